@@ -142,6 +142,13 @@
 /*                                            resulting in version 6.3.0  */
 /*  12-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.4.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            ethernet queue full error   */
+/*                                            code, added endpoint        */
+/*                                            transfer requests, added    */
+/*                                            device transfer queue,      */
+/*                                            added HID latency probe,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -262,6 +269,22 @@ typedef signed char               SCHAR;
 #endif /* UX_ENABLE_ASSERT */
 
 
+/* This defines the probe invoked as a HID input report goes from the device class to the
+   host client. The stage is one of UX_HID_LATENCY_STAGE_*, buffer and length are the report
+   data including the report ID if any. The probe is called in the context of the stage, so
+   it must be short: typically it reads a cycle counter (e.g. DWT->CYCCNT on Cortex-M) and
+   stores it with a sequence number taken from the report. It is defined to nothing by default. */
+#ifndef UX_HID_LATENCY_PROBE
+#define UX_HID_LATENCY_PROBE(stage, buffer, length)
+#endif
+
+#define UX_HID_LATENCY_STAGE_EVENT_SET                      0
+#define UX_HID_LATENCY_STAGE_DEVICE_SUBMIT                  1
+#define UX_HID_LATENCY_STAGE_HOST_RECEIVED                  2
+#define UX_HID_LATENCY_STAGE_HOST_DISPATCH                  3
+#define UX_HID_LATENCY_STAGES                               4
+
+
 /* Convert from millisecond to ThreadX Tick value. */
 #define UX_MS_TO_TICK(ms)                                  ((ms) * (UX_PERIODIC_RATE) / 1000)
 #define UX_MS_TO_TICK_NON_ZERO(ms)                         UX_MAX(1, UX_MS_TO_TICK(ms))
@@ -1545,6 +1568,7 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #define UX_CLASS_ETH_PACKET_POOL_ERROR                                  0x91
 #define UX_CLASS_ETH_PACKET_ERROR                                       0x92
 #define UX_CLASS_ETH_SIZE_ERROR                                         0x93
+#define UX_CLASS_ETH_QUEUE_FULL_ERROR                                   0x94
 
 
 /* Define USBX HCD API function constants.  */
@@ -1596,6 +1620,14 @@ VOID    _ux_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, UL
 #define UX_DCD_STALL_ENDPOINT                                           20
 #define UX_DCD_ENDPOINT_STATUS                                          21
 
+/* Define USBX DCD transfer queue function. The DCD appends the transfer request to the
+   transfer requests queued on its endpoint and returns without waiting. The transfer
+   requests of an endpoint are served in queue order, each one is completed by setting
+   its status and completion code, calling its completion function if any, then putting
+   its semaphore. A transfer request aborted is removed from the queue. A DCD that does
+   not support queuing returns UX_FUNCTION_NOT_SUPPORTED.  */
+#define UX_DCD_TRANSFER_QUEUE                                           22
+
 
 /* Define USBX generic host controller constants.  */
 
@@ -1861,6 +1893,9 @@ typedef struct UX_ENDPOINT_STRUCT
                     *ux_endpoint_device;
     struct UX_TRANSFER_STRUCT
                     ux_endpoint_transfer_request;
+    struct UX_TRANSFER_STRUCT
+                    *ux_endpoint_transfer_requests;
+    ULONG           ux_endpoint_transfer_requests_count;
 } UX_ENDPOINT;
 
 
@@ -2318,6 +2353,8 @@ typedef struct UX_SLAVE_TRANSFER_STRUCT
     ULONG           ux_slave_transfer_request_force_zlp;
     UCHAR           ux_slave_transfer_request_setup[UX_SETUP_SIZE];
     ULONG           ux_slave_transfer_request_status_phase_ignore;
+    struct UX_SLAVE_TRANSFER_STRUCT
+                    *ux_slave_transfer_request_next_transfer_request;
 } UX_SLAVE_TRANSFER;
 
 #if defined(UX_DEVICE_STANDALONE)
@@ -2343,6 +2380,9 @@ typedef struct UX_SLAVE_ENDPOINT_STRUCT
                     *ux_slave_endpoint_device;
     struct UX_SLAVE_TRANSFER_STRUCT
                     ux_slave_endpoint_transfer_request;
+    struct UX_SLAVE_TRANSFER_STRUCT
+                    *ux_slave_endpoint_transfer_requests;
+    ULONG           ux_slave_endpoint_transfer_requests_count;
 } UX_SLAVE_ENDPOINT;
 
 
@@ -2761,6 +2801,8 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_host_stack_device_get                                _uxe_host_stack_device_get
 #define ux_host_stack_device_string_get                         _uxe_host_stack_device_string_get
 #define ux_host_stack_endpoint_transfer_abort                   _uxe_host_stack_endpoint_transfer_abort
+#define ux_host_stack_endpoint_transfer_requests_allocate       _uxe_host_stack_endpoint_transfer_requests_allocate
+#define ux_host_stack_endpoint_transfer_requests_free           _uxe_host_stack_endpoint_transfer_requests_free
 #define ux_host_stack_hcd_register                              _uxe_host_stack_hcd_register
 #define ux_host_stack_hcd_unregister                            _uxe_host_stack_hcd_unregister
 #define ux_host_stack_interface_endpoint_get                    _uxe_host_stack_interface_endpoint_get
@@ -2779,6 +2821,8 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 #define ux_host_stack_device_get                                _ux_host_stack_device_get
 #define ux_host_stack_device_string_get                         _ux_host_stack_device_string_get
 #define ux_host_stack_endpoint_transfer_abort                   _ux_host_stack_endpoint_transfer_abort
+#define ux_host_stack_endpoint_transfer_requests_allocate       _ux_host_stack_endpoint_transfer_requests_allocate
+#define ux_host_stack_endpoint_transfer_requests_free           _ux_host_stack_endpoint_transfer_requests_free
 #define ux_host_stack_hcd_register                              _ux_host_stack_hcd_register
 #define ux_host_stack_hcd_unregister                            _ux_host_stack_hcd_unregister
 #define ux_host_stack_interface_endpoint_get                    _ux_host_stack_interface_endpoint_get
@@ -2810,13 +2854,19 @@ typedef struct UX_HOST_CLASS_DPUMP_STRUCT
 
 #define ux_device_stack_class_register                          _uxe_device_stack_class_register
 #define ux_device_stack_class_unregister                        _uxe_device_stack_class_unregister
+#define ux_device_stack_endpoint_transfer_requests_allocate     _uxe_device_stack_endpoint_transfer_requests_allocate
+#define ux_device_stack_endpoint_transfer_requests_free         _uxe_device_stack_endpoint_transfer_requests_free
 #define ux_device_stack_initialize                              _uxe_device_stack_initialize
+#define ux_device_stack_transfer_request_queue                  _uxe_device_stack_transfer_request_queue
 
 #else
 
 #define ux_device_stack_class_register                          _ux_device_stack_class_register
 #define ux_device_stack_class_unregister                        _ux_device_stack_class_unregister
+#define ux_device_stack_endpoint_transfer_requests_allocate     _ux_device_stack_endpoint_transfer_requests_allocate
+#define ux_device_stack_endpoint_transfer_requests_free         _ux_device_stack_endpoint_transfer_requests_free
 #define ux_device_stack_initialize                              _ux_device_stack_initialize
+#define ux_device_stack_transfer_request_queue                  _ux_device_stack_transfer_request_queue
 
 #endif
 #define ux_device_stack_uninitialize                            _ux_device_stack_uninitialize
@@ -2884,6 +2934,8 @@ UINT    ux_host_stack_device_configuration_select(UX_CONFIGURATION *configuratio
 UINT    ux_host_stack_device_get(ULONG device_index, UX_DEVICE **device);
 UINT    ux_host_stack_device_string_get(UX_DEVICE *device, UCHAR *descriptor_buffer, ULONG length, ULONG language_id, ULONG string_index);
 UINT    ux_host_stack_endpoint_transfer_abort(UX_ENDPOINT *endpoint);
+UINT    ux_host_stack_endpoint_transfer_requests_allocate(UX_ENDPOINT *endpoint, ULONG count, UX_TRANSFER **transfer_requests);
+UINT    ux_host_stack_endpoint_transfer_requests_free(UX_ENDPOINT *endpoint);
 UINT    ux_host_stack_hcd_register(UCHAR *hcd_name, UINT (*hcd_initialize_function)(struct UX_HCD_STRUCT *), ULONG hcd_param1, ULONG hcd_param2);
 UINT    ux_host_stack_hcd_unregister(UCHAR *hcd_name, ULONG hcd_param1, ULONG hcd_param2);
 UINT    ux_host_stack_initialize(UINT (*ux_system_host_change_function)(ULONG, UX_HOST_CLASS *, VOID *));
@@ -2922,6 +2974,8 @@ UINT    ux_device_stack_configuration_set(ULONG configuration_value);
 UINT    ux_device_stack_descriptor_send(ULONG descriptor_type, ULONG request_index, ULONG host_length);
 UINT    ux_device_stack_disconnect(VOID);
 UINT    ux_device_stack_endpoint_stall(UX_SLAVE_ENDPOINT *endpoint);
+UINT    ux_device_stack_endpoint_transfer_requests_allocate(UX_SLAVE_ENDPOINT *endpoint, ULONG count, UX_SLAVE_TRANSFER **transfer_requests);
+UINT    ux_device_stack_endpoint_transfer_requests_free(UX_SLAVE_ENDPOINT *endpoint);
 UINT    ux_device_stack_host_wakeup(VOID);
 UINT    ux_device_stack_initialize(UCHAR * device_framework_high_speed, ULONG device_framework_length_high_speed,
                                     UCHAR * device_framework_full_speed, ULONG device_framework_length_full_speed,
@@ -2935,6 +2989,7 @@ UINT    ux_device_stack_interface_set(UCHAR * device_framework, ULONG device_fra
                                     ULONG alternate_setting_value);
 UINT    ux_device_stack_interface_start(UX_SLAVE_INTERFACE *ux_interface);
 UINT    ux_device_stack_transfer_request(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length);
+UINT    ux_device_stack_transfer_request_queue(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length);
 UINT    ux_device_stack_transfer_request_abort(UX_SLAVE_TRANSFER *transfer_request, ULONG completion_code);
 
 UINT    ux_device_stack_tasks_run(VOID);
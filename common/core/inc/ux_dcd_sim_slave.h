@@ -55,6 +55,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            transfer requests queue,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -122,6 +125,10 @@ typedef struct UX_DCD_SIM_SLAVE_ED_STRUCT
     ULONG           ux_sim_slave_ed_configuration_value;
     struct UX_SLAVE_ENDPOINT_STRUCT             
                     *ux_sim_slave_ed_endpoint;
+    struct UX_SLAVE_TRANSFER_STRUCT
+                    *ux_sim_slave_ed_transfer_queue_head;
+    struct UX_SLAVE_TRANSFER_STRUCT
+                    *ux_sim_slave_ed_transfer_queue_tail;
 } UX_DCD_SIM_SLAVE_ED;
 
 
@@ -157,6 +164,7 @@ UINT    _ux_dcd_sim_slave_initialize(VOID);
 UINT    _ux_dcd_sim_slave_initialize_complete(VOID);
 UINT    _ux_dcd_sim_slave_state_change(UX_DCD_SIM_SLAVE *dcd_sim_slave, ULONG state);
 UINT    _ux_dcd_sim_slave_transfer_request(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request);
+UINT    _ux_dcd_sim_slave_transfer_queue(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request);
 UINT    _ux_dcd_sim_slave_transfer_run(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request);
 UINT    _ux_dcd_sim_slave_transfer_abort(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request);
 
@@ -56,6 +56,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            transfer requests queue,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -89,6 +92,8 @@ UINT    _ux_device_stack_control_request_process(UX_SLAVE_TRANSFER *transfer_req
 UINT    _ux_device_stack_descriptor_send(ULONG descriptor_type, ULONG request_index, ULONG host_length);
 UINT    _ux_device_stack_disconnect(VOID);
 UINT    _ux_device_stack_endpoint_stall(UX_SLAVE_ENDPOINT *endpoint);
+UINT    _ux_device_stack_endpoint_transfer_requests_allocate(UX_SLAVE_ENDPOINT *endpoint, ULONG count, UX_SLAVE_TRANSFER **transfer_requests);
+UINT    _ux_device_stack_endpoint_transfer_requests_free(UX_SLAVE_ENDPOINT *endpoint);
 UINT    _ux_device_stack_get_status(ULONG request_type, ULONG request_index, ULONG request_length);
 UINT    _ux_device_stack_host_wakeup(VOID);
 UINT    _ux_device_stack_initialize(UCHAR * device_framework_high_speed, ULONG device_framework_length_high_speed,
@@ -104,6 +109,7 @@ UINT    _ux_device_stack_interface_start(UX_SLAVE_INTERFACE *ux_interface);
 UINT    _ux_device_stack_set_feature(ULONG request_type, ULONG request_value, ULONG request_index);
 UINT    _ux_device_stack_transfer_all_request_abort(UX_SLAVE_ENDPOINT *endpoint, ULONG completion_code);
 UINT    _ux_device_stack_transfer_request(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length);
+UINT    _ux_device_stack_transfer_request_queue(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length);
 UINT    _ux_device_stack_transfer_abort(UX_SLAVE_TRANSFER *transfer_request, ULONG completion_code);
 UINT    _ux_device_stack_class_unregister(UCHAR *class_name, UINT (*class_entry_function)(struct UX_SLAVE_CLASS_COMMAND_STRUCT *));
 UINT    _ux_device_stack_microsoft_extension_register(ULONG vendor_request, UINT (*vendor_request_function)(ULONG, ULONG, ULONG, ULONG, UCHAR *, ULONG *));
@@ -119,6 +125,9 @@ UINT    _uxe_device_stack_class_register(UCHAR *class_name,
                                     VOID *parameter);
 UINT    _uxe_device_stack_class_unregister(UCHAR *class_name,
                                     UINT (*class_entry_function)(struct UX_SLAVE_CLASS_COMMAND_STRUCT *));
+UINT    _uxe_device_stack_endpoint_transfer_requests_allocate(UX_SLAVE_ENDPOINT *endpoint, ULONG count, UX_SLAVE_TRANSFER **transfer_requests);
+UINT    _uxe_device_stack_endpoint_transfer_requests_free(UX_SLAVE_ENDPOINT *endpoint);
+UINT    _uxe_device_stack_transfer_request_queue(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length);
 
 UINT    _uxe_device_stack_initialize(UCHAR * device_framework_high_speed, ULONG device_framework_length_high_speed,
                                     UCHAR * device_framework_full_speed, ULONG device_framework_length_full_speed,
@@ -68,6 +68,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            endpoint transfer requests  */
+/*                                            allocate and free,          */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -168,6 +172,8 @@ UINT    _ux_host_stack_endpoint_instance_create(UX_ENDPOINT *endpoint);
 VOID    _ux_host_stack_endpoint_instance_delete(UX_ENDPOINT *endpoint);
 UINT    _ux_host_stack_endpoint_reset(UX_ENDPOINT *endpoint);
 UINT    _ux_host_stack_endpoint_transfer_abort(UX_ENDPOINT *endpoint);
+UINT    _ux_host_stack_endpoint_transfer_requests_allocate(UX_ENDPOINT *endpoint, ULONG count, UX_TRANSFER **transfer_requests);
+UINT    _ux_host_stack_endpoint_transfer_requests_free(UX_ENDPOINT *endpoint);
 VOID    _ux_host_stack_enum_thread_entry(ULONG input);
 UINT    _ux_host_stack_hcd_register(UCHAR *hcd_name,
                                     UINT (*hcd_init_function)(struct UX_HCD_STRUCT *), ULONG hcd_param1, ULONG hcd_param2);
@@ -219,6 +225,8 @@ UINT    _uxe_host_stack_device_configuration_get(UX_DEVICE *device, UINT configu
 UINT    _uxe_host_stack_device_get(ULONG device_index, UX_DEVICE **device);
 UINT    _uxe_host_stack_device_string_get(UX_DEVICE *device, UCHAR *descriptor_buffer, ULONG length, ULONG language_id, ULONG string_index);
 UINT    _uxe_host_stack_endpoint_transfer_abort(UX_ENDPOINT *endpoint);
+UINT    _uxe_host_stack_endpoint_transfer_requests_allocate(UX_ENDPOINT *endpoint, ULONG count, UX_TRANSFER **transfer_requests);
+UINT    _uxe_host_stack_endpoint_transfer_requests_free(UX_ENDPOINT *endpoint);
 UINT    _uxe_host_stack_hcd_register(UCHAR *hcd_name,
                                     UINT (*hcd_init_function)(struct UX_HCD_STRUCT *), ULONG hcd_param1, ULONG hcd_param2);
 UINT    _uxe_host_stack_hcd_unregister(UCHAR *hcd_name, ULONG hcd_param1, ULONG hcd_param2);
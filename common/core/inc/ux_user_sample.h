@@ -26,7 +26,7 @@
 /*  PORT SPECIFIC C INFORMATION                            RELEASE        */ 
 /*                                                                        */ 
 /*    ux_user.h                                           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*                                                                        */
 /*  AUTHOR                                                                */
 /*                                                                        */
@@ -108,6 +108,9 @@
 /*                                            added option for get string */
 /*                                            requests with zero wIndex,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added HID latency probe,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -628,6 +631,13 @@
    it halts without any output.  */
 /* #define UX_ASSERT_FAIL  for (;;) {tx_thread_sleep(UX_WAIT_FOREVER); }  */
 
+/* Defined, this macro is invoked at each stage of a HID input report, from the device
+   event set to the host report dispatch, see UX_HID_LATENCY_STAGE_* in ux_api.h.
+   It can be used to measure the report latency with a cycle counter, e.g.:
+      extern VOID app_hid_latency_stamp(UINT stage, UCHAR *buffer, ULONG length, ULONG cycles);
+*/
+/* #define UX_HID_LATENCY_PROBE(stage, buffer, length) app_hid_latency_stamp(stage, buffer, length, DWT->CYCCNT)  */
+
 
 /* Defined, this option enables the basic USBX error checking. This define is typically used
    when the application is debugging and removed after the application is fully debugged.  */
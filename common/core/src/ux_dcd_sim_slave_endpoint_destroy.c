@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_dcd_sim_slave_endpoint_destroy                  PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            transfer queue reset,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_dcd_sim_slave_endpoint_destroy(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_ENDPOINT *endpoint)
@@ -82,6 +85,10 @@ UX_DCD_SIM_SLAVE_ED     *ed;
     /* We can free this endpoint.  */
     ed -> ux_sim_slave_ed_status =  UX_DCD_SIM_SLAVE_ED_STATUS_UNUSED;
 
+    /* No request is queued any more.  */
+    ed -> ux_sim_slave_ed_transfer_queue_head =  UX_NULL;
+    ed -> ux_sim_slave_ed_transfer_queue_tail =  UX_NULL;
+
     /* This function never fails.  */
     return(UX_SUCCESS);         
 }
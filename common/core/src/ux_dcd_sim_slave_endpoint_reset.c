@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_dcd_sim_slave_endpoint_reset                    PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -74,6 +74,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            kept queued transfer        */
+/*                                            requests,                   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_dcd_sim_slave_endpoint_reset(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_ENDPOINT *endpoint)
@@ -96,8 +100,10 @@ UX_SLAVE_TRANSFER       *transfer;
     transfer_waiting = UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
 #else
 
-    /* Save waiting status for non-zero endpoints.  */
-    if (ed -> ux_sim_slave_ed_index)
+    /* Save waiting status for non-zero endpoints, queued requests are kept.  */
+    if (ed -> ux_sim_slave_ed_transfer_queue_head != UX_NULL)
+        transfer_waiting = 0;
+    else if (ed -> ux_sim_slave_ed_index)
     {
         transfer_waiting = ed -> ux_sim_slave_ed_status;
         transfer_waiting &= UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
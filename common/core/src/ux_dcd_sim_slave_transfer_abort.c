@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_dcd_sim_slave_transfer_abort                    PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -70,6 +70,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            transfer queue support,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_dcd_sim_slave_transfer_abort(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request)
@@ -77,6 +80,9 @@ UINT  _ux_dcd_sim_slave_transfer_abort(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE
 
 UX_DCD_SIM_SLAVE_ED     *ed;
 UX_SLAVE_ENDPOINT       *endpoint;
+UX_SLAVE_TRANSFER       *previous;
+UX_SLAVE_TRANSFER       *next;
+UX_INTERRUPT_SAVE_AREA
 
     UX_PARAMETER_NOT_USED(dcd_sim_slave);
 
@@ -86,9 +92,35 @@ UX_SLAVE_ENDPOINT       *endpoint;
     /* Keep the physical endpoint address in the endpoint container.  */
     ed =  (UX_DCD_SIM_SLAVE_ED *) endpoint -> ux_slave_endpoint_ed;
 
-    /* Turn off the transfer bit.  */
-    ed -> ux_sim_slave_ed_status &= ~(ULONG)
-        (UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER | UX_DCD_SIM_SLAVE_ED_STATUS_DONE);
+    UX_DISABLE
+
+    /* Remove the request from the endpoint queue, if it's queued.  */
+    previous =  UX_NULL;
+    next =  ed -> ux_sim_slave_ed_transfer_queue_head;
+    while (next != UX_NULL)
+    {
+        if (next == transfer_request)
+        {
+            next =  transfer_request -> ux_slave_transfer_request_next_transfer_request;
+            if (previous == UX_NULL)
+                ed -> ux_sim_slave_ed_transfer_queue_head =  next;
+            else
+                previous -> ux_slave_transfer_request_next_transfer_request =  next;
+            if (next == UX_NULL)
+                ed -> ux_sim_slave_ed_transfer_queue_tail =  previous;
+            transfer_request -> ux_slave_transfer_request_next_transfer_request =  UX_NULL;
+            break;
+        }
+        previous =  next;
+        next =  next -> ux_slave_transfer_request_next_transfer_request;
+    }
+
+    /* Turn off the transfer bit, if no other request is queued.  */
+    if (ed -> ux_sim_slave_ed_transfer_queue_head == UX_NULL)
+        ed -> ux_sim_slave_ed_status &= ~(ULONG)
+            (UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER | UX_DCD_SIM_SLAVE_ED_STATUS_DONE);
+
+    UX_RESTORE
 
     /* This function never fails.  */
     return(UX_SUCCESS);         
@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Slave Simulator Controller Driver                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_dcd_sim_slave.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_dcd_sim_slave_transfer_queue                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function will queue a transfer request on a specific           */
+/*    endpoint. The request is appended to the endpoint queue and the     */
+/*    function returns without waiting. Queued requests are served in     */
+/*    order by the host simulator; on completion the completion function  */
+/*    of the request is called and its semaphore is put.                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    dcd_sim_slave                         Pointer to device controller  */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Slave Simulator Controller Driver                                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_dcd_sim_slave_transfer_queue(UX_DCD_SIM_SLAVE *dcd_sim_slave, UX_SLAVE_TRANSFER *transfer_request)
+{
+
+UX_SLAVE_ENDPOINT       *endpoint;
+UX_DCD_SIM_SLAVE_ED     *ed;
+UX_INTERRUPT_SAVE_AREA
+
+
+    UX_PARAMETER_NOT_USED(dcd_sim_slave);
+
+    /* Get the pointer to the logical endpoint from the transfer request.  */
+    endpoint =  transfer_request -> ux_slave_transfer_request_endpoint;
+
+    /* Get the slave endpoint.  */
+    ed = (UX_DCD_SIM_SLAVE_ED *) endpoint -> ux_slave_endpoint_ed;
+
+    /* This is the last request in queue.  */
+    transfer_request -> ux_slave_transfer_request_next_transfer_request =  UX_NULL;
+
+    UX_DISABLE
+
+    /* Append the request to the endpoint queue.  */
+    if (ed -> ux_sim_slave_ed_transfer_queue_tail == UX_NULL)
+        ed -> ux_sim_slave_ed_transfer_queue_head =  transfer_request;
+    else
+        ed -> ux_sim_slave_ed_transfer_queue_tail -> ux_slave_transfer_request_next_transfer_request =  transfer_request;
+    ed -> ux_sim_slave_ed_transfer_queue_tail =  transfer_request;
+
+    /* Set the ED to TRANSFER status.  */
+    ed -> ux_sim_slave_ed_status |= UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
+
+    UX_RESTORE
+
+    /* Return to caller with success.  */
+    return(UX_SUCCESS);
+}
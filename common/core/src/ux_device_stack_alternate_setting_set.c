@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_alternate_setting_set              PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -62,6 +62,8 @@
 /*    _ux_device_stack_transfer_all_request_abort                         */
 /*                                          Abort transfer                */
 /*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_device_stack_endpoint_transfer_requests_free                    */
+/*                                          Free transfer requests        */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -85,6 +87,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            endpoint transfer requests  */
+/*                                            free, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_alternate_setting_set(ULONG interface_value, ULONG alternate_setting_value)
@@ -241,6 +247,9 @@ ULONG                           max_transfer_length, n_trans;
                                 /* Abort any pending transfer.  */
                                 _ux_device_stack_transfer_all_request_abort(endpoint, UX_TRANSFER_BUS_RESET);
 
+                                /* Free the transfer requests queued on the endpoint, if any.  */
+                                _ux_device_stack_endpoint_transfer_requests_free(endpoint);
+
                                 /* The device controller must be called to destroy the endpoint.  */
                                 dcd -> ux_slave_dcd_function(dcd, UX_DCD_DESTROY_ENDPOINT, (VOID *) endpoint);
 
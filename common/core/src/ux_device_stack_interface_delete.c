@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_interface_delete                   PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,8 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    (ux_slave_dcd_function)               DCD dispatch function         */ 
+/*    _ux_device_stack_endpoint_transfer_requests_free                    */
+/*                                          Free transfer requests        */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -73,6 +75,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            endpoint transfer requests  */
+/*                                            free, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_interface_delete(UX_SLAVE_INTERFACE *interface_ptr)
@@ -108,6 +114,9 @@ UX_SLAVE_ENDPOINT       *next_endpoint;
         /* Get the pointer to the DCD.  */
         dcd =  &_ux_system_slave->ux_system_slave_dcd;
 
+        /* Free the transfer requests queued on the endpoint, if any.  */
+        _ux_device_stack_endpoint_transfer_requests_free(endpoint);
+
         /* The endpoint must be destroyed.  */
         dcd -> ux_slave_dcd_function(dcd, UX_DCD_DESTROY_ENDPOINT, endpoint);
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_transfer_abort                     PORTABLE C      */
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -80,6 +80,10 @@
 /*                                            added standalone support,   */
 /*                                            assigned aborting code,     */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), called   */
+/*                                            completion function of      */
+/*                                            aborted transfer request,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_transfer_abort(UX_SLAVE_TRANSFER *transfer_request, ULONG completion_code)
@@ -119,6 +123,10 @@ UX_SLAVE_DCD    *dcd;
            currently waiting for it to complete.  */
         transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_ABORT;
 
+        /* A queued transfer request is informed through its completion function.  */
+        if (transfer_request -> ux_slave_transfer_request_completion_function != UX_NULL)
+            transfer_request -> ux_slave_transfer_request_completion_function(transfer_request);
+
         /* Wake up the device driver who is waiting on the semaphore.  */
         _ux_device_semaphore_put(&transfer_request -> ux_slave_transfer_request_semaphore);
     }
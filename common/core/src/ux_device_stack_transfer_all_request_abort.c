@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_stack_transfer_all_request_abort         PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -43,7 +43,8 @@
 /*                                                                        */
 /*    This function cancels all the transfer requests attached to an      */
 /*    endpoint. The endpoint is not reset and its toggle state is left    */
-/*    the same.                                                           */
+/*    the same. The transfer requests queued on the endpoint are          */
+/*    cancelled before the endpoint transfer request.                     */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -69,16 +70,24 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), aborted  */
+/*                                            queued transfer requests,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_stack_transfer_all_request_abort(UX_SLAVE_ENDPOINT *endpoint, ULONG completion_code)
 {
 
 UX_SLAVE_TRANSFER       *transfer_request;    
+ULONG                   index;
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_STACK_TRANSFER_ALL_REQUEST_ABORT, endpoint, completion_code, 0, 0, UX_TRACE_DEVICE_STACK_EVENTS, 0, 0)
 
+    /* Abort the transfer requests queued on this endpoint.  */
+    for (index = 0; index < endpoint -> ux_slave_endpoint_transfer_requests_count; index ++)
+        _ux_device_stack_transfer_abort(&endpoint -> ux_slave_endpoint_transfer_requests[index], completion_code);
+
     /* Get the transfer request for this endpoint.  */
     transfer_request =  &endpoint -> ux_slave_endpoint_transfer_request;
     
@@ -0,0 +1,247 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Stack                                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_stack_transfer_request_queue             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function queues a USB transaction on a non control endpoint    */
+/*    and returns without waiting for its completion. On entry the        */
+/*    transfer request gives the endpoint pipe selected for this          */
+/*    transaction and the parameters associated with the transfer (data   */
+/*    payload, length of transaction).                                    */
+/*                                                                        */
+/*    Several transfer requests, allocated by                             */
+/*    _ux_device_stack_endpoint_transfer_requests_allocate, can be        */
+/*    queued on the same endpoint. The DCD completes them in the order    */
+/*    they were queued: it sets their status and completion code, calls   */
+/*    their completion function if any, and puts their semaphore. The     */
+/*    completion function may queue the transfer request again.           */
+/*                                                                        */
+/*    The DCD must support the UX_DCD_TRANSFER_QUEUE function,            */
+/*    UX_FUNCTION_NOT_SUPPORTED is returned otherwise. The endpoint       */
+/*    transfer request should not be used by                              */
+/*    _ux_device_stack_transfer_request while transfer requests are       */
+/*    queued on the endpoint.                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                      Pointer to transfer request   */
+/*    slave_length                          Length returned by host       */
+/*    host_length                           Length asked by host          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    (ux_slave_dcd_function)               Slave DCD dispatch function   */
+/*    _ux_system_error_handler              Log system error              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application, Device Classes                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_device_stack_transfer_request_queue(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_SLAVE_DCD            *dcd;
+UX_SLAVE_ENDPOINT       *endpoint;
+ULONG                   device_state;
+UINT                    status;
+
+
+    /* Get the endpoint associated with this transaction.  */
+    endpoint =  transfer_request -> ux_slave_transfer_request_endpoint;
+
+    /* Control transfers are driven by the device stack, they can not be queued.  */
+    if ((endpoint -> ux_slave_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_CONTROL_ENDPOINT)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_DEVICE_STACK, UX_FUNCTION_NOT_SUPPORTED);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_FUNCTION_NOT_SUPPORTED, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_FUNCTION_NOT_SUPPORTED);
+    }
+
+    /* Disable interrupts to prevent the disconnection ISR from preempting us
+       while we check the device state and set the transfer status.  */
+    UX_DISABLE
+
+    /* The transfer request can be queued only once.  */
+    if (transfer_request -> ux_slave_transfer_request_status == UX_TRANSFER_STATUS_PENDING)
+    {
+
+        /* Restore interrupts and return error.  */
+        UX_RESTORE
+        return(UX_BUSY);
+    }
+
+    /* Get the device state.  */
+    device_state =  _ux_system_slave -> ux_system_slave_device.ux_slave_device_state;
+
+    /* We can only transfer when the device is CONFIGURED.  */
+    if (device_state != UX_DEVICE_CONFIGURED)
+    {
+
+        /* The device is in an invalid state. Restore interrupts and return error.  */
+        UX_RESTORE
+        return(UX_TRANSFER_NOT_READY);
+    }
+
+    /* Set the transfer to pending.  */
+    transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_PENDING;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_STACK_TRANSFER_REQUEST, transfer_request, 0, 0, 0, UX_TRACE_DEVICE_STACK_EVENTS, 0, 0)
+
+    /* Get the pointer to the DCD.  */
+    dcd =  &_ux_system_slave -> ux_system_slave_dcd;
+
+    /* Isolate the direction from the endpoint address and set the data phase direction.  */
+    if ((endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) == UX_ENDPOINT_IN)
+        transfer_request -> ux_slave_transfer_request_phase =  UX_TRANSFER_PHASE_DATA_OUT;
+    else
+        transfer_request -> ux_slave_transfer_request_phase =  UX_TRANSFER_PHASE_DATA_IN;
+
+    /* See if we need to force a zero length packet at the end of the transfer.
+       This happens on a DATA IN and when the host requested length is not met
+       and the last packet is on a boundary. If slave_length is zero, then it is
+       a explicit ZLP request, no need to force ZLP.  */
+    if ((transfer_request -> ux_slave_transfer_request_phase ==  UX_TRANSFER_PHASE_DATA_OUT) &&
+        (slave_length != 0) && (host_length != slave_length) &&
+        (slave_length % endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize) == 0)
+        transfer_request -> ux_slave_transfer_request_force_zlp =  UX_TRUE;
+    else
+        transfer_request -> ux_slave_transfer_request_force_zlp =  UX_FALSE;
+
+    /* Reset the number of bytes sent/received.  */
+    transfer_request -> ux_slave_transfer_request_actual_length =  0;
+    transfer_request -> ux_slave_transfer_request_completion_code =  UX_SUCCESS;
+
+    /* Determine how many bytes to send in this transaction.  We keep track of the original
+        length and have a working length.  */
+    transfer_request -> ux_slave_transfer_request_requested_length =    slave_length;
+    transfer_request -> ux_slave_transfer_request_in_transfer_length =  slave_length;
+
+    /* Save the buffer pointer.  */
+    transfer_request -> ux_slave_transfer_request_current_data_pointer =
+                            transfer_request -> ux_slave_transfer_request_data_pointer;
+
+    /* Call the DCD driver transfer queue function.   */
+    status =  dcd -> ux_slave_dcd_function(dcd, UX_DCD_TRANSFER_QUEUE, transfer_request);
+
+    /* If the transfer request could not be queued, it is no more pending.  */
+    if (status != UX_SUCCESS)
+        transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
+
+    /* And return the status.  */
+    return(status);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_stack_transfer_request_queue            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in device stack transfer request queue  */
+/*    function call.                                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                      Pointer to transfer request   */
+/*    slave_length                          Length returned by host       */
+/*    host_length                           Length asked by host          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_stack_transfer_request_queue                             */
+/*                                          Queue transfer request        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_device_stack_transfer_request_queue(UX_SLAVE_TRANSFER *transfer_request, ULONG slave_length, ULONG host_length)
+{
+
+    /* Sanity checks.  */
+    if ((transfer_request == UX_NULL) ||
+        (transfer_request -> ux_slave_transfer_request_endpoint == UX_NULL) ||
+        ((slave_length != 0) && (transfer_request -> ux_slave_transfer_request_data_pointer == UX_NULL)))
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke transfer request queue function.  */
+    return(_ux_device_stack_transfer_request_queue(transfer_request, slave_length, host_length));
+}
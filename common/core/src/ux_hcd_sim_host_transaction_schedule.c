@@ -36,7 +36,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_hcd_sim_host_transaction_schedule               PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,6 +63,8 @@
 /*                                          Process request               */
 /*    _ux_utility_memory_copy               Copy memory block             */
 /*    _ux_utility_semaphore_put             Semaphore put                 */
+/*    (ux_slave_transfer_request_completion_function)                     */
+/*                                          Device completion function    */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -96,6 +98,12 @@
 /*                                            adjusted control request    */
 /*                                            data length handling,       */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), kept TDs */
+/*                                            of other transfers queued   */
+/*                                            on short packet and on      */
+/*                                            stall, served device        */
+/*                                            queued transfer requests,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_transaction_schedule(UX_HCD_SIM_HOST *hcd_sim_host, UX_HCD_SIM_HOST_ED *ed)
@@ -118,6 +126,7 @@ UX_SLAVE_TRANSFER       *slave_transfer_request;
 UX_TRANSFER             *transfer_request;
 ULONG                   endpoint_index;
 UX_SLAVE_DCD            *dcd;
+UX_INTERRUPT_SAVE_AREA
 
     UX_PARAMETER_NOT_USED(hcd_sim_host);
 
@@ -165,8 +174,10 @@ UX_SLAVE_DCD            *dcd;
     /* Get the logical endpoint from the physical endpoint.  */
     slave_endpoint =  slave_ed -> ux_sim_slave_ed_endpoint;
 
-    /* Get the pointer to the transfer request.  */
-    slave_transfer_request =  &slave_endpoint -> ux_slave_endpoint_transfer_request;
+    /* Get the pointer to the transfer request, queued requests are served first.  */
+    slave_transfer_request =  slave_ed -> ux_sim_slave_ed_transfer_queue_head;
+    if (slave_transfer_request == UX_NULL)
+        slave_transfer_request =  &slave_endpoint -> ux_slave_endpoint_transfer_request;
 
     /* Check the phase for this transfer, if this is the SETUP phase, treatment is different.  Explanation of how 
        control transfers are handled in the simulator: if the data phase is OUT, we handle it immediately, meaning we 
@@ -376,12 +387,15 @@ UX_SLAVE_DCD            *dcd;
             /* Wake up the host side.  */
             _ux_host_semaphore_put(&transfer_request -> ux_transfer_request_semaphore);
 
-            /* Clean up this ED.  */
+            /* Clean up this ED. Several transfers may be queued on this endpoint, only
+               the TDs of the stalled transfer are freed, the next transfers complete
+               in order with their own status.  */
             head_td =  ed -> ux_sim_host_ed_head_td;
             tail_td =  ed -> ux_sim_host_ed_tail_td;
 
-            /* Free all TDs attached to the ED.  */
-            while (head_td != tail_td)
+            /* Free the TDs of the stalled transfer.  */
+            while ((head_td != tail_td) &&
+                   (head_td -> ux_sim_host_td_transfer_request == transfer_request))
             {
 
                 /* Mark the current head TD as free. */
@@ -500,8 +514,38 @@ UX_SLAVE_DCD            *dcd;
                 /* Set the transfer status to COMPLETED.  */
                 slave_transfer_request -> ux_slave_transfer_request_status =  UX_TRANSFER_STATUS_COMPLETED;
 
+                /* Is this a queued request?  */
+                if (slave_transfer_request == slave_ed -> ux_sim_slave_ed_transfer_queue_head)
+                {
+
+                    UX_DISABLE
+
+                    /* Remove the request from the queue.  */
+                    slave_ed -> ux_sim_slave_ed_transfer_queue_head =
+                            slave_transfer_request -> ux_slave_transfer_request_next_transfer_request;
+                    if (slave_ed -> ux_sim_slave_ed_transfer_queue_head == UX_NULL)
+                    {
+
+                        /* Queue is empty, clear pending flag.  */
+                        slave_ed -> ux_sim_slave_ed_transfer_queue_tail =  UX_NULL;
+                        slave_ed -> ux_sim_slave_ed_status &= ~(ULONG)UX_DCD_SIM_SLAVE_ED_STATUS_TRANSFER;
+                    }
+
+                    /* Set done flag.  */
+                    slave_ed -> ux_sim_slave_ed_status |= UX_DCD_SIM_SLAVE_ED_STATUS_DONE;
+
+                    UX_RESTORE
+
+                    /* Call the completion function, it may queue the request again.  */
+                    if (slave_transfer_request -> ux_slave_transfer_request_completion_function)
+                        slave_transfer_request -> ux_slave_transfer_request_completion_function(slave_transfer_request);
+
+                    /* Wake up the slave side.  */
+                    _ux_device_semaphore_put(&slave_transfer_request -> ux_slave_transfer_request_semaphore);
+                }
+
                 /* Is this not the control endpoint? */
-                if (slave_ed -> ux_sim_slave_ed_index != 0)
+                else if (slave_ed -> ux_sim_slave_ed_index != 0)
                 {
 
                     /* Clear pending flag.  */
@@ -525,13 +569,12 @@ UX_SLAVE_DCD            *dcd;
                 {
 
                     /* Free all TDs associated with this transfer. Note that if this is a control transfer (which
-                       means it must be IN), then this also gets rid of the STATUS phase, which is okay. Also note
-                       that assumes that there is only one transfer occurring on this endpoint; if there were
-                       multiple, then we'd erase that one's TDs as well. Luckily, with the way USBX is designed,
-                       there should never be multiple transfers occurring simultaneously on a single endpoint
-                       (tldr; data pointer for transfers is shared).  */
+                       means it must be IN), then this also gets rid of the STATUS phase, which is okay. Several
+                       transfers may be queued on this endpoint (e.g. reception rings), so only the TDs of the
+                       transfer at the head are freed, the TDs of the next transfers are kept.  */
                     head_td =  ed -> ux_sim_host_ed_head_td;
-                    while (head_td != ed -> ux_sim_host_ed_tail_td)
+                    while ((head_td != ed -> ux_sim_host_ed_tail_td) &&
+                           (head_td -> ux_sim_host_td_transfer_request == transfer_request))
                     {
 
                         /* Free the TD that was used here.  */
@@ -541,9 +584,8 @@ UX_SLAVE_DCD            *dcd;
                         head_td =  head_td -> ux_sim_host_td_next_td;
                     }
 
-                    /* Update the head and tail TD. */
+                    /* Update the head TD, the tail TD is not changed.  */
                     ed -> ux_sim_host_ed_head_td =  head_td;
-                    ed -> ux_sim_host_ed_tail_td =  head_td;
                 }
 
                 /* Set the completion code to no error.  */
@@ -72,6 +72,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), kept TDs */
+/*                                            of other transfers queued   */
+/*                                            on the endpoint, resulting  */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_hcd_sim_host_transfer_abort(UX_HCD_SIM_HOST *hcd_sim_host, UX_TRANSFER *transfer_request)
@@ -81,6 +85,8 @@ UX_ENDPOINT             *endpoint;
 UX_HCD_SIM_HOST_ED      *ed;
 UX_HCD_SIM_HOST_TD      *head_td;
 UX_HCD_SIM_HOST_TD      *tail_td;
+UX_HCD_SIM_HOST_TD      *next_td;
+UX_HCD_SIM_HOST_TD      *previous_td;
     
     UX_PARAMETER_NOT_USED(hcd_sim_host);
 
@@ -113,22 +119,40 @@ UX_HCD_SIM_HOST_TD      *tail_td;
     _ux_utility_delay_ms(1);
 #endif
 
-    /* Remove all the TDs from this ED and leave the head and tail pointing to the dummy TD.  */
+    /* Remove the TDs from this ED, the tail still points to the dummy TD.  */
     head_td =  ed -> ux_sim_host_ed_head_td;
     tail_td =  ed -> ux_sim_host_ed_tail_td;
+    previous_td =  UX_NULL;
 
-    /* Free all TDs attached to the ED.  */
+    /* Several transfer requests may be queued on a bulk or interrupt endpoint,
+       free the TDs of the aborted transfer request only. All TDs are freed for
+       isochronous endpoints.  */
     while (head_td != tail_td)
     {
 
-        /* Mark the current head TD as free. */
-        head_td -> ux_sim_host_td_status =  UX_UNUSED;
+        /* Get the next TD.  */
+        next_td =  head_td -> ux_sim_host_td_next_td;
 
-        /* Update the head TD with the next TD.  */
-        ed -> ux_sim_host_ed_head_td =  head_td -> ux_sim_host_td_next_td;
+        if (((endpoint -> ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) == UX_ISOCHRONOUS_ENDPOINT) ||
+            (head_td -> ux_sim_host_td_transfer_request == transfer_request))
+        {
+
+            /* Unlink the TD.  */
+            if (previous_td == UX_NULL)
+                ed -> ux_sim_host_ed_head_td =  next_td;
+            else
+                previous_td -> ux_sim_host_td_next_td =  next_td;
+
+            /* Mark the TD as free. */
+            head_td -> ux_sim_host_td_status =  UX_UNUSED;
+        }
+        else
+
+            /* Keep the TD.  */
+            previous_td =  head_td;
 
         /* Now the new head TD is the next TD in the chain.  */
-        head_td =  ed -> ux_sim_host_ed_head_td;
+        head_td =  next_td;
     }
 
 #if defined(UX_HOST_STANDALONE)
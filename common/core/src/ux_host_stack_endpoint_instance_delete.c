@@ -58,6 +58,8 @@
 /*    _ux_host_stack_bandwidth_release      Release bandwidth             */ 
 /*    _ux_utility_semaphore_delete          Semaphore delete              */ 
 /*    (ux_hcd_entry_function)               HCD entry function            */ 
+/*    _ux_host_stack_endpoint_transfer_requests_free                      */
+/*                                          Free transfer requests        */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -78,6 +80,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            endpoint transfer requests  */
+/*                                            free, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_stack_endpoint_instance_delete(UX_ENDPOINT *endpoint)
@@ -96,6 +102,9 @@ UX_HCD          *hcd;
     if (endpoint -> ux_endpoint_ed != UX_NULL)
     {    
 
+        /* Free the transfer requests the class has not freed.  */
+        _ux_host_stack_endpoint_transfer_requests_free(endpoint);
+
         /* Destroy this endpoint.  */
         hcd -> ux_hcd_entry_function(hcd, UX_HCD_DESTROY_ENDPOINT, (VOID *) endpoint);
     
@@ -44,6 +44,10 @@
 /*    This function resets an endpoint after a stall or other error       */ 
 /*    condition.                                                          */ 
 /*                                                                        */ 
+/*    The transfer requests allocated for the endpoint by                 */
+/*    _ux_host_stack_endpoint_transfer_requests_allocate are cancelled    */
+/*    first, they are not resumed after the reset.                        */
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    endpoint                              Endpoint to abort transfer    */ 
@@ -56,6 +60,7 @@
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Send transfer request         */ 
 /*    (ux_hcd_entry_function)               HCD entry function            */ 
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -70,6 +75,10 @@
 /*                                            optimized based on compile  */
 /*                                            definitions,                */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            endpoint transfer requests  */
+/*                                            abort, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_endpoint_reset(UX_ENDPOINT *endpoint)
@@ -80,6 +89,7 @@ UX_TRANSFER     *transfer_request;
 UX_DEVICE       *device;    
 UX_HCD          *hcd;
 UINT            status;
+ULONG           index;
 
 
     /* Get the device container from the endpoint */
@@ -88,6 +98,10 @@ UINT            status;
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_ENDPOINT_RESET, device, endpoint, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
+    /* Cancel the transfer requests queued on this endpoint.  */
+    for (index = 0; index < endpoint -> ux_endpoint_transfer_requests_count; index ++)
+        _ux_host_stack_transfer_request_abort(&endpoint -> ux_endpoint_transfer_requests[index]);
+
     /* Get the control endpoint attached to the device.  */
     control_endpoint =  &device -> ux_device_control_endpoint;
 
@@ -45,10 +45,10 @@
 /*    endpoint. The endpoint is not reset and its toggle state is left    */ 
 /*    the same.                                                           */
 /*                                                                        */
-/*    In this version of USBX, there can only be one transfer request     */ 
-/*    pending for an endpoint. It is not known at this stage if having    */ 
-/*    multiple transfer request is a benefit for USBX but this function   */ 
-/*    may be changed one day to add such functionality.                   */
+/*    The transfer requests allocated for the endpoint by                 */
+/*    _ux_host_stack_endpoint_transfer_requests_allocate are cancelled    */
+/*    one after the other in array order, then the transfer request of    */
+/*    the endpoint itself.                                                */
 /*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
@@ -74,17 +74,26 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            endpoint transfer requests  */
+/*                                            abort, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_stack_endpoint_transfer_abort(UX_ENDPOINT *endpoint)
 {
 
 UINT    status;
+ULONG   index;
     
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_STACK_ENDPOINT_TRANSFER_ABORT, endpoint, 0, 0, 0, UX_TRACE_HOST_STACK_EVENTS, 0, 0)
 
-    /* Since we only have one transfer_request per endpoint, use the regular 
+    /* Abort the transfer requests allocated for this endpoint, in array order.  */
+    for (index = 0; index < endpoint -> ux_endpoint_transfer_requests_count; index ++)
+        _ux_host_stack_transfer_request_abort(&endpoint -> ux_endpoint_transfer_requests[index]);
+
+    /* Abort the transfer request of the endpoint itself with the regular
        abort transfer request function.  */
     status =  _ux_host_stack_transfer_request_abort(&endpoint -> ux_endpoint_transfer_request);
 
@@ -0,0 +1,225 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+#include "ux_hcd_sim_host.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_transfer_requests_allocate  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates a set of transfer requests for an           */
+/*    endpoint, in addition to the transfer request contained in the      */
+/*    endpoint. They can all be pending at the same time: the HCD queues  */
+/*    them on the endpoint and completes them in the order they were      */
+/*    issued.                                                             */
+/*                                                                        */
+/*    Only the simulator HCD keeps several transfers queued on an         */
+/*    endpoint. With the other HCDs a single transfer request can be      */
+/*    allocated, UX_FUNCTION_NOT_SUPPORTED is returned for more.          */
+/*                                                                        */
+/*    If a transfer fails, for example on a stall, the transfers queued   */
+/*    behind it are not flushed: each one is still served and completes   */
+/*    with its own status, UX_TRANSFER_STALLED while the endpoint is      */
+/*    halted. The class clears the halt with                              */
+/*    _ux_host_stack_endpoint_reset, which aborts the ones still pending. */
+/*                                                                        */
+/*    Each transfer request is initialized like the endpoint transfer     */
+/*    request (endpoint, type, packet length, timeout and class           */
+/*    instance). The class sets its own buffer and completion function.   */
+/*                                                                        */
+/*    Aborting or resetting the endpoint cancels all of them, one after   */
+/*    the other in array order, which is not necessarily the order they   */
+/*    were issued in. They are released by                                */
+/*    _ux_host_stack_endpoint_transfer_requests_free, or when the         */
+/*    endpoint is deleted.                                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    endpoint                              Pointer to endpoint           */
+/*    count                                 Number of transfer requests   */
+/*    transfer_requests                     Pointer to array address      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_allocate_mulc_safe Allocate memory               */
+/*    _ux_utility_memory_free               Free memory                   */
+/*    _ux_host_semaphore_create             Create semaphore              */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application, USBX Components                                        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_endpoint_transfer_requests_allocate(UX_ENDPOINT *endpoint, ULONG count, UX_TRANSFER **transfer_requests)
+{
+
+UX_TRANSFER     *endpoint_transfer_request;
+UX_TRANSFER     *transfer_request;
+UX_HCD          *hcd;
+ULONG           index;
+UINT            status;
+
+
+    /* Only the simulator HCD keeps the TDs of several transfers queued on an
+       endpoint, the other HCDs serve one pending transfer at a time.  */
+    hcd =  UX_DEVICE_HCD_GET(endpoint -> ux_endpoint_device);
+    if ((count > 1) && (hcd -> ux_hcd_controller_type != UX_HCD_SIM_HOST_CONTROLLER))
+        return(UX_FUNCTION_NOT_SUPPORTED);
+
+    /* Only one set of transfer requests can be attached to an endpoint.  */
+    if (endpoint -> ux_endpoint_transfer_requests != UX_NULL)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_HOST_STACK, UX_ALREADY_ACTIVATED);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_ALREADY_ACTIVATED, endpoint, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_ALREADY_ACTIVATED);
+    }
+
+    /* Allocate the transfer requests.  */
+    transfer_request =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY, count, sizeof(UX_TRANSFER));
+    if (transfer_request == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Initialize them from the endpoint transfer request.  */
+    endpoint_transfer_request =  &endpoint -> ux_endpoint_transfer_request;
+    for (index = 0; index < count; index ++)
+    {
+
+        transfer_request[index].ux_transfer_request_endpoint =         endpoint;
+        transfer_request[index].ux_transfer_request_type =             endpoint_transfer_request -> ux_transfer_request_type;
+        transfer_request[index].ux_transfer_request_packet_length =    endpoint_transfer_request -> ux_transfer_request_packet_length;
+        transfer_request[index].ux_transfer_request_timeout_value =    endpoint_transfer_request -> ux_transfer_request_timeout_value;
+        transfer_request[index].ux_transfer_request_class_instance =   endpoint_transfer_request -> ux_transfer_request_class_instance;
+
+        /* Create the semaphore used to wait for this transfer.  */
+        status =  _ux_host_semaphore_create(&transfer_request[index].ux_transfer_request_semaphore,
+                                                                "ux_transfer_request_semaphore", 0);
+        if (status != UX_SUCCESS)
+        {
+
+            /* Delete the semaphores already created.  */
+            while (index > 0)
+            {
+                index --;
+                _ux_host_semaphore_delete(&transfer_request[index].ux_transfer_request_semaphore);
+            }
+
+            /* Free the transfer requests.  */
+            _ux_utility_memory_free(transfer_request);
+            return(UX_SEMAPHORE_ERROR);
+        }
+    }
+
+    /* Attach the transfer requests to the endpoint.  */
+    endpoint -> ux_endpoint_transfer_requests =        transfer_request;
+    endpoint -> ux_endpoint_transfer_requests_count =  count;
+
+    /* Return the transfer requests.  */
+    *transfer_requests =  transfer_request;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_stack_endpoint_transfer_requests_allocate PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in host stack endpoint transfer         */
+/*    requests allocate function call.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    endpoint                              Pointer to endpoint           */
+/*    count                                 Number of transfer requests   */
+/*    transfer_requests                     Pointer to array address      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_transfer_requests_allocate                  */
+/*                                          Allocate transfer requests    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_stack_endpoint_transfer_requests_allocate(UX_ENDPOINT *endpoint, ULONG count, UX_TRANSFER **transfer_requests)
+{
+
+    /* Sanity checks.  */
+    if ((endpoint == UX_NULL) || (count == 0) || (transfer_requests == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke transfer requests allocate function.  */
+    return(_ux_host_stack_endpoint_transfer_requests_allocate(endpoint, count, transfer_requests));
+}
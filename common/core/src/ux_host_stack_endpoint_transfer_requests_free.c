@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Stack                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_transfer_requests_free      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees the transfer requests allocated for an          */
+/*    endpoint by _ux_host_stack_endpoint_transfer_requests_allocate.     */
+/*    The ones still pending are aborted first.                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    endpoint                              Pointer to endpoint           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application, USBX Components                                        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_stack_endpoint_transfer_requests_free(UX_ENDPOINT *endpoint)
+{
+
+UX_TRANSFER     *transfer_request;
+ULONG           count;
+ULONG           index;
+
+
+    /* Check if there is something to free.  */
+    transfer_request =  endpoint -> ux_endpoint_transfer_requests;
+    if (transfer_request == UX_NULL)
+        return(UX_SUCCESS);
+    count =  endpoint -> ux_endpoint_transfer_requests_count;
+
+    /* Abort the pending transfer requests, in array order.  */
+    for (index = 0; index < count; index ++)
+        _ux_host_stack_transfer_request_abort(&transfer_request[index]);
+
+    /* Detach the transfer requests from the endpoint.  */
+    endpoint -> ux_endpoint_transfer_requests =        UX_NULL;
+    endpoint -> ux_endpoint_transfer_requests_count =  0;
+
+    /* Delete the semaphores.  */
+    for (index = 0; index < count; index ++)
+        _ux_host_semaphore_delete(&transfer_request[index].ux_transfer_request_semaphore);
+
+    /* Free the transfer requests.  */
+    _ux_utility_memory_free(transfer_request);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_stack_endpoint_transfer_requests_free     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in host stack endpoint transfer         */
+/*    requests free function call.                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    endpoint                              Pointer to endpoint           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_transfer_requests_free                      */
+/*                                          Free transfer requests        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_stack_endpoint_transfer_requests_free(UX_ENDPOINT *endpoint)
+{
+
+    /* Sanity check.  */
+    if (endpoint == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke transfer requests free function.  */
+    return(_ux_host_stack_endpoint_transfer_requests_free(endpoint));
+}
@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */
 /*                                                                        */
 /*    ux_device_class_audio.h                             PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -70,6 +70,12 @@
 /*                                            endpoint buffer in classes  */
 /*                                            with zero copy enabled,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added block samples access, */
+/*                                            added feedback control,     */
+/*                                            added streaming statistics, */
+/*                                            added mixer and router,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -90,15 +96,39 @@ extern   "C" {
 /* Compile option: if defined, audio feedback endpoint is supported.  */
 /* #define UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT  */
 
+/* Compile option: if defined, the feedback of an OUT stream can be computed by a
+   built-in PI controller driven by the stream FIFO level, instead of being pushed
+   by application through ux_device_class_audio_feedback_set.
+   It requires UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT.  */
+/* #define UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT  */
+
 /* Compile option: if defined, audio interrupt endpoint is supported.  */
 /* #define UX_DEVICE_CLASS_AUDIO_INTERRUPT_SUPPORT  */
 
+/* Compile option: if defined, block samples access supports float samples
+   (UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT) in application buffers.  */
+/* #define UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT  */
+
+/* Compile option: if defined, each stream records statistics of its transfers
+   (intervals, FIFO level histogram, feedback and xruns), that application reads
+   through ux_device_class_audio_ioctl.  */
+/* #define UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT  */
+
+/* Compile option: if defined, a mixer stage mixes several OUT streams to an
+   application buffer and routes an application buffer to several IN streams,
+   with gains of feature unit mute and volume controls.  */
+/* #define UX_DEVICE_CLASS_AUDIO_MIXER_SUPPORT  */
+
 /* Internal option: enable the basic USBX error checking. This define is typically used
    while debugging application.  */
 #if defined(UX_ENABLE_ERROR_CHECKING) && !defined(UX_DEVICE_CLASS_AUDIO_ENABLE_ERROR_CHECKING)
 #define UX_DEVICE_CLASS_AUDIO_ENABLE_ERROR_CHECKING
 #endif
 
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT) && !defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+#error UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT must be defined to use UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT
+#endif
+
 
 /* Works if UX_DEVICE_ENDPOINT_BUFFER_OWNER is 1.
      If defined, it represents feedback endpoint buffer size.
@@ -110,6 +140,24 @@ extern   "C" {
 #define UX_DEVICE_CLASS_AUDIO_FEEDBACK_THREAD_STACK_SIZE            UX_THREAD_STACK_SIZE
 #define UX_DEVICE_CLASS_AUDIO_INTERRUPT_THREAD_STACK_SIZE           UX_THREAD_STACK_SIZE
 
+/* Define Audio Class statistics constants.
+     TIME_GET: time stamp of transfers, could be redefined for a finer timer.
+     LEVELS:   number of FIFO level histogram entries, last one counts all higher levels.
+     RECORDS:  number of last transfers recorded (power of 2), 0 to disable records.
+ */
+#ifndef UX_DEVICE_CLASS_AUDIO_STATISTICS_TIME_GET
+#define UX_DEVICE_CLASS_AUDIO_STATISTICS_TIME_GET()                 _ux_utility_time_get()
+#endif
+#ifndef UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS
+#define UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS                     16
+#endif
+#ifndef UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS
+#define UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS                    8
+#endif
+#if (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS & (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS - 1)) != 0
+#error UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS must be a power of 2
+#endif
+
 /* Define Audio Class function (AF) constants.  */
 
 #define UX_DEVICE_CLASS_AUDIO_FUNCTION_CLASS                        1
@@ -332,6 +380,39 @@ extern   "C" {
  */
 
 #define UX_DEVICE_CLASS_AUDIO_IOCTL_GET_ARG                         1
+#define UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET                  2
+#define UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_RESET                3
+
+/* Define formats of samples in application buffers, for block samples access.
+     PCM:   as in the stream, subframe size bytes per sample.
+     PCM16: signed 16-bit samples (SHORT).
+     Q31:   signed samples left justified in 32 bits (LONG).
+     FLOAT: float samples in [-1, 1).
+ */
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM                           0
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM16                         1
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31                           2
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT                         3
+
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_FORMAT_MAX                    UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT
+#else
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_FORMAT_MAX                    UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31
+#endif
+
+/* Size of a sample in application buffers.  */
+#define UX_DEVICE_CLASS_AUDIO_SAMPLES_SIZE(format, subframe_size)   (((format) == UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM) ? (subframe_size) : \
+                                                                     ((format) == UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM16) ? 2u : 4u)
+
+/* Define Audio Class mixer gains, Q15 linear gains (unity is 0x8000).
+   Volume controls are in 1/256 dB, 0x8000 is -infinity dB.  */
+#define UX_DEVICE_CLASS_AUDIO_MIXER_GAIN_UNITY                      0x8000u
+#define UX_DEVICE_CLASS_AUDIO_MIXER_VOLUME_SILENCE                  ((SHORT)-32768)
+
+/* Define Audio Class feedback control formats.  */
+#define UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO                  0   /* 10.14 for FS, 16.16 for HS.  */
+#define UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_10_14                 1
+#define UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16                 2
 
 /* Define Audio Class Task states.  */
 #define UX_DEVICE_CLASS_AUDIO_INTERRUPT_STOP            (UX_STATE_RESET)
@@ -406,6 +487,106 @@ typedef struct UX_DEVICE_CLASS_AUDIO_PARAMETER_STRUCT
 } UX_DEVICE_CLASS_AUDIO_PARAMETER;
 
 
+/* Define Audio Class block samples access structure.  */
+
+typedef struct UX_DEVICE_CLASS_AUDIO_SAMPLES_STRUCT
+{
+
+    VOID                                   *ux_device_class_audio_samples_buffer;
+    ULONG                                   ux_device_class_audio_samples_format;
+    ULONG                                   ux_device_class_audio_samples_channels;
+    ULONG                                   ux_device_class_audio_samples_subframe_size;  /* Bytes per sample in stream, 1 to 4.  */
+    ULONG                                   ux_device_class_audio_samples_planar_stride;  /* Samples between channels, 0 if interleaved.  */
+    ULONG                                   ux_device_class_audio_samples_packet_frames;  /* Frames per packet written, 0 for max.  */
+} UX_DEVICE_CLASS_AUDIO_SAMPLES;
+
+
+/* Define Audio Class feedback control structures.
+   Rates are in samples per millisecond, 16.16 fixed point (48kHz is 48 << 16).
+   Levels are in audio frames (samples of all channels).  */
+
+typedef struct UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER_STRUCT
+{
+
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_sample_rate;   /* In Hz.  */
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_frame_bytes;   /* Bytes per audio frame.  */
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_target_level;
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_kp;            /* Rate per level error, 16.16, up to 0xFFFF.  */
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_ki;            /* Rate per level error sum, 16.16, up to 0xFFFF.  */
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_max_deviation; /* In ppm of nominal rate.  */
+    ULONG                                   ux_device_class_audio_feedback_control_parameter_format;
+} UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER;
+
+typedef struct UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_STRUCT
+{
+
+    ULONG                                   ux_device_class_audio_feedback_control_nominal_rate;
+    ULONG                                   ux_device_class_audio_feedback_control_codec_rate;      /* Measured, 0 to use nominal.  */
+    ULONG                                   ux_device_class_audio_feedback_control_frame_bytes;     /* 0 if control disabled.  */
+    ULONG                                   ux_device_class_audio_feedback_control_target_level;
+    LONG                                    ux_device_class_audio_feedback_control_kp;
+    LONG                                    ux_device_class_audio_feedback_control_ki;
+    LONG                                    ux_device_class_audio_feedback_control_max_deviation;
+    LONG                                    ux_device_class_audio_feedback_control_integral_limit;
+    LONG                                    ux_device_class_audio_feedback_control_integral;
+    ULONG                                   ux_device_class_audio_feedback_control_format;
+
+    /* Telemetry, reset on alternate setting change.  */
+    ULONG                                   ux_device_class_audio_feedback_control_level;
+    ULONG                                   ux_device_class_audio_feedback_control_level_min;
+    ULONG                                   ux_device_class_audio_feedback_control_level_max;
+    LONG                                    ux_device_class_audio_feedback_control_rate_error;      /* Rate sent minus nominal rate.  */
+    ULONG                                   ux_device_class_audio_feedback_control_rate;            /* Rate sent.  */
+    ULONG                                   ux_device_class_audio_feedback_control_updates;
+} UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL;
+
+
+/* Define Audio Class stream statistics structures.
+   Times are in UX_DEVICE_CLASS_AUDIO_STATISTICS_TIME_GET unit, jitter is interval max - min.
+   Levels are in frame buffers holding data after a transfer is done.
+   Feedback is the last value sent or received, as encoded on bus.
+   Records keep the last transfers, transfer N in records[N & (RECORDS - 1)].  */
+
+typedef struct UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORD_STRUCT
+{
+
+    ULONG                                   ux_device_class_audio_statistics_record_time;
+    ULONG                                   ux_device_class_audio_statistics_record_length;
+    ULONG                                   ux_device_class_audio_statistics_record_level;
+} UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORD;
+
+typedef struct UX_DEVICE_CLASS_AUDIO_STATISTICS_STRUCT
+{
+
+    ULONG                                   ux_device_class_audio_statistics_transfers;
+    ULONG                                   ux_device_class_audio_statistics_bytes;
+    ULONG                                   ux_device_class_audio_statistics_time;              /* Last transfer done.  */
+    ULONG                                   ux_device_class_audio_statistics_interval_min;
+    ULONG                                   ux_device_class_audio_statistics_interval_max;
+    ULONG                                   ux_device_class_audio_statistics_interval_sum;      /* Of transfers - 1 intervals.  */
+    ULONG                                   ux_device_class_audio_statistics_level;
+    ULONG                                   ux_device_class_audio_statistics_level_min;
+    ULONG                                   ux_device_class_audio_statistics_level_max;
+    ULONG                                   ux_device_class_audio_statistics_level_histogram[UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS];
+    ULONG                                   ux_device_class_audio_statistics_feedback;
+    ULONG                                   ux_device_class_audio_statistics_feedback_min;
+    ULONG                                   ux_device_class_audio_statistics_feedback_max;
+    ULONG                                   ux_device_class_audio_statistics_xruns;
+    ULONG                                   ux_device_class_audio_statistics_xrun_time;         /* Last xrun.  */
+    ULONG                                   ux_device_class_audio_statistics_error_count;       /* Stream buffer errors counted.  */
+#if UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS > 0
+    UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORD ux_device_class_audio_statistics_records[UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS];
+#endif
+} UX_DEVICE_CLASS_AUDIO_STATISTICS;
+
+typedef struct UX_DEVICE_CLASS_AUDIO_STATISTICS_PARAMETER_STRUCT
+{
+
+    ULONG                                   ux_device_class_audio_statistics_parameter_stream_index;
+    UX_DEVICE_CLASS_AUDIO_STATISTICS       *ux_device_class_audio_statistics_parameter_statistics;  /* Copy to, could be NULL on reset.  */
+} UX_DEVICE_CLASS_AUDIO_STATISTICS_PARAMETER;
+
+
 /* Define Audio Class instance structure.  */
 
 typedef struct UX_DEVICE_CLASS_AUDIO_FRAME_STRUCT
@@ -439,6 +620,10 @@ typedef struct UX_DEVICE_CLASS_AUDIO_STREAM_STRUCT
     UINT                                     ux_device_class_audio_stream_feedback_task_state;
     UINT                                     ux_device_class_audio_stream_feedback_task_status;
 #endif
+
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+    UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL   ux_device_class_audio_stream_feedback_control;
+#endif
 #endif
 
     UX_DEVICE_CLASS_AUDIO_STREAM_CALLBACKS   ux_device_class_audio_stream_callbacks;
@@ -456,9 +641,15 @@ typedef struct UX_DEVICE_CLASS_AUDIO_STREAM_STRUCT
     ULONG                                    ux_device_class_audio_stream_buffer_size;
     ULONG                                    ux_device_class_audio_stream_frame_buffer_size;
     ULONG                                    ux_device_class_audio_stream_buffer_error_count;
+    ULONG                                    ux_device_class_audio_stream_underrun_count;
+    ULONG                                    ux_device_class_audio_stream_overrun_count;
 
     UX_DEVICE_CLASS_AUDIO_FRAME             *ux_device_class_audio_stream_transfer_pos;
     UX_DEVICE_CLASS_AUDIO_FRAME             *ux_device_class_audio_stream_access_pos;
+
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+    UX_DEVICE_CLASS_AUDIO_STATISTICS         ux_device_class_audio_stream_statistics;
+#endif
 } UX_DEVICE_CLASS_AUDIO_STREAM;
 
 typedef struct UX_DEVICE_CLASS_AUDIO_STRUCT
@@ -498,6 +689,34 @@ typedef struct UX_DEVICE_CLASS_AUDIO_STRUCT
 } UX_DEVICE_CLASS_AUDIO;
 
 
+/* Define Audio Class mixer structures.
+   All ports of a mixer have the mixer channels, mixed samples are Q31 interleaved.
+   Mute and volume point to feature unit controls (e.g. ux_device_class_audio20_control_mute
+   and ux_device_class_audio20_control_volume) updated by the control process, they
+   are read for each block. Positive volumes are taken as 0 dB.  */
+
+typedef struct UX_DEVICE_CLASS_AUDIO_MIXER_PORT_STRUCT
+{
+
+    UX_DEVICE_CLASS_AUDIO_STREAM           *ux_device_class_audio_mixer_port_stream;
+    ULONG                                   ux_device_class_audio_mixer_port_subframe_size;   /* Bytes per sample in stream, 1 to 4.  */
+    USHORT                                 *ux_device_class_audio_mixer_port_mute;            /* UX_NULL if no mute control.  */
+    SHORT                                  *ux_device_class_audio_mixer_port_volume;          /* UX_NULL if no volume control.  */
+} UX_DEVICE_CLASS_AUDIO_MIXER_PORT;
+
+typedef struct UX_DEVICE_CLASS_AUDIO_MIXER_STRUCT
+{
+
+    ULONG                                   ux_device_class_audio_mixer_channels;
+    ULONG                                   ux_device_class_audio_mixer_frames;         /* Frames per block, e.g. per frame interval.  */
+    LONG                                   *ux_device_class_audio_mixer_work;           /* Frames * channels samples.  */
+    ULONG                                   ux_device_class_audio_mixer_inputs_nb;
+    UX_DEVICE_CLASS_AUDIO_MIXER_PORT       *ux_device_class_audio_mixer_inputs;         /* OUT streams mixed.  */
+    ULONG                                   ux_device_class_audio_mixer_outputs_nb;
+    UX_DEVICE_CLASS_AUDIO_MIXER_PORT       *ux_device_class_audio_mixer_outputs;        /* IN streams routed to.  */
+} UX_DEVICE_CLASS_AUDIO_MIXER;
+
+
 /* Define Audio Class function prototypes.  */
 
 UINT    _ux_device_class_audio_initialize(UX_SLAVE_CLASS_COMMAND *command);
@@ -524,6 +743,15 @@ UINT    _ux_device_class_audio_sample_read16(UX_DEVICE_CLASS_AUDIO_STREAM *audio
 UINT    _ux_device_class_audio_sample_read24(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG *sample);
 UINT    _ux_device_class_audio_sample_read32(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG *sample);
 
+UINT    _ux_device_class_audio_samples_read(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                            ULONG frames, ULONG *actual_frames);
+UINT    _ux_device_class_audio_samples_write(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                             ULONG frames, ULONG *actual_frames);
+VOID    _ux_device_class_audio_samples_decode(UCHAR *source, ULONG source_step, ULONG subframe_size,
+                                              VOID *destination, ULONG format, ULONG count);
+VOID    _ux_device_class_audio_samples_encode(VOID *source, ULONG format, UCHAR *destination,
+                                              ULONG destination_step, ULONG subframe_size, ULONG count);
+
 UINT    _ux_device_class_audio_read_frame_get(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UCHAR **frame_data, ULONG *frame_length);
 UINT    _ux_device_class_audio_read_frame_free(UX_DEVICE_CLASS_AUDIO_STREAM *audio);
 
@@ -537,8 +765,19 @@ VOID    _ux_device_class_audio_feedback_thread_entry(ULONG audio_stream);
 UINT    _ux_device_class_audio_feedback_task_function(UX_DEVICE_CLASS_AUDIO_STREAM *stream);
 UINT    _ux_device_class_audio_feedback_set(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UCHAR *encoded_feedback);
 UINT    _ux_device_class_audio_feedback_get(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UCHAR *encoded_feedback);
+UINT    _ux_device_class_audio_feedback_control_set(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER *parameter);
+UINT    _ux_device_class_audio_feedback_control_rate_set(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG codec_rate);
+UINT    _ux_device_class_audio_feedback_control_update(UX_DEVICE_CLASS_AUDIO_STREAM *audio);
 ULONG   _ux_device_class_audio_speed_get(UX_DEVICE_CLASS_AUDIO_STREAM *audio);
 
+VOID    _ux_device_class_audio_statistics_update(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG length);
+
+UINT    _ux_device_class_audio_mixer_mix(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *output);
+UINT    _ux_device_class_audio_mixer_route(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *input);
+ULONG   _ux_device_class_audio_mixer_gain_get(UX_DEVICE_CLASS_AUDIO_MIXER_PORT *port);
+VOID    _ux_device_class_audio_mixer_gain_apply(LONG *source, LONG *destination, ULONG gain,
+                                                ULONG count, ULONG accumulate);
+
 VOID    _ux_device_class_audio_interrupt_thread_entry(ULONG audio_inst);
 UINT    _ux_device_class_audio_interrupt_task_function(UX_DEVICE_CLASS_AUDIO *audio);
 UINT    _ux_device_class_audio_interrupt_send(UX_DEVICE_CLASS_AUDIO *audio, UCHAR *int_data);
@@ -563,6 +802,11 @@ UINT    _uxe_device_class_audio_sample_read16(UX_DEVICE_CLASS_AUDIO_STREAM *audi
 UINT    _uxe_device_class_audio_sample_read24(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG *sample);
 UINT    _uxe_device_class_audio_sample_read32(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG *sample);
 
+UINT    _uxe_device_class_audio_samples_read(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                             ULONG frames, ULONG *actual_frames);
+UINT    _uxe_device_class_audio_samples_write(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                              ULONG frames, ULONG *actual_frames);
+
 UINT    _uxe_device_class_audio_read_frame_get(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UCHAR **frame_data, ULONG *frame_length);
 UINT    _uxe_device_class_audio_read_frame_free(UX_DEVICE_CLASS_AUDIO_STREAM *audio);
 
@@ -574,6 +818,11 @@ UINT    _uxe_device_class_audio_write_frame_commit(UX_DEVICE_CLASS_AUDIO_STREAM
 
 UINT    _uxe_device_class_audio_feedback_set(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UCHAR *encoded_feedback);
 UINT    _uxe_device_class_audio_feedback_get(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UCHAR *encoded_feedback);
+UINT    _uxe_device_class_audio_feedback_control_set(UX_DEVICE_CLASS_AUDIO_STREAM *audio, UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER *parameter);
+UINT    _uxe_device_class_audio_feedback_control_rate_set(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG codec_rate);
+UINT    _uxe_device_class_audio_feedback_control_update(UX_DEVICE_CLASS_AUDIO_STREAM *audio);
+UINT    _uxe_device_class_audio_mixer_mix(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *output);
+UINT    _uxe_device_class_audio_mixer_route(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *input);
 ULONG   _uxe_device_class_audio_speed_get(UX_DEVICE_CLASS_AUDIO_STREAM *audio);
 
 VOID    _uxe_device_class_audio_interrupt_thread_entry(ULONG audio_inst);
@@ -601,6 +850,9 @@ UINT    _uxe_device_class_audio_interrupt_send(UX_DEVICE_CLASS_AUDIO *audio, UCH
 #define ux_device_class_audio_sample_read24           _uxe_device_class_audio_sample_read24
 #define ux_device_class_audio_sample_read32           _uxe_device_class_audio_sample_read32
 
+#define ux_device_class_audio_samples_read            _uxe_device_class_audio_samples_read
+#define ux_device_class_audio_samples_write           _uxe_device_class_audio_samples_write
+
 #define ux_device_class_audio_read_frame_get          _uxe_device_class_audio_read_frame_get
 #define ux_device_class_audio_read_frame_free         _uxe_device_class_audio_read_frame_free
 
@@ -617,6 +869,12 @@ UINT    _uxe_device_class_audio_interrupt_send(UX_DEVICE_CLASS_AUDIO *audio, UCH
 #define ux_device_class_audio_feedback_task_function  _ux_device_class_audio_feedback_task_function
 #define ux_device_class_audio_feedback_get            _uxe_device_class_audio_feedback_get
 #define ux_device_class_audio_feedback_set            _uxe_device_class_audio_feedback_set
+#define ux_device_class_audio_feedback_control_set    _uxe_device_class_audio_feedback_control_set
+#define ux_device_class_audio_feedback_control_rate_set _uxe_device_class_audio_feedback_control_rate_set
+#define ux_device_class_audio_feedback_control_update _uxe_device_class_audio_feedback_control_update
+
+#define ux_device_class_audio_mixer_mix               _uxe_device_class_audio_mixer_mix
+#define ux_device_class_audio_mixer_route             _uxe_device_class_audio_mixer_route
 
 #define ux_device_class_audio_interrupt_send          _uxe_device_class_audio_interrupt_send
 
@@ -638,6 +896,9 @@ UINT    _uxe_device_class_audio_interrupt_send(UX_DEVICE_CLASS_AUDIO *audio, UCH
 #define ux_device_class_audio_sample_read24           _ux_device_class_audio_sample_read24
 #define ux_device_class_audio_sample_read32           _ux_device_class_audio_sample_read32
 
+#define ux_device_class_audio_samples_read            _ux_device_class_audio_samples_read
+#define ux_device_class_audio_samples_write           _ux_device_class_audio_samples_write
+
 #define ux_device_class_audio_read_frame_get          _ux_device_class_audio_read_frame_get
 #define ux_device_class_audio_read_frame_free         _ux_device_class_audio_read_frame_free
 
@@ -654,6 +915,12 @@ UINT    _uxe_device_class_audio_interrupt_send(UX_DEVICE_CLASS_AUDIO *audio, UCH
 #define ux_device_class_audio_feedback_task_function  _ux_device_class_audio_feedback_task_function
 #define ux_device_class_audio_feedback_get            _ux_device_class_audio_feedback_get
 #define ux_device_class_audio_feedback_set            _ux_device_class_audio_feedback_set
+#define ux_device_class_audio_feedback_control_set    _ux_device_class_audio_feedback_control_set
+#define ux_device_class_audio_feedback_control_rate_set _ux_device_class_audio_feedback_control_rate_set
+#define ux_device_class_audio_feedback_control_update _ux_device_class_audio_feedback_control_update
+
+#define ux_device_class_audio_mixer_mix               _ux_device_class_audio_mixer_mix
+#define ux_device_class_audio_mixer_route             _ux_device_class_audio_mixer_route
 
 #define ux_device_class_audio_interrupt_send          _ux_device_class_audio_interrupt_send
 
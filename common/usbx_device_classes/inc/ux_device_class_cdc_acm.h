@@ -24,7 +24,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_device_class_cdc_acm.h                           PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -64,6 +64,11 @@
 /*                                            endpoint buffer in classes, */
 /*                                            added error checks support, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            reception ring support,     */
+/*                                            added write coalescing      */
+/*                                            support,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -108,6 +113,61 @@ extern   "C" {
  */
 /* #define UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY  */
 
+/* Option: streaming reception with a ring buffer owned by the class.
+    Works in RTOS mode with transmission enabled (the bulk OUT thread is used).
+    Defined, once the reception ring is started by UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_START the
+    bulk OUT endpoint is kept armed by the bulk OUT thread and received data is appended to the ring.
+    If the DCD supports queued transfer requests, several packets are kept queued on the endpoint,
+    otherwise a single packet transfer is re-armed after each packet.
+    The application drains the ring without waiting, by read_available, read_peek and read.
+    A packet is queued only if the ring has room for it, when there is no room for any packet
+    the endpoint is not armed and the host is NAKed.
+ */
+/* #define UX_DEVICE_CLASS_CDC_ACM_READ_RING  */
+
+/* Option: reception ring buffer size, used if UX_DEVICE_CLASS_CDC_ACM_READ_RING is defined.
+    It should be a few times larger than the bulk out endpoint max packet size.  */
+#ifndef UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE
+#define UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE                   2048
+#endif
+
+/* Option: number of packets queued on the bulk out endpoint by the reception ring, used if
+    UX_DEVICE_CLASS_CDC_ACM_READ_RING is defined and the DCD supports queued transfer requests.
+    Each packet has a buffer of UX_DEVICE_CLASS_CDC_ACM_READ_BUFFER_SIZE bytes.  */
+#ifndef UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT
+#define UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT                4
+#endif
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING) &&                               \
+    (defined(UX_DEVICE_STANDALONE) || defined(UX_DEVICE_CLASS_CDC_ACM_TRANSMISSION_DISABLE))
+#error UX_DEVICE_CLASS_CDC_ACM_READ_RING needs the bulk OUT thread, not available in standalone mode or with transmission disabled
+#endif
+
+/* Option: coalescing transmission with a ring buffer owned by the class.
+    Works in RTOS mode with transmission enabled and zero copy disabled (the bulk IN thread is used).
+    Defined, once coalescing is enabled by UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE (with the
+    latency deadline in ms), write_with_callback appends data to the ring and returns. Full packets
+    are sent as soon as possible, the remaining short packet is sent when the oldest byte pending
+    reaches the latency deadline, or on UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH.
+    Coalescing is off until the ioctl sets a non-zero latency, and it is off again with zero latency.
+    While it is on, the write callback reports batches, not writes: it is invoked once per batch sent
+    from the ring with the length of the batch, which may hold several writes or a part of one.
+    The application counts bytes to know which writes are done. A write that does not fit in the
+    ring returns UX_BUFFER_OVERFLOW and is not reported.
+ */
+/* #define UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE  */
+
+/* Option: coalescing ring buffer size, used if UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE is defined.  */
+#ifndef UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE
+#define UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE              2048
+#endif
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE) &&                          \
+    (defined(UX_DEVICE_STANDALONE) || defined(UX_DEVICE_CLASS_CDC_ACM_TRANSMISSION_DISABLE) || \
+     defined(UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY))
+#error UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE needs the bulk IN thread and class write buffer, not available in standalone mode, with transmission disabled or zero copy
+#endif
+
 /* Internal: check if class own endpoint buffer  */
 #if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) &&                                   \
     (!defined(UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY) ||                             \
@@ -187,9 +247,14 @@ extern   "C" {
 #define UX_SLAVE_CLASS_CDC_ACM_IOCTL_TRANSMISSION_STOP                  7
 #define UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_READ_TIMEOUT                   8
 #define UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_TIMEOUT                  9
+#define UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_START                    10
+#define UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_STOP                     11
+#define UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE                 12
+#define UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH                        13
 
 /* Define event group flag.  */
 #define UX_DEVICE_CLASS_CDC_ACM_WRITE_EVENT                             1
+#define UX_DEVICE_CLASS_CDC_ACM_READ_RING_EVENT                         2
 
 
 /* CDC ACM read state machine states.  */
@@ -271,6 +336,25 @@ typedef struct UX_SLAVE_CLASS_CDC_ACM_STRUCT
     UCHAR                               *ux_slave_class_cdc_acm_callback_data_pointer;
     UCHAR                               *ux_slave_class_cdc_acm_callback_current_data_pointer;
 #endif
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+    UCHAR                               *ux_device_class_cdc_acm_read_ring_buffer;
+    UCHAR                               *ux_device_class_cdc_acm_read_ring_packets;
+    ULONG                               ux_device_class_cdc_acm_read_ring_head;
+    ULONG                               ux_device_class_cdc_acm_read_ring_tail;
+    ULONG                               ux_device_class_cdc_acm_read_ring_count;
+    UINT                                ux_device_class_cdc_acm_read_ring_status;
+    UINT                                ux_device_class_cdc_acm_read_ring_waiting;
+#endif
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+    UCHAR                               *ux_device_class_cdc_acm_write_coalesce_buffer;
+    ULONG                               ux_device_class_cdc_acm_write_coalesce_head;
+    ULONG                               ux_device_class_cdc_acm_write_coalesce_tail;
+    ULONG                               ux_device_class_cdc_acm_write_coalesce_count;
+    ULONG                               ux_device_class_cdc_acm_write_coalesce_latency;
+    ULONG                               ux_device_class_cdc_acm_write_coalesce_time;
+    UINT                                ux_device_class_cdc_acm_write_coalesce_flush;
+    ULONG                               ux_device_class_cdc_acm_write_coalesce_reset;
+#endif
 #endif
 } UX_SLAVE_CLASS_CDC_ACM;
 
@@ -382,6 +466,10 @@ UINT  _ux_device_class_cdc_acm_read_run(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *
 
 UINT  _ux_device_class_cdc_acm_tasks_run(VOID *instance);
 
+UINT  _ux_device_class_cdc_acm_read_available(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, ULONG *available_length);
+UINT  _ux_device_class_cdc_acm_read_peek(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
+                                ULONG requested_length, ULONG *actual_length);
+
 UINT  _uxe_device_class_cdc_acm_read(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
                                     ULONG requested_length, ULONG *actual_length);
 UINT  _uxe_device_class_cdc_acm_write(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
@@ -394,6 +482,9 @@ UINT  _uxe_device_class_cdc_acm_write_run(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR
                                 ULONG requested_length, ULONG *actual_length);
 UINT  _uxe_device_class_cdc_acm_read_run(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
                                 ULONG requested_length, ULONG *actual_length);
+UINT  _uxe_device_class_cdc_acm_read_available(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, ULONG *available_length);
+UINT  _uxe_device_class_cdc_acm_read_peek(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
+                                ULONG requested_length, ULONG *actual_length);
 
 /* Define Device CDC Class API prototypes.  */
 #define ux_device_class_cdc_acm_entry               _ux_device_class_cdc_acm_entry
@@ -408,6 +499,9 @@ UINT  _uxe_device_class_cdc_acm_read_run(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR
 #define ux_device_class_cdc_acm_read_run            _uxe_device_class_cdc_acm_read_run
 #define ux_device_class_cdc_acm_write_run           _uxe_device_class_cdc_acm_write_run
 
+#define ux_device_class_cdc_acm_read_available      _uxe_device_class_cdc_acm_read_available
+#define ux_device_class_cdc_acm_read_peek           _uxe_device_class_cdc_acm_read_peek
+
 #else
 
 #define ux_device_class_cdc_acm_read                _ux_device_class_cdc_acm_read
@@ -418,6 +512,9 @@ UINT  _uxe_device_class_cdc_acm_read_run(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR
 #define ux_device_class_cdc_acm_read_run            _ux_device_class_cdc_acm_read_run
 #define ux_device_class_cdc_acm_write_run           _ux_device_class_cdc_acm_write_run
 
+#define ux_device_class_cdc_acm_read_available      _ux_device_class_cdc_acm_read_available
+#define ux_device_class_cdc_acm_read_peek           _ux_device_class_cdc_acm_read_peek
+
 #endif
 
 /* Determine if a C++ compiler is being used.  If so, complete the standard 
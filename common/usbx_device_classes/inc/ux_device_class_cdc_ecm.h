@@ -60,6 +60,9 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            packet lend option,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -106,6 +109,15 @@ VOID  _ux_network_driver_link_down(VOID *ux_network_handle);
  */
 /* #define UX_DEVICE_CLASS_CDC_ECM_ZERO_COPY  */
 
+/* Option: defined, it enables reception of frames directly in NX packets lent as bulk OUT
+    transfer buffer (works if CDC_ECM owns endpoint buffer and zero copy is not enabled).
+    If the packet payload can not hold a frame, the endpoint buffer is used and data is copied.
+ */
+/* #define UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND  */
+#if (UX_DEVICE_ENDPOINT_BUFFER_OWNER != 1) || defined(UX_DEVICE_CLASS_CDC_ECM_ZERO_COPY)
+#undef UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND
+#endif
+
 
 /* Bulk out endpoint buffer size, must be larger than endpoint and ethernet max packet size, and aligned in 4-bytes.  */
 #if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_CDC_ECM_ZERO_COPY)
@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */
 /*                                                                        */
 /*    ux_device_class_hid.h                               PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -70,6 +70,10 @@
 /*                                            endpoint buffer in classes, */
 /*                                            moved build option check,   */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added events coalescing and */
+/*                                            events queue statistics,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -132,6 +136,27 @@ extern   "C" {
 #endif
 #endif
 
+/* Option: defined, it enables events coalescing. If the parameter _event_coalesce is set,
+    an event replaces the events of the same report ID still waiting in the queue, so that
+    only the latest state of each report is sent. The replaced events are skipped by the
+    interrupt thread, the new event takes its place at the head of the queue. If the queue
+    is full, the new event replaces the data of the newest pending event of its report ID
+    instead and the older pending ones of that report are skipped, the event being sent is
+    never replaced; it is dropped only if there is none.
+    The events queue has a single producer (ux_device_class_hid_event_set, from one thread
+    or ISR) and a single consumer (the HID interrupt thread or task), each updating its own
+    end of the queue. With coalescing, the producer disables interrupts only to mark the
+    replaced events and publish the new one, never while copying report data: a pending
+    event being replaced is marked as being written and the consumer waits at it until its
+    report ID is set back.
+ */
+/* #define UX_DEVICE_CLASS_HID_EVENT_COALESCE  */
+
+/* Option: defined, it enables the events queue statistics: queued, coalesced and dropped
+    events, queue depth high water, and the age of the events in ticks when they are sent.
+ */
+/* #define UX_DEVICE_CLASS_HID_EVENT_STATISTICS  */
+
 /* Internal: check if class own endpoint buffer  */
 #if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1)
 #define UX_DEVICE_CLASS_HID_OWN_ENDPOINT_BUFFER
@@ -210,6 +235,12 @@ extern   "C" {
 
 #define UX_DEVICE_CLASS_HID_EVENTS_ALL_MASK                         7u /* Mask all event flags.  */
 
+/* Report ID of a queued event replaced by a newer one.  */
+#define UX_DEVICE_CLASS_HID_EVENT_COALESCED                         0xFFFFFFFFu
+
+/* Report ID of a queued event being replaced, it is not sent until its report ID is set back.  */
+#define UX_DEVICE_CLASS_HID_EVENT_WRITING                           0xFFFFFFFEu
+
 typedef struct UX_SLAVE_CLASS_HID_EVENT_STRUCT
 {
     ULONG                   ux_device_class_hid_event_report_id;
@@ -228,6 +259,17 @@ typedef struct UX_DEVICE_CLASS_HID_EVENT_STRUCT
     UCHAR                   *ux_device_class_hid_event_buffer;
 } UX_DEVICE_CLASS_HID_EVENT;
 
+/* Events queue statistics.  */
+typedef struct UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS_STRUCT
+{
+    ULONG                   ux_device_class_hid_event_statistics_queued;
+    ULONG                   ux_device_class_hid_event_statistics_coalesced;
+    ULONG                   ux_device_class_hid_event_statistics_dropped;
+    ULONG                   ux_device_class_hid_event_statistics_depth_high_water;
+    ULONG                   ux_device_class_hid_event_statistics_age_last;
+    ULONG                   ux_device_class_hid_event_statistics_age_max;
+} UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS;
+
 #if defined(UX_DEVICE_CLASS_HID_FLEXIBLE_EVENTS_QUEUE)
 #define UX_DEVICE_CLASS_HID_EVENT_BUFFER(e)     ((e)->ux_device_class_hid_event_buffer)
 #else
@@ -272,6 +314,14 @@ typedef struct UX_SLAVE_CLASS_HID_STRUCT
 #if defined(UX_DEVICE_CLASS_HID_FLEXIBLE_EVENTS_QUEUE)
     ULONG                           ux_device_class_hid_event_max_length;
 #endif
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+    ULONG                           ux_device_class_hid_event_coalesce;
+#endif
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+    ULONG                           *ux_device_class_hid_event_times;
+    UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS
+                                    ux_device_class_hid_event_statistics;
+#endif
 
 #if defined(UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT)
     UX_SLAVE_ENDPOINT               *ux_device_class_hid_read_endpoint;
@@ -313,6 +363,22 @@ typedef struct UX_SLAVE_CLASS_HID_STRUCT
 #define UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid)  sizeof(UX_SLAVE_CLASS_HID_EVENT)
 #endif
 
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+
+/* Internal: move an event pointer to the next event of the queue.  */
+#define UX_DEVICE_CLASS_HID_EVENT_QUEUE_NEXT(hid, e) do {                                          \
+        (e) = (UX_DEVICE_CLASS_HID_EVENT *)((UCHAR *)(e) + UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid)); \
+        if ((UCHAR *)(e) >= (UCHAR *)(hid) -> ux_device_class_hid_event_array_end)                  \
+            (e) = (hid) -> ux_device_class_hid_event_array;                                        \
+    } while(0)
+
+/* Internal: check if a queued event is pending for the report of an event.  */
+#define UX_DEVICE_CLASS_HID_EVENT_SAME_REPORT(hid, e, event)                                       \
+    ((e) -> ux_device_class_hid_event_report_id < UX_DEVICE_CLASS_HID_EVENT_WRITING &&             \
+     ((hid) -> ux_device_class_hid_report_id != UX_TRUE ||                                         \
+      (e) -> ux_device_class_hid_event_report_id == (event) -> ux_device_class_hid_event_report_id))
+#endif
+
 
 /* HID interrupt OUT support extensions.  */
 
@@ -370,6 +436,9 @@ typedef struct UX_SLAVE_CLASS_HID_PARAMETER_STRUCT
     ULONG                   ux_device_class_hid_parameter_event_max_number;
     ULONG                   ux_device_class_hid_parameter_event_max_length;
 #endif
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+    ULONG                   ux_device_class_hid_parameter_event_coalesce;
+#endif
 #if defined(UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT)
     UINT                    (*ux_device_class_hid_parameter_receiver_initialize)(UX_SLAVE_CLASS_HID *hid, struct UX_SLAVE_CLASS_HID_PARAMETER_STRUCT *parameter, UX_DEVICE_CLASS_HID_RECEIVER **receiver);
     ULONG                   ux_device_class_hid_parameter_receiver_event_max_number;
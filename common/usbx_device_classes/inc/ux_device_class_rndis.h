@@ -61,6 +61,9 @@
 /*                                            endpoint buffer in classes, */
 /*                                            improved error checking,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            packet lend option,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -84,6 +87,15 @@ extern   "C" {
  */
 /* #define UX_DEVICE_CLASS_RNDIS_ZERO_COPY  */
 
+/* Option: defined, it enables reception of messages directly in NX packets lent as bulk OUT
+    transfer buffer (works if RNDIS owns endpoint buffer and zero copy is not enabled).
+    If the packet payload can not hold a message, the endpoint buffer is used and data is copied.
+ */
+/* #define UX_DEVICE_CLASS_RNDIS_PACKET_LEND  */
+#if (UX_DEVICE_ENDPOINT_BUFFER_OWNER != 1) || defined(UX_DEVICE_CLASS_RNDIS_ZERO_COPY)
+#undef UX_DEVICE_CLASS_RNDIS_PACKET_LEND
+#endif
+
 
 /* Bulk out endpoint buffer size (UX_DEVICE_CLASS_RNDIS_MAX_PACKET_TRANSFER_SIZE).  */
 #if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_RNDIS_ZERO_COPY)
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_audio_change                       PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -53,6 +53,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_system_error_handler          System error trap                 */
+/*    _ux_utility_memory_set            Set memory                        */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -89,6 +90,12 @@
 /*                                            endpoint buffer in classes  */
 /*                                            with zero copy enabled,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            reset underrun and overrun  */
+/*                                            counts,                     */
+/*                                            reset feedback control,     */
+/*                                            reset streaming statistics, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_audio_change(UX_SLAVE_CLASS_COMMAND *command)
@@ -255,6 +262,8 @@ ULONG                                    endpoint_dir;
 
         /* Now reset payload buffer error count.  */
         stream -> ux_device_class_audio_stream_buffer_error_count = 0;
+        stream -> ux_device_class_audio_stream_underrun_count = 0;
+        stream -> ux_device_class_audio_stream_overrun_count = 0;
 
         /* Now reset frame buffers.  */
         frame_buffer = stream -> ux_device_class_audio_stream_buffer;
@@ -270,6 +279,20 @@ ULONG                                    endpoint_dir;
         }
         stream -> ux_device_class_audio_stream_transfer_pos = stream -> ux_device_class_audio_stream_access_pos;
 
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+
+        /* Restart feedback control from nominal rate.  */
+        stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_integral = 0;
+        stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_rate_error = 0;
+        stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_updates = 0;
+#endif
+
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+        /* Restart stream statistics.  */
+        _ux_utility_memory_set(&stream -> ux_device_class_audio_stream_statistics, 0, sizeof(UX_DEVICE_CLASS_AUDIO_STATISTICS)); /* Use case of memset is verified. */
+#endif
+
 #if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT) && !defined(UX_DEVICE_STANDALONE)
 
         /* If feedback supported, resume the thread.  */
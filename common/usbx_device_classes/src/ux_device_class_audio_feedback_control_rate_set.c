@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_feedback_control_rate_set    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the sample rate measured on codec clock, as base */
+/*    of the feedback computed by the feedback control. The rate is in    */
+/*    samples per millisecond, 16.16 fixed point. Zero reverts to the     */
+/*    nominal sample rate.                                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    codec_rate                            Measured codec rate           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_feedback_control_rate_set(UX_DEVICE_CLASS_AUDIO_STREAM *stream, ULONG codec_rate)
+{
+#if !defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+    UX_PARAMETER_NOT_USED(stream);
+    UX_PARAMETER_NOT_USED(codec_rate);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+    /* Save measured rate, used on next update.  */
+    stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_codec_rate = codec_rate;
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_feedback_control_rate_set   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in codec rate setting function          */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    codec_rate                            Measured codec rate           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_feedback_control_rate_setSet codec rate      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_feedback_control_rate_set(UX_DEVICE_CLASS_AUDIO_STREAM *stream, ULONG codec_rate)
+{
+
+    /* Sanity check on input parameters.  */
+    if (stream == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Set codec rate.  */
+    return(_ux_device_class_audio_feedback_control_rate_set(stream, codec_rate));
+}
@@ -0,0 +1,203 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_feedback_control_set         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function configures the feedback control of an Audio stream.   */
+/*    Once configured, the feedback sent to host is computed from the     */
+/*    stream FIFO level each time it's polled, by a PI loop that adds a   */
+/*    bounded correction to the nominal (or measured codec) sample rate.  */
+/*    It should be invoked before the stream is started, e.g. in the      */
+/*    stream change callback. A NULL parameter disables the control.      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    parameter                             Feedback control parameter    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_feedback_control_set(UX_DEVICE_CLASS_AUDIO_STREAM *stream,
+                                                 UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER *parameter)
+{
+#if !defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+    UX_PARAMETER_NOT_USED(stream);
+    UX_PARAMETER_NOT_USED(parameter);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL      *control;
+ULONG                                       sample_rate;
+ULONG                                       nominal_rate;
+ULONG                                       max_deviation;
+
+
+    control = &stream -> ux_device_class_audio_stream_feedback_control;
+
+    /* Disable control, feedback is set by application.  */
+    if (parameter == UX_NULL)
+    {
+        control -> ux_device_class_audio_feedback_control_frame_bytes = 0;
+        return(UX_SUCCESS);
+    }
+
+    /* Check parameters.  */
+    sample_rate = parameter -> ux_device_class_audio_feedback_control_parameter_sample_rate;
+    if ((sample_rate == 0) ||
+        (parameter -> ux_device_class_audio_feedback_control_parameter_frame_bytes == 0) ||
+        (parameter -> ux_device_class_audio_feedback_control_parameter_kp > 0xFFFF) ||
+        (parameter -> ux_device_class_audio_feedback_control_parameter_ki > 0xFFFF) ||
+        (parameter -> ux_device_class_audio_feedback_control_parameter_format > UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16))
+        return(UX_INVALID_PARAMETER);
+
+    /* Nominal rate in samples per millisecond, 16.16.  */
+    nominal_rate = ((sample_rate / 1000) << 16) + (((sample_rate % 1000) << 16) / 1000);
+
+    /* Correction limit, in same unit.  */
+    max_deviation = parameter -> ux_device_class_audio_feedback_control_parameter_max_deviation;
+    if (max_deviation > 1000000)
+        max_deviation = 1000000;
+    max_deviation = (ULONG)(((ULONG64)nominal_rate * max_deviation) / 1000000);
+
+    /* Save settings.  */
+    control -> ux_device_class_audio_feedback_control_nominal_rate = nominal_rate;
+    control -> ux_device_class_audio_feedback_control_codec_rate = 0;
+    control -> ux_device_class_audio_feedback_control_target_level =
+                    parameter -> ux_device_class_audio_feedback_control_parameter_target_level;
+    control -> ux_device_class_audio_feedback_control_kp =
+                    (LONG)parameter -> ux_device_class_audio_feedback_control_parameter_kp;
+    control -> ux_device_class_audio_feedback_control_ki =
+                    (LONG)parameter -> ux_device_class_audio_feedback_control_parameter_ki;
+    control -> ux_device_class_audio_feedback_control_max_deviation = (LONG)max_deviation;
+    control -> ux_device_class_audio_feedback_control_format =
+                    parameter -> ux_device_class_audio_feedback_control_parameter_format;
+
+    /* Integral term is bounded by the correction limit.  */
+    control -> ux_device_class_audio_feedback_control_integral_limit =
+                    (control -> ux_device_class_audio_feedback_control_ki == 0) ? 0 :
+                    (LONG)max_deviation / control -> ux_device_class_audio_feedback_control_ki;
+
+    /* Start from nominal rate.  */
+    control -> ux_device_class_audio_feedback_control_integral = 0;
+    control -> ux_device_class_audio_feedback_control_level = 0;
+    control -> ux_device_class_audio_feedback_control_level_min = 0;
+    control -> ux_device_class_audio_feedback_control_level_max = 0;
+    control -> ux_device_class_audio_feedback_control_rate_error = 0;
+    control -> ux_device_class_audio_feedback_control_rate = nominal_rate;
+    control -> ux_device_class_audio_feedback_control_updates = 0;
+
+    /* Enable control.  */
+    control -> ux_device_class_audio_feedback_control_frame_bytes =
+                    parameter -> ux_device_class_audio_feedback_control_parameter_frame_bytes;
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_feedback_control_set        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in feedback control setting function    */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    parameter                             Feedback control parameter    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_feedback_control_setSet feedback control     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_feedback_control_set(UX_DEVICE_CLASS_AUDIO_STREAM *stream,
+                                                  UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER *parameter)
+{
+
+    /* Sanity check on input parameters.  */
+    if (stream == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Set feedback control.  */
+    return(_ux_device_class_audio_feedback_control_set(stream, parameter));
+}
@@ -0,0 +1,253 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_feedback_control_update      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function runs one step of the feedback control of an Audio     */
+/*    stream. The FIFO level is the number of frames not yet read in the  */
+/*    frame buffers, its error to the target level drives a PI loop whose */
+/*    bounded output corrects the base rate. The rate is encoded in 10.14 */
+/*    or 16.16 format, per frame or micro-frame, in the feedback buffer.  */
+/*    It's invoked by the feedback thread or task before each feedback    */
+/*    transfer, and can also be invoked by application.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_put                  Put 32-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    Device Audio Class                                                  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_feedback_control_update(UX_DEVICE_CLASS_AUDIO_STREAM *stream)
+{
+#if !defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+    UX_PARAMETER_NOT_USED(stream);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL      *control;
+UX_SLAVE_ENDPOINT                           *endpoint;
+UX_SLAVE_TRANSFER                           *transfer;
+UX_DEVICE_CLASS_AUDIO_FRAME                 *frame;
+UCHAR                                       *frame_buffer;
+UCHAR                                       *buffer;
+ULONG                                       level;
+LONG                                        error;
+LONG                                        integral;
+LONG                                        correction;
+LONG                                        max_deviation;
+ULONG                                       rate;
+ULONG                                       format;
+ULONG                                       feedback_length;
+
+
+    /* Check if control is enabled.  */
+    control = &stream -> ux_device_class_audio_stream_feedback_control;
+    if (control -> ux_device_class_audio_feedback_control_frame_bytes == 0)
+        return(UX_ERROR);
+
+    /* Check if endpoint is available.  */
+    endpoint = stream -> ux_device_class_audio_stream_feedback;
+    if (endpoint == UX_NULL)
+        return(UX_ERROR);
+
+    /* Check if endpoint direction is OK.  */
+    if ((endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_IN)
+        return(UX_ERROR);
+
+    /* Check feedback size.  */
+    format = control -> ux_device_class_audio_feedback_control_format;
+    if (format == UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO)
+        format = (_ux_system_slave -> ux_system_slave_speed == UX_HIGH_SPEED_DEVICE) ?
+                    UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16 : UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_10_14;
+    feedback_length = (format == UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16) ? 4 : 3;
+    transfer = &endpoint -> ux_slave_endpoint_transfer_request;
+    if (transfer -> ux_slave_transfer_request_transfer_length < feedback_length)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* FIFO level: bytes received and not read yet, in all frame buffers.  */
+    level = 0;
+    frame_buffer = stream -> ux_device_class_audio_stream_buffer;
+    while(frame_buffer < stream -> ux_device_class_audio_stream_buffer + stream -> ux_device_class_audio_stream_buffer_size)
+    {
+        frame = (UX_DEVICE_CLASS_AUDIO_FRAME *)frame_buffer;
+        if (frame -> ux_device_class_audio_frame_length > frame -> ux_device_class_audio_frame_pos)
+            level += frame -> ux_device_class_audio_frame_length - frame -> ux_device_class_audio_frame_pos;
+        frame_buffer += stream -> ux_device_class_audio_stream_frame_buffer_size;
+    }
+    level /= control -> ux_device_class_audio_feedback_control_frame_bytes;
+
+    /* Level telemetry.  */
+    if (control -> ux_device_class_audio_feedback_control_updates == 0 ||
+        level < control -> ux_device_class_audio_feedback_control_level_min)
+        control -> ux_device_class_audio_feedback_control_level_min = level;
+    if (control -> ux_device_class_audio_feedback_control_updates == 0 ||
+        level > control -> ux_device_class_audio_feedback_control_level_max)
+        control -> ux_device_class_audio_feedback_control_level_max = level;
+    control -> ux_device_class_audio_feedback_control_level = level;
+    control -> ux_device_class_audio_feedback_control_updates ++;
+
+    /* Level error, positive if host must send more.  */
+    error = (LONG)control -> ux_device_class_audio_feedback_control_target_level - (LONG)level;
+    if (error > 0x7FFF)
+        error = 0x7FFF;
+    if (error < -0x7FFF)
+        error = -0x7FFF;
+
+    /* Integral term, bounded to avoid windup.  */
+    integral = control -> ux_device_class_audio_feedback_control_integral + error;
+    if (integral > control -> ux_device_class_audio_feedback_control_integral_limit)
+        integral = control -> ux_device_class_audio_feedback_control_integral_limit;
+    if (integral < -control -> ux_device_class_audio_feedback_control_integral_limit)
+        integral = -control -> ux_device_class_audio_feedback_control_integral_limit;
+    control -> ux_device_class_audio_feedback_control_integral = integral;
+
+    /* Bounded correction.  */
+    max_deviation = control -> ux_device_class_audio_feedback_control_max_deviation;
+    correction = control -> ux_device_class_audio_feedback_control_kp * error;
+    if (correction > max_deviation)
+        correction = max_deviation;
+    if (correction < -max_deviation)
+        correction = -max_deviation;
+    correction += control -> ux_device_class_audio_feedback_control_ki * integral;
+    if (correction > max_deviation)
+        correction = max_deviation;
+    if (correction < -max_deviation)
+        correction = -max_deviation;
+
+    /* Rate from measured codec clock if available.  */
+    rate = control -> ux_device_class_audio_feedback_control_codec_rate;
+    if (rate == 0)
+        rate = control -> ux_device_class_audio_feedback_control_nominal_rate;
+    rate = (ULONG)((LONG)rate + correction);
+    control -> ux_device_class_audio_feedback_control_rate = rate;
+    control -> ux_device_class_audio_feedback_control_rate_error =
+                (LONG)(rate - control -> ux_device_class_audio_feedback_control_nominal_rate);
+
+    /* Samples per micro-frame in high speed.  */
+    if (_ux_system_slave -> ux_system_slave_speed == UX_HIGH_SPEED_DEVICE)
+        rate >>= 3;
+
+    /* Encode feedback.  */
+    buffer = transfer -> ux_slave_transfer_request_data_pointer;
+    if (format == UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16)
+        _ux_utility_long_put(buffer, rate);
+    else
+    {
+        rate >>= 2;
+        buffer[0] = (UCHAR)rate;
+        buffer[1] = (UCHAR)(rate >> 8);
+        buffer[2] = (UCHAR)(rate >> 16);
+    }
+    transfer -> ux_slave_transfer_request_requested_length = feedback_length;
+
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_feedback_control_update     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in feedback control update function     */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_feedback_control_updateUpdate feedback       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_feedback_control_update(UX_DEVICE_CLASS_AUDIO_STREAM *stream)
+{
+
+    /* Sanity check on input parameters.  */
+    if (stream == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Update feedback.  */
+    return(_ux_device_class_audio_feedback_control_update(stream));
+}
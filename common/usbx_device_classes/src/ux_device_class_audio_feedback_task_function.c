@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_audio_feedback_task_function       PORTABLE C      */
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Yajun Xia, Microsoft Corporation                                    */
@@ -62,6 +62,8 @@
 /*                                                                        */
 /*    _ux_system_error_handler              System error trap             */
 /*    _ux_device_stack_transfer_run         Run transfer state machine    */
+/*    _ux_device_class_audio_feedback_control_update                      */
+/*                                          Update feedback               */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -72,6 +74,9 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2022     Yajun Xia                Initial Version 6.2.0         */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added feedback control,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_audio_feedback_task_function(UX_DEVICE_CLASS_AUDIO_STREAM *stream)
@@ -124,6 +129,16 @@ ULONG                           transfer_length;
         stream -> ux_device_class_audio_stream_feedback_task_state = UX_DEVICE_CLASS_AUDIO_STREAM_FEEDBACK_RW_WAIT;
         stream -> ux_device_class_audio_stream_feedback_task_status = UX_TRANSFER_NO_ANSWER;
 
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+
+        /* Refresh feedback from FIFO level if control is enabled.  */
+        if (stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_frame_bytes)
+        {
+            _ux_device_class_audio_feedback_control_update(stream);
+            transfer_length = transfer -> ux_slave_transfer_request_requested_length;
+        }
+#endif
+
     /* Fall through.  */
     case UX_DEVICE_CLASS_AUDIO_STREAM_FEEDBACK_RW_WAIT:
 
@@ -147,6 +162,13 @@ ULONG                           transfer_length;
         {
             stream -> ux_device_class_audio_stream_feedback_task_state = UX_DEVICE_CLASS_AUDIO_STREAM_FEEDBACK_RW_WAIT;
             stream -> ux_device_class_audio_stream_feedback_task_status = transfer -> ux_slave_transfer_request_completion_code;
+
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+
+            /* Refresh feedback for next transfer.  */
+            if (stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_frame_bytes)
+                _ux_device_class_audio_feedback_control_update(stream);
+#endif
         }
 
         /* Keep waiting.  */
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_audio_feedback_thread_entry        PORTABLE C      */
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,8 @@
 /*    _ux_utility_thread_suspend            Suspend thread used           */
 /*    _ux_device_stack_transfer_request     Issue transfer request        */
 /*    _ux_utility_memory_copy               Copy data                     */
+/*    _ux_device_class_audio_feedback_control_update                      */
+/*                                          Update feedback               */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -73,6 +75,9 @@
 /*  10-31-2022     Yajun Xia                Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added feedback control,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID _ux_device_class_audio_feedback_thread_entry(ULONG audio_stream)
@@ -111,6 +116,13 @@ ULONG                           transfer_length;
             /* Get transfer instance.  */
             transfer = &endpoint -> ux_slave_endpoint_transfer_request;
 
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+
+            /* Refresh feedback from FIFO level if control is enabled.  */
+            if (stream -> ux_device_class_audio_stream_feedback_control.ux_device_class_audio_feedback_control_frame_bytes)
+                _ux_device_class_audio_feedback_control_update(stream);
+#endif
+
             /* Length is pre-set on interface alternate setting activate.  */
             transfer_length = transfer -> ux_slave_transfer_request_requested_length;
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_audio_ioctl                        PORTABLE C      */
-/*                                                           6.2.1        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_utility_memory_set                Set memory                    */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -70,6 +72,10 @@
 /*                                            resulting in version 6.1    */
 /*  03-08-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.2.1  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added statistics get and    */
+/*                                            reset,                      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_audio_ioctl(UX_DEVICE_CLASS_AUDIO *audio, ULONG ioctl_function,
@@ -78,6 +84,11 @@ UINT _ux_device_class_audio_ioctl(UX_DEVICE_CLASS_AUDIO *audio, ULONG ioctl_func
 
 UINT                                                status;
 VOID                                                **pptr_parameter;
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+UX_INTERRUPT_SAVE_AREA
+UX_DEVICE_CLASS_AUDIO_STATISTICS_PARAMETER          *statistics_parameter;
+UX_DEVICE_CLASS_AUDIO_STREAM                        *stream;
+#endif
 
 
     /* Let's be optimist ! */
@@ -97,6 +108,43 @@ VOID                                                **pptr_parameter;
 
             break;
 
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+        case UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET:
+        case UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_RESET:
+
+            /* Properly cast the parameter pointer.  */
+            statistics_parameter = (UX_DEVICE_CLASS_AUDIO_STATISTICS_PARAMETER *) parameter;
+
+            /* Check stream index.  */
+            if (statistics_parameter -> ux_device_class_audio_statistics_parameter_stream_index >=
+                audio -> ux_device_class_audio_streams_nb)
+            {
+                status = UX_INVALID_PARAMETER;
+                break;
+            }
+            stream = audio -> ux_device_class_audio_streams +
+                     statistics_parameter -> ux_device_class_audio_statistics_parameter_stream_index;
+
+            /* Statistics are updated by stream transfer, take a consistent copy.  */
+            UX_DISABLE
+            if (statistics_parameter -> ux_device_class_audio_statistics_parameter_statistics != UX_NULL)
+                _ux_utility_memory_copy(statistics_parameter -> ux_device_class_audio_statistics_parameter_statistics,
+                                        &stream -> ux_device_class_audio_stream_statistics,
+                                        sizeof(UX_DEVICE_CLASS_AUDIO_STATISTICS)); /* Use case of memcpy is verified. */
+
+            /* Restart counting, buffer errors already seen are not xruns.  */
+            if (ioctl_function == UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_RESET)
+            {
+                _ux_utility_memory_set(&stream -> ux_device_class_audio_stream_statistics, 0,
+                                       sizeof(UX_DEVICE_CLASS_AUDIO_STATISTICS)); /* Use case of memset is verified. */
+                stream -> ux_device_class_audio_stream_statistics.ux_device_class_audio_statistics_error_count =
+                                        stream -> ux_device_class_audio_stream_buffer_error_count;
+            }
+            UX_RESTORE
+
+            break;
+#endif
+
         default:
 
             /* Function not supported. Return an error.  */
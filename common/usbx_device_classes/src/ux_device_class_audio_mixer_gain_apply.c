@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_mixer_gain_apply             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function applies a Q15 gain to a block of Q31 samples. Scaled  */
+/*    samples are stored to, or added with saturation to, destination.    */
+/*    The 32 x 16 multiply is split in 16-bit halves so that no 64-bit    */
+/*    arithmetic is required. The loops are kept simple so that compilers */
+/*    vectorize them.                                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    source                                Source samples                */
+/*    destination                           Destination samples           */
+/*    gain                                  Q15 gain, up to unity         */
+/*    count                                 Number of samples             */
+/*    accumulate                            UX_TRUE to add to destination */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Device Audio Class                                                  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID _ux_device_class_audio_mixer_gain_apply(LONG *source, LONG *destination, ULONG gain,
+                                             ULONG count, ULONG accumulate)
+{
+
+LONG                sample;
+LONG                sum;
+ULONG               i;
+
+
+    if (accumulate == UX_FALSE)
+    {
+
+        /* Unity gain is a copy.  */
+        if (gain == UX_DEVICE_CLASS_AUDIO_MIXER_GAIN_UNITY)
+        {
+            _ux_utility_memory_copy(destination, source, count * sizeof(LONG)); /* Use case of memcpy is verified. */
+            return;
+        }
+
+        /* sample * gain >> 15, from high and low halves of sample.  */
+        for (i = 0; i < count; i ++)
+            destination[i] = (source[i] >> 16) * (LONG)gain * 2 +
+                             (LONG)((((ULONG)source[i] & 0xFFFFu) * gain) >> 15);
+        return;
+    }
+
+    for (i = 0; i < count; i ++)
+    {
+        sample = (source[i] >> 16) * (LONG)gain * 2 +
+                 (LONG)((((ULONG)source[i] & 0xFFFFu) * gain) >> 15);
+
+        /* Add, saturate on overflow (operands of same sign, sum of other sign).  */
+        sum = (LONG)((ULONG)destination[i] + (ULONG)sample);
+        if (((destination[i] ^ sum) & (sample ^ sum)) < 0)
+            sum = (LONG)((ULONG)(destination[i] >> 31) ^ 0x7FFFFFFFu);
+        destination[i] = sum;
+    }
+}
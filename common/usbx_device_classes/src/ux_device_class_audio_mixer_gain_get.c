@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_mixer_gain_get               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the Q15 linear gain of a mixer port, from its */
+/*    feature unit mute and volume controls. Volume in 1/256 dB is        */
+/*    converted by a table of whole dB attenuations within a decade,      */
+/*    linearly interpolated for the dB fraction and divided by 10 for each*/
+/*    decade. Positive volumes are limited to 0 dB.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    port                                  Address of mixer port         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Q15 linear gain                                                     */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Device Audio Class                                                  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG _ux_device_class_audio_mixer_gain_get(UX_DEVICE_CLASS_AUDIO_MIXER_PORT *port)
+{
+
+/* Q15 gains of 0 to 20 dB attenuations.  */
+static const USHORT _ux_device_class_audio_mixer_gains[21] =
+{
+    32768, 29205, 26029, 23198, 20675, 18427, 16423, 14637, 13045, 11627,
+    10362,  9235,  8231,  7336,  6538,  5827,  5193,  4629,  4125,  3677,
+     3277
+};
+SHORT               volume;
+ULONG               attenuation;
+ULONG               decibels;
+ULONG               fraction;
+ULONG               gain;
+
+
+    /* Muted.  */
+    if ((port -> ux_device_class_audio_mixer_port_mute != UX_NULL) &&
+        (*port -> ux_device_class_audio_mixer_port_mute != 0))
+        return(0);
+
+    /* No volume control, or no attenuation.  */
+    if (port -> ux_device_class_audio_mixer_port_volume == UX_NULL)
+        return(UX_DEVICE_CLASS_AUDIO_MIXER_GAIN_UNITY);
+    volume = *port -> ux_device_class_audio_mixer_port_volume;
+    if (volume >= 0)
+        return(UX_DEVICE_CLASS_AUDIO_MIXER_GAIN_UNITY);
+    if (volume == UX_DEVICE_CLASS_AUDIO_MIXER_VOLUME_SILENCE)
+        return(0);
+
+    /* Attenuation in whole dB and 1/256 dB fraction.  */
+    attenuation = (ULONG)(-(LONG)volume);
+    decibels = attenuation >> 8;
+    fraction = attenuation & 0xFFu;
+
+    /* Gain within the decade.  */
+    gain = _ux_device_class_audio_mixer_gains[decibels % 20];
+    gain -= ((gain - _ux_device_class_audio_mixer_gains[decibels % 20 + 1]) * fraction) >> 8;
+
+    /* Each 20 dB divides by 10.  */
+    for (decibels /= 20; decibels > 0 && gain != 0; decibels --)
+        gain = (gain + 5) / 10;
+
+    /* Return gain.  */
+    return(gain);
+}
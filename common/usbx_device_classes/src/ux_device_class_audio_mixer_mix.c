@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_mixer_mix                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function mixes a block of frames from the OUT streams of a     */
+/*    mixer to an interleaved Q31 application buffer. Each stream is read */
+/*    to the mixer work buffer, scaled by the gain of its feature unit    */
+/*    controls and added with saturation. Frames missing in a stream are  */
+/*    mixed as silence (the stream underrun count is incremented),        */
+/*    streams not started are ignored.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    mixer                                 Address of mixer              */
+/*    output                                Mixed samples                 */
+/*                                            (frames x channels)         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_read   Read samples block            */
+/*    _ux_device_class_audio_mixer_gain_get Get gain                      */
+/*    _ux_device_class_audio_mixer_gain_apply                             */
+/*                                          Apply gain                    */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_mixer_mix(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *output)
+{
+#if !defined(UX_DEVICE_CLASS_AUDIO_MIXER_SUPPORT)
+    UX_PARAMETER_NOT_USED(mixer);
+    UX_PARAMETER_NOT_USED(output);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_DEVICE_CLASS_AUDIO_MIXER_PORT    *port;
+UX_DEVICE_CLASS_AUDIO_SAMPLES       samples;
+ULONG                               channels;
+ULONG                               frames;
+ULONG                               actual_frames;
+ULONG                               gain;
+ULONG                               i;
+
+
+    /* As long as the device is in the CONFIGURED state.  */
+    if (_ux_system_slave -> ux_system_slave_device.ux_slave_device_state != UX_DEVICE_CONFIGURED)
+    {
+
+        /* Cannot proceed with command, the interface is down.  */
+        return(UX_CONFIGURATION_HANDLE_UNKNOWN);
+    }
+
+    /* Start from silence.  */
+    channels = mixer -> ux_device_class_audio_mixer_channels;
+    frames = mixer -> ux_device_class_audio_mixer_frames;
+    _ux_utility_memory_set(output, 0, frames * channels * sizeof(LONG)); /* Use case of memset is verified. */
+
+    /* Streams are read to work buffer.  */
+    samples.ux_device_class_audio_samples_buffer = mixer -> ux_device_class_audio_mixer_work;
+    samples.ux_device_class_audio_samples_format = UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31;
+    samples.ux_device_class_audio_samples_channels = channels;
+    samples.ux_device_class_audio_samples_planar_stride = 0;
+    samples.ux_device_class_audio_samples_packet_frames = 0;
+
+    for (i = 0; i < mixer -> ux_device_class_audio_mixer_inputs_nb; i ++)
+    {
+        port = &mixer -> ux_device_class_audio_mixer_inputs[i];
+        if (port -> ux_device_class_audio_mixer_port_stream == UX_NULL)
+            continue;
+
+        /* Read the block, frames are consumed even if muted.  */
+        samples.ux_device_class_audio_samples_subframe_size = port -> ux_device_class_audio_mixer_port_subframe_size;
+        _ux_device_class_audio_samples_read(port -> ux_device_class_audio_mixer_port_stream, &samples,
+                                            frames, &actual_frames);
+
+        /* Add frames read, the rest is silence.  */
+        gain = _ux_device_class_audio_mixer_gain_get(port);
+        if ((actual_frames == 0) || (gain == 0))
+            continue;
+        _ux_device_class_audio_mixer_gain_apply(mixer -> ux_device_class_audio_mixer_work, output,
+                                                gain, actual_frames * channels, UX_TRUE);
+    }
+
+    /* Block mixed.  */
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_mixer_mix                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in mixing function                      */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    mixer                                 Address of mixer              */
+/*    output                                Mixed samples                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_mixer_mix      Mix streams                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_mixer_mix(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *output)
+{
+
+    /* Sanity checks.  */
+    if ((mixer == UX_NULL) || (output == UX_NULL) ||
+        (mixer -> ux_device_class_audio_mixer_work == UX_NULL) ||
+        (mixer -> ux_device_class_audio_mixer_channels == 0) ||
+        ((mixer -> ux_device_class_audio_mixer_inputs_nb != 0) &&
+         (mixer -> ux_device_class_audio_mixer_inputs == UX_NULL)))
+        return(UX_INVALID_PARAMETER);
+
+    /* Mix streams.  */
+    return(_ux_device_class_audio_mixer_mix(mixer, output));
+}
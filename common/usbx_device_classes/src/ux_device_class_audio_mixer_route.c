@@ -0,0 +1,187 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_mixer_route                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function routes a block of frames from an interleaved Q31      */
+/*    application buffer (e.g. a capture) to the IN streams of a mixer.   */
+/*    For each stream the samples are scaled to the mixer work buffer by  */
+/*    the gain of its feature unit controls, then written to the stream.  */
+/*    Frames that do not fit are dropped (the stream overrun count is     */
+/*    incremented), streams not started are ignored.                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    mixer                                 Address of mixer              */
+/*    input                                 Samples to route              */
+/*                                            (frames x channels)         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_write  Write samples block           */
+/*    _ux_device_class_audio_mixer_gain_get Get gain                      */
+/*    _ux_device_class_audio_mixer_gain_apply                             */
+/*                                          Apply gain                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_mixer_route(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *input)
+{
+#if !defined(UX_DEVICE_CLASS_AUDIO_MIXER_SUPPORT)
+    UX_PARAMETER_NOT_USED(mixer);
+    UX_PARAMETER_NOT_USED(input);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_DEVICE_CLASS_AUDIO_MIXER_PORT    *port;
+UX_DEVICE_CLASS_AUDIO_SAMPLES       samples;
+ULONG                               channels;
+ULONG                               frames;
+ULONG                               actual_frames;
+ULONG                               i;
+
+
+    /* As long as the device is in the CONFIGURED state.  */
+    if (_ux_system_slave -> ux_system_slave_device.ux_slave_device_state != UX_DEVICE_CONFIGURED)
+    {
+
+        /* Cannot proceed with command, the interface is down.  */
+        return(UX_CONFIGURATION_HANDLE_UNKNOWN);
+    }
+
+    /* Streams are written from work buffer.  */
+    channels = mixer -> ux_device_class_audio_mixer_channels;
+    frames = mixer -> ux_device_class_audio_mixer_frames;
+    samples.ux_device_class_audio_samples_buffer = mixer -> ux_device_class_audio_mixer_work;
+    samples.ux_device_class_audio_samples_format = UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31;
+    samples.ux_device_class_audio_samples_channels = channels;
+    samples.ux_device_class_audio_samples_planar_stride = 0;
+    samples.ux_device_class_audio_samples_packet_frames = 0;
+
+    for (i = 0; i < mixer -> ux_device_class_audio_mixer_outputs_nb; i ++)
+    {
+        port = &mixer -> ux_device_class_audio_mixer_outputs[i];
+        if (port -> ux_device_class_audio_mixer_port_stream == UX_NULL)
+            continue;
+
+        /* Scale the block, muted streams still send silence.  */
+        _ux_device_class_audio_mixer_gain_apply(input, mixer -> ux_device_class_audio_mixer_work,
+                                                _ux_device_class_audio_mixer_gain_get(port),
+                                                frames * channels, UX_FALSE);
+
+        /* Write the block.  */
+        samples.ux_device_class_audio_samples_subframe_size = port -> ux_device_class_audio_mixer_port_subframe_size;
+        _ux_device_class_audio_samples_write(port -> ux_device_class_audio_mixer_port_stream, &samples,
+                                             frames, &actual_frames);
+    }
+
+    /* Block routed.  */
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_mixer_route                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in routing function                     */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    mixer                                 Address of mixer              */
+/*    input                                 Samples to route              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_mixer_route    Route to streams              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_mixer_route(UX_DEVICE_CLASS_AUDIO_MIXER *mixer, LONG *input)
+{
+
+    /* Sanity checks.  */
+    if ((mixer == UX_NULL) || (input == UX_NULL) ||
+        (mixer -> ux_device_class_audio_mixer_work == UX_NULL) ||
+        (mixer -> ux_device_class_audio_mixer_channels == 0) ||
+        ((mixer -> ux_device_class_audio_mixer_outputs_nb != 0) &&
+         (mixer -> ux_device_class_audio_mixer_outputs == UX_NULL)))
+        return(UX_INVALID_PARAMETER);
+
+    /* Route to streams.  */
+    return(_ux_device_class_audio_mixer_route(mixer, input));
+}
@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_decode               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function converts samples from a stream buffer to the format   */
+/*    of an application buffer. Stream samples are little endian, signed, */
+/*    subframe size bytes long and source step bytes apart. They are left */
+/*    justified in 32 bits then stored as PCM16, Q31 or float samples.    */
+/*    The loops are kept simple so that compilers vectorize them.         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    source                                Pointer to stream samples     */
+/*    source_step                           Bytes between samples         */
+/*    subframe_size                         Bytes per stream sample       */
+/*    destination                           Application samples           */
+/*    format                                Application samples format    */
+/*    count                                 Number of samples             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Device Audio Class                                                  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID _ux_device_class_audio_samples_decode(UCHAR *source, ULONG source_step, ULONG subframe_size,
+                                           VOID *destination, ULONG format, ULONG count)
+{
+
+UCHAR                       *pcm;
+SHORT                       *pcm16;
+LONG                        *q31;
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+float                       *samples_float;
+#endif
+ULONG                       value;
+ULONG                       byte_index;
+ULONG                       i;
+
+
+    switch(format)
+    {
+
+    case UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM:
+
+        /* Samples are kept as in the stream.  */
+        pcm = (UCHAR *)destination;
+        if (source_step == subframe_size)
+        {
+            _ux_utility_memory_copy(pcm, source, count * subframe_size); /* Use case of memcpy is verified. */
+            break;
+        }
+        for (i = 0; i < count; i ++)
+        {
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                pcm[byte_index] = source[byte_index];
+            pcm += subframe_size;
+            source += source_step;
+        }
+        break;
+
+    case UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM16:
+
+        pcm16 = (SHORT *)destination;
+        for (i = 0; i < count; i ++)
+        {
+
+            /* Left justify the sample, keep its 16 most significant bits.  */
+            value = 0;
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                value = (value >> 8) | ((ULONG)source[byte_index] << 24);
+            pcm16[i] = (SHORT)(USHORT)(value >> 16);
+            source += source_step;
+        }
+        break;
+
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+    case UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT:
+
+        samples_float = (float *)destination;
+        for (i = 0; i < count; i ++)
+        {
+
+            /* Left justify the sample, scale it to [-1, 1).  */
+            value = 0;
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                value = (value >> 8) | ((ULONG)source[byte_index] << 24);
+            samples_float[i] = (float)(LONG)value * (1.0f / 2147483648.0f);
+            source += source_step;
+        }
+        break;
+#endif
+
+    default:
+
+        q31 = (LONG *)destination;
+        for (i = 0; i < count; i ++)
+        {
+
+            /* Left justify the sample.  */
+            value = 0;
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                value = (value >> 8) | ((ULONG)source[byte_index] << 24);
+            q31[i] = (LONG)value;
+            source += source_step;
+        }
+        break;
+    }
+}
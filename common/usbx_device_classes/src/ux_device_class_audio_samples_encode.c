@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_encode               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function converts samples from the format of an application    */
+/*    buffer to a stream buffer. PCM16, Q31 or float samples are left     */
+/*    justified in 32 bits, then their most significant subframe size     */
+/*    bytes are stored little endian, destination step bytes apart.       */
+/*    Float samples are clipped to [-1, 1). The loops are kept simple so  */
+/*    that compilers vectorize them.                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    source                                Application samples           */
+/*    format                                Application samples format    */
+/*    destination                           Pointer to stream samples     */
+/*    destination_step                      Bytes between samples         */
+/*    subframe_size                         Bytes per stream sample       */
+/*    count                                 Number of samples             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Device Audio Class                                                  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID _ux_device_class_audio_samples_encode(VOID *source, ULONG format, UCHAR *destination,
+                                           ULONG destination_step, ULONG subframe_size, ULONG count)
+{
+
+UCHAR                       *pcm;
+SHORT                       *pcm16;
+LONG                        *q31;
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+float                       *samples_float;
+float                       sample;
+#endif
+ULONG                       value;
+ULONG                       shift;
+ULONG                       byte_index;
+ULONG                       i;
+
+
+    /* Shift of the least significant byte stored.  */
+    shift = 32 - (subframe_size << 3);
+
+    switch(format)
+    {
+
+    case UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM:
+
+        /* Samples are already as in the stream.  */
+        pcm = (UCHAR *)source;
+        if (destination_step == subframe_size)
+        {
+            _ux_utility_memory_copy(destination, pcm, count * subframe_size); /* Use case of memcpy is verified. */
+            break;
+        }
+        for (i = 0; i < count; i ++)
+        {
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                destination[byte_index] = pcm[byte_index];
+            pcm += subframe_size;
+            destination += destination_step;
+        }
+        break;
+
+    case UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM16:
+
+        pcm16 = (SHORT *)source;
+        for (i = 0; i < count; i ++)
+        {
+            value = (ULONG)(USHORT)pcm16[i] << 16;
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                destination[byte_index] = (UCHAR)(value >> (shift + (byte_index << 3)));
+            destination += destination_step;
+        }
+        break;
+
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+    case UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT:
+
+        samples_float = (float *)source;
+        for (i = 0; i < count; i ++)
+        {
+
+            /* Clip the sample, NaN is taken as -1.  */
+            sample = samples_float[i];
+            if (sample >= 1.0f)
+                value = 0x7FFFFFFFu;
+            else if (sample > -1.0f)
+                value = (ULONG)(LONG)(sample * 2147483648.0f);
+            else
+                value = 0x80000000u;
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                destination[byte_index] = (UCHAR)(value >> (shift + (byte_index << 3)));
+            destination += destination_step;
+        }
+        break;
+#endif
+
+    default:
+
+        q31 = (LONG *)source;
+        for (i = 0; i < count; i ++)
+        {
+            value = (ULONG)q31[i];
+            for (byte_index = 0; byte_index < subframe_size; byte_index ++)
+                destination[byte_index] = (UCHAR)(value >> (shift + (byte_index << 3)));
+            destination += destination_step;
+        }
+        break;
+    }
+}
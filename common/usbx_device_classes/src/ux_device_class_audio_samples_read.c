@@ -0,0 +1,246 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_read                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads a block of frames from the Audio class, into an */
+/*    interleaved or planar application buffer, converting the samples    */
+/*    to the application format. Frames are read across the received      */
+/*    frame buffers, the buffers fully read are freed. If there are less  */
+/*    frames than requested, the frames available are read and the        */
+/*    underrun count of the stream is incremented.                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    samples                               Application samples           */
+/*    frames                                Number of frames to read      */
+/*    actual_frames                         Pointer to save number of     */
+/*                                            frames read                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_decode Convert samples               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_samples_read(UX_DEVICE_CLASS_AUDIO_STREAM *stream, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                         ULONG frames, ULONG *actual_frames)
+{
+
+UX_SLAVE_ENDPOINT           *endpoint;
+UX_SLAVE_DEVICE             *device;
+UX_DEVICE_CLASS_AUDIO_FRAME *frame;
+UCHAR                       *next_frame_buffer;
+UCHAR                       *buffer;
+UCHAR                       *source;
+ULONG                       format;
+ULONG                       channels;
+ULONG                       subframe_size;
+ULONG                       sample_size;
+ULONG                       frame_bytes;
+ULONG                       stride;
+ULONG                       channel;
+ULONG                       count;
+ULONG                       done;
+UINT                        status;
+
+
+    /* Nothing read yet.  */
+    *actual_frames = 0;
+
+    /* Get the pointer to the device.  */
+    device =  &_ux_system_slave -> ux_system_slave_device;
+
+    /* As long as the device is in the CONFIGURED state.  */
+    if (device -> ux_slave_device_state != UX_DEVICE_CONFIGURED)
+    {
+
+        /* Cannot proceed with command, the interface is down.  */
+        return(UX_CONFIGURATION_HANDLE_UNKNOWN);
+    }
+
+    /* Check if endpoint is available.  */
+    endpoint = stream -> ux_device_class_audio_stream_endpoint;
+    if (endpoint == UX_NULL)
+        return(UX_ERROR);
+
+    /* Check if endpoint direction is OK.  */
+    if ((endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_OUT)
+        return(UX_ERROR);
+
+    /* Check the samples format.  */
+    format = samples -> ux_device_class_audio_samples_format;
+    channels = samples -> ux_device_class_audio_samples_channels;
+    subframe_size = samples -> ux_device_class_audio_samples_subframe_size;
+    if (format > UX_DEVICE_CLASS_AUDIO_SAMPLES_FORMAT_MAX || channels == 0 ||
+        subframe_size == 0 || subframe_size > 4)
+        return(UX_INVALID_PARAMETER);
+    sample_size = UX_DEVICE_CLASS_AUDIO_SAMPLES_SIZE(format, subframe_size);
+    frame_bytes = channels * subframe_size;
+    stride = samples -> ux_device_class_audio_samples_planar_stride;
+    buffer = (UCHAR *)samples -> ux_device_class_audio_samples_buffer;
+
+    status = UX_SUCCESS;
+    done = 0;
+    while (done < frames)
+    {
+
+        /* Underflow!!  */
+        frame = stream -> ux_device_class_audio_stream_access_pos;
+        if (frame -> ux_device_class_audio_frame_length == 0)
+        {
+            stream -> ux_device_class_audio_stream_underrun_count ++;
+            status = UX_BUFFER_OVERFLOW;
+            break;
+        }
+
+        /* Read the frames available in this buffer.  */
+        count = (frame -> ux_device_class_audio_frame_length - frame -> ux_device_class_audio_frame_pos) / frame_bytes;
+        if (count > frames - done)
+            count = frames - done;
+        source = frame -> ux_device_class_audio_frame_data + frame -> ux_device_class_audio_frame_pos;
+        if (stride == 0)
+            _ux_device_class_audio_samples_decode(source, subframe_size, subframe_size,
+                                                  buffer + done * channels * sample_size, format, count * channels);
+        else
+        {
+            for (channel = 0; channel < channels; channel ++)
+                _ux_device_class_audio_samples_decode(source + channel * subframe_size, frame_bytes, subframe_size,
+                                                      buffer + (channel * stride + done) * sample_size, format, count);
+        }
+        done += count;
+        frame -> ux_device_class_audio_frame_pos += count * frame_bytes;
+
+        /* Free the buffer once there is no more full frame in it.  */
+        if (frame -> ux_device_class_audio_frame_pos + frame_bytes > frame -> ux_device_class_audio_frame_length)
+        {
+
+            /* Set frame length to 0 to indicate no data.  */
+            frame -> ux_device_class_audio_frame_length = 0;
+            frame -> ux_device_class_audio_frame_pos = 0;
+
+            /* Move frame if it's not the last one.  */
+            if (frame != stream -> ux_device_class_audio_stream_transfer_pos)
+            {
+                next_frame_buffer = (UCHAR *)frame;
+                next_frame_buffer += stream -> ux_device_class_audio_stream_frame_buffer_size;
+                if (next_frame_buffer >= stream -> ux_device_class_audio_stream_buffer + stream -> ux_device_class_audio_stream_buffer_size)
+                    next_frame_buffer = stream -> ux_device_class_audio_stream_buffer;
+                stream -> ux_device_class_audio_stream_access_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next_frame_buffer;
+            }
+        }
+    }
+
+    /* Return number of frames read.  */
+    *actual_frames = done;
+    return(status);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_samples_read                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in reading samples block function call. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    samples                               Application samples           */
+/*    frames                                Number of frames              */
+/*    actual_frames                         Pointer to save number of     */
+/*                                            frames done                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_read   Read samples block            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_samples_read(UX_DEVICE_CLASS_AUDIO_STREAM *stream, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                          ULONG frames, ULONG *actual_frames)
+{
+
+    /* Sanity checks.  */
+    if ((stream == UX_NULL) || (samples == UX_NULL) || (actual_frames == UX_NULL) ||
+        (samples -> ux_device_class_audio_samples_buffer == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Read samples block.  */
+    return(_ux_device_class_audio_samples_read(stream, samples, frames, actual_frames));
+}
@@ -0,0 +1,248 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_write                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes a block of frames to the Audio class, from an  */
+/*    interleaved or planar application buffer, converting the samples    */
+/*    from the application format. Frames are written in packets of the   */
+/*    configured number of frames, each one committed to a frame buffer   */
+/*    to send. If the frame buffers are full, the frames that fit are     */
+/*    written and the overrun count of the stream is incremented.         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    samples                               Application samples           */
+/*    frames                                Number of frames to write     */
+/*    actual_frames                         Pointer to save number of     */
+/*                                            frames written              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_encode Convert samples               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_audio_samples_write(UX_DEVICE_CLASS_AUDIO_STREAM *stream, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                          ULONG frames, ULONG *actual_frames)
+{
+
+UX_SLAVE_ENDPOINT           *endpoint;
+UX_SLAVE_DEVICE             *device;
+UX_DEVICE_CLASS_AUDIO_FRAME *frame;
+UCHAR                       *next_frame_buffer;
+UCHAR                       *buffer;
+UCHAR                       *destination;
+ULONG                       format;
+ULONG                       channels;
+ULONG                       subframe_size;
+ULONG                       sample_size;
+ULONG                       frame_bytes;
+ULONG                       packet_frames;
+ULONG                       stride;
+ULONG                       channel;
+ULONG                       count;
+ULONG                       done;
+UINT                        status;
+
+
+    /* Nothing written yet.  */
+    *actual_frames = 0;
+
+    /* Get the pointer to the device.  */
+    device =  &_ux_system_slave -> ux_system_slave_device;
+
+    /* As long as the device is in the CONFIGURED state.  */
+    if (device -> ux_slave_device_state != UX_DEVICE_CONFIGURED)
+    {
+
+        /* Cannot proceed with command, the interface is down.  */
+        return(UX_CONFIGURATION_HANDLE_UNKNOWN);
+    }
+
+    /* Check if endpoint is available.  */
+    endpoint = stream -> ux_device_class_audio_stream_endpoint;
+    if (endpoint == UX_NULL)
+        return(UX_ERROR);
+
+    /* Check if endpoint direction is OK (IN).  */
+    if ((endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) == UX_ENDPOINT_OUT)
+        return(UX_ERROR);
+
+    /* Check the samples format.  */
+    format = samples -> ux_device_class_audio_samples_format;
+    channels = samples -> ux_device_class_audio_samples_channels;
+    subframe_size = samples -> ux_device_class_audio_samples_subframe_size;
+    if (format > UX_DEVICE_CLASS_AUDIO_SAMPLES_FORMAT_MAX || channels == 0 ||
+        subframe_size == 0 || subframe_size > 4)
+        return(UX_INVALID_PARAMETER);
+    sample_size = UX_DEVICE_CLASS_AUDIO_SAMPLES_SIZE(format, subframe_size);
+    frame_bytes = channels * subframe_size;
+    stride = samples -> ux_device_class_audio_samples_planar_stride;
+    buffer = (UCHAR *)samples -> ux_device_class_audio_samples_buffer;
+
+    /* Check packet length, excluding frame buffer header.  */
+    packet_frames = (stream -> ux_device_class_audio_stream_frame_buffer_size - 8) / frame_bytes;
+    if (samples -> ux_device_class_audio_samples_packet_frames != 0 &&
+        samples -> ux_device_class_audio_samples_packet_frames < packet_frames)
+        packet_frames = samples -> ux_device_class_audio_samples_packet_frames;
+    if (packet_frames == 0)
+        return(UX_ERROR);
+
+    status = UX_SUCCESS;
+    done = 0;
+    while (done < frames)
+    {
+
+        /* Check overflow!!  */
+        frame = stream -> ux_device_class_audio_stream_access_pos;
+        if (frame == stream -> ux_device_class_audio_stream_transfer_pos &&
+            frame -> ux_device_class_audio_frame_length != 0)
+        {
+            stream -> ux_device_class_audio_stream_overrun_count ++;
+            status = UX_BUFFER_OVERFLOW;
+            break;
+        }
+
+        /* Fill a packet.  */
+        count = frames - done;
+        if (count > packet_frames)
+            count = packet_frames;
+        destination = frame -> ux_device_class_audio_frame_data;
+        if (stride == 0)
+            _ux_device_class_audio_samples_encode(buffer + done * channels * sample_size, format,
+                                                  destination, subframe_size, subframe_size, count * channels);
+        else
+        {
+            for (channel = 0; channel < channels; channel ++)
+                _ux_device_class_audio_samples_encode(buffer + (channel * stride + done) * sample_size, format,
+                                                      destination + channel * subframe_size, frame_bytes, subframe_size, count);
+        }
+        done += count;
+
+        /* Calculate next frame buffer.  */
+        next_frame_buffer = (UCHAR *)frame;
+        next_frame_buffer += stream -> ux_device_class_audio_stream_frame_buffer_size;
+        if (next_frame_buffer >= stream -> ux_device_class_audio_stream_buffer + stream -> ux_device_class_audio_stream_buffer_size)
+            next_frame_buffer = stream -> ux_device_class_audio_stream_buffer;
+
+        /* Commit frame length.  */
+        frame -> ux_device_class_audio_frame_length = count * frame_bytes;
+
+        /* Move frame position.  */
+        stream -> ux_device_class_audio_stream_access_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next_frame_buffer;
+    }
+
+    /* Return number of frames written.  */
+    *actual_frames = done;
+    return(status);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_audio_samples_write               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in writing samples block function call. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    samples                               Application samples           */
+/*    frames                                Number of frames              */
+/*    actual_frames                         Pointer to save number of     */
+/*                                            frames done                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_audio_samples_write  Write samples block           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_audio_samples_write(UX_DEVICE_CLASS_AUDIO_STREAM *stream, UX_DEVICE_CLASS_AUDIO_SAMPLES *samples,
+                                           ULONG frames, ULONG *actual_frames)
+{
+
+    /* Sanity checks.  */
+    if ((stream == UX_NULL) || (samples == UX_NULL) || (actual_frames == UX_NULL) ||
+        (samples -> ux_device_class_audio_samples_buffer == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Write samples block.  */
+    return(_ux_device_class_audio_samples_write(stream, samples, frames, actual_frames));
+}
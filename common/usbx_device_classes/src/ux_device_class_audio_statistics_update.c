@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device Audio Class                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_audio_statistics_update            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function updates the statistics of an Audio stream after a     */
+/*    transfer is done: interval since previous transfer, FIFO level and  */
+/*    its histogram, feedback value and xruns (counted by stream buffer   */
+/*    errors).                                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Address of audio stream       */
+/*                                            instance                    */
+/*    length                                Transfer length               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_get                  Get 32-bit value              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Device Audio Class                                                  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+VOID _ux_device_class_audio_statistics_update(UX_DEVICE_CLASS_AUDIO_STREAM *stream, ULONG length)
+{
+
+UX_DEVICE_CLASS_AUDIO_STATISTICS    *statistics;
+#if UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS > 0
+UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORD *record;
+#endif
+UCHAR                               *frame_buffer;
+UCHAR                               *buffer_end;
+ULONG                               time;
+ULONG                               interval;
+ULONG                               level;
+ULONG                               error_count;
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+UX_SLAVE_TRANSFER                   *transfer;
+UCHAR                               *feedback_buffer;
+ULONG                               feedback;
+#endif
+
+
+    statistics = &stream -> ux_device_class_audio_stream_statistics;
+    time = UX_DEVICE_CLASS_AUDIO_STATISTICS_TIME_GET();
+
+    /* Interval from previous transfer (unsigned difference handles wrap).  */
+    if (statistics -> ux_device_class_audio_statistics_transfers > 0)
+    {
+        interval = time - statistics -> ux_device_class_audio_statistics_time;
+        if (statistics -> ux_device_class_audio_statistics_transfers == 1 ||
+            interval < statistics -> ux_device_class_audio_statistics_interval_min)
+            statistics -> ux_device_class_audio_statistics_interval_min = interval;
+        if (interval > statistics -> ux_device_class_audio_statistics_interval_max)
+            statistics -> ux_device_class_audio_statistics_interval_max = interval;
+        statistics -> ux_device_class_audio_statistics_interval_sum += interval;
+    }
+    statistics -> ux_device_class_audio_statistics_time = time;
+
+    /* FIFO level: frame buffers holding data.  */
+    level = 0;
+    frame_buffer = stream -> ux_device_class_audio_stream_buffer;
+    buffer_end = frame_buffer + stream -> ux_device_class_audio_stream_buffer_size;
+    while(frame_buffer < buffer_end)
+    {
+        if (((UX_DEVICE_CLASS_AUDIO_FRAME *)frame_buffer) -> ux_device_class_audio_frame_length)
+            level ++;
+        frame_buffer += stream -> ux_device_class_audio_stream_frame_buffer_size;
+    }
+    if (statistics -> ux_device_class_audio_statistics_transfers == 0 ||
+        level < statistics -> ux_device_class_audio_statistics_level_min)
+        statistics -> ux_device_class_audio_statistics_level_min = level;
+    if (level > statistics -> ux_device_class_audio_statistics_level_max)
+        statistics -> ux_device_class_audio_statistics_level_max = level;
+    statistics -> ux_device_class_audio_statistics_level = level;
+    if (level >= UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS)
+        level = UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS - 1;
+    statistics -> ux_device_class_audio_statistics_level_histogram[level] ++;
+
+    /* Xruns, stream buffer errors since last update.  */
+    error_count = stream -> ux_device_class_audio_stream_buffer_error_count;
+    if (error_count != statistics -> ux_device_class_audio_statistics_error_count)
+    {
+        statistics -> ux_device_class_audio_statistics_xruns +=
+                        error_count - statistics -> ux_device_class_audio_statistics_error_count;
+        statistics -> ux_device_class_audio_statistics_error_count = error_count;
+        statistics -> ux_device_class_audio_statistics_xrun_time = time;
+    }
+
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+
+    /* Feedback, as encoded: 3 bytes 10.14 or 4 bytes 16.16.  */
+    if (stream -> ux_device_class_audio_stream_feedback != UX_NULL)
+    {
+        transfer = &stream -> ux_device_class_audio_stream_feedback -> ux_slave_endpoint_transfer_request;
+        feedback_buffer = transfer -> ux_slave_transfer_request_data_pointer;
+        if (transfer -> ux_slave_transfer_request_requested_length == 4 ||
+            _ux_system_slave -> ux_system_slave_speed == UX_HIGH_SPEED_DEVICE)
+            feedback = _ux_utility_long_get(feedback_buffer);
+        else
+            feedback = (ULONG)feedback_buffer[0] | ((ULONG)feedback_buffer[1] << 8) | ((ULONG)feedback_buffer[2] << 16);
+        if (feedback != 0)
+        {
+            if (statistics -> ux_device_class_audio_statistics_feedback_min == 0 ||
+                feedback < statistics -> ux_device_class_audio_statistics_feedback_min)
+                statistics -> ux_device_class_audio_statistics_feedback_min = feedback;
+            if (feedback > statistics -> ux_device_class_audio_statistics_feedback_max)
+                statistics -> ux_device_class_audio_statistics_feedback_max = feedback;
+        }
+        statistics -> ux_device_class_audio_statistics_feedback = feedback;
+    }
+#endif
+
+#if UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS > 0
+
+    /* Record this transfer, overwriting the oldest one.  */
+    record = &statistics -> ux_device_class_audio_statistics_records[
+                    statistics -> ux_device_class_audio_statistics_transfers &
+                    (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+    record -> ux_device_class_audio_statistics_record_time = time;
+    record -> ux_device_class_audio_statistics_record_length = length;
+    record -> ux_device_class_audio_statistics_record_level = statistics -> ux_device_class_audio_statistics_level;
+#endif
+
+    /* Transfer done.  */
+    statistics -> ux_device_class_audio_statistics_transfers ++;
+    statistics -> ux_device_class_audio_statistics_bytes += length;
+}
+#endif
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_audio_write_task_function          PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Yajun Xia, Microsoft Corporation                                    */
@@ -62,6 +62,8 @@
 /*                                                                        */
 /*    _ux_device_stack_transfer_run         Run transfer state machine    */
 /*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_device_class_audio_statistics_update                            */
+/*                                          Update statistics             */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -77,6 +79,9 @@
 /*                                            endpoint buffer in classes  */
 /*                                            with zero copy enabled,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added streaming statistics, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_audio_write_task_function(UX_DEVICE_CLASS_AUDIO_STREAM *stream)
@@ -213,6 +218,12 @@ UINT                            status;
             }
         }
 
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+        /* Update stream statistics.  */
+        _ux_device_class_audio_statistics_update(stream, actual_length);
+#endif
+
         /* Invoke notification callback.  */
         if (stream -> ux_device_class_audio_stream_callbacks.ux_device_class_audio_stream_frame_done != UX_NULL)
             stream -> ux_device_class_audio_stream_callbacks.ux_device_class_audio_stream_frame_done(stream, actual_length);
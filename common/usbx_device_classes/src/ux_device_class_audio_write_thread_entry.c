@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_audio_write_thread_entry           PORTABLE C      */
-/*                                                           6.2.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,6 +58,8 @@
 /*    _ux_device_thread_suspend             Suspend thread used           */
 /*    _ux_device_stack_transfer_request     Issue transfer request        */
 /*    _ux_utility_memory_copy               Copy data                     */
+/*    _ux_device_class_audio_statistics_update                            */
+/*                                          Update statistics             */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -83,6 +85,9 @@
 /*                                            endpoint buffer in classes  */
 /*                                            with zero copy enabled,     */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added streaming statistics, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID _ux_device_class_audio_write_thread_entry(ULONG audio_stream)
@@ -191,6 +196,12 @@ ULONG                           actual_length;
                 }
             }
 
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+            /* Update stream statistics.  */
+            _ux_device_class_audio_statistics_update(stream, actual_length);
+#endif
+
             /* Invoke notification callback.  */
             if (stream -> ux_device_class_audio_stream_callbacks.ux_device_class_audio_stream_frame_done != UX_NULL)
                 stream -> ux_device_class_audio_stream_callbacks.ux_device_class_audio_stream_frame_done(stream, actual_length);
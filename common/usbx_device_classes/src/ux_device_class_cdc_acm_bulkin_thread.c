@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_cdc_acm_bulkin_thread              PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -46,6 +46,11 @@
 /*    IN endpoint is used when the device wants to write data to be sent  */
 /*    to the host.                                                        */
 /*                                                                        */
+/*    If write coalescing is enabled, data in coalescing ring is sent,    */
+/*    full packets as soon as possible, and the rest on latency deadline  */
+/*    or flush request. The write callback is invoked once per batch,     */
+/*    with the length of the batch.                                       */
+/*                                                                        */
 /*    It's for RTOS mode.                                                 */
 /*                                                                        */
 /*  INPUT                                                                 */
@@ -60,6 +65,9 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_device_stack_transfer_request     Request transfer              */
+/*    _ux_utility_event_flags_get           Get event flags               */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_utility_time_get                  Get current time              */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -97,6 +105,11 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added write coalescing      */
+/*                                            support, dropped stale ring */
+/*                                            position on stop,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_cdc_acm_bulkin_thread(ULONG cdc_acm_class)
@@ -113,6 +126,16 @@ ULONG                           transfer_length;
 ULONG                           host_length;
 ULONG                           total_length;
 ULONG                           sent_length;
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+UX_INTERRUPT_SAVE_AREA
+ULONG                           count;
+ULONG                           elapsed;
+ULONG                           deadline;
+ULONG                           tail;
+ULONG                           copy_length;
+ULONG                           reset;
+UINT                            flush;
+#endif
 
 
     /* Get the cdc_acm instance from this class container.  */
@@ -151,10 +174,119 @@ ULONG                           sent_length;
         while (device -> ux_slave_device_state == UX_DEVICE_CONFIGURED)
         {
 
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+            /* Check if writes are coalesced in the ring.  */
+            if (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency != 0)
+            {
+
+                /* Get data pending in the ring.  */
+                deadline = UX_MS_TO_TICK_NON_ZERO(cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency);
+                UX_DISABLE
+                count = cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count;
+                elapsed = _ux_utility_time_elapsed(cdc_acm -> ux_device_class_cdc_acm_write_coalesce_time, _ux_utility_time_get());
+                flush = cdc_acm -> ux_device_class_cdc_acm_write_coalesce_flush;
+                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_flush = UX_FALSE;
+                reset = cdc_acm -> ux_device_class_cdc_acm_write_coalesce_reset;
+                UX_RESTORE
+
+                /* Send all on flush or deadline, otherwise full packets only.  */
+                if (flush || (elapsed >= deadline))
+                    total_length = count;
+                else
+                    total_length = count - (count % endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize);
+
+                if (total_length == 0)
+                {
+
+                    /* Wait for more data, a flush, or the deadline of the data pending.  */
+                    _ux_utility_event_flags_get(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group, UX_DEVICE_CLASS_CDC_ACM_WRITE_EVENT,
+                                                UX_OR_CLEAR, &actual_flags, (count == 0) ? UX_WAIT_FOREVER : (deadline - elapsed));
+                    continue;
+                }
+
+                /* Send data from the ring.  */
+                status = UX_SUCCESS;
+                sent_length = 0;
+                tail = cdc_acm -> ux_device_class_cdc_acm_write_coalesce_tail;
+                while (total_length)
+                {
+
+                    /* Check the length to send in this transfer.  */
+                    transfer_length = total_length;
+                    if (transfer_length > UX_DEVICE_CLASS_CDC_ACM_WRITE_BUFFER_SIZE)
+                        transfer_length = UX_DEVICE_CLASS_CDC_ACM_WRITE_BUFFER_SIZE;
+
+                    /* Copy the payload from the ring, it may wrap.  */
+                    copy_length = UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE - tail;
+                    if (copy_length > transfer_length)
+                        copy_length = transfer_length;
+                    _ux_utility_memory_copy(transfer_request -> ux_slave_transfer_request_data_pointer,
+                                            cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer + tail,
+                                            copy_length); /* Use case of memcpy is verified. */
+                    if (transfer_length > copy_length)
+                        _ux_utility_memory_copy(transfer_request -> ux_slave_transfer_request_data_pointer + copy_length,
+                                                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer,
+                                                transfer_length - copy_length); /* Use case of memcpy is verified. */
+
+                    /* Data follows in ring, or everything pending is sent.  */
+                    host_length = transfer_length;
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_AUTO_ZLP)
+                    if (sent_length + transfer_length == count)
+
+                        /* Assume expected more to let stack append ZLP if needed.  */
+                        host_length = transfer_length + 1;
+#endif
+
+                    /* Send the acm payload to the host.  */
+                    status =  _ux_device_stack_transfer_request(transfer_request, transfer_length, host_length);
+                    if (status != UX_SUCCESS)
+                        break;
+
+                    /* Free the room in the ring.  */
+                    tail += transfer_length;
+                    if (tail >= UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE)
+                        tail -= UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE;
+                    UX_DISABLE
+
+                    /* Transmission stopped meanwhile, the ring is discarded.  */
+                    if (reset != cdc_acm -> ux_device_class_cdc_acm_write_coalesce_reset)
+                    {
+                        UX_RESTORE
+                        status = UX_ABORTED;
+                        break;
+                    }
+                    cdc_acm -> ux_device_class_cdc_acm_write_coalesce_tail = tail;
+                    cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count -= transfer_length;
+                    UX_RESTORE
+
+                    /* Update lengths.  */
+                    sent_length += transfer_length;
+                    total_length -= transfer_length;
+                }
+
+                /* If there is a callback defined by the application, report the batch sent,
+                   it may hold several writes or a part of one.  */
+                if (cdc_acm -> ux_device_class_cdc_acm_write_callback != UX_NULL)
+
+                    /* Callback exists. */
+                    cdc_acm -> ux_device_class_cdc_acm_write_callback(cdc_acm, status, sent_length);
+
+                continue;
+            }
+#endif
+
             /* Wait until we have a event sent by the application. */
             status =  _ux_utility_event_flags_get(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group, UX_DEVICE_CLASS_CDC_ACM_WRITE_EVENT,
                                                                                             UX_OR_CLEAR, &actual_flags, UX_WAIT_FOREVER);
 
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+            /* Coalescing may be enabled while waiting, data is in the ring.  */
+            if ((status == UX_SUCCESS) && (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency != 0))
+                continue;
+#endif
+
             /* Check the completion code. */
             if (status == UX_SUCCESS)
             {
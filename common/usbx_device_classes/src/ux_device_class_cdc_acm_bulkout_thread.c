@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_cdc_acm_bulkout_thread             PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -46,6 +46,13 @@
 /*    is waiting for the host to send data on the bulk out endpoint to    */
 /*    the device.                                                         */
 /*                                                                        */
+/*    If reception ring is started, the received data is saved in the     */
+/*    ring. If the DCD supports queued transfer requests, several packets */
+/*    are kept queued on the endpoint, otherwise a single packet transfer */
+/*    is armed each time. A packet is queued only if the ring has room    */
+/*    for it, the endpoint is not armed while there is no room in the     */
+/*    ring for a packet.                                                  */
+/*                                                                        */
 /*    It's for RTOS mode.                                                 */
 /*                                                                        */
 /*  INPUT                                                                 */
@@ -60,6 +67,15 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_device_stack_transfer_request     Request transfer              */
+/*    _ux_device_event_flags_get            Get event flags               */
+/*    _ux_device_semaphore_get              Get semaphore                 */
+/*    _ux_device_stack_endpoint_transfer_requests_allocate                */
+/*                                          Allocate transfer requests    */
+/*    _ux_device_stack_endpoint_transfer_requests_free                    */
+/*                                          Free transfer requests        */
+/*    _ux_device_stack_transfer_request_queue                             */
+/*                                          Queue transfer request        */
+/*    _ux_utility_memory_copy               Copy memory                   */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -88,6 +104,10 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added reception ring        */
+/*                                            support,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_cdc_acm_bulkout_thread(ULONG cdc_acm_class)
@@ -99,6 +119,19 @@ UX_SLAVE_ENDPOINT               *endpoint;
 UX_SLAVE_INTERFACE              *interface_ptr;
 UX_SLAVE_TRANSFER               *transfer_request;
 UINT                            status;
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+UX_INTERRUPT_SAVE_AREA
+ULONG                           length;
+ULONG                           room;
+ULONG                           head;
+ULONG                           actual_flags;
+ULONG                           packet_size;
+UX_SLAVE_TRANSFER               *transfer_requests = UX_NULL;
+ULONG                           transfer_next = 0;
+ULONG                           transfers_queued = 0;
+ULONG                           slot;
+UINT                            transfer_queue_supported = UX_TRUE;
+#endif
 
     /* Cast properly the cdc_acm instance.  */
     UX_THREAD_EXTENSION_PTR_GET(cdc_acm, UX_SLAVE_CLASS_CDC_ACM, cdc_acm_class)
@@ -124,13 +157,162 @@ UINT                            status;
     while(1)
     {
 
-        /* Select the transfer request associated with BULK OUT endpoint.   */
-        transfer_request =  &endpoint -> ux_slave_endpoint_transfer_request;
-
         /* As long as the device is in the CONFIGURED state.  */
         while (device -> ux_slave_device_state == UX_DEVICE_CONFIGURED)
         {
 
+            /* Select the transfer request associated with BULK OUT endpoint.   */
+            transfer_request =  &endpoint -> ux_slave_endpoint_transfer_request;
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+            /* Check if reception ring is started.  */
+            if (cdc_acm -> ux_device_class_cdc_acm_read_ring_status == UX_TRUE)
+            {
+
+                /* The queued transfer requests are freed with the endpoint.  */
+                if (endpoint -> ux_slave_endpoint_transfer_requests != transfer_requests)
+                {
+                    transfer_requests = UX_NULL;
+                    transfer_next = 0;
+                    transfers_queued = 0;
+                }
+
+                /* Allocate the transfer requests to queue packets on the endpoint.  */
+                packet_size = endpoint -> ux_slave_endpoint_descriptor.wMaxPacketSize;
+                if ((transfer_requests == UX_NULL) && (transfer_queue_supported == UX_TRUE) &&
+                    (packet_size <= UX_DEVICE_CLASS_CDC_ACM_READ_BUFFER_SIZE))
+                {
+                    status = _ux_device_stack_endpoint_transfer_requests_allocate(endpoint,
+                                        UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT, &transfer_requests);
+                    if (status != UX_SUCCESS)
+                        transfer_requests = UX_NULL;
+                    else
+                    {
+                        for (slot = 0; slot < UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT; slot ++)
+                            transfer_requests[slot].ux_slave_transfer_request_data_pointer =
+                                cdc_acm -> ux_device_class_cdc_acm_read_ring_packets + slot * UX_DEVICE_CLASS_CDC_ACM_READ_BUFFER_SIZE;
+                    }
+                }
+
+                /* Check room in the ring, a packet is queued only if there is room for it
+                   and for all the packets already queued.  */
+                UX_DISABLE
+                room = UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - cdc_acm -> ux_device_class_cdc_acm_read_ring_count;
+                if ((transfers_queued == 0) && (room < packet_size))
+                    cdc_acm -> ux_device_class_cdc_acm_read_ring_waiting = UX_TRUE;
+                UX_RESTORE
+
+                if (transfer_requests != UX_NULL)
+                {
+
+                    /* Keep the endpoint armed: queue the free packets while there is room.  */
+                    status = UX_SUCCESS;
+                    while ((transfers_queued < UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT) &&
+                           (room >= (transfers_queued + 1) * packet_size))
+                    {
+                        slot = transfer_next + transfers_queued;
+                        if (slot >= UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT)
+                            slot -= UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT;
+                        status = _ux_device_stack_transfer_request_queue(&transfer_requests[slot], packet_size, packet_size);
+                        if (status != UX_SUCCESS)
+                            break;
+                        transfers_queued ++;
+                    }
+
+                    /* If the DCD can't queue transfers, packets are received one by one.  */
+                    if ((status == UX_FUNCTION_NOT_SUPPORTED) && (transfers_queued == 0))
+                    {
+                        _ux_device_stack_endpoint_transfer_requests_free(endpoint);
+                        transfer_requests = UX_NULL;
+                        transfer_queue_supported = UX_FALSE;
+                        continue;
+                    }
+                }
+
+                /* The endpoint is not armed (host NAKed) if no room for a packet.  */
+                if ((transfers_queued == 0) && (room < packet_size))
+                {
+
+                    /* Wait until the application reads from the ring, or the ring is stopped.  */
+                    _ux_device_event_flags_get(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group,
+                                               UX_DEVICE_CLASS_CDC_ACM_READ_RING_EVENT, UX_OR_CLEAR,
+                                               &actual_flags, UX_WAIT_FOREVER);
+                    continue;
+                }
+
+                if (transfer_requests != UX_NULL)
+                {
+
+                    /* Nothing queued, the queue request failed.  */
+                    if (transfers_queued == 0)
+                        continue;
+
+                    /* Wait for the oldest packet, the DCD completes them in order.
+                       An aborted packet is completed too.  */
+                    transfer_request = &transfer_requests[transfer_next];
+                    status = _ux_device_semaphore_get(&transfer_request -> ux_slave_transfer_request_semaphore, UX_WAIT_FOREVER);
+                    if (status != UX_SUCCESS)
+                        continue;
+                    transfer_next ++;
+                    if (transfer_next == UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT)
+                        transfer_next = 0;
+                    transfers_queued --;
+                    status = transfer_request -> ux_slave_transfer_request_completion_code;
+                }
+                else
+                {
+
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
+
+                    /* Use class managed buffer.  */
+                    transfer_request -> ux_slave_transfer_request_data_pointer =
+                                        UX_DEVICE_CLASS_CDC_ACM_READ_BUFFER(cdc_acm);
+#endif
+
+                    /* Receive packet by packet, so a short stream is not held in the transfer.  */
+                    status =  _ux_device_stack_transfer_request(transfer_request, packet_size, packet_size);
+                }
+
+                /* Save received data in the ring.  */
+                length = transfer_request -> ux_slave_transfer_request_actual_length;
+                if ((status == UX_SUCCESS) && (length != 0) &&
+                    (cdc_acm -> ux_device_class_cdc_acm_read_ring_status == UX_TRUE))
+                {
+
+                    /* The producer is the only one to update the head.  */
+                    head = cdc_acm -> ux_device_class_cdc_acm_read_ring_head;
+
+                    /* Copy till the end of the ring.  */
+                    room = UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - head;
+                    if (room > length)
+                        room = length;
+                    _ux_utility_memory_copy(cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer + head,
+                                            transfer_request -> ux_slave_transfer_request_data_pointer, room); /* Use case of memcpy is verified. */
+
+                    /* Copy the rest to the start of the ring.  */
+                    if (length > room)
+                        _ux_utility_memory_copy(cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer,
+                                                transfer_request -> ux_slave_transfer_request_data_pointer + room,
+                                                length - room); /* Use case of memcpy is verified. */
+
+                    /* Update the ring.  */
+                    head += length;
+                    if (head >= UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE)
+                        head -= UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE;
+                    UX_DISABLE
+                    cdc_acm -> ux_device_class_cdc_acm_read_ring_head = head;
+                    cdc_acm -> ux_device_class_cdc_acm_read_ring_count += length;
+                    UX_RESTORE
+                }
+                continue;
+            }
+
+            /* Suspend if neither reception ring nor transmission is started.  */
+            if (cdc_acm -> ux_slave_class_cdc_acm_transmission_status != UX_TRUE)
+                break;
+#endif
+
 #if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
 
             /* Use class managed buffer.  */
@@ -37,7 +37,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_cdc_acm_initialize                 PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -92,6 +92,11 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added reception ring        */
+/*                                            support, added write        */
+/*                                            coalescing support,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_cdc_acm_initialize(UX_SLAVE_CLASS_COMMAND *command)
@@ -284,11 +289,56 @@ UINT                                    status;
         }
     }
 
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+    /* If success, go on to allocate reception ring buffer.  */
+    if (status == UX_SUCCESS)
+    {
+        cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer =
+            _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE);
+        if (cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer == UX_NULL)
+            status = (UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* If success, go on to allocate buffers of packets queued by reception ring.  */
+    if (status == UX_SUCCESS)
+    {
+        cdc_acm -> ux_device_class_cdc_acm_read_ring_packets =
+            _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY,
+                                                  UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT,
+                                                  UX_DEVICE_CLASS_CDC_ACM_READ_BUFFER_SIZE);
+        if (cdc_acm -> ux_device_class_cdc_acm_read_ring_packets == UX_NULL)
+            status = (UX_MEMORY_INSUFFICIENT);
+    }
+#endif
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+    /* If success, go on to allocate coalescing ring buffer.  */
+    if (status == UX_SUCCESS)
+    {
+        cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer =
+            _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE);
+        if (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer == UX_NULL)
+            status = (UX_MEMORY_INSUFFICIENT);
+    }
+#endif
+
     /* Check error.  */
     if (status != UX_SUCCESS)
     {
 
         /* Free resources and return error.  */
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING) || defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+        if (cdc_acm -> ux_slave_class_cdc_acm_bulkout_thread.tx_thread_id)
+            _ux_utility_thread_delete(&cdc_acm -> ux_slave_class_cdc_acm_bulkout_thread);
+#endif
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+        if (cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer)
+            _ux_utility_memory_free(cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer);
+        if (cdc_acm -> ux_device_class_cdc_acm_read_ring_packets)
+            _ux_utility_memory_free(cdc_acm -> ux_device_class_cdc_acm_read_ring_packets);
+#endif
         if (cdc_acm -> ux_slave_class_cdc_acm_bulkin_thread.tx_thread_id)
             _ux_utility_thread_delete(&cdc_acm -> ux_slave_class_cdc_acm_bulkin_thread);
         if (cdc_acm -> ux_slave_class_cdc_acm_event_flags_group.tx_event_flags_group_id)
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_cdc_acm_ioctl                      PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,12 +55,15 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_device_stack_transfer_abort           Abort transfer            */
+/*    _ux_device_stack_transfer_all_request_abort                         */
+/*                                              Abort all transfers       */
 /*    _ux_utility_memory_allocate               Allocate memory           */
 /*    _ux_utility_memory_free                   Free memory               */
 /*    _ux_utility_event_flags_create            Create event flags        */
 /*    _ux_utility_event_flags_delete            Delete event flags        */
 /*    _ux_device_thread_create                  Create thread             */
 /*    _ux_device_thread_delete                  Delete thread             */
+/*    _ux_device_event_flags_set                Set event flags           */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -98,11 +101,21 @@
 /*                                            resulting in version 6.1.12 */
 /*  10-31-2023     Yajun Xia                Modified comment(s),          */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added reception ring        */
+/*                                            support, added write        */
+/*                                            coalescing support, reset   */
+/*                                            coalescing ring with        */
+/*                                            interrupts disabled,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_cdc_acm_ioctl(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, ULONG ioctl_function,
                                     VOID *parameter)
 {
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+UX_INTERRUPT_SAVE_AREA
+#endif
 
 UINT                                                status;
 UX_SLAVE_CLASS_CDC_ACM_LINE_CODING_PARAMETER        *line_coding;
@@ -272,6 +285,13 @@ UX_SLAVE_TRANSFER                                   *transfer_request;
                 return(UX_ERROR);
             
             }
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+            /* Check if bulk out thread is used by reception ring.  */
+            if (cdc_acm -> ux_device_class_cdc_acm_read_ring_status == UX_TRUE)
+                return(UX_ERROR);
+#endif
             
             /* Properly cast the parameter pointer.  */
             callback = (UX_SLAVE_CLASS_CDC_ACM_CALLBACK_PARAMETER *) parameter;
@@ -332,8 +352,26 @@ UX_SLAVE_TRANSFER                                   *transfer_request;
                 /* Clear scheduled write flag.  */
                 cdc_acm -> ux_slave_class_cdc_acm_scheduled_write = UX_FALSE;
 
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+                /* Discard data pending in coalescing ring. The bulk IN thread
+                   may be suspended while sending from the ring, the reset count
+                   tells it its ring position is stale when it is resumed.  */
+                UX_DISABLE
+                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_head = 0;
+                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_tail = 0;
+                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count = 0;
+                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_flush = UX_FALSE;
+                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_reset ++;
+
+                /* Declare the transmission with callback off.  */
+                cdc_acm -> ux_slave_class_cdc_acm_transmission_status = UX_FALSE;
+                UX_RESTORE
+#else
+
                 /* Declare the transmission with callback off.  */
                 cdc_acm -> ux_slave_class_cdc_acm_transmission_status = UX_FALSE;
+#endif
             }
             else
                 
@@ -341,6 +379,87 @@ UX_SLAVE_TRANSFER                                   *transfer_request;
                 return(UX_ERROR);                
 
             break;                
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+        case UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_START:
+
+            /* Check if bulk out thread is used already.  */
+            if ((cdc_acm -> ux_slave_class_cdc_acm_transmission_status == UX_TRUE) ||
+                (cdc_acm -> ux_device_class_cdc_acm_read_ring_status == UX_TRUE))
+                return(UX_ERROR);
+
+            /* Reset the ring.  */
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_head = 0;
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_tail = 0;
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_count = 0;
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_waiting = UX_FALSE;
+
+            /* Declare the reception ring on.  */
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_status = UX_TRUE;
+
+            /* Start bulk out thread to fill the ring.  */
+            _ux_utility_thread_resume(&cdc_acm -> ux_slave_class_cdc_acm_bulkout_thread);
+
+            /* We are done here.  */
+            return(UX_SUCCESS);
+
+        case UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_STOP:
+
+            /* We should not try to stop an non existing reception ring.  */
+            if (cdc_acm -> ux_device_class_cdc_acm_read_ring_status != UX_TRUE)
+                return(UX_ERROR);
+
+            /* Declare the reception ring off.  */
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_status = UX_FALSE;
+
+            /* Locate the bulk out endpoint.  */
+            interface_ptr =  cdc_acm -> ux_slave_class_cdc_acm_interface;
+            endpoint =  interface_ptr -> ux_slave_interface_first_endpoint;
+            if ((endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_OUT)
+                endpoint =  endpoint -> ux_slave_endpoint_next_endpoint;
+
+            /* Abort the transfer and the packets queued.  */
+            _ux_device_stack_transfer_all_request_abort(endpoint, UX_ABORTED);
+
+            /* Wake up the bulk out thread if it's waiting for room, then suspend it.  */
+            _ux_device_event_flags_set(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group,
+                                       UX_DEVICE_CLASS_CDC_ACM_READ_RING_EVENT, UX_OR);
+            _ux_device_thread_suspend(&cdc_acm -> ux_slave_class_cdc_acm_bulkout_thread);
+
+            break;
+#endif
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+        case UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE:
+
+            /* Coalescing is enabled or disabled only when there is no write pending.  */
+            if (((cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency == 0) != ((ALIGN_TYPE) parameter == 0)) &&
+                ((cdc_acm -> ux_slave_class_cdc_acm_scheduled_write == UX_TRUE) ||
+                 (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count != 0)))
+                return(UX_BUSY);
+
+            /* Save the latency deadline, in ms.  */
+            cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency = (ULONG) (ALIGN_TYPE) parameter;
+
+            /* Let bulk in thread apply the new deadline.  */
+            _ux_device_event_flags_set(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group,
+                                       UX_DEVICE_CLASS_CDC_ACM_WRITE_EVENT, UX_OR);
+            break;
+
+        case UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH:
+
+            /* Check if coalescing is enabled.  */
+            if (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency == 0)
+                return(UX_ERROR);
+
+            /* Request bulk in thread to send all data pending.  */
+            cdc_acm -> ux_device_class_cdc_acm_write_coalesce_flush = UX_TRUE;
+            _ux_device_event_flags_set(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group,
+                                       UX_DEVICE_CLASS_CDC_ACM_WRITE_EVENT, UX_OR);
+            break;
+#endif
 #endif
 
         default: 
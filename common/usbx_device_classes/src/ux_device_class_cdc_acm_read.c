@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_cdc_acm_read                       PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -65,6 +65,8 @@
 /*    _ux_device_stack_transfer_request     Transfer request              */ 
 /*    _ux_utility_memory_copy               Copy memory                   */ 
 /*    _ux_device_mutex_off                  Release mutex                 */ 
+/*    _ux_device_class_cdc_acm_read_peek    Copy data from reception ring */
+/*    _ux_device_event_flags_set            Set event flags               */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -95,6 +97,10 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added reception ring        */
+/*                                            support,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_cdc_acm_read(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer, 
@@ -107,10 +113,52 @@ UX_SLAVE_INTERFACE          *interface_ptr;
 UX_SLAVE_TRANSFER           *transfer_request;
 UINT                        status= UX_SUCCESS;
 ULONG                       local_requested_length;
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+UX_INTERRUPT_SAVE_AREA
+UINT                        waiting;
+#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_CLASS_CDC_ACM_READ, cdc_acm, buffer, requested_length, 0, UX_TRACE_DEVICE_CLASS_EVENTS, 0, 0)
 
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+    /* Check if reception ring is started, data is read from the ring without waiting.  */
+    if (cdc_acm -> ux_device_class_cdc_acm_read_ring_status == UX_TRUE)
+    {
+
+        /* Protect this thread.  */
+        _ux_device_mutex_on(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_out_mutex);
+
+        /* Copy data from the ring.  */
+        status = _ux_device_class_cdc_acm_read_peek(cdc_acm, buffer, requested_length, actual_length);
+        if ((status == UX_SUCCESS) && (*actual_length != 0))
+        {
+
+            /* Remove the data from the ring.  */
+            UX_DISABLE
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_tail += *actual_length;
+            if (cdc_acm -> ux_device_class_cdc_acm_read_ring_tail >= UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE)
+                cdc_acm -> ux_device_class_cdc_acm_read_ring_tail -= UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE;
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_count -= *actual_length;
+            waiting = cdc_acm -> ux_device_class_cdc_acm_read_ring_waiting;
+            cdc_acm -> ux_device_class_cdc_acm_read_ring_waiting = UX_FALSE;
+            UX_RESTORE
+
+            /* Wake up the bulk out thread if it's waiting for room in the ring.  */
+            if (waiting)
+                _ux_device_event_flags_set(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group,
+                                           UX_DEVICE_CLASS_CDC_ACM_READ_RING_EVENT, UX_OR);
+        }
+
+        /* Free Mutex resource.  */
+        _ux_device_mutex_off(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_out_mutex);
+
+        /* Return completion status.  */
+        return(status);
+    }
+#endif
+
 #ifndef UX_DEVICE_CLASS_CDC_ACM_TRANSMISSION_DISABLE
 
     /* Check if current cdc-acm is using callback or not. We cannot use direct reads with callback on.  */
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Device CDC Class                                                    */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define UX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "ux_api.h"
+#include "ux_device_class_cdc_acm.h"
+#include "ux_device_stack.h"
+
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_device_class_cdc_acm_read_peek                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies data saved in the reception ring of the CDC    */
+/*    class to the application buffer, without waiting. The data is kept  */
+/*    in the ring, it is removed by next read.                            */
+/*                                                                        */
+/*    It's for RTOS mode, with reception ring started.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cdc_acm                               Address of cdc_acm class      */
+/*                                          instance                      */
+/*    buffer                                Pointer to buffer to save     */
+/*                                          received data                 */
+/*    requested_length                      Length of bytes to read       */
+/*    actual_length                         Pointer to save number of     */
+/*                                          bytes read                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_mutex_on                   Take mutex                    */
+/*    _ux_device_mutex_off                  Release mutex                 */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _ux_device_class_cdc_acm_read_peek(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
+                                ULONG requested_length, ULONG *actual_length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+ULONG                       tail;
+ULONG                       count;
+ULONG                       length;
+
+    /* Check if the reception ring is started.  */
+    if (cdc_acm -> ux_device_class_cdc_acm_read_ring_status != UX_TRUE)
+    {
+
+        /* Nothing can be read from the ring.  */
+        *actual_length = 0;
+        return(UX_ERROR);
+    }
+
+    /* Protect the ring reader.  */
+    _ux_device_mutex_on(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_out_mutex);
+
+    /* Get the ring data position, it is updated by bulk out thread.  */
+    UX_DISABLE
+    tail = cdc_acm -> ux_device_class_cdc_acm_read_ring_tail;
+    count = cdc_acm -> ux_device_class_cdc_acm_read_ring_count;
+    UX_RESTORE
+
+    /* Copy no more than available.  */
+    if (requested_length > count)
+        requested_length = count;
+    *actual_length = requested_length;
+
+    /* Copy till the end of the ring.  */
+    length = UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - tail;
+    if (length > requested_length)
+        length = requested_length;
+    if (length)
+        _ux_utility_memory_copy(buffer, cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer + tail, length); /* Use case of memcpy is verified. */
+
+    /* Copy the wrapped part from the start of the ring.  */
+    if (requested_length > length)
+        _ux_utility_memory_copy(buffer + length, cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer,
+                                requested_length - length); /* Use case of memcpy is verified. */
+
+    /* Free Mutex resource.  */
+    _ux_device_mutex_off(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_out_mutex);
+
+    /* Return completion status.  */
+    return(UX_SUCCESS);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_device_class_cdc_acm_read_peek                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in CDC ACM class read peek function.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cdc_acm                               Address of cdc_acm class      */
+/*                                          instance                      */
+/*    buffer                                Pointer to buffer to save     */
+/*                                          received data                 */
+/*    requested_length                      Length of bytes to read       */
+/*    actual_length                         Pointer to save number of     */
+/*                                          bytes read                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_device_class_cdc_acm_read_peek    CDC ACM class read peek       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT _uxe_device_class_cdc_acm_read_peek(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
+                                ULONG requested_length, ULONG *actual_length)
+{
+
+    /* Sanity checks.  */
+    if ((cdc_acm == UX_NULL) || ((buffer == UX_NULL) && (requested_length > 0)) || (actual_length == UX_NULL))
+    {
+        return (UX_INVALID_PARAMETER);
+    }
+
+    return (_ux_device_class_cdc_acm_read_peek(cdc_acm, buffer, requested_length, actual_length));
+}
+
+#endif
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_cdc_acm_uninitialize               PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -87,6 +87,11 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added reception ring        */
+/*                                            support, added write        */
+/*                                            coalescing support,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_cdc_acm_uninitialize(UX_SLAVE_CLASS_COMMAND *command)
@@ -120,6 +125,13 @@ UX_SLAVE_CLASS              *class_ptr;
         _ux_utility_thread_delete(&cdc_acm -> ux_slave_class_cdc_acm_bulkout_thread);
         _ux_utility_event_flags_delete(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group);
         _ux_utility_memory_free(cdc_acm -> ux_slave_class_cdc_acm_bulkout_thread_stack);
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+        _ux_utility_memory_free(cdc_acm -> ux_device_class_cdc_acm_read_ring_buffer);
+        _ux_utility_memory_free(cdc_acm -> ux_device_class_cdc_acm_read_ring_packets);
+#endif
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+        _ux_utility_memory_free(cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer);
+#endif
 #endif
 #endif
 
@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_cdc_acm_write_with_callback        PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -43,6 +43,10 @@
 /*                                                                        */
 /*    This function writes to  the CDC class with callback                */
 /*                                                                        */
+/*    If write coalescing is enabled, data is appended to the coalescing  */
+/*    ring and sent by bulk in thread. The write callback then reports    */
+/*    each batch sent from the ring, not each write.                      */
+/*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    cdc_acm                               Address of cdc_acm class      */
@@ -57,6 +61,11 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*   _ux_device_stack_transfer_request                                    */
+/*   _ux_device_mutex_on                    Take mutex                    */
+/*   _ux_device_mutex_off                   Release mutex                 */
+/*   _ux_utility_memory_copy                Copy memory                   */
+/*   _ux_utility_time_get                   Get current time              */
+/*   _ux_device_event_flags_set             Set event flags               */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -83,6 +92,10 @@
 /*                                            resulting in version 6.1.11 */
 /*  10-31-2023     Yajun Xia                Modified comment(s),          */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added write coalescing      */
+/*                                            support,                    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_cdc_acm_write_with_callback(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UCHAR *buffer,
@@ -96,6 +109,11 @@ UINT _ux_device_class_cdc_acm_write_with_callback(UX_SLAVE_CLASS_CDC_ACM *cdc_ac
 #else
 UX_SLAVE_DEVICE             *device;
 UINT                        status;
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+UX_INTERRUPT_SAVE_AREA
+ULONG                       head;
+ULONG                       length;
+#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_CLASS_CDC_ACM_WRITE, cdc_acm, buffer, requested_length, 0, UX_TRACE_DEVICE_CLASS_EVENTS, 0, 0)
@@ -126,6 +144,60 @@ UINT                        status;
 
     }
 
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+    /* Check if writes are coalesced in the ring.  */
+    if (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_latency != 0)
+    {
+
+        /* Protect the ring writer.  */
+        _ux_device_mutex_on(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_in_mutex);
+
+        /* Check room in the ring, data is not cut.  */
+        if (requested_length > UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE -
+                                cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count)
+        {
+
+            /* Free Mutex resource.  */
+            _ux_device_mutex_off(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_in_mutex);
+            return(UX_BUFFER_OVERFLOW);
+        }
+
+        /* The writer is the only one to update the head.  */
+        head = cdc_acm -> ux_device_class_cdc_acm_write_coalesce_head;
+
+        /* Copy till the end of the ring.  */
+        length = UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE - head;
+        if (length > requested_length)
+            length = requested_length;
+        if (length)
+            _ux_utility_memory_copy(cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer + head,
+                                    buffer, length); /* Use case of memcpy is verified. */
+
+        /* Copy the rest to the start of the ring.  */
+        if (requested_length > length)
+            _ux_utility_memory_copy(cdc_acm -> ux_device_class_cdc_acm_write_coalesce_buffer,
+                                    buffer + length, requested_length - length); /* Use case of memcpy is verified. */
+
+        /* Update the ring, the deadline starts with the oldest byte pending.  */
+        head += requested_length;
+        if (head >= UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE)
+            head -= UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE;
+        UX_DISABLE
+        cdc_acm -> ux_device_class_cdc_acm_write_coalesce_head = head;
+        if (cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count == 0)
+            cdc_acm -> ux_device_class_cdc_acm_write_coalesce_time = _ux_utility_time_get();
+        cdc_acm -> ux_device_class_cdc_acm_write_coalesce_count += requested_length;
+        UX_RESTORE
+
+        /* Free Mutex resource.  */
+        _ux_device_mutex_off(&cdc_acm -> ux_slave_class_cdc_acm_endpoint_in_mutex);
+
+        /* Invoke the bulkin thread by sending a flag .  */
+        return(_ux_device_event_flags_set(&cdc_acm -> ux_slave_class_cdc_acm_event_flags_group, UX_DEVICE_CLASS_CDC_ACM_WRITE_EVENT, UX_OR));
+    }
+#endif
+
     /* Have we already scheduled a buffer ?   */
     if (cdc_acm -> ux_slave_class_cdc_acm_scheduled_write == UX_TRUE)
     {
@@ -61,6 +61,7 @@
 /*    _ux_utility_event_flags_get           Get event flags               */
 /*    _ux_device_mutex_on                   Take mutex                    */
 /*    _ux_device_mutex_off                  Free mutex                    */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -91,6 +92,9 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_cdc_ecm_bulkin_thread(ULONG cdc_ecm_class)
@@ -274,12 +278,24 @@ NX_PACKET                       *packet;
                         {
 
                             /* Packet is too large.  */
+                            status = UX_TRANSFER_BUFFER_OVERFLOW;
 
                             /* Report error to application.  */
                             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_BUFFER_OVERFLOW);
                         }
 #endif
                     }
+                    else
+
+                        /* Packet is not sent.  */
+                        status = UX_CLASS_ETH_LINK_STATE_DOWN_ERROR;
+
+                    /* Log the transmit completion.  */
+                    _ux_network_driver_packet_transmitted(cdc_ecm -> ux_slave_class_cdc_ecm_network_handle, current_packet,
+                            (status == UX_SUCCESS) ? USB_NETWORK_DEVICE_DROP_NONE :
+                            (status == UX_TRANSFER_BUFFER_OVERFLOW) ? USB_NETWORK_DEVICE_DROP_OVERSIZE :
+                            (status == UX_CLASS_ETH_LINK_STATE_DOWN_ERROR) ? USB_NETWORK_DEVICE_DROP_LINK_DOWN :
+                                                                               USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR);
 
                     /* Free the packet that was just sent.  First do some housekeeping.  */
                     current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_DEVICE_CLASS_CDC_ECM_ETHERNET_SIZE; 
@@ -310,6 +326,9 @@ NX_PACKET                       *packet;
                     /* Set the next packet (or a NULL value) as the head of the xmit queue. */
                     cdc_ecm -> ux_slave_class_cdc_ecm_xmit_queue =  current_packet -> nx_packet_queue_next;
 
+                    /* Log the transmit completion.  */
+                    _ux_network_driver_packet_transmitted(cdc_ecm -> ux_slave_class_cdc_ecm_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_LINK_DOWN);
+
                     /* Free the packet.  */
                     current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_DEVICE_CLASS_CDC_ECM_ETHERNET_SIZE; 
                     current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_DEVICE_CLASS_CDC_ECM_ETHERNET_SIZE;
@@ -62,6 +62,8 @@
 /*    nx_packet_allocate                    Allocate NetX packet          */
 /*    nx_packet_release                     Free NetX packet              */
 /*    _ux_device_thread_suspend             Suspend thread                */
+/*    _ux_network_driver_packet_lend        Lend NetX packet              */
+/*    _ux_network_driver_packet_dropped     Log dropped frame             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -93,6 +95,12 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            packet lend support,        */
+/*                                            resulting in version 6.x    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_cdc_ecm_bulkout_thread(ULONG cdc_ecm_class)
@@ -153,16 +161,38 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                 continue;
             }
 
+            /* Select the transfer request associated with BULK OUT endpoint.   */
+            transfer_request =  &cdc_ecm -> ux_slave_class_cdc_ecm_bulkout_endpoint -> ux_slave_endpoint_transfer_request;
+
+#if defined(UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND)
+
+            /* We can accept new reception. Get a NX Packet lent as transfer buffer.  */
+            status =  _ux_network_driver_packet_lend(cdc_ecm -> ux_slave_class_cdc_ecm_packet_pool, 0,
+                                                     UX_DEVICE_CLASS_CDC_ECM_BULKOUT_BUFFER_SIZE, &packet,
+                                                     UX_MS_TO_TICK(UX_DEVICE_CLASS_CDC_ECM_PACKET_POOL_WAIT));
+            if (status == UX_SUCCESS)
+
+                /* Receive directly in packet payload.  */
+                transfer_request -> ux_slave_transfer_request_data_pointer = packet -> nx_packet_prepend_ptr;
+
+            else if (status == UX_BUFFER_OVERFLOW)
+            {
+
+                /* Packet payload can not hold a frame, receive in endpoint buffer and copy.  */
+                transfer_request -> ux_slave_transfer_request_data_pointer = UX_DEVICE_CLASS_CDC_ECM_BULKOUT_BUFFER(cdc_ecm);
+                status =  nx_packet_allocate(cdc_ecm -> ux_slave_class_cdc_ecm_packet_pool, &packet,
+                                             NX_RECEIVE_PACKET, UX_MS_TO_TICK(UX_DEVICE_CLASS_CDC_ECM_PACKET_POOL_WAIT));
+            }
+#else
+
             /* We can accept new reception. Get a NX Packet */
             status =  nx_packet_allocate(cdc_ecm -> ux_slave_class_cdc_ecm_packet_pool, &packet, 
                                          NX_RECEIVE_PACKET, UX_MS_TO_TICK(UX_DEVICE_CLASS_CDC_ECM_PACKET_POOL_WAIT));
+#endif
 
             if (status == NX_SUCCESS)
             {
 
-                /* Select the transfer request associated with BULK OUT endpoint.   */
-                transfer_request =  &cdc_ecm -> ux_slave_class_cdc_ecm_bulkout_endpoint -> ux_slave_endpoint_transfer_request;
-
                 /* And length.  */
                 transfer_request -> ux_slave_transfer_request_requested_length =  UX_DEVICE_CLASS_CDC_ECM_BULKOUT_BUFFER_SIZE;
                 transfer_request -> ux_slave_transfer_request_actual_length =     0;
@@ -195,6 +225,22 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                     /* If trace is enabled, insert this event into the trace buffer.  */
                     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_CLASS_CDC_ECM_PACKET_RECEIVE, cdc_ecm, 0, 0, 0, UX_TRACE_DEVICE_CLASS_EVENTS, 0, 0)
 
+#if defined(UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND)
+
+                    /* Check if data is received directly in packet.  */
+                    if (transfer_request -> ux_slave_transfer_request_data_pointer == packet -> nx_packet_prepend_ptr)
+                    {
+
+                        /* Data already in packet, aligned on lend.  */
+                        packet -> nx_packet_length = transfer_request -> ux_slave_transfer_request_actual_length;
+                        packet -> nx_packet_append_ptr += packet -> nx_packet_length;
+
+                        /* Send that packet to the NetX USB broker.  */
+                        _ux_network_driver_packet_received(cdc_ecm -> ux_slave_class_cdc_ecm_network_handle, packet);
+                        continue;
+                    }
+#endif
+
                     /* Adjust the prepend pointer to take into account the non 3 bit alignment of the ethernet header.  */
                     packet -> nx_packet_prepend_ptr += sizeof(USHORT);
                     packet -> nx_packet_append_ptr += sizeof(USHORT);
@@ -226,6 +272,9 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                         /* We received a malformed packet. Report to application.  */
                         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_MALFORMED_PACKET_RECEIVED_ERROR);
                         nx_packet_release(packet);
+
+                        /* Log the dropped frame, no packet to chain the data.  */
+                        _ux_network_driver_packet_dropped(cdc_ecm -> ux_slave_class_cdc_ecm_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
                     }
 #endif
                 }
@@ -242,6 +291,9 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
 
                 /* Error trap. No need for trace, since NetX does it.  */
                 _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
+
+                /* Log the reception refused, no packet to receive the frame.  */
+                _ux_network_driver_packet_dropped(cdc_ecm -> ux_slave_class_cdc_ecm_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
             }
         }
              
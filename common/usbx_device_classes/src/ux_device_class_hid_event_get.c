@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_hid_event_check                    PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -42,7 +42,9 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function checks if there is an event from the application and  */
-/*    fill a pointer to access the event.                                 */
+/*    fill a pointer to access the event. Events replaced by newer events */
+/*    of the same report are skipped, an event being replaced is not      */
+/*    reported until it is written.                                       */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -66,12 +68,18 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Chaoqiong Xiao           Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added events coalescing,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_hid_event_check(UX_SLAVE_CLASS_HID *hid,
                                        UX_DEVICE_CLASS_HID_EVENT **hid_event)
 {
 UX_SLAVE_DEVICE                 *device;
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+UCHAR                           *pos;
+#endif
 
     /* Get the pointer to the device.  */
     device =  &_ux_system_slave -> ux_system_slave_device;
@@ -80,12 +88,32 @@ UX_SLAVE_DEVICE                 *device;
     if (device -> ux_slave_device_state != UX_DEVICE_CONFIGURED)
         return(UX_DEVICE_HANDLE_UNKNOWN);
 
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+
+    /* Skip the events replaced by newer ones.  */
+    while ((hid -> ux_device_class_hid_event_array_head != hid -> ux_device_class_hid_event_array_tail) &&
+           (hid -> ux_device_class_hid_event_array_tail -> ux_device_class_hid_event_report_id == UX_DEVICE_CLASS_HID_EVENT_COALESCED))
+    {
+        pos = (UCHAR *) hid -> ux_device_class_hid_event_array_tail;
+        pos += UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid);
+        if (pos >= (UCHAR *) hid -> ux_device_class_hid_event_array_end)
+            pos = (UCHAR *) hid -> ux_device_class_hid_event_array;
+        hid -> ux_device_class_hid_event_array_tail = (UX_DEVICE_CLASS_HID_EVENT *) pos;
+    }
+#endif
+
     /* Check if the head and the tail of the event array is the same.  */
     if (hid -> ux_device_class_hid_event_array_head ==
         hid -> ux_device_class_hid_event_array_tail)
 
         /* No event to report.  */
         return(UX_ERROR);
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+
+    /* The event is being replaced, it is reported once written.  */
+    if (hid -> ux_device_class_hid_event_array_tail -> ux_device_class_hid_event_report_id == UX_DEVICE_CLASS_HID_EVENT_WRITING)
+        return(UX_ERROR);
+#endif
 
     /* There is an event to report, get the current pointer to the event.  */
     *hid_event =  hid -> ux_device_class_hid_event_array_tail;
@@ -98,7 +126,7 @@ UX_SLAVE_DEVICE                 *device;
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_hid_event_free                     PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -116,6 +144,7 @@ UX_SLAVE_DEVICE                 *device;
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_utility_time_get                     Get current time           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -126,13 +155,33 @@ UX_SLAVE_DEVICE                 *device;
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Chaoqiong Xiao           Initial Version 6.3.0         */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added events queue          */
+/*                                            statistics,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_hid_event_free(UX_SLAVE_CLASS_HID *hid)
 {
 UCHAR                           *pos;
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS  *statistics;
+ULONG                           tail_index;
+ULONG                           age;
+#endif
 
     pos = (UCHAR *) hid -> ux_device_class_hid_event_array_tail;
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+
+    /* Update the age of the events when they are sent.  */
+    statistics = &hid -> ux_device_class_hid_event_statistics;
+    tail_index = (ULONG)(pos - (UCHAR *) hid -> ux_device_class_hid_event_array) /
+                 UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid);
+    age = (ULONG)_ux_utility_time_elapsed(hid -> ux_device_class_hid_event_times[tail_index], _ux_utility_time_get());
+    statistics -> ux_device_class_hid_event_statistics_age_last = age;
+    if (age > statistics -> ux_device_class_hid_event_statistics_age_max)
+        statistics -> ux_device_class_hid_event_statistics_age_max = age;
+#endif
     pos += UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid);
     if (pos >= (UCHAR *) hid -> ux_device_class_hid_event_array_end)
         pos = (UCHAR *) hid -> ux_device_class_hid_event_array;
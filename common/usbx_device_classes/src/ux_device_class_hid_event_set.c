@@ -34,7 +34,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_hid_event_set                      PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -44,6 +44,19 @@
 /*    This function sends an event to the hid class. It is processed      */ 
 /*    asynchronously by the interrupt thread.                             */ 
 /*                                                                        */ 
+/*    The event is copied into the queue head before the head is moved,   */ 
+/*    so a single producer, thread or ISR, can queue events while the     */ 
+/*    interrupt thread sends them without lock.                           */ 
+/*                                                                        */ 
+/*    With events coalescing, the pending events of the same report are   */
+/*    skipped and the event is published in one short interrupt disabled */
+/*    section. An event that finds the queue full replaces the newest     */
+/*    pending event of its report instead of being dropped, the event at  */
+/*    the tail is never replaced as it may be being sent. The replaced    */
+/*    event is marked as being written while interrupts are disabled,     */
+/*    its data is copied with interrupts enabled, then setting its report */
+/*    ID publishes it again.                                              */
+/*                                                                        */
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    hid                                      Address of hid class       */ 
@@ -57,6 +70,7 @@
 /*                                                                        */ 
 /*    _ux_utility_memory_copy                  Copy memory                */
 /*    _ux_device_event_flags_set               Set event flags            */
+/*    _ux_utility_time_get                     Get current time           */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -82,6 +96,15 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added zero copy support,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            published event after copy, */
+/*                                            added events coalescing and */
+/*                                            events queue statistics,    */
+/*                                            added latency probe,        */
+/*                                            coalesced events on a full  */
+/*                                            queue without copying with  */
+/*                                            interrupts disabled,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_hid_event_set(UX_SLAVE_CLASS_HID *hid, 
@@ -90,7 +113,20 @@ UINT  _ux_device_class_hid_event_set(UX_SLAVE_CLASS_HID *hid,
 
 UX_DEVICE_CLASS_HID_EVENT   *current_hid_event;
 UX_DEVICE_CLASS_HID_EVENT   *next_hid_event;
+UX_DEVICE_CLASS_HID_EVENT   *target_hid_event;
 UCHAR                       *next_position;
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+UX_INTERRUPT_SAVE_AREA
+UX_DEVICE_CLASS_HID_EVENT   *pending_hid_event;
+ULONG                       coalesced = 0;
+#endif
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS  *statistics;
+ULONG                       head_index;
+ULONG                       tail_index;
+ULONG                       queue_size;
+ULONG                       depth;
+#endif
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_DEVICE_CLASS_HID_EVENT_SET, hid, hid_event, 0, 0, UX_TRACE_DEVICE_CLASS_EVENTS, 0, 0)
@@ -108,45 +144,88 @@ UCHAR                       *next_position;
         next_position = (UCHAR *)hid -> ux_device_class_hid_event_array;
     next_hid_event = (UX_DEVICE_CLASS_HID_EVENT *)next_position;
 
-    /* Any place left for this event ? */
-    if (next_hid_event == hid -> ux_device_class_hid_event_array_tail)
-        return (UX_ERROR);
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+    statistics = &hid -> ux_device_class_hid_event_statistics;
+#endif
 
-    /* There is an event to report, get the current pointer to the event.  */
-    current_hid_event =  hid -> ux_device_class_hid_event_array_head;
+    /* Check this event fits the event buffer, with the report ID if any.  */
+    if (hid_event -> ux_device_class_hid_event_length + ((hid -> ux_device_class_hid_report_id == UX_TRUE) ? 1 : 0) >
+        UX_DEVICE_CLASS_HID_EVENT_MAX_LENGTH(hid))
+    {
 
-    /* Update the head.  */
-    hid -> ux_device_class_hid_event_array_head = next_hid_event;
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
 
-    /* Check if this event has a report ID.  */
-    if (hid -> ux_device_class_hid_report_id == UX_TRUE)
-    {
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_MEMORY_INSUFFICIENT, 0, 0, 0, UX_TRACE_ERRORS, 0, 0)
 
-        /* Yes, there's a report ID. Check to see if our event buffer can also
-           fit the extra byte.  */
-        if (hid_event -> ux_device_class_hid_event_length + 1 > UX_DEVICE_CLASS_HID_EVENT_MAX_LENGTH(hid))
-        {
+        /* Return overflow error.  */
+        return(UX_MEMORY_INSUFFICIENT);
+    }
 
-            /* Error trap. */
-            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
+    /* The event goes to the head of the queue.  */
+    target_hid_event = current_hid_event;
 
-            /* If trace is enabled, insert this event into the trace buffer.  */
-            UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_MEMORY_INSUFFICIENT, 0, 0, 0, UX_TRACE_ERRORS, 0, 0)
+    /* Any place left for this event ? */
+    if (next_hid_event == hid -> ux_device_class_hid_event_array_tail)
+    {
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
 
-            /* Return overflow error.  */
-            return(UX_MEMORY_INSUFFICIENT);
+        /* The event replaces the newest pending event of the same report, not the
+           one at the tail that may be being sent. The older ones of the report are
+           skipped. The replaced event is marked as being written, the interrupt
+           thread stops there until it is published again.  */
+        if (hid -> ux_device_class_hid_event_coalesce)
+        {
+            UX_DISABLE
+            pending_hid_event = hid -> ux_device_class_hid_event_array_tail;
+            while (pending_hid_event != current_hid_event)
+            {
+                if (pending_hid_event != hid -> ux_device_class_hid_event_array_tail &&
+                    UX_DEVICE_CLASS_HID_EVENT_SAME_REPORT(hid, pending_hid_event, hid_event))
+                    target_hid_event = pending_hid_event;
+                UX_DEVICE_CLASS_HID_EVENT_QUEUE_NEXT(hid, pending_hid_event);
+            }
+            if (target_hid_event != current_hid_event)
+            {
+                pending_hid_event = hid -> ux_device_class_hid_event_array_tail;
+                while (pending_hid_event != target_hid_event)
+                {
+                    if (UX_DEVICE_CLASS_HID_EVENT_SAME_REPORT(hid, pending_hid_event, hid_event))
+                    {
+                        pending_hid_event -> ux_device_class_hid_event_report_id = UX_DEVICE_CLASS_HID_EVENT_COALESCED;
+                        coalesced ++;
+                    }
+                    UX_DEVICE_CLASS_HID_EVENT_QUEUE_NEXT(hid, pending_hid_event);
+                }
+                target_hid_event -> ux_device_class_hid_event_report_id = UX_DEVICE_CLASS_HID_EVENT_WRITING;
+            }
+            UX_RESTORE
         }
+        if (target_hid_event == current_hid_event)
+#endif
+        {
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+            statistics -> ux_device_class_hid_event_statistics_dropped ++;
+#endif
+            return (UX_ERROR);
+        }
+    }
+
+    /* Check if this event has a report ID.  */
+    if (hid -> ux_device_class_hid_report_id == UX_TRUE)
+    {
 
         /* Store the report ID.  */
-        *UX_DEVICE_CLASS_HID_EVENT_BUFFER(current_hid_event) =  (UCHAR)(hid_event -> ux_device_class_hid_event_report_id);
+        *UX_DEVICE_CLASS_HID_EVENT_BUFFER(target_hid_event) =  (UCHAR)(hid_event -> ux_device_class_hid_event_report_id);
 
         /* Store the data itself.  */
-        _ux_utility_memory_copy(UX_DEVICE_CLASS_HID_EVENT_BUFFER(current_hid_event) + 1,
+        _ux_utility_memory_copy(UX_DEVICE_CLASS_HID_EVENT_BUFFER(target_hid_event) + 1,
                                 hid_event -> ux_device_class_hid_event_buffer,
                                 hid_event -> ux_device_class_hid_event_length); /* Use case of memcpy is verified. */
     
         /* fill in the event structure from the user.  */
-        current_hid_event -> ux_device_class_hid_event_length =  hid_event -> ux_device_class_hid_event_length + 1;    
+        target_hid_event -> ux_device_class_hid_event_length =  hid_event -> ux_device_class_hid_event_length + 1;    
     }
     else
     {
@@ -154,14 +233,83 @@ UCHAR                       *next_position;
         /* No report ID to consider.  */
 
         /* Store copy of data so application can free event there (easier use).  */
-        _ux_utility_memory_copy(UX_DEVICE_CLASS_HID_EVENT_BUFFER(current_hid_event),
+        _ux_utility_memory_copy(UX_DEVICE_CLASS_HID_EVENT_BUFFER(target_hid_event),
                                 hid_event -> ux_device_class_hid_event_buffer,
                                 hid_event -> ux_device_class_hid_event_length); /* Use case of memcpy is verified. */
 
         /* fill in the event structure from the user.  */
-        current_hid_event -> ux_device_class_hid_event_length = hid_event -> ux_device_class_hid_event_length;    
+        target_hid_event -> ux_device_class_hid_event_length = hid_event -> ux_device_class_hid_event_length;    
+    }
+
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+
+    /* Stamp the event, its age is taken when it is sent.  */
+    head_index = (ULONG)((UCHAR *)target_hid_event - (UCHAR *)hid -> ux_device_class_hid_event_array) /
+                 UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid);
+    hid -> ux_device_class_hid_event_times[head_index] = _ux_utility_time_get();
+#endif
+
+    /* Probe the event before it is published.  */
+    UX_HID_LATENCY_PROBE(UX_HID_LATENCY_STAGE_EVENT_SET, UX_DEVICE_CLASS_HID_EVENT_BUFFER(target_hid_event),
+                         target_hid_event -> ux_device_class_hid_event_length);
+
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+    if (target_hid_event != current_hid_event)
+    {
+
+        /* The replaced event is complete, its report ID publishes it again.  */
+        target_hid_event -> ux_device_class_hid_event_report_id = hid_event -> ux_device_class_hid_event_report_id;
+        coalesced ++;
+    }
+    else if (hid -> ux_device_class_hid_event_coalesce)
+    {
+
+        /* Skip the pending events of the same report and publish the event at once,
+           so the interrupt thread does not move on meanwhile. A pending event
+           already being sent is sent anyway.  */
+        target_hid_event -> ux_device_class_hid_event_report_id = hid_event -> ux_device_class_hid_event_report_id;
+        UX_DISABLE
+        pending_hid_event = hid -> ux_device_class_hid_event_array_tail;
+        while (pending_hid_event != current_hid_event)
+        {
+            if (UX_DEVICE_CLASS_HID_EVENT_SAME_REPORT(hid, pending_hid_event, hid_event))
+            {
+                pending_hid_event -> ux_device_class_hid_event_report_id = UX_DEVICE_CLASS_HID_EVENT_COALESCED;
+                coalesced ++;
+            }
+            UX_DEVICE_CLASS_HID_EVENT_QUEUE_NEXT(hid, pending_hid_event);
+        }
+        hid -> ux_device_class_hid_event_array_head = next_hid_event;
+        UX_RESTORE
+    }
+    else
+#endif
+    {
+
+        /* The event is complete, publish it to the interrupt thread.  */
+        target_hid_event -> ux_device_class_hid_event_report_id = hid_event -> ux_device_class_hid_event_report_id;
+        hid -> ux_device_class_hid_event_array_head = next_hid_event;
     }
 
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+    statistics -> ux_device_class_hid_event_statistics_coalesced += coalesced;
+    if (target_hid_event == current_hid_event)
+#endif
+    {
+
+        /* Update the queue depth.  */
+        statistics -> ux_device_class_hid_event_statistics_queued ++;
+        queue_size = (ULONG)((UCHAR *)hid -> ux_device_class_hid_event_array_end - (UCHAR *)hid -> ux_device_class_hid_event_array) /
+                     UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid);
+        tail_index = (ULONG)((UCHAR *)hid -> ux_device_class_hid_event_array_tail - (UCHAR *)hid -> ux_device_class_hid_event_array) /
+                     UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid);
+        depth = (head_index + 1 + queue_size - tail_index) % queue_size;
+        if (depth > statistics -> ux_device_class_hid_event_statistics_depth_high_water)
+            statistics -> ux_device_class_hid_event_statistics_depth_high_water = depth;
+    }
+#endif
+
 #if defined(UX_DEVICE_STANDALONE)
 
     /* Set state machine to start sending if no transfer on going.  */
@@ -33,7 +33,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_device_class_hid_initialize                     PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -94,6 +94,10 @@
 /*                                            endpoint buffer in classes, */
 /*                                            checked compile options,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added events coalescing and */
+/*                                            events queue statistics,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_device_class_hid_initialize(UX_SLAVE_CLASS_COMMAND *command)
@@ -104,6 +108,9 @@ UX_SLAVE_CLASS_HID_PARAMETER            *hid_parameter;
 UX_SLAVE_CLASS                          *class_ptr;
 UINT                                    status = UX_SUCCESS;
 ULONG                                   array_memory_size;
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+ULONG                                   times_offset;
+#endif
 #if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_HID_ZERO_COPY)
 UINT                                    i;
 UCHAR                                   *buffer;
@@ -218,8 +225,16 @@ UCHAR                                   *buffer;
                     UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid),
                     UX_DEVICE_CLASS_HID_PARAM_EVENT_QUEUE_SIZE(hid_parameter)));
         array_memory_size = UX_DEVICE_CLASS_HID_EVENT_QUEUE_ITEM_SIZE(hid) * UX_DEVICE_CLASS_HID_PARAM_EVENT_QUEUE_SIZE(hid_parameter);
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+
+        /* Events time stamps follow the events, one per queue item.  */
+        times_offset = (array_memory_size + 3u) & ~3u;
+        hid -> ux_device_class_hid_event_array =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+                                        times_offset + UX_DEVICE_CLASS_HID_PARAM_EVENT_QUEUE_SIZE(hid_parameter) * sizeof(ULONG));
+#else
         hid -> ux_device_class_hid_event_array =  _ux_utility_memory_allocate(UX_NO_ALIGN,
                                         UX_REGULAR_MEMORY, array_memory_size);
+#endif
 
         /* Do we need event buffer?
          * 1. Even zero copy, report copy is kept to avoid keep buffers in application.
@@ -269,6 +284,14 @@ UCHAR                                   *buffer;
             hid -> ux_device_class_hid_event_array_head =  hid -> ux_device_class_hid_event_array;
             hid -> ux_device_class_hid_event_array_tail =  hid -> ux_device_class_hid_event_array;
             hid -> ux_device_class_hid_event_array_end  =  (UX_DEVICE_CLASS_HID_EVENT*)((UCHAR*)hid -> ux_device_class_hid_event_array + array_memory_size);
+#if defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+            hid -> ux_device_class_hid_event_times = (ULONG *)((UCHAR*)hid -> ux_device_class_hid_event_array + times_offset);
+#endif
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+
+            /* Store the events coalescing setting.  */
+            hid -> ux_device_class_hid_event_coalesce = hid_parameter -> ux_device_class_hid_parameter_event_coalesce;
+#endif
 
             /* Store the start and stop signals if needed by the application.  */
             hid -> ux_slave_class_hid_instance_activate = hid_parameter -> ux_slave_class_hid_instance_activate;
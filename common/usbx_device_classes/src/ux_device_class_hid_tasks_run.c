@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_device_class_hid_tasks_run                      PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -76,6 +76,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added zero copy support,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added latency probe,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT _ux_device_class_hid_tasks_run(VOID *instance)
@@ -174,6 +177,15 @@ UINT                        status;
 
         trans -> ux_slave_transfer_request_requested_length =
                                 hid_event -> ux_device_class_hid_event_length;
+
+        /* Probe the event as it is submitted, idle repeats are not probed.  */
+        if (status == UX_SUCCESS)
+        {
+            UX_HID_LATENCY_PROBE(UX_HID_LATENCY_STAGE_DEVICE_SUBMIT,
+                                 trans -> ux_slave_transfer_request_data_pointer,
+                                 hid_event -> ux_device_class_hid_event_length);
+        }
+
         UX_SLAVE_TRANSFER_STATE_RESET(trans);
         hid -> ux_device_class_hid_event_state = UX_STATE_WAIT;
 
@@ -63,6 +63,7 @@
 /*    _ux_device_mutex_off                  Release mutex                 */
 /*    _ux_utility_long_put                  Put 32-bit value              */
 /*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -93,6 +94,9 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_rndis_bulkin_thread(ULONG rndis_class)
@@ -316,13 +320,25 @@ UINT                            do_copy;
                         {
 
                             /* No, there is not enough space.  */
+                            status = UX_TRANSFER_BUFFER_OVERFLOW;
 
                             /* Report error to application. */
                             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
                         }
 #endif
                     }        
-               
+                    else
+
+                        /* Packet is not sent.  */
+                        status = UX_CLASS_ETH_LINK_STATE_DOWN_ERROR;
+
+                    /* Log the transmit completion.  */
+                    _ux_network_driver_packet_transmitted(rndis -> ux_slave_class_rndis_network_handle, current_packet,
+                            (status == UX_SUCCESS) ? USB_NETWORK_DEVICE_DROP_NONE :
+                            (status == UX_TRANSFER_BUFFER_OVERFLOW) ? USB_NETWORK_DEVICE_DROP_OVERSIZE :
+                            (status == UX_CLASS_ETH_LINK_STATE_DOWN_ERROR) ? USB_NETWORK_DEVICE_DROP_LINK_DOWN :
+                                                                               USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR);
+
                     /* Free the packet that was just sent.  First do some housekeeping.  */
                     current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_DEVICE_CLASS_RNDIS_ETHERNET_SIZE; 
                     current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_DEVICE_CLASS_RNDIS_ETHERNET_SIZE;
@@ -350,6 +366,9 @@ UINT                            do_copy;
                     /* Free Mutex resource.  */
                     _ux_device_mutex_off(&rndis -> ux_slave_class_rndis_mutex);
                     
+                    /* Log the transmit completion.  */
+                    _ux_network_driver_packet_transmitted(rndis -> ux_slave_class_rndis_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_LINK_DOWN);
+
                     /* Free the packet */
                     current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_DEVICE_CLASS_RNDIS_ETHERNET_SIZE; 
                     current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_DEVICE_CLASS_RNDIS_ETHERNET_SIZE;
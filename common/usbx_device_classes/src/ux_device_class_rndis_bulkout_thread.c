@@ -63,6 +63,8 @@
 /*    _ux_device_thread_suspend             Suspend thread                */
 /*    nx_packet_allocate                    Allocate NetX packet          */
 /*    nx_packet_release                     Release NetX packet           */
+/*    _ux_network_driver_packet_lend        Lend NetX packet              */
+/*    _ux_network_driver_packet_dropped     Log dropped frame             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -93,6 +95,12 @@
 /*                                            added a new mode to manage  */
 /*                                            endpoint buffer in classes, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            packet lend support,        */
+/*                                            resulting in version 6.x    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_device_class_rndis_bulkout_thread(ULONG rndis_class)
@@ -150,9 +158,32 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                 }
             }
 
+#if defined(UX_DEVICE_CLASS_RNDIS_PACKET_LEND)
+
+            /* We can accept new reception. Get a NX Packet lent as transfer buffer.  */
+            status =  _ux_network_driver_packet_lend(rndis -> ux_slave_class_rndis_packet_pool,
+                                                     UX_DEVICE_CLASS_RNDIS_PACKET_BUFFER,
+                                                     UX_DEVICE_CLASS_RNDIS_BULKOUT_BUFFER_SIZE, &packet,
+                                                     UX_MS_TO_TICK(UX_DEVICE_CLASS_RNDIS_PACKET_POOL_WAIT));
+            if (status == UX_SUCCESS)
+
+                /* Receive directly in packet payload.  */
+                transfer_request -> ux_slave_transfer_request_data_pointer = packet -> nx_packet_prepend_ptr;
+
+            else if (status == UX_BUFFER_OVERFLOW)
+            {
+
+                /* Packet payload can not hold a message, receive in endpoint buffer and copy.  */
+                transfer_request -> ux_slave_transfer_request_data_pointer = UX_DEVICE_CLASS_RNDIS_BULKOUT_BUFFER(rndis);
+                status =  nx_packet_allocate(rndis -> ux_slave_class_rndis_packet_pool, &packet,
+                                             NX_RECEIVE_PACKET, UX_MS_TO_TICK(UX_DEVICE_CLASS_RNDIS_PACKET_POOL_WAIT));
+            }
+#else
+
             /* We can accept new reception. Get a NX Packet.  */
             status =  nx_packet_allocate(rndis -> ux_slave_class_rndis_packet_pool, &packet, 
                                          NX_RECEIVE_PACKET, UX_MS_TO_TICK(UX_DEVICE_CLASS_RNDIS_PACKET_POOL_WAIT));
+#endif
 
             if (status == NX_SUCCESS)
             {
@@ -227,6 +258,22 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                         if (packet_payload <= transfer_request -> ux_slave_transfer_request_actual_length - UX_DEVICE_CLASS_RNDIS_PACKET_HEADER_LENGTH)
                         {
 
+#if defined(UX_DEVICE_CLASS_RNDIS_PACKET_LEND)
+
+                            /* Check if data is received directly in packet.  */
+                            if (transfer_request -> ux_slave_transfer_request_data_pointer == packet -> nx_packet_prepend_ptr)
+                            {
+
+                                /* Data already in packet, skip RNDIS header and save length.  */
+                                packet -> nx_packet_prepend_ptr += UX_DEVICE_CLASS_RNDIS_PACKET_BUFFER;
+                                packet -> nx_packet_length = packet_payload;
+                                packet -> nx_packet_append_ptr = packet -> nx_packet_prepend_ptr + packet_payload;
+
+                                /* Send that packet to the NetX USB broker.  */
+                                _ux_network_driver_packet_received(rndis -> ux_slave_class_rndis_network_handle, packet);
+                                continue;
+                            }
+#endif
 #if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1) && defined(UX_DEVICE_CLASS_RNDIS_ZERO_COPY)
 
                             /* Data already in buffer, adjust packet start and save length.  */
@@ -261,6 +308,9 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                                 /* Error.  */
                                 _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_ETH_PACKET_ERROR);
                                 nx_packet_release(packet);
+
+                                /* Log the dropped frame, no packet to chain the data.  */
+                                _ux_network_driver_packet_dropped(rndis -> ux_slave_class_rndis_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
                             }
 #endif
                         }
@@ -270,6 +320,9 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                             /* We received a malformed packet. Report to application.  */
                             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_MALFORMED_PACKET_RECEIVED_ERROR);
                             nx_packet_release(packet);
+
+                            /* Log the dropped frame.  */
+                            _ux_network_driver_packet_dropped(rndis -> ux_slave_class_rndis_network_handle, USB_NETWORK_DEVICE_DROP_MALFORMED);
                         }
                     }
                     else
@@ -278,6 +331,9 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
                         /* We received a malformed packet. Report to application.  */
                         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_MALFORMED_PACKET_RECEIVED_ERROR);
                         nx_packet_release(packet);
+
+                        /* Log the dropped frame.  */
+                        _ux_network_driver_packet_dropped(rndis -> ux_slave_class_rndis_network_handle, USB_NETWORK_DEVICE_DROP_MALFORMED);
                     }
                 }
                 else
@@ -296,6 +352,9 @@ USB_NETWORK_DEVICE_TYPE         *ux_nx_device;
 
                 /* Error trap. No need for trace, since NetX does it.  */
                 _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
+
+                /* Log the reception refused, no packet to receive the frame.  */
+                _ux_network_driver_packet_dropped(rndis -> ux_slave_class_rndis_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
             }
         }
              
@@ -60,6 +60,9 @@
 /*                                            added some new definitions, */
 /*                                            refined reception handling, */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            multiple receive buffers,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -134,6 +137,21 @@ extern   "C" {
 #define UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE              512 /* N*512.  */
 #endif
 
+/* Define number of receive buffers, each one is a bulk IN transfer kept
+   outstanding on the device. With more than one buffer, the device sends
+   frames in the next buffer while the class thread splits the previous one
+   into NetX packets.
+   For high throughput, use large buffers (e.g. 16384) and several of them
+   (e.g. 4). The device then aggregates many frames, each one with its 4-byte
+   ASIX header, in every bulk IN transfer.  */
+#ifndef UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT
+#define UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT             1
+#endif
+
+#if (UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT > 1) && !defined(UX_HOST_STANDALONE)
+#define UX_HOST_CLASS_ASIX_RECEIVE_RING
+#endif
+
 #ifdef NX_DISABLE_PACKET_CHAIN
 #undef UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT
 #else
@@ -311,6 +329,19 @@ extern   "C" {
 #define UX_HOST_CLASS_ASIX_RXCR_MFB_8192                    0x0200
 #define UX_HOST_CLASS_ASIX_RXCR_MFB_16384                   0x0300 /* Default.  */
 
+/* Define maximum frame burst (aggregated frames size) from receive buffer size.  */
+#ifndef UX_HOST_CLASS_ASIX_RXCR_MFB
+#if UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE >= 16384
+#define UX_HOST_CLASS_ASIX_RXCR_MFB                         UX_HOST_CLASS_ASIX_RXCR_MFB_16384
+#elif UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE >= 8192
+#define UX_HOST_CLASS_ASIX_RXCR_MFB                         UX_HOST_CLASS_ASIX_RXCR_MFB_8192
+#elif UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE >= 4096
+#define UX_HOST_CLASS_ASIX_RXCR_MFB                         UX_HOST_CLASS_ASIX_RXCR_MFB_4096
+#else
+#define UX_HOST_CLASS_ASIX_RXCR_MFB                         UX_HOST_CLASS_ASIX_RXCR_MFB_2048
+#endif
+#endif
+
 /* 88772B.  */
 #define UX_HOST_CLASS_ASIX_RXCR_RH1M                        0x0100 /* Default 1.  */
 #define UX_HOST_CLASS_ASIX_RXCR_RH2M                        0x0200 /* Default 0.  */
@@ -430,6 +461,9 @@ typedef struct UX_HOST_CLASS_ASIX_STRUCT
 #endif
     NX_PACKET       *ux_host_class_asix_receive_queue;
     UCHAR           *ux_host_class_asix_receive_buffer;
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+    UX_TRANSFER     ux_host_class_asix_receive_transfer_requests[UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT];
+#endif
     NX_PACKET_POOL  *ux_host_class_asix_packet_pool;
     ULONG           ux_host_class_asix_packet_available_min;
 
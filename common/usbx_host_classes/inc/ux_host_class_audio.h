@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */
 /*                                                                        */
 /*    ux_host_class_audio.h                               PORTABLE C      */
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,10 @@
 /*                                            improved AC AS management,  */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added ring streaming mode,  */
+/*                                            added streaming statistics, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -86,6 +90,14 @@ extern   "C" {
 /* Defined, it enables optional interrupt endpoint support.  */
 /* #define UX_HOST_CLASS_AUDIO_INTERRUPT_SUPPORT  */
 
+/* Defined, it enables ring streaming mode: class owned isochronous transfers are
+   re-armed from completion and application reads/writes data through a ring.  */
+/* #define UX_HOST_CLASS_AUDIO_RING_SUPPORT  */
+
+/* Defined, it enables statistics of isochronous transfer requests completion (intervals,
+   pending requests histogram, feedback and xruns), read by ux_host_class_audio_statistics_get.  */
+/* #define UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT  */
+
 /* Defined, it disables control_get/value_get/value_set and related code (to optimize code size).  */
 /* #define UX_HOST_CLASS_AUDIO_DISABLE_CONTROLS  */
 
@@ -105,6 +117,34 @@ extern   "C" {
 
 #define UX_HOST_CLASS_AUDIO_CLASS_TRANSFER_TIMEOUT          30
 
+/* Define Audio Class ring streaming constants.  */
+
+#ifndef UX_HOST_CLASS_AUDIO_RING_TRANSFERS
+#define UX_HOST_CLASS_AUDIO_RING_TRANSFERS                  3
+#endif
+
+#define UX_HOST_CLASS_AUDIO_RING_STOPPED                    0
+#define UX_HOST_CLASS_AUDIO_RING_RUNNING                    1
+
+/* Define Audio Class statistics constants.
+     TIME_GET: time stamp of completions, could be redefined for a finer timer.
+     LEVELS:   number of pending requests histogram entries, last one counts all higher levels.
+     RECORDS:  number of last completions recorded (power of 2), 0 to disable records.
+ */
+
+#ifndef UX_HOST_CLASS_AUDIO_STATISTICS_TIME_GET
+#define UX_HOST_CLASS_AUDIO_STATISTICS_TIME_GET()           _ux_utility_time_get()
+#endif
+#ifndef UX_HOST_CLASS_AUDIO_STATISTICS_LEVELS
+#define UX_HOST_CLASS_AUDIO_STATISTICS_LEVELS               8
+#endif
+#ifndef UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS
+#define UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS              8
+#endif
+#if (UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS & (UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS - 1)) != 0
+#error UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS must be a power of 2
+#endif
+
 #define UX_HOST_CLASS_AUDIO_CLASS                           1
 #define UX_HOST_CLASS_AUDIO_SUBCLASS_UNDEFINED              0
 #define UX_HOST_CLASS_AUDIO_SUBCLASS_CONTROL                1
@@ -404,6 +444,81 @@ typedef struct UX_HOST_CLASS_AUDIO_STREAMING_ENDPOINT_DESCRIPTOR_STRUCT
 } UX_HOST_CLASS_AUDIO_STREAMING_ENDPOINT_DESCRIPTOR;
 
 
+/* Define Audio Class ring slot structure, packet data follows the header.  */
+
+typedef struct UX_HOST_CLASS_AUDIO_RING_SLOT_STRUCT
+{
+
+    ULONG           ux_host_class_audio_ring_slot_length;
+    ULONG           ux_host_class_audio_ring_slot_pos;
+    ULONG           ux_host_class_audio_ring_slot_frame_number; /* Time stamp of IN packet.  */
+    UCHAR           ux_host_class_audio_ring_slot_data[4];
+} UX_HOST_CLASS_AUDIO_RING_SLOT;
+
+
+/* Define Audio Class ring streaming structure.  */
+
+typedef struct UX_HOST_CLASS_AUDIO_RING_STRUCT
+{
+
+    UX_TRANSFER     ux_host_class_audio_ring_transfers[UX_HOST_CLASS_AUDIO_RING_TRANSFERS];
+    UCHAR           *ux_host_class_audio_ring_transfer_buffer;
+    UCHAR           *ux_host_class_audio_ring_buffer;
+    ULONG           ux_host_class_audio_ring_slot_size;
+    ULONG           ux_host_class_audio_ring_slots_nb;          /* Power of 2, indexes are masked.  */
+    ULONG           ux_host_class_audio_ring_head;              /* Free running, updated by producer only.  */
+    ULONG           ux_host_class_audio_ring_tail;              /* Free running, updated by consumer only.  */
+    ULONG           ux_host_class_audio_ring_frame_bytes;
+    ULONG           ux_host_class_audio_ring_nominal_rate;      /* Frames per packet, 16.16.  */
+    ULONG           ux_host_class_audio_ring_rate;              /* Frames per packet in use, 16.16.  */
+    ULONG           ux_host_class_audio_ring_rate_accumulator;
+    ULONG           ux_host_class_audio_ring_packets;
+    ULONG           ux_host_class_audio_ring_xruns;
+    UINT            ux_host_class_audio_ring_state;
+} UX_HOST_CLASS_AUDIO_RING;
+
+
+/* Define Audio Class statistics structure.
+   Times are in UX_HOST_CLASS_AUDIO_STATISTICS_TIME_GET unit, jitter is interval max - min.
+   Levels are in requests still pending after a request is completed.
+   Xruns are requests completed with error, or completions leaving no request pending.
+   Records keep the last completions, completion N in records[N & (RECORDS - 1)].  */
+
+typedef struct UX_HOST_CLASS_AUDIO_STATISTICS_RECORD_STRUCT
+{
+
+    ULONG           ux_host_class_audio_statistics_record_time;
+    ULONG           ux_host_class_audio_statistics_record_frame_number;
+    ULONG           ux_host_class_audio_statistics_record_length;
+    ULONG           ux_host_class_audio_statistics_record_level;
+} UX_HOST_CLASS_AUDIO_STATISTICS_RECORD;
+
+typedef struct UX_HOST_CLASS_AUDIO_STATISTICS_STRUCT
+{
+
+    ULONG           ux_host_class_audio_statistics_transfers;
+    ULONG           ux_host_class_audio_statistics_bytes;
+    ULONG           ux_host_class_audio_statistics_frame_number;    /* Last completion.  */
+    ULONG           ux_host_class_audio_statistics_time;            /* Last completion.  */
+    ULONG           ux_host_class_audio_statistics_interval_min;
+    ULONG           ux_host_class_audio_statistics_interval_max;
+    ULONG           ux_host_class_audio_statistics_interval_sum;    /* Of transfers - 1 intervals.  */
+    ULONG           ux_host_class_audio_statistics_level;
+    ULONG           ux_host_class_audio_statistics_level_min;
+    ULONG           ux_host_class_audio_statistics_level_max;
+    ULONG           ux_host_class_audio_statistics_level_histogram[UX_HOST_CLASS_AUDIO_STATISTICS_LEVELS];
+    ULONG           ux_host_class_audio_statistics_feedback;        /* As encoded on bus.  */
+    ULONG           ux_host_class_audio_statistics_feedback_min;
+    ULONG           ux_host_class_audio_statistics_feedback_max;
+    ULONG           ux_host_class_audio_statistics_xruns;
+    ULONG           ux_host_class_audio_statistics_xrun_time;       /* Last xrun.  */
+#if UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS > 0
+    UX_HOST_CLASS_AUDIO_STATISTICS_RECORD
+                    ux_host_class_audio_statistics_records[UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS];
+#endif
+} UX_HOST_CLASS_AUDIO_STATISTICS;
+
+
 /* Define Audio Class audio control (AC) instance structure.  */
 typedef struct UX_HOST_CLASS_AUDIO_AC_STRUCT
 {
@@ -475,6 +590,15 @@ typedef struct UX_HOST_CLASS_AUDIO_STRUCT
     ULONG           ux_host_class_audio_feature_unit_id;
     UINT            ux_host_class_audio_channels;
     ULONG           ux_host_class_audio_channel_control[UX_HOST_CLASS_AUDIO_MAX_CHANNEL];
+#endif
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+    UX_HOST_CLASS_AUDIO_RING
+                    ux_host_class_audio_ring;
+#endif
+#if defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+    UX_HOST_CLASS_AUDIO_STATISTICS
+                    ux_host_class_audio_statistics;
+    ULONG           ux_host_class_audio_pending_transfers;
 #endif
     UX_MUTEX        ux_host_class_audio_mutex;
 } UX_HOST_CLASS_AUDIO;
@@ -497,6 +621,13 @@ typedef struct UX_HOST_CLASS_AUDIO_STRUCT
 #define _ux_host_class_audio_packet_fraction_get(a)     ((a)->ux_host_class_audio_packet_fraction)
 #define _ux_host_class_audio_max_packet_size_get(a)     ((a)->ux_host_class_audio_isochronous_endpoint->ux_endpoint_transfer_request.ux_transfer_request_packet_length)
 
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+#define _ux_host_class_audio_ring_level_get(a)          ((a)->ux_host_class_audio_ring.ux_host_class_audio_ring_head - (a)->ux_host_class_audio_ring.ux_host_class_audio_ring_tail)
+#define _ux_host_class_audio_ring_packets_get(a)        ((a)->ux_host_class_audio_ring.ux_host_class_audio_ring_packets)
+#define _ux_host_class_audio_ring_xruns_get(a)          ((a)->ux_host_class_audio_ring.ux_host_class_audio_ring_xruns)
+#define _ux_host_class_audio_ring_rate_get(a)           ((a)->ux_host_class_audio_ring.ux_host_class_audio_ring_rate)
+#endif
+
 
 /* Define Audio Class isochronous USB transfer request structure.  */
 
@@ -634,6 +765,19 @@ UINT    _ux_host_class_audio_interrupt_start(UX_HOST_CLASS_AUDIO_AC *audio,
                         VOID *arg);
 VOID    _ux_host_class_audio_interrupt_notification(UX_TRANSFER *transfer_request);
 
+UINT    _ux_host_class_audio_ring_start(UX_HOST_CLASS_AUDIO *audio, ULONG frame_bytes, ULONG slots_nb);
+UINT    _ux_host_class_audio_ring_stop(UX_HOST_CLASS_AUDIO *audio);
+UINT    _ux_host_class_audio_ring_read(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                        ULONG *actual_length, ULONG *frame_number);
+UINT    _ux_host_class_audio_ring_write(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                        ULONG *actual_length);
+VOID    _ux_host_class_audio_ring_release(UX_HOST_CLASS_AUDIO *audio);
+VOID    _ux_host_class_audio_ring_packet_fill(UX_HOST_CLASS_AUDIO *audio, UX_TRANSFER *transfer_request);
+VOID    _ux_host_class_audio_ring_transfer_completed(UX_TRANSFER *transfer_request);
+
+UINT    _ux_host_class_audio_statistics_get(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_STATISTICS *statistics);
+UINT    _ux_host_class_audio_statistics_reset(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_STATISTICS *statistics);
+
 UINT    _uxe_host_class_audio_control_get(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_CONTROL *audio_control);
 UINT    _uxe_host_class_audio_control_value_get(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_CONTROL *audio_control);
 UINT    _uxe_host_class_audio_control_value_set(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_CONTROL *audio_control);
@@ -669,6 +813,15 @@ UINT    _uxe_host_class_audio_interrupt_start(UX_HOST_CLASS_AUDIO_AC *audio,
                                                  UCHAR *message, ULONG length,
                                                  VOID *arg),
                         VOID *arg);
+UINT    _uxe_host_class_audio_ring_start(UX_HOST_CLASS_AUDIO *audio, ULONG frame_bytes, ULONG slots_nb);
+UINT    _uxe_host_class_audio_ring_stop(UX_HOST_CLASS_AUDIO *audio);
+UINT    _uxe_host_class_audio_ring_read(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                        ULONG *actual_length, ULONG *frame_number);
+UINT    _uxe_host_class_audio_ring_write(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                        ULONG *actual_length);
+
+UINT    _uxe_host_class_audio_statistics_get(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_STATISTICS *statistics);
+UINT    _uxe_host_class_audio_statistics_reset(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_STATISTICS *statistics);
 
 
 /* Define Audio Class API prototypes.  */
@@ -718,6 +871,18 @@ UINT    _uxe_host_class_audio_interrupt_start(UX_HOST_CLASS_AUDIO_AC *audio,
 
 #define ux_host_class_audio_interrupt_start             _uxe_host_class_audio_interrupt_start
 
+#define ux_host_class_audio_ring_start                  _uxe_host_class_audio_ring_start
+#define ux_host_class_audio_ring_stop                   _uxe_host_class_audio_ring_stop
+#define ux_host_class_audio_ring_read                   _uxe_host_class_audio_ring_read
+#define ux_host_class_audio_ring_write                  _uxe_host_class_audio_ring_write
+#define ux_host_class_audio_ring_level_get              _ux_host_class_audio_ring_level_get
+#define ux_host_class_audio_ring_packets_get            _ux_host_class_audio_ring_packets_get
+#define ux_host_class_audio_ring_xruns_get              _ux_host_class_audio_ring_xruns_get
+#define ux_host_class_audio_ring_rate_get               _ux_host_class_audio_ring_rate_get
+
+#define ux_host_class_audio_statistics_get              _uxe_host_class_audio_statistics_get
+#define ux_host_class_audio_statistics_reset            _uxe_host_class_audio_statistics_reset
+
 
 #else
 
@@ -764,6 +929,18 @@ UINT    _uxe_host_class_audio_interrupt_start(UX_HOST_CLASS_AUDIO_AC *audio,
 
 #define ux_host_class_audio_interrupt_start             _ux_host_class_audio_interrupt_start
 
+#define ux_host_class_audio_ring_start                  _ux_host_class_audio_ring_start
+#define ux_host_class_audio_ring_stop                   _ux_host_class_audio_ring_stop
+#define ux_host_class_audio_ring_read                   _ux_host_class_audio_ring_read
+#define ux_host_class_audio_ring_write                  _ux_host_class_audio_ring_write
+#define ux_host_class_audio_ring_level_get              _ux_host_class_audio_ring_level_get
+#define ux_host_class_audio_ring_packets_get            _ux_host_class_audio_ring_packets_get
+#define ux_host_class_audio_ring_xruns_get              _ux_host_class_audio_ring_xruns_get
+#define ux_host_class_audio_ring_rate_get               _ux_host_class_audio_ring_rate_get
+
+#define ux_host_class_audio_statistics_get              _ux_host_class_audio_statistics_get
+#define ux_host_class_audio_statistics_reset            _ux_host_class_audio_statistics_reset
+
 #endif
 
 
@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_cdc_acm.h                             PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,6 +55,9 @@
 /*                                            used defined line coding    */
 /*                                            instead of magic number,    */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            reception streaming mode,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -79,6 +82,9 @@ extern   "C" {
 #endif
 
 
+#include "ux_host_class_serial.h"
+
+
 /* Define CDC ACM Class constants.  */
 
 #define UX_HOST_CLASS_CDC_ACM_DEVICE_INIT_DELAY                 1000
@@ -241,6 +247,10 @@ typedef struct UX_HOST_CLASS_CDC_ACM_STRUCT
     
     VOID           (*ux_host_class_cdc_acm_device_status_change_callback)(struct UX_HOST_CLASS_CDC_ACM_STRUCT *cdc_acm, 
                                                                 ULONG  notification_type, ULONG notification_value);
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+    UX_HOST_CLASS_SERIAL_STATISTICS
+                   ux_host_class_cdc_acm_statistics;
+#endif
 #if !defined(UX_HOST_STANDALONE)
     UX_SEMAPHORE   ux_host_class_cdc_acm_semaphore;
 #else
@@ -314,6 +324,14 @@ typedef struct UX_HOST_CLASS_CDC_ACM_RECEPTION_STRUCT
                                                                 UINT  status,
                                                                 UCHAR *reception_buffer, 
                                                                 ULONG reception_size);
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    ULONG          ux_host_class_cdc_acm_reception_transfer_count;
+    UX_EVENT_FLAGS_GROUP
+                   *ux_host_class_cdc_acm_reception_event_flags_group;
+    ULONG          ux_host_class_cdc_acm_reception_event_flags;
+    UX_HOST_CLASS_SERIAL_STREAM
+                   ux_host_class_cdc_acm_reception_stream;
+#endif
 
 } UX_HOST_CLASS_CDC_ACM_RECEPTION;
 
@@ -371,6 +389,8 @@ UINT  _ux_host_class_cdc_acm_reception_start (UX_HOST_CLASS_CDC_ACM *cdc_acm,
                                     UX_HOST_CLASS_CDC_ACM_RECEPTION *cdc_acm_reception);
                                     
 VOID  _ux_host_class_cdc_acm_reception_callback (UX_TRANSFER *transfer_request);
+UINT  _ux_host_class_cdc_acm_reception_span_get(UX_HOST_CLASS_CDC_ACM *cdc_acm, UCHAR **span_buffer, ULONG *span_length);
+UINT  _ux_host_class_cdc_acm_reception_span_release(UX_HOST_CLASS_CDC_ACM *cdc_acm, ULONG length);
 
 UINT  _ux_host_class_cdc_acm_write_with_callback(UX_HOST_CLASS_CDC_ACM *cdc_acm, UCHAR *data_pointer, 
                                   ULONG requested_length);
@@ -391,6 +411,8 @@ UINT  _uxe_host_class_cdc_acm_reception_start (UX_HOST_CLASS_CDC_ACM *cdc_acm,
                                     UX_HOST_CLASS_CDC_ACM_RECEPTION *cdc_acm_reception);
 UINT  _uxe_host_class_cdc_acm_write_with_callback(UX_HOST_CLASS_CDC_ACM *cdc_acm, UCHAR *data_pointer, 
                                   ULONG requested_length);
+UINT  _uxe_host_class_cdc_acm_reception_span_get(UX_HOST_CLASS_CDC_ACM *cdc_acm, UCHAR **span_buffer, ULONG *span_length);
+UINT  _uxe_host_class_cdc_acm_reception_span_release(UX_HOST_CLASS_CDC_ACM *cdc_acm, ULONG length);
 
 
 /* Define CDC ACM Class API prototypes.  */
@@ -404,6 +426,8 @@ UINT  _uxe_host_class_cdc_acm_write_with_callback(UX_HOST_CLASS_CDC_ACM *cdc_acm
 #define ux_host_class_cdc_acm_ioctl                     _uxe_host_class_cdc_acm_ioctl
 #define ux_host_class_cdc_acm_reception_start           _uxe_host_class_cdc_acm_reception_start
 #define ux_host_class_cdc_acm_reception_stop            _uxe_host_class_cdc_acm_reception_stop
+#define ux_host_class_cdc_acm_reception_span_get        _uxe_host_class_cdc_acm_reception_span_get
+#define ux_host_class_cdc_acm_reception_span_release    _uxe_host_class_cdc_acm_reception_span_release
 
 #define ux_host_class_cdc_acm_write_with_callback       _uxe_host_class_cdc_acm_write_with_callback
 
@@ -414,6 +438,8 @@ UINT  _uxe_host_class_cdc_acm_write_with_callback(UX_HOST_CLASS_CDC_ACM *cdc_acm
 #define ux_host_class_cdc_acm_ioctl                     _ux_host_class_cdc_acm_ioctl
 #define ux_host_class_cdc_acm_reception_start           _ux_host_class_cdc_acm_reception_start
 #define ux_host_class_cdc_acm_reception_stop            _ux_host_class_cdc_acm_reception_stop
+#define ux_host_class_cdc_acm_reception_span_get        _ux_host_class_cdc_acm_reception_span_get
+#define ux_host_class_cdc_acm_reception_span_release    _ux_host_class_cdc_acm_reception_span_release
 
 #define ux_host_class_cdc_acm_write_with_callback       _ux_host_class_cdc_acm_write_with_callback
 
@@ -63,6 +63,12 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            bulk IN transfer ring,      */
+/*                                            added bulk OUT transfer     */
+/*                                            ring and transmit queue     */
+/*                                            depth limit, resulting in   */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 
@@ -257,6 +263,49 @@ extern   "C" {
 #define UX_HOST_CLASS_CDC_ECM_PACKET_POOL_INSTANCE_WAIT         100
 #endif
 
+/* Define number of bulk IN transfer requests kept armed at the same time.
+   With 1 (default) the CDC ECM thread arms one reception at a time.
+   With more than 1 a ring of transfer requests, each backed by a NetX packet
+   payload, is armed on the bulk IN endpoint and re-armed from the completion
+   callback, so frames are received without copy and without gaps.
+   The ring needs packets large enough to hold a complete Ethernet frame,
+   otherwise the single transfer reception is used. It also needs a HCD that
+   accepts several pending transfer requests on one endpoint.  */
+
+#ifndef UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT
+#define UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT    1
+#endif
+
+#if (UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT > 1) && !defined(UX_HOST_STANDALONE)
+#define UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+#endif
+
+/* Define number of bulk OUT transfer requests in flight at the same time.
+   With 1 (default) a queued packet is sent when the previous one completes.
+   With more than 1 queued packets are armed on a ring of transfer requests
+   as soon as a slot is free, in queue order. A frame that needs a ZLP is
+   sent alone so that its ZLP directly follows it.
+   With packet chain support, a copy buffer is allocated for each slot.
+   The ring needs a HCD that accepts several pending transfer requests on
+   one endpoint.  */
+
+#ifndef UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT
+#define UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT   1
+#endif
+
+#if (UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT > 1) && !defined(UX_HOST_STANDALONE)
+#define UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+#endif
+
+/* Define maximum number of packets in the transmit queue, including the ones
+   being sent. When the queue is full, write releases the packet and returns
+   UX_CLASS_ETH_QUEUE_FULL_ERROR, which the network driver reports to NetX
+   as NX_TX_QUEUE_DEPTH. 0 (default) means no limit.  */
+
+#ifndef UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH
+#define UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH                  0
+#endif
+
 /* Define  CDC_ECM Class instance structure.  */
 
 typedef struct UX_HOST_CLASS_CDC_ECM_STRUCT
@@ -293,11 +342,22 @@ typedef struct UX_HOST_CLASS_CDC_ECM_STRUCT
     ULONG           ux_host_class_cdc_ecm_link_state;
     NX_PACKET       *ux_host_class_cdc_ecm_xmit_queue_head;
     NX_PACKET       *ux_host_class_cdc_ecm_xmit_queue_tail;
+    ULONG           ux_host_class_cdc_ecm_xmit_queue_depth;
     NX_PACKET_POOL  *ux_host_class_cdc_ecm_packet_pool;
 #ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
     UCHAR           *ux_host_class_cdc_ecm_xmit_buffer;
     UCHAR           *ux_host_class_cdc_ecm_receive_buffer;
 #endif
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+    UX_TRANSFER     ux_host_class_cdc_ecm_bulk_in_transfer_requests[UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT];
+#endif
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+    NX_PACKET       *ux_host_class_cdc_ecm_xmit_queue_pending;
+    ULONG           ux_host_class_cdc_ecm_bulk_out_transfer_busy;
+    UCHAR           ux_host_class_cdc_ecm_bulk_out_transfer_arming;
+    UCHAR           ux_host_class_cdc_ecm_bulk_out_transfer_zlp;
+    UX_TRANSFER     ux_host_class_cdc_ecm_bulk_out_transfer_requests[UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT];
+#endif
 
     UCHAR           ux_host_class_cdc_ecm_node_id[UX_HOST_CLASS_CDC_ECM_NODE_ID_LENGTH];
     VOID            (*ux_host_class_cdc_ecm_device_status_change_callback)(struct UX_HOST_CLASS_CDC_ECM_STRUCT *cdc_ecm, 
@@ -337,6 +397,14 @@ VOID  _ux_host_class_cdc_ecm_thread(ULONG parameter);
 VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request);
 VOID  _ux_host_class_cdc_ecm_transmit_queue_clean(UX_HOST_CLASS_CDC_ECM *cdc_ecm_control);
 UINT  _ux_host_class_cdc_ecm_mac_address_get(UX_HOST_CLASS_CDC_ECM *cdc_ecm);
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+UINT  _ux_host_class_cdc_ecm_reception_ring_arm(UX_HOST_CLASS_CDC_ECM *cdc_ecm);
+VOID  _ux_host_class_cdc_ecm_reception_ring_abort(UX_HOST_CLASS_CDC_ECM *cdc_ecm);
+VOID  _ux_host_class_cdc_ecm_reception_callback(UX_TRANSFER *transfer_request);
+#endif
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+VOID  _ux_host_class_cdc_ecm_transmission_ring_arm(UX_HOST_CLASS_CDC_ECM *cdc_ecm);
+#endif
                                     
 /* Define CDC ECM Class API prototypes.  */
 
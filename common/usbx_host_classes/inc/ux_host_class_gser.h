@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_gser.h                                PORTABLE C      */ 
-/*                                                           6.1.8        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -50,6 +50,10 @@
 /*                                            added extern "C" keyword    */
 /*                                            for compatibility with C++, */
 /*                                            resulting in version 6.1.8  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode and      */
+/*                                            statistics,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -74,6 +78,9 @@ extern   "C" {
 #endif
 
 
+#include "ux_host_class_serial.h"
+
+
 /* Define Sierra Wireless AR Class constants.  */
 
 #define UX_HOST_CLASS_GSER_CLASS_TRANSFER_TIMEOUT               300000
@@ -184,6 +191,9 @@ typedef struct UX_HOST_CLASS_GSER_INTERFACE_STRUCT
     UX_SEMAPHORE                                ux_host_class_gser_semaphore;
     struct UX_HOST_CLASS_GSER_RECEPTION_STRUCT  *ux_host_class_gser_reception;
     ULONG                                       ux_host_class_gser_notification_count;
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+    UX_HOST_CLASS_SERIAL_STATISTICS             ux_host_class_gser_statistics;
+#endif
 } UX_HOST_CLASS_GSER_INTERFACE;
 
 /* Define Generic Serial Class instance structure.  */
@@ -218,6 +228,14 @@ typedef struct UX_HOST_CLASS_GSER_RECEPTION_STRUCT
                                                                 UINT  status,
                                                                 UCHAR *reception_buffer, 
                                                                 ULONG reception_size);
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    ULONG           ux_host_class_gser_reception_transfer_count;
+    UX_EVENT_FLAGS_GROUP
+                    *ux_host_class_gser_reception_event_flags_group;
+    ULONG           ux_host_class_gser_reception_event_flags;
+    UX_HOST_CLASS_SERIAL_STREAM
+                    ux_host_class_gser_reception_stream;
+#endif
 
 } UX_HOST_CLASS_GSER_RECEPTION;
 
@@ -274,6 +292,10 @@ UINT    _ux_host_class_gser_reception_stop (UX_HOST_CLASS_GSER *gser,
                                     UX_HOST_CLASS_GSER_RECEPTION *gser_reception);
 UINT    _ux_host_class_gser_reception_start (UX_HOST_CLASS_GSER *gser, 
                                     UX_HOST_CLASS_GSER_RECEPTION *gser_reception);
+UINT    _ux_host_class_gser_reception_span_get(UX_HOST_CLASS_GSER *gser, ULONG interface_index,
+                                    UCHAR **span_buffer, ULONG *span_length);
+UINT    _ux_host_class_gser_reception_span_release(UX_HOST_CLASS_GSER *gser, ULONG interface_index,
+                                    ULONG length);
 
 
 UINT    _uxe_host_class_gser_read (UX_HOST_CLASS_GSER *gser, ULONG interface_index,UCHAR *data_pointer, 
@@ -288,6 +310,10 @@ UINT    _uxe_host_class_gser_reception_stop (UX_HOST_CLASS_GSER *gser,
                                     UX_HOST_CLASS_GSER_RECEPTION *gser_reception);
 UINT    _uxe_host_class_gser_reception_start (UX_HOST_CLASS_GSER *gser, 
                                     UX_HOST_CLASS_GSER_RECEPTION *gser_reception);
+UINT    _uxe_host_class_gser_reception_span_get(UX_HOST_CLASS_GSER *gser, ULONG interface_index,
+                                    UCHAR **span_buffer, ULONG *span_length);
+UINT    _uxe_host_class_gser_reception_span_release(UX_HOST_CLASS_GSER *gser, ULONG interface_index,
+                                    ULONG length);
 
 
 /* Define GSER Class API prototypes.  */
@@ -301,6 +327,8 @@ UINT    _uxe_host_class_gser_reception_start (UX_HOST_CLASS_GSER *gser,
 #define ux_host_class_gser_ioctl                     _uxe_host_class_gser_ioctl
 #define ux_host_class_gser_reception_start           _uxe_host_class_gser_reception_start
 #define ux_host_class_gser_reception_stop            _uxe_host_class_gser_reception_stop
+#define ux_host_class_gser_reception_span_get        _uxe_host_class_gser_reception_span_get
+#define ux_host_class_gser_reception_span_release    _uxe_host_class_gser_reception_span_release
 
 #else
 
@@ -309,6 +337,8 @@ UINT    _uxe_host_class_gser_reception_start (UX_HOST_CLASS_GSER *gser,
 #define ux_host_class_gser_ioctl                     _ux_host_class_gser_ioctl
 #define ux_host_class_gser_reception_start           _ux_host_class_gser_reception_start
 #define ux_host_class_gser_reception_stop            _ux_host_class_gser_reception_stop
+#define ux_host_class_gser_reception_span_get        _ux_host_class_gser_reception_span_get
+#define ux_host_class_gser_reception_span_release    _ux_host_class_gser_reception_span_release
 
 #endif
 
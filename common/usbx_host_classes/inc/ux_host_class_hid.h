@@ -58,6 +58,12 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            optimized USB descriptors,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added report decode plans,  */
+/*                                            added input report ring,    */
+/*                                            added parse cache,          */
+/*                                            added parser arena,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -81,6 +87,71 @@ extern   "C" {
 #define UX_DEVICE_CLASS_HID_ENABLE_ERROR_CHECKING
 #endif
 
+/* Option: compile a flat decode plan for each report when the report descriptor
+   is parsed. A plan entry gives the bit offset, size, signedness and usage of one
+   report value. A client binds the entries to the members of its own structure
+   with ux_host_class_hid_report_layout_set, then reports are decoded straight
+   into that structure with no field list walking nor usage searching: by
+   ux_host_class_hid_report_plan_decode, or for the periodic input reports by
+   registering the report callback with UX_HOST_CLASS_HID_REPORT_STRUCTURE.
+   Each plan is kept twice, a new layout is bound in the copy that is not used
+   and swapped in, so it can be set while reports are decoded. Before binding,
+   ux_host_class_hid_report_layout_set waits, out of the instance lock, for the
+   decodes in progress on the report, at most
+   UX_HOST_CLASS_HID_PLAN_WAIT_TIMEOUT milliseconds each time.  */
+/* #define UX_HOST_CLASS_HID_DECODE_PLAN */
+
+/* Option: queue the periodic input reports in a ring of report buffers. The
+   interrupt transfer receives each report in the free buffer at the head of
+   the ring and is re-armed at once on the next one, nothing is copied nor
+   allocated. Decoding and client callbacks are done by a worker thread of the
+   HID instance, so a slow callback no longer delays the next poll. When the
+   ring is full the report is dropped, the instance keeps the counts of
+   received and dropped reports, the ring high water and the longest wait in
+   ticks before a report is dispatched. Each callback gives the tick time when
+   its report was received.
+   The ring indexes have a single writer each, the completion path for the
+   head and the worker thread for the tail, no lock is taken.  */
+/* #define UX_HOST_CLASS_HID_REPORT_RING */
+
+#if defined(UX_HOST_CLASS_HID_REPORT_RING) && defined(UX_HOST_STANDALONE)
+#error UX_HOST_CLASS_HID_REPORT_RING is not supported in standalone mode
+#endif
+
+/* Define the number of report buffers in the ring, it must be a power of 2. One
+   buffer is always owned by the interrupt transfer.  */
+#ifndef UX_HOST_CLASS_HID_REPORT_RING_DEPTH
+#define UX_HOST_CLASS_HID_REPORT_RING_DEPTH                     8
+#endif
+
+#if (UX_HOST_CLASS_HID_REPORT_RING_DEPTH < 2) || ((UX_HOST_CLASS_HID_REPORT_RING_DEPTH & (UX_HOST_CLASS_HID_REPORT_RING_DEPTH - 1)) != 0)
+#error UX_HOST_CLASS_HID_REPORT_RING_DEPTH must be a power of 2
+#endif
+
+/* Option: cache the parsed report descriptors. After a report descriptor is
+   parsed, its reports, fields, usages, values and decode plans are copied in
+   one block of the HID class, keyed by the device VID, PID and bcdDevice and
+   by the descriptor itself. When the same device is attached again the report
+   descriptor is still read, but if it is the cached one the reports are cloned
+   from the cache with one allocation instead of being parsed again.  */
+/* #define UX_HOST_CLASS_HID_PARSE_CACHE */
+
+/* Define the number of report descriptors kept in the parse cache, the oldest
+   one is replaced when the cache is full.  */
+#ifndef UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES
+#define UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES                   4
+#endif
+
+/* Option: allocate the parsed reports of a HID instance in one arena. Before
+   the report descriptor is parsed, a first pass over it computes the memory
+   the reports, fields, usages, values and decode plans can take at most. This
+   memory is allocated once and the parser takes its blocks from it, so a big
+   descriptor no longer makes hundreds of small allocations in the regular
+   pool. The arena is freed in one call when the instance is cleaned. The
+   instance keeps the size of its arena and the number of bytes used in it.
+   If the arena can not be allocated, the blocks are allocated one by one.  */
+/* #define UX_HOST_CLASS_HID_PARSER_ARENA */
+
 
 /* Define HID Class constants.  */
 
@@ -103,6 +174,7 @@ extern   "C" {
 #define UX_HOST_CLASS_HID_REPORT_DECOMPRESSED                   0
 #define UX_HOST_CLASS_HID_REPORT_RAW                            1
 #define UX_HOST_CLASS_HID_REPORT_INDIVIDUAL_USAGE               2
+#define UX_HOST_CLASS_HID_REPORT_STRUCTURE                      4
 #define UX_HOST_CLASS_HID_INTERRUPT_ENDPOINT_READY              1
 #define UX_HOST_CLASS_HID_INTERRUPT_ENDPOINT_ACTIVE             2
 
@@ -783,10 +855,18 @@ extern   "C" {
 #define UX_HOST_CLASS_HID_FLAG_LOCK                             1ul
 #define UX_HOST_CLASS_HID_FLAG_PROTECT                          2ul
 
+/* Define HID decode plan entry flags.  */
+#define UX_HOST_CLASS_HID_PLAN_SIGNED                           1u
+#define UX_HOST_CLASS_HID_PLAN_ARRAY                            2u
+
 #ifndef UX_HOST_CLASS_HID_REPORT_TRANSFER_TIMEOUT
 #define UX_HOST_CLASS_HID_REPORT_TRANSFER_TIMEOUT               10000
 #endif
 
+#ifndef UX_HOST_CLASS_HID_PLAN_WAIT_TIMEOUT
+#define UX_HOST_CLASS_HID_PLAN_WAIT_TIMEOUT                     1000
+#endif
+
 /* Define HID Class descriptor.  */
 
 typedef struct UX_HID_DESCRIPTOR_STRUCT
@@ -818,6 +898,9 @@ typedef struct UX_HOST_CLASS_HID_REPORT_CALLBACK_STRUCT
     ULONG           ux_host_class_hid_report_callback_actual_length;
     VOID            *ux_host_class_hid_report_callback_buffer;
     VOID            (*ux_host_class_hid_report_callback_function) (struct UX_HOST_CLASS_HID_REPORT_CALLBACK_STRUCT *);
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+    ULONG           ux_host_class_hid_report_callback_timestamp;
+#endif
 } UX_HOST_CLASS_HID_REPORT_CALLBACK;
 
 
@@ -898,6 +981,33 @@ typedef struct UX_HOST_CLASS_HID_FIELD_STRUCT
 } UX_HOST_CLASS_HID_FIELD;
 
 
+/* Define HID Class report decode plan entry structure.  */
+
+typedef struct UX_HOST_CLASS_HID_PLAN_ENTRY_STRUCT
+{
+
+    ULONG           ux_host_class_hid_plan_entry_usage;
+    ULONG           ux_host_class_hid_plan_entry_bit_offset;
+    UCHAR           ux_host_class_hid_plan_entry_bit_size;
+    UCHAR           ux_host_class_hid_plan_entry_flags;
+    UCHAR           ux_host_class_hid_plan_entry_destination_size;
+    UCHAR           ux_host_class_hid_plan_entry_reserved;
+    ULONG           ux_host_class_hid_plan_entry_destination_offset;
+} UX_HOST_CLASS_HID_PLAN_ENTRY;
+
+
+/* Define HID Class report layout structure, one per client structure member.  */
+
+typedef struct UX_HOST_CLASS_HID_LAYOUT_STRUCT
+{
+
+    ULONG           ux_host_class_hid_layout_usage;
+    ULONG           ux_host_class_hid_layout_offset;
+    ULONG           ux_host_class_hid_layout_size;
+    ULONG           ux_host_class_hid_layout_count;
+} UX_HOST_CLASS_HID_LAYOUT;
+
+
 /* Define HID Class report structure.  */
 
 typedef struct UX_HOST_CLASS_HID_REPORT_STRUCT
@@ -916,6 +1026,17 @@ typedef struct UX_HOST_CLASS_HID_REPORT_STRUCT
     VOID            (*ux_host_class_hid_report_callback_function) (struct UX_HOST_CLASS_HID_REPORT_CALLBACK_STRUCT *);
     struct UX_HOST_CLASS_HID_REPORT_STRUCT 
                     *ux_host_class_hid_report_next_report;
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+    UX_HOST_CLASS_HID_PLAN_ENTRY
+                    *ux_host_class_hid_report_plan;
+    UX_HOST_CLASS_HID_PLAN_ENTRY
+                    *ux_host_class_hid_report_plan_bound;
+    ULONG           ux_host_class_hid_report_plan_count;
+    ULONG           ux_host_class_hid_report_plan_length;
+    ULONG           ux_host_class_hid_report_plan_structure_length;
+    ULONG           ux_host_class_hid_report_plan_users;
+    UX_SEMAPHORE    *ux_host_class_hid_report_plan_waiter;
+#endif
 } UX_HOST_CLASS_HID_REPORT;
 
 
@@ -945,6 +1066,34 @@ typedef struct UX_HOST_CLASS_HID_PARSER_STRUCT
 } UX_HOST_CLASS_HID_PARSER;
 
 
+/* Define HID Class report descriptor parse cache structures.  */
+
+typedef struct UX_HOST_CLASS_HID_PARSE_CACHE_ENTRY_STRUCT
+{
+
+    UCHAR           *ux_host_class_hid_parse_cache_entry_block;
+    ULONG           ux_host_class_hid_parse_cache_entry_reports_length;
+    ULONG           ux_host_class_hid_parse_cache_entry_descriptor_length;
+    ULONG           ux_host_class_hid_parse_cache_entry_descriptor_hash;
+    USHORT          ux_host_class_hid_parse_cache_entry_vendor_id;
+    USHORT          ux_host_class_hid_parse_cache_entry_product_id;
+    USHORT          ux_host_class_hid_parse_cache_entry_device_release;
+    USHORT          ux_host_class_hid_parse_cache_entry_reserved;
+    UX_HOST_CLASS_HID_REPORT
+                    *ux_host_class_hid_parse_cache_entry_reports[3];
+} UX_HOST_CLASS_HID_PARSE_CACHE_ENTRY;
+
+typedef struct UX_HOST_CLASS_HID_PARSE_CACHE_EXT_STRUCT
+{
+
+    UX_HOST_CLASS_HID_PARSE_CACHE_ENTRY
+                    ux_host_class_hid_parse_cache_entries[UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES];
+    ULONG           ux_host_class_hid_parse_cache_next_entry;
+    ULONG           ux_host_class_hid_parse_cache_hits;
+    ULONG           ux_host_class_hid_parse_cache_misses;
+} UX_HOST_CLASS_HID_PARSE_CACHE_EXT;
+
+
 /* Define HID Class item analysis structure.  */
 
 typedef struct UX_HOST_CLASS_HID_ITEM_STRUCT
@@ -957,6 +1106,26 @@ typedef struct UX_HOST_CLASS_HID_ITEM_STRUCT
 }  UX_HOST_CLASS_HID_ITEM;
 
 
+/* Define HID Class report ring structures.  */
+
+typedef struct UX_HOST_CLASS_HID_RING_SLOT_STRUCT
+{
+
+    UCHAR           *ux_host_class_hid_ring_slot_buffer;
+    ULONG           ux_host_class_hid_ring_slot_length;
+    ULONG           ux_host_class_hid_ring_slot_timestamp;
+} UX_HOST_CLASS_HID_RING_SLOT;
+
+typedef struct UX_HOST_CLASS_HID_RING_STATISTICS_STRUCT
+{
+
+    ULONG           ux_host_class_hid_ring_statistics_received;
+    ULONG           ux_host_class_hid_ring_statistics_dropped;
+    ULONG           ux_host_class_hid_ring_statistics_pending_high_water;
+    ULONG           ux_host_class_hid_ring_statistics_latency_max;
+} UX_HOST_CLASS_HID_RING_STATISTICS;
+
+
 /* Define HID Class instance structure.  */
 
 typedef struct UX_HOST_CLASS_HID_STRUCT
@@ -981,6 +1150,9 @@ typedef struct UX_HOST_CLASS_HID_STRUCT
                     *ux_host_class_hid_client;
 #if !defined(UX_HOST_STANDALONE)
     UX_SEMAPHORE    ux_host_class_hid_semaphore;
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+    UX_SEMAPHORE    ux_host_class_hid_plan_semaphore;
+#endif
 #else
     ULONG           ux_host_class_hid_flags;
     UCHAR           *ux_host_class_hid_allocated;
@@ -990,8 +1162,42 @@ typedef struct UX_HOST_CLASS_HID_STRUCT
     UCHAR           ux_host_class_hid_cmd_state;
     UCHAR           reserved[1];
 #endif
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+    UCHAR           *ux_host_class_hid_ring_buffer;
+    UX_HOST_CLASS_HID_RING_SLOT
+                    ux_host_class_hid_ring_slots[UX_HOST_CLASS_HID_REPORT_RING_DEPTH];
+    ULONG           ux_host_class_hid_ring_head;
+    ULONG           ux_host_class_hid_ring_tail;
+    UX_HOST_CLASS_HID_RING_STATISTICS
+                    ux_host_class_hid_ring_statistics;
+    UX_SEMAPHORE    ux_host_class_hid_ring_semaphore;
+    UX_THREAD       ux_host_class_hid_ring_thread;
+    UCHAR           *ux_host_class_hid_ring_thread_stack;
+#endif
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+    UCHAR           *ux_host_class_hid_parse_cache_block;
+#endif
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+    UCHAR           *ux_host_class_hid_arena;
+    ULONG           ux_host_class_hid_arena_size;
+    ULONG           ux_host_class_hid_arena_used;
+    ULONG           ux_host_class_hid_arena_last;
+#endif
 } UX_HOST_CLASS_HID;
 
+
+/* Define HID Class parser memory allocation, from the arena of the instance if
+   there is one.  */
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+#define UX_HOST_CLASS_HID_ARENA_ALIGN(size)                     (((ULONG)(size) + 7u) & ~7u)
+#define _ux_host_class_hid_parser_allocate(hid, count, size)    _ux_host_class_hid_arena_allocate(hid, (ULONG)(count), (ULONG)(size))
+#define _ux_host_class_hid_parser_free(hid, memory)             _ux_host_class_hid_arena_free(hid, memory)
+#else
+#define _ux_host_class_hid_parser_allocate(hid, count, size)    _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY, count, size)
+#define _ux_host_class_hid_parser_free(hid, memory)             _ux_utility_memory_free(memory)
+#endif
+
 #if defined(UX_HOST_STANDALONE)
 #define _ux_host_class_hid_lock_fail_return(hid)                                \
     UX_DISABLE                                                                  \
@@ -1065,6 +1271,9 @@ typedef struct UX_HOST_CLASS_HID_CLIENT_STRUCT
 /* Define HID Class function prototypes.  */
 
 UINT    _ux_host_class_hid_activate(UX_HOST_CLASS_COMMAND  *command);
+VOID    *_ux_host_class_hid_arena_allocate(UX_HOST_CLASS_HID *hid, ULONG count, ULONG size);
+UINT    _ux_host_class_hid_arena_create(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, ULONG length);
+VOID    _ux_host_class_hid_arena_free(UX_HOST_CLASS_HID *hid, VOID *memory);
 UINT    _ux_host_class_hid_client_register(UCHAR *hid_client_name,
                                 UINT (*hid_client_handler)(struct UX_HOST_CLASS_HID_CLIENT_COMMAND_STRUCT *));
 UINT    _ux_host_class_hid_client_search(UX_HOST_CLASS_HID *hid);
@@ -1081,6 +1290,12 @@ UINT    _ux_host_class_hid_interrupt_endpoint_search(UX_HOST_CLASS_HID *hid);
 ULONG   _ux_host_class_hid_item_data_get(UCHAR *descriptor, UX_HOST_CLASS_HID_ITEM *item);
 UINT    _ux_host_class_hid_local_item_parse(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_ITEM *item, UCHAR *descriptor);
 UINT    _ux_host_class_hid_main_item_parse(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_ITEM *item, UCHAR *descriptor);
+ULONG   _ux_host_class_hid_parse_cache_copy(UX_HOST_CLASS_HID_REPORT **target_reports, UX_HOST_CLASS_HID_REPORT **source_reports,
+                                                    UCHAR *block);
+VOID    _ux_host_class_hid_parse_cache_free(UX_HOST_CLASS *hid_class);
+ULONG   _ux_host_class_hid_parse_cache_hash(UCHAR *descriptor, ULONG length);
+UINT    _ux_host_class_hid_parse_cache_load(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, ULONG length);
+VOID    _ux_host_class_hid_parse_cache_store(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, ULONG length);
 UINT    _ux_host_class_hid_periodic_report_start(UX_HOST_CLASS_HID *hid);
 UINT    _ux_host_class_hid_periodic_report_stop(UX_HOST_CLASS_HID *hid);
 UINT    _ux_host_class_hid_report_add(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, UX_HOST_CLASS_HID_ITEM *item);
@@ -1090,9 +1305,18 @@ UINT    _ux_host_class_hid_report_compress(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS
 UINT    _ux_host_class_hid_report_decompress(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report,
                                                     UCHAR  *report_buffer, ULONG report_length);
 UINT    _ux_host_class_hid_report_descriptor_get(UX_HOST_CLASS_HID *hid, ULONG length);
+UINT    _ux_host_class_hid_report_dispatch(UX_HOST_CLASS_HID *hid, UCHAR *report_buffer, ULONG report_length, ULONG timestamp);
 UINT    _ux_host_class_hid_report_get(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report);
 UINT    _ux_host_class_hid_report_id_get(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT_GET_ID *report_id);
+UINT    _ux_host_class_hid_report_layout_set(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT *hid_report,
+                                                    UX_HOST_CLASS_HID_LAYOUT *layout, ULONG layout_count, ULONG structure_length);
+UINT    _ux_host_class_hid_report_plan_compile(UX_HOST_CLASS_HID *hid);
+UINT    _ux_host_class_hid_report_plan_decode(UX_HOST_CLASS_HID_REPORT *hid_report, UCHAR *report_buffer,
+                                                    ULONG report_length, VOID *structure, ULONG structure_length);
 UINT    _ux_host_class_hid_report_item_analyse(UCHAR *descriptor, UX_HOST_CLASS_HID_ITEM *item);
+UINT    _ux_host_class_hid_report_ring_start(UX_HOST_CLASS_HID *hid);
+UINT    _ux_host_class_hid_report_ring_stop(UX_HOST_CLASS_HID *hid);
+VOID    _ux_host_class_hid_report_ring_thread(ULONG thread_input);
 UINT    _ux_host_class_hid_report_set(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report);
 UINT    _ux_host_class_hid_resources_free(UX_HOST_CLASS_HID *hid);
 VOID    _ux_host_class_hid_transfer_request_completed(UX_TRANSFER *transfer_request);
@@ -1114,6 +1338,8 @@ UINT    _uxe_host_class_hid_periodic_report_stop(UX_HOST_CLASS_HID *hid);
 UINT    _uxe_host_class_hid_report_callback_register(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT_CALLBACK *call_back);
 UINT    _uxe_host_class_hid_report_get(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report);
 UINT    _uxe_host_class_hid_report_id_get(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT_GET_ID *report_id);
+UINT    _uxe_host_class_hid_report_layout_set(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT *hid_report,
+                                                    UX_HOST_CLASS_HID_LAYOUT *layout, ULONG layout_count, ULONG structure_length);
 UINT    _uxe_host_class_hid_report_set(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report);
 
 UINT    _uxe_host_class_hid_idle_set_run(UX_HOST_CLASS_HID *hid, USHORT idle_time, USHORT report_id);
@@ -1130,6 +1356,7 @@ UINT    _uxe_host_class_hid_report_set_run(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS
 
 #define ux_host_class_hid_report_add                        _ux_host_class_hid_report_add
 #define ux_host_class_hid_report_descriptor_get             _ux_host_class_hid_report_descriptor_get
+#define ux_host_class_hid_report_plan_decode                _ux_host_class_hid_report_plan_decode
 
 #if defined(UX_DEVICE_CLASS_HID_ENABLE_ERROR_CHECKING)
 
@@ -1143,6 +1370,7 @@ UINT    _uxe_host_class_hid_report_set_run(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS
 
 #define ux_host_class_hid_report_callback_register          _uxe_host_class_hid_report_callback_register
 #define ux_host_class_hid_report_id_get                     _uxe_host_class_hid_report_id_get
+#define ux_host_class_hid_report_layout_set                 _uxe_host_class_hid_report_layout_set
 #define ux_host_class_hid_report_get                        _uxe_host_class_hid_report_get
 #define ux_host_class_hid_report_set                        _uxe_host_class_hid_report_set
 
@@ -1158,6 +1386,7 @@ UINT    _uxe_host_class_hid_report_set_run(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS
 
 #define ux_host_class_hid_report_callback_register          _ux_host_class_hid_report_callback_register
 #define ux_host_class_hid_report_id_get                     _ux_host_class_hid_report_id_get
+#define ux_host_class_hid_report_layout_set                 _ux_host_class_hid_report_layout_set
 #define ux_host_class_hid_report_get                        _ux_host_class_hid_report_get
 #define ux_host_class_hid_report_set                        _ux_host_class_hid_report_set
 
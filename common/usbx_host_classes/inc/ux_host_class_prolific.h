@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_prolific.h                            PORTABLE C      */ 
-/*                                                           6.1.8        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -50,6 +50,10 @@
 /*                                            added extern "C" keyword    */
 /*                                            for compatibility with C++, */
 /*                                            resulting in version 6.1.8  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode and      */
+/*                                            statistics,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -74,6 +78,9 @@ extern   "C" {
 #endif
 
 
+#include "ux_host_class_serial.h"
+
+
 /* Define PROLIFIC Class constants.  */
                                                                 
 #define UX_HOST_CLASS_PROLIFIC_DEVICE_INIT_DELAY                (1 * UX_PERIODIC_RATE)
@@ -228,6 +235,10 @@ typedef struct UX_HOST_CLASS_PROLIFIC_STRUCT
     UCHAR           ux_host_class_prolific_device_type;
     struct UX_HOST_CLASS_PROLIFIC_RECEPTION_STRUCT  
                     *ux_host_class_prolific_reception;
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+    UX_HOST_CLASS_SERIAL_STATISTICS
+                    ux_host_class_prolific_statistics;
+#endif
     
 } UX_HOST_CLASS_PROLIFIC;
 
@@ -247,6 +258,14 @@ typedef struct UX_HOST_CLASS_PROLIFIC_RECEPTION_STRUCT
                                                                 UINT  status,
                                                                 UCHAR *reception_buffer, 
                                                                 ULONG reception_size);
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    ULONG           ux_host_class_prolific_reception_transfer_count;
+    UX_EVENT_FLAGS_GROUP
+                    *ux_host_class_prolific_reception_event_flags_group;
+    ULONG           ux_host_class_prolific_reception_event_flags;
+    UX_HOST_CLASS_SERIAL_STREAM
+                    ux_host_class_prolific_reception_stream;
+#endif
 
 } UX_HOST_CLASS_PROLIFIC_RECEPTION;
 
@@ -302,6 +321,8 @@ UINT  _ux_host_class_prolific_reception_stop (UX_HOST_CLASS_PROLIFIC *prolific,
                                     UX_HOST_CLASS_PROLIFIC_RECEPTION *prolific_reception);
 UINT  _ux_host_class_prolific_reception_start (UX_HOST_CLASS_PROLIFIC *prolific, 
                                     UX_HOST_CLASS_PROLIFIC_RECEPTION *prolific_reception);
+UINT  _ux_host_class_prolific_reception_span_get(UX_HOST_CLASS_PROLIFIC *prolific, UCHAR **span_buffer, ULONG *span_length);
+UINT  _ux_host_class_prolific_reception_span_release(UX_HOST_CLASS_PROLIFIC *prolific, ULONG length);
                                     
 VOID  _ux_host_class_prolific_reception_callback (UX_TRANSFER *transfer_request);
 UINT  _ux_host_class_prolific_setup(UX_HOST_CLASS_PROLIFIC *prolific);
@@ -319,6 +340,8 @@ UINT  _uxe_host_class_prolific_reception_stop (UX_HOST_CLASS_PROLIFIC *prolific,
                                     UX_HOST_CLASS_PROLIFIC_RECEPTION *prolific_reception);
 UINT  _uxe_host_class_prolific_reception_start (UX_HOST_CLASS_PROLIFIC *prolific, 
                                     UX_HOST_CLASS_PROLIFIC_RECEPTION *prolific_reception);
+UINT  _uxe_host_class_prolific_reception_span_get(UX_HOST_CLASS_PROLIFIC *prolific, UCHAR **span_buffer, ULONG *span_length);
+UINT  _uxe_host_class_prolific_reception_span_release(UX_HOST_CLASS_PROLIFIC *prolific, ULONG length);
 
 
 /* Define Prolific Class API prototypes.  */
@@ -334,6 +357,8 @@ UINT  _uxe_host_class_prolific_reception_start (UX_HOST_CLASS_PROLIFIC *prolific
 #define  ux_host_class_prolific_command                         _uxe_host_class_prolific_command
 #define  ux_host_class_prolific_reception_stop                  _uxe_host_class_prolific_reception_stop
 #define  ux_host_class_prolific_reception_start                 _uxe_host_class_prolific_reception_start
+#define  ux_host_class_prolific_reception_span_get              _uxe_host_class_prolific_reception_span_get
+#define  ux_host_class_prolific_reception_span_release          _uxe_host_class_prolific_reception_span_release
 
 #else
 
@@ -343,6 +368,8 @@ UINT  _uxe_host_class_prolific_reception_start (UX_HOST_CLASS_PROLIFIC *prolific
 #define  ux_host_class_prolific_command                         _ux_host_class_prolific_command
 #define  ux_host_class_prolific_reception_stop                  _ux_host_class_prolific_reception_stop
 #define  ux_host_class_prolific_reception_start                 _ux_host_class_prolific_reception_start
+#define  ux_host_class_prolific_reception_span_get              _ux_host_class_prolific_reception_span_get
+#define  ux_host_class_prolific_reception_span_release          _ux_host_class_prolific_reception_span_release
 
 #endif
 
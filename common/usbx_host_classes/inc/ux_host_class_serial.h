@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  COMPONENT DEFINITION                                   RELEASE        */
+/*                                                                        */
+/*    ux_host_class_serial.h                              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This file contains the definitions and extern functions of the      */
+/*    serial data engine shared by the host serial classes (CDC ACM,      */
+/*    generic serial, Prolific and Sierra Wireless AR).                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+
+#ifndef UX_HOST_CLASS_SERIAL_H
+#define UX_HOST_CLASS_SERIAL_H
+
+/* Determine if a C++ compiler is being used.  If so, ensure that standard
+   C is used to process the API information.  */
+
+#ifdef   __cplusplus
+
+/* Yes, C++ compiler is present.  Use standard C.  */
+extern   "C" {
+
+#endif
+
+
+/* Option: enable the streaming reception of the host serial classes. A
+   reception whose transfer count is not 0 keeps that many block-sized
+   transfers outstanding on the bulk IN endpoint, one per free block of the
+   reception buffer. Completed blocks are kept until the application
+   releases them, they are read as contiguous spans without copying. When
+   all blocks are waiting for the application the device is NAKed and an
+   overflow is reported.
+   A reception can also signal an event flags group shared by several ports
+   instead of calling back for each block: its flags are set when data is
+   received in an empty buffer or when the reception fails, so that a single
+   application thread serves all the ports and is woken once per burst.
+   The mode needs a HCD that accepts several pending transfer requests on
+   one endpoint.  */
+/* #define UX_HOST_CLASS_SERIAL_RECEPTION_STREAM */
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM) && defined(UX_HOST_STANDALONE)
+#error UX_HOST_CLASS_SERIAL_RECEPTION_STREAM is not supported in standalone mode
+#endif
+
+/* Option: keep statistics for each port of the host serial classes: bytes
+   read and written and, with the streaming reception, the overflows and the
+   high water mark of the blocks waiting for the application.  */
+/* #define UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT */
+
+
+/* Define serial stream states.  */
+
+#define UX_HOST_CLASS_SERIAL_STREAM_STATE_STOPPED               0
+#define UX_HOST_CLASS_SERIAL_STREAM_STATE_STARTED               1
+
+
+/* Define serial port statistics structure.  */
+
+typedef struct UX_HOST_CLASS_SERIAL_STATISTICS_STRUCT
+{
+
+    ULONG           ux_host_class_serial_statistics_rx_bytes;
+    ULONG           ux_host_class_serial_statistics_rx_overflows;
+    ULONG           ux_host_class_serial_statistics_rx_blocks_high_water;
+    ULONG           ux_host_class_serial_statistics_tx_bytes;
+
+} UX_HOST_CLASS_SERIAL_STATISTICS;
+
+/* Define serial stream structure, it is part of the class reception.  */
+
+typedef struct UX_HOST_CLASS_SERIAL_STREAM_STRUCT
+{
+
+    ULONG           ux_host_class_serial_stream_state;
+    UX_ENDPOINT     *ux_host_class_serial_stream_endpoint;
+    UX_HOST_CLASS_SERIAL_STATISTICS
+                    *ux_host_class_serial_stream_statistics;
+    UCHAR           *ux_host_class_serial_stream_buffer;
+    ULONG           ux_host_class_serial_stream_block_size;
+    ULONG           ux_host_class_serial_stream_block_count;
+    ULONG           *ux_host_class_serial_stream_block_lengths;
+    ULONG           ux_host_class_serial_stream_block_head;
+    ULONG           ux_host_class_serial_stream_block_tail;
+    ULONG           ux_host_class_serial_stream_block_offset;
+    ULONG           ux_host_class_serial_stream_blocks_filled;
+    UX_TRANSFER     *ux_host_class_serial_stream_transfer_requests;
+    ULONG           ux_host_class_serial_stream_transfer_count;
+    ULONG           ux_host_class_serial_stream_transfer_next;
+    ULONG           ux_host_class_serial_stream_transfers_pending;
+    UCHAR           ux_host_class_serial_stream_arming;
+    UX_EVENT_FLAGS_GROUP
+                    *ux_host_class_serial_stream_event_flags_group;
+    ULONG           ux_host_class_serial_stream_event_flags;
+
+} UX_HOST_CLASS_SERIAL_STREAM;
+
+
+/* Define serial engine function prototypes.  */
+
+UINT    _ux_host_class_serial_transfer(UX_TRANSFER *transfer_request, UCHAR *data_pointer,
+                                    ULONG requested_length, ULONG *actual_length, ULONG wait_option);
+
+UINT    _ux_host_class_serial_stream_start(UX_HOST_CLASS_SERIAL_STREAM *stream, UX_ENDPOINT *endpoint,
+                                    UX_HOST_CLASS_SERIAL_STATISTICS *statistics,
+                                    UCHAR *buffer, ULONG buffer_size, ULONG block_size, ULONG transfer_count,
+                                    VOID (*completion_function)(UX_TRANSFER *),
+                                    VOID *class_instance, VOID *user_specific);
+UINT    _ux_host_class_serial_stream_stop(UX_HOST_CLASS_SERIAL_STREAM *stream);
+UINT    _ux_host_class_serial_stream_arm(UX_HOST_CLASS_SERIAL_STREAM *stream);
+UINT    _ux_host_class_serial_stream_completed(UX_HOST_CLASS_SERIAL_STREAM *stream, UX_TRANSFER *transfer_request);
+UINT    _ux_host_class_serial_stream_span_get(UX_HOST_CLASS_SERIAL_STREAM *stream, UCHAR **span_buffer, ULONG *span_length);
+UINT    _ux_host_class_serial_stream_span_release(UX_HOST_CLASS_SERIAL_STREAM *stream, ULONG length);
+
+/* Determine if a C++ compiler is being used.  If so, complete the standard
+   C conditional started above.  */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
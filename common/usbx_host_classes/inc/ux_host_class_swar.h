@@ -26,7 +26,7 @@
 /*  COMPONENT DEFINITION                                   RELEASE        */ 
 /*                                                                        */ 
 /*    ux_host_class_swar.h                                PORTABLE C      */ 
-/*                                                           6.1.8        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -50,6 +50,10 @@
 /*                                            added extern "C" keyword    */
 /*                                            for compatibility with C++, */
 /*                                            resulting in version 6.1.8  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode and      */
+/*                                            statistics,                 */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -74,6 +78,9 @@ extern   "C" {
 #endif
 
 
+#include "ux_host_class_serial.h"
+
+
 /* Define Sierra Wireless AR Class constants.  */
 
 #define UX_HOST_CLASS_SWAR_CLASS_TRANSFER_TIMEOUT               300000
@@ -116,6 +123,10 @@ typedef struct UX_HOST_CLASS_SWAR_STRUCT
 
     struct UX_HOST_CLASS_SWAR_RECEPTION_STRUCT  
                     *ux_host_class_swar_reception;
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+    UX_HOST_CLASS_SERIAL_STATISTICS
+                    ux_host_class_swar_statistics;
+#endif
     ULONG           ux_host_class_swar_notification_count;
 } UX_HOST_CLASS_SWAR;
 
@@ -134,6 +145,14 @@ typedef struct UX_HOST_CLASS_SWAR_RECEPTION_STRUCT
                                                                 UINT  status,
                                                                 UCHAR *reception_buffer, 
                                                                 ULONG reception_size);
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    ULONG           ux_host_class_swar_reception_transfer_count;
+    UX_EVENT_FLAGS_GROUP
+                    *ux_host_class_swar_reception_event_flags_group;
+    ULONG           ux_host_class_swar_reception_event_flags;
+    UX_HOST_CLASS_SERIAL_STREAM
+                    ux_host_class_swar_reception_stream;
+#endif
 
 } UX_HOST_CLASS_SWAR_RECEPTION;
 
@@ -155,6 +174,8 @@ UINT    _ux_host_class_swar_reception_stop (UX_HOST_CLASS_SWAR *swar,
                                     UX_HOST_CLASS_SWAR_RECEPTION *swar_reception);
 UINT    _ux_host_class_swar_reception_start (UX_HOST_CLASS_SWAR *swar, 
                                     UX_HOST_CLASS_SWAR_RECEPTION *swar_reception);
+UINT    _ux_host_class_swar_reception_span_get(UX_HOST_CLASS_SWAR *swar, UCHAR **span_buffer, ULONG *span_length);
+UINT    _ux_host_class_swar_reception_span_release(UX_HOST_CLASS_SWAR *swar, ULONG length);
 
 
 UINT    _uxe_host_class_swar_read (UX_HOST_CLASS_SWAR *swar, UCHAR *data_pointer, 
@@ -167,6 +188,8 @@ UINT    _uxe_host_class_swar_reception_stop (UX_HOST_CLASS_SWAR *swar,
                                     UX_HOST_CLASS_SWAR_RECEPTION *swar_reception);
 UINT    _uxe_host_class_swar_reception_start (UX_HOST_CLASS_SWAR *swar, 
                                     UX_HOST_CLASS_SWAR_RECEPTION *swar_reception);
+UINT    _uxe_host_class_swar_reception_span_get(UX_HOST_CLASS_SWAR *swar, UCHAR **span_buffer, ULONG *span_length);
+UINT    _uxe_host_class_swar_reception_span_release(UX_HOST_CLASS_SWAR *swar, ULONG length);
 
 /* Define SWAR Class API prototypes.  */
 
@@ -180,6 +203,8 @@ UINT    _uxe_host_class_swar_reception_start (UX_HOST_CLASS_SWAR *swar,
 #define  ux_host_class_swar_ioctl                           _uxe_host_class_swar_ioctl
 #define  ux_host_class_swar_reception_stop                  _uxe_host_class_swar_reception_stop
 #define  ux_host_class_swar_reception_start                 _uxe_host_class_swar_reception_start
+#define  ux_host_class_swar_reception_span_get              _uxe_host_class_swar_reception_span_get
+#define  ux_host_class_swar_reception_span_release          _uxe_host_class_swar_reception_span_release
 
 #else
 
@@ -188,6 +213,8 @@ UINT    _uxe_host_class_swar_reception_start (UX_HOST_CLASS_SWAR *swar,
 #define  ux_host_class_swar_ioctl                           _ux_host_class_swar_ioctl
 #define  ux_host_class_swar_reception_stop                  _ux_host_class_swar_reception_stop
 #define  ux_host_class_swar_reception_start                 _ux_host_class_swar_reception_start
+#define  ux_host_class_swar_reception_span_get              _ux_host_class_swar_reception_span_get
+#define  ux_host_class_swar_reception_span_release          _ux_host_class_swar_reception_span_release
 
 #endif
 
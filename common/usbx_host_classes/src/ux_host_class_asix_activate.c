@@ -94,6 +94,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            masked in standalone build, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            multiple receive buffers,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_asix_activate(UX_HOST_CLASS_COMMAND *command)
@@ -112,6 +115,9 @@ UINT                                status;
 UX_TRANSFER                         *transfer_request;
 ULONG                               physical_address_msw;
 ULONG                               physical_address_lsw;
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+ULONG                               slot;
+#endif
 
 
     /* We need to make sure that the value of the NX_PHYSICAL_HEADER is at least 20.  
@@ -212,11 +218,29 @@ ULONG                               physical_address_lsw;
     /* Allocate some memory for reception.  */
     if (status == UX_SUCCESS)
     {
-        asix -> ux_host_class_asix_receive_buffer = _ux_utility_memory_allocate(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE);
+        asix -> ux_host_class_asix_receive_buffer = _ux_utility_memory_allocate_mulc_safe(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY,
+                                                        UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE, UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT);
         if (asix -> ux_host_class_asix_receive_buffer == UX_NULL)
             status = UX_MEMORY_INSUFFICIENT;
     }
 
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+
+    /* Prepare a bulk IN transfer request for each receive buffer.  */
+    for (slot = 0; (status == UX_SUCCESS) && (slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT); slot ++)
+    {
+        transfer_request =  &asix -> ux_host_class_asix_receive_transfer_requests[slot];
+        transfer_request -> ux_transfer_request_endpoint =          asix -> ux_host_class_asix_bulk_in_endpoint;
+        transfer_request -> ux_transfer_request_type =              UX_REQUEST_IN;
+        transfer_request -> ux_transfer_request_class_instance =    (VOID *) asix;
+        transfer_request -> ux_transfer_request_packet_length =
+                    asix -> ux_host_class_asix_bulk_in_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_packet_length;
+        transfer_request -> ux_transfer_request_timeout_value =
+                    asix -> ux_host_class_asix_bulk_in_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_timeout_value;
+        status = _ux_host_semaphore_create(&transfer_request -> ux_transfer_request_semaphore, "ux_host_asix_receive_semaphore", 0);
+    }
+#endif
+
     /* Activate network driver.  */
     if (status == UX_SUCCESS)
     {
@@ -265,6 +289,16 @@ ULONG                               physical_address_lsw;
     if (asix -> ux_host_class_asix_receive_buffer)
         _ux_utility_memory_free(asix -> ux_host_class_asix_receive_buffer);
 
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+
+    /* Free receive transfer requests semaphores.  */
+    for (slot = 0; slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT; slot ++)
+    {
+        if (_ux_host_semaphore_created(&asix -> ux_host_class_asix_receive_transfer_requests[slot].ux_transfer_request_semaphore))
+            _ux_host_semaphore_delete(&asix -> ux_host_class_asix_receive_transfer_requests[slot].ux_transfer_request_semaphore);
+    }
+#endif
+
     /* Free asix -> ux_host_class_asix_thread.  */
     if (asix -> ux_host_class_asix_thread.tx_thread_id)
         _ux_utility_thread_delete(&asix -> ux_host_class_asix_thread);
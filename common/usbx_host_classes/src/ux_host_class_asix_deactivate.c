@@ -66,6 +66,8 @@
 /*    _ux_utility_thread_delete             Delete thread                 */
 /*    _ux_network_driver_deactivate         Deactivate NetX USB interface */
 /*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -90,6 +92,12 @@
 /*                                            added reception buffer,     */
 /*                                            removed internal NX pool,   */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            multiple receive buffers,   */
+/*                                            resulting in version 6.x    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_asix_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -100,6 +108,9 @@ UX_TRANSFER                 *transfer_request;
 NX_PACKET                   *current_packet;
 NX_PACKET                   *next_packet;
 UINT                        status;
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+ULONG                               slot;
+#endif
 
     /* Get the instance for this class.  */
     asix =  (UX_HOST_CLASS_ASIX *) command -> ux_host_class_command_instance;
@@ -128,6 +139,9 @@ UINT                        status;
         while (current_packet != UX_NULL)
         {
         
+            /* Log the transmit completion.  */
+            _ux_network_driver_packet_transmitted(asix -> ux_host_class_asix_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_LINK_DOWN);
+
             /* Free the packet that was just sent.  First do some housekeeping.  */
             current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_ASIX_ETHERNET_SIZE; 
             current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_HOST_CLASS_ASIX_ETHERNET_SIZE;
@@ -176,6 +190,13 @@ UINT                        status;
 
         /* We need to abort transactions on the bulk In pipe.  */
         _ux_host_stack_endpoint_transfer_abort(asix -> ux_host_class_asix_bulk_in_endpoint);
+
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+
+    /* Abort transactions of all receive buffers.  */
+    for (slot = 0; slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT; slot ++)
+        _ux_host_stack_transfer_request_abort(&asix -> ux_host_class_asix_receive_transfer_requests[slot]);
+#endif
     
     /* Then endpoint OUT.  */       
     transfer_request =  &asix -> ux_host_class_asix_bulk_out_endpoint -> ux_endpoint_transfer_request;
@@ -204,6 +225,13 @@ UINT                        status;
     /* Free receive buffer memory.  */
     _ux_utility_memory_free(asix -> ux_host_class_asix_receive_buffer);
 
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+
+    /* Destroy the receive transfer requests semaphores.  */
+    for (slot = 0; slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT; slot ++)
+        _ux_host_semaphore_delete(&asix -> ux_host_class_asix_receive_transfer_requests[slot].ux_transfer_request_semaphore);
+#endif
+
 #ifdef UX_HOST_CLASS_ASIX_PACKET_CHAIN_SUPPORT
 
     /* Free transmit buffer memory.  */
@@ -57,6 +57,7 @@
 /*                                                                        */ 
 /*    _ux_host_semaphore_put                Put semaphore                 */
 /*    _ux_host_stack_transfer_request       Transfer request              */
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -80,12 +81,18 @@
 /*                                            refined link up/down flow,  */
 /*                                            refined interrupt flow,     */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            multiple receive buffers,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_asix_interrupt_notification(UX_TRANSFER *transfer_request)
 {
 
 UX_HOST_CLASS_ASIX                      *asix;
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+ULONG                                   slot;
+#endif
 
     /* Get the class instance for this transfer request.  */
     asix =  (UX_HOST_CLASS_ASIX *) transfer_request -> ux_transfer_request_class_instance;
@@ -147,7 +154,12 @@ UX_HOST_CLASS_ASIX                      *asix;
                     asix -> ux_host_class_asix_link_state = UX_HOST_CLASS_ASIX_LINK_STATE_PENDING_DOWN;
 
                     /* Abort possible pending bulk in requests.  */
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+                    for (slot = 0; slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT; slot ++)
+                        _ux_host_stack_transfer_request_abort(&asix -> ux_host_class_asix_receive_transfer_requests[slot]);
+#else
                     _ux_host_stack_endpoint_transfer_abort(asix -> ux_host_class_asix_bulk_in_endpoint);
+#endif
 
                     /* We need to inform the asix thread of this change.  */
                     _ux_host_semaphore_put(&asix -> ux_host_class_asix_interrupt_notification_semaphore);
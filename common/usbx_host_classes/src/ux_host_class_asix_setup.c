@@ -71,6 +71,10 @@
 /*                                            verified memset and memcpy  */
 /*                                            cases,                      */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), set RX   */
+/*                                            burst size from receive     */
+/*                                            buffer size, resulting in   */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_asix_setup(UX_HOST_CLASS_ASIX *asix)
@@ -619,7 +623,7 @@ UINT                        status;
     transfer_request -> ux_transfer_request_requested_length    =  0;
     transfer_request -> ux_transfer_request_function            =  UX_HOST_CLASS_ASIX_REQ_WRITE_RX_CTL;
     transfer_request -> ux_transfer_request_type                =  UX_REQUEST_OUT | UX_REQUEST_TYPE_VENDOR | UX_REQUEST_TARGET_DEVICE;
-    transfer_request -> ux_transfer_request_value               =  (UX_HOST_CLASS_ASIX_RXCR_AB | UX_HOST_CLASS_ASIX_RXCR_SO | UX_HOST_CLASS_ASIX_RXCR_MFB_2048);
+    transfer_request -> ux_transfer_request_value               =  (UX_HOST_CLASS_ASIX_RXCR_AB | UX_HOST_CLASS_ASIX_RXCR_SO | UX_HOST_CLASS_ASIX_RXCR_MFB);
     transfer_request -> ux_transfer_request_index               =  0;
 
     /* Send request to HCD layer.  */
@@ -59,6 +59,7 @@ static inline UINT _ux_host_class_asix_link_up_controls(UX_HOST_CLASS_ASIX  *asi
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request        Transfer request             */
+/*    _ux_host_stack_transfer_request_abort  Abort transfer request       */
 /*    _ux_host_semaphore_get                 Get semaphore                */
 /*    _ux_host_semaphore_put                 Put semaphore                */
 /*    _ux_utility_memory_allocate            Allocate memory              */
@@ -69,6 +70,8 @@ static inline UINT _ux_host_class_asix_link_up_controls(UX_HOST_CLASS_ASIX  *asi
 /*    _ux_network_driver_link_up             Set state to link up         */
 /*    nx_packet_allocate                     Allocate NetX packet         */
 /*    nx_packet_transmit_release             Release NetX packet          */
+/*    _ux_network_driver_packet_dropped     Log dropped frame             */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -97,6 +100,12 @@ static inline UINT _ux_host_class_asix_link_up_controls(UX_HOST_CLASS_ASIX  *asi
 /*                                            refined reception flow,     */
 /*                                            refined interrupt flow,     */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            multiple receive buffers,   */
+/*                                            resulting in version 6.x    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_asix_thread(ULONG parameter)
@@ -119,6 +128,12 @@ UINT                        status;
 UX_DEVICE                   *device;
 ULONG                       available0, available1;
 USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+ULONG                       ring_index;
+ULONG                       ring_armed;
+ULONG                       ring_slot;
+UINT                        ring_busy;
+#endif
 
 
     /* Cast the parameter passed in the thread into the asix pointer.  */
@@ -182,6 +197,18 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
             buffer_count = 0;
             packet_discard = UX_FALSE;
             asix -> ux_host_class_asix_packet_available_min = 0xFFFFFFFF;
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+            ring_index = 0;
+            ring_armed = 0;
+            ring_busy = UX_FALSE;
+
+            /* No buffer is armed, discard completions left from previous link.  */
+            for (ring_slot = 0; ring_slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT; ring_slot ++)
+            {
+                while (_ux_host_semaphore_get(&asix -> ux_host_class_asix_receive_transfer_requests[ring_slot].ux_transfer_request_semaphore,
+                                              UX_NO_WAIT) == UX_SUCCESS);
+            }
+#endif
 
             /* Polling loop.  */
             while(device -> ux_device_state == UX_DEVICE_CONFIGURED &&
@@ -211,6 +238,58 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
                     }
                 }
 
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+
+                /* Get transfer request of the buffer in process. */
+                transfer_request =  &asix -> ux_host_class_asix_receive_transfer_requests[ring_index];
+
+                /* If there is no buffer ready, read it.  */
+                if (buffer == UX_NULL)
+                {
+
+                    /* The buffer in process is consumed, it can be armed again.  */
+                    if (ring_busy)
+                    {
+                        ring_busy = UX_FALSE;
+                        ring_armed --;
+                        ring_index = (ring_index + 1) % UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT;
+                    }
+
+                    /* Keep all buffers armed, so the device always has a place to send frames.  */
+                    status = UX_SUCCESS;
+                    while (ring_armed < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT)
+                    {
+                        ring_slot = (ring_index + ring_armed) % UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT;
+                        transfer_request =  &asix -> ux_host_class_asix_receive_transfer_requests[ring_slot];
+                        transfer_request -> ux_transfer_request_data_pointer = asix -> ux_host_class_asix_receive_buffer +
+                                                            ring_slot * UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE;
+                        transfer_request -> ux_transfer_request_requested_length =  UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE;
+                        transfer_request -> ux_transfer_request_actual_length =     0;
+                        status = _ux_host_stack_transfer_request(transfer_request);
+                        if (status != UX_SUCCESS)
+                            break;
+                        ring_armed ++;
+                    }
+
+                    /* Check if there is buffer in reception.  */
+                    if (ring_armed == 0)
+                    {
+
+                        /* If a packet (chain) is on-going, release it.  */
+                        if (packet != UX_NULL)
+                        {
+                            nx_packet_release(packet);
+                            packet = UX_NULL;
+                        }
+                        continue;
+                    }
+
+                    /* Wait for the oldest buffer, data must be processed in order.  */
+                    transfer_request =  &asix -> ux_host_class_asix_receive_transfer_requests[ring_index];
+                    _ux_host_semaphore_get_norc(&transfer_request -> ux_transfer_request_semaphore, UX_WAIT_FOREVER);
+                    ring_busy = UX_TRUE;
+#else
+
                 /* Get transfer request for bulk in reception. */
                 transfer_request =  &asix -> ux_host_class_asix_bulk_in_endpoint -> ux_endpoint_transfer_request;
 
@@ -243,6 +322,7 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
 
                     /* Wait for transfer completion.  */
                     _ux_host_semaphore_get_norc(&transfer_request -> ux_transfer_request_semaphore, UX_WAIT_FOREVER);
+#endif
 
                     /* Check completion code.  */
                     if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
@@ -272,6 +352,9 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
                             _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_DESCRIPTOR_CORRUPTED);
                             nx_packet_release(packet);
                             packet = UX_NULL;
+
+                            /* Log the dropped frame.  */
+                            _ux_network_driver_packet_dropped(asix -> ux_host_class_asix_network_handle, USB_NETWORK_DEVICE_DROP_MALFORMED);
                         }
 
                         buffer = UX_NULL;
@@ -281,7 +364,7 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
                     }
 
                     /* Buffer is ready.  */
-                    buffer = asix -> ux_host_class_asix_receive_buffer;
+                    buffer = transfer_request -> ux_transfer_request_data_pointer;
                 }
 
                 /* There is data in buffer, extract the data to packets.  */
@@ -305,6 +388,9 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
 
                         /* Error trap.  */
                         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_ETH_PACKET_ERROR);
+
+                        /* Log the pool empty, no packet to receive the frame.  */
+                        _ux_network_driver_packet_dropped(asix -> ux_host_class_asix_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
                         continue;
                     }
 
@@ -410,6 +496,9 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
                         /* Re-allocate packet.  */
                         nx_packet_release(packet);
                         packet = UX_NULL;
+
+                        /* Log the dropped frame, no packet to chain the data.  */
+                        _ux_network_driver_packet_dropped(asix -> ux_host_class_asix_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
                         continue;
                     }
 
@@ -430,6 +519,13 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
             /* Release packet not sent to NX.  */
             if (packet)
                 nx_packet_release(packet);
+
+#ifdef UX_HOST_CLASS_ASIX_RECEIVE_RING
+
+            /* Stop reception on all buffers.  */
+            for (ring_slot = 0; ring_slot < UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT; ring_slot ++)
+                _ux_host_stack_transfer_request_abort(&asix -> ux_host_class_asix_receive_transfer_requests[ring_slot]);
+#endif
         }
         else
         {
@@ -447,6 +543,9 @@ USB_NETWORK_DEVICE_TYPE     *ux_nx_device;
             while (current_packet != UX_NULL)
             {
 
+                /* Log the transmit completion.  */
+                _ux_network_driver_packet_transmitted(asix -> ux_host_class_asix_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_LINK_DOWN);
+
                 /* Free the packet that was just sent.  First do some housekeeping.  */
                 current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_ASIX_ETHERNET_SIZE;
                 current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_HOST_CLASS_ASIX_ETHERNET_SIZE;
@@ -592,7 +691,7 @@ UINT                        status;
     transfer_request -> ux_transfer_request_function            =  UX_HOST_CLASS_ASIX_REQ_WRITE_RX_CTL;
     transfer_request -> ux_transfer_request_type                =  UX_REQUEST_OUT | UX_REQUEST_TYPE_VENDOR | UX_REQUEST_TARGET_DEVICE;
     transfer_request -> ux_transfer_request_value               =  (UX_HOST_CLASS_ASIX_RXCR_AM | UX_HOST_CLASS_ASIX_RXCR_AB |
-                                                                    UX_HOST_CLASS_ASIX_RXCR_SO | UX_HOST_CLASS_ASIX_RXCR_MFB_2048);
+                                                                    UX_HOST_CLASS_ASIX_RXCR_SO | UX_HOST_CLASS_ASIX_RXCR_MFB);
     transfer_request -> ux_transfer_request_index               =  0;
 
     /* Send request to HCD layer.  */
@@ -59,6 +59,7 @@
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_utility_short_put                 Put 16-bit value              */
 /*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -85,6 +86,9 @@
 /*                                            fixed compile warnings,     */
 /*                                            improved 64-bit support,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_asix_transmission_callback (UX_TRANSFER *transfer_request)
@@ -190,6 +194,9 @@ ULONG                           copied;
         _ux_host_stack_transfer_request(transfer_request);
     }        
 
+    /* Log the transmit completion.  */
+    _ux_network_driver_packet_transmitted(asix -> ux_host_class_asix_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_NONE);
+
     /* Free the packet that was just sent.  First do some housekeeping.  */
     current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_ASIX_ETHERNET_SIZE; 
     current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_HOST_CLASS_ASIX_ETHERNET_SIZE;
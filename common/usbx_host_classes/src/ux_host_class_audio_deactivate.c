@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_audio_deactivate                     PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -56,6 +56,7 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_class_audio_ring_release     Release ring streaming        */
 /*    _ux_host_stack_class_instance_destroy Destroy class instance        */ 
 /*    _ux_host_stack_endpoint_transfer_abort Abort outstanding transfer   */ 
 /*    _ux_host_mutex_on                     Get mutex                     */
@@ -84,6 +85,9 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved AC AS management,  */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added ring streaming mode,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_audio_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -138,6 +142,11 @@ UINT                    i;
         /* We need to abort transactions on the iso pipe.  */
         if (audio -> ux_host_class_audio_isochronous_endpoint)
             _ux_host_stack_endpoint_transfer_abort(audio -> ux_host_class_audio_isochronous_endpoint);
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+
+        /* Free ring streaming resources.  */
+        _ux_host_class_audio_ring_release(audio);
+#endif
 #if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
     if (audio -> ux_host_class_audio_feedback_endpoint)
     {
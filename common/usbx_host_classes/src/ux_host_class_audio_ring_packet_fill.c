@@ -0,0 +1,167 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Audio Class                                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_audio.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_packet_fill               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function fills an OUT packet from ring. The number of frames   */
+/*    in packet is accumulated from the rate in 16.16 frames per packet.  */
+/*    The rate is from the feedback endpoint if it's available and sane,  */
+/*    otherwise it's the nominal rate of the sampling set. Missing data   */
+/*    is padded with silence and counted as xrun (underrun).              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_long_get                  Get 32-bit value              */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Audio Class                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+VOID  _ux_host_class_audio_ring_packet_fill(UX_HOST_CLASS_AUDIO *audio, UX_TRANSFER *transfer_request)
+{
+
+UX_HOST_CLASS_AUDIO_RING        *ring;
+UX_HOST_CLASS_AUDIO_RING_SLOT   *slot;
+UCHAR                           *buffer;
+ULONG                           rate;
+ULONG                           length;
+ULONG                           max_length;
+ULONG                           done;
+ULONG                           count;
+ULONG                           head;
+ULONG                           tail;
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+UCHAR                           *feedback;
+ULONG                           nominal_rate;
+ULONG                           feedback_rate;
+#endif
+
+
+    ring = &audio -> ux_host_class_audio_ring;
+    rate = ring -> ux_host_class_audio_ring_nominal_rate;
+
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+
+    /* Feedback in frames per (micro)frame, HS: 16.16, FS: 10.14 in 3 bytes.  */
+    if (audio -> ux_host_class_audio_feedback_endpoint != UX_NULL)
+    {
+        feedback = audio -> ux_host_class_audio_feedback_buffer;
+        if (_ux_host_class_audio_speed_get(audio) == UX_HIGH_SPEED_DEVICE)
+            feedback_rate = (ULONG)(((ULONG64)_ux_utility_long_get(feedback) * 8000) /
+                            audio -> ux_host_class_audio_packet_freq);
+        else
+            feedback_rate = (ULONG)((((ULONG64)feedback[0] | ((ULONG64)feedback[1] << 8) |
+                              ((ULONG64)feedback[2] << 16)) << 2) * 1000 /
+                            audio -> ux_host_class_audio_packet_freq);
+
+        /* Not received yet or out of range (+/-12.5%) feedback is ignored.  */
+        nominal_rate = ring -> ux_host_class_audio_ring_nominal_rate;
+        if ((feedback_rate > nominal_rate - (nominal_rate >> 3)) &&
+            (feedback_rate < nominal_rate + (nominal_rate >> 3)))
+            rate = feedback_rate;
+    }
+#endif
+    ring -> ux_host_class_audio_ring_rate = rate;
+
+    /* Accumulate frames, keep the fraction for next packets.  */
+    ring -> ux_host_class_audio_ring_rate_accumulator += rate;
+    length = (ring -> ux_host_class_audio_ring_rate_accumulator >> 16) * ring -> ux_host_class_audio_ring_frame_bytes;
+    ring -> ux_host_class_audio_ring_rate_accumulator &= 0xFFFFu;
+    max_length = transfer_request -> ux_transfer_request_packet_length;
+    max_length -= max_length % ring -> ux_host_class_audio_ring_frame_bytes;
+    if (length > max_length)
+        length = max_length;
+
+    /* Copy data from ring.  */
+    buffer = transfer_request -> ux_transfer_request_data_pointer;
+    head = ring -> ux_host_class_audio_ring_head;
+    tail = ring -> ux_host_class_audio_ring_tail;
+    done = 0;
+    while ((done < length) && (tail != head))
+    {
+        slot = (UX_HOST_CLASS_AUDIO_RING_SLOT *)(ring -> ux_host_class_audio_ring_buffer +
+                (tail & (ring -> ux_host_class_audio_ring_slots_nb - 1)) * ring -> ux_host_class_audio_ring_slot_size);
+        count = slot -> ux_host_class_audio_ring_slot_length - slot -> ux_host_class_audio_ring_slot_pos;
+        if (count > length - done)
+            count = length - done;
+        _ux_utility_memory_copy(buffer + done,
+                                slot -> ux_host_class_audio_ring_slot_data + slot -> ux_host_class_audio_ring_slot_pos,
+                                count); /* Use case of memcpy is verified. */
+        done += count;
+        slot -> ux_host_class_audio_ring_slot_pos += count;
+
+        /* Slot is free to write.  */
+        if (slot -> ux_host_class_audio_ring_slot_pos >= slot -> ux_host_class_audio_ring_slot_length)
+            tail ++;
+    }
+    ring -> ux_host_class_audio_ring_tail = tail;
+
+    /* Underrun, padded with silence (not counted while priming).  */
+    if (done < length)
+    {
+        _ux_utility_memory_set(buffer + done, 0, length - done); /* Use case of memset is verified. */
+        if (ring -> ux_host_class_audio_ring_state == UX_HOST_CLASS_AUDIO_RING_RUNNING)
+            ring -> ux_host_class_audio_ring_xruns ++;
+    }
+
+    transfer_request -> ux_transfer_request_requested_length = length;
+}
+#endif
@@ -0,0 +1,206 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Audio Class                                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_audio.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_read                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads data received in ring streaming mode. Data      */
+/*    is copied across packets, as much as available and fits in the      */
+/*    buffer. The frame number the first packet is received in is         */
+/*    returned as its time stamp. It does not block nor lock, the ring    */
+/*    is shared with completion by its head and tail indexes.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    buffer                                Buffer to fill                */
+/*    length                                Buffer length                 */
+/*    actual_length                         Pointer to save length read   */
+/*    frame_number                          Pointer to save frame number  */
+/*                                            of first packet (optional)  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_audio_ring_read(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                                     ULONG *actual_length, ULONG *frame_number)
+{
+#if !defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+    UX_PARAMETER_NOT_USED(audio);
+    UX_PARAMETER_NOT_USED(buffer);
+    UX_PARAMETER_NOT_USED(length);
+    UX_PARAMETER_NOT_USED(actual_length);
+    UX_PARAMETER_NOT_USED(frame_number);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_HOST_CLASS_AUDIO_RING        *ring;
+UX_HOST_CLASS_AUDIO_RING_SLOT   *slot;
+ULONG                           head;
+ULONG                           tail;
+ULONG                           done;
+ULONG                           count;
+
+
+    /* Nothing read yet.  */
+    *actual_length = 0;
+
+    /* Check state.  */
+    if (audio -> ux_host_class_audio_state != UX_HOST_CLASS_INSTANCE_LIVE)
+        return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
+    ring = &audio -> ux_host_class_audio_ring;
+    if (ring -> ux_host_class_audio_ring_state != UX_HOST_CLASS_AUDIO_RING_RUNNING)
+        return(UX_INVALID_STATE);
+
+    /* Check direction.  */
+    if ((audio -> ux_host_class_audio_isochronous_endpoint -> ux_endpoint_descriptor.bEndpointAddress &
+         UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_IN)
+        return(UX_ERROR);
+
+    /* No data.  */
+    head = ring -> ux_host_class_audio_ring_head;
+    tail = ring -> ux_host_class_audio_ring_tail;
+    if (head == tail)
+        return(UX_BUFFER_OVERFLOW);
+
+    done = 0;
+    while ((done < length) && (tail != head))
+    {
+        slot = (UX_HOST_CLASS_AUDIO_RING_SLOT *)(ring -> ux_host_class_audio_ring_buffer +
+                (tail & (ring -> ux_host_class_audio_ring_slots_nb - 1)) * ring -> ux_host_class_audio_ring_slot_size);
+
+        /* Time stamp of first packet.  */
+        if ((done == 0) && (frame_number != UX_NULL))
+            *frame_number = slot -> ux_host_class_audio_ring_slot_frame_number;
+
+        count = slot -> ux_host_class_audio_ring_slot_length - slot -> ux_host_class_audio_ring_slot_pos;
+        if (count > length - done)
+            count = length - done;
+        _ux_utility_memory_copy(buffer + done,
+                                slot -> ux_host_class_audio_ring_slot_data + slot -> ux_host_class_audio_ring_slot_pos,
+                                count); /* Use case of memcpy is verified. */
+        done += count;
+        slot -> ux_host_class_audio_ring_slot_pos += count;
+
+        /* Slot is free to receive.  */
+        if (slot -> ux_host_class_audio_ring_slot_pos >= slot -> ux_host_class_audio_ring_slot_length)
+        {
+            tail ++;
+            ring -> ux_host_class_audio_ring_tail = tail;
+        }
+    }
+
+    /* Return length read.  */
+    *actual_length = done;
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_class_audio_ring_read                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in audio ring read function             */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    buffer                                Buffer to fill                */
+/*    length                                Buffer length                 */
+/*    actual_length                         Pointer to save length read   */
+/*    frame_number                          Pointer to save frame number  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_read        Read from ring                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_class_audio_ring_read(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                                      ULONG *actual_length, ULONG *frame_number)
+{
+
+    /* Sanity checks.  */
+    if ((audio == UX_NULL) || (buffer == UX_NULL) || (actual_length == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke audio ring read function.  */
+    return(_ux_host_class_audio_ring_read(audio, buffer, length, actual_length, frame_number));
+}
@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Audio Class                                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_audio.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_release                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function stops ring streaming if it's running: the state is    */
+/*    changed so completion no longer re-arms transfers, the class owned  */
+/*    transfers are aborted and the ring memory is freed.                 */
+/*    Caller must protect the instance with its mutex.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request_abort                               */
+/*                                          Abort transfer                */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Audio Class                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+VOID  _ux_host_class_audio_ring_release(UX_HOST_CLASS_AUDIO *audio)
+{
+
+UX_HOST_CLASS_AUDIO_RING    *ring;
+ULONG                       i;
+
+
+    /* Check if ring is running.  */
+    ring = &audio -> ux_host_class_audio_ring;
+    if (ring -> ux_host_class_audio_ring_buffer == UX_NULL)
+        return;
+
+    /* No more re-arm from completion.  */
+    ring -> ux_host_class_audio_ring_state = UX_HOST_CLASS_AUDIO_RING_STOPPED;
+
+    /* Abort queued transfers.  */
+    for (i = 0; i < UX_HOST_CLASS_AUDIO_RING_TRANSFERS; i ++)
+        _ux_host_stack_transfer_request_abort(&ring -> ux_host_class_audio_ring_transfers[i]);
+
+    /* Free ring memory.  */
+    _ux_utility_memory_free(ring -> ux_host_class_audio_ring_transfer_buffer);
+    ring -> ux_host_class_audio_ring_transfer_buffer = UX_NULL;
+    _ux_utility_memory_free(ring -> ux_host_class_audio_ring_buffer);
+    ring -> ux_host_class_audio_ring_buffer = UX_NULL;
+}
+#endif
@@ -0,0 +1,286 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Audio Class                                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_audio.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_start                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function starts ring streaming on the audio streaming          */
+/*    interface, once the sampling is set. The class allocates the ring   */
+/*    slots and owns UX_HOST_CLASS_AUDIO_RING_TRANSFERS isochronous       */
+/*    transfers, which are queued at once and re-armed from completion.   */
+/*    Each slot holds one packet. For OUT stream the transfers are        */
+/*    primed with silence and the application fills the ring by           */
+/*    _ux_host_class_audio_ring_write. For IN stream the received         */
+/*    packets are read by _ux_host_class_audio_ring_read.                 */
+/*                                                                        */
+/*    The ring head and tail are free running counters, the number of     */
+/*    slots must be a power of 2 so that they still index the slots once  */
+/*    they wrap.                                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    frame_bytes                           Bytes per audio frame (all    */
+/*                                            channels of one sample)     */
+/*    slots_nb                              Number of ring slots, power   */
+/*                                            of 2                        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_packet_fill Fill OUT packet               */
+/*    _ux_host_class_audio_ring_release     Release ring                  */
+/*    _ux_host_stack_class_instance_verify  Verify instance is valid      */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_memory_allocate           Allocate memory               */
+/*    _ux_utility_memory_free               Free memory                   */
+/*    _ux_utility_memory_set                Set memory                    */
+/*    _ux_host_mutex_on                     Get mutex                     */
+/*    _ux_host_mutex_off                    Release mutex                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_audio_ring_start(UX_HOST_CLASS_AUDIO *audio, ULONG frame_bytes, ULONG slots_nb)
+{
+#if !defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+    UX_PARAMETER_NOT_USED(audio);
+    UX_PARAMETER_NOT_USED(frame_bytes);
+    UX_PARAMETER_NOT_USED(slots_nb);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_HOST_CLASS_AUDIO_RING    *ring;
+UX_ENDPOINT                 *endpoint;
+UX_TRANSFER                 *transfer_request;
+ULONG                       max_packet_size;
+ULONG                       slot_size;
+ULONG                       bytes_per_second;
+ULONG                       i;
+UINT                        status;
+
+
+    /* Ensure the instance is valid.  */
+    if (_ux_host_stack_class_instance_verify(_ux_system_host_class_audio_name, (VOID *) audio) != UX_SUCCESS)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_HOST_CLASS_INSTANCE_UNKNOWN);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_HOST_CLASS_INSTANCE_UNKNOWN, audio, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
+    }
+
+    /* Protect thread reentry to this instance.  */
+    _ux_host_mutex_on(&audio -> ux_host_class_audio_mutex);
+
+    /* Streaming must be started by sampling set.  */
+    endpoint = audio -> ux_host_class_audio_isochronous_endpoint;
+    if (endpoint == UX_NULL)
+    {
+        _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+        return(UX_ENDPOINT_HANDLE_UNKNOWN);
+    }
+
+    /* Ring must not be running.  */
+    ring = &audio -> ux_host_class_audio_ring;
+    if (ring -> ux_host_class_audio_ring_buffer != UX_NULL)
+    {
+        _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+        return(UX_ALREADY_ACTIVATED);
+    }
+
+    /* Check parameters, at least 2 slots so packets flow while one slot is accessed,
+       a power of 2 so the free running indexes are masked.  */
+    max_packet_size = endpoint -> ux_endpoint_transfer_request.ux_transfer_request_packet_length;
+    if ((frame_bytes == 0) || (frame_bytes > max_packet_size) ||
+        (slots_nb < 2) || (slots_nb & (slots_nb - 1)) ||
+        (audio -> ux_host_class_audio_packet_freq == 0))
+    {
+        _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+        return(UX_INVALID_PARAMETER);
+    }
+
+    /* Slot holds one packet after its header, 4 bytes aligned.  */
+    slot_size = (sizeof(UX_HOST_CLASS_AUDIO_RING_SLOT) - 4 + max_packet_size + 3) & ~3u;
+
+    /* Allocate the ring slots.  */
+    ring -> ux_host_class_audio_ring_buffer = _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN,
+                                                    UX_REGULAR_MEMORY, slots_nb, slot_size);
+    if (ring -> ux_host_class_audio_ring_buffer == UX_NULL)
+    {
+        _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+        return(UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* Allocate the transfers buffer, accessed by controller.  */
+    ring -> ux_host_class_audio_ring_transfer_buffer = _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN,
+                                    UX_CACHE_SAFE_MEMORY, UX_HOST_CLASS_AUDIO_RING_TRANSFERS, max_packet_size);
+    if (ring -> ux_host_class_audio_ring_transfer_buffer == UX_NULL)
+    {
+        _ux_utility_memory_free(ring -> ux_host_class_audio_ring_buffer);
+        ring -> ux_host_class_audio_ring_buffer = UX_NULL;
+        _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+        return(UX_MEMORY_INSUFFICIENT);
+    }
+
+    /* Reset ring.  */
+    ring -> ux_host_class_audio_ring_slot_size = slot_size;
+    ring -> ux_host_class_audio_ring_slots_nb = slots_nb;
+    ring -> ux_host_class_audio_ring_head = 0;
+    ring -> ux_host_class_audio_ring_tail = 0;
+    ring -> ux_host_class_audio_ring_frame_bytes = frame_bytes;
+    ring -> ux_host_class_audio_ring_rate_accumulator = 0;
+    ring -> ux_host_class_audio_ring_packets = 0;
+    ring -> ux_host_class_audio_ring_xruns = 0;
+
+    /* Nominal frames per packet in 16.16, from bytes per second set by sampling.  */
+    bytes_per_second = audio -> ux_host_class_audio_packet_size * audio -> ux_host_class_audio_packet_freq +
+                       audio -> ux_host_class_audio_packet_fraction;
+    ring -> ux_host_class_audio_ring_nominal_rate = (ULONG)(((ULONG64)bytes_per_second << 16) /
+                        ((ULONG64)frame_bytes * audio -> ux_host_class_audio_packet_freq));
+    ring -> ux_host_class_audio_ring_rate = ring -> ux_host_class_audio_ring_nominal_rate;
+
+    /* Prepare transfers, OUT packets are silence since ring is still empty.  */
+    for (i = 0; i < UX_HOST_CLASS_AUDIO_RING_TRANSFERS; i ++)
+    {
+        transfer_request = &ring -> ux_host_class_audio_ring_transfers[i];
+        _ux_utility_memory_set(transfer_request, 0, sizeof(UX_TRANSFER)); /* Use case of memset is verified. */
+        transfer_request -> ux_transfer_request_type =
+                        endpoint -> ux_endpoint_transfer_request.ux_transfer_request_type;
+        transfer_request -> ux_transfer_request_endpoint =              endpoint;
+        transfer_request -> ux_transfer_request_data_pointer =          ring -> ux_host_class_audio_ring_transfer_buffer +
+                                                                        i * max_packet_size;
+        transfer_request -> ux_transfer_request_requested_length =      max_packet_size;
+        transfer_request -> ux_transfer_request_packet_length =         max_packet_size;
+        transfer_request -> ux_transfer_request_completion_function =   _ux_host_class_audio_ring_transfer_completed;
+        transfer_request -> ux_transfer_request_class_instance =        audio;
+        if ((endpoint -> ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) == UX_ENDPOINT_OUT)
+            _ux_host_class_audio_ring_packet_fill(audio, transfer_request);
+    }
+
+    /* Queue all transfers, completion re-arms them.  */
+    ring -> ux_host_class_audio_ring_state = UX_HOST_CLASS_AUDIO_RING_RUNNING;
+    for (i = 0; i < UX_HOST_CLASS_AUDIO_RING_TRANSFERS; i ++)
+    {
+        status = _ux_host_stack_transfer_request(&ring -> ux_host_class_audio_ring_transfers[i]);
+        if (status != UX_SUCCESS)
+        {
+
+            /* Abort transfers started and free ring.  */
+            _ux_host_class_audio_ring_release(audio);
+            _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+            return(status);
+        }
+    }
+
+    /* Unprotect thread reentry to this instance.  */
+    _ux_host_mutex_off(&audio -> ux_host_class_audio_mutex);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_class_audio_ring_start                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in audio ring start function            */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    frame_bytes                           Bytes per audio frame         */
+/*    slots_nb                              Number of ring slots          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_start       Start ring streaming          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_class_audio_ring_start(UX_HOST_CLASS_AUDIO *audio, ULONG frame_bytes, ULONG slots_nb)
+{
+
+    /* Sanity check.  */
+    if (audio == UX_NULL)
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke audio ring start function.  */
+    return(_ux_host_class_audio_ring_start(audio, frame_bytes, slots_nb));
+}
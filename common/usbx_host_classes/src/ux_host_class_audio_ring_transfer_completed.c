@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Audio Class                                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_audio.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_transfer_completed        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the completion thread when a class       */
+/*    owned ring transfer is completed. For IN stream the packet is saved */
+/*    to ring with the frame number it's received in. For OUT stream the  */
+/*    next packet is filled from ring. Then the transfer is re-armed.     */
+/*    Lost packets, full ring on IN and empty ring on OUT are counted as  */
+/*    xruns. Nothing is re-armed once the ring is stopped or aborted.     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_packet_fill Fill OUT packet               */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*    (ux_hcd_entry_function)               Get frame number              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Audio Class                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+VOID  _ux_host_class_audio_ring_transfer_completed(UX_TRANSFER *transfer_request)
+{
+
+UX_HOST_CLASS_AUDIO             *audio;
+UX_HOST_CLASS_AUDIO_RING        *ring;
+UX_HOST_CLASS_AUDIO_RING_SLOT   *slot;
+UX_HCD                          *hcd;
+ULONG                           head;
+ULONG                           frame_number;
+
+
+    /* Get the class instance for this transfer request.  */
+    audio = (UX_HOST_CLASS_AUDIO *) transfer_request -> ux_transfer_request_class_instance;
+    ring = &audio -> ux_host_class_audio_ring;
+
+    /* Check state, transfer is not re-armed once stopped.  */
+    if ((ring -> ux_host_class_audio_ring_state != UX_HOST_CLASS_AUDIO_RING_RUNNING) ||
+        (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_STATUS_ABORT))
+        return;
+
+    ring -> ux_host_class_audio_ring_packets ++;
+
+    if ((transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_descriptor.bEndpointAddress &
+         UX_ENDPOINT_DIRECTION) == UX_ENDPOINT_IN)
+    {
+
+        /* Packet lost.  */
+        head = ring -> ux_host_class_audio_ring_head;
+        if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
+            ring -> ux_host_class_audio_ring_xruns ++;
+
+        /* Ring full, packet dropped (overrun).  */
+        else if (head - ring -> ux_host_class_audio_ring_tail >= ring -> ux_host_class_audio_ring_slots_nb)
+            ring -> ux_host_class_audio_ring_xruns ++;
+
+        /* Save packet with its time stamp (no empty packet in ring).  */
+        else if (transfer_request -> ux_transfer_request_actual_length)
+        {
+            slot = (UX_HOST_CLASS_AUDIO_RING_SLOT *)(ring -> ux_host_class_audio_ring_buffer +
+                    (head & (ring -> ux_host_class_audio_ring_slots_nb - 1)) * ring -> ux_host_class_audio_ring_slot_size);
+            _ux_utility_memory_copy(slot -> ux_host_class_audio_ring_slot_data,
+                                    transfer_request -> ux_transfer_request_data_pointer,
+                                    transfer_request -> ux_transfer_request_actual_length); /* Use case of memcpy is verified. */
+            slot -> ux_host_class_audio_ring_slot_length = transfer_request -> ux_transfer_request_actual_length;
+            slot -> ux_host_class_audio_ring_slot_pos = 0;
+
+            frame_number = 0;
+            hcd = UX_DEVICE_HCD_GET(audio -> ux_host_class_audio_device);
+            hcd -> ux_hcd_entry_function(hcd, UX_HCD_GET_FRAME_NUMBER, (VOID *) &frame_number);
+            slot -> ux_host_class_audio_ring_slot_frame_number = frame_number;
+
+            /* Slot is ready to read.  */
+            ring -> ux_host_class_audio_ring_head = head + 1;
+        }
+
+        transfer_request -> ux_transfer_request_requested_length = transfer_request -> ux_transfer_request_packet_length;
+    }
+    else
+    {
+
+        /* Fill next packet to send.  */
+        _ux_host_class_audio_ring_packet_fill(audio, transfer_request);
+    }
+
+    /* Issue the request again.  */
+    _ux_host_stack_transfer_request(transfer_request);
+}
+#endif
@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Audio Class                                                         */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_audio.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_write                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function writes data to send in ring streaming mode. Data is   */
+/*    split into slots of max packet size, packets are then built from    */
+/*    ring data by the rate of the stream. Each call uses at least one    */
+/*    slot so the data should be written in blocks close to packet size.  */
+/*    It does not block nor lock, the ring is shared with completion by   */
+/*    its head and tail indexes.                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    buffer                                Data to write                 */
+/*    length                                Data length                   */
+/*    actual_length                         Pointer to save length written*/
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_audio_ring_write(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                                      ULONG *actual_length)
+{
+#if !defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+    UX_PARAMETER_NOT_USED(audio);
+    UX_PARAMETER_NOT_USED(buffer);
+    UX_PARAMETER_NOT_USED(length);
+    UX_PARAMETER_NOT_USED(actual_length);
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_HOST_CLASS_AUDIO_RING        *ring;
+UX_HOST_CLASS_AUDIO_RING_SLOT   *slot;
+UX_ENDPOINT                     *endpoint;
+ULONG                           head;
+ULONG                           done;
+ULONG                           count;
+
+
+    /* Nothing written yet.  */
+    *actual_length = 0;
+
+    /* Check state.  */
+    if (audio -> ux_host_class_audio_state != UX_HOST_CLASS_INSTANCE_LIVE)
+        return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
+    ring = &audio -> ux_host_class_audio_ring;
+    if (ring -> ux_host_class_audio_ring_state != UX_HOST_CLASS_AUDIO_RING_RUNNING)
+        return(UX_INVALID_STATE);
+
+    /* Check direction.  */
+    endpoint = audio -> ux_host_class_audio_isochronous_endpoint;
+    if ((endpoint -> ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_OUT)
+        return(UX_ERROR);
+
+    head = ring -> ux_host_class_audio_ring_head;
+    done = 0;
+    while (done < length)
+    {
+
+        /* Ring full (overrun).  */
+        if (head - ring -> ux_host_class_audio_ring_tail >= ring -> ux_host_class_audio_ring_slots_nb)
+            break;
+
+        slot = (UX_HOST_CLASS_AUDIO_RING_SLOT *)(ring -> ux_host_class_audio_ring_buffer +
+                (head & (ring -> ux_host_class_audio_ring_slots_nb - 1)) * ring -> ux_host_class_audio_ring_slot_size);
+        count = endpoint -> ux_endpoint_transfer_request.ux_transfer_request_packet_length;
+        if (count > length - done)
+            count = length - done;
+        _ux_utility_memory_copy(slot -> ux_host_class_audio_ring_slot_data, buffer + done, count); /* Use case of memcpy is verified. */
+        slot -> ux_host_class_audio_ring_slot_length = count;
+        slot -> ux_host_class_audio_ring_slot_pos = 0;
+        done += count;
+
+        /* Slot is ready to send.  */
+        head ++;
+        ring -> ux_host_class_audio_ring_head = head;
+    }
+
+    /* Return length written.  */
+    *actual_length = done;
+    return((done < length) ? UX_BUFFER_OVERFLOW : UX_SUCCESS);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_class_audio_ring_write                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in audio ring write function            */
+/*    call.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    audio                                 Pointer to audio class        */
+/*    buffer                                Data to write                 */
+/*    length                                Data length                   */
+/*    actual_length                         Pointer to save length written*/
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_audio_ring_write       Write to ring                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_class_audio_ring_write(UX_HOST_CLASS_AUDIO *audio, UCHAR *buffer, ULONG length,
+                                       ULONG *actual_length)
+{
+
+    /* Sanity checks.  */
+    if ((audio == UX_NULL) || (buffer == UX_NULL) || (actual_length == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke audio ring write function.  */
+    return(_ux_host_class_audio_ring_write(audio, buffer, length, actual_length));
+}
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_audio_stop                           PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -54,6 +54,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _ux_host_class_audio_ring_release     Release ring streaming        */
 /*    _ux_host_stack_endpoint_transfer_abort                              */
 /*                                          Abort transfer                */
 /*    _ux_host_stack_interface_setting_select                             */
@@ -70,6 +71,9 @@
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  07-29-2022     Chaoqiong Xiao           Initial Version 6.1.12        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added ring streaming mode,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_audio_stop(UX_HOST_CLASS_AUDIO *audio)
@@ -100,6 +104,12 @@ UINT                    streaming_interface;
     /* Get the interface number of the audio streaming interface.  */
     streaming_interface =  audio -> ux_host_class_audio_streaming_interface -> ux_interface_descriptor.bInterfaceNumber;
 
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+
+    /* Stop ring streaming if it's running.  */
+    _ux_host_class_audio_ring_release(audio);
+#endif
+
     /* We need to abort transactions on the ISO pipes.  */
     if (audio -> ux_host_class_audio_isochronous_endpoint != UX_NULL)
     {
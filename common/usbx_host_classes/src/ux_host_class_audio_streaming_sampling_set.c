@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_audio_streaming_sampling_set         PORTABLE C      */
-/*                                                           6.2.1        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,7 @@
 /*                                                                        */
 /*    _ux_host_class_audio_alternate_setting_locate                       */
 /*                                          Locate alternate setting      */
+/*    _ux_host_class_audio_ring_release     Release ring streaming        */
 /*    _ux_host_stack_class_instance_verify  Verify instance is valid      */
 /*    _ux_host_stack_interface_endpoint_get Get interface endpoint        */
 /*    _ux_host_stack_interface_setting_select Select interface            */
@@ -99,6 +100,9 @@
 /*  03-08-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved frequency check,   */
 /*                                            resulting in version 6.2.1  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added ring streaming mode,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_audio_streaming_sampling_set(UX_HOST_CLASS_AUDIO *audio, UX_HOST_CLASS_AUDIO_SAMPLING *audio_sampling)
@@ -127,6 +131,12 @@ ULONG                   res_bytes;
     /* Protect thread reentry to this instance.  */
     _ux_host_mutex_on(&audio -> ux_host_class_audio_mutex);
 
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+
+    /* Stop ring streaming on current setting.  */
+    _ux_host_class_audio_ring_release(audio);
+#endif
+
     /* Find the correct alternate setting for the sampling desired.  */
     status =  _ux_host_class_audio_alternate_setting_locate(audio, audio_sampling, &alternate_setting);
 
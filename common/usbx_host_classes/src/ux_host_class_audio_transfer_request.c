@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_audio_transfer_request               PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -72,6 +72,9 @@
 /*  07-29-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined transfer implement, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added streaming statistics, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_audio_transfer_request(UX_HOST_CLASS_AUDIO *audio,
@@ -113,11 +116,29 @@ UX_TRANSFER     *transfer_request;
     if (audio -> ux_host_class_audio_head_transfer_request == UX_NULL)
         audio -> ux_host_class_audio_head_transfer_request =  audio_transfer_request;
 
+#if defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+    /* Count it pending before it could complete.  */
+    audio -> ux_host_class_audio_pending_transfers ++;
+#endif
+
     UX_RESTORE
 
     /* Transfer the transfer request (queued in lower level).  */
     status =  _ux_host_stack_transfer_request(transfer_request);
 
+#if defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+    /* Not queued, no completion.  */
+    if (status != UX_SUCCESS)
+    {
+        UX_DISABLE
+        if (audio -> ux_host_class_audio_pending_transfers > 0)
+            audio -> ux_host_class_audio_pending_transfers --;
+        UX_RESTORE
+    }
+#endif
+
     /* Return completion status.  */
     return(status);
 }
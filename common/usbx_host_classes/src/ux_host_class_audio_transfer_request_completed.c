@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_audio_transfer_request_completed     PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,7 @@
 /*                                                                        */ 
 /*    (ux_host_class_audio_transfer_request_completion_function)          */ 
 /*                                          Transfer request completion   */ 
+/*    _ux_utility_long_get                  Get 32-bit value              */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -69,12 +70,31 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added streaming statistics, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_audio_transfer_request_completed(UX_TRANSFER *transfer_request)
 {
 
 UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST     *audio_transfer_request;
+#if defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+UX_HOST_CLASS_AUDIO                      *audio;
+UX_HOST_CLASS_AUDIO_STATISTICS           *statistics;
+#if UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS > 0
+UX_HOST_CLASS_AUDIO_STATISTICS_RECORD    *record;
+#endif
+UX_HCD                                   *hcd;
+ULONG                                    frame_number;
+ULONG                                    time;
+ULONG                                    interval;
+ULONG                                    level;
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+UCHAR                                    *feedback_buffer;
+ULONG                                    feedback;
+#endif
+#endif
     
 
     /* Get the pointer to the audio specific transfer request, by nature of the lined transfer requests,
@@ -88,6 +108,100 @@ UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST     *audio_transfer_request;
     /* The caller's transfer request needs to be updated.  */
     audio_transfer_request -> ux_host_class_audio_transfer_request_actual_length =    transfer_request -> ux_transfer_request_actual_length;
     audio_transfer_request -> ux_host_class_audio_transfer_request_completion_code =  transfer_request -> ux_transfer_request_completion_code;
+
+#if defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+    /* Get the class instance for this transfer request.  */
+    audio = (UX_HOST_CLASS_AUDIO *) transfer_request -> ux_transfer_request_class_instance;
+    statistics = &audio -> ux_host_class_audio_statistics;
+
+    /* Request no longer pending.  */
+    level = audio -> ux_host_class_audio_pending_transfers;
+    if (level > 0)
+        level --;
+    audio -> ux_host_class_audio_pending_transfers = level;
+
+    /* Aborted requests are not streamed.  */
+    if (transfer_request -> ux_transfer_request_completion_code != UX_TRANSFER_STATUS_ABORT)
+    {
+
+        /* Time stamps of completion.  */
+        time = UX_HOST_CLASS_AUDIO_STATISTICS_TIME_GET();
+        frame_number = 0;
+        hcd = UX_DEVICE_HCD_GET(audio -> ux_host_class_audio_device);
+        hcd -> ux_hcd_entry_function(hcd, UX_HCD_GET_FRAME_NUMBER, (VOID *) &frame_number);
+        statistics -> ux_host_class_audio_statistics_frame_number = frame_number;
+
+        /* Interval from previous completion (unsigned difference handles wrap).  */
+        if (statistics -> ux_host_class_audio_statistics_transfers > 0)
+        {
+            interval = time - statistics -> ux_host_class_audio_statistics_time;
+            if (statistics -> ux_host_class_audio_statistics_transfers == 1 ||
+                interval < statistics -> ux_host_class_audio_statistics_interval_min)
+                statistics -> ux_host_class_audio_statistics_interval_min = interval;
+            if (interval > statistics -> ux_host_class_audio_statistics_interval_max)
+                statistics -> ux_host_class_audio_statistics_interval_max = interval;
+            statistics -> ux_host_class_audio_statistics_interval_sum += interval;
+        }
+        statistics -> ux_host_class_audio_statistics_time = time;
+
+        /* Pending requests level.  */
+        if (statistics -> ux_host_class_audio_statistics_transfers == 0 ||
+            level < statistics -> ux_host_class_audio_statistics_level_min)
+            statistics -> ux_host_class_audio_statistics_level_min = level;
+        if (level > statistics -> ux_host_class_audio_statistics_level_max)
+            statistics -> ux_host_class_audio_statistics_level_max = level;
+        statistics -> ux_host_class_audio_statistics_level = level;
+        statistics -> ux_host_class_audio_statistics_level_histogram[
+                        (level < UX_HOST_CLASS_AUDIO_STATISTICS_LEVELS) ?
+                        level : (UX_HOST_CLASS_AUDIO_STATISTICS_LEVELS - 1)] ++;
+
+        /* Xrun: packet lost, or no request left to stream next packets.  */
+        if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS || level == 0)
+        {
+            statistics -> ux_host_class_audio_statistics_xruns ++;
+            statistics -> ux_host_class_audio_statistics_xrun_time = time;
+        }
+
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+
+        /* Feedback, as encoded: 3 bytes 10.14 or 4 bytes 16.16.  */
+        if (audio -> ux_host_class_audio_feedback_endpoint != UX_NULL)
+        {
+            feedback_buffer = audio -> ux_host_class_audio_feedback_buffer;
+            if (_ux_host_class_audio_speed_get(audio) == UX_HIGH_SPEED_DEVICE)
+                feedback = _ux_utility_long_get(feedback_buffer);
+            else
+                feedback = (ULONG)feedback_buffer[0] | ((ULONG)feedback_buffer[1] << 8) | ((ULONG)feedback_buffer[2] << 16);
+            if (feedback != 0)
+            {
+                if (statistics -> ux_host_class_audio_statistics_feedback_min == 0 ||
+                    feedback < statistics -> ux_host_class_audio_statistics_feedback_min)
+                    statistics -> ux_host_class_audio_statistics_feedback_min = feedback;
+                if (feedback > statistics -> ux_host_class_audio_statistics_feedback_max)
+                    statistics -> ux_host_class_audio_statistics_feedback_max = feedback;
+            }
+            statistics -> ux_host_class_audio_statistics_feedback = feedback;
+        }
+#endif
+
+#if UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS > 0
+
+        /* Record this completion, overwriting the oldest one.  */
+        record = &statistics -> ux_host_class_audio_statistics_records[
+                        statistics -> ux_host_class_audio_statistics_transfers &
+                        (UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+        record -> ux_host_class_audio_statistics_record_time = time;
+        record -> ux_host_class_audio_statistics_record_frame_number = frame_number;
+        record -> ux_host_class_audio_statistics_record_length = transfer_request -> ux_transfer_request_actual_length;
+        record -> ux_host_class_audio_statistics_record_level = level;
+#endif
+
+        /* Request done.  */
+        statistics -> ux_host_class_audio_statistics_transfers ++;
+        statistics -> ux_host_class_audio_statistics_bytes += transfer_request -> ux_transfer_request_actual_length;
+    }
+#endif
     
     /* Call the completion routine.  */
     audio_transfer_request -> ux_host_class_audio_transfer_request_completion_function(audio_transfer_request);
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_acm_deactivate                   PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,6 +63,7 @@
 /*    _ux_host_semaphore_get                Get protection semaphore      */ 
 /*    _ux_host_semaphore_delete             Delete protection semaphore   */ 
 /*    _ux_utility_thread_schedule_other     Schedule other threads        */
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -78,6 +79,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            reception streaming mode,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_acm_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -87,6 +91,9 @@ UX_HOST_CLASS_CDC_ACM       *cdc_acm;
 UX_TRANSFER                 *transfer_request;
 #if !defined(UX_HOST_STANDALONE)
 UINT                        status;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UX_HOST_CLASS_CDC_ACM_RECEPTION *cdc_acm_reception;
+#endif
 #else
 UX_HOST_CLASS_CDC_ACM       *cdc_acm_inst;
 #endif
@@ -160,6 +167,18 @@ UX_HOST_CLASS_CDC_ACM       *cdc_acm_inst;
             /* We need to abort transactions on the bulk In pipe.  */
             _ux_host_stack_endpoint_transfer_abort(cdc_acm -> ux_host_class_cdc_acm_bulk_in_endpoint);
     
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+        /* A streaming reception has its transfers on the bulk In pipe, free them.  */
+        cdc_acm_reception =  cdc_acm -> ux_host_class_cdc_acm_reception;
+        if ((cdc_acm_reception != UX_NULL) &&
+            (cdc_acm_reception -> ux_host_class_cdc_acm_reception_transfer_count != 0))
+        {
+            cdc_acm_reception -> ux_host_class_cdc_acm_reception_state =  UX_HOST_CLASS_CDC_ACM_RECEPTION_STATE_STOPPED;
+            _ux_host_class_serial_stream_stop(&cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream);
+        }
+#endif
+
         /* Then endpoint OUT.  */       
         transfer_request =  &cdc_acm -> ux_host_class_cdc_acm_bulk_out_endpoint -> ux_endpoint_transfer_request;
         if (transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_STATUS_PENDING)
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_acm_read                         PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -77,6 +77,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added statistics,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_acm_read (UX_HOST_CLASS_CDC_ACM *cdc_acm, UCHAR *data_pointer, 
@@ -204,6 +207,13 @@ ULONG           transfer_flags;
 
         /* Update the length of the transfer. Normally all the data has to be received.  */
         *actual_length +=  transfer_request -> ux_transfer_request_actual_length;
+
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+
+        /* Update statistics.  */
+        cdc_acm -> ux_host_class_cdc_acm_statistics.ux_host_class_serial_statistics_rx_bytes +=
+                                    transfer_request -> ux_transfer_request_actual_length;
+#endif
         
         /* Check for completion of transfer. If the transfer is partial, return to caller.
            The transfer is marked as successful but the caller will need to check the length
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_cdc_acm_reception_callback           PORTABLE C      */
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -46,6 +46,11 @@
 /*    it is called when a full or partial transfer has been done for a    */
 /*    bulk in transfer. It calls back the application.                    */
 /*                                                                        */
+/*    In streaming mode, the block received is kept for the application  */
+/*    and transfers are armed on free blocks. When no block is free, an   */
+/*    overflow is counted and reported, the reception goes on when the    */
+/*    application releases data.                                          */
+/*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    transfer_request                      Pointer to transfer request   */
@@ -57,6 +62,9 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_host_class_serial_stream_completed                              */
+/*                                          Complete stream transfer      */
+/*    _ux_host_class_serial_stream_arm      Arm stream transfers          */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -69,6 +77,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            reception streaming mode,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_acm_reception_callback (UX_TRANSFER *transfer_request)
@@ -76,6 +87,9 @@ VOID  _ux_host_class_cdc_acm_reception_callback (UX_TRANSFER *transfer_request)
 
 UX_HOST_CLASS_CDC_ACM               *cdc_acm;
 UX_HOST_CLASS_CDC_ACM_RECEPTION     *cdc_acm_reception;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UINT                                status;
+#endif
 
     /* Get the class instance for this transfer request.  */
     cdc_acm =  (UX_HOST_CLASS_CDC_ACM *) transfer_request -> ux_transfer_request_class_instance;
@@ -83,6 +97,45 @@ UX_HOST_CLASS_CDC_ACM_RECEPTION     *cdc_acm_reception;
     /* Get the pointer to the acm reception structure.  */
     cdc_acm_reception =  cdc_acm -> ux_host_class_cdc_acm_reception;
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Stream transfers are not the endpoint transfer request, they point to their reception.  */
+    if (transfer_request != &cdc_acm -> ux_host_class_cdc_acm_bulk_in_endpoint -> ux_endpoint_transfer_request)
+    {
+
+        /* Keep the block received for the application.  */
+        cdc_acm_reception =  (UX_HOST_CLASS_CDC_ACM_RECEPTION *) transfer_request -> ux_transfer_request_user_specific;
+        status =  _ux_host_class_serial_stream_completed(&cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream, transfer_request);
+
+        /* If there is an error or the reception is stopped, we do not proceed.  */
+        if ((status != UX_SUCCESS) && (status != UX_BUFFER_OVERFLOW))
+        {
+
+            /* The reception is stopped.  */
+            cdc_acm_reception -> ux_host_class_cdc_acm_reception_state =  UX_HOST_CLASS_CDC_ACM_RECEPTION_STATE_STOPPED;
+            return;
+        }
+
+        /* Report the data received to the application, it stays in the buffer until released.  */
+        if (cdc_acm_reception -> ux_host_class_cdc_acm_reception_callback != UX_NULL)
+        {
+            cdc_acm_reception -> ux_host_class_cdc_acm_reception_callback(cdc_acm, UX_SUCCESS,
+                                                                    transfer_request -> ux_transfer_request_data_pointer,
+                                                                    transfer_request -> ux_transfer_request_actual_length);
+
+            /* Report the overflow, the reception goes on when data is released.  */
+            if (status == UX_BUFFER_OVERFLOW)
+                cdc_acm_reception -> ux_host_class_cdc_acm_reception_callback(cdc_acm, UX_BUFFER_OVERFLOW, UX_NULL, 0);
+        }
+
+        /* Arm transfers on free blocks.  */
+        _ux_host_class_serial_stream_arm(&cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream);
+
+        /* There is no status to be reported back to the stack.  */
+        return;
+    }
+#endif
+
     /* Check the state of the transfer.  If there is an error, we do not proceed with this report.  */
     if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
     {
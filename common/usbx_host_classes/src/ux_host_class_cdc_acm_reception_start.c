@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_acm_reception_start              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -48,6 +48,11 @@
 /*    application callback function is invoked and a new transfer request */
 /*    is rescheduled.                                                     */
 /*                                                                        */
+/*    If the transfer count of the reception is not 0, the reception is   */
+/*    streaming: that many block-sized transfers are kept outstanding on  */
+/*    the free blocks of the buffer, and received data is kept until the  */
+/*    application releases it.                                            */
+/*                                                                        */
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    cdc_acm                               Pointer to cdc_acm class      */ 
@@ -60,6 +65,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
+/*    _ux_host_class_serial_stream_start    Start serial stream           */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -72,6 +78,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            reception streaming mode,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_acm_reception_start (UX_HOST_CLASS_CDC_ACM *cdc_acm, 
@@ -111,6 +120,43 @@ UINT            status;
         return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
     }
     
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Check if the reception is streaming.  */
+    if (cdc_acm_reception -> ux_host_class_cdc_acm_reception_transfer_count != 0)
+    {
+
+        /* Completions may be notified through an event flags group shared with other ports.  */
+        cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_event_flags_group =
+                                    cdc_acm_reception -> ux_host_class_cdc_acm_reception_event_flags_group;
+        cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_event_flags =
+                                    cdc_acm_reception -> ux_host_class_cdc_acm_reception_event_flags;
+
+        /* Start the stream on the bulk in endpoint, the transfers point to this reception.  */
+        status =  _ux_host_class_serial_stream_start(&cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream,
+                                    cdc_acm -> ux_host_class_cdc_acm_bulk_in_endpoint,
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+                                    &cdc_acm -> ux_host_class_cdc_acm_statistics,
+#else
+                                    UX_NULL,
+#endif
+                                    cdc_acm_reception -> ux_host_class_cdc_acm_reception_data_buffer,
+                                    cdc_acm_reception -> ux_host_class_cdc_acm_reception_data_buffer_size,
+                                    cdc_acm_reception -> ux_host_class_cdc_acm_reception_block_size,
+                                    cdc_acm_reception -> ux_host_class_cdc_acm_reception_transfer_count,
+                                    _ux_host_class_cdc_acm_reception_callback, (VOID *) cdc_acm, (VOID *) cdc_acm_reception);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        /* Save the acm reception structure in the acm structure.  */
+        cdc_acm -> ux_host_class_cdc_acm_reception = cdc_acm_reception;
+
+        /* And declare we have transfers in progress.  */
+        cdc_acm_reception -> ux_host_class_cdc_acm_reception_state =  UX_HOST_CLASS_CDC_ACM_RECEPTION_STATE_STARTED;
+        return(UX_SUCCESS);
+    }
+#endif
+
     /* Start by aligning the head and tail of buffers to the same address supplied by the application.  */
     cdc_acm_reception -> ux_host_class_cdc_acm_reception_data_head =  cdc_acm_reception -> ux_host_class_cdc_acm_reception_data_buffer;
     cdc_acm_reception -> ux_host_class_cdc_acm_reception_data_tail =  cdc_acm_reception -> ux_host_class_cdc_acm_reception_data_buffer;
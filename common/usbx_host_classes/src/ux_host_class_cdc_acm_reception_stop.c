@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_cdc_acm_reception_stop               PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -59,6 +59,7 @@
 /*    _ux_host_stack_endpoint_transfer_abort                              */
 /*                                          Abort transfer                */
 /*    _ux_host_semaphore_get                Get semaphore                 */
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -74,6 +75,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            reception streaming mode,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_acm_reception_stop(UX_HOST_CLASS_CDC_ACM *cdc_acm, 
@@ -112,6 +116,21 @@ UX_TRANSFER              *transfer_request;
         return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
     }
     
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* A streaming reception frees its transfer requests, they may be left after an error.  */
+    if ((cdc_acm_reception -> ux_host_class_cdc_acm_reception_transfer_count != 0) &&
+        (cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_transfer_requests != UX_NULL))
+    {
+
+        /* Declare the reception stopped, the aborted transfers are not reported.  */
+        cdc_acm_reception -> ux_host_class_cdc_acm_reception_state =  UX_HOST_CLASS_CDC_ACM_RECEPTION_STATE_STOPPED;
+
+        /* Abort and free the transfers on the bulk In pipe.  */
+        return(_ux_host_class_serial_stream_stop(&cdc_acm_reception -> ux_host_class_cdc_acm_reception_stream));
+    }
+#endif
+
     /* Check if we do have transfers for this application. If none, nothing to do. */
     if (cdc_acm_reception -> ux_host_class_cdc_acm_reception_state ==  UX_HOST_CLASS_CDC_ACM_RECEPTION_STATE_STOPPED)
         return(UX_SUCCESS);
@@ -108,6 +108,11 @@ UX_HOST_CLASS_CDC_ECM_NX_ETHERNET_POOL_ALLOCSIZE_ASSERT
 /*                                            rejected the CDC ECM data   */
 /*                                            interface not next to ctrl, */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            bulk IN transfer ring,      */
+/*                                            added bulk OUT transfer     */
+/*                                            ring, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_ecm_activate(UX_HOST_CLASS_COMMAND *command)
@@ -121,6 +126,9 @@ ULONG                               physical_address_msw = 0;
 ULONG                               physical_address_lsw = 0;
 UX_INTERFACE                        *control_interface;
 UX_INTERFACE                        *cur_interface;
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING) || defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+ULONG                               slot;
+#endif
 
     /* The CDC ECM class is always activated by the interface descriptor and not the
        device descriptor.  */
@@ -222,6 +230,69 @@ UX_INTERFACE                        *cur_interface;
             status =  UX_MEMORY_INSUFFICIENT;
     }
 
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+    if (status == UX_SUCCESS)
+    {
+
+        /* Initialize the bulk IN transfer ring, all slots are on the bulk IN endpoint.  */
+        for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT; slot ++)
+        {
+            transfer_request =  &cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot];
+            transfer_request -> ux_transfer_request_endpoint =          cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_endpoint;
+            transfer_request -> ux_transfer_request_type =              UX_REQUEST_IN;
+            transfer_request -> ux_transfer_request_packet_length =
+                    cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_packet_length;
+            transfer_request -> ux_transfer_request_timeout_value =
+                    cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_timeout_value;
+            transfer_request -> ux_transfer_request_class_instance =    (VOID *) cdc_ecm;
+            transfer_request -> ux_transfer_request_completion_function =  _ux_host_class_cdc_ecm_reception_callback;
+
+            /* The HCD puts the semaphore of each completed request.  */
+            status =  _ux_host_semaphore_create(&transfer_request -> ux_transfer_request_semaphore,
+                                                "host CDC-ECM bulk in ring semaphore", 0);
+            if (status != UX_SUCCESS)
+                break;
+        }
+    }
+#endif
+
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+    if (status == UX_SUCCESS)
+    {
+
+        /* Initialize the bulk OUT transfer ring, all slots are on the bulk OUT endpoint.  */
+        for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT; slot ++)
+        {
+            transfer_request =  &cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot];
+            transfer_request -> ux_transfer_request_endpoint =          cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_endpoint;
+            transfer_request -> ux_transfer_request_type =              UX_REQUEST_OUT;
+            transfer_request -> ux_transfer_request_packet_length =
+                    cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_packet_length;
+            transfer_request -> ux_transfer_request_timeout_value =
+                    cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_timeout_value;
+            transfer_request -> ux_transfer_request_class_instance =    (VOID *) cdc_ecm;
+            transfer_request -> ux_transfer_request_completion_function =  _ux_host_class_cdc_ecm_transmission_callback;
+
+            /* The HCD puts the semaphore of each completed request.  */
+            status =  _ux_host_semaphore_create(&transfer_request -> ux_transfer_request_semaphore,
+                                                "host CDC-ECM bulk out ring semaphore", 0);
+            if (status != UX_SUCCESS)
+                break;
+        }
+    }
+#ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
+    if (status == UX_SUCCESS)
+    {
+
+        /* Each slot has its buffer for chained packets, it can't be allocated in the callback.  */
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_CACHE_SAFE_MEMORY,
+                                            UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT, UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE);
+        if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer == UX_NULL)
+            status =  UX_MEMORY_INSUFFICIENT;
+    }
+#endif
+#endif
+
     if (status == UX_SUCCESS)
     {
 
@@ -367,6 +438,26 @@ UX_INTERFACE                        *cur_interface;
     if (cdc_ecm -> ux_host_class_cdc_ecm_thread_stack != UX_NULL)
         _ux_utility_memory_free(cdc_ecm -> ux_host_class_cdc_ecm_thread_stack);
 
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT; slot ++)
+    {
+        if (_ux_host_semaphore_created(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot].ux_transfer_request_semaphore))
+            _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot].ux_transfer_request_semaphore);
+    }
+#endif
+
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT; slot ++)
+    {
+        if (_ux_host_semaphore_created(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot].ux_transfer_request_semaphore))
+            _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot].ux_transfer_request_semaphore);
+    }
+#ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
+    if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer != UX_NULL)
+        _ux_utility_memory_free(cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer);
+#endif
+#endif
+
     _ux_utility_memory_free(cdc_ecm);
     
     /* Return completion status.  */
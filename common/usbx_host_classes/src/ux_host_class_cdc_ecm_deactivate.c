@@ -63,6 +63,8 @@
 /*    _ux_utility_memory_free               Free memory block             */ 
 /*    _ux_host_semaphore_get                Get protection semaphore      */ 
 /*    _ux_host_semaphore_delete             Delete protection semaphore   */ 
+/*    _ux_host_class_cdc_ecm_reception_ring_abort                         */
+/*                                          Abort bulk IN transfer ring   */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -93,6 +95,11 @@
 /*                                            deprecated ECM pool option, */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            bulk IN transfer ring,      */
+/*                                            added bulk OUT transfer     */
+/*                                            ring, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_ecm_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -102,6 +109,9 @@ UX_INTERRUPT_SAVE_AREA
 
 UX_HOST_CLASS_CDC_ECM       *cdc_ecm;
 UX_TRANSFER                 *transfer_request;
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING) || defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+ULONG                       slot;
+#endif
 
     /* This must be the data interface, since the control interface doesn't have
        a class instance.  */
@@ -169,6 +179,12 @@ UX_TRANSFER                 *transfer_request;
     /* Now we can abort the transfer.  */
     _ux_host_stack_transfer_request_abort(transfer_request);
 
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+
+    /* Abort the reception ring too, packets are released by the callback.  */
+    _ux_host_class_cdc_ecm_reception_ring_abort(cdc_ecm);
+#endif
+
     /* De-register this interface to the NetX USB interface broker.  */
     _ux_network_driver_deactivate((VOID *) cdc_ecm, cdc_ecm -> ux_host_class_cdc_ecm_network_handle);
 
@@ -193,6 +209,20 @@ UX_TRANSFER                 *transfer_request;
     _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_waiting_for_check_and_arm_to_finish_semaphore);
     _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_waiting_for_check_and_arm_to_finish_semaphore);
 
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+
+    /* Destroy the reception ring semaphores.  */
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT; slot ++)
+        _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot].ux_transfer_request_semaphore);
+#endif
+
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+
+    /* Destroy the transmission ring semaphores.  */
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT; slot ++)
+        _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot].ux_transfer_request_semaphore);
+#endif
+
     /* Destroy the notification semaphore.  */
     _ux_host_semaphore_delete(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
 
@@ -55,7 +55,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    None                                                                */
+/*    _ux_host_class_cdc_ecm_reception_ring_abort                         */
+/*                                          Abort bulk IN transfer ring   */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -74,6 +75,9 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            bulk IN transfer ring,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_interrupt_notification(UX_TRANSFER *transfer_request)
@@ -163,6 +167,9 @@ ULONG                                       notification_value;
 
                 /* Now we can abort the transfer.  */
                 _ux_host_stack_transfer_request_abort(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_endpoint -> ux_endpoint_transfer_request);
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+                _ux_host_class_cdc_ecm_reception_ring_abort(cdc_ecm);
+#endif
 
                 /* We need to inform the CDC-ECM thread of this change.  */
                 _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
@@ -0,0 +1,164 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   CDC_ECM Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_cdc_ecm_reception_callback           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is the callback from the USBX transfer functions, it  */
+/*    is called when a transfer request of the bulk IN reception ring is  */
+/*    completed or aborted.                                               */
+/*                                                                        */
+/*    A received frame is passed to the NetX-USB broker and the transfer  */
+/*    request is re-armed at once with a new packet. If no packet is      */
+/*    available the CDC ECM thread is woken up to re-arm the ring when    */
+/*    packets are released.                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request       Transfer request              */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_network_driver_packet_received    Process received packet       */
+/*    _ux_network_driver_packet_lend        Lend NetX packet              */
+/*    nx_packet_release                     Free NetX packet              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HCD when a transfer request completes                               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_cdc_ecm_reception_callback(UX_TRANSFER *transfer_request)
+{
+
+UX_HOST_CLASS_CDC_ECM       *cdc_ecm;
+NX_PACKET                   *packet;
+UINT                        status;
+
+
+    /* Get the class instance for this transfer request.  */
+    cdc_ecm =  (UX_HOST_CLASS_CDC_ECM *) transfer_request -> ux_transfer_request_class_instance;
+
+    /* Get the packet that owns this transaction.  */
+    packet =  (NX_PACKET *) transfer_request -> ux_transfer_request_user_specific;
+
+    /* Check the transfer status. If there is a transport error, we ignore the packet.  */
+    if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
+    {
+
+        /* Free the slot and the packet that was not successfully received.  */
+        transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+        if (packet != UX_NULL)
+            nx_packet_release(packet);
+
+        /* If the transfer is not aborted, let the thread re-arm the slot.  */
+        if ((transfer_request -> ux_transfer_request_completion_code != UX_TRANSFER_STATUS_ABORT) &&
+            (cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP) &&
+            (cdc_ecm -> ux_host_class_cdc_ecm_state != UX_HOST_CLASS_INSTANCE_SHUTDOWN))
+            _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
+        return;
+    }
+
+    /* Get the packet length. */
+    packet -> nx_packet_length = transfer_request -> ux_transfer_request_actual_length;
+
+    /* Adjust the prepend, length, and append fields.  */
+    packet -> nx_packet_append_ptr =
+        packet -> nx_packet_prepend_ptr + transfer_request -> ux_transfer_request_actual_length;
+
+    /* Send that packet to the NetX USB broker. The slot is kept busy until
+       it is re-armed or released, so the thread does not pick it meanwhile.  */
+    _ux_network_driver_packet_received(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, packet);
+
+    /* Is the link still up?  */
+    if ((cdc_ecm -> ux_host_class_cdc_ecm_link_state != UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP) ||
+        (cdc_ecm -> ux_host_class_cdc_ecm_state == UX_HOST_CLASS_INSTANCE_SHUTDOWN))
+    {
+
+        /* Free the slot.  */
+        transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+        return;
+    }
+
+    /* Get a new packet for this slot, we must not wait here.  */
+    status =  _ux_network_driver_packet_lend(cdc_ecm -> ux_host_class_cdc_ecm_packet_pool, 0,
+                                             UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE, &packet, NX_NO_WAIT);
+    if (status != UX_SUCCESS)
+    {
+
+        /* No packet now, the thread re-arms the slot when it can wait for one.  */
+        transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+        _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
+        return;
+    }
+
+    /* Receive directly in the packet payload.  */
+    transfer_request -> ux_transfer_request_data_pointer =      packet -> nx_packet_prepend_ptr;
+    transfer_request -> ux_transfer_request_requested_length =  UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE;
+    transfer_request -> ux_transfer_request_actual_length =     0;
+    transfer_request -> ux_transfer_request_user_specific =     packet;
+
+    /* Ask USB to schedule a reception.  */
+    status =  _ux_host_stack_transfer_request(transfer_request);
+    if (status != UX_SUCCESS)
+    {
+
+        /* Error arming transfer, free the slot and release packet,
+           the thread retries the slot.  */
+        transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+        nx_packet_release(packet);
+        _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
+    }
+}
+#endif
@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   CDC_ECM Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_cdc_ecm_reception_ring_abort         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function aborts all the transfer requests of the bulk IN       */
+/*    reception ring. The packets owned by the transfer requests are      */
+/*    released by the reception callback.                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cdc_ecm                               CDC ECM instance              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    CDC ECM class                                                       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_cdc_ecm_reception_ring_abort(UX_HOST_CLASS_CDC_ECM *cdc_ecm)
+{
+
+ULONG       slot;
+
+
+    /* Abort every slot, pending ones are completed with abort status.  */
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT; slot ++)
+        _ux_host_stack_transfer_request_abort(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot]);
+}
+#endif
@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   CDC_ECM Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_cdc_ecm_reception_ring_arm           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function arms all idle transfer requests of the bulk IN        */
+/*    reception ring. Each transfer request receives directly in the      */
+/*    payload of a NetX packet allocated from the IP instance packet      */
+/*    pool.                                                               */
+/*                                                                        */
+/*    If the packets of the pool are too small to hold a complete         */
+/*    Ethernet frame the ring is not used and UX_MEMORY_INSUFFICIENT is   */
+/*    returned, so the caller falls back to the single transfer           */
+/*    reception.                                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cdc_ecm                               CDC ECM instance              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request       Transfer request              */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*    _ux_system_error_handler              Error handler                 */
+/*    _ux_utility_delay_ms                  Delay                         */
+/*    _ux_network_driver_packet_lend        Lend NetX packet              */
+/*    nx_packet_release                     Free NetX packet              */
+/*    _ux_network_driver_packet_dropped     Log dropped frame             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    CDC ECM thread                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_cdc_ecm_reception_ring_arm(UX_HOST_CLASS_CDC_ECM *cdc_ecm)
+{
+
+UX_TRANSFER                 *transfer_request;
+NX_PACKET                   *packet;
+UINT                        status;
+ULONG                       slot;
+USB_NETWORK_DEVICE_TYPE     *usb_network_device_ptr;
+
+
+    /* As long as we are connected, configured and link up ... arm the idle slots.  */
+    while ((cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP) &&
+           (cdc_ecm -> ux_host_class_cdc_ecm_device -> ux_device_state == UX_DEVICE_CONFIGURED))
+    {
+
+        /* Check if we have packet pool available.  */
+        if (cdc_ecm -> ux_host_class_cdc_ecm_packet_pool == UX_NULL)
+        {
+
+            /* Get the network device handle.  */
+            usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE *)(cdc_ecm -> ux_host_class_cdc_ecm_network_handle);
+
+            /* Check if IP instance is available.  */
+            if (usb_network_device_ptr -> ux_network_device_ip_instance != UX_NULL)
+            {
+
+                /* Get the packet pool from IP instance.  */
+                cdc_ecm -> ux_host_class_cdc_ecm_packet_pool = usb_network_device_ptr -> ux_network_device_ip_instance -> nx_ip_default_packet_pool;
+            }
+            else
+            {
+
+                /* IP instance is not available, wait for application to attach the interface.  */
+                _ux_utility_delay_ms(UX_MS_TO_TICK(UX_HOST_CLASS_CDC_ECM_PACKET_POOL_INSTANCE_WAIT));
+            }
+            continue;
+        }
+
+        /* Look for an idle slot in the ring.  */
+        transfer_request =  UX_NULL;
+        for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT; slot ++)
+        {
+            if (cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot].ux_transfer_request_user_specific == UX_NULL)
+            {
+                transfer_request =  &cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot];
+                break;
+            }
+        }
+
+        /* All the ring is armed, we are done.  */
+        if (transfer_request == UX_NULL)
+            return(UX_SUCCESS);
+
+        /* We can accept reception. Get a NX Packet lent as transfer buffer.  */
+        status =  _ux_network_driver_packet_lend(cdc_ecm -> ux_host_class_cdc_ecm_packet_pool, 0,
+                                                 UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE, &packet,
+                                                 UX_MS_TO_TICK(UX_HOST_CLASS_CDC_ECM_PACKET_POOL_WAIT));
+
+        /* The frame must fit in one aligned packet payload to be received without copy.  */
+        if (status == UX_BUFFER_OVERFLOW)
+            return(UX_MEMORY_INSUFFICIENT);
+
+        if (status != UX_SUCCESS)
+        {
+
+            /* Packet allocation timed out. Note that the timeout value is
+               configurable.  */
+
+            /* Error trap. No need for trace, since NetX does it.  */
+            _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
+
+            /* Log the reception refused, no packet to receive the frame.  */
+            _ux_network_driver_packet_dropped(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
+            continue;
+        }
+
+        /* Receive directly in the packet payload.  */
+        transfer_request -> ux_transfer_request_data_pointer =      packet -> nx_packet_prepend_ptr;
+        transfer_request -> ux_transfer_request_requested_length =  UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE;
+        transfer_request -> ux_transfer_request_actual_length =     0;
+
+        /* Store the packet that owns this transaction, this also marks the slot busy.  */
+        transfer_request -> ux_transfer_request_user_specific = packet;
+
+        /* We're arming the transfer now.  */
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_check_and_arm_in_process =  UX_TRUE;
+
+        /* Is the link up?  */
+        if (cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP)
+
+            /* Ask USB to schedule a reception.  */
+            status =  _ux_host_stack_transfer_request(transfer_request);
+        else
+
+            /* Link is down.  */
+            status =  UX_HOST_CLASS_INSTANCE_UNKNOWN;
+
+        /* Signal that we are done arming and resume waiting thread if necessary.  */
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_check_and_arm_in_process =  UX_FALSE;
+        if (cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_waiting_for_check_and_arm_to_finish == UX_TRUE)
+            _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_in_transfer_waiting_for_check_and_arm_to_finish_semaphore);
+
+        /* Check if the transaction was armed successfully.  */
+        if (status != UX_SUCCESS)
+        {
+
+            /* Free the slot and release packet.  */
+            transfer_request -> ux_transfer_request_user_specific = UX_NULL;
+            nx_packet_release(packet);
+            return(status);
+        }
+    }
+
+    /* Link is down or device is gone.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -59,15 +59,19 @@
 /*                                                                        */ 
 /*    _ux_host_class_cdc_ecm_transmit_queue_clean                         */
 /*                                          Clean transmit queue          */
+/*    _ux_host_class_cdc_ecm_reception_ring_arm                           */
+/*                                          Arm bulk IN transfer ring     */
 /*    _ux_host_stack_transfer_request       Transfer request              */
 /*    _ux_host_semaphore_get                Get semaphore                 */
 /*    _ux_host_semaphore_put                Put semaphore                 */
 /*    _ux_utility_short_get_big_endian      Get 16-bit big endian         */
+/*    _ux_utility_delay_ms                  Delay                         */
 /*    _ux_network_driver_link_up            Set state link up             */
 /*    _ux_network_driver_link_down          Set state link down           */
 /*    _ux_network_driver_packet_received    Process received packet       */
 /*    nx_packet_allocate                    Allocate NetX packet          */
 /*    nx_packet_release                     Free NetX packet              */
+/*    _ux_network_driver_packet_dropped     Log dropped frame             */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -99,6 +103,13 @@
 /*                                            deprecated ECM pool option, */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added bulk IN transfer      */
+/*                                            ring,                       */
+/*                                            resulting in version 6.x    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_thread(ULONG parameter)
@@ -131,7 +142,24 @@ ULONG                       packet_buffer_size;
 
             /* Communicate the state with the network driver.  */
             _ux_network_driver_link_up(cdc_ecm -> ux_host_class_cdc_ecm_network_handle);
-            
+
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+
+            /* Arm the reception ring, it is re-armed by the reception callback.
+               If packets are too small for the ring, fall back to single transfer reception.  */
+            status =  _ux_host_class_cdc_ecm_reception_ring_arm(cdc_ecm);
+            if (status != UX_MEMORY_INSUFFICIENT)
+            {
+
+                /* A slot left idle by an arm error is retried as a slot the
+                   reception callback could not re-arm.  */
+                if ((status != UX_SUCCESS) &&
+                    (cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP))
+                    _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
+                continue;
+            }
+#endif
+
             /* As long as we are connected, configured and link up ... do some work.... */
             while ((cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP) &&
                    (cdc_ecm -> ux_host_class_cdc_ecm_device -> ux_device_state == UX_DEVICE_CONFIGURED))                             
@@ -273,6 +301,9 @@ ULONG                       packet_buffer_size;
 
                                         /* Error trap.  */
                                         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_ETH_PACKET_ERROR);
+
+                                        /* Log the dropped frame, no packet to chain the data.  */
+                                        _ux_network_driver_packet_dropped(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
                                         continue;
                                     }
                                 }
@@ -329,9 +360,28 @@ ULONG                       packet_buffer_size;
 
                     /* Error trap. No need for trace, since NetX does it.  */
                     _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_MEMORY_INSUFFICIENT);
+
+                    /* Log the reception refused, no packet to receive the frame.  */
+                    _ux_network_driver_packet_dropped(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, USB_NETWORK_DEVICE_DROP_POOL_EMPTY);
                 }
             }
         }
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_IN_RING
+        else if (cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP)
+        {
+
+            /* The reception callback could not re-arm a slot, re-arm idle slots here.  */
+            status =  _ux_host_class_cdc_ecm_reception_ring_arm(cdc_ecm);
+            if (status != UX_SUCCESS)
+            {
+
+                /* A slot is still idle and no completion will wake us for it,
+                   retry after the packet pool wait.  */
+                _ux_utility_delay_ms(UX_HOST_CLASS_CDC_ECM_PACKET_POOL_WAIT);
+                _ux_host_semaphore_put(&cdc_ecm -> ux_host_class_cdc_ecm_interrupt_notification_semaphore);
+            }
+        }
+#endif
         else
         {
 
@@ -58,6 +58,9 @@
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
+/*    _ux_host_class_cdc_ecm_transmission_ring_arm                        */
+/*                                          Arm bulk OUT transfer ring    */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -83,6 +86,13 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics, added   */
+/*                                            bulk OUT transfer ring and  */
+/*                                            transmit queue depth,       */
+/*                                            dropped failed transfers on */
+/*                                            bulk OUT ring,              */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request)
@@ -91,12 +101,16 @@ VOID  _ux_host_class_cdc_ecm_transmission_callback(UX_TRANSFER *transfer_request
     UX_PARAMETER_NOT_USED(transfer_request);
 #else
 
+UX_INTERRUPT_SAVE_AREA
+
 UX_HOST_CLASS_CDC_ECM           *cdc_ecm;
 NX_PACKET                       *current_packet;
+#ifndef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
 NX_PACKET                       *next_packet;
 UCHAR                           *packet_header;
 #ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 ULONG                           copied;
+#endif
 #endif
     
     /* Get the data and control class instances for this transfer request.  */
@@ -114,7 +128,13 @@ ULONG                           copied;
     current_packet =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head;
     
     /* Do a sanity check on the packet.  */
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+
+    /* Slots complete in queue order, the packet of this slot is the head.  */
+    if ((current_packet == UX_NULL) || (current_packet != transfer_request -> ux_transfer_request_user_specific))
+#else
     if (current_packet == UX_NULL)
+#endif
     {
     
         /* Error trap. */
@@ -146,6 +166,23 @@ ULONG                           copied;
             return;
         }
 
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+
+        /* Remove the packet from the queue and free its slot.  */
+        UX_DISABLE
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  current_packet -> nx_packet_queue_next;
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth --;
+        transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_busy --;
+
+        /* A frame with ZLP is sent alone, it's done.  */
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp =  UX_FALSE;
+        UX_RESTORE
+
+        /* Arm pending packets on the free slots.  */
+        _ux_host_class_cdc_ecm_transmission_ring_arm(cdc_ecm);
+#else
+
         /* Get the next packet associated with the first packet.  */
         next_packet =  current_packet -> nx_packet_queue_next;
 
@@ -188,9 +225,18 @@ ULONG                           copied;
             _ux_host_stack_transfer_request(transfer_request);
         }
 
+        /* One packet less in the queue, the depth is also updated by write.  */
+        UX_DISABLE
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth --;
+        UX_RESTORE
+#endif
+
         /* If error log is enabled, insert this message into the log buffer.  */
         UX_DEBUG_LOG("_ux_host_class_cdc_ecm_transmission_callback", "Freeing transmitted packet", 0, transfer_request, current_packet)
         
+        /* Log the transmit completion.  */
+        _ux_network_driver_packet_transmitted(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_NONE);
+
         /* Free the packet that was just sent.  First do some housekeeping.  */
         current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE; 
         current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE;
@@ -201,10 +247,40 @@ ULONG                           copied;
     else
     {
 
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+
+        /* The transfer failed. The next slots are already armed behind this
+           one, a retry would send the frame out of order: drop it instead.
+           Note that this can't be a transfer abort, because otherwise the link
+           is either down or the class is in shutdown, both of which are
+           checked for at the beginning.  */
+        UX_DISABLE
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  current_packet -> nx_packet_queue_next;
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth --;
+        transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_busy --;
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp =  UX_FALSE;
+        UX_RESTORE
+
+        /* Arm pending packets on the free slots.  */
+        _ux_host_class_cdc_ecm_transmission_ring_arm(cdc_ecm);
+
+        /* Log the transmit drop.  */
+        _ux_network_driver_packet_transmitted(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR);
+
+        /* Free the packet that failed.  First do some housekeeping.  */
+        current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE; 
+        current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE;
+
+        /* And ask Netx to release it.  */
+        nx_packet_transmit_release(current_packet); 
+#else
+
         /* The transfer failed. Retry it. Note that this can't be a transfer
            abort, because otherwise the link is either down or the class is in
            shutdown, both of which are checked for at the beginning.  */
         _ux_host_stack_transfer_request(transfer_request);
+#endif
     }
 
     /* There is no status to be reported back to the stack.  */
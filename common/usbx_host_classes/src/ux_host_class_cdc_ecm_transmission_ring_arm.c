@@ -0,0 +1,228 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   CDC_ECM Class                                                       */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_cdc_ecm.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_cdc_ecm_transmission_ring_arm        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function arms the pending packets of the transmit queue on     */
+/*    the free transfer requests of the bulk OUT ring, in queue order.    */
+/*    Only one context arms the ring at a time, the others leave the      */
+/*    slots they freed to it.                                             */
+/*                                                                        */
+/*    A packet whose length is a multiple of the endpoint packet size is  */
+/*    armed alone, so its ZLP directly follows it. If a transfer request  */
+/*    can not be armed, its packet is dropped as a failed transfer.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    cdc_ecm                               CDC ECM instance              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request       Transfer request              */
+/*    nx_packet_data_extract_offset         Copy NetX packet data         */
+/*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    CDC ECM write and transmission callback                             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_cdc_ecm_transmission_ring_arm(UX_HOST_CLASS_CDC_ECM *cdc_ecm)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_TRANSFER             *transfer_request;
+NX_PACKET               *packet;
+NX_PACKET               *previous_packet;
+UCHAR                   *packet_header;
+ULONG                   slot;
+UINT                    status;
+#ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
+ULONG                   copied;
+#endif
+
+
+    /* We need to disable interrupts here, the transmit queue and the ring
+       slots are also updated by the transmission callback.  */
+    UX_DISABLE
+
+    /* Is another context arming the ring? It will arm the slots we freed.  */
+    if (cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_arming == UX_TRUE)
+    {
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+        return;
+    }
+    cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_arming =  UX_TRUE;
+
+    /* Arm pending packets as long as the link is up.  */
+    while (cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP)
+    {
+
+        /* Get the first packet not yet armed.  */
+        packet =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_pending;
+
+        /* Nothing to send, or a frame and its ZLP are being sent.  */
+        if ((packet == UX_NULL) || (cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp == UX_TRUE))
+            break;
+
+        /* A frame that needs a ZLP waits for the ring to be empty.  */
+        transfer_request =  &cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[0];
+        if (((packet -> nx_packet_length % transfer_request -> ux_transfer_request_packet_length) == 0) &&
+            (cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_busy != 0))
+            break;
+
+        /* Find a free slot.  */
+        for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT; slot ++)
+        {
+            if (cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot].ux_transfer_request_user_specific == UX_NULL)
+                break;
+        }
+        if (slot == UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT)
+            break;
+
+        /* Store the packet that owns this slot and move to the next pending packet.  */
+        transfer_request =  &cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot];
+        transfer_request -> ux_transfer_request_user_specific =  packet;
+        cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_pending =  packet -> nx_packet_queue_next;
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_busy ++;
+        if ((packet -> nx_packet_length % transfer_request -> ux_transfer_request_packet_length) == 0)
+            cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp =  UX_TRUE;
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+
+#ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
+
+        if (packet -> nx_packet_next != UX_NULL)
+        {
+
+            /* Put packet to continuous buffer of this slot to transfer.  */
+            packet_header =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_buffer + slot * UX_HOST_CLASS_CDC_ECM_NX_PAYLOAD_SIZE;
+            nx_packet_data_extract_offset(packet, 0, packet_header, packet -> nx_packet_length, &copied);
+        }
+        else
+#endif
+        {
+
+            /* Load the address of the current packet header at the physical header.  */
+            packet_header =  packet -> nx_packet_prepend_ptr;
+        }
+
+        /* Setup the transaction parameters.  */
+        transfer_request -> ux_transfer_request_data_pointer     =  packet_header;
+        transfer_request -> ux_transfer_request_requested_length =  packet -> nx_packet_length;
+
+        /* Arm the transfer request.  */
+        status =  _ux_host_stack_transfer_request(transfer_request);
+
+        /* Disable interrupts again to check the next packet.  */
+        UX_DISABLE
+
+        /* Did we successfully arm the transfer?  */
+        if (status != UX_SUCCESS)
+        {
+
+            /* Nothing would arm the packet again if no write or completion
+               follows, drop it as a failed transfer. Remove it from the queue,
+               the packets before it are armed and may have completed.  */
+            if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head == packet)
+            {
+                previous_packet =  UX_NULL;
+                cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  packet -> nx_packet_queue_next;
+            }
+            else
+            {
+                previous_packet =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head;
+                while (previous_packet -> nx_packet_queue_next != packet)
+                    previous_packet =  previous_packet -> nx_packet_queue_next;
+                previous_packet -> nx_packet_queue_next =  packet -> nx_packet_queue_next;
+            }
+            if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_tail == packet)
+                cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_tail =  previous_packet;
+            cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_pending =  packet -> nx_packet_queue_next;
+            cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth --;
+
+            /* Free its slot.  */
+            transfer_request -> ux_transfer_request_user_specific =  UX_NULL;
+            cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_busy --;
+            cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp =  UX_FALSE;
+
+            /* Restore interrupts.  */
+            UX_RESTORE
+
+            /* Log the transmit drop.  */
+            _ux_network_driver_packet_transmitted(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, packet, USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR);
+
+            /* Free the packet that failed.  First do some housekeeping.  */
+            packet -> nx_packet_prepend_ptr =  packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE;
+            packet -> nx_packet_length =  packet -> nx_packet_length - UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE;
+
+            /* And ask Netx to release it.  */
+            nx_packet_transmit_release(packet);
+
+            /* Disable interrupts again to check the next packet.  */
+            UX_DISABLE
+        }
+    }
+
+    /* We are done arming.  */
+    cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_arming =  UX_FALSE;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+}
+#endif
@@ -58,6 +58,7 @@
 /*    _ux_host_semaphore_get                Get bulk out semaphore        */ 
 /*    _ux_host_stack_endpoint_transfer_abort Abort endpoint transfer      */ 
 /*    nx_packet_transmit_release            Release NetX packet           */ 
+/*    _ux_network_driver_packet_transmitted Log transmit completion       */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -79,6 +80,10 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            traffic statistics, added   */
+/*                                            bulk OUT transfer ring,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_cdc_ecm_transmit_queue_clean(UX_HOST_CLASS_CDC_ECM *cdc_ecm)
@@ -88,6 +93,9 @@ UX_INTERRUPT_SAVE_AREA
 
 NX_PACKET               *current_packet;
 NX_PACKET               *next_packet;
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+ULONG                   slot;
+#endif
 
     /* Disable interrupts while we check the write in process flag and
        set our own state.  */
@@ -123,7 +131,20 @@ NX_PACKET               *next_packet;
     /* Abort transfers on the bulk out endpoint. Note we need to do this
        before accessing the queue since the transmission callback might
        modify it.  */
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT; slot ++)
+    {
+        _ux_host_stack_transfer_request_abort(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot]);
+        cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot].ux_transfer_request_user_specific =  UX_NULL;
+    }
+
+    /* All slots are free.  */
+    cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_pending =  UX_NULL;
+    cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_busy =  0;
+    cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp =  UX_FALSE;
+#else
     _ux_host_stack_transfer_request_abort(&cdc_ecm -> ux_host_class_cdc_ecm_bulk_out_endpoint -> ux_endpoint_transfer_request);
+#endif
 
     /* Get the first packet.  */
     current_packet =  cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head;
@@ -137,6 +158,9 @@ NX_PACKET               *next_packet;
            to null.  */
         next_packet =  current_packet -> nx_packet_queue_next;
 
+        /* Log the transmit completion.  */
+        _ux_network_driver_packet_transmitted(cdc_ecm -> ux_host_class_cdc_ecm_network_handle, current_packet, USB_NETWORK_DEVICE_DROP_LINK_DOWN);
+
         /* Free the packet. First do some housekeeping.  */
         current_packet -> nx_packet_prepend_ptr =  current_packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE; 
         current_packet -> nx_packet_length =  current_packet -> nx_packet_length - UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE;
@@ -150,5 +174,6 @@ NX_PACKET               *next_packet;
 
     /* Clear the queue.  */
     cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  UX_NULL;
+    cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth =  0;
 }
 #endif
@@ -60,6 +60,8 @@
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_host_semaphore_put                Release protection semaphore  */ 
 /*    nx_packet_transmit_release            Release NetX packet           */
+/*    _ux_host_class_cdc_ecm_transmission_ring_arm                        */
+/*                                          Arm bulk OUT transfer ring    */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -84,6 +86,10 @@
 /*  10-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            supported NX packet chain,  */
 /*                                            resulting in version 6.2.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            bulk OUT transfer ring and  */
+/*                                            transmit queue depth limit, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_cdc_ecm_write(VOID *cdc_ecm_class, NX_PACKET *packet)
@@ -91,12 +97,14 @@ UINT  _ux_host_class_cdc_ecm_write(VOID *cdc_ecm_class, NX_PACKET *packet)
 
 UX_INTERRUPT_SAVE_AREA
 
-UX_TRANSFER             *transfer_request;
 UINT                    status;
-UCHAR                   *packet_header;
 UX_HOST_CLASS_CDC_ECM   *cdc_ecm;
+#ifndef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+UX_TRANSFER             *transfer_request;
+UCHAR                   *packet_header;
 #ifdef UX_HOST_CLASS_CDC_ECM_PACKET_CHAIN_SUPPORT
 ULONG                   copied;
+#endif
 #endif
 
     /* Get the instance.  */
@@ -150,6 +158,54 @@ ULONG                   copied;
     if (cdc_ecm -> ux_host_class_cdc_ecm_link_state == UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP)
     {
 
+#if UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH > 0
+
+        /* Is the transmit queue full?  */
+        if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth >= UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH)
+        {
+
+            /* Restore interrupts.  */
+            UX_RESTORE
+
+            /* Release the packet.  */
+            packet -> nx_packet_prepend_ptr =  packet -> nx_packet_prepend_ptr + UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE; 
+            packet -> nx_packet_length =  packet -> nx_packet_length - UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE;
+            nx_packet_transmit_release(packet);
+
+            /* The packet is dropped, the caller is told to slow down.  */
+            status =  UX_CLASS_ETH_QUEUE_FULL_ERROR;
+        }
+        else
+#endif
+#ifdef UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING
+        {
+
+            /* The packet to be sent is the last in the queue.  */
+            packet -> nx_packet_queue_next =  UX_NULL;
+
+            /* Memorize the packet to be sent.  */
+            if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head == UX_NULL)
+                cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  packet;
+            else
+                cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_tail -> nx_packet_queue_next =  packet;
+            cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_tail =  packet;
+            cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth ++;
+
+            /* It is pending if all packets before it are armed.  */
+            if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_pending == UX_NULL)
+                cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_pending =  packet;
+
+            /* Restore interrupts.  */
+            UX_RESTORE
+
+            /* Arm it now if a slot is free.  */
+            _ux_host_class_cdc_ecm_transmission_ring_arm(cdc_ecm);
+
+            /* Successfully added to queue.  */
+            status =  UX_SUCCESS;
+        }
+#else
+
         /* Check the queue. See if there is something that is being sent.  */
         if (cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head == UX_NULL)
         {
@@ -160,6 +216,7 @@ ULONG                   copied;
             /* Memorize this packet at the beginning of the queue.  */
             cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  packet;
             cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_tail =  packet;
+            cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth =  1;
 
             /* Restore interrupts.  */
             UX_RESTORE
@@ -215,6 +272,7 @@ ULONG                   copied;
 
                 /* Clear the queue. No need to clear the tail.  */
                 cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_head =  UX_NULL;
+                cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth =  0;
 
                 /* We cleared the queue, so we must free the packet. First
                    we need to clean it before passing it to NetX.  */
@@ -239,6 +297,7 @@ ULONG                   copied;
 
             /* Set the tail.  */
             cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_tail =  packet;
+            cdc_ecm -> ux_host_class_cdc_ecm_xmit_queue_depth ++;
 
             /* Restore interrupts.  */
             UX_RESTORE
@@ -246,6 +305,7 @@ ULONG                   copied;
             /* Successfully added to queue.  */
             status =  UX_SUCCESS;
         }
+#endif
     }
     else
     {
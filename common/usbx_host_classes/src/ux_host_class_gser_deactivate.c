@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_gser_deactivate                      PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -62,6 +62,7 @@
 /*    _ux_utility_memory_free               Free memory block             */ 
 /*    _ux_host_semaphore_delete             Delete protection semaphore   */ 
 /*    _ux_utility_thread_schedule_other     Schedule other threads        */
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -77,6 +78,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_gser_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -84,6 +88,10 @@ UINT  _ux_host_class_gser_deactivate(UX_HOST_CLASS_COMMAND *command)
 
 UX_HOST_CLASS_GSER          *gser;
 ULONG                       interface_index;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UX_HOST_CLASS_GSER_RECEPTION
+                            *gser_reception;
+#endif
 
     /* Get the instance for this class.  */
     gser =  (UX_HOST_CLASS_GSER *) command -> ux_host_class_command_instance;
@@ -100,6 +108,18 @@ ULONG                       interface_index;
         /* We need to abort transactions on the bulk In pipes.  */
         _ux_host_stack_endpoint_transfer_abort(gser -> ux_host_class_gser_interface_array[interface_index].ux_host_class_gser_bulk_in_endpoint);
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+        /* A streaming reception has its transfers on the bulk In pipe, free them.  */
+        gser_reception =  gser -> ux_host_class_gser_interface_array[interface_index].ux_host_class_gser_reception;
+        if ((gser_reception != UX_NULL) &&
+            (gser_reception -> ux_host_class_gser_reception_transfer_count != 0))
+        {
+            gser_reception -> ux_host_class_gser_reception_state =  UX_HOST_CLASS_GSER_RECEPTION_STATE_STOPPED;
+            _ux_host_class_serial_stream_stop(&gser_reception -> ux_host_class_gser_reception_stream);
+        }
+#endif
+
         /* The enumeration thread needs to sleep a while to allow the application or the class that may be using
            endpoints to exit properly.  */
         _ux_host_thread_schedule_other(UX_THREAD_PRIORITY_ENUM); 
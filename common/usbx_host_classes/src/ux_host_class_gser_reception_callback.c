@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_gser_reception_callback              PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,9 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
+/*    _ux_host_class_serial_stream_completed                              */
+/*                                          Complete stream transfer      */
+/*    _ux_host_class_serial_stream_arm      Arm stream transfers          */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -69,6 +72,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_gser_reception_callback (UX_TRANSFER *transfer_request)
@@ -77,10 +83,52 @@ VOID  _ux_host_class_gser_reception_callback (UX_TRANSFER *transfer_request)
 UX_HOST_CLASS_GSER              *gser;
 UX_HOST_CLASS_GSER_RECEPTION    *gser_reception;
 ULONG                           interface_index;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UINT                            status;
+#endif
     
     /* Get the class instance for this transfer request.  */
     gser =  (UX_HOST_CLASS_GSER *) transfer_request -> ux_transfer_request_class_instance;
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Stream transfers are not the endpoint transfer request, they point to their reception.  */
+    if (transfer_request != &transfer_request -> ux_transfer_request_endpoint -> ux_endpoint_transfer_request)
+    {
+
+        /* Keep the block received for the application.  */
+        gser_reception =  (UX_HOST_CLASS_GSER_RECEPTION *) transfer_request -> ux_transfer_request_user_specific;
+        status =  _ux_host_class_serial_stream_completed(&gser_reception -> ux_host_class_gser_reception_stream, transfer_request);
+
+        /* If there is an error or the reception is stopped, we do not proceed.  */
+        if ((status != UX_SUCCESS) && (status != UX_BUFFER_OVERFLOW))
+        {
+
+            /* The reception is stopped.  */
+            gser_reception -> ux_host_class_gser_reception_state =  UX_HOST_CLASS_GSER_RECEPTION_STATE_STOPPED;
+            return;
+        }
+
+        /* Report the data received to the application, it stays in the buffer until released.  */
+        if (gser_reception -> ux_host_class_gser_reception_callback != UX_NULL)
+        {
+            gser_reception -> ux_host_class_gser_reception_callback(gser, UX_SUCCESS,
+                                    transfer_request -> ux_transfer_request_data_pointer,
+                                    transfer_request -> ux_transfer_request_actual_length);
+
+            /* Report the overflow, the reception goes on when data is released.  */
+            if (status == UX_BUFFER_OVERFLOW)
+                gser_reception -> ux_host_class_gser_reception_callback(gser, UX_BUFFER_OVERFLOW, UX_NULL, 0);
+        }
+
+        /* Arm transfers on free blocks.  */
+        _ux_host_class_serial_stream_arm(&gser_reception -> ux_host_class_gser_reception_stream);
+
+        /* There is no status to be reported back to the stack.  */
+        return;
+    }
+#endif
+
     /* The interface index was stored into the user specific field.  */
     interface_index = (ULONG) (ALIGN_TYPE) transfer_request -> ux_transfer_request_user_specific; 
     
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_gser_reception_start                 PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
+/*    _ux_host_class_serial_stream_start    Start serial stream           */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -72,6 +73,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_gser_reception_start (UX_HOST_CLASS_GSER *gser, 
@@ -101,6 +105,43 @@ ULONG           interface_index;
     /* Get the interface index.  */
     interface_index = gser_reception -> ux_host_class_gser_reception_interface_index;
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Check if the reception is streaming.  */
+    if (gser_reception -> ux_host_class_gser_reception_transfer_count != 0)
+    {
+
+        /* Completions may be notified through an event flags group shared with other ports.  */
+        gser_reception -> ux_host_class_gser_reception_stream.ux_host_class_serial_stream_event_flags_group =
+                                    gser_reception -> ux_host_class_gser_reception_event_flags_group;
+        gser_reception -> ux_host_class_gser_reception_stream.ux_host_class_serial_stream_event_flags =
+                                    gser_reception -> ux_host_class_gser_reception_event_flags;
+
+        /* Start the stream on the bulk in endpoint, the transfers point to this reception.  */
+        status =  _ux_host_class_serial_stream_start(&gser_reception -> ux_host_class_gser_reception_stream,
+                                    gser -> ux_host_class_gser_interface_array[interface_index].ux_host_class_gser_bulk_in_endpoint,
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+                                    &gser -> ux_host_class_gser_interface_array[interface_index].ux_host_class_gser_statistics,
+#else
+                                    UX_NULL,
+#endif
+                                    gser_reception -> ux_host_class_gser_reception_data_buffer,
+                                    gser_reception -> ux_host_class_gser_reception_data_buffer_size,
+                                    gser_reception -> ux_host_class_gser_reception_block_size,
+                                    gser_reception -> ux_host_class_gser_reception_transfer_count,
+                                    _ux_host_class_gser_reception_callback, (VOID *) gser, (VOID *) gser_reception);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        /* Save the reception structure in the gser structure.  */
+        gser -> ux_host_class_gser_interface_array[interface_index].ux_host_class_gser_reception = gser_reception;
+
+        /* And declare we have transfers in progress.  */
+        gser_reception -> ux_host_class_gser_reception_state =  UX_HOST_CLASS_GSER_RECEPTION_STATE_STARTED;
+        return(UX_SUCCESS);
+    }
+#endif
+
     /* Start by aligning the head and tail of buffers to the same address supplied by the application.  */
     gser_reception -> ux_host_class_gser_reception_data_head =  gser_reception -> ux_host_class_gser_reception_data_buffer;
     gser_reception -> ux_host_class_gser_reception_data_tail =  gser_reception -> ux_host_class_gser_reception_data_buffer;
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_gser_reception_stop                  PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,7 @@
 /*                                                                        */ 
 /*    _ux_host_stack_endpoint_transfer_abort                              */
 /*                                       Abort transfer request           */ 
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -73,6 +74,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_gser_reception_stop (UX_HOST_CLASS_GSER *gser, 
@@ -94,6 +98,21 @@ ULONG           interface_index;
         return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
     }
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* A streaming reception frees its transfer requests, they may be left after an error.  */
+    if ((gser_reception -> ux_host_class_gser_reception_transfer_count != 0) &&
+        (gser_reception -> ux_host_class_gser_reception_stream.ux_host_class_serial_stream_transfer_requests != UX_NULL))
+    {
+
+        /* Declare the reception stopped, the aborted transfers are not reported.  */
+        gser_reception -> ux_host_class_gser_reception_state =  UX_HOST_CLASS_GSER_RECEPTION_STATE_STOPPED;
+
+        /* Abort and free the transfers on the bulk In pipe.  */
+        return(_ux_host_class_serial_stream_stop(&gser_reception -> ux_host_class_gser_reception_stream));
+    }
+#endif
+
     /* Check if we do have transfers for this application. If none, nothing to do. */
     if (gser_reception -> ux_host_class_gser_reception_state ==  UX_HOST_CLASS_GSER_RECEPTION_STATE_STOPPED)
         return(UX_SUCCESS);
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_activate                         PORTABLE C      */ 
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,12 +58,15 @@
 /*    _ux_host_class_hid_configure          Configure HID                 */ 
 /*    _ux_host_class_hid_descriptor_parse   Parse descriptor              */ 
 /*    _ux_host_class_hid_interrupt_endpoint_search  Search endpoint       */ 
+/*    _ux_host_class_hid_report_ring_start  Start report ring             */
+/*    _ux_host_class_hid_report_ring_stop   Stop report ring              */
 /*    _ux_host_class_hid_instance_clean     Clean up instance resources   */
 /*    _ux_host_stack_class_instance_create  Create class instance         */ 
 /*    _ux_host_stack_class_instance_destroy Destroy class instance        */ 
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*    _ux_utility_memory_free               Free memory                   */
 /*    _ux_host_semaphore_create             Create semaphore              */ 
+/*    _ux_host_semaphore_delete             Delete semaphore              */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -83,6 +86,10 @@
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added input report ring,    */
+/*                                            added decode plan semaphore,*/
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_activate(UX_HOST_CLASS_COMMAND  *command)
@@ -147,6 +154,16 @@ UINT                status;
         /* Search the HID interrupt endpoint but do not start it.  */
         status =  _ux_host_class_hid_interrupt_endpoint_search(hid);     
     }
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+    /* If HID interrupt endpoint is found, goes on. */
+    if (status == UX_SUCCESS)
+    {
+
+        /* Start the ring of input reports and its worker thread.  */
+        status =  _ux_host_class_hid_report_ring_start(hid);
+    }
+#endif
 
     /* If HID interrupt endpoint is found, goes on. */
     if (status == UX_SUCCESS)
@@ -155,6 +172,16 @@ UINT                status;
         /* Create the semaphore to protect multiple threads from accessing the same
         storage instance.  */
         status =  _ux_host_semaphore_create(&hid -> ux_host_class_hid_semaphore, "ux_host_class_hid_semaphore", 1);
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+        /* Create the semaphore the layout set waits on for the decodes in progress.  */
+        if (status == UX_SUCCESS)
+        {
+            status =  _ux_host_semaphore_create(&hid -> ux_host_class_hid_plan_semaphore, "ux_host_class_hid_plan_semaphore", 0);
+            if (status != UX_SUCCESS)
+                _ux_host_semaphore_delete(&hid -> ux_host_class_hid_semaphore);
+        }
+#endif
 
         if (status == UX_SUCCESS)
         {
@@ -188,6 +215,12 @@ UINT                status;
         }
     }
 
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+    /* Stop the ring of input reports, if started.  */
+    _ux_host_class_hid_report_ring_stop(hid);
+#endif
+
     /* Clean interrupt endpoint.  */
     if (hid -> ux_host_class_hid_interrupt_endpoint &&
         hid -> ux_host_class_hid_interrupt_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_data_pointer)
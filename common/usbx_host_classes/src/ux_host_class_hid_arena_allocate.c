@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_arena_allocate                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates a cleared block for the HID parser. If the  */
+/*    HID instance has an arena, the block is taken at the end of the used*/
+/*    part of the arena. Otherwise it is allocated from regular memory.   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    count                                 Number of elements            */
+/*    size                                  Size of one element           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Pointer to the block, NULL if no memory                             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_allocate_mulc_safe Allocate memory block         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  *_ux_host_class_hid_arena_allocate(UX_HOST_CLASS_HID *hid, ULONG count, ULONG size)
+{
+
+ULONG       block_size;
+
+
+    /* Without arena, the block is allocated alone.  */
+    if (hid -> ux_host_class_hid_arena == UX_NULL)
+        return(_ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY, count, size));
+
+    /* Check the block fits in what is left of the arena.  */
+    if (UX_OVERFLOW_CHECK_MULC_ULONG(count, size))
+        return(UX_NULL);
+    block_size =  count * size;
+    if (block_size > hid -> ux_host_class_hid_arena_size - hid -> ux_host_class_hid_arena_used)
+        return(UX_NULL);
+
+    /* Keep the next block aligned, the arena size is aligned too.  */
+    block_size =  UX_HOST_CLASS_HID_ARENA_ALIGN(block_size);
+
+    /* Take the block at the end of the used part.  */
+    hid -> ux_host_class_hid_arena_last =  hid -> ux_host_class_hid_arena_used;
+    hid -> ux_host_class_hid_arena_used +=  block_size;
+
+    /* Return the block, the arena memory is cleared.  */
+    return(hid -> ux_host_class_hid_arena + hid -> ux_host_class_hid_arena_last);
+}
+#endif
@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_arena_create                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function allocates the arena of the reports of a HID instance. */
+/*    A first pass over the report descriptor computes the memory that the*/
+/*    parser can take at most: one report and one field for each input,   */
+/*    output or feature item, with its values, usages and decode plan     */
+/*    entries. If the arena can not be allocated, the parser allocates its*/
+/*    blocks one by one.                                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    descriptor                            Pointer to report descriptor  */
+/*    length                                Length of report descriptor   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_item_data_get      Get data from item            */
+/*    _ux_host_class_hid_report_item_analyseAnalyze item                  */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_arena_create(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, ULONG length)
+{
+
+UX_HOST_CLASS_HID_ITEM  item;
+ULONG                   arena_size;
+ULONG                   item_size;
+ULONG                   report_count;
+ULONG                   usage_count;
+ULONG                   usage_min;
+ULONG                   usage_max;
+ULONG                   item_data;
+
+
+    /* Nothing is reserved yet.  */
+    arena_size =  0;
+    report_count =  0;
+    usage_count =  0;
+    usage_min =  0;
+
+    /* Go through the report descriptor items.  */
+    while (length)
+    {
+
+        /* Get one item from the report and analyze it.  */
+        _ux_host_class_hid_report_item_analyse(descriptor, &item);
+        if (length < (ULONG)(item.ux_host_class_hid_item_report_length + item.ux_host_class_hid_item_report_format))
+            return(UX_DESCRIPTOR_CORRUPTED);
+        descriptor +=  item.ux_host_class_hid_item_report_format;
+        item_data =  _ux_host_class_hid_item_data_get(descriptor, &item);
+
+        switch (item.ux_host_class_hid_item_report_type)
+        {
+
+        case UX_HOST_CLASS_HID_TYPE_GLOBAL:
+
+            /* The report count may be pushed and popped, keep the biggest.  */
+            if ((item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_GLOBAL_TAG_REPORT_COUNT) &&
+                (item_data > report_count))
+                report_count =  item_data;
+            break;
+
+        case UX_HOST_CLASS_HID_TYPE_LOCAL:
+
+            /* Count the usages as the local item parser adds them.  */
+            if (item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_LOCAL_TAG_USAGE)
+                usage_count ++;
+            else if (item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_LOCAL_TAG_USAGE_MINIMUM)
+                usage_min =  item_data;
+            else if (item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_LOCAL_TAG_USAGE_MAXIMUM)
+            {
+                usage_max =  item_data;
+                if (usage_max >= usage_min)
+                    usage_count +=  (usage_max - usage_min < UX_HOST_CLASS_HID_USAGES) ?
+                                            usage_max - usage_min + 1 : UX_HOST_CLASS_HID_USAGES;
+            }
+
+            /* The parser does not take more usages.  */
+            if (usage_count > UX_HOST_CLASS_HID_USAGES)
+                usage_count =  UX_HOST_CLASS_HID_USAGES;
+            break;
+
+        case UX_HOST_CLASS_HID_TYPE_MAIN:
+
+            /* Reports take memory only for input, output and feature items.  */
+            if ((item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_MAIN_TAG_INPUT) ||
+                (item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_MAIN_TAG_OUTPUT) ||
+                (item.ux_host_class_hid_item_report_tag == UX_HOST_CLASS_HID_MAIN_TAG_FEATURE))
+            {
+
+                /* Values and usages are 4 bytes each.  */
+                if (UX_OVERFLOW_CHECK_MULC_ULONG(report_count, 8))
+                    return(UX_MATH_OVERFLOW);
+                item_size =  UX_HOST_CLASS_HID_ARENA_ALIGN(sizeof(UX_HOST_CLASS_HID_REPORT)) +
+                             UX_HOST_CLASS_HID_ARENA_ALIGN(sizeof(UX_HOST_CLASS_HID_FIELD)) +
+                             UX_HOST_CLASS_HID_ARENA_ALIGN(report_count * 4) +
+                             UX_HOST_CLASS_HID_ARENA_ALIGN(usage_count * 4);
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+                /* Each value may have its plan entry, in both copies of the plan.  */
+                if (UX_OVERFLOW_CHECK_MULC_ULONG(report_count, sizeof(UX_HOST_CLASS_HID_PLAN_ENTRY) * 2 + 8))
+                    return(UX_MATH_OVERFLOW);
+                item_size +=  UX_HOST_CLASS_HID_ARENA_ALIGN(report_count * (ULONG)sizeof(UX_HOST_CLASS_HID_PLAN_ENTRY) * 2);
+#endif
+                if (UX_OVERFLOW_CHECK_ADD_ULONG(arena_size, item_size))
+                    return(UX_MATH_OVERFLOW);
+                arena_size +=  item_size;
+            }
+
+            /* The local items are cleaned after each main item.  */
+            usage_count =  0;
+            usage_min =  0;
+            break;
+
+        default:
+
+            /* Reserved items are rejected by the parser.  */
+            return(UX_DESCRIPTOR_CORRUPTED);
+        }
+
+        /* Jump to the next item.  */
+        descriptor +=  item.ux_host_class_hid_item_report_length;
+        length -=  (ULONG)(item.ux_host_class_hid_item_report_length + item.ux_host_class_hid_item_report_format);
+    }
+
+    /* A descriptor without reports needs no arena.  */
+    if (arena_size == 0)
+        return(UX_SUCCESS);
+
+    /* Allocate the arena, its memory is cleared.  */
+    hid -> ux_host_class_hid_arena =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, arena_size);
+    if (hid -> ux_host_class_hid_arena == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+    hid -> ux_host_class_hid_arena_size =  arena_size;
+    hid -> ux_host_class_hid_arena_used =  0;
+    hid -> ux_host_class_hid_arena_last =  0;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
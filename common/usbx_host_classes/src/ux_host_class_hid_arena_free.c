@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_arena_free                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases a block of the HID parser. A block of the    */
+/*    arena is given back only if it is the last one taken, it is cleared */
+/*    for the next one. Other arena blocks are released with the arena. A */
+/*    block out of the arena is freed to the regular memory.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    memory                                Pointer to the block          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_free               Free memory block             */
+/*    _ux_utility_memory_set                Set memory block              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hid_arena_free(UX_HOST_CLASS_HID *hid, VOID *memory)
+{
+
+UCHAR       *last_block;
+
+
+    /* Without arena, the block was allocated alone.  */
+    if (hid -> ux_host_class_hid_arena == UX_NULL)
+    {
+        _ux_utility_memory_free(memory);
+        return;
+    }
+
+    /* The last block taken can be given back.  */
+    last_block =  hid -> ux_host_class_hid_arena + hid -> ux_host_class_hid_arena_last;
+    if ((UCHAR *) memory == last_block)
+    {
+        _ux_utility_memory_set(last_block, 0, hid -> ux_host_class_hid_arena_used - hid -> ux_host_class_hid_arena_last); /* Use case of memset is verified. */
+        hid -> ux_host_class_hid_arena_used =  hid -> ux_host_class_hid_arena_last;
+    }
+}
+#endif
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_deactivate                       PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,6 +58,7 @@
 /*                                                                        */ 
 /*    (ux_host_class_hid_client_handler)    HID client handler            */ 
 /*    _ux_host_class_hid_instance_clean     HID instance clean            */ 
+/*    _ux_host_class_hid_report_ring_stop   Stop report ring              */
 /*    _ux_host_stack_class_instance_destroy Destroy the class instance    */ 
 /*    _ux_host_stack_endpoint_transfer_abort                              */
 /*                                          Abort transfer                */ 
@@ -80,6 +81,10 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            added standalone support,   */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added input report ring,    */
+/*                                            added decode plan semaphore,*/
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -116,6 +121,11 @@ UINT                                status;
 
         /* We need to abort transactions on the interrupt pipe.  */
         _ux_host_stack_endpoint_transfer_abort(hid -> ux_host_class_hid_interrupt_endpoint);
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+        /* No more report is queued, stop the ring worker.  */
+        _ux_host_class_hid_report_ring_stop(hid);
+#endif
 
         /* If the Hid class instance has a interrupt pipe with a data payload associated with it
         it must be freed.  */
@@ -151,6 +161,9 @@ UINT                                status;
 
     /* Destroy the semaphore.  */
     _ux_host_semaphore_delete(&hid -> ux_host_class_hid_semaphore);
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+    _ux_host_semaphore_delete(&hid -> ux_host_class_hid_plan_semaphore);
+#endif
 
     /* Before we free the device resources, we need to inform the application
         that the device is removed.  */
@@ -51,7 +51,7 @@ static inline UINT _ux_host_class_hid_activate_wait(UX_HOST_CLASS_COMMAND *comma
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
 /*    _ux_host_class_hid_entry                            PORTABLE C      */
-/*                                                           6.1.12       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -74,6 +74,7 @@ static inline UINT _ux_host_class_hid_activate_wait(UX_HOST_CLASS_COMMAND *comma
 /*                                                                        */
 /*    _ux_host_class_hid_activate           Activate HID class            */
 /*    _ux_host_class_hid_deactivate         Deactivate HID class          */
+/*    _ux_host_class_hid_parse_cache_free   Free parse cache              */
 /*    _ux_utility_memory_free               Free memory                   */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -97,6 +98,10 @@ static inline UINT _ux_host_class_hid_activate_wait(UX_HOST_CLASS_COMMAND *comma
 /*                                            fixed parameter/variable    */
 /*                                            names conflict C++ keyword, */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            added parse cache,          */
+/*                                            added parser arena,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_entry(UX_HOST_CLASS_COMMAND *command)
@@ -173,6 +178,12 @@ UX_HOST_CLASS_HID_CLIENT_COMMAND    client_command;
             _ux_utility_memory_free(command -> ux_host_class_command_class_ptr -> ux_host_class_client);
             command -> ux_host_class_command_class_ptr -> ux_host_class_client = UX_NULL;
         }
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+        /* Free the cached reports.  */
+        _ux_host_class_hid_parse_cache_free(command -> ux_host_class_command_class_ptr);
+#endif
         return(UX_SUCCESS);
 
     default:
@@ -370,6 +381,21 @@ UINT                    status = UX_SUCCESS;
     descriptor = hid -> ux_host_class_hid_allocated;
     length = transfer -> ux_transfer_request_actual_length;
 
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+    /* If this descriptor of this device was parsed before, clone its reports,
+       nothing is left to parse.  */
+    if (_ux_host_class_hid_parse_cache_load(hid, descriptor, length) == UX_SUCCESS)
+        length = 0;
+#endif
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+
+    /* Reserve the memory of the reports in one block.  */
+    if (length)
+        _ux_host_class_hid_arena_create(hid, descriptor, length);
+#endif
+
     /* Parse the report descriptor and build the report items.  */
     while (length)
     {
@@ -443,6 +469,12 @@ UINT                    status = UX_SUCCESS;
         return;
     }
 
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+    /* Keep the parsed reports for the next attach of this device.  */
+    _ux_host_class_hid_parse_cache_store(hid, hid -> ux_host_class_hid_allocated, transfer -> ux_transfer_request_actual_length);
+#endif
+
     /* Search the HID interrupt endpoint.  */
     status = _ux_host_class_hid_interrupt_endpoint_search(hid);
     if (status != UX_SUCCESS)
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_field_decompress                 PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -44,6 +44,10 @@
 /*                                                                        */ 
 /*    This function will decompress a field and return the usage/value.   */ 
 /*                                                                        */ 
+/*    The report bits are loaded a byte at a time in a 64 bit window and  */
+/*    each value is taken with a shift and a mask, byte aligned values of */
+/*    8, 16 and 32 bits are read directly.                                */
+/*                                                                        */ 
 /*  INPUT                                                                 */ 
 /*                                                                        */ 
 /*    hid_field                             Pointer to HID field          */ 
@@ -56,7 +60,8 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
-/*    None                                                                */ 
+/*    _ux_utility_long_get                  Get 32-bit value              */
+/*    _ux_utility_short_get                 Get 16-bit value              */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -72,6 +77,10 @@
 /*  10-31-2023     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            improved usage handling,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            extracted values with shift */
+/*                                            and mask on a bit window,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_field_decompress(UX_HOST_CLASS_HID_FIELD *hid_field, UCHAR *report_buffer, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report)
@@ -79,58 +88,73 @@ UINT  _ux_host_class_hid_field_decompress(UX_HOST_CLASS_HID_FIELD *hid_field, UC
 
 ULONG       field_report_count;
 ULONG       field_report_size;
-ULONG       data_offset_byte;
-ULONG       data_offset_bit;
-ULONG       data_offset_bit_in_report;
 ULONG       field_value;
-ULONG       field_value_bit_shifting;
+ULONG       field_value_mask;
 ULONG       field_usage;
-ULONG       report_content;
+ULONG       field_variable;
+ULONG       *client_buffer;
+UCHAR       *report_pointer;
+ULONG64     report_bits;
+ULONG       report_bits_count;
 
 
     /* Calculate the address of the beginning of the field in the report.  */
-    data_offset_byte =  (hid_field -> ux_host_class_hid_field_report_offset >> 3);
+    report_pointer =  report_buffer + (hid_field -> ux_host_class_hid_field_report_offset >> 3);
+
+    /* Fields are not always on a byte boundary, the bits before the field are dropped from the
+       first byte. The bits of the report are then loaded byte by byte in a 64 bit window, there
+       is enough room for a value of 32 bits at any bit offset.  */
+    report_bits =  0;
+    report_bits_count =  hid_field -> ux_host_class_hid_field_report_offset & 7;
+    if (report_bits_count != 0)
+    {
+        report_bits =  (ULONG64)(*report_pointer++ >> report_bits_count);
+        report_bits_count =  8 - report_bits_count;
+    }
+
+    /* Get the report size in bits, the parser does not accept values larger than 32 bits.  */
+    field_report_size =  hid_field -> ux_host_class_hid_field_report_size;
+    field_value_mask =  (field_report_size >= 32) ? 0xFFFFFFFFu : (((ULONG)1 << field_report_size) - 1);
+
+    /* The Usage value will depend if the data is defined as a variable or an array in the HID report.  */
+    field_variable =  hid_field -> ux_host_class_hid_field_value & UX_HOST_CLASS_HID_ITEM_VARIABLE;
 
-    /* Calculate the bit start address. Hopefully things will be on a boundary but not necessary.  */
-    data_offset_bit =  hid_field -> ux_host_class_hid_field_report_offset & 7;
+    /* Values are written after the data already in the caller's buffer.  */
+    client_buffer =  client_report -> ux_host_class_hid_client_report_buffer + client_report -> ux_host_class_hid_client_report_actual_length;
 
     /* Each report field has a report_count value. This count is used to extract values from the 
        incoming report and build each usage/value instance.  */
     for (field_report_count = 0; field_report_count < hid_field -> ux_host_class_hid_field_report_count; field_report_count++)
     {
 
-        /* Get the report size in bits.  */
-        field_report_size =  hid_field -> ux_host_class_hid_field_report_size;
-        
-        /* We use the bit offset for this report and not the generic field bit offset.  */
-        data_offset_bit_in_report = data_offset_bit;
-        
-        /* Reset the local value.  */
-        field_value =  0;
-        
-        /* And start with bit 0 in the target value.  */
-        field_value_bit_shifting =  0;
-        
-        /* Build the value field bit by bit.  */
-        while (field_report_size-- != 0)
+        /* Byte aligned values of 8, 16 or 32 bits are read directly from the report.  */
+        if ((report_bits_count == 0) && ((field_report_size == 8) || (field_report_size == 16) || (field_report_size == 32)))
         {
+            if (field_report_size == 8)
+                field_value =  (ULONG) *report_pointer;
+            else if (field_report_size == 16)
+                field_value =  _ux_utility_short_get(report_pointer);
+            else
+                field_value =  _ux_utility_long_get(report_pointer);
+            report_pointer +=  field_report_size >> 3;
+        }
+        else
+        {
+
+            /* Load the bytes of the value in the window, bytes after the field are not read.  */
+            while (report_bits_count < field_report_size)
+            {
+                report_bits |=  (ULONG64) *report_pointer++ << report_bits_count;
+                report_bits_count +=  8;
+            }
+
+            /* The value is at the bottom of the window.  */
+            field_value =  (ULONG) report_bits & field_value_mask;
+            report_bits >>=  field_report_size;
+            report_bits_count -=  field_report_size;
+        }
 
-            /* Read the content. This method is redundant if we are not changing byte but it 
-               makes the algorithm much easier.  */
-            report_content =  (ULONG) *(report_buffer + data_offset_byte + (data_offset_bit_in_report >> 3));        
-            
-            /* Shift the current value content to allow space to store the new bit.  */
-            field_value |=  ((report_content >> (data_offset_bit_in_report & 7)) & 1) << field_value_bit_shifting;
-                
-            /* Move to next bit in the report.  */
-            data_offset_bit_in_report++;
-            
-            /* And the next bit in the value.  */
-            field_value_bit_shifting++;
-        }        
-
-        /* The Usage value will depend if the data is defined as a variable or an array in the HID report.  */
-        if (hid_field -> ux_host_class_hid_field_value & UX_HOST_CLASS_HID_ITEM_VARIABLE)
+        if (field_variable)
         {
 
             /* Take the usage directly from the usage array (if specified).  */
@@ -151,16 +175,13 @@ ULONG       report_content;
         }
 
         /* Put the value and the usage into the caller's buffer.  */
-        *(client_report -> ux_host_class_hid_client_report_buffer + client_report -> ux_host_class_hid_client_report_actual_length) =  field_usage;
-        client_report -> ux_host_class_hid_client_report_actual_length++;
-        *(client_report -> ux_host_class_hid_client_report_buffer + client_report -> ux_host_class_hid_client_report_actual_length) =  field_value;
-        client_report -> ux_host_class_hid_client_report_actual_length++;
-
-        /* Calculate the next address for this field.  */
-        data_offset_bit +=  hid_field -> ux_host_class_hid_field_report_size;
+        *client_buffer++ =  field_usage;
+        *client_buffer++ =  field_value;
     }              
 
+    /* Update the length of data in the caller's buffer.  */
+    client_report -> ux_host_class_hid_client_report_actual_length +=  hid_field -> ux_host_class_hid_field_report_count << 1;
+
     /* Return successful completion.  */
     return(UX_SUCCESS);
 }
-
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_instance_clean                   PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -67,6 +67,11 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            freed report decode plans,  */
+/*                                            freed parse cache clones,   */
+/*                                            freed parser arena,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_instance_clean(UX_HOST_CLASS_HID *hid)
@@ -79,6 +84,29 @@ UX_HOST_CLASS_HID_FIELD      *hid_field;
 UX_HOST_CLASS_HID_FIELD      *hid_next_field;
 
 
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+    /* Reports cloned from the parse cache are all in one block.  */
+    if (hid -> ux_host_class_hid_parse_cache_block != UX_NULL)
+    {
+        _ux_utility_memory_free(hid -> ux_host_class_hid_parse_cache_block);
+        hid -> ux_host_class_hid_parse_cache_block =  UX_NULL;
+        return(UX_SUCCESS);
+    }
+#endif
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+
+    /* Reports allocated in the arena are freed with it.  */
+    if (hid -> ux_host_class_hid_arena != UX_NULL)
+    {
+        _ux_utility_memory_free(hid -> ux_host_class_hid_arena);
+        hid -> ux_host_class_hid_arena =  UX_NULL;
+        hid -> ux_host_class_hid_arena_used =  0;
+        return(UX_SUCCESS);
+    }
+#endif
+
     /* Get the parser structure pointer.  */
     hid_parser =  &hid -> ux_host_class_hid_parser;
 
@@ -115,6 +143,13 @@ UX_HOST_CLASS_HID_FIELD      *hid_next_field;
             hid_field =  hid_next_field;
         }
 
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+        /* Free the decode plan.  */
+        if (hid_report -> ux_host_class_hid_report_plan != UX_NULL)
+            _ux_utility_memory_free(hid_report -> ux_host_class_hid_report_plan);
+#endif
+
         /* Free the report.  */
         _ux_utility_memory_free(hid_report);
 
@@ -155,6 +190,13 @@ UX_HOST_CLASS_HID_FIELD      *hid_next_field;
             hid_field =  hid_next_field;
         }
 
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+        /* Free the decode plan.  */
+        if (hid_report -> ux_host_class_hid_report_plan != UX_NULL)
+            _ux_utility_memory_free(hid_report -> ux_host_class_hid_report_plan);
+#endif
+
         /* Free the report.  */
         _ux_utility_memory_free(hid_report);
 
@@ -195,6 +237,13 @@ UX_HOST_CLASS_HID_FIELD      *hid_next_field;
             hid_field =  hid_next_field;
         }
 
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+        /* Free the decode plan.  */
+        if (hid_report -> ux_host_class_hid_report_plan != UX_NULL)
+            _ux_utility_memory_free(hid_report -> ux_host_class_hid_report_plan);
+#endif
+
         /* Free the report.  */
         _ux_utility_memory_free(hid_report);
 
@@ -0,0 +1,200 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+
+/* Keep the structures of the block aligned.  */
+#define UX_HOST_CLASS_HID_PARSE_CACHE_ALIGN(size)   (((size) + 7u) & ~7u)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_copy                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies the input, output and feature report lists     */
+/*    with their fields, usages, values and decode plans in one block.    */
+/*    The copied lists are linked inside the block. If the block is NULL, */
+/*    nothing is copied and only the length of the block is computed.     */
+/*    The report callbacks are copied as they are.                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    target_reports                        Lists of the copied reports   */
+/*    source_reports                        Lists of the reports to copy  */
+/*    block                                 Block to copy the lists in    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Length of the block                                                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_host_class_hid_parse_cache_copy(UX_HOST_CLASS_HID_REPORT **target_reports, UX_HOST_CLASS_HID_REPORT **source_reports,
+                                           UCHAR *block)
+{
+
+UX_HOST_CLASS_HID_REPORT    *hid_report;
+UX_HOST_CLASS_HID_REPORT    *new_hid_report;
+UX_HOST_CLASS_HID_REPORT    **report_link;
+UX_HOST_CLASS_HID_FIELD     *hid_field;
+UX_HOST_CLASS_HID_FIELD     *new_hid_field;
+UX_HOST_CLASS_HID_FIELD     **field_link;
+ULONG                       block_length;
+ULONG                       array_length;
+ULONG                       report_list;
+
+
+    /* Nothing is copied yet.  */
+    block_length =  0;
+    new_hid_report =  UX_NULL;
+    new_hid_field =  UX_NULL;
+    field_link =  UX_NULL;
+
+    /* Copy the input, output and feature report lists.  */
+    for (report_list = 0; report_list < 3; report_list ++)
+    {
+
+        /* The first report is linked to the list head.  */
+        report_link =  &target_reports[report_list];
+        for (hid_report =  source_reports[report_list]; hid_report != UX_NULL;
+             hid_report =  hid_report -> ux_host_class_hid_report_next_report)
+        {
+
+            /* Copy the report and link it to the previous one.  */
+            if (block != UX_NULL)
+            {
+                new_hid_report =  (UX_HOST_CLASS_HID_REPORT *) (block + block_length);
+                _ux_utility_memory_copy(new_hid_report, hid_report, sizeof(UX_HOST_CLASS_HID_REPORT)); /* Use case of memcpy is verified. */
+                *report_link =  new_hid_report;
+                report_link =  &new_hid_report -> ux_host_class_hid_report_next_report;
+                field_link =  &new_hid_report -> ux_host_class_hid_report_field;
+            }
+            block_length +=  UX_HOST_CLASS_HID_PARSE_CACHE_ALIGN(sizeof(UX_HOST_CLASS_HID_REPORT));
+
+            for (hid_field =  hid_report -> ux_host_class_hid_report_field; hid_field != UX_NULL;
+                 hid_field =  hid_field -> ux_host_class_hid_field_next_field)
+            {
+
+                /* Copy the field and link it to the previous one.  */
+                if (block != UX_NULL)
+                {
+                    new_hid_field =  (UX_HOST_CLASS_HID_FIELD *) (block + block_length);
+                    _ux_utility_memory_copy(new_hid_field, hid_field, sizeof(UX_HOST_CLASS_HID_FIELD)); /* Use case of memcpy is verified. */
+                    if (hid_field -> ux_host_class_hid_field_report != UX_NULL)
+                        new_hid_field -> ux_host_class_hid_field_report =  new_hid_report;
+                    *field_link =  new_hid_field;
+                    field_link =  &new_hid_field -> ux_host_class_hid_field_next_field;
+                }
+                block_length +=  UX_HOST_CLASS_HID_PARSE_CACHE_ALIGN(sizeof(UX_HOST_CLASS_HID_FIELD));
+
+                /* Copy the values table.  */
+                if (hid_field -> ux_host_class_hid_field_values != UX_NULL)
+                {
+                    array_length =  hid_field -> ux_host_class_hid_field_report_count * 4;
+                    if (block != UX_NULL)
+                    {
+                        new_hid_field -> ux_host_class_hid_field_values =  (ULONG *) (block + block_length);
+                        _ux_utility_memory_copy(new_hid_field -> ux_host_class_hid_field_values,
+                                                hid_field -> ux_host_class_hid_field_values, array_length); /* Use case of memcpy is verified. */
+                    }
+                    block_length +=  UX_HOST_CLASS_HID_PARSE_CACHE_ALIGN(array_length);
+                }
+
+                /* Copy the usages table.  */
+                if (hid_field -> ux_host_class_hid_field_usages != UX_NULL)
+                {
+                    array_length =  hid_field -> ux_host_class_hid_field_number_usage * 4;
+                    if (block != UX_NULL)
+                    {
+                        new_hid_field -> ux_host_class_hid_field_usages =  (ULONG *) (block + block_length);
+                        _ux_utility_memory_copy(new_hid_field -> ux_host_class_hid_field_usages,
+                                                hid_field -> ux_host_class_hid_field_usages, array_length); /* Use case of memcpy is verified. */
+                    }
+                    block_length +=  UX_HOST_CLASS_HID_PARSE_CACHE_ALIGN(array_length);
+                }
+            }
+
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+            /* Copy the decode plan.  */
+            if (hid_report -> ux_host_class_hid_report_plan != UX_NULL)
+            {
+                array_length =  hid_report -> ux_host_class_hid_report_plan_count * (ULONG)sizeof(UX_HOST_CLASS_HID_PLAN_ENTRY) * 2;
+                if (block != UX_NULL)
+                {
+                    new_hid_report -> ux_host_class_hid_report_plan =  (UX_HOST_CLASS_HID_PLAN_ENTRY *) (block + block_length);
+                    _ux_utility_memory_copy(new_hid_report -> ux_host_class_hid_report_plan,
+                                            hid_report -> ux_host_class_hid_report_plan, array_length); /* Use case of memcpy is verified. */
+
+                    /* The copy is bound in the same half and not decoding.  */
+                    new_hid_report -> ux_host_class_hid_report_plan_bound =  new_hid_report -> ux_host_class_hid_report_plan +
+                                        (hid_report -> ux_host_class_hid_report_plan_bound - hid_report -> ux_host_class_hid_report_plan);
+                    new_hid_report -> ux_host_class_hid_report_plan_users =  0;
+                    new_hid_report -> ux_host_class_hid_report_plan_waiter =  UX_NULL;
+                }
+                block_length +=  UX_HOST_CLASS_HID_PARSE_CACHE_ALIGN(array_length);
+            }
+#endif
+        }
+
+        /* Terminate the list.  */
+        if (block != UX_NULL)
+            *report_link =  UX_NULL;
+    }
+
+    /* Return the length of the block.  */
+    return(block_length);
+}
+#endif
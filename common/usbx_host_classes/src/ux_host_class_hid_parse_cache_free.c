@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_free                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function frees the parse cache of the HID class, when the      */
+/*    class is unregistered.                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid_class                             Pointer to HID class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_free               Release memory block          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hid_parse_cache_free(UX_HOST_CLASS *hid_class)
+{
+
+UX_HOST_CLASS_HID_PARSE_CACHE_EXT   *cache;
+ULONG                               entry_index;
+
+
+    /* Check if the cache was allocated.  */
+    cache =  (UX_HOST_CLASS_HID_PARSE_CACHE_EXT *) hid_class -> ux_host_class_ext;
+    if (cache == UX_NULL)
+        return;
+
+    /* Free the cached reports.  */
+    for (entry_index = 0; entry_index < UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES; entry_index ++)
+    {
+        if (cache -> ux_host_class_hid_parse_cache_entries[entry_index].ux_host_class_hid_parse_cache_entry_block != UX_NULL)
+            _ux_utility_memory_free(cache -> ux_host_class_hid_parse_cache_entries[entry_index].ux_host_class_hid_parse_cache_entry_block);
+    }
+
+    /* Free the cache.  */
+    _ux_utility_memory_free(cache);
+    hid_class -> ux_host_class_ext =  UX_NULL;
+}
+#endif
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_hash                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function computes the FNV-1a hash of a report descriptor, used */
+/*    to find the descriptor in the parse cache.                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    descriptor                            Pointer to report descriptor  */
+/*    length                                Length of descriptor          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Hash of the descriptor                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _ux_host_class_hid_parse_cache_hash(UCHAR *descriptor, ULONG length)
+{
+
+ULONG       hash;
+
+
+    /* Fold each byte of the descriptor in the hash.  */
+    hash =  2166136261u;
+    while (length --)
+    {
+        hash ^=  (ULONG) *descriptor ++;
+        hash *=  16777619u;
+    }
+
+    /* Return the hash.  */
+    return(hash);
+}
+#endif
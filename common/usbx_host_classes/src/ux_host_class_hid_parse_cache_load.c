@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_load                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function looks for a report descriptor in the parse cache. If  */
+/*    the same device gave the same descriptor before, the cached reports */
+/*    are cloned in one block owned by the HID instance and the descriptor*/
+/*    does not need to be parsed.                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    descriptor                            Pointer to report descriptor  */
+/*    length                                Length of descriptor          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_copy   Copy reports                  */
+/*    _ux_host_class_hid_parse_cache_hash   Hash descriptor               */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_compare            Compare memory blocks         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_parse_cache_load(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, ULONG length)
+{
+
+UX_HOST_CLASS_HID_PARSE_CACHE_EXT   *cache;
+UX_HOST_CLASS_HID_PARSE_CACHE_ENTRY *cache_entry;
+UX_HOST_CLASS_HID_PARSER            *hid_parser;
+UX_HOST_CLASS_HID_REPORT            *hid_reports[3];
+UX_DEVICE                           *device;
+UCHAR                               *block;
+ULONG                               hash;
+ULONG                               entry_index;
+
+
+    /* Nothing is cached before the first descriptor is parsed.  */
+    cache =  (UX_HOST_CLASS_HID_PARSE_CACHE_EXT *) hid -> ux_host_class_hid_class -> ux_host_class_ext;
+    if (cache == UX_NULL)
+        return(UX_ERROR);
+
+    /* Look for the same descriptor of the same device.  */
+    device =  hid -> ux_host_class_hid_device;
+    hash =  _ux_host_class_hid_parse_cache_hash(descriptor, length);
+    for (entry_index = 0; entry_index < UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES; entry_index ++)
+    {
+
+        cache_entry =  &cache -> ux_host_class_hid_parse_cache_entries[entry_index];
+        if ((cache_entry -> ux_host_class_hid_parse_cache_entry_block != UX_NULL) &&
+            (cache_entry -> ux_host_class_hid_parse_cache_entry_descriptor_hash == hash) &&
+            (cache_entry -> ux_host_class_hid_parse_cache_entry_descriptor_length == length) &&
+            (cache_entry -> ux_host_class_hid_parse_cache_entry_vendor_id == device -> ux_device_descriptor.idVendor) &&
+            (cache_entry -> ux_host_class_hid_parse_cache_entry_product_id == device -> ux_device_descriptor.idProduct) &&
+            (cache_entry -> ux_host_class_hid_parse_cache_entry_device_release == device -> ux_device_descriptor.bcdDevice) &&
+            (_ux_utility_memory_compare(cache_entry -> ux_host_class_hid_parse_cache_entry_block +
+                                            cache_entry -> ux_host_class_hid_parse_cache_entry_reports_length,
+                                        descriptor, length) == UX_SUCCESS))
+            break;
+    }
+
+    /* Not found, the descriptor must be parsed.  */
+    if (entry_index == UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES)
+    {
+        cache -> ux_host_class_hid_parse_cache_misses ++;
+        return(UX_ERROR);
+    }
+
+    /* Clone the cached reports in one block.  */
+    block =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+                                         cache_entry -> ux_host_class_hid_parse_cache_entry_reports_length);
+    if (block == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+    _ux_host_class_hid_parse_cache_copy(hid_reports, cache_entry -> ux_host_class_hid_parse_cache_entry_reports, block);
+
+    /* The reports are now the instance ones.  */
+    hid_parser =  &hid -> ux_host_class_hid_parser;
+    hid_parser -> ux_host_class_hid_parser_input_report =  hid_reports[0];
+    hid_parser -> ux_host_class_hid_parser_output_report =  hid_reports[1];
+    hid_parser -> ux_host_class_hid_parser_feature_report =  hid_reports[2];
+    hid -> ux_host_class_hid_parse_cache_block =  block;
+    cache -> ux_host_class_hid_parse_cache_hits ++;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_store                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function stores the reports of a parsed report descriptor in   */
+/*    the parse cache, with the descriptor and the device VID, PID and    */
+/*    bcdDevice. The cache is allocated on the first store, when it is    */
+/*    full the oldest entry is replaced. A failure to store is not an     */
+/*    error, the descriptor is parsed again on the next attach.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    descriptor                            Pointer to report descriptor  */
+/*    length                                Length of descriptor          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_parse_cache_copy   Copy reports                  */
+/*    _ux_host_class_hid_parse_cache_hash   Hash descriptor               */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*    _ux_utility_memory_free               Release memory block          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hid_parse_cache_store(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, ULONG length)
+{
+
+UX_HOST_CLASS                       *hid_class;
+UX_HOST_CLASS_HID_PARSE_CACHE_EXT   *cache;
+UX_HOST_CLASS_HID_PARSE_CACHE_ENTRY *cache_entry;
+UX_HOST_CLASS_HID_PARSER            *hid_parser;
+UX_HOST_CLASS_HID_REPORT            *hid_reports[3];
+UX_DEVICE                           *device;
+UCHAR                               *block;
+ULONG                               reports_length;
+
+
+    /* Reports cloned from the cache are already there.  */
+    if (hid -> ux_host_class_hid_parse_cache_block != UX_NULL)
+        return;
+
+    /* Allocate the cache on first use.  */
+    hid_class =  hid -> ux_host_class_hid_class;
+    cache =  (UX_HOST_CLASS_HID_PARSE_CACHE_EXT *) hid_class -> ux_host_class_ext;
+    if (cache == UX_NULL)
+    {
+        cache =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HOST_CLASS_HID_PARSE_CACHE_EXT));
+        if (cache == UX_NULL)
+            return;
+        hid_class -> ux_host_class_ext =  (VOID *) cache;
+    }
+
+    /* Get the length of the reports, the descriptor follows them.  */
+    hid_parser =  &hid -> ux_host_class_hid_parser;
+    hid_reports[0] =  hid_parser -> ux_host_class_hid_parser_input_report;
+    hid_reports[1] =  hid_parser -> ux_host_class_hid_parser_output_report;
+    hid_reports[2] =  hid_parser -> ux_host_class_hid_parser_feature_report;
+    reports_length =  _ux_host_class_hid_parse_cache_copy(UX_NULL, hid_reports, UX_NULL);
+    if (UX_OVERFLOW_CHECK_ADD_ULONG(reports_length, length))
+        return;
+    block =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, reports_length + length);
+    if (block == UX_NULL)
+        return;
+
+    /* Replace the oldest entry.  */
+    cache_entry =  &cache -> ux_host_class_hid_parse_cache_entries[cache -> ux_host_class_hid_parse_cache_next_entry];
+    cache -> ux_host_class_hid_parse_cache_next_entry =  (cache -> ux_host_class_hid_parse_cache_next_entry + 1) %
+                                                            UX_HOST_CLASS_HID_PARSE_CACHE_ENTRIES;
+    if (cache_entry -> ux_host_class_hid_parse_cache_entry_block != UX_NULL)
+        _ux_utility_memory_free(cache_entry -> ux_host_class_hid_parse_cache_entry_block);
+
+    /* Copy the reports and the descriptor.  */
+    _ux_host_class_hid_parse_cache_copy(cache_entry -> ux_host_class_hid_parse_cache_entry_reports, hid_reports, block);
+    _ux_utility_memory_copy(block + reports_length, descriptor, length); /* Use case of memcpy is verified. */
+
+    /* Save the keys of the entry.  */
+    device =  hid -> ux_host_class_hid_device;
+    cache_entry -> ux_host_class_hid_parse_cache_entry_block =  block;
+    cache_entry -> ux_host_class_hid_parse_cache_entry_reports_length =  reports_length;
+    cache_entry -> ux_host_class_hid_parse_cache_entry_descriptor_length =  length;
+    cache_entry -> ux_host_class_hid_parse_cache_entry_descriptor_hash =  _ux_host_class_hid_parse_cache_hash(descriptor, length);
+    cache_entry -> ux_host_class_hid_parse_cache_entry_vendor_id =  (USHORT) device -> ux_device_descriptor.idVendor;
+    cache_entry -> ux_host_class_hid_parse_cache_entry_product_id =  (USHORT) device -> ux_device_descriptor.idProduct;
+    cache_entry -> ux_host_class_hid_parse_cache_entry_device_release =  (USHORT) device -> ux_device_descriptor.bcdDevice;
+}
+#endif
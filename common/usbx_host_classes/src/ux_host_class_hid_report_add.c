@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_report_add                       PORTABLE C      */ 
-/*                                                           6.3.0        */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -58,6 +58,8 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_item_data_get      Get data item                 */ 
+/*    _ux_host_class_hid_arena_allocate     Allocate from parser arena    */
+/*    _ux_host_class_hid_arena_free         Free to parser arena          */
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
 /*    _ux_utility_memory_copy               Copy memory block             */ 
 /*    _ux_utility_memory_free               Release memory block          */ 
@@ -82,6 +84,9 @@
 /*                                            fixed field managing issue, */
 /*                                            improved usage handling,    */
 /*                                            resulting in version 6.3.0  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used parser arena,          */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_report_add(UX_HOST_CLASS_HID *hid, UCHAR *descriptor, UX_HOST_CLASS_HID_ITEM *item)
@@ -104,7 +109,7 @@ ULONG                       current_field_address;
     hid_field_value =  _ux_host_class_hid_item_data_get(descriptor, item);
 
     /* Allocate some memory to store this new report.  */
-    new_hid_report =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HOST_CLASS_HID_REPORT));
+    new_hid_report =  _ux_host_class_hid_parser_allocate(hid, 1, sizeof(UX_HOST_CLASS_HID_REPORT));
     if (new_hid_report == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -146,7 +151,7 @@ ULONG                       current_field_address;
 
     default:
 
-        _ux_utility_memory_free(new_hid_report);
+        _ux_host_class_hid_parser_free(hid, new_hid_report);
 
         /* Error trap. */
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_HOST_CLASS_HID_REPORT_ERROR);
@@ -172,7 +177,7 @@ ULONG                       current_field_address;
     {
 
         /* So we did not need a new report after all!  */
-        _ux_utility_memory_free(new_hid_report);
+        _ux_host_class_hid_parser_free(hid, new_hid_report);
         new_hid_report =  hid_report;
     }
     else
@@ -206,7 +211,7 @@ ULONG                       current_field_address;
         return(UX_SUCCESS);
 
     /* Create the field structure.  */
-    new_hid_field =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, sizeof(UX_HOST_CLASS_HID_FIELD));
+    new_hid_field =  _ux_host_class_hid_parser_allocate(hid, 1, sizeof(UX_HOST_CLASS_HID_FIELD));
     if (new_hid_field == UX_NULL)
         return(UX_MEMORY_INSUFFICIENT);
 
@@ -238,14 +243,14 @@ ULONG                       current_field_address;
     new_hid_field -> ux_host_class_hid_field_value =  hid_field_value;
 
     /* We need some memory for the values.  */
-    new_hid_field -> ux_host_class_hid_field_values =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY,
+    new_hid_field -> ux_host_class_hid_field_values =  _ux_host_class_hid_parser_allocate(hid,
                                                                                     new_hid_field -> ux_host_class_hid_field_report_count, 4);
 
     /* Check the memory pointer. */
     if (new_hid_field -> ux_host_class_hid_field_values == UX_NULL)
     {
 
-        _ux_utility_memory_free(new_hid_field);
+        _ux_host_class_hid_parser_free(hid, new_hid_field);
         return(UX_MEMORY_INSUFFICIENT);
     }
 
@@ -256,12 +261,12 @@ ULONG                       current_field_address;
     {
 
         /* Allocate memory for the usages.  */
-        new_hid_field -> ux_host_class_hid_field_usages =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY, hid_parser -> ux_host_class_hid_parser_local.ux_host_class_hid_local_item_number_usage, 4);
+        new_hid_field -> ux_host_class_hid_field_usages =  _ux_host_class_hid_parser_allocate(hid, hid_parser -> ux_host_class_hid_parser_local.ux_host_class_hid_local_item_number_usage, 4);
         if (new_hid_field -> ux_host_class_hid_field_usages == UX_NULL)                   
         {
 
-            _ux_utility_memory_free(new_hid_field -> ux_host_class_hid_field_values);
-            _ux_utility_memory_free(new_hid_field);
+            _ux_host_class_hid_parser_free(hid, new_hid_field -> ux_host_class_hid_field_values);
+            _ux_host_class_hid_parser_free(hid, new_hid_field);
             return(UX_MEMORY_INSUFFICIENT);
         }
         
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_hid_report_descriptor_get            PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -55,9 +55,13 @@
 /*                                                                        */ 
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
+/*    _ux_host_class_hid_arena_create       Create parser arena           */
 /*    _ux_host_class_hid_global_item_parse  Parse global item             */ 
 /*    _ux_host_class_hid_local_item_parse   Parse local item              */ 
+/*    _ux_host_class_hid_parse_cache_load   Clone cached reports          */
+/*    _ux_host_class_hid_parse_cache_store  Cache parsed reports          */
 /*    _ux_host_class_hid_report_item_analyse Analyze report               */ 
+/*    _ux_host_class_hid_report_plan_compile Compile report decode plans  */
 /*    _ux_host_class_hid_resources_free     Free HID resources            */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
 /*    _ux_utility_memory_allocate           Allocate memory block         */ 
@@ -74,6 +78,11 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            compiled decode plans,      */
+/*                                            added parse cache,          */
+/*                                            added parser arena,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_hid_report_descriptor_get(UX_HOST_CLASS_HID *hid, ULONG length)
@@ -114,6 +123,22 @@ UINT                    status;
     if ((status == UX_SUCCESS) && (transfer_request -> ux_transfer_request_actual_length == length))
     {
 
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+        /* If this descriptor of this device was parsed before, clone its reports.  */
+        if (_ux_host_class_hid_parse_cache_load(hid, descriptor, length) == UX_SUCCESS)
+        {
+            _ux_utility_memory_free(start_descriptor);
+            return(UX_SUCCESS);
+        }
+#endif
+
+#if defined(UX_HOST_CLASS_HID_PARSER_ARENA)
+
+        /* Reserve the memory of the reports in one block.  */
+        _ux_host_class_hid_arena_create(hid, descriptor, length);
+#endif
+
         /* Parse the report descriptor and build the report items.  */
         while (length)
         {
@@ -185,6 +210,20 @@ UINT                    status;
         /* Descriptor length error!  */
         status = UX_DESCRIPTOR_CORRUPTED;
 
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+    /* All reports are known, compile their decode plans.  */
+    if (status == UX_SUCCESS)
+        status =  _ux_host_class_hid_report_plan_compile(hid);
+#endif
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+    /* Keep the parsed reports for the next attach of this device.  */
+    if (status == UX_SUCCESS)
+        _ux_host_class_hid_parse_cache_store(hid, start_descriptor, transfer_request -> ux_transfer_request_actual_length);
+#endif
+
     if (status != UX_SUCCESS)
     {
         /* Error trap. */
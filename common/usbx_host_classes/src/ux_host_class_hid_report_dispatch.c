@@ -0,0 +1,295 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_dispatch                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the input report of a received report buffer    */
+/*    and passes it to the callback registered by the HID client, raw,    */
+/*    decoded to the client structure or decompressed.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    report_buffer                         Pointer to report buffer      */
+/*    report_length                         Length of report              */
+/*    timestamp                             Tick time of reception        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    (ux_host_class_hid_report_callback_function)                        */
+/*                                          Callback function for report  */
+/*    _ux_host_class_hid_report_decompress  Decompress HID report         */
+/*    _ux_host_class_hid_report_plan_decode Decode report to structure    */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_free               Release memory block          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_report_dispatch(UX_HOST_CLASS_HID *hid, UCHAR *report_buffer, ULONG report_length, ULONG timestamp)
+{
+
+UX_HOST_CLASS_HID_CLIENT            *hid_client;
+UX_HOST_CLASS_HID_REPORT            *hid_report;
+UINT                                status;
+UX_HOST_CLASS_HID_REPORT_CALLBACK   callback;
+UX_HOST_CLASS_HID_CLIENT_REPORT     client_report;
+ULONG                               *client_buffer;
+UX_HOST_CLASS_HID_FIELD             *hid_field;
+ULONG                               field_report_count;
+
+#if !defined(UX_HOST_CLASS_HID_REPORT_RING)
+    UX_PARAMETER_NOT_USED(timestamp);
+#endif
+
+    /* Set Status to success. Optimistic view.  */
+    status = UX_SUCCESS;
+
+    /* Get the client instance attached to the HID.  */
+    hid_client =  hid -> ux_host_class_hid_client;
+
+    /* We know this incoming report is for the Input report.  */
+    hid_report =  hid -> ux_host_class_hid_parser.ux_host_class_hid_parser_input_report;
+
+    /* If there are multiple HID reports, report ID must be checked.  */
+    if (hid_report -> ux_host_class_hid_report_next_report != UX_NULL)
+    {
+
+        /* Scan the reports to find the report expected. */
+        while(1)
+        {
+
+            /* Check report ID at buffer start.  */
+            if (*(UCHAR*)report_buffer == hid_report -> ux_host_class_hid_report_id)
+                break;
+
+            /* If there is no more report, it's done.  */
+            if (hid_report -> ux_host_class_hid_report_next_report == UX_NULL)
+                break;
+
+            /* There is more reports, next.  */
+            hid_report = hid_report -> ux_host_class_hid_report_next_report;
+        }
+
+        /* Check if the report is what we expected.  */
+        if (*(UCHAR*)report_buffer != hid_report -> ux_host_class_hid_report_id)
+
+            /* Report not found.  */
+            hid_report = UX_NULL;
+    }
+
+    /* For this report to be used, the HID client must have registered
+       the report. We check the call back function.  */
+    if ((hid_report != UX_NULL) &&
+        (hid_report -> ux_host_class_hid_report_callback_function != UX_NULL))
+    {
+
+        /* Probe the report as it is passed to the client.  */
+        UX_HID_LATENCY_PROBE(UX_HID_LATENCY_STAGE_HOST_DISPATCH, report_buffer, report_length);
+
+        /* initialize some of the callback structure which are generic to any
+           reporting method.  */
+        callback.ux_host_class_hid_report_callback_client =  hid_client;
+        callback.ux_host_class_hid_report_callback_id =      hid_report -> ux_host_class_hid_report_id;
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+        callback.ux_host_class_hid_report_callback_timestamp =  timestamp;
+#endif
+
+        /* The report is now in memory in a raw format the application may desire to handle it that way!  */
+        if (hid_report -> ux_host_class_hid_report_callback_flags & UX_HOST_CLASS_HID_REPORT_RAW)
+        {
+
+            /* Put the length of the report in raw form in the callers callback structure.  */
+            callback.ux_host_class_hid_report_callback_actual_length =  report_length;
+            callback.ux_host_class_hid_report_callback_buffer =         report_buffer;
+
+            /* Build the callback structure status.  */
+            callback.ux_host_class_hid_report_callback_status =  status;
+    
+            /* Set the flags to indicate the type of report.  */
+            callback.ux_host_class_hid_report_callback_flags =  hid_report -> ux_host_class_hid_report_callback_flags;
+            
+            /* Call the report owner.  */
+            hid_report -> ux_host_class_hid_report_callback_function(&callback);
+        }
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+        else if (hid_report -> ux_host_class_hid_report_callback_flags & UX_HOST_CLASS_HID_REPORT_STRUCTURE)
+        {
+
+            /* The report is decoded with its plan straight into the client structure,
+               no memory is needed. A structure shorter than the bound layout is not
+               decoded and the callback gets the error.  */
+            status =  _ux_host_class_hid_report_plan_decode(hid_report, report_buffer,
+                                                            report_length,
+                                                            hid_report -> ux_host_class_hid_report_callback_buffer,
+                                                            hid_report -> ux_host_class_hid_report_callback_length);
+
+            /* Return the client structure.  */
+            callback.ux_host_class_hid_report_callback_actual_length =  hid_report -> ux_host_class_hid_report_callback_length;
+            callback.ux_host_class_hid_report_callback_buffer =         hid_report -> ux_host_class_hid_report_callback_buffer;
+
+            /* Build the callback structure status.  */
+            callback.ux_host_class_hid_report_callback_status =  status;
+
+            /* Set the flags to indicate the type of report.  */
+            callback.ux_host_class_hid_report_callback_flags =  hid_report -> ux_host_class_hid_report_callback_flags;
+
+            /* Call the report owner.  */
+            hid_report -> ux_host_class_hid_report_callback_function(&callback);
+        }
+#endif
+        else
+        {
+
+            /* The report may be decompressed, buffer length is based on number of items in report.
+               Each item is a pair of words (usage and the value itself), so the required decompress memory for each
+               item is 4 (word size) * 2 (number of word) = 8 bytes.
+               To accelerate we shift number of item by 3 to get the result.  */
+            if (UX_OVERFLOW_CHECK_MULC_ULONG(hid_report->ux_host_class_hid_report_number_item, 8))
+                client_buffer = UX_NULL;
+            else
+            {
+                client_report.ux_host_class_hid_client_report_length = hid_report->ux_host_class_hid_report_number_item << 3;
+
+                /* We need to allocate some memory to build the decompressed report.  */
+                client_buffer =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, client_report.ux_host_class_hid_client_report_length);
+            }
+
+            /* Check completion status.  */
+            if (client_buffer == UX_NULL)
+            {
+                /* We have an error of memory, do not proceed */
+                status =  UX_MEMORY_INSUFFICIENT;
+            }
+            else
+            {
+
+                /* We need to build a client structure to be used by the decompression engine.  */
+                client_report.ux_host_class_hid_client_report_buffer =         client_buffer;
+                client_report.ux_host_class_hid_client_report_actual_length =  0;
+                client_report.ux_host_class_hid_client_report =                hid_report;
+
+                /* The report buffer must be parsed and decompressed into the local buffer.  */
+                _ux_host_class_hid_report_decompress(hid, &client_report, report_buffer, report_length);
+
+                /* The report may be decompressed and returned as individual Usages.  */
+                if (hid_report -> ux_host_class_hid_report_callback_flags & UX_HOST_CLASS_HID_REPORT_INDIVIDUAL_USAGE)
+                {
+
+                    /* Now, we need to call the HID client call back function with a usage/value couple.  */
+                    hid_field =  hid_report -> ux_host_class_hid_report_field;
+
+                    /* Set the flags to indicate the type of report (usage/value couple).  */
+                    callback.ux_host_class_hid_report_callback_flags =  hid_report -> ux_host_class_hid_report_callback_flags;
+
+                    /* The length of the buffer is irrelevant here so we reset it.  */
+                    callback.ux_host_class_hid_report_callback_actual_length =  0;
+
+                    /* Scan all the fields and send each usage/value.   */
+                    while(hid_field != UX_NULL)
+                    {
+
+                        /* Build each report item.  */
+                        for (field_report_count = 0; field_report_count < hid_field -> ux_host_class_hid_field_report_count; field_report_count++)
+                        {
+
+                            /* Insert the usage and the report value into the callback structure.  */
+                            callback.ux_host_class_hid_report_callback_usage =  *client_report.ux_host_class_hid_client_report_buffer++;
+                            callback.ux_host_class_hid_report_callback_value =  *client_report.ux_host_class_hid_client_report_buffer++;
+
+                            /* Build the callback structure status.  */
+                            callback.ux_host_class_hid_report_callback_status =  status;
+
+                            /* Call the report owner */
+                            hid_report -> ux_host_class_hid_report_callback_function(&callback);
+                        }
+
+                        /* Get the next field.  */
+                        hid_field =  hid_field -> ux_host_class_hid_field_next_field;
+                    }
+                }
+                else
+                {
+
+                    /* Add the length actually valid in the caller's buffer.  */
+                    callback.ux_host_class_hid_report_callback_actual_length =  client_report.ux_host_class_hid_client_report_actual_length;
+        
+                    /* Add the caller's buffer address.  */
+                    callback.ux_host_class_hid_report_callback_buffer =  client_report.ux_host_class_hid_client_report_buffer;
+            
+                    /* Build the callback structure status.  */
+                    callback.ux_host_class_hid_report_callback_status =  status;
+        
+                    /* Set the flags to indicate the type of report.  */
+                    callback.ux_host_class_hid_report_callback_flags =  hid_report -> ux_host_class_hid_report_callback_flags;
+                
+                    /* Call the report owner.  */
+                    hid_report -> ux_host_class_hid_report_callback_function(&callback);
+                }
+
+                /* Free the memory resource we used.  */
+                _ux_utility_memory_free(client_buffer);
+            }
+        }
+    }
+
+    /* Check latest status.  */
+    if (status != UX_SUCCESS)
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, status);
+
+    /* Return completion status.  */
+    return(status);
+}
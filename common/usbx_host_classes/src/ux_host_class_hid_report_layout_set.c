@@ -0,0 +1,338 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_layout_set                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function binds the decode plan of a report to the members of   */
+/*    a client structure. Each layout entry takes the next count values   */
+/*    of its usage, in report order, and stores them from its offset in   */
+/*    the structure, size bytes each (1, 2 or 4, aligned). Values with no */
+/*    layout entry are not decoded. Array values are known by the first   */
+/*    usage of their range and stored as raw indexes. A layout count of   */
+/*    0 unbinds the whole report.                                         */
+/*                                                                        */
+/*    The report must be one of the input, output or feature reports      */
+/*    parsed for this instance.                                           */
+/*                                                                        */
+/*    The layout is bound in the copy of the plan that is not used, once  */
+/*    the decodes that may still read it are done, then the two copies    */
+/*    are swapped with interrupts disabled, so the layout can be changed  */
+/*    while reports are decoded. The decodes are waited for on the plan   */
+/*    semaphore of the instance, out of the instance lock, for at most    */
+/*    UX_HOST_CLASS_HID_PLAN_WAIT_TIMEOUT ms each time. On error the      */
+/*    previous layout is kept.                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    hid_report                            Pointer to the report         */
+/*    layout                                Array of layout entries       */
+/*    layout_count                          Number of layout entries      */
+/*    structure_length                      Client structure length       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_get                Get protection semaphore      */
+/*    _ux_host_semaphore_put                Release protection semaphore  */
+/*    _ux_host_stack_class_instance_verify  Verify class instance is valid*/
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_report_layout_set(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT *hid_report,
+                                           UX_HOST_CLASS_HID_LAYOUT *layout, ULONG layout_count, ULONG structure_length)
+{
+#if !defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+    UX_PARAMETER_NOT_USED(hid);
+    UX_PARAMETER_NOT_USED(hid_report);
+    UX_PARAMETER_NOT_USED(layout);
+    UX_PARAMETER_NOT_USED(layout_count);
+    UX_PARAMETER_NOT_USED(structure_length);
+
+    /* Plans are not compiled.  */
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+UX_INTERRUPT_SAVE_AREA
+UINT                            status;
+UX_HOST_CLASS_HID_PLAN_ENTRY    *plan;
+UX_HOST_CLASS_HID_PLAN_ENTRY    *plan_entry;
+UX_HOST_CLASS_HID_PLAN_ENTRY    *plan_end;
+UX_HOST_CLASS_HID_REPORT        *report;
+UX_HOST_CLASS_HID_REPORT        *report_lists[3];
+ULONG                           list_index;
+ULONG                           layout_index;
+ULONG                           value_count;
+ULONG                           size;
+#if !defined(UX_HOST_STANDALONE)
+UINT                            timed_out;
+#endif
+
+
+    /* Ensure the instance is valid.  */
+    if (_ux_host_stack_class_instance_verify(_ux_system_host_class_hid_name, (VOID *) hid) != UX_SUCCESS)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_HOST_CLASS_INSTANCE_UNKNOWN);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_HOST_CLASS_INSTANCE_UNKNOWN, hid, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
+    }
+
+    /* Protect thread reentry to this instance.  */
+    _ux_host_class_hid_lock_fail_return(hid);
+
+    /* The report must be one of the reports parsed for this instance.  */
+    report_lists[0] =  hid -> ux_host_class_hid_parser.ux_host_class_hid_parser_input_report;
+    report_lists[1] =  hid -> ux_host_class_hid_parser.ux_host_class_hid_parser_output_report;
+    report_lists[2] =  hid -> ux_host_class_hid_parser.ux_host_class_hid_parser_feature_report;
+    status =  UX_INVALID_PARAMETER;
+    for (list_index = 0; list_index < 3; list_index ++)
+    {
+        report =  report_lists[list_index];
+        while ((report != UX_NULL) && (report != hid_report))
+            report =  report -> ux_host_class_hid_report_next_report;
+        if (report != UX_NULL)
+        {
+            status =  UX_SUCCESS;
+            break;
+        }
+    }
+
+    /* Wait for the decodes that started before the last swap, they may
+       still read the copy that is not bound.  */
+#if !defined(UX_HOST_STANDALONE)
+    timed_out =  UX_FALSE;
+#endif
+    while (status == UX_SUCCESS)
+    {
+
+        /* The last decode done puts the plan semaphore if a waiter is registered.  */
+        UX_DISABLE
+        if (hid_report -> ux_host_class_hid_report_plan_users == 0)
+        {
+            UX_RESTORE
+            break;
+        }
+#if defined(UX_HOST_STANDALONE)
+        UX_RESTORE
+
+        /* There is no thread to wait in, try again later.  */
+        status =  UX_BUSY;
+#else
+        if (timed_out == UX_TRUE)
+        {
+            UX_RESTORE
+            status =  UX_TIMEOUT;
+            break;
+        }
+        hid_report -> ux_host_class_hid_report_plan_waiter =  &hid -> ux_host_class_hid_plan_semaphore;
+        UX_RESTORE
+
+        /* Wait out of the lock, decodes and other requests to this instance go on.  */
+        _ux_host_class_hid_unlock(hid);
+        status =  _ux_host_semaphore_get(&hid -> ux_host_class_hid_plan_semaphore,
+                                         UX_MS_TO_TICK(UX_HOST_CLASS_HID_PLAN_WAIT_TIMEOUT));
+        if (status != UX_SUCCESS)
+        {
+
+            /* No put is expected anymore, check the decodes one last time.  */
+            UX_DISABLE
+            hid_report -> ux_host_class_hid_report_plan_waiter =  UX_NULL;
+            UX_RESTORE
+            timed_out =  UX_TRUE;
+        }
+
+        /* Protect thread reentry to this instance again.  */
+        _ux_host_class_hid_lock_fail_return(hid);
+#endif
+    }
+
+    /* Bind the copy of the plan that is not used.  */
+    plan =  hid_report -> ux_host_class_hid_report_plan;
+    if ((plan != UX_NULL) && (hid_report -> ux_host_class_hid_report_plan_bound == plan))
+        plan +=  hid_report -> ux_host_class_hid_report_plan_count;
+    plan_end =  plan + hid_report -> ux_host_class_hid_report_plan_count;
+
+    /* Unbind all its entries.  */
+    plan_entry =  plan;
+    while ((status == UX_SUCCESS) && (plan_entry < plan_end))
+    {
+        plan_entry -> ux_host_class_hid_plan_entry_destination_size =  0;
+        plan_entry ++;
+    }
+
+    /* Bind the values of each layout entry.  */
+    for (layout_index = 0; (status == UX_SUCCESS) && (layout_index < layout_count); layout_index ++)
+    {
+
+        /* Check the destination: aligned members inside the structure.  */
+        size =  layout[layout_index].ux_host_class_hid_layout_size;
+        value_count =  layout[layout_index].ux_host_class_hid_layout_count;
+        if (((size != 1) && (size != 2) && (size != 4)) ||
+            (layout[layout_index].ux_host_class_hid_layout_offset & (size - 1)) ||
+            (value_count == 0) || (value_count > structure_length / size) ||
+            (layout[layout_index].ux_host_class_hid_layout_offset > structure_length - value_count * size))
+        {
+            status =  UX_INVALID_PARAMETER;
+            break;
+        }
+
+        /* Take the next values of the usage that are not bound yet.  */
+        plan_entry =  plan;
+        while ((plan_entry < plan_end) && (value_count != 0))
+        {
+            if ((plan_entry -> ux_host_class_hid_plan_entry_usage == layout[layout_index].ux_host_class_hid_layout_usage) &&
+                (plan_entry -> ux_host_class_hid_plan_entry_destination_size == 0))
+            {
+                value_count --;
+                plan_entry -> ux_host_class_hid_plan_entry_destination_size =  (UCHAR)size;
+                plan_entry -> ux_host_class_hid_plan_entry_destination_offset =  layout[layout_index].ux_host_class_hid_layout_offset +
+                                    (layout[layout_index].ux_host_class_hid_layout_count - value_count - 1) * size;
+            }
+            plan_entry ++;
+        }
+
+        /* All the values must be in the report.  */
+        if (value_count != 0)
+        {
+            status =  UX_HOST_CLASS_HID_REPORT_ERROR;
+            break;
+        }
+    }
+
+    /* Swap the copies, the decodes that start now use the new layout.  */
+    if (status == UX_SUCCESS)
+    {
+        UX_DISABLE
+        hid_report -> ux_host_class_hid_report_plan_bound =  plan;
+        hid_report -> ux_host_class_hid_report_plan_structure_length =  (layout_count != 0) ? structure_length : 0;
+        UX_RESTORE
+    }
+
+    /* Unprotect thread reentry to this instance.  */
+    _ux_host_class_hid_unlock(hid);
+
+    if (status != UX_SUCCESS)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, status);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, status, hid, 0, 0, UX_TRACE_ERRORS, 0, 0)
+    }
+
+    /* Return completion status.  */
+    return(status);
+#endif
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_class_hid_report_layout_set               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in HID report layout set function call. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*    hid_report                            Pointer to the report         */
+/*    layout                                Array of layout entries       */
+/*    layout_count                          Number of layout entries      */
+/*    structure_length                      Client structure length       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_report_layout_set  Set the report layout         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_class_hid_report_layout_set(UX_HOST_CLASS_HID *hid, UX_HOST_CLASS_HID_REPORT *hid_report,
+                                            UX_HOST_CLASS_HID_LAYOUT *layout, ULONG layout_count, ULONG structure_length)
+{
+
+    /* Sanity check.  */
+    if ((hid == UX_NULL) || (hid_report == UX_NULL) || ((layout == UX_NULL) && (layout_count != 0)))
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke report layout set function.  */
+    return(_ux_host_class_hid_report_layout_set(hid, hid_report, layout, layout_count, structure_length));
+}
@@ -0,0 +1,203 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_plan_compile              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function compiles the decode plan of all the reports, once the */
+/*    report descriptor is parsed. Each report value that is not constant */
+/*    gets a plan entry with its bit offset in the report buffer (report  */
+/*    ID byte included), its size, its usage and whether it is signed or  */
+/*    an array index. Entries are not bound to a destination until a      */
+/*    client sets a layout for the report. The plan is allocated twice    */
+/*    its size, the second copy is used to bind a new layout while the    */
+/*    first one may still be decoding.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_arena_allocate     Allocate from parser arena    */
+/*    _ux_utility_memory_allocate_mulc_safe Allocate memory block         */
+/*    _ux_utility_memory_copy               Copy memory block             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_report_plan_compile(UX_HOST_CLASS_HID *hid)
+{
+#if !defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+    UX_PARAMETER_NOT_USED(hid);
+
+    /* Plans are not compiled.  */
+    return(UX_SUCCESS);
+#else
+
+UX_HOST_CLASS_HID_PARSER        *hid_parser;
+UX_HOST_CLASS_HID_REPORT        *hid_report;
+UX_HOST_CLASS_HID_FIELD         *hid_field;
+UX_HOST_CLASS_HID_PLAN_ENTRY    *plan_entry;
+UX_HOST_CLASS_HID_REPORT        *report_lists[3];
+ULONG                           list_index;
+ULONG                           entry_count;
+ULONG                           field_report_count;
+ULONG                           report_bit_offset;
+ULONG                           usage_index;
+
+
+    /* Get the parser structure pointer.  */
+    hid_parser =  &hid -> ux_host_class_hid_parser;
+
+    /* All the report lists are compiled.  */
+    report_lists[0] =  hid_parser -> ux_host_class_hid_parser_input_report;
+    report_lists[1] =  hid_parser -> ux_host_class_hid_parser_output_report;
+    report_lists[2] =  hid_parser -> ux_host_class_hid_parser_feature_report;
+    for (list_index = 0; list_index < 3; list_index ++)
+    {
+
+        for (hid_report =  report_lists[list_index];
+             hid_report != UX_NULL;
+             hid_report =  hid_report -> ux_host_class_hid_report_next_report)
+        {
+
+            /* The buffer starts with the report ID, if any.  */
+            report_bit_offset =  (hid_report -> ux_host_class_hid_report_id != 0) ? 8 : 0;
+            hid_report -> ux_host_class_hid_report_plan_length =  hid_report -> ux_host_class_hid_report_byte_length +
+                                                                  (report_bit_offset >> 3);
+
+            /* Count the values to decode, constant fields are padding.  */
+            entry_count =  0;
+            for (hid_field =  hid_report -> ux_host_class_hid_report_field;
+                 hid_field != UX_NULL;
+                 hid_field =  hid_field -> ux_host_class_hid_field_next_field)
+            {
+                if (((hid_field -> ux_host_class_hid_field_value & UX_HOST_CLASS_HID_ITEM_CONSTANT) == 0) &&
+                    (hid_field -> ux_host_class_hid_field_report_size != 0))
+                    entry_count +=  hid_field -> ux_host_class_hid_field_report_count;
+            }
+
+            /* A report with only padding has no plan.  */
+            if (entry_count == 0)
+                continue;
+
+            /* Allocate the two copies of the plan, entries are cleared so none is bound.  */
+            plan_entry =  _ux_host_class_hid_parser_allocate(hid, entry_count, sizeof(UX_HOST_CLASS_HID_PLAN_ENTRY) * 2);
+            if (plan_entry == UX_NULL)
+                return(UX_MEMORY_INSUFFICIENT);
+            hid_report -> ux_host_class_hid_report_plan =        plan_entry;
+            hid_report -> ux_host_class_hid_report_plan_bound =  plan_entry;
+            hid_report -> ux_host_class_hid_report_plan_count =  entry_count;
+
+            /* Build one entry per value.  */
+            for (hid_field =  hid_report -> ux_host_class_hid_report_field;
+                 hid_field != UX_NULL;
+                 hid_field =  hid_field -> ux_host_class_hid_field_next_field)
+            {
+
+                if (((hid_field -> ux_host_class_hid_field_value & UX_HOST_CLASS_HID_ITEM_CONSTANT) != 0) ||
+                    (hid_field -> ux_host_class_hid_field_report_size == 0))
+                    continue;
+
+                for (field_report_count = 0; field_report_count < hid_field -> ux_host_class_hid_field_report_count; field_report_count++)
+                {
+
+                    plan_entry -> ux_host_class_hid_plan_entry_bit_offset =  report_bit_offset +
+                                                                              hid_field -> ux_host_class_hid_field_report_offset +
+                                                                              field_report_count * hid_field -> ux_host_class_hid_field_report_size;
+                    plan_entry -> ux_host_class_hid_plan_entry_bit_size =  (UCHAR)hid_field -> ux_host_class_hid_field_report_size;
+
+                    if (hid_field -> ux_host_class_hid_field_value & UX_HOST_CLASS_HID_ITEM_VARIABLE)
+                    {
+
+                        /* The usage of a variable value is in the usage table, the
+                           last usage applies to the values that are left.  */
+                        if (hid_field -> ux_host_class_hid_field_number_usage != 0)
+                        {
+                            usage_index =  field_report_count;
+                            if (usage_index >= hid_field -> ux_host_class_hid_field_number_usage)
+                                usage_index =  hid_field -> ux_host_class_hid_field_number_usage - 1;
+                            plan_entry -> ux_host_class_hid_plan_entry_usage =  hid_field -> ux_host_class_hid_field_usages[usage_index];
+                        }
+
+                        /* Values with negative logical minimum are sign extended.  */
+                        if (hid_field -> ux_host_class_hid_field_logical_min < 0)
+                            plan_entry -> ux_host_class_hid_plan_entry_flags =  UX_HOST_CLASS_HID_PLAN_SIGNED;
+                    }
+                    else
+                    {
+
+                        /* The value of an array is an index in the usage range, the
+                           entry is known by the first usage of the range.  */
+                        plan_entry -> ux_host_class_hid_plan_entry_usage =  hid_field -> ux_host_class_hid_field_usage_min |
+                                                                            (hid_field -> ux_host_class_hid_field_usage_page << 16);
+                        plan_entry -> ux_host_class_hid_plan_entry_flags =  UX_HOST_CLASS_HID_PLAN_ARRAY;
+                    }
+
+                    /* Next entry.  */
+                    plan_entry ++;
+                }
+            }
+
+            /* The second copy starts the same.  */
+            _ux_utility_memory_copy(plan_entry, hid_report -> ux_host_class_hid_report_plan,
+                                    entry_count * sizeof(UX_HOST_CLASS_HID_PLAN_ENTRY)); /* Use case of memcpy is verified. */
+        }
+    }
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+#endif
+}
@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_plan_decode               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function decodes a report into the client structure bound by   */
+/*    the report layout. The report buffer starts with the report ID, if  */
+/*    any. Each bound plan entry is extracted at its bit offset, sign     */
+/*    extended if signed and stored in its structure member. Values that  */
+/*    are not bound, or beyond the received length, are left unchanged.   */
+/*    Nothing is decoded if the structure is shorter than the one bound.  */
+/*                                                                        */
+/*    The bound copy of the plan is taken with interrupts disabled and    */
+/*    counted as used until the decode is done, so a new layout is never  */
+/*    bound in it meanwhile. The last decode done wakes up the layout set */
+/*    waiting for it.                                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid_report                            Pointer to the report         */
+/*    report_buffer                         Pointer to report buffer      */
+/*    report_length                         Length of report              */
+/*    structure                             Client structure              */
+/*    structure_length                      Client structure length       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_put                Put semaphore                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_report_plan_decode(UX_HOST_CLASS_HID_REPORT *hid_report, UCHAR *report_buffer,
+                                            ULONG report_length, VOID *structure, ULONG structure_length)
+{
+#if !defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+    UX_PARAMETER_NOT_USED(hid_report);
+    UX_PARAMETER_NOT_USED(report_buffer);
+    UX_PARAMETER_NOT_USED(report_length);
+    UX_PARAMETER_NOT_USED(structure);
+    UX_PARAMETER_NOT_USED(structure_length);
+
+    /* Plans are not compiled.  */
+    return(UX_FUNCTION_NOT_SUPPORTED);
+#else
+
+UX_INTERRUPT_SAVE_AREA
+UX_HOST_CLASS_HID_PLAN_ENTRY    *plan_entry;
+UX_HOST_CLASS_HID_PLAN_ENTRY    *plan_end;
+UCHAR                           *report_pointer;
+UCHAR                           *destination;
+ULONG64                         report_bits;
+ULONG                           bit_offset;
+ULONG                           bit_size;
+ULONG                           bit_limit;
+ULONG                           byte_count;
+ULONG                           value;
+ULONG                           value_mask;
+UX_SEMAPHORE                    *waiter;
+
+
+    /* Take the bound copy of the plan, the structure must hold all its members.  */
+    UX_DISABLE
+    if (structure_length < hid_report -> ux_host_class_hid_report_plan_structure_length)
+    {
+        UX_RESTORE
+        return(UX_BUFFER_OVERFLOW);
+    }
+    plan_entry =  hid_report -> ux_host_class_hid_report_plan_bound;
+    hid_report -> ux_host_class_hid_report_plan_users ++;
+    UX_RESTORE
+    plan_end =  plan_entry + hid_report -> ux_host_class_hid_report_plan_count;
+
+    /* Values must be fully received to be decoded.  */
+    bit_limit =  report_length << 3;
+
+    for (; plan_entry < plan_end; plan_entry ++)
+    {
+
+        /* Skip the values the client does not want.  */
+        if (plan_entry -> ux_host_class_hid_plan_entry_destination_size == 0)
+            continue;
+
+        bit_offset =  plan_entry -> ux_host_class_hid_plan_entry_bit_offset;
+        bit_size =    plan_entry -> ux_host_class_hid_plan_entry_bit_size;
+        if (bit_offset + bit_size > bit_limit)
+            continue;
+
+        /* Load the bytes covering the value, at most 5 for 32 bits.  */
+        report_pointer =  report_buffer + (bit_offset >> 3);
+        bit_offset &=  7;
+        byte_count =  (bit_offset + bit_size + 7) >> 3;
+        report_bits =  0;
+        while (byte_count --)
+            report_bits |=  (ULONG64)report_pointer[byte_count] << (byte_count << 3);
+
+        /* Shift and mask the value out.  */
+        value_mask =  (bit_size >= 32) ? 0xFFFFFFFFu : (((ULONG)1 << bit_size) - 1);
+        value =  (ULONG)(report_bits >> bit_offset) & value_mask;
+
+        /* Sign extend negative values.  */
+        if ((plan_entry -> ux_host_class_hid_plan_entry_flags & UX_HOST_CLASS_HID_PLAN_SIGNED) &&
+            (value & ~(value_mask >> 1)))
+            value |=  ~value_mask;
+
+        /* Store the value in its structure member.  */
+        destination =  (UCHAR *)structure + plan_entry -> ux_host_class_hid_plan_entry_destination_offset;
+        switch (plan_entry -> ux_host_class_hid_plan_entry_destination_size)
+        {
+
+        case 1:
+            *destination =  (UCHAR)value;
+            break;
+
+        case 2:
+            *(USHORT *)destination =  (USHORT)value;
+            break;
+
+        default:
+            *(ULONG *)destination =  value;
+            break;
+        }
+    }
+
+    /* The copy of the plan is no longer used, wake up the layout set waiting for the last decode.  */
+    UX_DISABLE
+    hid_report -> ux_host_class_hid_report_plan_users --;
+    waiter =  UX_NULL;
+    if (hid_report -> ux_host_class_hid_report_plan_users == 0)
+    {
+        waiter =  hid_report -> ux_host_class_hid_report_plan_waiter;
+        hid_report -> ux_host_class_hid_report_plan_waiter =  UX_NULL;
+    }
+    UX_RESTORE
+    if (waiter != UX_NULL)
+        _ux_host_semaphore_put(waiter);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+#endif
+}
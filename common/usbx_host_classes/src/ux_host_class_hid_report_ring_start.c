@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_ring_start                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets up the ring of input report buffers of the HID   */
+/*    instance and starts its worker thread. The ring takes the place of  */
+/*    the interrupt transfer buffer.                                      */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_report_ring_stop   Stop report ring              */
+/*    _ux_host_semaphore_create             Create semaphore              */
+/*    _ux_host_thread_create                Create thread                 */
+/*    _ux_utility_memory_allocate           Allocate memory block         */
+/*    _ux_utility_memory_allocate_mulc_safe Allocate memory table         */
+/*    _ux_utility_memory_free               Release memory block          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_report_ring_start(UX_HOST_CLASS_HID *hid)
+{
+
+UX_TRANSFER     *transfer_request;
+UCHAR           *buffer;
+ULONG           slot_size;
+ULONG           slot_index;
+UINT            status;
+
+
+    /* Get the transfer request of the interrupt endpoint.  */
+    transfer_request =  &hid -> ux_host_class_hid_interrupt_endpoint -> ux_endpoint_transfer_request;
+
+    /* Each report buffer holds a full packet, keep the buffers aligned.  */
+    slot_size =  (transfer_request -> ux_transfer_request_requested_length + 3u) & ~3u;
+
+    /* Allocate all the report buffers at once.  */
+    buffer =  _ux_utility_memory_allocate_mulc_safe(UX_SAFE_ALIGN, UX_CACHE_SAFE_MEMORY,
+                                                    UX_HOST_CLASS_HID_REPORT_RING_DEPTH, slot_size);
+    if (buffer == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* The ring replaces the buffer of the transfer request, it is freed with
+       the transfer request.  */
+    _ux_utility_memory_free(transfer_request -> ux_transfer_request_data_pointer);
+    transfer_request -> ux_transfer_request_data_pointer =  buffer;
+    hid -> ux_host_class_hid_ring_buffer =  buffer;
+
+    /* Set the report buffers, the transfer receives in the first one.  */
+    for (slot_index = 0; slot_index < UX_HOST_CLASS_HID_REPORT_RING_DEPTH; slot_index ++)
+    {
+        hid -> ux_host_class_hid_ring_slots[slot_index].ux_host_class_hid_ring_slot_buffer =  buffer;
+        buffer +=  slot_size;
+    }
+    hid -> ux_host_class_hid_ring_head =  0;
+    hid -> ux_host_class_hid_ring_tail =  0;
+
+    /* Create the semaphore to wake up the worker thread.  */
+    status =  _ux_host_semaphore_create(&hid -> ux_host_class_hid_ring_semaphore, "ux_host_class_hid_ring_semaphore", 0);
+    if (status != UX_SUCCESS)
+        status =  UX_SEMAPHORE_ERROR;
+
+    /* Allocate the stack of the worker thread.  */
+    if (status == UX_SUCCESS)
+    {
+        hid -> ux_host_class_hid_ring_thread_stack =  _ux_utility_memory_allocate(UX_NO_ALIGN, UX_REGULAR_MEMORY, UX_THREAD_STACK_SIZE);
+        if (hid -> ux_host_class_hid_ring_thread_stack == UX_NULL)
+            status =  UX_MEMORY_INSUFFICIENT;
+    }
+
+    /* Create the worker thread, it waits for the first report.  */
+    if (status == UX_SUCCESS)
+    {
+        status =  _ux_host_thread_create(&hid -> ux_host_class_hid_ring_thread, "ux_host_class_hid_ring_thread",
+                                         _ux_host_class_hid_report_ring_thread, (ULONG) (ALIGN_TYPE) hid,
+                                         hid -> ux_host_class_hid_ring_thread_stack, UX_THREAD_STACK_SIZE,
+                                         UX_THREAD_PRIORITY_CLASS, UX_THREAD_PRIORITY_CLASS,
+                                         UX_NO_TIME_SLICE, UX_AUTO_START);
+        if (status == UX_SUCCESS)
+        {
+            UX_THREAD_EXTENSION_PTR_SET(&(hid -> ux_host_class_hid_ring_thread), hid)
+        }
+        else
+            status =  UX_THREAD_ERROR;
+    }
+
+    /* On error, free what is created.  */
+    if (status != UX_SUCCESS)
+        _ux_host_class_hid_report_ring_stop(hid);
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_ring_stop                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function stops the worker thread of the input report ring and  */
+/*    frees its resources. The report buffers are given back to the       */
+/*    interrupt transfer request. The interrupt transfer must be stopped. */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_semaphore_delete             Delete semaphore              */
+/*    _ux_host_thread_delete                Delete thread                 */
+/*    _ux_host_thread_schedule_other        Schedule other threads        */
+/*    _ux_utility_memory_free               Release memory block          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    HID Class                                                           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_hid_report_ring_stop(UX_HOST_CLASS_HID *hid)
+{
+
+
+    /* Check if the ring is started.  */
+    if (hid -> ux_host_class_hid_ring_buffer == UX_NULL)
+        return(UX_SUCCESS);
+
+    /* Delete the worker thread, after it is done with the report it may be
+       dispatching.  */
+    if (hid -> ux_host_class_hid_ring_thread_stack != UX_NULL)
+    {
+        if (_ux_host_thread_created(&hid -> ux_host_class_hid_ring_thread))
+        {
+            _ux_host_thread_schedule_other(UX_THREAD_PRIORITY_ENUM);
+            _ux_host_thread_delete(&hid -> ux_host_class_hid_ring_thread);
+        }
+        _ux_utility_memory_free(hid -> ux_host_class_hid_ring_thread_stack);
+        hid -> ux_host_class_hid_ring_thread_stack =  UX_NULL;
+    }
+
+    /* Delete the worker semaphore.  */
+    if (_ux_host_semaphore_created(&hid -> ux_host_class_hid_ring_semaphore))
+        _ux_host_semaphore_delete(&hid -> ux_host_class_hid_ring_semaphore);
+
+    /* Give the ring back to the transfer request as a single buffer, it is
+       freed with the transfer request.  */
+    hid -> ux_host_class_hid_interrupt_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_data_pointer =
+                                                    hid -> ux_host_class_hid_ring_buffer;
+    hid -> ux_host_class_hid_ring_buffer =  UX_NULL;
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   HID Class                                                           */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_hid.h"
+#include "ux_host_stack.h"
+
+
+
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_hid_report_ring_thread               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This file contains the worker thread of the input report ring. It   */
+/*    dispatches the reports queued by the interrupt transfer completion  */
+/*    to the HID client, oldest first, and frees their buffers.           */
+/*                                                                        */
+/*    It's for RTOS mode.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    hid                                   Pointer to HID class          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_hid_report_dispatch    Dispatch HID report           */
+/*    _ux_host_semaphore_get                Get signal semaphore          */
+/*    _ux_utility_time_get                  Get system time               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    ThreadX                                                             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_host_class_hid_report_ring_thread(ULONG thread_input)
+{
+
+UX_HOST_CLASS_HID               *hid;
+UX_HOST_CLASS_HID_RING_SLOT     *slot;
+ULONG                           tail;
+ULONG                           elapsed;
+UINT                            status;
+
+    /* Cast the thread_input variable into the proper format.  */
+    UX_THREAD_EXTENSION_PTR_GET(hid, UX_HOST_CLASS_HID, thread_input)
+
+    /* Loop forever waiting for reports signaled through the semaphore.  */
+    while (1)
+    {
+
+        /* Wait for reports to be published by the completion path.  */
+        status =  _ux_host_semaphore_get(&hid -> ux_host_class_hid_ring_semaphore, UX_WAIT_FOREVER);
+
+        /* The thread should terminate upon a semaphore error.  */
+        if (status != UX_SUCCESS)
+            return;
+
+        /* Dispatch all the pending reports, unless the HID is shutting down.  */
+        tail =  hid -> ux_host_class_hid_ring_tail;
+        while ((tail != hid -> ux_host_class_hid_ring_head) &&
+               (hid -> ux_host_class_hid_state != UX_HOST_CLASS_INSTANCE_SHUTDOWN))
+        {
+
+            /* Get the oldest report.  */
+            slot =  &hid -> ux_host_class_hid_ring_slots[tail & (UX_HOST_CLASS_HID_REPORT_RING_DEPTH - 1)];
+
+            /* Keep the longest time a report waited in the ring.  */
+            elapsed =  _ux_utility_time_elapsed(slot -> ux_host_class_hid_ring_slot_timestamp, _ux_utility_time_get());
+            if (elapsed > hid -> ux_host_class_hid_ring_statistics.ux_host_class_hid_ring_statistics_latency_max)
+                hid -> ux_host_class_hid_ring_statistics.ux_host_class_hid_ring_statistics_latency_max =  elapsed;
+
+            /* Decode the report and call the HID client.  */
+            _ux_host_class_hid_report_dispatch(hid, slot -> ux_host_class_hid_ring_slot_buffer,
+                                               slot -> ux_host_class_hid_ring_slot_length,
+                                               slot -> ux_host_class_hid_ring_slot_timestamp);
+
+            /* Free the buffer for the completion path.  */
+            tail ++;
+            hid -> ux_host_class_hid_ring_tail =  tail;
+        }
+    }
+}
+#endif
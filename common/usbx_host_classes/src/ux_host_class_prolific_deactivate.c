@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_prolific_deactivate                  PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,6 +63,7 @@
 /*    _ux_host_semaphore_get                Get protection semaphore      */ 
 /*    _ux_host_semaphore_delete             Delete protection semaphore   */ 
 /*    _ux_utility_thread_schedule_other     Schedule other threads        */
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -78,6 +79,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_prolific_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -86,6 +90,10 @@ UINT  _ux_host_class_prolific_deactivate(UX_HOST_CLASS_COMMAND *command)
 UX_HOST_CLASS_PROLIFIC      *prolific;
 UX_TRANSFER                 *transfer_request;
 UINT                        status;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UX_HOST_CLASS_PROLIFIC_RECEPTION
+                            *prolific_reception;
+#endif
 
 
     /* Get the instance for this class.  */
@@ -125,6 +133,17 @@ UINT                        status;
         /* We need to abort transactions on the bulk In pipe.  */
         _ux_host_stack_endpoint_transfer_abort(prolific -> ux_host_class_prolific_bulk_in_endpoint);
     
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* A streaming reception has its transfers on the bulk In pipe, free them.  */
+    prolific_reception =  prolific -> ux_host_class_prolific_reception;
+    if ((prolific_reception != UX_NULL) &&
+        (prolific_reception -> ux_host_class_prolific_reception_transfer_count != 0))
+    {
+        prolific_reception -> ux_host_class_prolific_reception_state =  UX_HOST_CLASS_PROLIFIC_RECEPTION_STATE_STOPPED;
+        _ux_host_class_serial_stream_stop(&prolific_reception -> ux_host_class_prolific_reception_stream);
+    }
+#endif
     
     /* Then endpoint OUT.  */       
     transfer_request =  &prolific -> ux_host_class_prolific_bulk_out_endpoint -> ux_endpoint_transfer_request;
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_prolific_reception_callback          PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,6 +57,9 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
+/*    _ux_host_class_serial_stream_completed                              */
+/*                                          Complete stream transfer      */
+/*    _ux_host_class_serial_stream_arm      Arm stream transfers          */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -69,6 +72,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _ux_host_class_prolific_reception_callback (UX_TRANSFER *transfer_request)
@@ -76,6 +82,9 @@ VOID  _ux_host_class_prolific_reception_callback (UX_TRANSFER *transfer_request)
 
 UX_HOST_CLASS_PROLIFIC               *prolific;
 UX_HOST_CLASS_PROLIFIC_RECEPTION     *prolific_reception;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UINT                                status;
+#endif
     
     /* Get the class instance for this transfer request.  */
     prolific =  (UX_HOST_CLASS_PROLIFIC *) transfer_request -> ux_transfer_request_class_instance;
@@ -83,6 +92,45 @@ UX_HOST_CLASS_PROLIFIC_RECEPTION     *prolific_reception;
     /* Get the pointer to the prolific reception structure.  */
     prolific_reception =  prolific -> ux_host_class_prolific_reception;
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Stream transfers are not the endpoint transfer request, they point to their reception.  */
+    if (transfer_request != &prolific -> ux_host_class_prolific_bulk_in_endpoint -> ux_endpoint_transfer_request)
+    {
+
+        /* Keep the block received for the application.  */
+        prolific_reception =  (UX_HOST_CLASS_PROLIFIC_RECEPTION *) transfer_request -> ux_transfer_request_user_specific;
+        status =  _ux_host_class_serial_stream_completed(&prolific_reception -> ux_host_class_prolific_reception_stream, transfer_request);
+
+        /* If there is an error or the reception is stopped, we do not proceed.  */
+        if ((status != UX_SUCCESS) && (status != UX_BUFFER_OVERFLOW))
+        {
+
+            /* The reception is stopped.  */
+            prolific_reception -> ux_host_class_prolific_reception_state =  UX_HOST_CLASS_PROLIFIC_RECEPTION_STATE_STOPPED;
+            return;
+        }
+
+        /* Report the data received to the application, it stays in the buffer until released.  */
+        if (prolific_reception -> ux_host_class_prolific_reception_callback != UX_NULL)
+        {
+            prolific_reception -> ux_host_class_prolific_reception_callback(prolific, UX_SUCCESS,
+                                    transfer_request -> ux_transfer_request_data_pointer,
+                                    transfer_request -> ux_transfer_request_actual_length);
+
+            /* Report the overflow, the reception goes on when data is released.  */
+            if (status == UX_BUFFER_OVERFLOW)
+                prolific_reception -> ux_host_class_prolific_reception_callback(prolific, UX_BUFFER_OVERFLOW, UX_NULL, 0);
+        }
+
+        /* Arm transfers on free blocks.  */
+        _ux_host_class_serial_stream_arm(&prolific_reception -> ux_host_class_prolific_reception_stream);
+
+        /* There is no status to be reported back to the stack.  */
+        return;
+    }
+#endif
+
     /* Check the state of the transfer.  If there is an error, we do not proceed with this report.  */
     if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
     {
@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Prolific Class                                                      */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_prolific.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_prolific_reception_span_get          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the oldest data of a streaming reception      */
+/*    that is not released yet. The data is returned in place, as a span  */
+/*    of the reception buffer: a span goes on in the next block only if   */
+/*    the block is full and the next block follows it in the buffer.      */
+/*                                                                        */
+/*    The data stays in the buffer until it is released by                */
+/*    _ux_host_class_prolific_reception_span_release. If there is no      */
+/*    data, the span length is 0.                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    prolific                              Pointer to prolific class     */
+/*    span_buffer                           Pointer to span address       */
+/*    span_length                           Pointer to span length        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_span_get Get span of stream data       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_prolific_reception_span_get(UX_HOST_CLASS_PROLIFIC *prolific, UCHAR **span_buffer, ULONG *span_length)
+{
+
+UX_HOST_CLASS_PROLIFIC_RECEPTION  *prolific_reception;
+
+
+    /* Ensure the instance is valid.  */
+    if (prolific -> ux_host_class_prolific_state !=  UX_HOST_CLASS_INSTANCE_LIVE)
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_HOST_CLASS_INSTANCE_UNKNOWN);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_HOST_CLASS_INSTANCE_UNKNOWN, prolific, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
+    }
+
+    /* The reception must be streaming.  */
+    prolific_reception =  prolific -> ux_host_class_prolific_reception;
+    if ((prolific_reception == UX_NULL) ||
+        (prolific_reception -> ux_host_class_prolific_reception_transfer_count == 0))
+        return(UX_ERROR);
+
+    /* Get the span from the stream.  */
+    return(_ux_host_class_serial_stream_span_get(&prolific_reception -> ux_host_class_prolific_reception_stream, span_buffer, span_length));
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _uxe_host_class_prolific_reception_span_get         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in PROLIFIC reception span get          */
+/*    function call.                                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    prolific                              Pointer to prolific class     */
+/*    span_buffer                           Pointer to span address       */
+/*    span_length                           Pointer to span length        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Status                                                              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_prolific_reception_span_get                          */
+/*                                          Get span of received data     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _uxe_host_class_prolific_reception_span_get(UX_HOST_CLASS_PROLIFIC *prolific, UCHAR **span_buffer, ULONG *span_length)
+{
+
+    /* Sanity checks.  */
+    if ((prolific == UX_NULL) || (span_buffer == UX_NULL) || (span_length == UX_NULL))
+        return(UX_INVALID_PARAMETER);
+
+    /* Invoke PROLIFIC reception span get function.  */
+    return(_ux_host_class_prolific_reception_span_get(prolific, span_buffer, span_length));
+}
+#endif
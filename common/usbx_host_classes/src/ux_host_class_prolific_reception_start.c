@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_prolific_reception_start             PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -60,6 +60,7 @@
 /*  CALLS                                                                 */ 
 /*                                                                        */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
+/*    _ux_host_class_serial_stream_start    Start serial stream           */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -72,6 +73,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_prolific_reception_start (UX_HOST_CLASS_PROLIFIC *prolific, 
@@ -97,6 +101,43 @@ UINT            status;
         return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
     }
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Check if the reception is streaming.  */
+    if (prolific_reception -> ux_host_class_prolific_reception_transfer_count != 0)
+    {
+
+        /* Completions may be notified through an event flags group shared with other ports.  */
+        prolific_reception -> ux_host_class_prolific_reception_stream.ux_host_class_serial_stream_event_flags_group =
+                                    prolific_reception -> ux_host_class_prolific_reception_event_flags_group;
+        prolific_reception -> ux_host_class_prolific_reception_stream.ux_host_class_serial_stream_event_flags =
+                                    prolific_reception -> ux_host_class_prolific_reception_event_flags;
+
+        /* Start the stream on the bulk in endpoint, the transfers point to this reception.  */
+        status =  _ux_host_class_serial_stream_start(&prolific_reception -> ux_host_class_prolific_reception_stream,
+                                    prolific -> ux_host_class_prolific_bulk_in_endpoint,
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+                                    &prolific -> ux_host_class_prolific_statistics,
+#else
+                                    UX_NULL,
+#endif
+                                    prolific_reception -> ux_host_class_prolific_reception_data_buffer,
+                                    prolific_reception -> ux_host_class_prolific_reception_data_buffer_size,
+                                    prolific_reception -> ux_host_class_prolific_reception_block_size,
+                                    prolific_reception -> ux_host_class_prolific_reception_transfer_count,
+                                    _ux_host_class_prolific_reception_callback, (VOID *) prolific, (VOID *) prolific_reception);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        /* Save the reception structure in the prolific structure.  */
+        prolific -> ux_host_class_prolific_reception = prolific_reception;
+
+        /* And declare we have transfers in progress.  */
+        prolific_reception -> ux_host_class_prolific_reception_state =  UX_HOST_CLASS_PROLIFIC_RECEPTION_STATE_STARTED;
+        return(UX_SUCCESS);
+    }
+#endif
+
     /* Start by aligning the head and tail of buffers to the same address supplied by the application.  */
     prolific_reception -> ux_host_class_prolific_reception_data_head =  prolific_reception -> ux_host_class_prolific_reception_data_buffer;
     prolific_reception -> ux_host_class_prolific_reception_data_tail =  prolific_reception -> ux_host_class_prolific_reception_data_buffer;
@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_arm                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function arms the transfer requests of a serial stream on the  */
+/*    free blocks of the reception buffer, in buffer order. Transfers     */
+/*    are armed as long as less than the transfer count are outstanding   */
+/*    and a block is not waiting for the application. Only one context    */
+/*    arms the stream at a time, the others leave the blocks they freed   */
+/*    to it.                                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Pointer to serial stream      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_stream_arm(UX_HOST_CLASS_SERIAL_STREAM *stream)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+UX_TRANSFER     *transfer_request;
+ULONG           block;
+UINT            status =  UX_SUCCESS;
+
+
+    /* We need to disable interrupts here, the blocks are also updated by
+       the transfer completion.  */
+    UX_DISABLE
+
+    /* Is another context arming the stream? It will arm the blocks we freed.  */
+    if (stream -> ux_host_class_serial_stream_arming == UX_TRUE)
+    {
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+        return(UX_SUCCESS);
+    }
+    stream -> ux_host_class_serial_stream_arming =  UX_TRUE;
+
+    /* Arm free blocks until enough transfers are outstanding.  */
+    while ((stream -> ux_host_class_serial_stream_state == UX_HOST_CLASS_SERIAL_STREAM_STATE_STARTED) &&
+           (stream -> ux_host_class_serial_stream_transfers_pending < stream -> ux_host_class_serial_stream_transfer_count) &&
+           (stream -> ux_host_class_serial_stream_blocks_filled + stream -> ux_host_class_serial_stream_transfers_pending <
+            stream -> ux_host_class_serial_stream_block_count))
+    {
+
+        /* The next block follows the ones being received.  */
+        block =  (stream -> ux_host_class_serial_stream_block_head + stream -> ux_host_class_serial_stream_transfers_pending) %
+                  stream -> ux_host_class_serial_stream_block_count;
+
+        /* Transfer requests complete in order, the next one is free.  */
+        transfer_request =  &stream -> ux_host_class_serial_stream_transfer_requests[stream -> ux_host_class_serial_stream_transfer_next];
+        stream -> ux_host_class_serial_stream_transfer_next ++;
+        if (stream -> ux_host_class_serial_stream_transfer_next == stream -> ux_host_class_serial_stream_transfer_count)
+            stream -> ux_host_class_serial_stream_transfer_next =  0;
+        stream -> ux_host_class_serial_stream_transfers_pending ++;
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+
+        /* Setup the transfer to receive the block.  */
+        transfer_request -> ux_transfer_request_data_pointer =      stream -> ux_host_class_serial_stream_buffer +
+                                                                    block * stream -> ux_host_class_serial_stream_block_size;
+        transfer_request -> ux_transfer_request_requested_length =  stream -> ux_host_class_serial_stream_block_size;
+
+        /* Arm the transfer request.  */
+        status =  _ux_host_stack_transfer_request(transfer_request);
+
+        /* Disable interrupts again to check the next block.  */
+        UX_DISABLE
+
+        /* Did we successfully arm the transfer?  */
+        if (status != UX_SUCCESS)
+        {
+
+            /* Keep the block free, it is armed again on next completion or release.  */
+            if (stream -> ux_host_class_serial_stream_transfer_next == 0)
+                stream -> ux_host_class_serial_stream_transfer_next =  stream -> ux_host_class_serial_stream_transfer_count;
+            stream -> ux_host_class_serial_stream_transfer_next --;
+            stream -> ux_host_class_serial_stream_transfers_pending --;
+            break;
+        }
+    }
+
+    /* We are done arming.  */
+    stream -> ux_host_class_serial_stream_arming =  UX_FALSE;
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Return the status of the last transfer armed.  */
+    return(status);
+}
+#endif
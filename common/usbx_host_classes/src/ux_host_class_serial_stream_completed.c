@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_completed              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the completion function of a serial      */
+/*    class when a stream transfer is completed. The block received is    */
+/*    kept for the application and the port statistics, if enabled, are   */
+/*    updated. A zero length packet received in an empty buffer frees     */
+/*    its block at once, so that the buffer head always has data.         */
+/*                                                                        */
+/*    When no block is free, UX_BUFFER_OVERFLOW is returned and the       */
+/*    device is NAKed until the application releases data. If the         */
+/*    transfer failed or the stream is stopped, the stream is stopped and */
+/*    an error is returned. The class reports the data to the             */
+/*    application, then calls _ux_host_class_serial_stream_arm.           */
+/*                                                                        */
+/*    If the stream has an event flags group, its flags are set when a    */
+/*    block is received in an empty buffer or when a transfer fails, the  */
+/*    application thread serving several streams is woken once per burst  */
+/*    of data instead of once per block.                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Pointer to serial stream      */
+/*    transfer_request                      Pointer to transfer request   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_event_flags_set              Set event flags               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_stream_completed(UX_HOST_CLASS_SERIAL_STREAM *stream, UX_TRANSFER *transfer_request)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+UX_HOST_CLASS_SERIAL_STATISTICS     *statistics;
+#endif
+ULONG                               block;
+ULONG                               event_flags =  0;
+UINT                                status;
+
+
+    /* We need to disable interrupts here, blocks are also updated by the application.  */
+    UX_DISABLE
+
+    /* This transfer is done.  */
+    stream -> ux_host_class_serial_stream_transfers_pending --;
+
+    /* If there is an error or the stream is stopped, we do not proceed.  */
+    status =  transfer_request -> ux_transfer_request_completion_code;
+    if ((status != UX_SUCCESS) ||
+        (stream -> ux_host_class_serial_stream_state != UX_HOST_CLASS_SERIAL_STREAM_STATE_STARTED))
+    {
+
+        /* The stream is stopped, the application is notified if it was started.  */
+        if (stream -> ux_host_class_serial_stream_state == UX_HOST_CLASS_SERIAL_STREAM_STATE_STARTED)
+            event_flags =  stream -> ux_host_class_serial_stream_event_flags;
+        stream -> ux_host_class_serial_stream_state =  UX_HOST_CLASS_SERIAL_STREAM_STATE_STOPPED;
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+
+        /* Wake up the application thread serving this stream.  */
+        if ((event_flags != 0) && (stream -> ux_host_class_serial_stream_event_flags_group != UX_NULL))
+            _ux_host_event_flags_set(stream -> ux_host_class_serial_stream_event_flags_group, event_flags, UX_OR);
+        return((status != UX_SUCCESS) ? status : UX_ERROR);
+    }
+
+    /* Transfers complete in order, this is the block at head.  */
+    block =  stream -> ux_host_class_serial_stream_block_head;
+    stream -> ux_host_class_serial_stream_block_head =  (block + 1) % stream -> ux_host_class_serial_stream_block_count;
+
+    /* A zero length packet in an empty buffer has nothing for the application, the block is free
+       again. Otherwise it follows data and is freed with it by the release.  */
+    if ((transfer_request -> ux_transfer_request_actual_length == 0) &&
+        (stream -> ux_host_class_serial_stream_blocks_filled == 0))
+    {
+        stream -> ux_host_class_serial_stream_block_tail =  stream -> ux_host_class_serial_stream_block_head;
+        stream -> ux_host_class_serial_stream_block_offset =  0;
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+        return(UX_SUCCESS);
+    }
+
+    /* Keep its data for the application.  */
+    stream -> ux_host_class_serial_stream_block_lengths[block] =  transfer_request -> ux_transfer_request_actual_length;
+    stream -> ux_host_class_serial_stream_blocks_filled ++;
+
+    /* The application is notified when data is received in an empty buffer only,
+       it then gets all blocks received until the buffer is empty again.  */
+    if (stream -> ux_host_class_serial_stream_blocks_filled == 1)
+        event_flags =  stream -> ux_host_class_serial_stream_event_flags;
+
+    /* OVERFLOW check: all blocks wait for the application, the device is NAKed.  */
+    if (stream -> ux_host_class_serial_stream_blocks_filled == stream -> ux_host_class_serial_stream_block_count)
+        status =  UX_BUFFER_OVERFLOW;
+
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+
+    /* Update statistics.  */
+    statistics =  stream -> ux_host_class_serial_stream_statistics;
+    statistics -> ux_host_class_serial_statistics_rx_bytes +=  transfer_request -> ux_transfer_request_actual_length;
+    if (stream -> ux_host_class_serial_stream_blocks_filled > statistics -> ux_host_class_serial_statistics_rx_blocks_high_water)
+        statistics -> ux_host_class_serial_statistics_rx_blocks_high_water =  stream -> ux_host_class_serial_stream_blocks_filled;
+    if (status == UX_BUFFER_OVERFLOW)
+        statistics -> ux_host_class_serial_statistics_rx_overflows ++;
+#endif
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Wake up the application thread serving this stream.  */
+    if ((event_flags != 0) && (stream -> ux_host_class_serial_stream_event_flags_group != UX_NULL))
+        _ux_host_event_flags_set(stream -> ux_host_class_serial_stream_event_flags_group, event_flags, UX_OR);
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
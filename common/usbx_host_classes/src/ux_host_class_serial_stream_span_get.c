@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_span_get               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the oldest data received by a serial stream,  */
+/*    in place in the reception buffer. The span goes on in the next      */
+/*    block while blocks are full and adjacent in the buffer. The data    */
+/*    stays in the buffer until it is released by                         */
+/*    _ux_host_class_serial_stream_span_release.                          */
+/*                                                                        */
+/*    The stream is not changed here, blocks are freed and transfers are  */
+/*    armed by the release and the transfer completion only. A span of 0  */
+/*    bytes means the buffer is empty.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Pointer to serial stream      */
+/*    span_buffer                           Pointer to span address       */
+/*    span_length                           Pointer to span length        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_stream_span_get(UX_HOST_CLASS_SERIAL_STREAM *stream, UCHAR **span_buffer, ULONG *span_length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG           *block_lengths;
+ULONG           block;
+ULONG           blocks;
+ULONG           offset;
+ULONG           length;
+
+
+    /* The stream must be allocated.  */
+    if (stream -> ux_host_class_serial_stream_transfer_requests == UX_NULL)
+        return(UX_ERROR);
+
+    /* Blocks are also updated by the transfer completion.  */
+    block_lengths =  stream -> ux_host_class_serial_stream_block_lengths;
+    UX_DISABLE
+    block =   stream -> ux_host_class_serial_stream_block_tail;
+    offset =  stream -> ux_host_class_serial_stream_block_offset;
+    blocks =  stream -> ux_host_class_serial_stream_blocks_filled;
+
+    /* The span starts with the data left in this block.  */
+    *span_buffer =  stream -> ux_host_class_serial_stream_buffer +
+                    block * stream -> ux_host_class_serial_stream_block_size + offset;
+    length =  0;
+    while (blocks > 0)
+    {
+
+        /* Add the data of this block.  */
+        length +=  block_lengths[block] - offset;
+
+        /* Data goes on in the next block if this one is full and is not the last one of the buffer.  */
+        if ((block_lengths[block] != stream -> ux_host_class_serial_stream_block_size) ||
+            (block + 1 == stream -> ux_host_class_serial_stream_block_count))
+            break;
+        block ++;
+        offset =  0;
+        blocks --;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Return the span length.  */
+    *span_length =  length;
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_span_release           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases data received by a serial stream, from the   */
+/*    oldest one. The blocks with no data left are free to receive data   */
+/*    again, transfers are armed on them.                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Pointer to serial stream      */
+/*    length                                Length of data to release     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_arm      Arm stream transfers          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_stream_span_release(UX_HOST_CLASS_SERIAL_STREAM *stream, ULONG length)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+ULONG           *block_lengths;
+ULONG           block;
+ULONG           blocks;
+ULONG           available;
+ULONG           remaining;
+
+
+    /* The stream must be allocated.  */
+    if (stream -> ux_host_class_serial_stream_transfer_requests == UX_NULL)
+        return(UX_ERROR);
+
+    /* Blocks are also updated by the transfer completion.  */
+    block_lengths =  stream -> ux_host_class_serial_stream_block_lengths;
+    UX_DISABLE
+
+    /* Check the length against the data received.  */
+    block =  stream -> ux_host_class_serial_stream_block_tail;
+    available =  0;
+    for (blocks = 0; blocks < stream -> ux_host_class_serial_stream_blocks_filled; blocks ++)
+    {
+        available +=  block_lengths[block];
+        block =  (block + 1) % stream -> ux_host_class_serial_stream_block_count;
+    }
+    if (length > available - stream -> ux_host_class_serial_stream_block_offset)
+    {
+
+        /* Restore interrupts.  */
+        UX_RESTORE
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_INVALID_PARAMETER);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_INVALID_PARAMETER, stream, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_INVALID_PARAMETER);
+    }
+
+    /* Release the data, then the blocks with no data left.  */
+    while (stream -> ux_host_class_serial_stream_blocks_filled > 0)
+    {
+
+        /* Is the data left in this block released?  */
+        block =  stream -> ux_host_class_serial_stream_block_tail;
+        remaining =  block_lengths[block] - stream -> ux_host_class_serial_stream_block_offset;
+        if (remaining > length)
+        {
+
+            /* Part of the block stays.  */
+            stream -> ux_host_class_serial_stream_block_offset +=  length;
+            break;
+        }
+        length -=  remaining;
+
+        /* The block is free to receive data again.  */
+        stream -> ux_host_class_serial_stream_block_tail =  (block + 1) % stream -> ux_host_class_serial_stream_block_count;
+        stream -> ux_host_class_serial_stream_block_offset =  0;
+        stream -> ux_host_class_serial_stream_blocks_filled --;
+    }
+
+    /* Restore interrupts.  */
+    UX_RESTORE
+
+    /* Arm transfers on the blocks released.  */
+    _ux_host_class_serial_stream_arm(stream);
+
+    /* Return successful completion.  */
+    return(UX_SUCCESS);
+}
+#endif
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_start                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function starts a serial stream on the bulk IN endpoint of a   */
+/*    class. The reception buffer is split in blocks of the block size,   */
+/*    the transfer requests are allocated on the endpoint and armed on    */
+/*    the first free blocks. If the HCD can't queue several transfers on  */
+/*    an endpoint, a single transfer is used.                             */
+/*                                                                        */
+/*    The completion function, class instance and user specific value     */
+/*    are set in all the transfer requests, the completion function of    */
+/*    the class calls _ux_host_class_serial_stream_completed.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Pointer to serial stream      */
+/*    endpoint                              Pointer to bulk IN endpoint   */
+/*    statistics                            Pointer to port statistics,   */
+/*                                            UX_NULL if not enabled      */
+/*    buffer                                Pointer to reception buffer   */
+/*    buffer_size                           Size of reception buffer      */
+/*    block_size                            Size of reception block       */
+/*    transfer_count                        Number of transfers           */
+/*    completion_function                   Transfer completion function  */
+/*    class_instance                        Class instance of transfers   */
+/*    user_specific                         User value of transfers       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_transfer_requests_allocate                  */
+/*                                          Allocate transfer requests    */
+/*    _ux_host_class_serial_stream_arm      Arm stream transfers          */
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
+/*    _ux_utility_memory_allocate_mulc_safe Allocate memory               */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_stream_start(UX_HOST_CLASS_SERIAL_STREAM *stream, UX_ENDPOINT *endpoint,
+                                    UX_HOST_CLASS_SERIAL_STATISTICS *statistics,
+                                    UCHAR *buffer, ULONG buffer_size, ULONG block_size, ULONG transfer_count,
+                                    VOID (*completion_function)(UX_TRANSFER *),
+                                    VOID *class_instance, VOID *user_specific)
+{
+
+UX_TRANSFER     *transfer_requests;
+ULONG           *block_lengths;
+ULONG           block_count;
+ULONG           index;
+UINT            status;
+
+
+    /* The buffer must have a block for each outstanding transfer.  */
+    block_count =  0;
+    if (block_size != 0)
+        block_count =  buffer_size / block_size;
+    if ((transfer_count == 0) || (block_count < transfer_count))
+    {
+
+        /* Error trap. */
+        _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_INVALID_PARAMETER);
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_INVALID_PARAMETER, stream, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+        return(UX_INVALID_PARAMETER);
+    }
+
+    /* Allocate the lengths of data received in blocks.  */
+    block_lengths =  _ux_utility_memory_allocate_mulc_safe(UX_NO_ALIGN, UX_REGULAR_MEMORY, block_count, sizeof(ULONG));
+    if (block_lengths == UX_NULL)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Allocate the outstanding transfer requests on the bulk in endpoint.  */
+    status =  _ux_host_stack_endpoint_transfer_requests_allocate(endpoint, transfer_count, &transfer_requests);
+
+    /* If the HCD can't queue transfers, the stream runs with one transfer.  */
+    if ((status == UX_FUNCTION_NOT_SUPPORTED) && (transfer_count > 1))
+    {
+        transfer_count =  1;
+        status =  _ux_host_stack_endpoint_transfer_requests_allocate(endpoint, transfer_count, &transfer_requests);
+    }
+    if (status != UX_SUCCESS)
+    {
+        _ux_utility_memory_free(block_lengths);
+        return(status);
+    }
+    for (index = 0; index < transfer_count; index ++)
+    {
+        transfer_requests[index].ux_transfer_request_class_instance =       class_instance;
+        transfer_requests[index].ux_transfer_request_user_specific =        user_specific;
+        transfer_requests[index].ux_transfer_request_completion_function =  completion_function;
+    }
+
+    /* All blocks are free.  */
+    stream -> ux_host_class_serial_stream_endpoint =           endpoint;
+    stream -> ux_host_class_serial_stream_statistics =         statistics;
+    stream -> ux_host_class_serial_stream_buffer =             buffer;
+    stream -> ux_host_class_serial_stream_block_size =         block_size;
+    stream -> ux_host_class_serial_stream_block_count =        block_count;
+    stream -> ux_host_class_serial_stream_block_lengths =      block_lengths;
+    stream -> ux_host_class_serial_stream_block_head =         0;
+    stream -> ux_host_class_serial_stream_block_tail =         0;
+    stream -> ux_host_class_serial_stream_block_offset =       0;
+    stream -> ux_host_class_serial_stream_blocks_filled =      0;
+    stream -> ux_host_class_serial_stream_transfer_requests =  transfer_requests;
+    stream -> ux_host_class_serial_stream_transfer_count =     transfer_count;
+    stream -> ux_host_class_serial_stream_transfer_next =      0;
+    stream -> ux_host_class_serial_stream_transfers_pending =  0;
+    stream -> ux_host_class_serial_stream_arming =             UX_FALSE;
+
+    /* Arm the transfers, there is a completion for each of them.  */
+    stream -> ux_host_class_serial_stream_state =  UX_HOST_CLASS_SERIAL_STREAM_STATE_STARTED;
+    status =  _ux_host_class_serial_stream_arm(stream);
+
+    /* If a transfer can't be armed, the stream is not started.  */
+    if (status != UX_SUCCESS)
+        _ux_host_class_serial_stream_stop(stream);
+
+    /* Return completion status.  */
+    return(status);
+}
+#endif
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_stream_stop                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function stops a serial stream. The transfer requests are      */
+/*    aborted and freed, the aborted transfers are not reported as data.  */
+/*    The data left in the buffer is dropped.                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    stream                                Pointer to serial stream      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_endpoint_transfer_requests_free                      */
+/*                                          Free transfer requests        */
+/*    _ux_utility_memory_free               Free memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_stream_stop(UX_HOST_CLASS_SERIAL_STREAM *stream)
+{
+
+    /* Declare the stream stopped, the aborted transfers are not reported.  */
+    stream -> ux_host_class_serial_stream_state =  UX_HOST_CLASS_SERIAL_STREAM_STATE_STOPPED;
+
+    /* Nothing to free if the stream is not allocated.  */
+    if (stream -> ux_host_class_serial_stream_transfer_requests == UX_NULL)
+        return(UX_SUCCESS);
+
+    /* Abort and free the transfer requests on the endpoint.  */
+    _ux_host_stack_endpoint_transfer_requests_free(stream -> ux_host_class_serial_stream_endpoint);
+    stream -> ux_host_class_serial_stream_transfer_requests =  UX_NULL;
+
+    /* Free the block lengths.  */
+    _ux_utility_memory_free(stream -> ux_host_class_serial_stream_block_lengths);
+    stream -> ux_host_class_serial_stream_block_lengths =  UX_NULL;
+    stream -> ux_host_class_serial_stream_blocks_filled =  0;
+
+    /* This function never really fails.  */
+    return(UX_SUCCESS);
+}
+#endif
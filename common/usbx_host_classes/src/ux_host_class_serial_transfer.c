@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** USBX Component                                                        */
+/**                                                                       */
+/**   Host Serial Engine                                                  */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+/* Include necessary system files.  */
+
+#define UX_SOURCE_CODE
+
+#include "ux_api.h"
+#include "ux_host_class_serial.h"
+#include "ux_host_stack.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_host_class_serial_transfer                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function reads or writes data on the bulk endpoint of a        */
+/*    serial class. The data is transferred in transfers of the maximum   */
+/*    length of the transfer request, each one waits for completion. A    */
+/*    short transfer ends the read or write with success, the caller      */
+/*    checks the actual length.                                           */
+/*                                                                        */
+/*    The function is not protected against thread reentry, the class     */
+/*    protects it.                                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    transfer_request                      Pointer to transfer request   */
+/*    data_pointer                          Pointer to data               */
+/*    requested_length                      Length of data                */
+/*    actual_length                         Actual length transferred     */
+/*    wait_option                           Transfer timeout in ticks     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_transfer_request       Process transfer request      */
+/*    _ux_host_stack_transfer_request_abort Abort transfer request        */
+/*    _ux_host_semaphore_get                Get semaphore                 */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Serial Classes                                                      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_host_class_serial_transfer(UX_TRANSFER *transfer_request, UCHAR *data_pointer,
+                                    ULONG requested_length, ULONG *actual_length, ULONG wait_option)
+{
+
+UINT            status;
+ULONG           transfer_request_length;
+
+
+    /* Start by resetting the actual length of the transfer.  */
+    *actual_length =  0;
+
+    /* A read of nothing is done, a write of nothing sends a zero length packet.  */
+    if ((requested_length == 0) &&
+        ((transfer_request -> ux_transfer_request_type & UX_REQUEST_DIRECTION) == UX_REQUEST_IN))
+        return(UX_SUCCESS);
+
+    /* Perform a transfer on the bulk endpoint until either the transfer is
+       completed or when there is an error.  */
+    do
+    {
+
+        /* Program the maximum authorized length for this transfer request.  */
+        if (requested_length > transfer_request -> ux_transfer_request_maximum_length)
+            transfer_request_length =  transfer_request -> ux_transfer_request_maximum_length;
+        else
+            transfer_request_length =  requested_length;
+
+        /* Initialize the transfer request.  */
+        transfer_request -> ux_transfer_request_data_pointer =      data_pointer;
+        transfer_request -> ux_transfer_request_requested_length =  transfer_request_length;
+
+        /* Perform the transfer.  */
+        status =  _ux_host_stack_transfer_request(transfer_request);
+
+        /* If the transfer is successful, we need to wait for the transfer request to be completed.  */
+        if (status == UX_SUCCESS)
+        {
+
+            /* Wait for the completion of the transfer request.  */
+            status =  _ux_host_semaphore_get(&transfer_request -> ux_transfer_request_semaphore, wait_option);
+
+            /* If the semaphore did not succeed we probably have a time out.  */
+            if (status != UX_SUCCESS)
+            {
+
+                /* All transfers pending need to abort. There may have been a partial transfer.  */
+                _ux_host_stack_transfer_request_abort(transfer_request);
+
+                /* Update the length of the actual data transferred. We do this after the
+                   abort of the transfer request in case some data was actually transferred.  */
+                *actual_length +=  transfer_request -> ux_transfer_request_actual_length;
+
+                /* Set the completion code.  */
+                transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
+
+                /* Error trap. */
+                _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
+
+                /* If trace is enabled, insert this event into the trace buffer.  */
+                UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_TIMEOUT, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
+
+                /* There was an error, return to the caller.  */
+                return(UX_TRANSFER_TIMEOUT);
+            }
+        }
+        else
+        {
+
+            /* There was a non transfer error, no partial transfer to be checked.  */
+            return(status);
+        }
+
+        /* Update the length of the transfer. Normally all the data has to be transferred.  */
+        *actual_length +=  transfer_request -> ux_transfer_request_actual_length;
+
+        /* Check for completion status.  */
+        if (transfer_request -> ux_transfer_request_completion_code != UX_SUCCESS)
+            return(transfer_request -> ux_transfer_request_completion_code);
+
+        /* Check for completion of transfer. If the transfer is partial, return to caller.
+           The transfer is marked as successful but the caller will need to check the length
+           actually transferred and determine if a partial transfer is OK.  */
+        if (transfer_request_length != transfer_request -> ux_transfer_request_actual_length)
+            return(UX_SUCCESS);
+
+        /* Update the data pointer for next transfer.  */
+        data_pointer +=  transfer_request_length;
+
+        /* Update what is left to transfer.  */
+        requested_length -=  transfer_request_length;
+
+    } while (requested_length != 0);
+
+    /* We get here when all the transfers went through without errors.  */
+    return(UX_SUCCESS);
+}
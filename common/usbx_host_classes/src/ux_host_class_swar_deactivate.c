@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_swar_deactivate                      PORTABLE C      */ 
-/*                                                           6.1.10       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -63,6 +63,7 @@
 /*    _ux_host_semaphore_get                Get protection semaphore      */ 
 /*    _ux_host_semaphore_delete             Delete protection semaphore   */ 
 /*    _ux_utility_thread_schedule_other     Schedule other threads        */
+/*    _ux_host_class_serial_stream_stop     Stop serial stream            */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -78,6 +79,9 @@
 /*  01-31-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            refined macros names,       */
 /*                                            resulting in version 6.1.10 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_swar_deactivate(UX_HOST_CLASS_COMMAND *command)
@@ -85,6 +89,10 @@ UINT  _ux_host_class_swar_deactivate(UX_HOST_CLASS_COMMAND *command)
 
 UX_HOST_CLASS_SWAR         *swar;
 UINT                        status;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UX_HOST_CLASS_SWAR_RECEPTION
+                            *swar_reception;
+#endif
 
 
     /* Get the instance for this class.  */
@@ -113,6 +121,18 @@ UINT                        status;
     /* We need to abort transactions on the bulk In pipe.  */
     _ux_host_stack_endpoint_transfer_abort(swar -> ux_host_class_swar_bulk_in_endpoint);
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* A streaming reception has its transfers on the bulk In pipe, free them.  */
+    swar_reception =  swar -> ux_host_class_swar_reception;
+    if ((swar_reception != UX_NULL) &&
+        (swar_reception -> ux_host_class_swar_reception_transfer_count != 0))
+    {
+        swar_reception -> ux_host_class_swar_reception_state =  UX_HOST_CLASS_SWAR_RECEPTION_STATE_STOPPED;
+        _ux_host_class_serial_stream_stop(&swar_reception -> ux_host_class_swar_reception_stream);
+    }
+#endif
+
     /* The enumeration thread needs to sleep a while to allow the application or the class that may be using
        endpoints to exit properly.  */
     _ux_host_thread_schedule_other(UX_THREAD_PRIORITY_ENUM); 
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_swar_read                            PORTABLE C      */ 
-/*                                                           6.1.11       */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -57,14 +57,13 @@
 /*                                                                        */ 
 /*    Completion Status                                                   */ 
 /*                                                                        */ 
-/*  CALLS                                                                 */ 
-/*                                                                        */ 
-/*    _ux_host_stack_class_instance_verify  Verify the class instance     */ 
-/*    _ux_host_stack_transfer_request       Process transfer request      */ 
-/*    _ux_host_stack_transfer_request_abort Abort transfer request        */ 
-/*    _ux_host_semaphore_get                Get protection semaphore      */ 
-/*    _ux_host_semaphore_put                Release protection semaphore  */ 
-/*                                                                        */ 
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_host_stack_class_instance_verify  Verify the class instance     */
+/*    _ux_host_class_serial_transfer        Transfer serial data          */
+/*    _ux_host_semaphore_get                Get protection semaphore      */
+/*    _ux_host_semaphore_put                Release protection semaphore  */
+/*                                                                        */
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
 /*    Application                                                         */ 
@@ -83,6 +82,10 @@
 /*  04-25-2022     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            fixed standalone compile,   */
 /*                                            resulting in version 6.1.11 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s),          */
+/*                                            used serial transfer,       */
+/*                                            added statistics,           */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_swar_read(UX_HOST_CLASS_SWAR *swar, UCHAR *data_pointer, 
@@ -91,7 +94,6 @@ UINT  _ux_host_class_swar_read(UX_HOST_CLASS_SWAR *swar, UCHAR *data_pointer,
 
 UX_TRANSFER     *transfer_request;
 UINT            status;
-ULONG           transfer_request_length;
     
     /* If trace is enabled, insert this event into the trace buffer.  */
     UX_TRACE_IN_LINE_INSERT(UX_TRACE_HOST_CLASS_SWAR_READ, swar, data_pointer, requested_length, 0, UX_TRACE_HOST_CLASS_EVENTS, 0, 0)
@@ -114,102 +116,24 @@ ULONG           transfer_request_length;
     if (status != UX_SUCCESS)
         return(status);
 
-    /* Start by resetting the actual length of the transfer to zero.  */
-    *actual_length =  0;
-
     /* Get the pointer to the bulk in endpoint in the transfer_request.  */
     transfer_request =  &swar -> ux_host_class_swar_bulk_in_endpoint -> ux_endpoint_transfer_request;
-    
-    /* Perform a transfer on the bulk in endpoint until either the transfer is
-       completed or until there is an error.  */
-    while (requested_length)
-    {
-
-        /* Program the maximum authorized length for this transfer request.  */
-        if (requested_length > transfer_request -> ux_transfer_request_maximum_length)
-            transfer_request_length =  transfer_request -> ux_transfer_request_maximum_length;
-        else
-            transfer_request_length =  requested_length;
-                    
-        /* Initialize the transfer request.  */
-        transfer_request -> ux_transfer_request_data_pointer =      data_pointer;
-        transfer_request -> ux_transfer_request_requested_length =  transfer_request_length;
-        
-        /* Perform the transfer.  */
-        status =  _ux_host_stack_transfer_request(transfer_request);
-
-        /* If the transfer is successful, we need to wait for the transfer request to be completed.  */
-        if (status == UX_SUCCESS)
-        {
-            
-            /* Wait for the completion of the transfer_request.  */
-            status =  _ux_host_semaphore_get(&transfer_request -> ux_transfer_request_semaphore, UX_MS_TO_TICK(UX_HOST_CLASS_SWAR_CLASS_TRANSFER_TIMEOUT));
-
-            /* If the semaphore did not succeed we probably have a time out.  */
-            if (status != UX_SUCCESS)
-            {
-
-                /* All transfers pending need to abort. There may have been a partial transfer.  */
-                _ux_host_stack_transfer_request_abort(transfer_request);
-                
-                /* Update the length of the actual data transferred. We do this after the 
-                   abort of the transfer request in case some data was actually received.  */
-                *actual_length +=  transfer_request -> ux_transfer_request_actual_length;
-            
-                /* Unprotect thread reentry to this instance.  */
-                _ux_host_semaphore_put(&swar -> ux_host_class_swar_semaphore);
-
-                /* Set the completion code.  */
-                transfer_request -> ux_transfer_request_completion_code =  UX_TRANSFER_TIMEOUT;
-        
-                /* Error trap. */
-                _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_TRANSFER_TIMEOUT);
-
-                /* If trace is enabled, insert this event into the trace buffer.  */
-                UX_TRACE_IN_LINE_INSERT(UX_TRACE_ERROR, UX_TRANSFER_TIMEOUT, transfer_request, 0, 0, UX_TRACE_ERRORS, 0, 0)
-        
-                /* There was an error, return to the caller */
-                return(UX_TRANSFER_TIMEOUT);
-            }            
-        }
-        else
-        {
-
-            /* Unprotect thread reentry to this instance.  */
-            _ux_host_semaphore_put(&swar -> ux_host_class_swar_semaphore);
 
-            /* There was a non transfer error, no partial transfer to be checked.  */
-            return(status);
-        }
+    /* Read the data on the bulk in endpoint.  */
+    status =  _ux_host_class_serial_transfer(transfer_request, data_pointer, requested_length, actual_length,
+                                             UX_MS_TO_TICK(UX_HOST_CLASS_SWAR_CLASS_TRANSFER_TIMEOUT));
 
-        /* Update the length of the transfer. Normally all the data has to be received.  */
-        *actual_length +=  transfer_request -> ux_transfer_request_actual_length;
-        
-        /* Check for completion of transfer. If the transfer is partial, return to caller.
-           The transfer is marked as successful but the caller will need to check the length
-           actually received and determine if a partial transfer is OK.  */
-        if (transfer_request_length != transfer_request -> ux_transfer_request_actual_length)
-        {
-        
-            /* Unprotect thread reentry to this instance.  */
-            _ux_host_semaphore_put(&swar -> ux_host_class_swar_semaphore);
-            
-            /* Return success to caller.  */
-            return(UX_SUCCESS);
-        }
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
 
-        /* Update the data pointer for next transfer. */        
-        data_pointer +=  transfer_request_length;
-        
-        /* Update what is left to receive.  */
-        requested_length -=  transfer_request_length;          
-    }    
+    /* Update statistics.  */
+    swar -> ux_host_class_swar_statistics.ux_host_class_serial_statistics_rx_bytes +=  *actual_length;
+#endif
 
     /* Unprotect thread reentry to this instance.  */
     _ux_host_semaphore_put(&swar -> ux_host_class_swar_semaphore);
 
-    /* We get here when all the transfers went through without errors.  */
-    return(UX_SUCCESS); 
+    /* Return completion status.  */
+    return(status);
 }
 
 
@@ -35,7 +35,7 @@
 /*  FUNCTION                                               RELEASE        */ 
 /*                                                                        */ 
 /*    _ux_host_class_swar_reception_start                 PORTABLE C      */ 
-/*                                                           6.1          */
+/*                                                           6.x          */
 /*  AUTHOR                                                                */
 /*                                                                        */
 /*    Chaoqiong Xiao, Microsoft Corporation                               */
@@ -61,6 +61,7 @@
 /*                                                                        */ 
 /*    _ux_host_stack_class_instance_verify  Verify the class instance     */ 
 /*    _ux_host_stack_transfer_request       Process transfer request      */ 
+/*    _ux_host_class_serial_stream_start    Start serial stream           */
 /*                                                                        */ 
 /*  CALLED BY                                                             */ 
 /*                                                                        */ 
@@ -73,6 +74,9 @@
 /*  05-19-2020     Chaoqiong Xiao           Initial Version 6.0           */
 /*  09-30-2020     Chaoqiong Xiao           Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            serial stream mode,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _ux_host_class_swar_reception_start (UX_HOST_CLASS_SWAR *swar, 
@@ -98,6 +102,43 @@ UINT            status;
         return(UX_HOST_CLASS_INSTANCE_UNKNOWN);
     }
 
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Check if the reception is streaming.  */
+    if (swar_reception -> ux_host_class_swar_reception_transfer_count != 0)
+    {
+
+        /* Completions may be notified through an event flags group shared with other ports.  */
+        swar_reception -> ux_host_class_swar_reception_stream.ux_host_class_serial_stream_event_flags_group =
+                                    swar_reception -> ux_host_class_swar_reception_event_flags_group;
+        swar_reception -> ux_host_class_swar_reception_stream.ux_host_class_serial_stream_event_flags =
+                                    swar_reception -> ux_host_class_swar_reception_event_flags;
+
+        /* Start the stream on the bulk in endpoint, the transfers point to this reception.  */
+        status =  _ux_host_class_serial_stream_start(&swar_reception -> ux_host_class_swar_reception_stream,
+                                    swar -> ux_host_class_swar_bulk_in_endpoint,
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+                                    &swar -> ux_host_class_swar_statistics,
+#else
+                                    UX_NULL,
+#endif
+                                    swar_reception -> ux_host_class_swar_reception_data_buffer,
+                                    swar_reception -> ux_host_class_swar_reception_data_buffer_size,
+                                    swar_reception -> ux_host_class_swar_reception_block_size,
+                                    swar_reception -> ux_host_class_swar_reception_transfer_count,
+                                    _ux_host_class_swar_reception_callback, (VOID *) swar, (VOID *) swar_reception);
+        if (status != UX_SUCCESS)
+            return(status);
+
+        /* Save the reception structure in the swar structure.  */
+        swar -> ux_host_class_swar_reception = swar_reception;
+
+        /* And declare we have transfers in progress.  */
+        swar_reception -> ux_host_class_swar_reception_state =  UX_HOST_CLASS_SWAR_RECEPTION_STATE_STARTED;
+        return(UX_SUCCESS);
+    }
+#endif
+
     /* Start by aligning the head and tail of buffers to the same address supplied by the application.  */
     swar_reception -> ux_host_class_swar_reception_data_head =  swar_reception -> ux_host_class_swar_reception_data_buffer;
     swar_reception -> ux_host_class_swar_reception_data_tail =  swar_reception -> ux_host_class_swar_reception_data_buffer;
@@ -51,6 +51,11 @@
 /*  07-29-2022     Yajun Xia                Modified comment(s),          */
 /*                                            fixed ipv6 support issue,   */
 /*                                            resulting in version 6.1.12 */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), added    */
+/*                                            packet lend support, added  */
+/*                                            traffic statistics, added   */
+/*                                            queue full drop reason,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 
@@ -81,6 +86,60 @@ extern   "C" {
 #define NX_ETHERNET_IPV6                    0x86DD
 #define NX_ETHERNET_MTU                     1514
 
+/* Define the alignment of the IP header in packets lent as USB transfer buffers.  */
+#define USB_NETWORK_DEVICE_PACKET_ALIGN_MASK    ((ULONG)sizeof(ULONG) - 1)
+
+/* Option: defined, it enables per-interface traffic statistics, including frames and bytes
+    in each direction, drops by reason, transmit queue high-water mark and transmit completion
+    latency histogram. They are read by _ux_network_driver_statistics_get, counters are also
+    returned by NetX driver requests (NX_LINK_GET_RX_COUNT, NX_LINK_GET_TX_COUNT,
+    NX_LINK_GET_ALLOC_ERRORS and NX_LINK_GET_ERROR_COUNT).
+ */
+/* #define UX_NETWORK_DRIVER_ENABLE_STATISTICS  */
+
+/* Define drop reasons of network statistics.  */
+#define USB_NETWORK_DEVICE_DROP_NONE                0
+#define USB_NETWORK_DEVICE_DROP_POOL_EMPTY          1
+#define USB_NETWORK_DEVICE_DROP_LINK_DOWN           2
+#define USB_NETWORK_DEVICE_DROP_OVERSIZE            3
+#define USB_NETWORK_DEVICE_DROP_MALFORMED           4
+#define USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR      5
+#define USB_NETWORK_DEVICE_DROP_QUEUE_FULL          6
+#define USB_NETWORK_DEVICE_DROP_REASONS             7
+
+/* Define transmit completion latency histogram, bucket N (N > 0) counts latencies
+   from 2^(N-1) to 2^N-1 ticks, bucket 0 counts latencies below 1 tick and the last
+   bucket counts all latencies above.  */
+#ifndef USB_NETWORK_DEVICE_TX_LATENCY_BUCKETS
+#define USB_NETWORK_DEVICE_TX_LATENCY_BUCKETS       8
+#endif
+
+/* Define number of transmitting packets whose latency is measured, power of 2.  */
+#ifndef USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE
+#define USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE       16
+#endif
+
+#if (USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE < 1) || ((USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE & (USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE - 1)) != 0)
+#error USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE must be a power of 2
+#endif
+
+typedef struct USB_NETWORK_DEVICE_STATISTICS_STRUCT
+{
+
+    ULONG           ux_network_device_statistics_tx_frames;
+    ULONG           ux_network_device_statistics_tx_bytes;
+    ULONG           ux_network_device_statistics_rx_frames;
+    ULONG           ux_network_device_statistics_rx_bytes;
+    ULONG           ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_REASONS];
+    ULONG           ux_network_device_statistics_rx_drops[USB_NETWORK_DEVICE_DROP_REASONS];
+
+    /* Packets accepted by USB class and not yet transmitted, and its maximum.  */
+    ULONG           ux_network_device_statistics_tx_queue_depth;
+    ULONG           ux_network_device_statistics_tx_queue_high_water;
+
+    ULONG           ux_network_device_statistics_tx_latency[USB_NETWORK_DEVICE_TX_LATENCY_BUCKETS];
+} USB_NETWORK_DEVICE_STATISTICS;
+
 typedef struct USB_NETWORK_DEVICE_STRUCT
 {
 
@@ -110,6 +169,16 @@ typedef struct USB_NETWORK_DEVICE_STRUCT
     ULONG           ux_network_physical_address_msw;
     ULONG           ux_network_physical_address_lsw;
 
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+    /* Traffic statistics.  */
+    USB_NETWORK_DEVICE_STATISTICS   ux_network_device_statistics;
+
+    /* Times packets are accepted by USB class, in transmit order.  */
+    ULONG           ux_network_device_tx_times[USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE];
+    ULONG           ux_network_device_tx_time_index;
+#endif
+
 
 } USB_NETWORK_DEVICE_TYPE;
 
@@ -128,6 +197,20 @@ VOID  _ux_network_driver_link_up(VOID *ux_network_handle);
 VOID  _ux_network_driver_link_down(VOID *ux_network_handle);
 
 VOID  _ux_network_driver_packet_received(VOID *ux_network_handle, NX_PACKET *packet_ptr);
+
+UINT  _ux_network_driver_packet_lend(NX_PACKET_POOL *pool, ULONG header_length, ULONG buffer_length,
+                                     NX_PACKET **packet_ptr, ULONG wait_option);
+
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+VOID  _ux_network_driver_packet_transmitted(VOID *ux_network_handle, NX_PACKET *packet_ptr, UINT drop_reason);
+VOID  _ux_network_driver_packet_dropped(VOID *ux_network_handle, UINT drop_reason);
+UINT  _ux_network_driver_statistics_get(VOID *ux_network_handle, USB_NETWORK_DEVICE_STATISTICS *statistics);
+UINT  _ux_network_driver_statistics_reset(VOID *ux_network_handle);
+#else
+#define _ux_network_driver_packet_transmitted(h,p,r)    do {} while(0)
+#define _ux_network_driver_packet_dropped(h,r)          do {} while(0)
+#endif
+
 /* Determine if a C++ compiler is being used.  If so, complete the standard 
    C conditional started above.  */   
 #ifdef __cplusplus
@@ -441,6 +441,10 @@ USB_NETWORK_DEVICE_TYPE *usb_network_device;
 /*  03-08-2023     Yajun Xia                Modified comment(s),          */
 /*                                            fixed build issue with NETX,*/
 /*                                            resulting in version 6.2.1  */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Modified comment(s), reported */
+/*                                            transmit queue full to      */
+/*                                            NetX, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 
@@ -454,6 +458,11 @@ ULONG                           *ethernet_frame_ptr;
 NX_INTERFACE                    *nx_interface_ptr;
 USB_NETWORK_DEVICE_TYPE         *usb_network_device_ptr;
 UINT                            i;
+UINT                            status;
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+USB_NETWORK_DEVICE_STATISTICS   *statistics;
+ULONG                           count;
+#endif
 
     /* Get the pointer to the NX_IP instance.  */
     nx_ip = nx_ip_driver -> nx_ip_driver_ptr;    
@@ -640,6 +649,11 @@ UINT                            i;
                     {
                         /* Unknown IP version */
                         /* free the packet that we will not send */
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+                        UX_DISABLE
+                        usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_MALFORMED] ++;
+                        UX_RESTORE
+#endif
                         nx_packet_transmit_release(packet_ptr);
                         nx_ip_driver  -> nx_ip_driver_status =  NX_NOT_SUCCESSFUL;        
                         break;
@@ -653,10 +667,44 @@ UINT                            i;
                 NX_CHANGE_ULONG_ENDIAN(*(ethernet_frame_ptr+2));
                 NX_CHANGE_ULONG_ENDIAN(*(ethernet_frame_ptr+3));
                 
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+                /* Log the time before writing, the transmission may complete before write returns.  */
+                statistics = &usb_network_device_ptr -> ux_network_device_statistics;
+                UX_DISABLE
+                usb_network_device_ptr -> ux_network_device_tx_times[usb_network_device_ptr -> ux_network_device_tx_time_index &
+                                                                     (USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE - 1)] = _ux_utility_time_get();
+                usb_network_device_ptr -> ux_network_device_tx_time_index ++;
+                statistics -> ux_network_device_statistics_tx_queue_depth ++;
+                if (statistics -> ux_network_device_statistics_tx_queue_high_water < statistics -> ux_network_device_statistics_tx_queue_depth)
+                    statistics -> ux_network_device_statistics_tx_queue_high_water = statistics -> ux_network_device_statistics_tx_queue_depth;
+                UX_RESTORE
+#endif
+
                 /* Write the packet or queue it.  */
-                nx_ip_driver -> nx_ip_driver_status = 
-                    usb_network_device_ptr -> ux_network_device_write_function(usb_network_device_ptr -> ux_network_device_usb_instance_ptr,
-                                                                              packet_ptr);
+                status = usb_network_device_ptr -> ux_network_device_write_function(usb_network_device_ptr -> ux_network_device_usb_instance_ptr,
+                                                                                    packet_ptr);
+
+                /* A full transmit queue is reported to NetX as back-pressure.  */
+                nx_ip_driver -> nx_ip_driver_status = (status == UX_CLASS_ETH_QUEUE_FULL_ERROR) ? NX_TX_QUEUE_DEPTH : status;
+
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+                /* If packet is not accepted, it's not queued.  */
+                if (nx_ip_driver -> nx_ip_driver_status != NX_SUCCESS)
+                {
+                    UX_DISABLE
+                    if (statistics -> ux_network_device_statistics_tx_queue_depth)
+                    {
+                        usb_network_device_ptr -> ux_network_device_tx_time_index --;
+                        statistics -> ux_network_device_statistics_tx_queue_depth --;
+                    }
+                    statistics -> ux_network_device_statistics_tx_drops[(status == UX_CLASS_ETH_QUEUE_FULL_ERROR) ?
+                                                                        USB_NETWORK_DEVICE_DROP_QUEUE_FULL :
+                                                                        USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR] ++;
+                    UX_RESTORE
+                }
+#endif
 
                 /* Are the sync objects valid?  */
                 if (usb_network_device_ptr -> ux_network_device_activated_by_thread == UX_TRUE)
@@ -699,6 +747,11 @@ UINT                            i;
                     _ux_utility_mutex_off(&usb_network_device_ptr -> ux_network_device_deactivate_mutex);
 
                 /* Link down, throw away packet.  */
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+                UX_DISABLE
+                usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_LINK_DOWN] ++;
+                UX_RESTORE
+#endif
                 nx_packet_transmit_release(packet_ptr);
                 nx_ip_driver  -> nx_ip_driver_status =  NX_SUCCESS;
 
@@ -713,14 +766,52 @@ UINT                            i;
             usb_network_driver_initialized =  0;
 
             break;
+
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+        case NX_LINK_GET_RX_COUNT:
+
+            /* Return frames received.  */
+            *(nx_ip_driver -> nx_ip_driver_return_ptr) = usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_rx_frames;
+            nx_ip_driver -> nx_ip_driver_status =  NX_SUCCESS;
+            break;
+
+        case NX_LINK_GET_TX_COUNT:
+
+            /* Return frames transmitted.  */
+            *(nx_ip_driver -> nx_ip_driver_return_ptr) = usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_frames;
+            nx_ip_driver -> nx_ip_driver_status =  NX_SUCCESS;
+            break;
+
+        case NX_LINK_GET_ALLOC_ERRORS:
+
+            /* Return frames dropped for no packet.  */
+            *(nx_ip_driver -> nx_ip_driver_return_ptr) = usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_rx_drops[USB_NETWORK_DEVICE_DROP_POOL_EMPTY];
+            nx_ip_driver -> nx_ip_driver_status =  NX_SUCCESS;
+            break;
+
+        case NX_LINK_GET_ERROR_COUNT:
+
+            /* Return frames dropped for all reasons in both directions.  */
+            statistics = &usb_network_device_ptr -> ux_network_device_statistics;
+            count = 0;
+            for (i = USB_NETWORK_DEVICE_DROP_NONE + 1; i < USB_NETWORK_DEVICE_DROP_REASONS; i ++)
+                count += statistics -> ux_network_device_statistics_tx_drops[i] +
+                         statistics -> ux_network_device_statistics_rx_drops[i];
+            *(nx_ip_driver -> nx_ip_driver_return_ptr) = count;
+            nx_ip_driver -> nx_ip_driver_status =  NX_SUCCESS;
+            break;
+#endif
             
         case NX_LINK_MULTICAST_JOIN:
         case NX_LINK_MULTICAST_LEAVE:
         case NX_LINK_GET_STATUS:
+#if !defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
         case NX_LINK_GET_ERROR_COUNT:
         case NX_LINK_GET_RX_COUNT:
         case NX_LINK_GET_TX_COUNT:
         case NX_LINK_GET_ALLOC_ERRORS:
+#endif
         case NX_LINK_GET_SPEED:
         case NX_LINK_GET_DUPLEX_TYPE:
         case NX_LINK_USER_COMMAND :
@@ -795,12 +886,16 @@ USB_NETWORK_DEVICE_TYPE *usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE*) ux_
 
 ULONG           packet_type;
 NX_IP           *nx_ip;
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+UX_INTERRUPT_SAVE_AREA
+#endif
 
     /* Check the state of the Link.  */
     if (usb_network_device_ptr -> ux_network_device_link_status != NX_TRUE)
     {
 
         /* Link down, throw away packet.  */
+        _ux_network_driver_packet_dropped(usb_network_device_ptr, USB_NETWORK_DEVICE_DROP_LINK_DOWN);
         nx_packet_release(packet_ptr);
         return;
 
@@ -814,10 +909,20 @@ NX_IP           *nx_ip;
         _ux_system_error_handler(UX_SYSTEM_LEVEL_THREAD, UX_SYSTEM_CONTEXT_CLASS, UX_CLASS_MALFORMED_PACKET_RECEIVED_ERROR);
 
         /* Invalid ethernet header... release the packet.  */
+        _ux_network_driver_packet_dropped(usb_network_device_ptr, USB_NETWORK_DEVICE_DROP_MALFORMED);
         nx_packet_release(packet_ptr);
         return;
     }
 
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+    /* Log the frame, it's received by the USB network device.  */
+    UX_DISABLE
+    usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_rx_frames ++;
+    usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_rx_bytes += packet_ptr -> nx_packet_length;
+    UX_RESTORE
+#endif
+
     /* Pickup the packet header to determine where the packet needs to be
        sent.  */
     packet_type =  _ux_utility_short_get_big_endian(packet_ptr -> nx_packet_prepend_ptr + 12);
@@ -886,6 +991,7 @@ NX_IP           *nx_ip;
         default :
     
             /* Invalid ethernet header... release the packet.  */
+            _ux_network_driver_packet_dropped(usb_network_device_ptr, USB_NETWORK_DEVICE_DROP_MALFORMED);
             nx_packet_release(packet_ptr);
 
     }
@@ -1004,5 +1110,397 @@ USB_NETWORK_DEVICE_TYPE *usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE*)ux_n
     /* Set the link status.  */
     usb_network_device_ptr -> ux_network_device_link_status = NX_FALSE;
 
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+    /* Packets queued in USB class are discarded, they are not waited anymore.  */
+    usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_queue_depth = 0;
+#endif
+
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_network_driver_packet_lend                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by USB network classes to get a NetX        */
+/*    packet whose payload area is lent directly as USB transfer buffer,  */
+/*    so a received frame is not copied.                                  */
+/*                                                                        */
+/*    The packet prepend pointer is moved so that the IP header, which    */
+/*    follows the class header and the Ethernet header, is aligned on a   */
+/*    ULONG boundary, as NetX expects. If the packet payload can not      */
+/*    hold the transfer buffer after the alignment, no packet is          */
+/*    returned and the class must receive in its own buffer and copy.     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool                                  Packet pool to allocate from  */
+/*    header_length                         Length of class header before */
+/*                                          the Ethernet header           */
+/*    buffer_length                         Length of transfer buffer     */
+/*    packet_ptr                            Pointer to returned packet    */
+/*    wait_option                           Packet allocation wait option */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    nx_packet_allocate                    Allocate NetX packet          */
+/*    nx_packet_release                     Free NetX packet              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX network classes                                                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_network_driver_packet_lend(NX_PACKET_POOL *pool, ULONG header_length, ULONG buffer_length,
+                                     NX_PACKET **packet_ptr, ULONG wait_option)
+{
+
+NX_PACKET       *packet;
+UINT            status;
+ULONG           padding;
+
+
+    /* The packet can not be lent if the transfer buffer does not fit in payload.  */
+    if (pool -> nx_packet_pool_payload_size < buffer_length)
+        return(UX_BUFFER_OVERFLOW);
+
+    /* Get a NX packet for reception.  */
+    status =  nx_packet_allocate(pool, &packet, NX_RECEIVE_PACKET, wait_option);
+    if (status != NX_SUCCESS)
+        return(UX_MEMORY_INSUFFICIENT);
+
+    /* Get padding to align IP header after class header and Ethernet header.  */
+    padding = (ULONG)((ALIGN_TYPE)(packet -> nx_packet_prepend_ptr + header_length + NX_ETHERNET_SIZE) &
+                      USB_NETWORK_DEVICE_PACKET_ALIGN_MASK);
+    if (padding)
+        padding = USB_NETWORK_DEVICE_PACKET_ALIGN_MASK + 1 - padding;
+
+    /* Check if the transfer buffer still fits after padding.  */
+    if ((ULONG)(packet -> nx_packet_data_end - packet -> nx_packet_prepend_ptr) < buffer_length + padding)
+    {
+
+        /* Packet can not be lent, caller receives in its own buffer.  */
+        nx_packet_release(packet);
+        return(UX_BUFFER_OVERFLOW);
+    }
+
+    /* Adjust the prepend pointer, the transfer buffer starts there.  */
+    packet -> nx_packet_prepend_ptr += padding;
+    packet -> nx_packet_append_ptr = packet -> nx_packet_prepend_ptr;
+    packet -> nx_packet_length = 0;
+    packet -> nx_packet_queue_next = UX_NULL;
+
+    /* Return the packet.  */
+    *packet_ptr = packet;
+    return(UX_SUCCESS);
+}
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_network_driver_packet_transmitted               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by USB network classes when a packet        */
+/*    accepted by their write function is done, before the packet is      */
+/*    released to NetX. It updates the transmit statistics and, for a     */
+/*    packet sent, the transmit completion latency histogram.             */
+/*                                                                        */
+/*    Packets must be reported in the order they are written.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ux_network_handle                     Handle of USB network instance*/
+/*    packet_ptr                            Pointer to packet done        */
+/*    drop_reason                           Reason of drop, or            */
+/*                                          USB_NETWORK_DEVICE_DROP_NONE  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_time_get                  Get current time              */
+/*    _ux_utility_time_elapsed              Get elapsed time              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX network classes                                                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_network_driver_packet_transmitted(VOID *ux_network_handle, NX_PACKET *packet_ptr, UINT drop_reason)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+USB_NETWORK_DEVICE_TYPE         *usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE*)ux_network_handle;
+USB_NETWORK_DEVICE_STATISTICS   *statistics;
+ULONG                           elapsed;
+ULONG                           bucket;
+ULONG                           time_index;
+UINT                            logged;
+
+
+    /* Get statistics.  */
+    statistics = &usb_network_device_ptr -> ux_network_device_statistics;
+
+    UX_DISABLE
+
+    /* Remove the oldest packet from queue, if it's still logged.  */
+    logged = UX_FALSE;
+    time_index = 0;
+    if (statistics -> ux_network_device_statistics_tx_queue_depth)
+    {
+        time_index = usb_network_device_ptr -> ux_network_device_tx_time_index -
+                     statistics -> ux_network_device_statistics_tx_queue_depth;
+        statistics -> ux_network_device_statistics_tx_queue_depth --;
+
+        /* Time is kept for the last packets in queue only.  */
+        logged = (statistics -> ux_network_device_statistics_tx_queue_depth < USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE) ?
+                 UX_TRUE : UX_FALSE;
+    }
+
+    /* Check if the packet is dropped.  */
+    if (drop_reason != USB_NETWORK_DEVICE_DROP_NONE)
+    {
+        if (drop_reason < USB_NETWORK_DEVICE_DROP_REASONS)
+            statistics -> ux_network_device_statistics_tx_drops[drop_reason] ++;
+        UX_RESTORE
+        return;
+    }
+
+    /* Log the frame sent.  */
+    statistics -> ux_network_device_statistics_tx_frames ++;
+    statistics -> ux_network_device_statistics_tx_bytes += packet_ptr -> nx_packet_length;
+
+    /* Log the latency.  */
+    if (logged)
+    {
+        elapsed = _ux_utility_time_elapsed(usb_network_device_ptr -> ux_network_device_tx_times[time_index &
+                                                                    (USB_NETWORK_DEVICE_TX_TIME_QUEUE_SIZE - 1)],
+                                           _ux_utility_time_get());
+
+        /* Bucket is the number of significant bits in latency.  */
+        for (bucket = 0; elapsed && bucket < USB_NETWORK_DEVICE_TX_LATENCY_BUCKETS - 1; bucket ++)
+            elapsed >>= 1;
+        statistics -> ux_network_device_statistics_tx_latency[bucket] ++;
+    }
+
+    UX_RESTORE
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_network_driver_packet_dropped                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by USB network classes when a received      */
+/*    frame is dropped before it is passed to the network driver, e.g.,   */
+/*    when there is no packet in pool to receive it.                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ux_network_handle                     Handle of USB network instance*/
+/*    drop_reason                           Reason of drop                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    USBX network classes                                                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _ux_network_driver_packet_dropped(VOID *ux_network_handle, UINT drop_reason)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+USB_NETWORK_DEVICE_TYPE *usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE*)ux_network_handle;
+
+
+    /* Check the reason.  */
+    if (drop_reason == USB_NETWORK_DEVICE_DROP_NONE || drop_reason >= USB_NETWORK_DEVICE_DROP_REASONS)
+        return;
+
+    /* Log the drop.  */
+    UX_DISABLE
+    usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_rx_drops[drop_reason] ++;
+    UX_RESTORE
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_network_driver_statistics_get                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the application to get a copy of the     */
+/*    traffic statistics of a USB network instance.                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ux_network_handle                     Handle of USB network instance*/
+/*    statistics                            Pointer to statistics buffer  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_copy               Copy memory                   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application, NetX                                                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_network_driver_statistics_get(VOID *ux_network_handle, USB_NETWORK_DEVICE_STATISTICS *statistics)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+USB_NETWORK_DEVICE_TYPE *usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE*)ux_network_handle;
+
+
+    /* Check parameters.  */
+    if (usb_network_device_ptr == UX_NULL || statistics == UX_NULL)
+        return(USB_NETWORK_DRIVER_FAILURE);
+
+    /* Copy the statistics consistently.  */
+    UX_DISABLE
+    _ux_utility_memory_copy(statistics, &usb_network_device_ptr -> ux_network_device_statistics,
+                            sizeof(USB_NETWORK_DEVICE_STATISTICS)); /* Use case of memcpy is verified. */
+    UX_RESTORE
+
+    return(USB_NETWORK_DRIVER_SUCCESS);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _ux_network_driver_statistics_reset                 PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Chaoqiong Xiao, Microsoft Corporation                               */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the application to reset the traffic     */
+/*    statistics of a USB network instance. The transmit queue depth is   */
+/*    kept since packets are still in the queue.                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ux_network_handle                     Handle of USB network instance*/
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    Completion Status                                                   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _ux_utility_memory_set                Set memory                    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Chaoqiong Xiao           Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _ux_network_driver_statistics_reset(VOID *ux_network_handle)
+{
+
+UX_INTERRUPT_SAVE_AREA
+
+USB_NETWORK_DEVICE_TYPE *usb_network_device_ptr = (USB_NETWORK_DEVICE_TYPE*)ux_network_handle;
+ULONG                   queue_depth;
+
+
+    /* Check parameters.  */
+    if (usb_network_device_ptr == UX_NULL)
+        return(USB_NETWORK_DRIVER_FAILURE);
+
+    /* Reset the statistics, keep the queue state.  */
+    UX_DISABLE
+    queue_depth = usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_queue_depth;
+    _ux_utility_memory_set(&usb_network_device_ptr -> ux_network_device_statistics, 0,
+                           sizeof(USB_NETWORK_DEVICE_STATISTICS)); /* Use case of memset is verified. */
+    usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_queue_depth = queue_depth;
+    usb_network_device_ptr -> ux_network_device_statistics.ux_network_device_statistics_tx_queue_high_water = queue_depth;
+    UX_RESTORE
+
+    return(USB_NETWORK_DRIVER_SUCCESS);
 }
 #endif
+#endif
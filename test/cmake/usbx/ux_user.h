@@ -332,6 +332,15 @@
 void ux_test_assert_hit(char* file, int line);
 #define UX_ASSERT_FAIL ux_test_assert_hit(__FILE__, __LINE__);
 
+/* Defined, this defines the probe invoked at each stage of a HID input report.  */
+void ux_test_hid_latency_probe(unsigned int stage, unsigned char *buffer, unsigned long length);
+#define UX_HID_LATENCY_PROBE(stage, buffer, length) ux_test_hid_latency_probe(stage, buffer, (unsigned long)(length))
+
+/* Defined, this defines the time base of the audio classes statistics.  */
+unsigned long ux_test_audio_statistics_time_get(void);
+#define UX_DEVICE_CLASS_AUDIO_STATISTICS_TIME_GET() ux_test_audio_statistics_time_get()
+#define UX_HOST_CLASS_AUDIO_STATISTICS_TIME_GET() ux_test_audio_statistics_time_get()
+
 
 /* DEBUG includes and macros for a specific platform go here.  */
 #ifdef UX_INCLUDE_USER_DEFINE_BSP
@@ -0,0 +1,860 @@
+/* This benchmarks the end-to-end latency and jitter of an Audio 2.0 OUT
+   stream over the simulated controllers, at 48kHz, 96kHz and 192kHz. The
+   host application keeps requests queued and stamps each packet when it is
+   submitted, the test bridges the isochronous packets from the host to the
+   device one at a time and a codec reads the device FIFO after prefill.
+   The host and device classes stamp their statistics on a free-running
+   microsecond counter, the test never moves the clock. Host and device per
+   transfer statistics records are paired to check every packet is delivered
+   in order, the latencies and jitter are only reported.  */
+
+#include <stdio.h>
+#include <sys/time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_hcd_sim_host.h"
+
+#include "ux_device_class_audio.h"
+#include "ux_device_class_audio20.h"
+#include "ux_device_stack.h"
+
+#include "ux_host_class_audio.h"
+
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+#include "ux_test_utility_sim.h"
+
+
+/* Define constants.  */
+
+#define                             UX_DEMO_STACK_SIZE  1024
+#define                             UX_DEMO_MEMORY_SIZE (128*1024)
+
+#define                             TEST_FRAME_BYTES    4           /* 16-bit stereo.  */
+#define                             TEST_PACKET_MAX     (192 * TEST_FRAME_BYTES)
+#define                             TEST_FRAMES         400         /* Per rate.  */
+#define                             TEST_REQUESTS       3           /* Host requests kept queued.  */
+#define                             TEST_PREFILL        2           /* Packets received before codec starts.  */
+#define                             TEST_WAIT_LOOPS     1000
+
+#define                             TEST_RATES_NB       3
+
+/* Time t1 is not before t0, the counter may wrap.  */
+#define                             TEST_TIME_ORDERED(t0, t1)   ((ULONG)((t1) - (t0)) < 0x80000000ul)
+
+
+#if defined(UX_HOST_CLASS_AUDIO_2_SUPPORT)                                  && \
+    defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT)                       && \
+    defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)                         && \
+    (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS > 0)                          && \
+    (UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS > 0)                            && \
+    (UX_SLAVE_REQUEST_DATA_MAX_LENGTH >= TEST_PACKET_MAX)                   && \
+    !defined(UX_DEVICE_STANDALONE) && !defined(UX_HOST_STANDALONE)
+#define TEST_BENCHMARK_SUPPORT
+#endif
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+#if defined(TEST_BENCHMARK_SUPPORT)
+
+/* Define local/extern function prototypes.  */
+static TX_THREAD   tx_test_thread_host_simulation;
+static TX_THREAD   tx_test_thread_slave_simulation;
+static void        tx_test_thread_host_simulation_entry(ULONG);
+static void        tx_test_thread_slave_simulation_entry(ULONG);
+
+
+/* Define global data structures.  */
+static UCHAR                                    usbx_memory[UX_DEMO_MEMORY_SIZE + (UX_DEMO_STACK_SIZE * 2)];
+
+static UX_HOST_CLASS_AUDIO                      *host_audio_tx;
+static UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST     host_requests[TEST_REQUESTS];
+static ULONG                                    host_buffers[TEST_REQUESTS][TEST_PACKET_MAX / sizeof(ULONG)];
+static UX_HOST_CLASS_AUDIO_STATISTICS           host_statistics;
+static ULONG                                    host_streaming;
+static ULONG                                    host_sequence;
+static ULONG                                    host_packet_length;
+static ULONG                                    host_submit_times[TEST_FRAMES + TEST_REQUESTS];
+
+static UX_TRANSFER                              *bus_queue[TEST_REQUESTS + 1];
+static ULONG                                    bus_head;
+static ULONG                                    bus_tail;
+
+static UX_DEVICE_CLASS_AUDIO                    *slave_audio;
+static UX_DEVICE_CLASS_AUDIO_PARAMETER           slave_audio_parameter;
+static UX_DEVICE_CLASS_AUDIO_STREAM_PARAMETER    slave_audio_stream_parameter[1];
+static UX_DEVICE_CLASS_AUDIO_STREAM             *slave_audio_rx_stream;
+static UX_SLAVE_TRANSFER                        *slave_audio_rx_transfer;
+static UX_DEVICE_CLASS_AUDIO20_CONTROL          g_slave_audio20_control[1];
+static UX_DEVICE_CLASS_AUDIO_STATISTICS         slave_statistics;
+static UX_DEVICE_CLASS_AUDIO_STATISTICS_PARAMETER slave_statistics_parameter;
+
+static ULONG                                    codec_sequence;
+
+static ULONG                                    report_latency_min[TEST_RATES_NB];
+static ULONG                                    report_latency_max[TEST_RATES_NB];
+static ULONG                                    report_latency_mean[TEST_RATES_NB];
+static ULONG                                    report_bus_max[TEST_RATES_NB];
+static ULONG                                    report_interval_min[TEST_RATES_NB];
+static ULONG                                    report_interval_max[TEST_RATES_NB];
+static ULONG                                    report_level_max[TEST_RATES_NB];
+
+static ULONG                                    error_callback_counter;
+
+/* Sampling frequencies of the clock source, UAC 2.0 Layer 3 parameter block of RANGE.  */
+static UCHAR                                    audio20_cs_range[] = {
+    UX_W0 (     3), UX_W1 (     3), /* Number of subs.  */
+
+    UX_DW0( 48000), UX_DW1( 48000), UX_DW2( 48000), UX_DW3( 48000), /* dMIN  */
+    UX_DW0( 48000), UX_DW1( 48000), UX_DW2( 48000), UX_DW3( 48000), /* dMAX  */
+    UX_DW0(     0), UX_DW1(     0), UX_DW2(     0), UX_DW3(     0), /* dRES  */
+
+    UX_DW0( 96000), UX_DW1( 96000), UX_DW2( 96000), UX_DW3( 96000), /* dMIN  */
+    UX_DW0( 96000), UX_DW1( 96000), UX_DW2( 96000), UX_DW3( 96000), /* dMAX  */
+    UX_DW0(     0), UX_DW1(     0), UX_DW2(     0), UX_DW3(     0), /* dRES  */
+
+    UX_DW0(192000), UX_DW1(192000), UX_DW2(192000), UX_DW3(192000), /* dMIN  */
+    UX_DW0(192000), UX_DW1(192000), UX_DW2(192000), UX_DW3(192000), /* dMAX  */
+    UX_DW0(     0), UX_DW1(     0), UX_DW2(     0), UX_DW3(     0), /* dRES  */
+};
+
+/* Define device framework.  */
+
+#define D3(d) ((UCHAR)((d) >> 24))
+#define D2(d) ((UCHAR)((d) >> 16))
+#define D1(d) ((UCHAR)((d) >> 8))
+#define D0(d) ((UCHAR)((d) >> 0))
+
+static unsigned char device_framework_full_speed[] = {
+
+/* --------------------------------------- Device Descriptor */
+/* 0  bLength, bDescriptorType                               */ 18,   0x01,
+/* 2  bcdUSB                                                 */ D0(0x200),D1(0x200),
+/* 4  bDeviceClass, bDeviceSubClass, bDeviceProtocol         */ 0x00, 0x00, 0x00,
+/* 7  bMaxPacketSize0                                        */ 8,
+/* 8  idVendor, idProduct                                    */ 0x84, 0x84, 0x02, 0x00,
+/* 12 bcdDevice                                              */ D0(0x200),D1(0x200),
+/* 14 iManufacturer, iProduct, iSerialNumber                 */ 0,    0,    0,
+/* 17 bNumConfigurations                                     */ 1,
+
+/* ----------------------------- Device Qualifier Descriptor */
+/* 0 bLength, bDescriptorType                                */ 10,                 0x06,
+/* 2 bcdUSB                                                  */ D0(0x200),D1(0x200),
+/* 4 bDeviceClass, bDeviceSubClass, bDeviceProtocol          */ 0x00,               0x00, 0x00,
+/* 7 bMaxPacketSize0                                         */ 8,
+/* 8 bNumConfigurations                                      */ 1,
+/* 9 bReserved                                               */ 0,
+
+/* -------------------------------- Configuration Descriptor *//* 9+8+55+55=127 */
+/* 0 bLength, bDescriptorType                                */ 9,    0x02,
+/* 2 wTotalLength                                            */ D0(127),D1(127),
+/* 4 bNumInterfaces, bConfigurationValue                     */ 2,    1,
+/* 6 iConfiguration                                          */ 0,
+/* 7 bmAttributes, bMaxPower                                 */ 0x80, 50,
+
+/* ------------------------ Interface Association Descriptor */
+/* 0 bLength, bDescriptorType                                */ 8,    0x0B,
+/* 2 bFirstInterface, bInterfaceCount                        */ 0,    2,
+/* 4 bFunctionClass, bFunctionSubClass, bFunctionProtocol    */ 0x01, 0x00, 0x20,
+/* 7 iFunction                                               */ 0,
+
+/* ------------------------------------ Interface Descriptor *//* 0 Control (9+46=55) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 0,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x01, 0x20,
+/* 8 iInterface                                              */ 0,
+/* ---------------- Audio 2.0 AC Interface Header Descriptor *//* (9+8+17+12=46) */
+/* 0 bLength, bDescriptorType, bDescriptorSubtype            */ 9,                   0x24, 0x01,
+/* 3 bcdADC, bCategory                                       */ D0(0x200),D1(0x200), 0x01,
+/* 6 wTotalLength                                            */ D0(46),D1(46),
+/* 8 bmControls                                              */ 0x00,
+/* -------------------- Audio 2.0 AC Clock Source Descriptor (0x10) */
+/* 0 bLength, bDescriptorType, bDescriptorSubtype            */ 8,    0x24, 0x0A,
+/* 3 bClockID, bmAttributes, bmControls                      */ 0x10, 0x03, 0x07,
+/* 6 bAssocTerminal, iClockSource                            */ 0x00, 0,
+/* ------------------- Audio 2.0 AC Input Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 17,   0x24,                   0x02,
+/* 3  bTerminalID, wTerminalType                              */ 0x01, D0(0x0101),D1(0x0101),
+/* 6  bAssocTerminal, bCSourceID                              */ 0x00, 0x10,
+/* 8  bNrChannels, bmChannelConfig                            */ 0x02, D0(0),D1(0),D2(0),D3(0),
+/* 13 iChannelNames, bmControls, iTerminal                    */ 0,    D0(0),D1(0),            0,
+/* ------------------ Audio 2.0 AC Output Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 12,          0x24,                 0x03,
+/* 3  bTerminalID, wTerminalType                              */ 0x02,        D0(0x0301),D1(0x0301),
+/* 6  bAssocTerminal, bSourceID, bCSourceID                   */ 0x00,        0x01,                 0x10,
+/* 9  bmControls, iTerminal                                   */ D0(0),D1(0), 0,
+
+/* ------------------------------------ Interface Descriptor *//* 1 Stream OUT (9+9+16+6+7+8=55) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x20,
+/* 8 iInterface                                              */ 0,
+/* ------------------------------------ Interface Descriptor */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    1,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x20,
+/* 8 iInterface                                              */ 0,
+/* ------------------------ Audio 2.0 AS Interface Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 16,  0x24, 0x01,
+/* 3  bTerminalLink, bmControls                               */ 0x01,0x00,
+/* 5  bFormatType, bmFormats                                  */ 0x01,D0(1),D1(1),D2(1),D3(1),
+/* 10 bNrChannels, bmChannelConfig                            */ 2,   D0(0),D1(0),D2(0),D3(0),
+/* 15 iChannelNames                                           */ 0,
+/* ---------------------- Audio 2.0 AS Format Type Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 6,    0x24, 0x02,
+/* 3  bFormatType, bSubslotSize, bBitResolution               */ 0x01, 2,    16,
+/* ------------------------------------- Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 7,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x01,            0x09,
+/* 4  wMaxPacketSize, bInterval                               */ D0(TEST_PACKET_MAX),D1(TEST_PACKET_MAX), 1,
+/* ---------- Audio 2.0 AS ISO Audio Data Endpoint Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 8,    0x25,      0x01,
+/* 3  bmAttributes, bmControls                                */ 0x00, 0x00,
+/* 5  bLockDelayUnits, wLockDelay                             */ 0x00, D0(0),D1(0),
+};
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED sizeof(device_framework_full_speed)
+
+static unsigned char device_framework_high_speed[] = {
+
+/* --------------------------------------- Device Descriptor */
+/* 0  bLength, bDescriptorType                               */ 18,   0x01,
+/* 2  bcdUSB                                                 */ D0(0x200),D1(0x200),
+/* 4  bDeviceClass, bDeviceSubClass, bDeviceProtocol         */ 0x00, 0x00, 0x00,
+/* 7  bMaxPacketSize0                                        */ 8,
+/* 8  idVendor, idProduct                                    */ 0x84, 0x84, 0x02, 0x00,
+/* 12 bcdDevice                                              */ D0(0x200),D1(0x200),
+/* 14 iManufacturer, iProduct, iSerialNumber                 */ 0,    0,    0,
+/* 17 bNumConfigurations                                     */ 1,
+
+/* ----------------------------- Device Qualifier Descriptor */
+/* 0 bLength, bDescriptorType                                */ 10,                 0x06,
+/* 2 bcdUSB                                                  */ D0(0x200),D1(0x200),
+/* 4 bDeviceClass, bDeviceSubClass, bDeviceProtocol          */ 0x00,               0x00, 0x00,
+/* 7 bMaxPacketSize0                                         */ 8,
+/* 8 bNumConfigurations                                      */ 1,
+/* 9 bReserved                                               */ 0,
+
+/* -------------------------------- Configuration Descriptor *//* 9+8+55+55=127 */
+/* 0 bLength, bDescriptorType                                */ 9,    0x02,
+/* 2 wTotalLength                                            */ D0(127),D1(127),
+/* 4 bNumInterfaces, bConfigurationValue                     */ 2,    1,
+/* 6 iConfiguration                                          */ 0,
+/* 7 bmAttributes, bMaxPower                                 */ 0x80, 50,
+
+/* ------------------------ Interface Association Descriptor */
+/* 0 bLength, bDescriptorType                                */ 8,    0x0B,
+/* 2 bFirstInterface, bInterfaceCount                        */ 0,    2,
+/* 4 bFunctionClass, bFunctionSubClass, bFunctionProtocol    */ 0x01, 0x00, 0x20,
+/* 7 iFunction                                               */ 0,
+
+/* ------------------------------------ Interface Descriptor *//* 0 Control (9+46=55) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 0,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x01, 0x20,
+/* 8 iInterface                                              */ 0,
+/* ---------------- Audio 2.0 AC Interface Header Descriptor *//* (9+8+17+12=46) */
+/* 0 bLength, bDescriptorType, bDescriptorSubtype            */ 9,                   0x24, 0x01,
+/* 3 bcdADC, bCategory                                       */ D0(0x200),D1(0x200), 0x01,
+/* 6 wTotalLength                                            */ D0(46),D1(46),
+/* 8 bmControls                                              */ 0x00,
+/* -------------------- Audio 2.0 AC Clock Source Descriptor (0x10) */
+/* 0 bLength, bDescriptorType, bDescriptorSubtype            */ 8,    0x24, 0x0A,
+/* 3 bClockID, bmAttributes, bmControls                      */ 0x10, 0x03, 0x07,
+/* 6 bAssocTerminal, iClockSource                            */ 0x00, 0,
+/* ------------------- Audio 2.0 AC Input Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 17,   0x24,                   0x02,
+/* 3  bTerminalID, wTerminalType                              */ 0x01, D0(0x0101),D1(0x0101),
+/* 6  bAssocTerminal, bCSourceID                              */ 0x00, 0x10,
+/* 8  bNrChannels, bmChannelConfig                            */ 0x02, D0(0),D1(0),D2(0),D3(0),
+/* 13 iChannelNames, bmControls, iTerminal                    */ 0,    D0(0),D1(0),            0,
+/* ------------------ Audio 2.0 AC Output Terminal Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 12,          0x24,                 0x03,
+/* 3  bTerminalID, wTerminalType                              */ 0x02,        D0(0x0301),D1(0x0301),
+/* 6  bAssocTerminal, bSourceID, bCSourceID                   */ 0x00,        0x01,                 0x10,
+/* 9  bmControls, iTerminal                                   */ D0(0),D1(0), 0,
+
+/* ------------------------------------ Interface Descriptor *//* 1 Stream OUT (9+9+16+6+7+8=55) */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    0,
+/* 4 bNumEndpoints                                           */ 0,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x20,
+/* 8 iInterface                                              */ 0,
+/* ------------------------------------ Interface Descriptor */
+/* 0 bLength, bDescriptorType                                */ 9,    0x04,
+/* 2 bInterfaceNumber, bAlternateSetting                     */ 1,    1,
+/* 4 bNumEndpoints                                           */ 1,
+/* 5 bInterfaceClass, bInterfaceSubClass, bInterfaceProtocol */ 0x01, 0x02, 0x20,
+/* 8 iInterface                                              */ 0,
+/* ------------------------ Audio 2.0 AS Interface Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 16,  0x24, 0x01,
+/* 3  bTerminalLink, bmControls                               */ 0x01,0x00,
+/* 5  bFormatType, bmFormats                                  */ 0x01,D0(1),D1(1),D2(1),D3(1),
+/* 10 bNrChannels, bmChannelConfig                            */ 2,   D0(0),D1(0),D2(0),D3(0),
+/* 15 iChannelNames                                           */ 0,
+/* ---------------------- Audio 2.0 AS Format Type Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 6,    0x24, 0x02,
+/* 3  bFormatType, bSubslotSize, bBitResolution               */ 0x01, 2,    16,
+/* ------------------------------------- Endpoint Descriptor */
+/* 0  bLength, bDescriptorType                                */ 7,               0x05,
+/* 2  bEndpointAddress, bmAttributes                          */ 0x01,            0x09,
+/* 4  wMaxPacketSize, bInterval                               */ D0(TEST_PACKET_MAX),D1(TEST_PACKET_MAX), 4,
+/* ---------- Audio 2.0 AS ISO Audio Data Endpoint Descriptor */
+/* 0  bLength, bDescriptorType, bDescriptorSubtype            */ 8,    0x25,      0x01,
+/* 3  bmAttributes, bmControls                                */ 0x00, 0x00,
+/* 5  bLockDelayUnits, wLockDelay                             */ 0x00, D0(0),D1(0),
+};
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED sizeof(device_framework_high_speed)
+
+static unsigned char string_framework[] = {
+
+/* Manufacturer string descriptor : Index 1 - "Express Logic" */
+    0x09, 0x04, 0x01, 0x0c,
+    0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+    0x6f, 0x67, 0x69, 0x63,
+
+/* Product string descriptor : Index 2 - "EL Composite device" */
+    0x09, 0x04, 0x02, 0x13,
+    0x45, 0x4c, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+    0x73, 0x69, 0x74, 0x65, 0x20, 0x64, 0x65, 0x76,
+    0x69, 0x63, 0x65,
+
+/* Serial Number string descriptor : Index 3 - "0001" */
+    0x09, 0x04, 0x03, 0x04,
+    0x30, 0x30, 0x30, 0x31
+};
+#define STRING_FRAMEWORK_LENGTH sizeof(string_framework)
+
+/* Multiple languages are supported on the device, to add
+    a language besides English, the Unicode language code must
+    be appended to the language_id_framework array and the length
+    adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+/* English. */
+    0x09, 0x04
+};
+#define LANGUAGE_ID_FRAMEWORK_LENGTH sizeof(language_id_framework)
+
+
+/* Hooks define, the test is the isochronous bus.  */
+
+static VOID ux_device_class_audio_rx_hook(struct UX_TEST_ACTION_STRUCT *action, VOID *params)
+{
+
+UX_TEST_OVERRIDE_UX_DCD_SIM_SLAVE_FUNCTION_PARAMS *p = (UX_TEST_OVERRIDE_UX_DCD_SIM_SLAVE_FUNCTION_PARAMS *)params;
+
+
+    (void)action;
+
+    /* Device waits for next packet.  */
+    slave_audio_rx_transfer = (UX_SLAVE_TRANSFER *)p -> parameter;
+}
+
+static VOID ux_host_class_audio_tx_hook(struct UX_TEST_ACTION_STRUCT *action, VOID *params)
+{
+
+UX_TEST_OVERRIDE_UX_HCD_SIM_HOST_ENTRY_PARAMS   *p = (UX_TEST_OVERRIDE_UX_HCD_SIM_HOST_ENTRY_PARAMS*)params;
+
+
+    (void)action;
+
+    /* Host request queued for next frames.  */
+    bus_queue[bus_head] = (UX_TRANSFER *)p -> parameter;
+    bus_head = (bus_head + 1) % (TEST_REQUESTS + 1);
+}
+
+static UX_TEST_ACTION ux_audio_transfer_hook[] =
+{
+    {
+        .usbx_function = UX_TEST_OVERRIDE_UX_DCD_SIM_SLAVE_FUNCTION,
+        .function = UX_DCD_TRANSFER_REQUEST,
+        .action_func = ux_device_class_audio_rx_hook,
+        .req_setup = UX_NULL,
+        .req_action = UX_TEST_MATCH_EP,
+        .req_ep_address = 0x01,
+        .do_after = UX_FALSE,
+        .no_return = UX_FALSE,
+    },
+    {
+        .usbx_function = UX_TEST_OVERRIDE_UX_HCD_SIM_HOST_ENTRY,
+        .function = UX_HCD_TRANSFER_REQUEST,
+        .action_func = ux_host_class_audio_tx_hook,
+        .req_setup = UX_NULL,
+        .req_action = UX_TEST_MATCH_EP,
+        .req_ep_address = 0x01,
+        .do_after = UX_FALSE,
+        .no_return = UX_FALSE,
+    },
+{ 0 },
+};
+
+/* Define the ISR dispatch.  */
+
+extern VOID    (*test_isr_dispatch)(void);
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* Transfers aborted on stream stop are expected.  */
+    error_callback_counter ++;
+}
+
+static VOID    slave_audio_activate(VOID *audio_instance)
+{
+    slave_audio = (UX_DEVICE_CLASS_AUDIO *)audio_instance;
+    ux_device_class_audio_stream_get(slave_audio, 0, &slave_audio_rx_stream);
+}
+static VOID    slave_audio_deactivate(VOID *audio_instance)
+{
+    if ((VOID *)slave_audio == audio_instance)
+    {
+        slave_audio = UX_NULL;
+        slave_audio_rx_stream = UX_NULL;
+    }
+}
+static VOID    slave_audio_rx_stream_change(UX_DEVICE_CLASS_AUDIO_STREAM *audio, ULONG alt)
+{
+    slave_audio_rx_transfer = UX_NULL;
+}
+static UINT    slave_audio_control_process(UX_DEVICE_CLASS_AUDIO *audio, UX_SLAVE_TRANSFER *transfer)
+{
+
+UX_DEVICE_CLASS_AUDIO20_CONTROL_GROUP   group =
+    {1, g_slave_audio20_control};
+
+
+    return(ux_device_class_audio20_control_process(audio, transfer, &group));
+}
+
+static UINT test_host_change_function(ULONG event, UX_HOST_CLASS *cls, VOID *inst)
+{
+
+UX_HOST_CLASS_AUDIO *audio = (UX_HOST_CLASS_AUDIO *) inst;
+
+
+    switch(event)
+    {
+
+        case UX_DEVICE_INSERTION:
+
+            if (ux_host_class_audio_type_get(audio) == UX_HOST_CLASS_AUDIO_OUTPUT)
+                host_audio_tx = audio;
+            break;
+
+        case UX_DEVICE_REMOVAL:
+
+            if (audio == host_audio_tx)
+                host_audio_tx = UX_NULL;
+            break;
+
+        default:
+            break;
+    }
+    return 0;
+}
+#endif
+
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio20_streaming_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+#if defined(TEST_BENCHMARK_SUPPORT)
+UINT                    status;
+CHAR *                  stack_pointer;
+CHAR *                  memory_pointer;
+#endif
+
+
+    /* Inform user.  */
+    printf("Running Audio 2.0 Streaming Benchmark............................... ");
+
+#if !defined(TEST_BENCHMARK_SUPPORT)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    stepinfo("\n");
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(test_host_change_function);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Register Audio class.  */
+    status  = ux_host_stack_class_register(_ux_system_host_class_audio_name, ux_host_class_audio_entry);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Set the parameters for callback when insertion/extraction of a Audio 2.0 speaker.  */
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_thread_entry = ux_device_class_audio_read_thread_entry;
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_callbacks.ux_device_class_audio_stream_change = slave_audio_rx_stream_change;
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_max_frame_buffer_size = TEST_PACKET_MAX + 8;
+    slave_audio_stream_parameter[0].ux_device_class_audio_stream_parameter_max_frame_buffer_nb   = 8;
+    slave_audio_parameter.ux_device_class_audio_parameter_streams = slave_audio_stream_parameter;
+    slave_audio_parameter.ux_device_class_audio_parameter_streams_nb = 1;
+    slave_audio_parameter.ux_device_class_audio_parameter_callbacks.ux_slave_class_audio_instance_activate   = slave_audio_activate;
+    slave_audio_parameter.ux_device_class_audio_parameter_callbacks.ux_slave_class_audio_instance_deactivate = slave_audio_deactivate;
+    slave_audio_parameter.ux_device_class_audio_parameter_callbacks.ux_device_class_audio_control_process = slave_audio_control_process;
+    slave_audio_parameter.ux_device_class_audio_parameter_callbacks.ux_device_class_audio_arg             = UX_NULL;
+
+    g_slave_audio20_control[0].ux_device_class_audio20_control_cs_id                = 0x10;
+    g_slave_audio20_control[0].ux_device_class_audio20_control_sampling_frequency   = 0;
+    g_slave_audio20_control[0].ux_device_class_audio20_control_sampling_frequency_cur = 48000;
+    g_slave_audio20_control[0].ux_device_class_audio20_control_sampling_frequency_range = audio20_cs_range;
+
+    /* Initialize the device Audio class. This class owns interfaces starting with 0, 1.  */
+    status  = ux_device_stack_class_register(_ux_system_slave_class_audio_name, ux_device_class_audio_entry,
+                                             1, 0,  &slave_audio_parameter);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Hook ISO transfers.  */
+    ux_test_link_hooks_from_array(ux_audio_transfer_hook);
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_test_dcd_sim_slave_initialize();
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_test_hcd_sim_host_initialize,0,0);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_test_thread_host_simulation, "tx demo host simulation", tx_test_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_CHECK_SUCCESS(status);
+
+    /* Create the main slave simulation  thread.  */
+    status =  tx_thread_create(&tx_test_thread_slave_simulation, "tx demo slave simulation", tx_test_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_CHECK_SUCCESS(status);
+#endif
+}
+#if defined(TEST_BENCHMARK_SUPPORT)
+
+static UINT test_wait_until_not_null(VOID **ptr, ULONG loop)
+{
+    while(loop --)
+    {
+        _ux_utility_delay_ms(10);
+        if (*ptr != UX_NULL)
+            return UX_SUCCESS;
+    }
+    return UX_ERROR;
+}
+
+static ULONG  test_time_us(VOID)
+{
+
+struct timeval  now;
+
+    gettimeofday(&now, UX_NULL);
+    return((ULONG)now.tv_sec * 1000000ul + (ULONG)now.tv_usec);
+}
+
+static UINT  device_ready_wait(VOID)
+{
+ULONG       loop;
+
+    /* Device read thread runs at the same priority, yield to it first.  */
+    for (loop = 0; loop < TEST_WAIT_LOOPS; loop ++)
+    {
+        if (slave_audio_rx_transfer != UX_NULL)
+            return(UX_SUCCESS);
+        if (loop < TEST_WAIT_LOOPS / 2)
+            tx_thread_relinquish();
+        else
+            _ux_utility_thread_sleep(1);
+    }
+    return(UX_ERROR);
+}
+
+static UINT  host_request_submit(UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST *request)
+{
+ULONG       *data = (ULONG *)request -> ux_host_class_audio_transfer_request_data_pointer;
+
+    /* Packet stamped with sequence and submit time.  */
+    data[0] = host_sequence;
+    data[1] = test_time_us();
+    if (host_sequence < TEST_FRAMES + TEST_REQUESTS)
+        host_submit_times[host_sequence] = data[1];
+    host_sequence ++;
+    request -> ux_host_class_audio_transfer_request_requested_length = host_packet_length;
+    request -> ux_host_class_audio_transfer_request_packet_size = host_packet_length;
+    return(ux_host_class_audio_write(host_audio_tx, request));
+}
+
+static VOID  host_request_done(UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST *request)
+{
+
+    /* Application keeps requests queued.  */
+    if (host_streaming)
+        UX_TEST_CHECK_SUCCESS(host_request_submit(request));
+}
+
+/* The oldest queued host packet, if any, is sent to the device.  */
+static UINT  bus_transfer(VOID)
+{
+UX_TRANSFER         *transfer;
+UX_SLAVE_TRANSFER   *slave_transfer;
+ULONG               length;
+
+    if (bus_tail == bus_head)
+        return(UX_ERROR);
+    transfer = bus_queue[bus_tail];
+    bus_tail = (bus_tail + 1) % (TEST_REQUESTS + 1);
+
+    /* Device is waiting.  */
+    UX_TEST_CHECK_SUCCESS(device_ready_wait());
+    slave_transfer = slave_audio_rx_transfer;
+    slave_audio_rx_transfer = UX_NULL;
+
+    /* Transaction done, host completion first then device.  */
+    length = transfer -> ux_transfer_request_requested_length;
+    _ux_utility_memory_copy(slave_transfer -> ux_slave_transfer_request_data_pointer,
+                            transfer -> ux_transfer_request_data_pointer, length);
+    slave_transfer -> ux_slave_transfer_request_actual_length = length;
+    slave_transfer -> ux_slave_transfer_request_completion_code = UX_SUCCESS;
+    transfer -> ux_transfer_request_actual_length = length;
+    transfer -> ux_transfer_request_completion_code = UX_SUCCESS;
+    transfer -> ux_transfer_request_completion_function(transfer);
+    _ux_utility_semaphore_put(&slave_transfer -> ux_slave_transfer_request_semaphore);
+
+    /* Device has taken the packet once it waits for the next one.  */
+    UX_TEST_CHECK_SUCCESS(device_ready_wait());
+    return(UX_SUCCESS);
+}
+
+static UINT  slave_statistics_get(VOID)
+{
+    slave_statistics_parameter.ux_device_class_audio_statistics_parameter_stream_index = 0;
+    slave_statistics_parameter.ux_device_class_audio_statistics_parameter_statistics = &slave_statistics;
+    return(ux_device_class_audio_ioctl(slave_audio, UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET, &slave_statistics_parameter));
+}
+
+static VOID  stream_run(ULONG rate_index, ULONG sample_rate)
+{
+UINT                                    status;
+UX_HOST_CLASS_AUDIO_SAMPLING            sampling;
+UX_HOST_CLASS_AUDIO_STATISTICS_RECORD   *host_record;
+UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORD *slave_record;
+UCHAR                                   *frame_data;
+ULONG                                   frame_length;
+ULONG                                   frame;
+ULONG                                   now;
+ULONG                                   latency;
+ULONG                                   latency_min;
+ULONG                                   latency_max;
+ULONG                                   latency_sum;
+ULONG                                   latency_count;
+ULONG                                   bus;
+ULONG                                   i;
+
+
+    /* Host selects the rate, device stream restarts.  */
+    sampling.ux_host_class_audio_sampling_channels =   2;
+    sampling.ux_host_class_audio_sampling_frequency =  sample_rate;
+    sampling.ux_host_class_audio_sampling_resolution = 16;
+    status =  ux_host_class_audio_streaming_sampling_set(host_audio_tx, &sampling);
+    UX_TEST_CHECK_SUCCESS(status);
+    UX_TEST_ASSERT(g_slave_audio20_control[0].ux_device_class_audio20_control_sampling_frequency_cur == sample_rate);
+    host_packet_length = sample_rate / 1000 * TEST_FRAME_BYTES;
+    UX_TEST_ASSERT(host_audio_tx -> ux_host_class_audio_packet_size == host_packet_length);
+    status = ux_device_class_audio_reception_start(slave_audio_rx_stream);
+    UX_TEST_CHECK_SUCCESS(status);
+    UX_TEST_CHECK_SUCCESS(device_ready_wait());
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_statistics_reset(host_audio_tx, UX_NULL));
+
+    /* Application queues its requests.  */
+    host_sequence = 0;
+    codec_sequence = 0;
+    host_streaming = 1;
+    bus_head = 0;
+    bus_tail = 0;
+    for (i = 0; i < TEST_REQUESTS; i ++)
+        UX_TEST_CHECK_SUCCESS(host_request_submit(&host_requests[i]));
+
+    latency_min = 0xFFFFFFFF;
+    latency_max = 0;
+    latency_sum = 0;
+    latency_count = 0;
+    bus = 0;
+    for (frame = 0; frame < TEST_FRAMES; frame ++)
+    {
+
+        /* Next packet sent.  */
+        UX_TEST_CHECK_SUCCESS(bus_transfer());
+
+        /* Both sides recorded the same transfer.  */
+        UX_TEST_CHECK_SUCCESS(ux_host_class_audio_statistics_get(host_audio_tx, &host_statistics));
+        UX_TEST_CHECK_SUCCESS(slave_statistics_get());
+        UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_transfers == frame + 1);
+        UX_TEST_ASSERT(slave_statistics.ux_device_class_audio_statistics_transfers == frame + 1);
+        host_record = &host_statistics.ux_host_class_audio_statistics_records[frame & (UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+        slave_record = &slave_statistics.ux_device_class_audio_statistics_records[frame & (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+        UX_TEST_ASSERT(host_record -> ux_host_class_audio_statistics_record_length == host_packet_length);
+        UX_TEST_ASSERT(slave_record -> ux_device_class_audio_statistics_record_length == host_packet_length);
+        UX_TEST_ASSERT(host_record -> ux_host_class_audio_statistics_record_level == TEST_REQUESTS - 1);
+        UX_TEST_ASSERT(TEST_TIME_ORDERED(host_submit_times[frame], host_record -> ux_host_class_audio_statistics_record_time));
+
+        /* Host class completes the transfer before the device class gets it.  */
+        UX_TEST_ASSERT_MESSAGE(TEST_TIME_ORDERED(host_record -> ux_host_class_audio_statistics_record_time,
+                                                 slave_record -> ux_device_class_audio_statistics_record_time),
+                               "frame %ld: device before host\n", (long)frame);
+        i = slave_record -> ux_device_class_audio_statistics_record_time -
+            host_record -> ux_host_class_audio_statistics_record_time;
+        if (i > bus)
+            bus = i;
+
+        /* Codec takes a packet after prefill.  */
+        if (frame + 1 < TEST_PREFILL)
+            continue;
+        status = ux_device_class_audio_read_frame_get(slave_audio_rx_stream, &frame_data, &frame_length);
+        UX_TEST_CHECK_SUCCESS(status);
+        UX_TEST_ASSERT(frame_length == host_packet_length);
+        UX_TEST_ASSERT(((ULONG *)frame_data)[0] == codec_sequence);
+        now = test_time_us();
+        UX_TEST_ASSERT(TEST_TIME_ORDERED(slave_record -> ux_device_class_audio_statistics_record_time, now));
+        latency = now - ((ULONG *)frame_data)[1];
+        UX_TEST_CHECK_SUCCESS(ux_device_class_audio_read_frame_free(slave_audio_rx_stream));
+
+        /* Packets queued before streaming are not steady.  */
+        if (codec_sequence ++ < TEST_REQUESTS)
+            continue;
+        if (latency < latency_min)
+            latency_min = latency;
+        if (latency > latency_max)
+            latency_max = latency;
+        latency_sum += latency;
+        latency_count ++;
+    }
+
+    /* No xrun while streaming.  */
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_xruns == 0);
+    UX_TEST_ASSERT(slave_statistics.ux_device_class_audio_statistics_xruns == 0);
+    UX_TEST_ASSERT(slave_statistics.ux_device_class_audio_statistics_level_max <= TEST_PREFILL + 1);
+
+    /* Steady latency: host queue, host and device classes, then device FIFO.  */
+    UX_TEST_ASSERT(latency_count == TEST_FRAMES - TEST_PREFILL + 1 - TEST_REQUESTS);
+    UX_TEST_ASSERT(latency_min <= latency_max);
+    report_latency_min[rate_index] = latency_min;
+    report_latency_max[rate_index] = latency_max;
+    report_latency_mean[rate_index] = latency_sum / latency_count;
+    report_bus_max[rate_index] = bus;
+    report_interval_min[rate_index] = slave_statistics.ux_device_class_audio_statistics_interval_min;
+    report_interval_max[rate_index] = slave_statistics.ux_device_class_audio_statistics_interval_max;
+    report_level_max[rate_index] = slave_statistics.ux_device_class_audio_statistics_level_max;
+
+    /* Application stops, queued requests drain, then stream stops.  */
+    host_streaming = 0;
+    while(bus_transfer() == UX_SUCCESS);
+    UX_TEST_ASSERT(host_audio_tx -> ux_host_class_audio_pending_transfers == 0);
+    status = ux_host_class_audio_stop(host_audio_tx);
+    UX_TEST_CHECK_SUCCESS(status);
+}
+
+void  tx_test_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                                                status;
+ULONG                                               i;
+
+
+    /* Test connect.  */
+    status  = test_wait_until_not_null((void**)&host_audio_tx, 100);
+    status |= test_wait_until_not_null((void**)&slave_audio_rx_stream, 100);
+    UX_TEST_CHECK_SUCCESS(status);
+    UX_TEST_ASSERT(ux_host_class_audio_protocol_get(host_audio_tx) == UX_HOST_CLASS_AUDIO_PROTOCOL_IP_VERSION_02_00);
+    UX_TEST_ASSERT(ux_host_class_audio_speed_get(host_audio_tx) == UX_FULL_SPEED_DEVICE);
+
+    /* Classes statistics are stamped on the free-running counter.  */
+    ux_test_audio_statistics_time_set(test_time_us);
+
+    /* Prepare the audio transfer requests.  */
+    for (i = 0; i < TEST_REQUESTS; i ++)
+    {
+        host_requests[i].ux_host_class_audio_transfer_request_completion_function = host_request_done;
+        host_requests[i].ux_host_class_audio_transfer_request_class_instance = host_audio_tx;
+        host_requests[i].ux_host_class_audio_transfer_request_data_pointer = (UCHAR *)host_buffers[i];
+    }
+
+    /* Stream at 48kHz, 96kHz and 192kHz.  */
+    for (i = 0; i < TEST_RATES_NB; i ++)
+        stream_run(i, 48000 << i);
+
+    ux_test_audio_statistics_time_set(UX_NULL);
+
+    /* Finally disconnect the device. */
+    ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    ux_device_stack_class_unregister(_ux_system_slave_class_audio_name, ux_device_class_audio_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+
+    /* Report end-to-end latency (submit to codec read), its jitter, host to device
+       class time and device transfer intervals, in us.  */
+    for (i = 0; i < TEST_RATES_NB; i ++)
+    {
+        printf("  %6ld Hz: latency %ld us (%ld..%ld), jitter %ld us, host to device %ld us max, interval %ld..%ld us, FIFO %ld frames max\n",
+               (long)(48000 << i), (long)report_latency_mean[i],
+               (long)report_latency_min[i], (long)report_latency_max[i],
+               (long)(report_latency_max[i] - report_latency_min[i]),
+               (long)report_bus_max[i],
+               (long)report_interval_min[i], (long)report_interval_max[i],
+               (long)report_level_max[i]);
+    }
+    test_control_return(0);
+}
+
+void  tx_test_thread_slave_simulation_entry(ULONG arg)
+{
+    while(1)
+    {
+
+        /* Sleep so ThreadX on Win32 will delete this thread. */
+        tx_thread_sleep(10);
+    }
+}
+#endif
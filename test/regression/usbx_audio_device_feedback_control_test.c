@@ -0,0 +1,304 @@
+/* This tests the device audio feedback control: the feedback of an OUT stream
+   is computed from the stream FIFO level by a PI loop, encoded in 10.14 or
+   16.16 format. A simulated host that sends samples at the feedback rate and
+   a codec that consumes them at a slightly different rate are kept locked,
+   with the FIFO level held around its target.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_device_stack.h"
+#include "ux_device_class_audio.h"
+
+#include "ux_test.h"
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_MEMORY_SIZE                 (64*1024)
+
+#define TEST_FRAME_BYTES                    4           /* 16-bit stereo.  */
+#define TEST_FRAME_DATA_SIZE                (64 * TEST_FRAME_BYTES)
+#define TEST_FRAME_BUFFER_SIZE              (TEST_FRAME_DATA_SIZE + 8)
+#define TEST_FRAME_BUFFER_NB                16
+
+#define TEST_TARGET_LEVEL                   96
+#define TEST_RATE_48K                       (48ul << 16)
+
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+
+static ULONG                                usbx_memory[UX_TEST_MEMORY_SIZE / sizeof(ULONG)];
+static ULONG                                stream_buffer[TEST_FRAME_BUFFER_SIZE * TEST_FRAME_BUFFER_NB / sizeof(ULONG)];
+
+static UX_DEVICE_CLASS_AUDIO_STREAM         stream;
+static UX_SLAVE_ENDPOINT                    endpoint;
+static UX_SLAVE_ENDPOINT                    feedback;
+static UCHAR                                feedback_buffer[8];
+static UCHAR                                packet[TEST_FRAME_DATA_SIZE];
+
+static UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_PARAMETER parameter;
+
+static VOID  stream_reset(VOID)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+ULONG                           i;
+
+    /* The OUT stream has its data and feedback endpoints and empty frame buffers.  */
+    endpoint.ux_slave_endpoint_descriptor.bEndpointAddress = 0x01;
+    feedback.ux_slave_endpoint_descriptor.bEndpointAddress = 0x82;
+    feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_data_pointer = feedback_buffer;
+    feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_transfer_length = 4;
+    feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length = 0;
+    stream.ux_device_class_audio_stream_endpoint = &endpoint;
+    stream.ux_device_class_audio_stream_feedback = &feedback;
+    stream.ux_device_class_audio_stream_buffer = (UCHAR *)stream_buffer;
+    stream.ux_device_class_audio_stream_buffer_size = sizeof(stream_buffer);
+    stream.ux_device_class_audio_stream_frame_buffer_size = TEST_FRAME_BUFFER_SIZE;
+    stream.ux_device_class_audio_stream_underrun_count = 0;
+    for (i = 0; i < TEST_FRAME_BUFFER_NB; i ++)
+    {
+        frame = (UX_DEVICE_CLASS_AUDIO_FRAME *)((UCHAR *)stream_buffer + i * TEST_FRAME_BUFFER_SIZE);
+        frame -> ux_device_class_audio_frame_length = 0;
+        frame -> ux_device_class_audio_frame_pos = 0;
+    }
+    stream.ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)stream_buffer;
+    stream.ux_device_class_audio_stream_access_pos = stream.ux_device_class_audio_stream_transfer_pos;
+    _ux_utility_memory_set(feedback_buffer, 0, sizeof(feedback_buffer));
+}
+
+static VOID  stream_receive(ULONG frames)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+UCHAR                           *next;
+
+    /* Log the packet as the read thread does.  */
+    frame = stream.ux_device_class_audio_stream_transfer_pos;
+    _ux_utility_memory_copy(frame -> ux_device_class_audio_frame_data, packet, frames * TEST_FRAME_BYTES);
+    frame -> ux_device_class_audio_frame_length = frames * TEST_FRAME_BYTES;
+    frame -> ux_device_class_audio_frame_pos = 0;
+    next = (UCHAR *)frame + TEST_FRAME_BUFFER_SIZE;
+    if (next >= (UCHAR *)stream_buffer + sizeof(stream_buffer))
+        next = (UCHAR *)stream_buffer;
+    if (((UX_DEVICE_CLASS_AUDIO_FRAME *)next) -> ux_device_class_audio_frame_length == 0)
+        stream.ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next;
+}
+
+static VOID  parameter_set(ULONG sample_rate, ULONG kp, ULONG ki, ULONG max_deviation, ULONG format)
+{
+    parameter.ux_device_class_audio_feedback_control_parameter_sample_rate = sample_rate;
+    parameter.ux_device_class_audio_feedback_control_parameter_frame_bytes = TEST_FRAME_BYTES;
+    parameter.ux_device_class_audio_feedback_control_parameter_target_level = TEST_TARGET_LEVEL;
+    parameter.ux_device_class_audio_feedback_control_parameter_kp = kp;
+    parameter.ux_device_class_audio_feedback_control_parameter_ki = ki;
+    parameter.ux_device_class_audio_feedback_control_parameter_max_deviation = max_deviation;
+    parameter.ux_device_class_audio_feedback_control_parameter_format = format;
+}
+
+/* Feedback seen by host, in samples per millisecond, 16.16.  */
+static ULONG feedback_decode(VOID)
+{
+ULONG                           value;
+ULONG                           length;
+
+    length = feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length;
+    if (length == 3)
+        value = ((ULONG)feedback_buffer[0] | ((ULONG)feedback_buffer[1] << 8) | ((ULONG)feedback_buffer[2] << 16)) << 2;
+    else
+        value = _ux_utility_long_get(feedback_buffer);
+    if (_ux_system_slave -> ux_system_slave_speed == UX_HIGH_SPEED_DEVICE)
+        value <<= 3;
+    return(value);
+}
+#endif
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio_device_feedback_control_test_application_define(void *first_unused_memory)
+#endif
+{
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+
+UINT                            status;
+UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL  *control;
+UX_DEVICE_CLASS_AUDIO_SAMPLES   samples;
+ULONG                           actual_frames;
+ULONG                           host_rate, host_acc, codec_rate, codec_acc;
+ULONG                           frames;
+ULONG                           ms;
+ULONG                           level_min, level_max;
+LONG                            error_sum;
+#endif
+
+
+    /* Inform user.  */
+    printf("Running Audio Device Feedback Control Test.......................... ");
+#if !defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_CONTROL_SUPPORT)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(usbx_memory, UX_TEST_MEMORY_SIZE, UX_NULL, 0));
+    _ux_system_slave -> ux_system_slave_device.ux_slave_device_state = UX_DEVICE_CONFIGURED;
+    _ux_system_slave -> ux_system_slave_speed = UX_FULL_SPEED_DEVICE;
+    control = &stream.ux_device_class_audio_stream_feedback_control;
+
+    /* Nominal rate at target level, 10.14 in full speed.  */
+    stream_reset();
+    parameter_set(48000, 0x0400, 0x0010, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_nominal_rate == TEST_RATE_48K);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_max_deviation == (LONG)(TEST_RATE_48K * 2 / 1000));
+    stream_receive(64);
+    stream_receive(32);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length == 3);
+    UX_TEST_ASSERT(feedback_buffer[0] == 0x00 && feedback_buffer[1] == 0x00 && feedback_buffer[2] == 0x0C);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_level == TEST_TARGET_LEVEL);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_rate_error == 0);
+
+    /* 16.16 per micro-frame in high speed.  */
+    _ux_system_slave -> ux_system_slave_speed = UX_HIGH_SPEED_DEVICE;
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length == 4);
+    UX_TEST_ASSERT(_ux_utility_long_get(feedback_buffer) == (6ul << 16));
+
+    /* 16.16 per frame in full speed, if selected.  */
+    _ux_system_slave -> ux_system_slave_speed = UX_FULL_SPEED_DEVICE;
+    parameter_set(48000, 0x0400, 0x0010, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length == 4);
+    UX_TEST_ASSERT(_ux_utility_long_get(feedback_buffer) == TEST_RATE_48K);
+
+    /* Fractional nominal rate.  */
+    parameter_set(44100, 0, 0, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_10_14);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length == 3);
+    UX_TEST_ASSERT(feedback_buffer[0] == 0x66 && feedback_buffer[1] == 0x06 && feedback_buffer[2] == 0x0B);
+
+    /* Proportional correction of a low level, then bounded correction.  */
+    stream_reset();
+    stream_receive(64);
+    stream_receive(22);
+    parameter_set(48000, 0x0100, 0, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_level == 86);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_rate_error == 10 * 0x0100);
+    UX_TEST_ASSERT(feedback_decode() == TEST_RATE_48K + 10 * 0x0100);
+    parameter_set(48000, 0xFFFF, 0xFFFF, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_rate_error ==
+                   control -> ux_device_class_audio_feedback_control_max_deviation);
+    stream_receive(64);
+    stream_receive(64);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_rate_error ==
+                   -control -> ux_device_class_audio_feedback_control_max_deviation);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_level_min == 86);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_level_max == 214);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_updates == 2);
+
+    /* Measured codec rate is the base of feedback.  */
+    stream_reset();
+    stream_receive(64);
+    stream_receive(32);
+    parameter_set(48000, 0x0100, 0x0010, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_rate_set(&stream, TEST_RATE_48K + 0x1000));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(feedback_decode() == TEST_RATE_48K + 0x1000);
+    UX_TEST_ASSERT(control -> ux_device_class_audio_feedback_control_rate_error == 0x1000);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_rate_set(&stream, 0));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+    UX_TEST_ASSERT(feedback_decode() == TEST_RATE_48K);
+
+    /* Closed loop: codec clock is 1000ppm faster than nominal.  */
+    stream_reset();
+    parameter_set(48000, 0x0520, 0x0020, 2000, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    samples.ux_device_class_audio_samples_buffer = packet;
+    samples.ux_device_class_audio_samples_format = UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM;
+    samples.ux_device_class_audio_samples_channels = 2;
+    samples.ux_device_class_audio_samples_subframe_size = 2;
+    samples.ux_device_class_audio_samples_planar_stride = 0;
+    samples.ux_device_class_audio_samples_packet_frames = 0;
+    codec_rate = TEST_RATE_48K + TEST_RATE_48K / 1000;
+    host_rate = TEST_RATE_48K;
+    host_acc = 0;
+    codec_acc = 0;
+    level_min = 0xFFFFFFFF;
+    level_max = 0;
+    error_sum = 0;
+    for (ms = 0; ms < 4000; ms ++)
+    {
+
+        /* Host sends at feedback rate.  */
+        host_acc += host_rate;
+        stream_receive(host_acc >> 16);
+        host_acc &= 0xFFFF;
+
+        /* Codec starts once target is reached.  */
+        if (ms > 2)
+        {
+            codec_acc += codec_rate;
+            frames = codec_acc >> 16;
+            codec_acc &= 0xFFFF;
+            status = ux_device_class_audio_samples_read(&stream, &samples, frames, &actual_frames);
+            UX_TEST_ASSERT(status == UX_SUCCESS);
+        }
+
+        /* Feedback polled every frame.  */
+        UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_update(&stream));
+        host_rate = feedback_decode();
+
+        /* Locked state.  */
+        if (ms >= 3000)
+        {
+            if (control -> ux_device_class_audio_feedback_control_level < level_min)
+                level_min = control -> ux_device_class_audio_feedback_control_level;
+            if (control -> ux_device_class_audio_feedback_control_level > level_max)
+                level_max = control -> ux_device_class_audio_feedback_control_level;
+            error_sum += control -> ux_device_class_audio_feedback_control_rate_error;
+        }
+    }
+    UX_TEST_ASSERT_MESSAGE(level_min + 8 >= TEST_TARGET_LEVEL && level_max <= TEST_TARGET_LEVEL + 8,
+                           "level %ld..%ld\n", (long)level_min, (long)level_max);
+    error_sum /= 1000;
+    UX_TEST_ASSERT_MESSAGE(error_sum > (LONG)(TEST_RATE_48K / 1000) - 0x100 && error_sum < (LONG)(TEST_RATE_48K / 1000) + 0x100,
+                           "rate error %ld\n", (long)error_sum);
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_underrun_count == 0);
+
+    /* Parameters and states errors.  */
+    parameter_set(0, 0, 0, 0, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_set(&stream, &parameter) == UX_INVALID_PARAMETER);
+    parameter_set(48000, 0x10000, 0, 0, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_AUTO);
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_set(&stream, &parameter) == UX_INVALID_PARAMETER);
+    parameter_set(48000, 0, 0, 0, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16 + 1);
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_set(&stream, &parameter) == UX_INVALID_PARAMETER);
+    parameter_set(48000, 0, 0, 0, UX_DEVICE_CLASS_AUDIO_FEEDBACK_FORMAT_16_16);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, &parameter));
+    feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_transfer_length = 3;
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_update(&stream) == UX_MEMORY_INSUFFICIENT);
+    feedback.ux_slave_endpoint_descriptor.bEndpointAddress = 0x02;
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_update(&stream) == UX_ERROR);
+    stream.ux_device_class_audio_stream_feedback = UX_NULL;
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_update(&stream) == UX_ERROR);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_feedback_control_set(&stream, UX_NULL));
+    stream_reset();
+    UX_TEST_ASSERT(ux_device_class_audio_feedback_control_update(&stream) == UX_ERROR);
+    UX_TEST_ASSERT(_uxe_device_class_audio_feedback_control_set(UX_NULL, &parameter) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(_uxe_device_class_audio_feedback_control_rate_set(UX_NULL, 0) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(_uxe_device_class_audio_feedback_control_update(UX_NULL) == UX_INVALID_PARAMETER);
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+#endif
+}
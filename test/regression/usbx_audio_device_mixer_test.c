@@ -0,0 +1,363 @@
+/* This tests the device audio mixer: OUT streams are mixed block by block to
+   an application buffer and an application buffer is routed to IN streams,
+   with gains of feature unit mute and volume controls set through the audio
+   2.0 control process. Underruns are mixed as silence, sums are saturated.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_device_stack.h"
+#include "ux_device_class_audio.h"
+#include "ux_device_class_audio20.h"
+
+#include "ux_test.h"
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_MEMORY_SIZE                 (64*1024)
+
+#define TEST_FRAME_DATA_SIZE                48
+#define TEST_FRAME_BUFFER_SIZE              (TEST_FRAME_DATA_SIZE + 8)
+#define TEST_FRAME_BUFFER_NB                4
+
+#define TEST_CHANNELS                       2
+#define TEST_FRAMES                         8           /* Frames per block.  */
+#define TEST_STREAMS_NB                     2           /* Stream 0 is 16-bit, stream 1 is 24-bit.  */
+#define TEST_FU_ID                          10
+
+#if defined(UX_DEVICE_CLASS_AUDIO_MIXER_SUPPORT)
+
+static ULONG                                usbx_memory[UX_TEST_MEMORY_SIZE / sizeof(ULONG)];
+static ULONG                                stream_buffer[TEST_STREAMS_NB * 2][TEST_FRAME_BUFFER_SIZE * TEST_FRAME_BUFFER_NB / sizeof(ULONG)];
+
+static UX_DEVICE_CLASS_AUDIO                audio;
+static UX_SLAVE_DEVICE                      device;
+static UX_DEVICE_CLASS_AUDIO_STREAM         out_stream[TEST_STREAMS_NB];
+static UX_DEVICE_CLASS_AUDIO_STREAM         in_stream[TEST_STREAMS_NB];
+static UX_SLAVE_ENDPOINT                    out_endpoint[TEST_STREAMS_NB];
+static UX_SLAVE_ENDPOINT                    in_endpoint[TEST_STREAMS_NB];
+
+static UX_DEVICE_CLASS_AUDIO20_CONTROL      control;
+static UX_DEVICE_CLASS_AUDIO20_CONTROL_GROUP control_group = {1, &control};
+static UCHAR                                control_data[2];
+
+static UX_DEVICE_CLASS_AUDIO_MIXER_PORT     inputs[TEST_STREAMS_NB];
+static UX_DEVICE_CLASS_AUDIO_MIXER_PORT     outputs[TEST_STREAMS_NB];
+static UX_DEVICE_CLASS_AUDIO_MIXER          mixer;
+static LONG                                 mixer_work[TEST_FRAMES * TEST_CHANNELS];
+static LONG                                 mixed[TEST_FRAMES * TEST_CHANNELS];
+static LONG                                 capture[TEST_FRAMES * TEST_CHANNELS];
+
+static UCHAR                                packet[TEST_FRAME_DATA_SIZE];
+
+static VOID  stream_reset(UX_DEVICE_CLASS_AUDIO_STREAM *stream, UX_SLAVE_ENDPOINT *endpoint, UCHAR endpoint_address, ULONG *buffer)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+ULONG                           i;
+
+    /* The stream has its data endpoint and empty frame buffers.  */
+    endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress = endpoint_address;
+    stream -> ux_device_class_audio_stream_endpoint = endpoint;
+    stream -> ux_device_class_audio_stream_buffer = (UCHAR *)buffer;
+    stream -> ux_device_class_audio_stream_buffer_size = TEST_FRAME_BUFFER_SIZE * TEST_FRAME_BUFFER_NB;
+    stream -> ux_device_class_audio_stream_frame_buffer_size = TEST_FRAME_BUFFER_SIZE;
+    stream -> ux_device_class_audio_stream_underrun_count = 0;
+    stream -> ux_device_class_audio_stream_overrun_count = 0;
+    for (i = 0; i < TEST_FRAME_BUFFER_NB; i ++)
+    {
+        frame = (UX_DEVICE_CLASS_AUDIO_FRAME *)((UCHAR *)buffer + i * TEST_FRAME_BUFFER_SIZE);
+        frame -> ux_device_class_audio_frame_length = 0;
+        frame -> ux_device_class_audio_frame_pos = 0;
+    }
+    stream -> ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)buffer;
+    stream -> ux_device_class_audio_stream_access_pos = stream -> ux_device_class_audio_stream_transfer_pos;
+}
+
+static VOID  streams_reset(VOID)
+{
+ULONG                           i;
+
+    for (i = 0; i < TEST_STREAMS_NB; i ++)
+    {
+        stream_reset(&out_stream[i], &out_endpoint[i], 0x01 + i, stream_buffer[i]);
+        stream_reset(&in_stream[i], &in_endpoint[i], 0x81 + i, stream_buffer[TEST_STREAMS_NB + i]);
+    }
+}
+
+/* Sample of a frame and a channel, Q31.  */
+static LONG  sample_value(ULONG frame, ULONG channel)
+{
+    return((LONG)(frame * 0x1F2E3D4Cu + channel * 0x6B5A4938u + 0x12345678u));
+}
+
+/* Sample in a stream of subframe size, Q31.  */
+static LONG  sample_truncate(LONG sample, ULONG subframe_size)
+{
+    return((LONG)((ULONG)sample & (0xFFFFFFFFu << (32 - subframe_size * 8))));
+}
+
+/* Sample scaled by a Q15 gain.  */
+static LONG  sample_scale(LONG sample, ULONG gain)
+{
+    return((LONG)(((long long)sample * gain) >> 15));
+}
+
+/* Saturated sum.  */
+static LONG  sample_add(LONG a, LONG b)
+{
+long long   sum = (long long)a + b;
+
+    if (sum > 0x7FFFFFFF)
+        return(0x7FFFFFFF);
+    if (sum < -0x7FFFFFFF - 1)
+        return(-0x7FFFFFFF - 1);
+    return((LONG)sum);
+}
+
+static VOID  stream_receive(ULONG index, ULONG frames, LONG value)
+{
+UX_DEVICE_CLASS_AUDIO_STREAM    *stream = &out_stream[index];
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+UCHAR                           *next;
+ULONG                           subframe_size = 2 + index;
+ULONG                           f, c, b;
+ULONG                           sample;
+
+    /* Build the packet, samples of given value if not 0.  */
+    for (f = 0; f < frames; f ++)
+    {
+        for (c = 0; c < TEST_CHANNELS; c ++)
+        {
+            sample = (ULONG)((value != 0) ? ((c == 0) ? value : -value) : sample_value(f, c));
+            for (b = 0; b < subframe_size; b ++)
+                packet[(f * TEST_CHANNELS + c) * subframe_size + b] = (UCHAR)(sample >> (32 - (subframe_size - b) * 8));
+        }
+    }
+
+    /* Log the packet as the read thread does.  */
+    frame = stream -> ux_device_class_audio_stream_transfer_pos;
+    _ux_utility_memory_copy(frame -> ux_device_class_audio_frame_data, packet, frames * TEST_CHANNELS * subframe_size);
+    frame -> ux_device_class_audio_frame_length = frames * TEST_CHANNELS * subframe_size;
+    frame -> ux_device_class_audio_frame_pos = 0;
+    next = (UCHAR *)frame + TEST_FRAME_BUFFER_SIZE;
+    if (next >= stream -> ux_device_class_audio_stream_buffer + stream -> ux_device_class_audio_stream_buffer_size)
+        next = stream -> ux_device_class_audio_stream_buffer;
+    if (((UX_DEVICE_CLASS_AUDIO_FRAME *)next) -> ux_device_class_audio_frame_length == 0)
+        stream -> ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next;
+}
+
+/* Host SET_CUR of feature unit master channel control.  */
+static UINT  control_set(UCHAR control_selector, SHORT value)
+{
+UX_SLAVE_TRANSFER               *transfer;
+
+    transfer = &device.ux_slave_device_control_endpoint.ux_slave_endpoint_transfer_request;
+    transfer -> ux_slave_transfer_request_setup[UX_DEVICE_CLASS_AUDIO_REQUEST_REQUEST_TYPE] = UX_REQUEST_OUT | UX_REQUEST_TYPE_CLASS | UX_REQUEST_TARGET_INTERFACE;
+    transfer -> ux_slave_transfer_request_setup[UX_DEVICE_CLASS_AUDIO_REQUEST_REQUEST] = UX_DEVICE_CLASS_AUDIO20_CUR;
+    transfer -> ux_slave_transfer_request_setup[UX_DEVICE_CLASS_AUDIO_REQUEST_CHANNEL_NUMBER] = 0;
+    transfer -> ux_slave_transfer_request_setup[UX_DEVICE_CLASS_AUDIO_REQUEST_CONTROL_SELECTOR] = control_selector;
+    transfer -> ux_slave_transfer_request_setup[4] = 0;
+    transfer -> ux_slave_transfer_request_setup[UX_DEVICE_CLASS_AUDIO_REQUEST_ENEITY_ID] = TEST_FU_ID;
+    _ux_utility_short_put(transfer -> ux_slave_transfer_request_setup + UX_SETUP_LENGTH,
+                          (control_selector == UX_DEVICE_CLASS_AUDIO20_FU_MUTE_CONTROL) ? 1 : 2);
+    _ux_utility_short_put(control_data, (USHORT)value);
+    transfer -> ux_slave_transfer_request_data_pointer = control_data;
+    return(ux_device_class_audio20_control_process(&audio, transfer, &control_group));
+}
+
+static ULONG  gain_of(SHORT volume)
+{
+UX_DEVICE_CLASS_AUDIO_MIXER_PORT    port;
+
+    port.ux_device_class_audio_mixer_port_mute = UX_NULL;
+    port.ux_device_class_audio_mixer_port_volume = &volume;
+    return(_ux_device_class_audio_mixer_gain_get(&port));
+}
+#endif
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio_device_mixer_test_application_define(void *first_unused_memory)
+#endif
+{
+#if defined(UX_DEVICE_CLASS_AUDIO_MIXER_SUPPORT)
+
+ULONG                           frame, channel, i;
+LONG                            expected;
+ULONG                           gain;
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame_ptr;
+UCHAR                           *data;
+#endif
+
+
+    /* Inform user.  */
+    printf("Running Audio Device Mixer Test..................................... ");
+#if !defined(UX_DEVICE_CLASS_AUDIO_MIXER_SUPPORT)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(usbx_memory, UX_TEST_MEMORY_SIZE, UX_NULL, 0));
+    _ux_system_slave -> ux_system_slave_device.ux_slave_device_state = UX_DEVICE_CONFIGURED;
+
+    /* Gains of volumes in 1/256 dB.  */
+    UX_TEST_ASSERT(gain_of(0) == UX_DEVICE_CLASS_AUDIO_MIXER_GAIN_UNITY);
+    UX_TEST_ASSERT(gain_of(3 * 256) == UX_DEVICE_CLASS_AUDIO_MIXER_GAIN_UNITY);
+    UX_TEST_ASSERT(gain_of(-6 * 256) == 16423);
+    UX_TEST_ASSERT(gain_of(-6 * 256 - 128) == 15530);
+    UX_TEST_ASSERT(gain_of(-20 * 256) == 3277);
+    UX_TEST_ASSERT(gain_of(-45 * 256) == 184);
+    UX_TEST_ASSERT(gain_of(-127 * 256) == 0);
+    UX_TEST_ASSERT(gain_of(UX_DEVICE_CLASS_AUDIO_MIXER_VOLUME_SILENCE) == 0);
+
+    /* Stream 1 gain is from feature unit controls, set by host.  */
+    audio.ux_device_class_audio_device = &device;
+    control.ux_device_class_audio20_control_fu_id = TEST_FU_ID;
+    control.ux_device_class_audio20_control_volume_min[0] = -127 * 256;
+    control.ux_device_class_audio20_control_volume_max[0] = 0;
+    control.ux_device_class_audio20_control_volume_res[0] = 256;
+    UX_TEST_CHECK_SUCCESS(control_set(UX_DEVICE_CLASS_AUDIO20_FU_VOLUME_CONTROL, -6 * 256));
+    UX_TEST_ASSERT(control.ux_device_class_audio20_control_changed == UX_DEVICE_CLASS_AUDIO20_CONTROL_VOLUME_CHANGED);
+    gain = 16423;
+
+    /* Mixer of 16-bit and 24-bit stereo streams, 8 frames a block.  */
+    streams_reset();
+    for (i = 0; i < TEST_STREAMS_NB; i ++)
+    {
+        inputs[i].ux_device_class_audio_mixer_port_stream = &out_stream[i];
+        inputs[i].ux_device_class_audio_mixer_port_subframe_size = 2 + i;
+        outputs[i].ux_device_class_audio_mixer_port_stream = &in_stream[i];
+        outputs[i].ux_device_class_audio_mixer_port_subframe_size = 2 + i;
+    }
+    inputs[1].ux_device_class_audio_mixer_port_mute = control.ux_device_class_audio20_control_mute;
+    inputs[1].ux_device_class_audio_mixer_port_volume = control.ux_device_class_audio20_control_volume;
+    outputs[1].ux_device_class_audio_mixer_port_mute = control.ux_device_class_audio20_control_mute;
+    outputs[1].ux_device_class_audio_mixer_port_volume = control.ux_device_class_audio20_control_volume;
+    mixer.ux_device_class_audio_mixer_channels = TEST_CHANNELS;
+    mixer.ux_device_class_audio_mixer_frames = TEST_FRAMES;
+    mixer.ux_device_class_audio_mixer_work = mixer_work;
+    mixer.ux_device_class_audio_mixer_inputs_nb = TEST_STREAMS_NB;
+    mixer.ux_device_class_audio_mixer_inputs = inputs;
+    mixer.ux_device_class_audio_mixer_outputs_nb = TEST_STREAMS_NB;
+    mixer.ux_device_class_audio_mixer_outputs = outputs;
+
+    /* Mix a block, frame buffers are freed.  */
+    stream_receive(0, TEST_FRAMES, 0);
+    stream_receive(1, TEST_FRAMES, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_mix(&mixer, mixed));
+    for (frame = 0; frame < TEST_FRAMES; frame ++)
+    {
+        for (channel = 0; channel < TEST_CHANNELS; channel ++)
+        {
+            expected = sample_add(sample_truncate(sample_value(frame, channel), 2),
+                                  sample_scale(sample_truncate(sample_value(frame, channel), 3), gain));
+            UX_TEST_ASSERT(mixed[frame * TEST_CHANNELS + channel] == expected);
+        }
+    }
+    for (i = 0; i < TEST_STREAMS_NB; i ++)
+        UX_TEST_ASSERT(out_stream[i].ux_device_class_audio_stream_access_pos -> ux_device_class_audio_frame_length == 0);
+
+    /* Stream 1 underrun, missing frames are silence.  */
+    stream_receive(0, TEST_FRAMES, 0);
+    stream_receive(1, TEST_FRAMES / 2, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_mix(&mixer, mixed));
+    for (frame = 0; frame < TEST_FRAMES; frame ++)
+    {
+        for (channel = 0; channel < TEST_CHANNELS; channel ++)
+        {
+            expected = sample_truncate(sample_value(frame, channel), 2);
+            if (frame < TEST_FRAMES / 2)
+                expected = sample_add(expected, sample_scale(sample_truncate(sample_value(frame, channel), 3), gain));
+            UX_TEST_ASSERT(mixed[frame * TEST_CHANNELS + channel] == expected);
+        }
+    }
+    UX_TEST_ASSERT(out_stream[0].ux_device_class_audio_stream_underrun_count == 0);
+    UX_TEST_ASSERT(out_stream[1].ux_device_class_audio_stream_underrun_count == 1);
+
+    /* Stream 1 muted by host, its frames are still consumed.  */
+    UX_TEST_CHECK_SUCCESS(control_set(UX_DEVICE_CLASS_AUDIO20_FU_MUTE_CONTROL, 1));
+    stream_receive(0, TEST_FRAMES, 0);
+    stream_receive(1, TEST_FRAMES, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_mix(&mixer, mixed));
+    for (i = 0; i < TEST_FRAMES * TEST_CHANNELS; i ++)
+        UX_TEST_ASSERT(mixed[i] == sample_truncate(sample_value(i / TEST_CHANNELS, i % TEST_CHANNELS), 2));
+    UX_TEST_ASSERT(out_stream[1].ux_device_class_audio_stream_access_pos -> ux_device_class_audio_frame_length == 0);
+    UX_TEST_ASSERT(out_stream[1].ux_device_class_audio_stream_underrun_count == 1);
+
+    /* Full scale streams at 0 dB saturate.  */
+    UX_TEST_CHECK_SUCCESS(control_set(UX_DEVICE_CLASS_AUDIO20_FU_MUTE_CONTROL, 0));
+    UX_TEST_CHECK_SUCCESS(control_set(UX_DEVICE_CLASS_AUDIO20_FU_VOLUME_CONTROL, 0));
+    stream_receive(0, TEST_FRAMES, 0x7FFFFFFF);
+    stream_receive(1, TEST_FRAMES, 0x7FFFFFFF);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_mix(&mixer, mixed));
+    for (frame = 0; frame < TEST_FRAMES; frame ++)
+    {
+        UX_TEST_ASSERT(mixed[frame * TEST_CHANNELS] == 0x7FFFFFFF);
+        UX_TEST_ASSERT(mixed[frame * TEST_CHANNELS + 1] == -0x7FFFFFFF - 1);
+    }
+
+    /* Stream not started is ignored.  */
+    out_stream[1].ux_device_class_audio_stream_endpoint = UX_NULL;
+    stream_receive(0, TEST_FRAMES, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_mix(&mixer, mixed));
+    for (i = 0; i < TEST_FRAMES * TEST_CHANNELS; i ++)
+        UX_TEST_ASSERT(mixed[i] == sample_truncate(sample_value(i / TEST_CHANNELS, i % TEST_CHANNELS), 2));
+    UX_TEST_ASSERT(out_stream[1].ux_device_class_audio_stream_underrun_count == 1);
+
+    /* Route a capture block to IN streams, stream 1 at -20 dB.  */
+    UX_TEST_CHECK_SUCCESS(control_set(UX_DEVICE_CLASS_AUDIO20_FU_VOLUME_CONTROL, -20 * 256));
+    gain = 3277;
+    for (i = 0; i < TEST_FRAMES * TEST_CHANNELS; i ++)
+        capture[i] = sample_value(i / TEST_CHANNELS, i % TEST_CHANNELS);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_route(&mixer, capture));
+    for (i = 0; i < TEST_STREAMS_NB; i ++)
+    {
+        frame_ptr = (UX_DEVICE_CLASS_AUDIO_FRAME *)in_stream[i].ux_device_class_audio_stream_buffer;
+        UX_TEST_ASSERT(frame_ptr -> ux_device_class_audio_frame_length == TEST_FRAMES * TEST_CHANNELS * (2 + i));
+        UX_TEST_ASSERT(in_stream[i].ux_device_class_audio_stream_access_pos ==
+                       (UX_DEVICE_CLASS_AUDIO_FRAME *)(in_stream[i].ux_device_class_audio_stream_buffer + TEST_FRAME_BUFFER_SIZE));
+        data = frame_ptr -> ux_device_class_audio_frame_data;
+        for (frame = 0; frame < TEST_FRAMES; frame ++)
+        {
+            for (channel = 0; channel < TEST_CHANNELS; channel ++)
+            {
+                expected = sample_value(frame, channel);
+                if (i == 1)
+                    expected = sample_scale(expected, gain);
+                if (i == 0)
+                {
+                    UX_TEST_ASSERT(_ux_utility_short_get(data) == (USHORT)(expected >> 16));
+                }
+                else
+                {
+                    UX_TEST_ASSERT(((ULONG)data[0] | ((ULONG)data[1] << 8) | ((ULONG)data[2] << 16)) ==
+                                   (((ULONG)expected >> 8) & 0xFFFFFFu));
+                }
+                data += 2 + i;
+            }
+        }
+    }
+
+    /* Muted IN stream sends silence.  */
+    UX_TEST_CHECK_SUCCESS(control_set(UX_DEVICE_CLASS_AUDIO20_FU_MUTE_CONTROL, 1));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_mixer_route(&mixer, capture));
+    frame_ptr = in_stream[1].ux_device_class_audio_stream_access_pos;
+    frame_ptr = (UX_DEVICE_CLASS_AUDIO_FRAME *)((UCHAR *)frame_ptr - TEST_FRAME_BUFFER_SIZE);
+    UX_TEST_ASSERT(frame_ptr -> ux_device_class_audio_frame_length == TEST_FRAMES * TEST_CHANNELS * 3);
+    for (i = 0; i < TEST_FRAMES * TEST_CHANNELS * 3; i ++)
+        UX_TEST_ASSERT(frame_ptr -> ux_device_class_audio_frame_data[i] == 0);
+
+    /* Device not configured.  */
+    _ux_system_slave -> ux_system_slave_device.ux_slave_device_state = UX_DEVICE_ADDRESSED;
+    UX_TEST_ASSERT(ux_device_class_audio_mixer_mix(&mixer, mixed) == UX_CONFIGURATION_HANDLE_UNKNOWN);
+    UX_TEST_ASSERT(ux_device_class_audio_mixer_route(&mixer, capture) == UX_CONFIGURATION_HANDLE_UNKNOWN);
+
+    printf("SUCCESS!\n");
+    test_control_return(0);
+#endif
+}
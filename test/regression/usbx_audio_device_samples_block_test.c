@@ -0,0 +1,296 @@
+/* This tests the device audio block samples access: frames are read across
+   received frame buffers and written in packets to frame buffers to send,
+   from and to interleaved or planar application buffers, with the samples
+   converted between the stream and the application formats. Short reads
+   and writes are counted as underruns and overruns.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_device_stack.h"
+#include "ux_device_class_audio.h"
+
+#include "ux_test.h"
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_MEMORY_SIZE                 (64*1024)
+
+#define TEST_FRAME_DATA_SIZE                48
+#define TEST_FRAME_BUFFER_SIZE              (TEST_FRAME_DATA_SIZE + 8)
+#define TEST_FRAME_BUFFER_NB                4
+
+static ULONG                                usbx_memory[UX_TEST_MEMORY_SIZE / sizeof(ULONG)];
+static ULONG                                stream_buffer[TEST_FRAME_BUFFER_SIZE * TEST_FRAME_BUFFER_NB / sizeof(ULONG)];
+
+static UX_DEVICE_CLASS_AUDIO_STREAM         stream;
+static UX_SLAVE_ENDPOINT                    endpoint;
+static UX_DEVICE_CLASS_AUDIO_SAMPLES        samples;
+
+static UCHAR                                packet[TEST_FRAME_DATA_SIZE];
+static LONG                                 samples_q31[64];
+static SHORT                                samples_pcm16[64];
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+static float                                samples_float[64];
+#endif
+
+static VOID  stream_reset(UCHAR endpoint_address)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+ULONG                           i;
+
+    /* The stream has its data endpoint and empty frame buffers.  */
+    endpoint.ux_slave_endpoint_descriptor.bEndpointAddress = endpoint_address;
+    stream.ux_device_class_audio_stream_endpoint = &endpoint;
+    stream.ux_device_class_audio_stream_buffer = (UCHAR *)stream_buffer;
+    stream.ux_device_class_audio_stream_buffer_size = sizeof(stream_buffer);
+    stream.ux_device_class_audio_stream_frame_buffer_size = TEST_FRAME_BUFFER_SIZE;
+    stream.ux_device_class_audio_stream_underrun_count = 0;
+    stream.ux_device_class_audio_stream_overrun_count = 0;
+    for (i = 0; i < TEST_FRAME_BUFFER_NB; i ++)
+    {
+        frame = (UX_DEVICE_CLASS_AUDIO_FRAME *)((UCHAR *)stream_buffer + i * TEST_FRAME_BUFFER_SIZE);
+        frame -> ux_device_class_audio_frame_length = 0;
+        frame -> ux_device_class_audio_frame_pos = 0;
+    }
+    stream.ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)stream_buffer;
+    stream.ux_device_class_audio_stream_access_pos = stream.ux_device_class_audio_stream_transfer_pos;
+}
+
+static UX_DEVICE_CLASS_AUDIO_FRAME *stream_frame(ULONG index)
+{
+    return((UX_DEVICE_CLASS_AUDIO_FRAME *)((UCHAR *)stream_buffer + index * TEST_FRAME_BUFFER_SIZE));
+}
+
+static VOID  stream_receive(UCHAR *data, ULONG length)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+UCHAR                           *next;
+
+    /* Log the packet as the read thread does.  */
+    frame = stream.ux_device_class_audio_stream_transfer_pos;
+    _ux_utility_memory_copy(frame -> ux_device_class_audio_frame_data, data, length);
+    frame -> ux_device_class_audio_frame_length = length;
+    frame -> ux_device_class_audio_frame_pos = 0;
+    next = (UCHAR *)frame + TEST_FRAME_BUFFER_SIZE;
+    if (next >= (UCHAR *)stream_buffer + sizeof(stream_buffer))
+        next = (UCHAR *)stream_buffer;
+    if (((UX_DEVICE_CLASS_AUDIO_FRAME *)next) -> ux_device_class_audio_frame_length == 0)
+        stream.ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next;
+}
+
+static VOID  samples_set(VOID *buffer, ULONG format, ULONG channels, ULONG subframe_size, ULONG planar_stride, ULONG packet_frames)
+{
+    samples.ux_device_class_audio_samples_buffer = buffer;
+    samples.ux_device_class_audio_samples_format = format;
+    samples.ux_device_class_audio_samples_channels = channels;
+    samples.ux_device_class_audio_samples_subframe_size = subframe_size;
+    samples.ux_device_class_audio_samples_planar_stride = planar_stride;
+    samples.ux_device_class_audio_samples_packet_frames = packet_frames;
+}
+
+/* Sample of a frame and a channel, signed 24 bits.  */
+static LONG  sample_value(ULONG frame, ULONG channel)
+{
+    return((LONG)((frame * 0x10203u + channel * 0x40507u) & 0xFFFFFFu) - 0x800000);
+}
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio_device_samples_block_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                            status;
+ULONG                           actual_frames;
+ULONG                           frame, channel, i;
+LONG                            value;
+UX_DEVICE_CLASS_AUDIO_FRAME     *stream_frame_ptr;
+
+
+    /* Inform user.  */
+    printf("Running Audio Device Samples Block Test............................. ");
+
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(usbx_memory, UX_TEST_MEMORY_SIZE, UX_NULL, 0));
+    _ux_system_slave -> ux_system_slave_device.ux_slave_device_state = UX_DEVICE_CONFIGURED;
+
+    /* 16-bit stereo read to interleaved Q31, across frame buffers.  */
+    stream_reset(0x01);
+    for (i = 0; i < 2; i ++)
+    {
+        for (frame = 0; frame < 6; frame ++)
+        {
+            for (channel = 0; channel < 2; channel ++)
+            {
+                value = sample_value(i * 6 + frame, channel) >> 8;
+                packet[frame * 4 + channel * 2] = (UCHAR)value;
+                packet[frame * 4 + channel * 2 + 1] = (UCHAR)(value >> 8);
+            }
+        }
+        stream_receive(packet, 24);
+    }
+    samples_set(samples_q31, UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31, 2, 2, 0, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_samples_read(&stream, &samples, 8, &actual_frames));
+    UX_TEST_ASSERT(actual_frames == 8);
+    for (frame = 0; frame < 8; frame ++)
+        for (channel = 0; channel < 2; channel ++)
+            UX_TEST_ASSERT(samples_q31[frame * 2 + channel] == (LONG)((ULONG)(sample_value(frame, channel) >> 8) << 16));
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_access_pos == stream_frame(1));
+    UX_TEST_ASSERT(stream_frame(0) -> ux_device_class_audio_frame_length == 0);
+    UX_TEST_ASSERT(stream_frame(1) -> ux_device_class_audio_frame_pos == 8);
+
+    /* Only 4 frames are left: underrun.  */
+    status = ux_device_class_audio_samples_read(&stream, &samples, 8, &actual_frames);
+    UX_TEST_ASSERT(status == UX_BUFFER_OVERFLOW);
+    UX_TEST_ASSERT(actual_frames == 4);
+    for (frame = 0; frame < 4; frame ++)
+        for (channel = 0; channel < 2; channel ++)
+            UX_TEST_ASSERT(samples_q31[frame * 2 + channel] == (LONG)((ULONG)(sample_value(8 + frame, channel) >> 8) << 16));
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_underrun_count == 1);
+    UX_TEST_ASSERT(stream_frame(1) -> ux_device_class_audio_frame_length == 0);
+
+    /* 24-bit 3 channels read to planar PCM16.  */
+    stream_reset(0x01);
+    for (frame = 0; frame < 4; frame ++)
+    {
+        for (channel = 0; channel < 3; channel ++)
+        {
+            value = sample_value(frame, channel);
+            packet[frame * 9 + channel * 3] = (UCHAR)value;
+            packet[frame * 9 + channel * 3 + 1] = (UCHAR)(value >> 8);
+            packet[frame * 9 + channel * 3 + 2] = (UCHAR)(value >> 16);
+        }
+    }
+    stream_receive(packet, 36);
+    samples_set(samples_pcm16, UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM16, 3, 3, 8, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_samples_read(&stream, &samples, 4, &actual_frames));
+    UX_TEST_ASSERT(actual_frames == 4);
+    for (frame = 0; frame < 4; frame ++)
+        for (channel = 0; channel < 3; channel ++)
+            UX_TEST_ASSERT(samples_pcm16[channel * 8 + frame] == (SHORT)(sample_value(frame, channel) >> 8));
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_underrun_count == 0);
+
+    /* A partial frame at the end of a buffer is dropped with the buffer.  */
+    stream_reset(0x01);
+    stream_receive(packet, 10);
+    samples_set(packet + 16, UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM, 2, 3, 0, 0);
+    status = ux_device_class_audio_samples_read(&stream, &samples, 2, &actual_frames);
+    UX_TEST_ASSERT(status == UX_BUFFER_OVERFLOW);
+    UX_TEST_ASSERT(actual_frames == 1);
+    UX_TEST_ASSERT(ux_utility_memory_compare(packet + 16, packet, 6) == UX_SUCCESS);
+    UX_TEST_ASSERT(stream_frame(0) -> ux_device_class_audio_frame_length == 0);
+
+    /* Interleaved Q31 written to 24-bit stereo, in packets of 4 frames.  */
+    stream_reset(0x81);
+    for (frame = 0; frame < 14; frame ++)
+        for (channel = 0; channel < 2; channel ++)
+            samples_q31[frame * 2 + channel] = (LONG)((ULONG)sample_value(frame, channel) << 8) | 0x5A;
+    samples_set(samples_q31, UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31, 2, 3, 0, 4);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_samples_write(&stream, &samples, 10, &actual_frames));
+    UX_TEST_ASSERT(actual_frames == 10);
+    UX_TEST_ASSERT(stream_frame(0) -> ux_device_class_audio_frame_length == 24);
+    UX_TEST_ASSERT(stream_frame(1) -> ux_device_class_audio_frame_length == 24);
+    UX_TEST_ASSERT(stream_frame(2) -> ux_device_class_audio_frame_length == 12);
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_access_pos == stream_frame(3));
+    for (frame = 0; frame < 10; frame ++)
+    {
+        stream_frame_ptr = stream_frame(frame / 4);
+        for (channel = 0; channel < 2; channel ++)
+        {
+            i = (frame % 4) * 6 + channel * 3;
+            value = sample_value(frame, channel);
+            UX_TEST_ASSERT(stream_frame_ptr -> ux_device_class_audio_frame_data[i] == (UCHAR)value);
+            UX_TEST_ASSERT(stream_frame_ptr -> ux_device_class_audio_frame_data[i + 1] == (UCHAR)(value >> 8));
+            UX_TEST_ASSERT(stream_frame_ptr -> ux_device_class_audio_frame_data[i + 2] == (UCHAR)(value >> 16));
+        }
+    }
+
+    /* Only one frame buffer is left: overrun.  */
+    samples.ux_device_class_audio_samples_buffer = samples_q31 + 20;
+    status = ux_device_class_audio_samples_write(&stream, &samples, 10, &actual_frames);
+    UX_TEST_ASSERT(status == UX_BUFFER_OVERFLOW);
+    UX_TEST_ASSERT(actual_frames == 4);
+    UX_TEST_ASSERT(stream_frame(3) -> ux_device_class_audio_frame_length == 24);
+    UX_TEST_ASSERT(stream_frame(3) -> ux_device_class_audio_frame_data[0] == (UCHAR)sample_value(10, 0));
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_overrun_count == 1);
+
+    /* Planar PCM16 written to 16-bit stereo, packets as large as frame buffers.  */
+    stream_reset(0x81);
+    for (frame = 0; frame < 16; frame ++)
+        for (channel = 0; channel < 2; channel ++)
+            samples_pcm16[channel * 16 + frame] = (SHORT)(sample_value(frame, channel) >> 8);
+    samples_set(samples_pcm16, UX_DEVICE_CLASS_AUDIO_SAMPLES_PCM16, 2, 2, 16, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_samples_write(&stream, &samples, 16, &actual_frames));
+    UX_TEST_ASSERT(actual_frames == 16);
+    UX_TEST_ASSERT(stream_frame(0) -> ux_device_class_audio_frame_length == TEST_FRAME_DATA_SIZE);
+    UX_TEST_ASSERT(stream_frame(1) -> ux_device_class_audio_frame_length == 16);
+    for (frame = 0; frame < 16; frame ++)
+    {
+        stream_frame_ptr = stream_frame(frame / 12);
+        for (channel = 0; channel < 2; channel ++)
+        {
+            i = (frame % 12) * 4 + channel * 2;
+            value = sample_value(frame, channel) >> 8;
+            UX_TEST_ASSERT(stream_frame_ptr -> ux_device_class_audio_frame_data[i] == (UCHAR)value);
+            UX_TEST_ASSERT(stream_frame_ptr -> ux_device_class_audio_frame_data[i + 1] == (UCHAR)(value >> 8));
+        }
+    }
+
+#if defined(UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT_SUPPORT)
+
+    /* Float written to 16-bit mono is clipped, then read back.  */
+    stream_reset(0x81);
+    for (frame = 0; frame < 8; frame ++)
+        samples_float[frame] = (float)frame / 4.0f - 1.0f;
+    samples_float[0] = -2.0f;
+    samples_float[7] = 1.5f;
+    samples_set(samples_float, UX_DEVICE_CLASS_AUDIO_SAMPLES_FLOAT, 1, 2, 0, 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_samples_write(&stream, &samples, 8, &actual_frames));
+    UX_TEST_ASSERT(actual_frames == 8);
+    _ux_utility_memory_copy(packet, stream_frame(0) -> ux_device_class_audio_frame_data, 16);
+    UX_TEST_ASSERT(packet[0] == 0x00 && packet[1] == 0x80);
+    UX_TEST_ASSERT(packet[8] == 0x00 && packet[9] == 0x00);
+    UX_TEST_ASSERT(packet[14] == 0xFF && packet[15] == 0x7F);
+
+    stream_reset(0x01);
+    stream_receive(packet, 16);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_audio_samples_read(&stream, &samples, 8, &actual_frames));
+    UX_TEST_ASSERT(actual_frames == 8);
+    UX_TEST_ASSERT(samples_float[0] == -1.0f);
+    for (frame = 1; frame < 7; frame ++)
+        UX_TEST_ASSERT(samples_float[frame] == (float)frame / 4.0f - 1.0f);
+    UX_TEST_ASSERT(samples_float[7] > 0.9999f && samples_float[7] < 1.0f);
+#endif
+
+    /* Parameters and states errors.  */
+    stream_reset(0x81);
+    samples_set(samples_q31, UX_DEVICE_CLASS_AUDIO_SAMPLES_FORMAT_MAX + 1, 2, 2, 0, 0);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_write(&stream, &samples, 1, &actual_frames) == UX_INVALID_PARAMETER);
+    stream_reset(0x01);
+    samples_set(samples_q31, UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31, 0, 2, 0, 0);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_read(&stream, &samples, 1, &actual_frames) == UX_INVALID_PARAMETER);
+    samples_set(samples_q31, UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31, 2, 5, 0, 0);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_read(&stream, &samples, 1, &actual_frames) == UX_INVALID_PARAMETER);
+    samples_set(samples_q31, UX_DEVICE_CLASS_AUDIO_SAMPLES_Q31, 16, 4, 0, 0);
+    stream_reset(0x81);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_write(&stream, &samples, 1, &actual_frames) == UX_ERROR);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_read(&stream, &samples, 1, &actual_frames) == UX_ERROR);
+    stream_reset(0x01);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_write(&stream, &samples, 1, &actual_frames) == UX_ERROR);
+    _ux_system_slave -> ux_system_slave_device.ux_slave_device_state = UX_DEVICE_ATTACHED;
+    UX_TEST_ASSERT(ux_device_class_audio_samples_read(&stream, &samples, 1, &actual_frames) == UX_CONFIGURATION_HANDLE_UNKNOWN);
+    UX_TEST_ASSERT(ux_device_class_audio_samples_write(&stream, &samples, 1, &actual_frames) == UX_CONFIGURATION_HANDLE_UNKNOWN);
+    UX_TEST_ASSERT(_uxe_device_class_audio_samples_read(UX_NULL, &samples, 1, &actual_frames) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(_uxe_device_class_audio_samples_read(&stream, &samples, 1, UX_NULL) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(_uxe_device_class_audio_samples_write(&stream, UX_NULL, 1, &actual_frames) == UX_INVALID_PARAMETER);
+    samples.ux_device_class_audio_samples_buffer = UX_NULL;
+    UX_TEST_ASSERT(_uxe_device_class_audio_samples_write(&stream, &samples, 1, &actual_frames) == UX_INVALID_PARAMETER);
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
@@ -0,0 +1,400 @@
+/* This tests the host audio ring streaming: class owned isochronous transfers
+   are queued on start and re-armed from completion, IN packets are read from
+   ring with their frame numbers, OUT packets are built from ring at nominal
+   or feedback rate, and overruns/underruns are counted as xruns. The free
+   running ring indexes are also checked across their wrap.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_host_stack.h"
+#include "ux_host_class_audio.h"
+
+#include "ux_test.h"
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_STACK_SIZE                  4096
+#define UX_TEST_MEMORY_SIZE                 (64*1024)
+
+#define TEST_FRAME_BYTES                    4           /* 16-bit stereo.  */
+#define TEST_PACKET_SIZE                    (48 * TEST_FRAME_BYTES)
+#define TEST_MAX_PACKET_SIZE                (TEST_PACKET_SIZE + 2 * TEST_FRAME_BYTES)
+#define TEST_SLOTS_NB                       4
+
+#if defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+
+static UCHAR                                usbx_memory[UX_TEST_MEMORY_SIZE];
+static TX_THREAD                            test_thread;
+static UCHAR                                test_thread_stack[UX_TEST_STACK_SIZE];
+
+static UX_DEVICE                            device;
+static UX_ENDPOINT                          endpoint;
+static UX_HOST_CLASS_AUDIO                  audio;
+
+/* Transfers queued on the controller, in order.  */
+static UX_TRANSFER                          *queued[UX_HOST_CLASS_AUDIO_RING_TRANSFERS + 1];
+static ULONG                                queued_count;
+static ULONG                                frame_number;
+
+static UCHAR                                buffer[TEST_MAX_PACKET_SIZE * (TEST_SLOTS_NB + 1)];
+
+static UINT  test_hcd_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+UX_TRANSFER     *transfer_request;
+ULONG           i;
+
+    switch(function)
+    {
+    case UX_HCD_TRANSFER_REQUEST:
+        if (queued_count > UX_HOST_CLASS_AUDIO_RING_TRANSFERS)
+            return(UX_ERROR);
+        queued[queued_count ++] = (UX_TRANSFER *)parameter;
+        return(UX_SUCCESS);
+
+    case UX_HCD_TRANSFER_ABORT:
+        transfer_request = (UX_TRANSFER *)parameter;
+        for (i = 0; i < queued_count; i ++)
+        {
+            if (queued[i] == transfer_request)
+            {
+                queued_count --;
+                for (; i < queued_count; i ++)
+                    queued[i] = queued[i + 1];
+                break;
+            }
+        }
+        return(UX_SUCCESS);
+
+    case UX_HCD_GET_FRAME_NUMBER:
+        *(ULONG *)parameter = frame_number;
+        return(UX_SUCCESS);
+
+    default:
+        return(UX_FUNCTION_NOT_SUPPORTED);
+    }
+}
+
+/* Complete the oldest queued transfer, as the controller does each frame.  */
+static UX_TRANSFER  *transfer_complete(UCHAR *data, ULONG length, UINT code)
+{
+UX_TRANSFER     *transfer_request;
+ULONG           i;
+
+    UX_TEST_ASSERT(queued_count > 0);
+    transfer_request = queued[0];
+    queued_count --;
+    for (i = 0; i < queued_count; i ++)
+        queued[i] = queued[i + 1];
+
+    if (data != UX_NULL)
+        _ux_utility_memory_copy(transfer_request -> ux_transfer_request_data_pointer, data, length);
+    transfer_request -> ux_transfer_request_actual_length = length;
+    transfer_request -> ux_transfer_request_completion_code = code;
+    frame_number ++;
+    transfer_request -> ux_transfer_request_completion_function(transfer_request);
+    return(transfer_request);
+}
+
+static VOID  stream_setup(UCHAR address)
+{
+
+    /* Streaming started at 48K 16-bit stereo, 1 packet per frame.  */
+    endpoint.ux_endpoint_descriptor.bEndpointAddress = address;
+    endpoint.ux_endpoint_descriptor.bmAttributes = UX_ISOCHRONOUS_ENDPOINT;
+    endpoint.ux_endpoint_device = &device;
+    endpoint.ux_endpoint_transfer_request.ux_transfer_request_endpoint = &endpoint;
+    endpoint.ux_endpoint_transfer_request.ux_transfer_request_type = (address & UX_ENDPOINT_DIRECTION) ?
+                                                                    UX_REQUEST_IN : UX_REQUEST_OUT;
+    endpoint.ux_endpoint_transfer_request.ux_transfer_request_packet_length = TEST_MAX_PACKET_SIZE;
+    audio.ux_host_class_audio_isochronous_endpoint = &endpoint;
+    audio.ux_host_class_audio_packet_size = TEST_PACKET_SIZE;
+    audio.ux_host_class_audio_packet_freq = 1000;
+    audio.ux_host_class_audio_packet_fraction = 0;
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+    audio.ux_host_class_audio_feedback_endpoint = UX_NULL;
+    _ux_utility_memory_set(audio.ux_host_class_audio_feedback_buffer, 0, 4);
+#endif
+}
+
+static VOID  pattern_fill(UCHAR *data, ULONG length, UCHAR seed)
+{
+ULONG           i;
+
+    for (i = 0; i < length; i ++)
+        data[i] = (UCHAR)(seed + i);
+}
+
+static VOID  test_thread_entry(ULONG arg)
+{
+
+UX_HOST_CLASS               *audio_class;
+UX_HOST_CLASS_AUDIO_RING    *ring;
+UX_TRANSFER                 *transfer_request;
+UCHAR                       packet[TEST_MAX_PACKET_SIZE];
+ULONG                       actual_length;
+ULONG                       frame;
+ULONG                       total;
+ULONG                       i;
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+ULONG                       frames;
+#endif
+
+
+    /* Audio streaming instance on a fake controller.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_initialize(UX_NULL));
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_class_register(_ux_system_host_class_audio_name, ux_host_class_audio_entry));
+    UX_TEST_CHECK_SUCCESS(_ux_host_stack_class_get(_ux_system_host_class_audio_name, &audio_class));
+    _ux_system_host -> ux_system_host_hcd_array[0].ux_hcd_entry_function = test_hcd_entry;
+    UX_DEVICE_HCD_SET(&device, &_ux_system_host -> ux_system_host_hcd_array[0]);
+    device.ux_device_state = UX_DEVICE_CONFIGURED;
+    device.ux_device_speed = UX_FULL_SPEED_DEVICE;
+    audio.ux_host_class_audio_class = audio_class;
+    audio.ux_host_class_audio_device = &device;
+    audio.ux_host_class_audio_state = UX_HOST_CLASS_INSTANCE_LIVE;
+    UX_TEST_CHECK_SUCCESS(_ux_host_mutex_create(&audio.ux_host_class_audio_mutex, "ux_host_class_audio_mutex"));
+    UX_TEST_CHECK_SUCCESS(_ux_host_stack_class_instance_create(audio_class, (VOID *)&audio));
+    ring = &audio.ux_host_class_audio_ring;
+
+    /* Not streaming, bad parameters.  */
+    audio.ux_host_class_audio_isochronous_endpoint = UX_NULL;
+    UX_TEST_CHECK_CODE(UX_ENDPOINT_HANDLE_UNKNOWN, ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    stream_setup(0x81);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_audio_ring_start(&audio, 0, TEST_SLOTS_NB));
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, 1));
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, 3));
+    UX_TEST_CHECK_CODE(UX_INVALID_STATE, ux_host_class_audio_ring_read(&audio, buffer, sizeof(buffer), &actual_length, UX_NULL));
+
+    /* IN: all transfers queued at start.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    UX_TEST_ASSERT(queued_count == UX_HOST_CLASS_AUDIO_RING_TRANSFERS);
+    UX_TEST_CHECK_CODE(UX_ALREADY_ACTIVATED, ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_audio_ring_write(&audio, buffer, TEST_PACKET_SIZE, &actual_length));
+    UX_TEST_CHECK_CODE(UX_BUFFER_OVERFLOW, ux_host_class_audio_ring_read(&audio, buffer, sizeof(buffer), &actual_length, UX_NULL));
+    UX_TEST_ASSERT(actual_length == 0);
+
+    /* IN: packets are saved with frame numbers and transfers re-armed.  */
+    frame_number = 100;
+    pattern_fill(packet, TEST_PACKET_SIZE, 0);
+    transfer_request = transfer_complete(packet, TEST_PACKET_SIZE, UX_SUCCESS);
+    UX_TEST_ASSERT(queued_count == UX_HOST_CLASS_AUDIO_RING_TRANSFERS);
+    UX_TEST_ASSERT(queued[UX_HOST_CLASS_AUDIO_RING_TRANSFERS - 1] == transfer_request);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_requested_length == TEST_MAX_PACKET_SIZE);
+    pattern_fill(packet, TEST_PACKET_SIZE + TEST_FRAME_BYTES, TEST_PACKET_SIZE);
+    transfer_complete(packet, TEST_PACKET_SIZE + TEST_FRAME_BYTES, UX_SUCCESS);
+    transfer_complete(UX_NULL, 0, UX_SUCCESS);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 2);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_packets_get(&audio) == 3);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 0);
+
+    /* IN: read across packets, time stamp of first packet.  */
+    frame = 0;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_read(&audio, buffer, 100, &actual_length, &frame));
+    UX_TEST_ASSERT(actual_length == 100 && frame == 101);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_read(&audio, buffer + 100, sizeof(buffer) - 100, &actual_length, &frame));
+    UX_TEST_ASSERT(actual_length == TEST_PACKET_SIZE * 2 + TEST_FRAME_BYTES - 100 && frame == 101);
+    for (i = 0; i < TEST_PACKET_SIZE * 2 + TEST_FRAME_BYTES; i ++)
+        UX_TEST_ASSERT(buffer[i] == (UCHAR)i);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 0);
+
+    /* IN: overrun when ring is full, lost packets.  */
+    for (i = 0; i < TEST_SLOTS_NB + 2; i ++)
+        transfer_complete(packet, TEST_PACKET_SIZE, UX_SUCCESS);
+    transfer_complete(UX_NULL, 0, UX_TRANSFER_ERROR);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == TEST_SLOTS_NB);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 3);
+    UX_TEST_ASSERT(queued_count == UX_HOST_CLASS_AUDIO_RING_TRANSFERS);
+    total = 0;
+    while (ux_host_class_audio_ring_read(&audio, buffer, sizeof(buffer), &actual_length, UX_NULL) == UX_SUCCESS)
+        total += actual_length;
+    UX_TEST_ASSERT(total == TEST_SLOTS_NB * TEST_PACKET_SIZE);
+
+    /* Stop: transfers aborted, no more re-arm.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+    UX_TEST_ASSERT(queued_count == 0);
+    UX_TEST_ASSERT(ring -> ux_host_class_audio_ring_buffer == UX_NULL);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+
+    /* OUT: transfers primed with silence at nominal rate.  */
+    stream_setup(0x02);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    UX_TEST_ASSERT(ux_host_class_audio_ring_rate_get(&audio) == (48ul << 16));
+    UX_TEST_ASSERT(queued_count == UX_HOST_CLASS_AUDIO_RING_TRANSFERS);
+    for (i = 0; i < UX_HOST_CLASS_AUDIO_RING_TRANSFERS; i ++)
+    {
+        UX_TEST_ASSERT(queued[i] -> ux_transfer_request_requested_length == TEST_PACKET_SIZE);
+        UX_TEST_ASSERT(queued[i] -> ux_transfer_request_data_pointer[0] == 0);
+    }
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_audio_ring_read(&audio, buffer, sizeof(buffer), &actual_length, UX_NULL));
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 0);
+
+    /* OUT: written data is sent, packets are split from ring.  */
+    pattern_fill(buffer, sizeof(buffer), 0);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_write(&audio, buffer, TEST_PACKET_SIZE + 100, &actual_length));
+    UX_TEST_ASSERT(actual_length == TEST_PACKET_SIZE + 100);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_write(&audio, buffer + TEST_PACKET_SIZE + 100, TEST_PACKET_SIZE - 100, &actual_length));
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 3);
+    transfer_request = transfer_complete(UX_NULL, TEST_PACKET_SIZE, UX_SUCCESS);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_requested_length == TEST_PACKET_SIZE);
+    for (i = 0; i < TEST_PACKET_SIZE; i ++)
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer[i] == (UCHAR)i);
+    transfer_request = transfer_complete(UX_NULL, TEST_PACKET_SIZE, UX_SUCCESS);
+    for (i = 0; i < TEST_PACKET_SIZE; i ++)
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer[i] == (UCHAR)(TEST_PACKET_SIZE + i));
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 0);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 0);
+
+    /* OUT: underrun padded with silence, overrun on write.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_write(&audio, buffer, 8, &actual_length));
+    transfer_request = transfer_complete(UX_NULL, TEST_PACKET_SIZE, UX_SUCCESS);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_requested_length == TEST_PACKET_SIZE);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer[7] == 7);
+    UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer[8] == 0);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 1);
+    UX_TEST_CHECK_CODE(UX_BUFFER_OVERFLOW, ux_host_class_audio_ring_write(&audio, buffer, TEST_MAX_PACKET_SIZE * (TEST_SLOTS_NB + 1), &actual_length));
+    UX_TEST_ASSERT(actual_length == TEST_MAX_PACKET_SIZE * TEST_SLOTS_NB);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == TEST_SLOTS_NB);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+    UX_TEST_ASSERT(queued_count == 0);
+
+    /* OUT: fractional rate, 44.1K sends 9 packets of 44 frames then 1 of 45.  */
+    stream_setup(0x02);
+    audio.ux_host_class_audio_packet_size = 176;
+    audio.ux_host_class_audio_packet_fraction = 400;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    total = 0;
+    for (i = 0; i < 100; i ++)
+    {
+        ux_host_class_audio_ring_write(&audio, buffer, TEST_PACKET_SIZE, &actual_length);
+        transfer_request = transfer_complete(UX_NULL, 0, UX_SUCCESS);
+        total += transfer_request -> ux_transfer_request_requested_length;
+    }
+    UX_TEST_ASSERT(total >= 4410 * TEST_FRAME_BYTES - TEST_FRAME_BYTES && total <= 4410 * TEST_FRAME_BYTES + TEST_FRAME_BYTES);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+
+    /* OUT: rate follows feedback (10.14 in full speed), insane feedback ignored.  */
+    stream_setup(0x02);
+    audio.ux_host_class_audio_feedback_endpoint = &endpoint;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    audio.ux_host_class_audio_feedback_buffer[0] = 0x00;
+    audio.ux_host_class_audio_feedback_buffer[1] = 0x20;
+    audio.ux_host_class_audio_feedback_buffer[2] = 0x0C;   /* 48.5 frames per frame.  */
+    frames = 0;
+    for (i = 0; i < 100; i ++)
+    {
+        ux_host_class_audio_ring_write(&audio, buffer, TEST_MAX_PACKET_SIZE, &actual_length);
+        transfer_request = transfer_complete(UX_NULL, 0, UX_SUCCESS);
+        frames += transfer_request -> ux_transfer_request_requested_length / TEST_FRAME_BYTES;
+    }
+    UX_TEST_ASSERT(ux_host_class_audio_ring_rate_get(&audio) == (97ul << 15));
+    UX_TEST_ASSERT(frames >= 4849 && frames <= 4851);
+    audio.ux_host_class_audio_feedback_buffer[2] = 0x18;   /* Not 10.14, ignored.  */
+    transfer_complete(UX_NULL, 0, UX_SUCCESS);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_rate_get(&audio) == (48ul << 16));
+
+    /* 16.16 in high speed, per micro-frame.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+    device.ux_device_speed = UX_HIGH_SPEED_DEVICE;
+    audio.ux_host_class_audio_packet_size = 24;
+    audio.ux_host_class_audio_packet_freq = 8000;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    UX_TEST_ASSERT(ux_host_class_audio_ring_rate_get(&audio) == (6ul << 16));
+    _ux_utility_long_put(audio.ux_host_class_audio_feedback_buffer, (6ul << 16) + 0x1000);
+    transfer_complete(UX_NULL, 0, UX_SUCCESS);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_rate_get(&audio) == (6ul << 16) + 0x1000);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+    device.ux_device_speed = UX_FULL_SPEED_DEVICE;
+#endif
+
+    /* IN: indexes wrap past 0xFFFFFFFF, packets are still read in order.  */
+    stream_setup(0x81);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    ring -> ux_host_class_audio_ring_head = 0xFFFFFFFEu;
+    ring -> ux_host_class_audio_ring_tail = 0xFFFFFFFEu;
+    for (i = 0; i < TEST_SLOTS_NB + 1; i ++)
+    {
+        pattern_fill(packet, TEST_PACKET_SIZE, (UCHAR)(i * 16));
+        transfer_complete(packet, TEST_PACKET_SIZE, UX_SUCCESS);
+    }
+    UX_TEST_ASSERT(ring -> ux_host_class_audio_ring_head == TEST_SLOTS_NB - 2);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == TEST_SLOTS_NB);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 1);
+    for (i = 0; i < TEST_SLOTS_NB; i ++)
+    {
+        UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_read(&audio, buffer, TEST_PACKET_SIZE, &actual_length, UX_NULL));
+        UX_TEST_ASSERT(actual_length == TEST_PACKET_SIZE);
+        UX_TEST_ASSERT(buffer[0] == (UCHAR)(i * 16));
+        UX_TEST_ASSERT(buffer[TEST_PACKET_SIZE - 1] == (UCHAR)(i * 16 + TEST_PACKET_SIZE - 1));
+    }
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 0);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+
+    /* OUT: same across the wrap, written data is sent in order.  */
+    stream_setup(0x02);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    ring -> ux_host_class_audio_ring_head = 0xFFFFFFFFu;
+    ring -> ux_host_class_audio_ring_tail = 0xFFFFFFFFu;
+    pattern_fill(buffer, sizeof(buffer), 0);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_write(&audio, buffer, TEST_PACKET_SIZE * 2, &actual_length));
+    UX_TEST_ASSERT(ring -> ux_host_class_audio_ring_head == 1);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 2);
+    for (frame = 0; frame < 2; frame ++)
+    {
+        transfer_request = transfer_complete(UX_NULL, TEST_PACKET_SIZE, UX_SUCCESS);
+        UX_TEST_ASSERT(transfer_request -> ux_transfer_request_requested_length == TEST_PACKET_SIZE);
+        for (i = 0; i < TEST_PACKET_SIZE; i ++)
+            UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer[i] == (UCHAR)(frame * TEST_PACKET_SIZE + i));
+    }
+    UX_TEST_ASSERT(ux_host_class_audio_ring_level_get(&audio) == 0);
+    UX_TEST_ASSERT(ux_host_class_audio_ring_xruns_get(&audio) == 0);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_stop(&audio));
+
+    /* Release stops running ring, as audio stop and sampling set do.  */
+    stream_setup(0x81);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    audio.ux_host_class_audio_state = UX_HOST_CLASS_INSTANCE_SHUTDOWN;
+    UX_TEST_CHECK_CODE(UX_HOST_CLASS_INSTANCE_UNKNOWN, ux_host_class_audio_ring_read(&audio, buffer, sizeof(buffer), &actual_length, UX_NULL));
+    audio.ux_host_class_audio_state = UX_HOST_CLASS_INSTANCE_LIVE;
+    _ux_host_class_audio_ring_release(&audio);
+    UX_TEST_ASSERT(queued_count == 0);
+    UX_TEST_ASSERT(ring -> ux_host_class_audio_ring_state == UX_HOST_CLASS_AUDIO_RING_STOPPED);
+
+    /* Instance not known.  */
+    UX_TEST_CHECK_SUCCESS(_ux_host_stack_class_instance_destroy(audio_class, (VOID *)&audio));
+    UX_TEST_CHECK_CODE(UX_HOST_CLASS_INSTANCE_UNKNOWN, ux_host_class_audio_ring_start(&audio, TEST_FRAME_BYTES, TEST_SLOTS_NB));
+    UX_TEST_CHECK_CODE(UX_HOST_CLASS_INSTANCE_UNKNOWN, ux_host_class_audio_ring_stop(&audio));
+
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+#endif
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio_host_ring_test_application_define(void *first_unused_memory)
+#endif
+{
+
+
+    /* Inform user.  */
+    printf("Running Audio Host Ring Streaming Test.............................. ");
+#if !defined(UX_HOST_CLASS_AUDIO_RING_SUPPORT)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(usbx_memory, UX_TEST_MEMORY_SIZE, UX_NULL, 0));
+
+    /* Mutex is used, run the test in a thread.  */
+    UX_TEST_CHECK_SUCCESS(tx_thread_create(&test_thread, "test thread", test_thread_entry, 0,
+                                           test_thread_stack, UX_TEST_STACK_SIZE,
+                                           20, 20, 1, TX_AUTO_START));
+#endif
+}
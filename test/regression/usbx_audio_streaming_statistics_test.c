@@ -0,0 +1,452 @@
+/* This tests the audio streaming statistics of device streams and host
+   isochronous transfer requests: intervals, FIFO (or pending requests) level
+   histogram, feedback and xruns. Packets are simulated with a controlled time
+   base in microseconds and jitter, and the latency and jitter measured for
+   48kHz, 96kHz and 192kHz streams are reported.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_device_stack.h"
+#include "ux_device_class_audio.h"
+
+#include "ux_host_stack.h"
+#include "ux_host_class_audio.h"
+
+#include "ux_test.h"
+
+/* Define USBX test constants.  */
+
+#define UX_TEST_MEMORY_SIZE                 (64*1024)
+
+#define TEST_FRAME_BYTES                    4           /* 16-bit stereo.  */
+#define TEST_FRAME_DATA_SIZE                (24 * TEST_FRAME_BYTES)
+#define TEST_FRAME_BUFFER_SIZE              (TEST_FRAME_DATA_SIZE + 8)
+#define TEST_FRAME_BUFFER_NB                16
+
+#define TEST_PACKETS                        800
+#define TEST_PREFILL                        4           /* Packets received before codec starts.  */
+#define TEST_JITTER                         10          /* Packet arrival jitter, in us.  */
+#define TEST_TIME_START                     ((ULONG)0 - 50000)      /* Time stamps wrap in test.  */
+
+#define TEST_RATES_NB                       3
+
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT) && defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+static ULONG                                usbx_memory[UX_TEST_MEMORY_SIZE / sizeof(ULONG)];
+static ULONG                                stream_buffer[TEST_FRAME_BUFFER_SIZE * TEST_FRAME_BUFFER_NB / sizeof(ULONG)];
+
+static UX_DEVICE_CLASS_AUDIO                audio;
+static UX_DEVICE_CLASS_AUDIO_STREAM         stream;
+static UX_SLAVE_ENDPOINT                    endpoint;
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+static UX_SLAVE_ENDPOINT                    feedback;
+static UCHAR                                feedback_buffer[8];
+#endif
+static UCHAR                                packet[TEST_FRAME_DATA_SIZE];
+
+static UX_DEVICE_CLASS_AUDIO_STATISTICS             statistics;
+static UX_DEVICE_CLASS_AUDIO_STATISTICS_PARAMETER   statistics_parameter;
+
+static UX_HOST_CLASS_AUDIO                  host_audio;
+static UX_DEVICE                            host_device;
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+static UX_ENDPOINT                          host_feedback;
+#endif
+static UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST host_request;
+static UX_HOST_CLASS_AUDIO_STATISTICS       host_statistics;
+static ULONG                                host_frame_number;
+static ULONG                                host_resubmit;
+static ULONG                                host_done;
+
+static ULONG                                jitter_seed;
+
+static ULONG                                report_level_mean[TEST_RATES_NB];
+static ULONG                                report_level_max[TEST_RATES_NB];
+static ULONG                                report_interval_mean[TEST_RATES_NB];
+static ULONG                                report_jitter[TEST_RATES_NB];
+
+static ULONG jitter_get(VOID)
+{
+    jitter_seed = jitter_seed * 1103515245ul + 12345;
+    return((jitter_seed >> 16) % (TEST_JITTER + 1));
+}
+
+static VOID  stream_reset(VOID)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+ULONG                           i;
+
+    /* The OUT stream has its data (and feedback) endpoints and empty frame buffers.  */
+    endpoint.ux_slave_endpoint_descriptor.bEndpointAddress = 0x01;
+    stream.ux_device_class_audio_stream_endpoint = &endpoint;
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+    feedback.ux_slave_endpoint_descriptor.bEndpointAddress = 0x82;
+    feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_data_pointer = feedback_buffer;
+    feedback.ux_slave_endpoint_transfer_request.ux_slave_transfer_request_requested_length = 4;
+    stream.ux_device_class_audio_stream_feedback = &feedback;
+#endif
+    stream.ux_device_class_audio_stream_buffer = (UCHAR *)stream_buffer;
+    stream.ux_device_class_audio_stream_buffer_size = sizeof(stream_buffer);
+    stream.ux_device_class_audio_stream_frame_buffer_size = TEST_FRAME_BUFFER_SIZE;
+    stream.ux_device_class_audio_stream_buffer_error_count = 0;
+    for (i = 0; i < TEST_FRAME_BUFFER_NB; i ++)
+    {
+        frame = (UX_DEVICE_CLASS_AUDIO_FRAME *)((UCHAR *)stream_buffer + i * TEST_FRAME_BUFFER_SIZE);
+        frame -> ux_device_class_audio_frame_length = 0;
+        frame -> ux_device_class_audio_frame_pos = 0;
+    }
+    stream.ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)stream_buffer;
+    stream.ux_device_class_audio_stream_access_pos = stream.ux_device_class_audio_stream_transfer_pos;
+    audio.ux_device_class_audio_streams = &stream;
+    audio.ux_device_class_audio_streams_nb = 1;
+}
+
+static VOID  stream_receive(ULONG length, ULONG time)
+{
+UX_INTERRUPT_SAVE_AREA
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+UCHAR                           *next;
+
+    /* Log the packet and check overflow as the read thread does.  */
+    frame = stream.ux_device_class_audio_stream_transfer_pos;
+    _ux_utility_memory_copy(frame -> ux_device_class_audio_frame_data, packet, length);
+    frame -> ux_device_class_audio_frame_length = length;
+    frame -> ux_device_class_audio_frame_pos = 0;
+    next = (UCHAR *)frame + TEST_FRAME_BUFFER_SIZE;
+    if (next >= (UCHAR *)stream_buffer + sizeof(stream_buffer))
+        next = (UCHAR *)stream_buffer;
+    if (((UX_DEVICE_CLASS_AUDIO_FRAME *)next) -> ux_device_class_audio_frame_length > 0)
+        stream.ux_device_class_audio_stream_buffer_error_count ++;
+    else
+        stream.ux_device_class_audio_stream_transfer_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next;
+
+    /* Transfer done at given time, timer not running meanwhile.  */
+    UX_DISABLE
+    tx_time_set(time);
+    _ux_device_class_audio_statistics_update(&stream, length);
+    UX_RESTORE
+}
+
+static VOID  stream_consume(VOID)
+{
+UX_DEVICE_CLASS_AUDIO_FRAME     *frame;
+UCHAR                           *next;
+
+    /* Codec takes a packet.  */
+    frame = stream.ux_device_class_audio_stream_access_pos;
+    if (frame -> ux_device_class_audio_frame_length == 0)
+        return;
+    frame -> ux_device_class_audio_frame_length = 0;
+    next = (UCHAR *)frame + TEST_FRAME_BUFFER_SIZE;
+    if (next >= (UCHAR *)stream_buffer + sizeof(stream_buffer))
+        next = (UCHAR *)stream_buffer;
+    stream.ux_device_class_audio_stream_access_pos = (UX_DEVICE_CLASS_AUDIO_FRAME *)next;
+}
+
+static UINT  statistics_ioctl(ULONG function, ULONG stream_index, UX_DEVICE_CLASS_AUDIO_STATISTICS *copy)
+{
+    statistics_parameter.ux_device_class_audio_statistics_parameter_stream_index = stream_index;
+    statistics_parameter.ux_device_class_audio_statistics_parameter_statistics = copy;
+    return(ux_device_class_audio_ioctl(&audio, function, &statistics_parameter));
+}
+
+/* High speed OUT stream, a packet per 125us micro-frame.  */
+static VOID  device_stream_run(ULONG rate_index, ULONG sample_rate)
+{
+ULONG                           packet_length;
+ULONG                           codec_time;
+ULONG                           arrival;
+ULONG                           first_arrival;
+ULONG                           k, i, sum;
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+ULONG                           nominal_feedback;
+#endif
+#if UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS > 0
+UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORD *record;
+#endif
+
+
+    _ux_system_slave -> ux_system_slave_speed = UX_HIGH_SPEED_DEVICE;
+    packet_length = sample_rate / 8000 * TEST_FRAME_BYTES;
+    stream_reset();
+    UX_TEST_CHECK_SUCCESS(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_RESET, 0, UX_NULL));
+
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+
+    /* Feedback in 16.16 samples per micro-frame, toggled around nominal.  */
+    nominal_feedback = (sample_rate / 8000) << 16;
+#endif
+
+    /* Codec starts in the middle of a micro-frame after prefill.  */
+    jitter_seed = sample_rate;
+    codec_time = TEST_PREFILL * 125 + 62;
+    first_arrival = 0;
+    for (k = 0; k < TEST_PACKETS; k ++)
+    {
+        arrival = k * 125 + jitter_get();
+        if (k == 0)
+            first_arrival = arrival;
+        while(codec_time <= arrival)
+        {
+            stream_consume();
+            codec_time += 125;
+        }
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+        _ux_utility_long_put(feedback_buffer, nominal_feedback + (k & 1));
+#endif
+        stream_receive(packet_length, TEST_TIME_START + arrival);
+    }
+
+    /* Statistics of the run.  */
+    UX_TEST_CHECK_SUCCESS(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET, 0, &statistics));
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_transfers == TEST_PACKETS);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_bytes == TEST_PACKETS * packet_length);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_time == TEST_TIME_START + arrival);
+    UX_TEST_ASSERT_MESSAGE(statistics.ux_device_class_audio_statistics_interval_min >= 125 - TEST_JITTER &&
+                           statistics.ux_device_class_audio_statistics_interval_max <= 125 + TEST_JITTER,
+                           "interval %ld..%ld\n", (long)statistics.ux_device_class_audio_statistics_interval_min,
+                           (long)statistics.ux_device_class_audio_statistics_interval_max);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_interval_sum == arrival - first_arrival);
+
+    /* Level grows to prefill + 1, then is steady.  */
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level == TEST_PREFILL + 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level_min == 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level_max == TEST_PREFILL + 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level_histogram[0] == 0);
+    for (i = 1; i <= TEST_PREFILL; i ++)
+        UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level_histogram[i] == 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level_histogram[TEST_PREFILL + 1] == TEST_PACKETS - TEST_PREFILL);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_xruns == 0);
+#if UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS > 0
+
+    /* Last transfers recorded.  */
+    record = &statistics.ux_device_class_audio_statistics_records[(TEST_PACKETS - 1) & (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+    UX_TEST_ASSERT(record -> ux_device_class_audio_statistics_record_time == TEST_TIME_START + arrival);
+    UX_TEST_ASSERT(record -> ux_device_class_audio_statistics_record_length == packet_length);
+    UX_TEST_ASSERT(record -> ux_device_class_audio_statistics_record_level == TEST_PREFILL + 1);
+    record = &statistics.ux_device_class_audio_statistics_records[(TEST_PACKETS - 2) & (UX_DEVICE_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+    UX_TEST_ASSERT(arrival - (record -> ux_device_class_audio_statistics_record_time - TEST_TIME_START) >= 125 - TEST_JITTER);
+#endif
+#if defined(UX_DEVICE_CLASS_AUDIO_FEEDBACK_SUPPORT)
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_feedback == nominal_feedback + 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_feedback_min == nominal_feedback);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_feedback_max == nominal_feedback + 1);
+#endif
+
+    /* Report: FIFO latency in us from mean level, jitter is interval max - min.  */
+    sum = 0;
+    for (i = 0; i < UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS; i ++)
+        sum += statistics.ux_device_class_audio_statistics_level_histogram[i] * i;
+    report_level_mean[rate_index] = sum * 125 / TEST_PACKETS;
+    report_level_max[rate_index] = statistics.ux_device_class_audio_statistics_level_max * 125;
+    report_interval_mean[rate_index] = statistics.ux_device_class_audio_statistics_interval_sum / (TEST_PACKETS - 1);
+    report_jitter[rate_index] = statistics.ux_device_class_audio_statistics_interval_max -
+                                statistics.ux_device_class_audio_statistics_interval_min;
+}
+
+static UINT  host_hcd_entry(UX_HCD *hcd, UINT function, VOID *parameter)
+{
+    if (function == UX_HCD_GET_FRAME_NUMBER)
+    {
+        *(ULONG *)parameter = host_frame_number;
+        return(UX_SUCCESS);
+    }
+    return(UX_FUNCTION_NOT_SUPPORTED);
+}
+
+static VOID  host_transfer_done(UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST *request)
+{
+
+    /* Application keeps requests queued.  */
+    host_done ++;
+    if (host_resubmit)
+        host_audio.ux_host_class_audio_pending_transfers ++;
+}
+
+static VOID  host_transfer_complete(UINT code, ULONG length, ULONG time)
+{
+UX_INTERRUPT_SAVE_AREA
+
+    host_request.ux_host_class_audio_transfer_request.ux_transfer_request_completion_code = code;
+    host_request.ux_host_class_audio_transfer_request.ux_transfer_request_actual_length = length;
+    UX_DISABLE
+    tx_time_set(time);
+    _ux_host_class_audio_transfer_request_completed(&host_request.ux_host_class_audio_transfer_request);
+    UX_RESTORE
+}
+#endif
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_audio_streaming_statistics_test_application_define(void *first_unused_memory)
+#endif
+{
+#if defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT) && defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+
+ULONG                           k;
+ULONG                           time;
+ULONG                           error_count;
+UX_HOST_CLASS                   *audio_class;
+#if UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS > 0
+UX_HOST_CLASS_AUDIO_STATISTICS_RECORD   *host_record;
+#endif
+#endif
+
+
+    /* Inform user.  */
+    printf("Running Audio Streaming Statistics Test............................. ");
+#if !defined(UX_DEVICE_CLASS_AUDIO_STATISTICS_SUPPORT) || !defined(UX_HOST_CLASS_AUDIO_STATISTICS_SUPPORT)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#else
+
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(usbx_memory, UX_TEST_MEMORY_SIZE, UX_NULL, 0));
+    _ux_system_slave -> ux_system_slave_device.ux_slave_device_state = UX_DEVICE_CONFIGURED;
+
+    /* Device OUT streams of 48kHz, 96kHz and 192kHz.  */
+    device_stream_run(0, 48000);
+    device_stream_run(1, 96000);
+    device_stream_run(2, 192000);
+
+    /* Codec stalls, FIFO overflows.  */
+    time = statistics.ux_device_class_audio_statistics_time;
+    for (k = 0; k < TEST_FRAME_BUFFER_NB; k ++)
+    {
+        time += 125;
+        stream_receive(TEST_FRAME_DATA_SIZE, time);
+    }
+    error_count = stream.ux_device_class_audio_stream_buffer_error_count;
+    UX_TEST_ASSERT(error_count == TEST_PREFILL + 2);
+    UX_TEST_CHECK_SUCCESS(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET, 0, &statistics));
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_xruns == error_count);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_xrun_time == time);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level == TEST_FRAME_BUFFER_NB);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level_histogram[UX_DEVICE_CLASS_AUDIO_STATISTICS_LEVELS - 1] == error_count + 1);
+
+    /* Reset returns the statistics before reset, buffer errors already seen are not counted again.  */
+    _ux_utility_memory_set(&statistics, 0, sizeof(statistics));
+    UX_TEST_CHECK_SUCCESS(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_RESET, 0, &statistics));
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_transfers == TEST_PACKETS + TEST_FRAME_BUFFER_NB);
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_statistics.ux_device_class_audio_statistics_transfers == 0);
+    UX_TEST_ASSERT(stream.ux_device_class_audio_stream_statistics.ux_device_class_audio_statistics_error_count == error_count);
+    stream_consume();
+    stream_receive(TEST_FRAME_DATA_SIZE, time + 125);
+    UX_TEST_CHECK_SUCCESS(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET, 0, &statistics));
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_transfers == 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_xruns == 0);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_level == TEST_FRAME_BUFFER_NB - 1);
+    UX_TEST_ASSERT(statistics.ux_device_class_audio_statistics_interval_max == 0);
+
+    /* Bad stream index.  */
+    UX_TEST_ASSERT(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_GET, 1, &statistics) == UX_INVALID_PARAMETER);
+    UX_TEST_ASSERT(statistics_ioctl(UX_DEVICE_CLASS_AUDIO_IOCTL_STATISTICS_RESET, 1, UX_NULL) == UX_INVALID_PARAMETER);
+
+    /* Host full speed stream, a request per 1ms frame, application keeps 3 requests queued.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_initialize(UX_NULL));
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_class_register(_ux_system_host_class_audio_name, ux_host_class_audio_entry));
+    UX_TEST_CHECK_SUCCESS(_ux_host_stack_class_get(_ux_system_host_class_audio_name, &audio_class));
+    _ux_system_host -> ux_system_host_hcd_array[0].ux_hcd_entry_function = host_hcd_entry;
+    UX_DEVICE_HCD_SET(&host_device, &_ux_system_host -> ux_system_host_hcd_array[0]);
+    host_device.ux_device_speed = UX_FULL_SPEED_DEVICE;
+    host_audio.ux_host_class_audio_class = audio_class;
+    host_audio.ux_host_class_audio_device = &host_device;
+    UX_TEST_CHECK_SUCCESS(_ux_host_stack_class_instance_create(audio_class, (VOID *)&host_audio));
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+    host_audio.ux_host_class_audio_feedback_endpoint = &host_feedback;
+    host_audio.ux_host_class_audio_feedback_buffer[0] = 0x00;
+    host_audio.ux_host_class_audio_feedback_buffer[1] = 0x00;
+    host_audio.ux_host_class_audio_feedback_buffer[2] = 0x0C;   /* 48.0 in 10.14.  */
+    host_audio.ux_host_class_audio_feedback_buffer[3] = 0xFF;   /* Not used in full speed.  */
+#endif
+    host_request.ux_host_class_audio_transfer_request_completion_function = host_transfer_done;
+    host_request.ux_host_class_audio_transfer_request.ux_transfer_request_class_instance = &host_audio;
+    host_request.ux_host_class_audio_transfer_request.ux_transfer_request_user_specific = &host_request;
+    host_audio.ux_host_class_audio_pending_transfers = 3;
+    host_resubmit = 1;
+    jitter_seed = 1;
+    for (k = 0; k < TEST_PACKETS; k ++)
+    {
+        host_frame_number = k;
+        host_transfer_complete(UX_SUCCESS, 192, TEST_TIME_START + k * 1000 + jitter_get());
+    }
+    UX_TEST_ASSERT(host_done == TEST_PACKETS);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_pending_transfers == 3);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_statistics_get(&host_audio, &host_statistics));
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_transfers == TEST_PACKETS);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_bytes == TEST_PACKETS * 192);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_frame_number == TEST_PACKETS - 1);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_interval_min >= 1000 - TEST_JITTER);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_interval_max <= 1000 + TEST_JITTER);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_level == 2);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_level_min == 2);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_level_histogram[2] == TEST_PACKETS);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_xruns == 0);
+#if UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS > 0
+    for (k = TEST_PACKETS - UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS; k < TEST_PACKETS; k ++)
+    {
+        host_record = &host_statistics.ux_host_class_audio_statistics_records[k & (UX_HOST_CLASS_AUDIO_STATISTICS_RECORDS - 1)];
+        UX_TEST_ASSERT(host_record -> ux_host_class_audio_statistics_record_frame_number == k);
+        UX_TEST_ASSERT(host_record -> ux_host_class_audio_statistics_record_time - (TEST_TIME_START + k * 1000) <= TEST_JITTER);
+        UX_TEST_ASSERT(host_record -> ux_host_class_audio_statistics_record_length == 192);
+        UX_TEST_ASSERT(host_record -> ux_host_class_audio_statistics_record_level == 2);
+    }
+#endif
+#if defined(UX_HOST_CLASS_AUDIO_FEEDBACK_SUPPORT)
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_feedback == 0x0C0000);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_feedback_min == 0x0C0000);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_feedback_max == 0x0C0000);
+#endif
+
+    /* Packet lost, then queue drained by application.  */
+    time = host_statistics.ux_host_class_audio_statistics_time;
+    host_transfer_complete(UX_TRANSFER_ERROR, 0, time + 1000);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_statistics.ux_host_class_audio_statistics_xruns == 1);
+    host_resubmit = 0;
+    host_transfer_complete(UX_SUCCESS, 192, time + 2000);
+    host_transfer_complete(UX_SUCCESS, 192, time + 3000);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_statistics.ux_host_class_audio_statistics_xruns == 1);
+    host_transfer_complete(UX_SUCCESS, 192, time + 4000);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_pending_transfers == 0);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_statistics.ux_host_class_audio_statistics_xruns == 2);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_statistics.ux_host_class_audio_statistics_xrun_time == time + 4000);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_statistics.ux_host_class_audio_statistics_level_histogram[0] == 1);
+
+    /* Aborted request is not counted.  */
+    host_audio.ux_host_class_audio_pending_transfers = 1;
+    host_transfer_complete(UX_TRANSFER_STATUS_ABORT, 0, time + 5000);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_pending_transfers == 0);
+    UX_TEST_ASSERT(host_audio.ux_host_class_audio_statistics.ux_host_class_audio_statistics_transfers == TEST_PACKETS + 4);
+    UX_TEST_ASSERT(host_done == TEST_PACKETS + 5);
+
+    /* Reset returns the statistics before reset.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_statistics_reset(&host_audio, &host_statistics));
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_transfers == TEST_PACKETS + 4);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_statistics_reset(&host_audio, UX_NULL));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_audio_statistics_get(&host_audio, &host_statistics));
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_transfers == 0);
+    UX_TEST_ASSERT(host_statistics.ux_host_class_audio_statistics_xruns == 0);
+
+    /* Instance checks.  */
+    UX_TEST_CHECK_SUCCESS(_ux_host_stack_class_instance_destroy(audio_class, (VOID *)&host_audio));
+    UX_TEST_ASSERT(ux_host_class_audio_statistics_get(&host_audio, &host_statistics) == UX_HOST_CLASS_INSTANCE_UNKNOWN);
+    UX_TEST_ASSERT(ux_host_class_audio_statistics_reset(&host_audio, UX_NULL) == UX_HOST_CLASS_INSTANCE_UNKNOWN);
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+
+    /* Report latency and jitter measured.  */
+    for (k = 0; k < TEST_RATES_NB; k ++)
+    {
+        printf("  %6ld Hz: FIFO latency %ld us (max %ld us), interval %ld us, jitter %ld us\n",
+               (long)(48000 << k), (long)report_level_mean[k], (long)report_level_max[k],
+               (long)report_interval_mean[k], (long)report_jitter[k]);
+    }
+    test_control_return(0);
+#endif
+}
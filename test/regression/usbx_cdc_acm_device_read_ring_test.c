@@ -0,0 +1,199 @@
+/* This tests the device CDC-ACM reception ring: received data is saved in
+   the ring and read without waiting, packets are kept queued on the bulk
+   OUT endpoint of the simulator DCD, the host is NAKed while the ring is
+   full, and the ring is stopped and started by ioctl.  */
+
+#include "usbx_ux_test_cdc_acm.h"
+
+#define RING_TEST_PACKET_SIZE       64
+#define RING_TEST_OVERFLOW_LENGTH   (RING_TEST_PACKET_SIZE * 4)
+
+static UCHAR        host_buffer[UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE + RING_TEST_OVERFLOW_LENGTH];
+static UCHAR        device_buffer[UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE + RING_TEST_OVERFLOW_LENGTH];
+static ULONG        test_step;
+static UCHAR        host_write_done;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_acm_device_read_ring_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ACM Device Read Ring Test............................... ");
+    stepinfo("\n");
+#if !defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_acm_initialize(first_unused_memory);
+}
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+static void ring_host_write(ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+ULONG       actual_length;
+
+
+    for (i = 0; i < length; i ++)
+        host_buffer[i] = (UCHAR)(tag + i);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_write(cdc_acm_host_data, host_buffer, length, &actual_length));
+    UX_TEST_ASSERT(actual_length == length);
+}
+
+static void ring_device_check(UCHAR *buffer, ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+
+
+    for (i = 0; i < length; i ++)
+        UX_TEST_ASSERT(buffer[i] == (UCHAR)(tag + i));
+}
+
+static void ring_device_queue_check(void)
+{
+
+UX_SLAVE_ENDPOINT   *endpoint;
+
+
+    /* The simulator DCD queues transfers, packets are queued on the bulk OUT endpoint.  */
+    endpoint = cdc_acm_slave -> ux_slave_class_cdc_acm_interface -> ux_slave_interface_first_endpoint;
+    if ((endpoint -> ux_slave_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) != UX_ENDPOINT_OUT)
+        endpoint = endpoint -> ux_slave_endpoint_next_endpoint;
+    UX_TEST_ASSERT(endpoint -> ux_slave_endpoint_transfer_requests != UX_NULL);
+    UX_TEST_ASSERT(endpoint -> ux_slave_endpoint_transfer_requests_count == UX_DEVICE_CLASS_CDC_ACM_READ_RING_TRANSFER_COUNT);
+}
+
+static void ring_device_wait_available(ULONG length)
+{
+
+ULONG       available;
+ULONG       wait_ms = 0;
+
+
+    while (1)
+    {
+        UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read_available(cdc_acm_slave, &available));
+        if (available >= length)
+            break;
+        UX_TEST_ASSERT(wait_ms < 2000);
+        tx_thread_sleep(1);
+        wait_ms += 10;
+    }
+    UX_TEST_ASSERT(available == length);
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+UX_SLAVE_CLASS_CDC_ACM_CALLBACK_PARAMETER   callback;
+ULONG                                       available;
+ULONG                                       actual_length;
+
+
+    /* The ring is started once, not with transmission.  */
+    stepinfo("start.\n");
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_START, UX_NULL));
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_START, UX_NULL));
+    callback.ux_device_class_cdc_acm_parameter_write_callback = UX_NULL;
+    callback.ux_device_class_cdc_acm_parameter_read_callback = UX_NULL;
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_TRANSMISSION_START, &callback));
+
+    /* Data is saved in the ring, peek keeps it and read removes it.  */
+    stepinfo("peek and read.\n");
+    ring_host_write(100, 'A');
+    ring_device_wait_available(100);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read_peek(cdc_acm_slave, device_buffer, 10, &actual_length));
+    UX_TEST_ASSERT(actual_length == 10);
+    ring_device_check(device_buffer, 10, 'A');
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read_available(cdc_acm_slave, &available));
+    UX_TEST_ASSERT(available == 100);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read(cdc_acm_slave, device_buffer, 200, &actual_length));
+    UX_TEST_ASSERT(actual_length == 100);
+    ring_device_check(device_buffer, 100, 'A');
+    ring_device_queue_check();
+
+    /* Read does not wait for data.  */
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read(cdc_acm_slave, device_buffer, 10, &actual_length));
+    UX_TEST_ASSERT(actual_length == 0);
+
+    /* Data wraps around the end of the ring.  */
+    stepinfo("wrap.\n");
+    ring_host_write(UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - 100, 'a');
+    ring_device_wait_available(UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - 100);
+    UX_TEST_ASSERT(cdc_acm_slave -> ux_device_class_cdc_acm_read_ring_head < cdc_acm_slave -> ux_device_class_cdc_acm_read_ring_tail);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read_peek(cdc_acm_slave, device_buffer, sizeof(device_buffer), &actual_length));
+    UX_TEST_ASSERT(actual_length == UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - 100);
+    ring_device_check(device_buffer, actual_length, 'a');
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read(cdc_acm_slave, device_buffer, sizeof(device_buffer), &actual_length));
+    UX_TEST_ASSERT(actual_length == UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE - 100);
+    ring_device_check(device_buffer, actual_length, 'a');
+
+    /* The host is NAKed while the ring is full, the device drains it.  */
+    stepinfo("full.\n");
+    test_step = 1;
+    ring_host_write(UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE + RING_TEST_OVERFLOW_LENGTH, '0');
+    host_write_done = UX_TRUE;
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&test_step, 2));
+
+    /* The ring is stopped, it can be started again.  */
+    stepinfo("stop.\n");
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_STOP, UX_NULL));
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_STOP, UX_NULL));
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_device_class_cdc_acm_read_available(cdc_acm_slave, &available));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_READ_RING_START, UX_NULL));
+    ring_host_write(RING_TEST_PACKET_SIZE, 'x');
+    ring_device_wait_available(RING_TEST_PACKET_SIZE);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read(cdc_acm_slave, device_buffer, sizeof(device_buffer), &actual_length));
+    UX_TEST_ASSERT(actual_length == RING_TEST_PACKET_SIZE);
+    ring_device_check(device_buffer, actual_length, 'x');
+
+    /* The ring is left started, it is stopped on disconnection.  */
+#endif
+}
+
+static void post_init_device()
+{
+#if defined(UX_DEVICE_CLASS_CDC_ACM_READ_RING)
+
+ULONG       actual_length;
+ULONG       total_length;
+ULONG       wait_ms;
+
+
+    /* Wait for the host to write more than the ring size.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&test_step, 1));
+    ring_device_wait_available(UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE);
+
+    /* The ring is full, the host write is pending.  */
+    tx_thread_sleep(10);
+    UX_TEST_ASSERT(cdc_acm_slave -> ux_device_class_cdc_acm_read_ring_waiting == UX_TRUE);
+    UX_TEST_ASSERT(host_write_done == UX_FALSE);
+
+    /* Drain the ring, the rest of data is received.  */
+    total_length = 0;
+    wait_ms = 0;
+    while (total_length < UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE + RING_TEST_OVERFLOW_LENGTH)
+    {
+        UX_TEST_ASSERT(wait_ms < 2000);
+        UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_read(cdc_acm_slave, device_buffer + total_length,
+                                                           RING_TEST_PACKET_SIZE * 3, &actual_length));
+        total_length += actual_length;
+        tx_thread_sleep(1);
+        wait_ms += 10;
+    }
+    UX_TEST_ASSERT(total_length == UX_DEVICE_CLASS_CDC_ACM_READ_RING_BUFFER_SIZE + RING_TEST_OVERFLOW_LENGTH);
+    ring_device_check(device_buffer, total_length, '0');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_uchar(&host_write_done, UX_TRUE));
+    test_step = 2;
+#endif
+}
@@ -0,0 +1,177 @@
+/* This tests the device CDC-ACM write coalescing: small writes are sent in
+   few transfers, full packets are sent without waiting, the rest is sent on
+   latency deadline or flush, the ring is not overflowed, and coalescing is
+   enabled and disabled by ioctl.  */
+
+#include "usbx_ux_test_cdc_acm.h"
+
+#define COALESCE_TEST_PACKET_SIZE   64
+#define COALESCE_TEST_WRITE_LENGTH  10
+#define COALESCE_TEST_WRITE_COUNT   10
+#define COALESCE_TEST_LATENCY_MS    50
+
+static UCHAR        device_buffer[UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE];
+static UCHAR        host_buffer[UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE];
+static ULONG        write_callback_count;
+static ULONG        write_callback_length;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_acm_device_write_coalesce_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ACM Device Write Coalesce Test.......................... ");
+    stepinfo("\n");
+#if !defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_acm_initialize(first_unused_memory);
+}
+
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+static UINT coalesce_write_callback(UX_SLAVE_CLASS_CDC_ACM *cdc_acm, UINT status, ULONG length)
+{
+
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    write_callback_count ++;
+    write_callback_length += length;
+    return(UX_SUCCESS);
+}
+
+static void coalesce_device_write(ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+
+
+    for (i = 0; i < length; i ++)
+        device_buffer[i] = (UCHAR)(tag + i);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_write_with_callback(cdc_acm_slave, device_buffer, length));
+}
+
+static ULONG coalesce_host_read(ULONG length)
+{
+
+ULONG       actual_length;
+ULONG       total_length = 0;
+
+
+    /* Read until all the expected data is received.  */
+    while (total_length < length)
+    {
+        UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_read(cdc_acm_host_data, host_buffer + total_length,
+                                                         sizeof(host_buffer) - total_length, &actual_length));
+        total_length += actual_length;
+    }
+    UX_TEST_ASSERT(total_length == length);
+    return(total_length);
+}
+
+static void coalesce_host_check(ULONG offset, ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+
+
+    for (i = 0; i < length; i ++)
+        UX_TEST_ASSERT(host_buffer[offset + i] == (UCHAR)(tag + i));
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE)
+
+UX_SLAVE_CLASS_CDC_ACM_CALLBACK_PARAMETER   callback;
+ULONG                                       i;
+ULONG                                       start_time;
+
+
+    /* Start transmission with coalescing.  */
+    stepinfo("start.\n");
+    callback.ux_device_class_cdc_acm_parameter_write_callback = coalesce_write_callback;
+    callback.ux_device_class_cdc_acm_parameter_read_callback = UX_NULL;
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_TRANSMISSION_START, &callback));
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH, UX_NULL));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE,
+                                                        (VOID *)(ALIGN_TYPE)COALESCE_TEST_LATENCY_MS));
+
+    /* Small writes are coalesced, full packet first and the rest on deadline.  */
+    stepinfo("small writes.\n");
+    write_callback_count = 0;
+    write_callback_length = 0;
+    for (i = 0; i < COALESCE_TEST_WRITE_COUNT; i ++)
+        coalesce_device_write(COALESCE_TEST_WRITE_LENGTH, (UCHAR)(i * COALESCE_TEST_WRITE_LENGTH));
+    start_time = tx_time_get();
+    coalesce_host_read(COALESCE_TEST_WRITE_LENGTH * COALESCE_TEST_WRITE_COUNT);
+    UX_TEST_ASSERT(tx_time_get() - start_time >= UX_MS_TO_TICK(COALESCE_TEST_LATENCY_MS) / 2);
+    coalesce_host_check(0, COALESCE_TEST_WRITE_LENGTH * COALESCE_TEST_WRITE_COUNT, 0);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&write_callback_length, COALESCE_TEST_WRITE_LENGTH * COALESCE_TEST_WRITE_COUNT));
+    UX_TEST_ASSERT(write_callback_count < COALESCE_TEST_WRITE_COUNT);
+
+    /* Full packets are sent without waiting for the deadline.  */
+    stepinfo("full packets.\n");
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE,
+                                                        (VOID *)(ALIGN_TYPE)100000));
+    write_callback_length = 0;
+    coalesce_device_write(COALESCE_TEST_PACKET_SIZE * 2, 'P');
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_read(cdc_acm_host_data, host_buffer, COALESCE_TEST_PACKET_SIZE * 2, &i));
+    UX_TEST_ASSERT(i == COALESCE_TEST_PACKET_SIZE * 2);
+    coalesce_host_check(0, COALESCE_TEST_PACKET_SIZE * 2, 'P');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&write_callback_length, COALESCE_TEST_PACKET_SIZE * 2));
+
+    /* The rest is sent on flush.  */
+    stepinfo("flush.\n");
+    write_callback_length = 0;
+    coalesce_device_write(COALESCE_TEST_WRITE_LENGTH, 'F');
+    tx_thread_sleep(UX_MS_TO_TICK(COALESCE_TEST_LATENCY_MS));
+    UX_TEST_ASSERT(write_callback_length == 0);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH, UX_NULL));
+    coalesce_host_read(COALESCE_TEST_WRITE_LENGTH);
+    coalesce_host_check(0, COALESCE_TEST_WRITE_LENGTH, 'F');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&write_callback_length, COALESCE_TEST_WRITE_LENGTH));
+
+    /* Data is not accepted when the ring is full.  */
+    stepinfo("ring full.\n");
+    write_callback_length = 0;
+    coalesce_device_write(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE - COALESCE_TEST_WRITE_LENGTH, 'R');
+    coalesce_device_write(COALESCE_TEST_WRITE_LENGTH, 'r');
+    UX_TEST_CHECK_CODE(UX_BUFFER_OVERFLOW, ux_device_class_cdc_acm_write_with_callback(cdc_acm_slave, device_buffer, 1));
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH, UX_NULL));
+    coalesce_host_read(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE);
+    coalesce_host_check(0, UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE - COALESCE_TEST_WRITE_LENGTH, 'R');
+    coalesce_host_check(UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE - COALESCE_TEST_WRITE_LENGTH, COALESCE_TEST_WRITE_LENGTH, 'r');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&write_callback_length, UX_DEVICE_CLASS_CDC_ACM_WRITE_COALESCE_BUFFER_SIZE));
+
+    /* Coalescing is disabled when nothing is pending, writes are sent one by one.  */
+    stepinfo("disable.\n");
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE, UX_NULL));
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_WRITE_FLUSH, UX_NULL));
+    write_callback_count = 0;
+    write_callback_length = 0;
+    coalesce_device_write(COALESCE_TEST_WRITE_LENGTH, 'D');
+    coalesce_host_read(COALESCE_TEST_WRITE_LENGTH);
+    coalesce_host_check(0, COALESCE_TEST_WRITE_LENGTH, 'D');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&write_callback_length, COALESCE_TEST_WRITE_LENGTH));
+    UX_TEST_ASSERT(write_callback_count == 1);
+
+    /* Coalescing can't be enabled while a write is pending.  */
+    cdc_acm_slave -> ux_slave_class_cdc_acm_scheduled_write = UX_TRUE;
+    UX_TEST_CHECK_CODE(UX_BUSY, ux_device_class_cdc_acm_ioctl(cdc_acm_slave, UX_SLAVE_CLASS_CDC_ACM_IOCTL_SET_WRITE_COALESCE,
+                                                             (VOID *)(ALIGN_TYPE)COALESCE_TEST_LATENCY_MS));
+    cdc_acm_slave -> ux_slave_class_cdc_acm_scheduled_write = UX_FALSE;
+
+    /* Transmission is stopped on disconnection.  */
+#endif
+}
+
+static void post_init_device()
+{
+}
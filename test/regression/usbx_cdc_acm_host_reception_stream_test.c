@@ -0,0 +1,228 @@
+/* This tests the host CDC-ACM reception streaming: several transfers are kept
+   outstanding, received data is read in place as contiguous spans and kept
+   until released, the device is NAKed and an overflow is counted while all
+   blocks are waiting, and the reception is stopped and started again.  */
+
+#include "usbx_ux_test_cdc_acm.h"
+
+#define STREAM_TEST_BLOCK_SIZE      64
+#define STREAM_TEST_BLOCK_COUNT     8
+#define STREAM_TEST_TRANSFER_COUNT  3
+#define STREAM_TEST_BUFFER_SIZE     (STREAM_TEST_BLOCK_SIZE * STREAM_TEST_BLOCK_COUNT)
+#define STREAM_TEST_OVERFLOW_LENGTH (STREAM_TEST_BUFFER_SIZE + 30)
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+#define STREAM_TEST_STATISTICS_CHECK(field, value)  \
+    UX_TEST_ASSERT(cdc_acm_host_data -> ux_host_class_cdc_acm_statistics.ux_host_class_serial_statistics_##field == (value))
+#else
+#define STREAM_TEST_STATISTICS_CHECK(field, value)
+#endif
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static UX_HOST_CLASS_CDC_ACM_RECEPTION  reception;
+#endif
+static UCHAR        reception_buffer[STREAM_TEST_BUFFER_SIZE];
+static UCHAR        device_buffer[STREAM_TEST_OVERFLOW_LENGTH];
+static ULONG        callback_length;
+static ULONG        callback_overflow;
+static ULONG        test_step;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_acm_host_reception_stream_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ACM Host Reception Stream Test.......................... ");
+    stepinfo("\n");
+#if !defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_acm_initialize(first_unused_memory);
+}
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static VOID stream_reception_callback(UX_HOST_CLASS_CDC_ACM *cdc_acm, UINT status, UCHAR *buffer, ULONG length)
+{
+
+    /* Overflow is reported without data.  */
+    if (status == UX_BUFFER_OVERFLOW)
+    {
+        UX_TEST_ASSERT(buffer == UX_NULL);
+        callback_overflow ++;
+        return;
+    }
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(buffer >= reception_buffer && buffer + length <= reception_buffer + STREAM_TEST_BUFFER_SIZE);
+    callback_length += length;
+}
+
+static void stream_device_write(ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+ULONG       actual_length;
+
+
+    for (i = 0; i < length; i ++)
+        device_buffer[i] = (UCHAR)(tag + i);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_write(cdc_acm_slave, device_buffer, length, &actual_length));
+    UX_TEST_ASSERT(actual_length == length);
+}
+
+static void stream_span_check(ULONG offset, ULONG length, UCHAR tag, ULONG data_offset)
+{
+
+UCHAR       *span_buffer;
+ULONG       span_length;
+ULONG       i;
+
+
+    /* The span is in place in the reception buffer.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_get(cdc_acm_host_data, &span_buffer, &span_length));
+    UX_TEST_ASSERT(span_buffer == reception_buffer + offset);
+    UX_TEST_ASSERT(span_length == length);
+    for (i = 0; i < length; i ++)
+        UX_TEST_ASSERT(span_buffer[i] == (UCHAR)(tag + data_offset + i));
+}
+
+static void stream_read(ULONG length, UCHAR tag)
+{
+
+UCHAR       *span_buffer;
+ULONG       span_length;
+ULONG       total_length = 0;
+ULONG       wait_ms = 0;
+ULONG       i;
+
+
+    /* Read spans and release them until all the expected data is received.  */
+    while (total_length < length)
+    {
+        UX_TEST_ASSERT(wait_ms < 2000);
+        UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_get(cdc_acm_host_data, &span_buffer, &span_length));
+        if (span_length == 0)
+        {
+            tx_thread_sleep(1);
+            wait_ms += 10;
+            continue;
+        }
+        UX_TEST_ASSERT(total_length + span_length <= length);
+        for (i = 0; i < span_length; i ++)
+            UX_TEST_ASSERT(span_buffer[i] == (UCHAR)(tag + total_length + i));
+        UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_release(cdc_acm_host_data, span_length));
+        total_length += span_length;
+    }
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+UCHAR       *span_buffer;
+ULONG       span_length;
+
+
+    /* Reception is not started, there is no span.  */
+    stepinfo("start.\n");
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_cdc_acm_reception_span_get(cdc_acm_host_data, &span_buffer, &span_length));
+
+    /* The buffer must have a block for each outstanding transfer.  */
+    reception.ux_host_class_cdc_acm_reception_block_size = STREAM_TEST_BLOCK_SIZE;
+    reception.ux_host_class_cdc_acm_reception_data_buffer = reception_buffer;
+    reception.ux_host_class_cdc_acm_reception_data_buffer_size = STREAM_TEST_BUFFER_SIZE;
+    reception.ux_host_class_cdc_acm_reception_callback = stream_reception_callback;
+    reception.ux_host_class_cdc_acm_reception_transfer_count = STREAM_TEST_BLOCK_COUNT + 1;
+    ux_test_ignore_all_errors();
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_cdc_acm_reception_start(cdc_acm_host_data, &reception));
+    ux_test_unignore_all_errors();
+
+    /* Transfers are outstanding on the bulk IN endpoint.  */
+    reception.ux_host_class_cdc_acm_reception_transfer_count = STREAM_TEST_TRANSFER_COUNT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_start(cdc_acm_host_data, &reception));
+    UX_TEST_ASSERT(cdc_acm_host_data -> ux_host_class_cdc_acm_bulk_in_endpoint -> ux_endpoint_transfer_requests_count == STREAM_TEST_TRANSFER_COUNT);
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_transfers_pending == STREAM_TEST_TRANSFER_COUNT);
+    ux_test_ignore_all_errors();
+    UX_TEST_CHECK_CODE(UX_ALREADY_ACTIVATED, ux_host_class_cdc_acm_reception_start(cdc_acm_host_data, &reception));
+    ux_test_unignore_all_errors();
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_transfers_pending == STREAM_TEST_TRANSFER_COUNT);
+
+    /* Full blocks are read as one span, data is kept until released.  */
+    stepinfo("span.\n");
+    stream_device_write(STREAM_TEST_BLOCK_SIZE * 2 + 10, 'A');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&callback_length, STREAM_TEST_BLOCK_SIZE * 2 + 10));
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_blocks_filled == 3);
+    STREAM_TEST_STATISTICS_CHECK(rx_bytes, STREAM_TEST_BLOCK_SIZE * 2 + 10);
+    stream_span_check(0, STREAM_TEST_BLOCK_SIZE * 2 + 10, 'A', 0);
+    stream_span_check(0, STREAM_TEST_BLOCK_SIZE * 2 + 10, 'A', 0);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_release(cdc_acm_host_data, 100));
+    stream_span_check(100, STREAM_TEST_BLOCK_SIZE * 2 + 10 - 100, 'A', 100);
+    ux_test_ignore_all_errors();
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_cdc_acm_reception_span_release(cdc_acm_host_data, STREAM_TEST_BLOCK_SIZE * 2 + 10 - 99));
+    ux_test_unignore_all_errors();
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_release(cdc_acm_host_data, STREAM_TEST_BLOCK_SIZE * 2 + 10 - 100));
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_blocks_filled == 0);
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_transfers_pending == STREAM_TEST_TRANSFER_COUNT);
+
+    /* A span ends at the end of the buffer, data goes on at its start.  */
+    stepinfo("wrap.\n");
+    callback_length = 0;
+    stream_device_write(STREAM_TEST_BLOCK_SIZE * 5 + 20, 'a');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&callback_length, STREAM_TEST_BLOCK_SIZE * 5 + 20));
+    stream_span_check(STREAM_TEST_BLOCK_SIZE * 3, STREAM_TEST_BLOCK_SIZE * 5, 'a', 0);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_release(cdc_acm_host_data, STREAM_TEST_BLOCK_SIZE * 5));
+    stream_span_check(0, 20, 'a', STREAM_TEST_BLOCK_SIZE * 5);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_release(cdc_acm_host_data, 20));
+    STREAM_TEST_STATISTICS_CHECK(rx_blocks_high_water, 6);
+    STREAM_TEST_STATISTICS_CHECK(rx_overflows, 0);
+    UX_TEST_ASSERT(callback_overflow == 0);
+
+    /* The device is NAKed while all blocks are waiting, no data is lost.  */
+    stepinfo("overflow.\n");
+    test_step = 1;
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&callback_overflow, 1));
+    STREAM_TEST_STATISTICS_CHECK(rx_overflows, 1);
+    STREAM_TEST_STATISTICS_CHECK(rx_blocks_high_water, STREAM_TEST_BLOCK_COUNT);
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_stream.ux_host_class_serial_stream_transfers_pending == 0);
+    tx_thread_sleep(10);
+    UX_TEST_ASSERT(test_step == 1);
+    stream_read(STREAM_TEST_OVERFLOW_LENGTH, '0');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&test_step, 2));
+
+    /* Stop frees the transfers, the reception can be started again.  */
+    stepinfo("stop.\n");
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_stop(cdc_acm_host_data, &reception));
+    UX_TEST_ASSERT(reception.ux_host_class_cdc_acm_reception_state == UX_HOST_CLASS_CDC_ACM_RECEPTION_STATE_STOPPED);
+    UX_TEST_ASSERT(cdc_acm_host_data -> ux_host_class_cdc_acm_bulk_in_endpoint -> ux_endpoint_transfer_requests == UX_NULL);
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_cdc_acm_reception_span_get(cdc_acm_host_data, &span_buffer, &span_length));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_start(cdc_acm_host_data, &reception));
+    STREAM_TEST_STATISTICS_CHECK(rx_overflows, 1);
+    callback_length = 0;
+    stream_device_write(10, 'x');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&callback_length, 10));
+    stream_span_check(0, 10, 'x', 0);
+
+    /* Statistics are kept for the port, they are not reset by a new reception.  */
+    STREAM_TEST_STATISTICS_CHECK(rx_bytes, STREAM_TEST_BLOCK_SIZE * 7 + 30 + STREAM_TEST_OVERFLOW_LENGTH + 10);
+    STREAM_TEST_STATISTICS_CHECK(rx_blocks_high_water, STREAM_TEST_BLOCK_COUNT);
+
+    /* The reception is left started, it is freed on disconnection.  */
+#endif
+}
+
+static void post_init_device()
+{
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+
+    /* Write more than the reception buffer, it completes when the host releases data.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&test_step, 1));
+    stream_device_write(STREAM_TEST_OVERFLOW_LENGTH, '0');
+    test_step = 2;
+#endif
+}
@@ -0,0 +1,526 @@
+/* This benchmarks the host serial reception with several CDC-ACM ports on a
+   composite device: for 1 to SERIAL_BENCHMARK_MAX_PORTS ports, data is read
+   by one reader thread per port, then by a single thread serving the
+   streamed receptions of all the ports through a shared event flags group.
+   Throughput, CPU per KB and reader wakeups per KB are only reported, the
+   benchmark checks nothing but that data went through in order.  */
+
+#include <stdio.h>
+#include <sys/time.h>
+#include <time.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_device_class_cdc_acm.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_cdc_acm.h"
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+#include "ux_test_utility_sim.h"
+#include "ux_test.h"
+
+/* Define benchmark constants.  */
+
+#define UX_DEMO_STACK_SIZE                  (4*1024)
+#define UX_USBX_MEMORY_SIZE                 (256*1024)
+
+/* Each port uses 3 endpoints of the 15 of the simulated device controller,
+   and a device class instance.  */
+#ifndef SERIAL_BENCHMARK_MAX_PORTS
+#if UX_MAX_SLAVE_CLASS_DRIVER < 4
+#define SERIAL_BENCHMARK_MAX_PORTS          UX_MAX_SLAVE_CLASS_DRIVER
+#else
+#define SERIAL_BENCHMARK_MAX_PORTS          4
+#endif
+#endif
+
+/* Writes are not multiple of the packet size, so no zero length packet is
+   left pending when all data is received.  */
+#ifndef SERIAL_BENCHMARK_WRITE_SIZE
+#define SERIAL_BENCHMARK_WRITE_SIZE         1000
+#endif
+#ifndef SERIAL_BENCHMARK_WRITES_PER_PORT
+#define SERIAL_BENCHMARK_WRITES_PER_PORT    32
+#endif
+#ifndef SERIAL_BENCHMARK_BLOCK_SIZE
+#define SERIAL_BENCHMARK_BLOCK_SIZE         512
+#endif
+#ifndef SERIAL_BENCHMARK_BLOCK_COUNT
+#define SERIAL_BENCHMARK_BLOCK_COUNT        8
+#endif
+#ifndef SERIAL_BENCHMARK_TRANSFER_COUNT
+#define SERIAL_BENCHMARK_TRANSFER_COUNT     4
+#endif
+#ifndef SERIAL_BENCHMARK_TIMEOUT_MS
+#define SERIAL_BENCHMARK_TIMEOUT_MS         10000
+#endif
+
+#define SERIAL_BENCHMARK_BYTES_PER_PORT     (SERIAL_BENCHMARK_WRITE_SIZE * SERIAL_BENCHMARK_WRITES_PER_PORT)
+#define SERIAL_BENCHMARK_PACKET_SIZE        64
+#define SERIAL_BENCHMARK_FUNCTION_LENGTH    66
+#define SERIAL_BENCHMARK_FRAMEWORK_SIZE     (18 + 10 + 9 + SERIAL_BENCHMARK_FUNCTION_LENGTH * SERIAL_BENCHMARK_MAX_PORTS)
+
+typedef struct SERIAL_BENCHMARK_PORT
+{
+    UX_HOST_CLASS_CDC_ACM           *host;
+    UX_SLAVE_CLASS_CDC_ACM          *device;
+    ULONG                           received;
+    ULONG                           wakeups;
+    TX_THREAD                       reader_thread;
+    TX_SEMAPHORE                    reader_start;
+    UCHAR                           reader_stack[UX_DEMO_STACK_SIZE];
+    TX_THREAD                       writer_thread;
+    TX_SEMAPHORE                    writer_start;
+    UCHAR                           writer_stack[UX_DEMO_STACK_SIZE];
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    UX_HOST_CLASS_CDC_ACM_RECEPTION reception;
+#endif
+    UCHAR                           buffer[SERIAL_BENCHMARK_BLOCK_SIZE * SERIAL_BENCHMARK_BLOCK_COUNT];
+} SERIAL_BENCHMARK_PORT;
+
+static SERIAL_BENCHMARK_PORT                serial_benchmark_ports[SERIAL_BENCHMARK_MAX_PORTS];
+static TX_SEMAPHORE                         serial_benchmark_done;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static TX_EVENT_FLAGS_GROUP                 serial_benchmark_events;
+#endif
+
+/* Data is a byte counter, any offset in the stream is found at offset & 0xFF.  */
+static UCHAR                                serial_benchmark_pattern[SERIAL_BENCHMARK_WRITE_SIZE + 256];
+
+static TX_THREAD                            thread_host;
+static UCHAR                                thread_stack_host[UX_DEMO_STACK_SIZE];
+static UX_SLAVE_CLASS_CDC_ACM_PARAMETER     cdc_acm_parameter;
+
+static UCHAR                                device_framework_full_speed[SERIAL_BENCHMARK_FRAMEWORK_SIZE];
+static UCHAR                                device_framework_high_speed[SERIAL_BENCHMARK_FRAMEWORK_SIZE];
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "Express Logic" */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 - "EL Composite device" */
+        0x09, 0x04, 0x02, 0x13,
+        0x45, 0x4c, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+        0x73, 0x69, 0x74, 0x65, 0x20, 0x64, 0x65, 0x76,
+        0x69, 0x63, 0x65,
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+/* Define local prototypes and definitions.  */
+static void thread_entry_host(ULONG arg);
+
+/* Prototype for test control return.  */
+void  test_control_return(UINT status);
+
+static ULONG serial_benchmark_time_us(void)
+{
+
+struct timeval  now;
+
+    gettimeofday(&now, UX_NULL);
+    return((ULONG)now.tv_sec * 1000000ul + (ULONG)now.tv_usec);
+}
+
+static ULONG serial_benchmark_cpu_us(void)
+{
+
+    return((ULONG)((unsigned long long)clock() * 1000000ull / CLOCKS_PER_SEC));
+}
+
+static ULONG serial_benchmark_framework_build(UCHAR *framework, UCHAR high_speed)
+{
+
+static UCHAR        function[SERIAL_BENCHMARK_FUNCTION_LENGTH] = {
+
+    /* Interface association descriptor.  */
+    0x08, 0x0b, 0x00, 0x02, 0x02, 0x02, 0x00, 0x00,
+
+    /* Communication Class Interface Descriptor.  */
+    0x09, 0x04, 0x00, 0x00, 0x01, 0x02, 0x02, 0x01, 0x00,
+
+    /* Header, ACM, Union and Call Management Functional Descriptors.  */
+    0x05, 0x24, 0x00, 0x10, 0x01,
+    0x04, 0x24, 0x02, 0x0f,
+    0x05, 0x24, 0x06, 0x00, 0x01,
+    0x05, 0x24, 0x01, 0x03, 0x01,
+
+    /* Interrupt IN endpoint.  */
+    0x07, 0x05, 0x81, 0x03, 0x08, 0x00, 0xFF,
+
+    /* Data Class Interface Descriptor.  */
+    0x09, 0x04, 0x01, 0x00, 0x02, 0x0A, 0x00, 0x00, 0x00,
+
+    /* Bulk OUT and bulk IN endpoints.  */
+    0x07, 0x05, 0x02, 0x02, SERIAL_BENCHMARK_PACKET_SIZE, 0x00, 0x00,
+    0x07, 0x05, 0x83, 0x02, SERIAL_BENCHMARK_PACKET_SIZE, 0x00, 0x00,
+};
+static UCHAR        device[] = {
+    0x12, 0x01, 0x10, 0x01, 0xEF, 0x02, 0x01, 0x08,
+    0x84, 0x84, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x01
+};
+static UCHAR        qualifier[] = {
+    0x0a, 0x06, 0x00, 0x02, 0x02, 0x00, 0x00, 0x40, 0x01, 0x00
+};
+UCHAR               *configuration;
+UCHAR               *descriptor;
+ULONG               length;
+ULONG               port;
+
+
+    /* Device descriptor, with the qualifier in high speed.  */
+    _ux_utility_memory_copy(framework, device, sizeof(device));
+    length = sizeof(device);
+    if (high_speed)
+    {
+        framework[2] = 0x00;
+        framework[3] = 0x02;
+        framework[7] = 0x40;
+        _ux_utility_memory_copy(framework + length, qualifier, sizeof(qualifier));
+        length += sizeof(qualifier);
+    }
+
+    /* Configuration descriptor, completed when all functions are added.  */
+    configuration = framework + length;
+    length += 9;
+
+    /* Each port owns interfaces 2 * port and 2 * port + 1, endpoints 3 * port + 1 to 3 * port + 3.  */
+    for (port = 0; port < SERIAL_BENCHMARK_MAX_PORTS; port ++)
+    {
+        descriptor = framework + length;
+        _ux_utility_memory_copy(descriptor, function, sizeof(function));
+        descriptor[2] = (UCHAR)(port * 2);
+        descriptor[8 + 2] = (UCHAR)(port * 2);
+        descriptor[17 + 5 + 4 + 3] = (UCHAR)(port * 2);
+        descriptor[17 + 5 + 4 + 4] = (UCHAR)(port * 2 + 1);
+        descriptor[17 + 5 + 4 + 5 + 4] = (UCHAR)(port * 2 + 1);
+        descriptor[36 + 2] = (UCHAR)(0x80 | (port * 3 + 1));
+        descriptor[43 + 2] = (UCHAR)(port * 2 + 1);
+        descriptor[52 + 2] = (UCHAR)(port * 3 + 2);
+        descriptor[59 + 2] = (UCHAR)(0x80 | (port * 3 + 3));
+        length += sizeof(function);
+    }
+
+    configuration[0] = 0x09;
+    configuration[1] = 0x02;
+    configuration[2] = (UCHAR)(framework + length - configuration);
+    configuration[3] = (UCHAR)((framework + length - configuration) >> 8);
+    configuration[4] = (UCHAR)(SERIAL_BENCHMARK_MAX_PORTS * 2);
+    configuration[5] = 0x01;
+    configuration[6] = 0x00;
+    configuration[7] = 0x40;
+    configuration[8] = 0x00;
+    return(length);
+}
+
+static VOID serial_benchmark_instance_activate(VOID *cdc_instance)
+{
+
+UX_SLAVE_CLASS_CDC_ACM  *cdc_acm = (UX_SLAVE_CLASS_CDC_ACM *) cdc_instance;
+
+    /* The port is found from the interface number.  */
+    serial_benchmark_ports[cdc_acm -> ux_slave_class_cdc_acm_interface -> ux_slave_interface_descriptor.bInterfaceNumber / 2].device = cdc_acm;
+}
+
+static VOID serial_benchmark_instance_deactivate(VOID *cdc_instance)
+{
+
+UX_SLAVE_CLASS_CDC_ACM  *cdc_acm = (UX_SLAVE_CLASS_CDC_ACM *) cdc_instance;
+
+    serial_benchmark_ports[cdc_acm -> ux_slave_class_cdc_acm_interface -> ux_slave_interface_descriptor.bInterfaceNumber / 2].device = UX_NULL;
+}
+
+static void serial_benchmark_check(SERIAL_BENCHMARK_PORT *port, UCHAR *data, ULONG length)
+{
+
+    /* Data goes on from the bytes already received.  */
+    UX_TEST_ASSERT(port -> received + length <= SERIAL_BENCHMARK_BYTES_PER_PORT);
+    UX_TEST_ASSERT(ux_utility_memory_compare(data, serial_benchmark_pattern + (port -> received & 0xFF), length) == UX_SUCCESS);
+    port -> received += length;
+}
+
+static void serial_benchmark_writer_entry(ULONG arg)
+{
+
+SERIAL_BENCHMARK_PORT   *port = &serial_benchmark_ports[arg];
+ULONG                   offset;
+ULONG                   actual_length;
+
+    while (1)
+    {
+
+        /* Write all data of a run.  */
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_get(&port -> writer_start, TX_WAIT_FOREVER));
+        for (offset = 0; offset < SERIAL_BENCHMARK_BYTES_PER_PORT; offset += actual_length)
+        {
+            UX_TEST_CHECK_SUCCESS(ux_device_class_cdc_acm_write(port -> device, serial_benchmark_pattern + (offset & 0xFF),
+                                                                SERIAL_BENCHMARK_WRITE_SIZE, &actual_length));
+            UX_TEST_ASSERT(actual_length == SERIAL_BENCHMARK_WRITE_SIZE);
+        }
+    }
+}
+
+static void serial_benchmark_reader_entry(ULONG arg)
+{
+
+SERIAL_BENCHMARK_PORT   *port = &serial_benchmark_ports[arg];
+ULONG                   actual_length;
+
+    while (1)
+    {
+
+        /* Read until all data of a run is received, the thread is woken up for each block.  */
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_get(&port -> reader_start, TX_WAIT_FOREVER));
+        while (port -> received < SERIAL_BENCHMARK_BYTES_PER_PORT)
+        {
+            UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_read(port -> host, port -> buffer, SERIAL_BENCHMARK_BLOCK_SIZE, &actual_length));
+            serial_benchmark_check(port, port -> buffer, actual_length);
+            port -> wakeups ++;
+        }
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_put(&serial_benchmark_done));
+    }
+}
+
+static void serial_benchmark_report(CHAR *mode, ULONG ports, ULONG elapsed_us, ULONG cpu_us)
+{
+
+ULONG       port;
+ULONG       wakeups = 0;
+double      kbytes;
+
+    for (port = 0; port < ports; port ++)
+        wakeups += serial_benchmark_ports[port].wakeups;
+    kbytes = (double)(SERIAL_BENCHMARK_BYTES_PER_PORT * ports) / 1024;
+    printf("  %-8s ports %lu: %7lu bytes %8.3f Mbit/s %9.1f cpu us/KB %7.2f wakeups/KB\n",
+           mode, ports, SERIAL_BENCHMARK_BYTES_PER_PORT * ports,
+           elapsed_us ? (double)(SERIAL_BENCHMARK_BYTES_PER_PORT * ports) * 8 / elapsed_us : 0,
+           (double)cpu_us / kbytes, (double)wakeups / kbytes);
+}
+
+static void serial_benchmark_run_per_port(ULONG ports)
+{
+
+ULONG       port;
+ULONG       start_us;
+ULONG       start_cpu_us;
+
+    for (port = 0; port < ports; port ++)
+    {
+        serial_benchmark_ports[port].received = 0;
+        serial_benchmark_ports[port].wakeups = 0;
+    }
+
+    /* One thread per port reads, the device writes on all ports.  */
+    start_us = serial_benchmark_time_us();
+    start_cpu_us = serial_benchmark_cpu_us();
+    for (port = 0; port < ports; port ++)
+    {
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_put(&serial_benchmark_ports[port].reader_start));
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_put(&serial_benchmark_ports[port].writer_start));
+    }
+    for (port = 0; port < ports; port ++)
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_get(&serial_benchmark_done, UX_MS_TO_TICK(SERIAL_BENCHMARK_TIMEOUT_MS)));
+
+    serial_benchmark_report("per-port", ports, serial_benchmark_time_us() - start_us, serial_benchmark_cpu_us() - start_cpu_us);
+}
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static void serial_benchmark_run_shared(ULONG ports)
+{
+
+SERIAL_BENCHMARK_PORT   *port;
+ULONG                   index;
+ULONG                   pending;
+ULONG                   flags;
+ULONG                   start_us;
+ULONG                   start_cpu_us;
+UCHAR                   *span_buffer;
+ULONG                   span_length;
+
+    /* The receptions of all ports notify the same event flags group, one flag per port.  */
+    UX_TEST_CHECK_SUCCESS(tx_event_flags_set(&serial_benchmark_events, 0, TX_AND));
+    pending = 0;
+    for (index = 0; index < ports; index ++)
+    {
+        port = &serial_benchmark_ports[index];
+        port -> received = 0;
+        port -> wakeups = 0;
+        ux_utility_memory_set(&port -> reception, 0, sizeof(port -> reception));
+        port -> reception.ux_host_class_cdc_acm_reception_block_size = SERIAL_BENCHMARK_BLOCK_SIZE;
+        port -> reception.ux_host_class_cdc_acm_reception_data_buffer = port -> buffer;
+        port -> reception.ux_host_class_cdc_acm_reception_data_buffer_size = sizeof(port -> buffer);
+        port -> reception.ux_host_class_cdc_acm_reception_transfer_count = SERIAL_BENCHMARK_TRANSFER_COUNT;
+        port -> reception.ux_host_class_cdc_acm_reception_event_flags_group = &serial_benchmark_events;
+        port -> reception.ux_host_class_cdc_acm_reception_event_flags = 1ul << index;
+        UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_start(port -> host, &port -> reception));
+        pending |= 1ul << index;
+    }
+
+    /* One thread serves all ports, it is woken up when data comes in an empty buffer.  */
+    start_us = serial_benchmark_time_us();
+    start_cpu_us = serial_benchmark_cpu_us();
+    for (index = 0; index < ports; index ++)
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_put(&serial_benchmark_ports[index].writer_start));
+    while (pending)
+    {
+        UX_TEST_CHECK_SUCCESS(tx_event_flags_get(&serial_benchmark_events, pending, TX_OR_CLEAR, &flags,
+                                                 UX_MS_TO_TICK(SERIAL_BENCHMARK_TIMEOUT_MS)));
+
+        /* The wakeups of the thread serving all ports are counted on the first one.  */
+        serial_benchmark_ports[0].wakeups ++;
+        for (index = 0; index < ports; index ++)
+        {
+            if ((flags & (1ul << index)) == 0)
+                continue;
+
+            /* Take all data received in place, the port is notified again once empty.  */
+            port = &serial_benchmark_ports[index];
+            do
+            {
+                UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_get(port -> host, &span_buffer, &span_length));
+                serial_benchmark_check(port, span_buffer, span_length);
+                UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_span_release(port -> host, span_length));
+            } while (span_length != 0);
+            if (port -> received == SERIAL_BENCHMARK_BYTES_PER_PORT)
+                pending &= ~(1ul << index);
+        }
+    }
+
+    serial_benchmark_report("shared", ports, serial_benchmark_time_us() - start_us, serial_benchmark_cpu_us() - start_cpu_us);
+
+    for (index = 0; index < ports; index ++)
+        UX_TEST_CHECK_SUCCESS(ux_host_class_cdc_acm_reception_stop(serial_benchmark_ports[index].host,
+                                                                   &serial_benchmark_ports[index].reception));
+}
+#endif
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_acm_host_serial_scale_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+CHAR    *memory_pointer = first_unused_memory;
+ULONG   framework_length_full_speed;
+ULONG   framework_length_high_speed;
+ULONG   index;
+
+    /* Inform user.  */
+    printf("Running CDC-ACM Host Serial Scale Benchmark......................... ");
+    stepinfo("\n");
+
+    for (index = 0; index < sizeof(serial_benchmark_pattern); index ++)
+        serial_benchmark_pattern[index] = (UCHAR)index;
+    framework_length_full_speed = serial_benchmark_framework_build(device_framework_full_speed, UX_FALSE);
+    framework_length_high_speed = serial_benchmark_framework_build(device_framework_high_speed, UX_TRUE);
+
+    /* Initialize USBX Memory. */
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(memory_pointer, UX_USBX_MEMORY_SIZE, UX_NULL, 0));
+
+    /* Register the error callback. */
+    ux_utility_error_callback_register(ux_test_error_callback);
+
+    /* The code below is required for installing the host portion of USBX. */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_initialize(UX_NULL));
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_class_register(_ux_system_host_class_cdc_acm_name, ux_host_class_cdc_acm_entry));
+
+    /* The code below is required for installing the device portion of USBX. */
+    UX_TEST_CHECK_SUCCESS(ux_device_stack_initialize(device_framework_high_speed, framework_length_high_speed,
+                                                     device_framework_full_speed, framework_length_full_speed,
+                                                     string_framework, sizeof(string_framework),
+                                                     language_id_framework, sizeof(language_id_framework), UX_NULL));
+
+    /* One device CDC-ACM function per port, each owns two interfaces.  */
+    cdc_acm_parameter.ux_slave_class_cdc_acm_instance_activate   =  serial_benchmark_instance_activate;
+    cdc_acm_parameter.ux_slave_class_cdc_acm_instance_deactivate =  serial_benchmark_instance_deactivate;
+    for (index = 0; index < SERIAL_BENCHMARK_MAX_PORTS; index ++)
+        UX_TEST_CHECK_SUCCESS(ux_device_stack_class_register(_ux_system_slave_class_cdc_acm_name, ux_device_class_cdc_acm_entry,
+                                                             1, index * 2, &cdc_acm_parameter));
+
+    /* Initialize the simulated device and host controllers.  */
+    UX_TEST_CHECK_SUCCESS(_ux_dcd_sim_slave_initialize());
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_test_hcd_sim_host_initialize, 0, 0));
+
+    /* Create the reader and writer threads of ports.  */
+    UX_TEST_CHECK_SUCCESS(tx_semaphore_create(&serial_benchmark_done, "done", 0));
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    UX_TEST_CHECK_SUCCESS(tx_event_flags_create(&serial_benchmark_events, "ports"));
+#endif
+    for (index = 0; index < SERIAL_BENCHMARK_MAX_PORTS; index ++)
+    {
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_create(&serial_benchmark_ports[index].reader_start, "reader", 0));
+        UX_TEST_CHECK_SUCCESS(tx_semaphore_create(&serial_benchmark_ports[index].writer_start, "writer", 0));
+        UX_TEST_CHECK_SUCCESS(tx_thread_create(&serial_benchmark_ports[index].reader_thread, "reader thread",
+                                               serial_benchmark_reader_entry, index,
+                                               serial_benchmark_ports[index].reader_stack, UX_DEMO_STACK_SIZE,
+                                               20, 20, 1, TX_AUTO_START));
+        UX_TEST_CHECK_SUCCESS(tx_thread_create(&serial_benchmark_ports[index].writer_thread, "writer thread",
+                                               serial_benchmark_writer_entry, index,
+                                               serial_benchmark_ports[index].writer_stack, UX_DEMO_STACK_SIZE,
+                                               20, 20, 1, TX_AUTO_START));
+    }
+
+    /* Create the host thread. */
+    UX_TEST_CHECK_SUCCESS(tx_thread_create(&thread_host, "host thread", thread_entry_host, 0,
+                                           thread_stack_host, UX_DEMO_STACK_SIZE,
+                                           20, 20, 1, TX_AUTO_START));
+}
+
+static void thread_entry_host(ULONG arg)
+{
+
+UX_HOST_CLASS           *class;
+UX_HOST_CLASS_CDC_ACM   *cdc_acm;
+UX_INTERFACE            *interface;
+ULONG                   index;
+ULONG                   ports;
+
+    /* Wait for the data interfaces of all ports on host and device.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_class_get(_ux_system_host_class_cdc_acm_name, &class));
+    for (index = 0; index < SERIAL_BENCHMARK_MAX_PORTS * 2; index ++)
+    {
+        while (ux_host_stack_class_instance_get(class, index, (VOID **) &cdc_acm) != UX_SUCCESS)
+            tx_thread_sleep(10);
+        while (cdc_acm -> ux_host_class_cdc_acm_state != UX_HOST_CLASS_INSTANCE_LIVE)
+            tx_thread_sleep(10);
+        interface = cdc_acm -> ux_host_class_cdc_acm_interface;
+        if (interface -> ux_interface_descriptor.bInterfaceClass == UX_HOST_CLASS_CDC_DATA_CLASS)
+            serial_benchmark_ports[interface -> ux_interface_descriptor.bInterfaceNumber / 2].host = cdc_acm;
+    }
+    for (index = 0; index < SERIAL_BENCHMARK_MAX_PORTS; index ++)
+    {
+        UX_TEST_ASSERT(serial_benchmark_ports[index].host != UX_NULL);
+        UX_TEST_CHECK_SUCCESS(ux_test_wait_for_non_null((VOID **)&serial_benchmark_ports[index].device));
+    }
+
+    /* Run with more and more ports.  */
+    printf("\n");
+    for (ports = 1; ports <= SERIAL_BENCHMARK_MAX_PORTS; ports ++)
+    {
+        serial_benchmark_run_per_port(ports);
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+        serial_benchmark_run_shared(ports);
+#endif
+    }
+
+    /* Disconnect. */
+    ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
@@ -0,0 +1,104 @@
+/* This tests the network driver packet lend: NX packets are lent to the
+   device CDC-ECM class as bulk OUT transfer buffer with the IP header
+   aligned, and packets that can not hold the transfer buffer are refused. */
+
+#include "usbx_ux_test_cdc_ecm.h"
+
+/* RNDIS message header length, to check alignment with a class header.  */
+#define RNDIS_PACKET_HEADER_LENGTH      44
+
+static UCHAR        device_is_finished;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_ecm_device_packet_lend_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ECM Device Packet Lend Test............................. ");
+    stepinfo("\n");
+#if !defined(UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_ecm_initialize(first_unused_memory);
+}
+
+#if defined(UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND)
+static void packet_lend_test(ULONG header_length)
+{
+
+NX_PACKET       *packet;
+ULONG           available;
+
+
+    available = ip_pool_device.nx_packet_pool_available;
+
+    /* Lent packet holds the buffer and aligns the IP header.  */
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_packet_lend(&ip_pool_device, header_length,
+                                                         UX_DEVICE_CLASS_CDC_ECM_BULKOUT_BUFFER_SIZE,
+                                                         &packet, NX_NO_WAIT));
+    UX_TEST_ASSERT(((ALIGN_TYPE)(packet -> nx_packet_prepend_ptr + header_length + NX_ETHERNET_SIZE) & 0x3) == 0);
+    UX_TEST_ASSERT(packet -> nx_packet_append_ptr == packet -> nx_packet_prepend_ptr);
+    UX_TEST_ASSERT(packet -> nx_packet_length == 0);
+    UX_TEST_ASSERT((ULONG)(packet -> nx_packet_data_end - packet -> nx_packet_prepend_ptr) >=
+                   UX_DEVICE_CLASS_CDC_ECM_BULKOUT_BUFFER_SIZE);
+    nx_packet_release(packet);
+
+    /* Buffer larger than payload is refused, no packet is consumed.  */
+    UX_TEST_ASSERT(_ux_network_driver_packet_lend(&ip_pool_device, header_length,
+                                                  ip_pool_device.nx_packet_pool_payload_size + 1,
+                                                  &packet, NX_NO_WAIT) == UX_BUFFER_OVERFLOW);
+    UX_TEST_ASSERT(ip_pool_device.nx_packet_pool_available == available);
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND)
+
+UX_SLAVE_TRANSFER   *transfer_request;
+
+
+    /* Lend for ECM and RNDIS framing.  */
+    packet_lend_test(0);
+    packet_lend_test(RNDIS_PACKET_HEADER_LENGTH);
+
+    stepinfo("running TCP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_TCP);
+
+    stepinfo("running UDP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_UDP);
+
+    /* Wait for device to finish.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_uchar(&device_is_finished, UX_TRUE));
+
+    /* The pending reception is in a lent packet, not in the endpoint buffer.  */
+    transfer_request = &cdc_ecm_device -> ux_slave_class_cdc_ecm_bulkout_endpoint -> ux_slave_endpoint_transfer_request;
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&transfer_request -> ux_slave_transfer_request_status, UX_TRANSFER_STATUS_PENDING));
+    UX_TEST_ASSERT(transfer_request -> ux_slave_transfer_request_data_pointer != UX_DEVICE_CLASS_CDC_ECM_BULKOUT_BUFFER(cdc_ecm_device));
+    UX_TEST_ASSERT(transfer_request -> ux_slave_transfer_request_data_pointer ==
+                   cdc_ecm_device -> ux_slave_class_cdc_ecm_receive_queue -> nx_packet_prepend_ptr);
+
+    /* Disconnect and reconnect, the lent packet must be released.  */
+    ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+    ux_test_connect_slave_and_host_wait_for_enum_completion();
+    class_cdc_ecm_get_host();
+#endif
+}
+
+static void post_init_device()
+{
+#if defined(UX_DEVICE_CLASS_CDC_ECM_PACKET_LEND)
+
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_TCP);
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_UDP);
+#endif
+
+    device_is_finished = UX_TRUE;
+}
@@ -0,0 +1,120 @@
+/* This tests the CDC-ECM host bulk IN transfer ring: all the ring transfer
+   requests are kept armed while traffic runs, and are released on link down
+   and on disconnection. */
+
+#include "usbx_ux_test_cdc_ecm.h"
+
+static UCHAR        device_is_finished;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_ecm_host_bulk_in_ring_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ECM Host Bulk IN Ring Test.............................. ");
+    stepinfo("\n");
+#if !defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_ecm_initialize(first_unused_memory);
+}
+
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+static ULONG ring_armed_count(void)
+{
+
+ULONG       slot;
+ULONG       armed = 0;
+UX_TRANSFER *transfer_request;
+
+
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT; slot ++)
+    {
+        transfer_request = &cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_in_transfer_requests[slot];
+        if (transfer_request -> ux_transfer_request_user_specific != UX_NULL)
+        {
+
+            /* Armed slot must be pending, and receive in its own packet.  */
+            UX_TEST_ASSERT(transfer_request -> ux_transfer_request_completion_code == UX_TRANSFER_STATUS_PENDING);
+            UX_TEST_ASSERT(transfer_request -> ux_transfer_request_data_pointer ==
+                           ((NX_PACKET *)transfer_request -> ux_transfer_request_user_specific) -> nx_packet_prepend_ptr);
+            armed ++;
+        }
+    }
+    return(armed);
+}
+
+static void ring_wait_armed(ULONG expected)
+{
+
+ULONG       wait_ms = 0;
+
+
+    while (ring_armed_count() != expected)
+    {
+        UX_TEST_ASSERT(wait_ms < 2000);
+        tx_thread_sleep(1);
+        wait_ms += 10;
+    }
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+
+    /* The whole ring is armed once the link is up.  */
+    ring_wait_armed(UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT);
+
+    /* The single transfer reception is not used.  */
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_in_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_completion_code != UX_TRANSFER_STATUS_PENDING);
+
+    stepinfo("running TCP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_TCP);
+
+    stepinfo("running UDP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_UDP);
+
+    /* Wait for device to finish.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_uchar(&device_is_finished, UX_TRUE));
+
+    /* Slots are re-armed after each frame.  */
+    ring_wait_armed(UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT);
+
+    /* Link down releases all the slots.  */
+    stepinfo("link down.\n");
+    ux_test_device_class_cdc_ecm_set_link_state(cdc_ecm_device, UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_DOWN);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&cdc_ecm_host -> ux_host_class_cdc_ecm_link_state, UX_HOST_CLASS_CDC_ECM_LINK_STATE_DOWN));
+    ring_wait_armed(0);
+
+    /* Link up arms the ring again.  */
+    stepinfo("link up.\n");
+    ux_test_device_class_cdc_ecm_set_link_state(cdc_ecm_device, UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_UP);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&cdc_ecm_host -> ux_host_class_cdc_ecm_link_state, UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP));
+    ring_wait_armed(UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT);
+
+    /* Disconnect and reconnect, packets owned by the ring must be released.  */
+    ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+    ux_test_connect_slave_and_host_wait_for_enum_completion();
+    class_cdc_ecm_get_host();
+    ring_wait_armed(UX_HOST_CLASS_CDC_ECM_BULK_IN_TRANSFER_REQUEST_COUNT);
+#endif
+}
+
+static void post_init_device()
+{
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_IN_RING)
+
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_TCP);
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_UDP);
+#endif
+
+    device_is_finished = UX_TRUE;
+}
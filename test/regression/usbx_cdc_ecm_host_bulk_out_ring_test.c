@@ -0,0 +1,268 @@
+/* This tests the CDC-ECM host bulk OUT transfer ring: queued packets are
+   sent on several transfer requests at once and in order, a frame that needs
+   a ZLP is sent alone, a failed transfer or arm is dropped without stalling
+   the ring, the transmit queue depth is limited, and the ring is released on
+   link down. */
+
+#include "usbx_ux_test_cdc_ecm.h"
+
+#define RING_TEST_BURST_PACKETS     (UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT * 2)
+#define RING_TEST_ZLP_FRAME_LENGTH  1024
+#define RING_TEST_HEADERS_LENGTH    (UX_HOST_CLASS_CDC_ECM_ETHERNET_SIZE + 20 + 8)
+
+static UCHAR        device_is_finished;
+static UCHAR        ring_error_inject;
+static ULONG        ring_error_busy;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_ecm_host_bulk_out_ring_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ECM Host Bulk OUT Ring Test............................. ");
+    stepinfo("\n");
+#if !defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_ecm_initialize(first_unused_memory);
+}
+
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+static void ring_send_udp(ULONG length, UCHAR tag)
+{
+
+NX_PACKET   *packet;
+static UCHAR buffer[RING_TEST_ZLP_FRAME_LENGTH];
+
+
+    ux_utility_memory_set(buffer, tag, length);
+    UX_TEST_CHECK_SUCCESS(nx_packet_allocate(&packet_pool_host, &packet, NX_UDP_PACKET, NX_WAIT_FOREVER));
+    UX_TEST_CHECK_SUCCESS(nx_packet_data_append(packet, buffer, length, &packet_pool_host, NX_WAIT_FOREVER));
+    UX_TEST_CHECK_SUCCESS(nx_udp_socket_send(&udp_socket_host, packet, DEVICE_IP_ADDRESS, DEVICE_SOCKET_PORT_UDP));
+}
+
+static void ring_receive_udp(ULONG length, UCHAR tag)
+{
+
+NX_PACKET   *packet;
+
+
+    UX_TEST_CHECK_SUCCESS(nx_udp_socket_receive(&udp_socket_device, &packet, MS_TO_TICK(2000)));
+    UX_TEST_ASSERT(packet -> nx_packet_length == length);
+    UX_TEST_ASSERT(packet -> nx_packet_prepend_ptr[0] == tag);
+    UX_TEST_ASSERT(packet -> nx_packet_prepend_ptr[length - 1] == tag);
+    nx_packet_release(packet);
+}
+
+static void ring_wait_idle(void)
+{
+
+ULONG       wait_ms = 0;
+
+
+    while ((cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_busy != 0) ||
+           (cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_depth != 0))
+    {
+        UX_TEST_ASSERT(wait_ms < 2000);
+        tx_thread_sleep(1);
+        wait_ms += 10;
+    }
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_head == UX_NULL);
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_pending == UX_NULL);
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_zlp == UX_FALSE);
+}
+
+static void ring_drain_device(void)
+{
+
+NX_PACKET   *packet;
+
+
+    while (nx_udp_socket_receive(&udp_socket_device, &packet, MS_TO_TICK(100)) == NX_SUCCESS)
+        nx_packet_release(packet);
+}
+
+static VOID ring_error_callback(UX_TRANSFER *transfer_request)
+{
+
+    /* Fail one frame transfer while the next slots are armed behind it.  */
+    if ((ring_error_inject == UX_TRUE) &&
+        (cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_busy > 1) &&
+        (transfer_request -> ux_transfer_request_requested_length != 0))
+    {
+        ring_error_inject = UX_FALSE;
+        ring_error_busy = cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_busy;
+        transfer_request -> ux_transfer_request_completion_code = UX_TRANSFER_ERROR;
+    }
+
+    _ux_host_class_cdc_ecm_transmission_callback(transfer_request);
+}
+
+static void ring_completion_function_set(VOID (*completion_function)(UX_TRANSFER *))
+{
+
+ULONG       slot;
+
+
+    for (slot = 0; slot < UX_HOST_CLASS_CDC_ECM_BULK_OUT_TRANSFER_REQUEST_COUNT; slot ++)
+        cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[slot].ux_transfer_request_completion_function = completion_function;
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+
+ULONG       i;
+ULONG       zlp_length;
+NX_PACKET   *packet;
+UX_TEST_ACTION  arm_fail_action = {0};
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+ULONG       transfer_errors;
+USB_NETWORK_DEVICE_STATISTICS   statistics;
+#endif
+
+
+    stepinfo("running TCP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_TCP);
+
+    stepinfo("running UDP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_UDP);
+
+    /* Wait for device to finish.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_uchar(&device_is_finished, UX_TRUE));
+    ring_wait_idle();
+
+    /* A burst is sent on several transfer requests at once.  */
+    stepinfo("burst.\n");
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp(100 + i, (UCHAR)i);
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_busy > 1);
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_receive_udp(100 + i, (UCHAR)i);
+    ring_wait_idle();
+
+    /* Frames that need a ZLP are sent alone, frames stay in order.  */
+    stepinfo("ZLP frames.\n");
+    UX_TEST_ASSERT((RING_TEST_ZLP_FRAME_LENGTH % cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_requests[0].ux_transfer_request_packet_length) == 0);
+    zlp_length = RING_TEST_ZLP_FRAME_LENGTH - RING_TEST_HEADERS_LENGTH;
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp((i & 1) ? zlp_length : 100, (UCHAR)i);
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_receive_udp((i & 1) ? zlp_length : 100, (UCHAR)i);
+    ring_wait_idle();
+
+    /* A failed transfer drops its frame, the slots armed behind it go on.  */
+    stepinfo("transfer error.\n");
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(cdc_ecm_host -> ux_host_class_cdc_ecm_network_handle, &statistics));
+    transfer_errors = statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR];
+#endif
+    ring_completion_function_set(ring_error_callback);
+    ring_error_inject = UX_TRUE;
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp(100 + i, (UCHAR)i);
+    ring_wait_idle();
+    ring_completion_function_set(_ux_host_class_cdc_ecm_transmission_callback);
+    UX_TEST_ASSERT(ring_error_inject == UX_FALSE);
+    UX_TEST_ASSERT(ring_error_busy > 1);
+
+    /* The simulated device got the data of the failed transfer: every frame
+       is received once, in order, the failed one is not sent again.  */
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_receive_udp(100 + i, (UCHAR)i);
+    UX_TEST_ASSERT(nx_udp_socket_receive(&udp_socket_device, &packet, MS_TO_TICK(100)) == NX_NO_PACKET);
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(cdc_ecm_host -> ux_host_class_cdc_ecm_network_handle, &statistics));
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR] == transfer_errors + 1);
+#endif
+
+    /* The ring still works.  */
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp(100 + i, (UCHAR)i);
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_receive_udp(100 + i, (UCHAR)i);
+    ring_wait_idle();
+
+    /* A frame that can not be armed on an idle ring is dropped, it does not
+       stay pending waiting for another write.  */
+    stepinfo("arm error.\n");
+    arm_fail_action.usbx_function = UX_TEST_OVERRIDE_UX_HCD_SIM_HOST_ENTRY;
+    arm_fail_action.function = UX_HCD_TRANSFER_REQUEST;
+    arm_fail_action.req_action = UX_TEST_MATCH_EP;
+    arm_fail_action.req_ep_address = 0x02;
+    arm_fail_action.no_return = 0;
+    arm_fail_action.status = UX_ERROR;
+    ux_test_add_action_to_main_list(arm_fail_action);
+    ring_send_udp(100, 0xAA);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_empty_actions());
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_head == UX_NULL);
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_pending == UX_NULL);
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_depth == 0);
+    UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_bulk_out_transfer_busy == 0);
+    UX_TEST_ASSERT(nx_udp_socket_receive(&udp_socket_device, &packet, MS_TO_TICK(100)) == NX_NO_PACKET);
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(cdc_ecm_host -> ux_host_class_cdc_ecm_network_handle, &statistics));
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_TRANSFER_ERROR] == transfer_errors + 2);
+#endif
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp(100 + i, (UCHAR)i);
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_receive_udp(100 + i, (UCHAR)i);
+    ring_wait_idle();
+
+#if UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH > 0
+
+    /* The queue depth is limited, extra packets are rejected.  */
+    stepinfo("queue full.\n");
+    for (i = 0; i < UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH * 2; i ++)
+    {
+        ring_send_udp(64, (UCHAR)i);
+        UX_TEST_ASSERT(cdc_ecm_host -> ux_host_class_cdc_ecm_xmit_queue_depth <= UX_HOST_CLASS_CDC_ECM_XMIT_QUEUE_DEPTH);
+    }
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(cdc_ecm_host -> ux_host_class_cdc_ecm_network_handle, &statistics));
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_QUEUE_FULL] > 0);
+#endif
+    ring_wait_idle();
+    ring_drain_device();
+#endif
+
+    /* Link down releases the ring and the queue.  */
+    stepinfo("link down.\n");
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp(100, (UCHAR)i);
+    ux_test_device_class_cdc_ecm_set_link_state(cdc_ecm_device, UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_DOWN);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&cdc_ecm_host -> ux_host_class_cdc_ecm_link_state, UX_HOST_CLASS_CDC_ECM_LINK_STATE_DOWN));
+    ring_wait_idle();
+    ring_drain_device();
+
+    /* Link up, the ring works again.  */
+    stepinfo("link up.\n");
+    ux_test_device_class_cdc_ecm_set_link_state(cdc_ecm_device, UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_UP);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&cdc_ecm_host -> ux_host_class_cdc_ecm_link_state, UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP));
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_send_udp(200 + i, (UCHAR)i);
+    for (i = 0; i < RING_TEST_BURST_PACKETS; i ++)
+        ring_receive_udp(200 + i, (UCHAR)i);
+    ring_wait_idle();
+#endif
+}
+
+static void post_init_device()
+{
+#if defined(UX_HOST_CLASS_CDC_ECM_BULK_OUT_RING)
+
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_TCP);
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_UDP);
+#endif
+
+    device_is_finished = UX_TRUE;
+}
@@ -0,0 +1,54 @@
+/* This benchmarks USB networking between the device CDC-ECM class and the
+   host CDC-ECM class: UDP blast, TCP bulk and ping latency are measured
+   both ways, with full and with reduced receive packet pools.  */
+
+/* Open TCP windows for bulk transfers.  */
+#define TCP_WINDOW                          (1460 * 8)
+#define DEVICE_TCP_WINDOW                   (1460 * 8)
+
+#include "usbx_ux_test_cdc_ecm.h"
+#include "usbx_ux_test_network_benchmark.h"
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_ecm_network_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ECM Network Benchmark................................... ");
+    stepinfo("\n");
+
+    ux_test_cdc_ecm_initialize(first_unused_memory);
+}
+
+static void post_init_host()
+{
+
+NETWORK_BENCHMARK_PEER  host;
+NETWORK_BENCHMARK_PEER  device;
+
+    host.name = "host";
+    host.ip = &nx_ip_host;
+    host.ip_address = HOST_IP_ADDRESS;
+    host.packet_pool = &packet_pool_host;
+    host.udp_socket = &udp_socket_host;
+    host.udp_port = HOST_SOCKET_PORT_UDP;
+    host.tcp_socket = &tcp_socket_host;
+
+    device.name = "ecm";
+    device.ip = &nx_ip_device;
+    device.ip_address = DEVICE_IP_ADDRESS;
+    device.packet_pool = &packet_pool_device;
+    device.udp_socket = &udp_socket_device;
+    device.udp_port = DEVICE_SOCKET_PORT_UDP;
+    device.tcp_socket = &tcp_socket_device;
+
+    network_benchmark_run(&host, &device);
+}
+
+static void post_init_device()
+{
+}
@@ -0,0 +1,131 @@
+/* This tests the network driver traffic statistics: frames and bytes are
+   counted on both sides, transmit completions are logged with latency and
+   queue depth, and drops are counted with their reasons. */
+
+#include "usbx_ux_test_cdc_ecm.h"
+
+static UCHAR        device_is_finished;
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_cdc_ecm_network_statistics_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running CDC-ECM Network Statistics Test............................. ");
+    stepinfo("\n");
+#if !defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    ux_test_cdc_ecm_initialize(first_unused_memory);
+}
+
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+static void statistics_check(VOID *network_handle, NX_IP *ip_ptr)
+{
+
+USB_NETWORK_DEVICE_STATISTICS   statistics;
+ULONG                           latency_count = 0;
+ULONG                           value;
+ULONG                           i;
+
+
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(network_handle, &statistics));
+
+    /* Traffic is counted both ways.  */
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_frames > 0);
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_rx_frames > 0);
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_bytes >=
+                   statistics.ux_network_device_statistics_tx_frames * NX_ETHERNET_SIZE);
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_rx_bytes >=
+                   statistics.ux_network_device_statistics_rx_frames * NX_ETHERNET_SIZE);
+
+    /* All sent frames are completed.  */
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_queue_depth == 0);
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_queue_high_water > 0);
+    for (i = 0; i < USB_NETWORK_DEVICE_TX_LATENCY_BUCKETS; i ++)
+        latency_count += statistics.ux_network_device_statistics_tx_latency[i];
+    UX_TEST_ASSERT(latency_count <= statistics.ux_network_device_statistics_tx_frames);
+    UX_TEST_ASSERT(latency_count > 0);
+
+    /* Counters are reported through driver requests.  */
+    UX_TEST_CHECK_SUCCESS(nx_ip_driver_direct_command(ip_ptr, NX_LINK_GET_RX_COUNT, &value));
+    UX_TEST_ASSERT(value >= statistics.ux_network_device_statistics_rx_frames);
+    UX_TEST_CHECK_SUCCESS(nx_ip_driver_direct_command(ip_ptr, NX_LINK_GET_TX_COUNT, &value));
+    UX_TEST_ASSERT(value >= statistics.ux_network_device_statistics_tx_frames);
+
+    /* Reset clears the counters, late acknowledgements may still be counted.  */
+    value = statistics.ux_network_device_statistics_tx_frames;
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_reset(network_handle));
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(network_handle, &statistics));
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_frames < value);
+    UX_TEST_CHECK_SUCCESS(nx_ip_driver_direct_command(ip_ptr, NX_LINK_GET_ERROR_COUNT, &value));
+    UX_TEST_ASSERT(value == 0);
+}
+
+static void statistics_link_down_check(VOID *network_handle)
+{
+
+USB_NETWORK_DEVICE_STATISTICS   statistics;
+ULONG                           value;
+NX_PACKET                       *packet;
+
+
+    /* Frames sent while link is down are dropped and counted.  */
+    UX_TEST_CHECK_SUCCESS(nx_packet_allocate(&packet_pool_host, &packet, NX_UDP_PACKET, NX_NO_WAIT));
+    UX_TEST_CHECK_SUCCESS(nx_packet_data_append(packet, "statistics", 10, &packet_pool_host, NX_NO_WAIT));
+    UX_TEST_CHECK_SUCCESS(nx_udp_socket_send(&udp_socket_host, packet, DEVICE_IP_ADDRESS, DEVICE_SOCKET_PORT_UDP));
+
+    UX_TEST_CHECK_SUCCESS(_ux_network_driver_statistics_get(network_handle, &statistics));
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_drops[USB_NETWORK_DEVICE_DROP_LINK_DOWN] >= 1);
+    UX_TEST_ASSERT(statistics.ux_network_device_statistics_tx_queue_depth == 0);
+    UX_TEST_CHECK_SUCCESS(nx_ip_driver_direct_command(&nx_ip_host, NX_LINK_GET_ERROR_COUNT, &value));
+    UX_TEST_ASSERT(value >= 1);
+}
+#endif
+
+static void post_init_host()
+{
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+    stepinfo("running TCP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_TCP);
+
+    stepinfo("running UDP test.\n");
+    cdc_ecm_basic_test(BASIC_TEST_HOST, BASIC_TEST_UDP);
+
+    /* Wait for device to finish.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_uchar(&device_is_finished, UX_TRUE));
+
+    /* Check counters on both sides.  */
+    statistics_check(cdc_ecm_host -> ux_host_class_cdc_ecm_network_handle, &nx_ip_host);
+    statistics_check(cdc_ecm_device -> ux_slave_class_cdc_ecm_network_handle, &nx_ip_device);
+
+    /* Link down, then up.  */
+    stepinfo("link down.\n");
+    ux_test_device_class_cdc_ecm_set_link_state(cdc_ecm_device, UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_DOWN);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&cdc_ecm_host -> ux_host_class_cdc_ecm_link_state, UX_HOST_CLASS_CDC_ECM_LINK_STATE_DOWN));
+    statistics_link_down_check(cdc_ecm_host -> ux_host_class_cdc_ecm_network_handle);
+
+    stepinfo("link up.\n");
+    ux_test_device_class_cdc_ecm_set_link_state(cdc_ecm_device, UX_DEVICE_CLASS_CDC_ECM_LINK_STATE_UP);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&cdc_ecm_host -> ux_host_class_cdc_ecm_link_state, UX_HOST_CLASS_CDC_ECM_LINK_STATE_UP));
+#endif
+}
+
+static void post_init_device()
+{
+#if defined(UX_NETWORK_DRIVER_ENABLE_STATISTICS)
+
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_TCP);
+    cdc_ecm_basic_test(BASIC_TEST_DEVICE, BASIC_TEST_UDP);
+#endif
+
+    device_is_finished = UX_TRUE;
+}
@@ -0,0 +1,598 @@
+#include "usbx_test_common_hid.h"
+#include "ux_host_class_hid_keyboard.h"
+
+
+#define DUMMY_USBX_MEMORY_SIZE (64*1024)
+static UCHAR dummy_usbx_memory[DUMMY_USBX_MEMORY_SIZE];
+
+static UCHAR hid_report_descriptor[] = {
+
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x06,                    // USAGE (Keyboard)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x00,                    //   REPORT_ID (0)
+    0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
+    0x19, 0xe0,                    //   USAGE_MINIMUM (Keyboard LeftControl)
+    0x29, 0xe7,                    //   USAGE_MAXIMUM (Keyboard Right GUI)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x95, 0x08,                    //   REPORT_COUNT (8)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x81, 0x03,                    //   INPUT (Cnst,Var,Abs)
+    0x95, 0x05,                    //   REPORT_COUNT (5)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x05, 0x08,                    //   USAGE_PAGE (LEDs)
+    0x19, 0x01,                    //   USAGE_MINIMUM (Num Lock)
+    0x29, 0x05,                    //   USAGE_MAXIMUM (Kana)
+    0x91, 0x02,                    //   OUTPUT (Data,Var,Abs)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x03,                    //   REPORT_SIZE (3)
+    0x91, 0x03,                    //   OUTPUT (Cnst,Var,Abs)
+    0x95, 0x06,                    //   REPORT_COUNT (6)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x65,                    //   LOGICAL_MAXIMUM (101)
+    0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
+    0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
+    0x29, 0x65,                    //   USAGE_MAXIMUM (Keyboard Application)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0                           // END_COLLECTION
+};
+#define HID_REPORT_LENGTH sizeof(hid_report_descriptor)/sizeof(hid_report_descriptor[0])
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[DEVICE_FRAMEWORK_LENGTH_FULL_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+UINT  _ux_hcd_sim_host_entry(UX_HCD *hcd, UINT function, VOID *parameter);
+
+
+static UINT ux_system_host_change_function(ULONG a, UX_HOST_CLASS *b, VOID *c)
+{
+    return 0;
+}
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_device_hid_event_coalesce_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR *                          stack_pointer;
+CHAR *                          memory_pointer;
+
+
+    /* Inform user.  */
+    printf("Running Device HID Event Coalesce Test.............................. ");
+#if !defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE) || !defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX. Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(ux_system_host_change_function);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    status =  ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Register the HID client(s).  */
+    status =  ux_host_class_hid_client_register(_ux_system_host_class_hid_client_keyboard_name, ux_host_class_hid_keyboard_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_report_descriptor;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+    hid_parameter.ux_device_class_hid_parameter_report_id      = UX_TRUE;
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE)
+    hid_parameter.ux_device_class_hid_parameter_event_coalesce = UX_TRUE;
+#endif
+
+    /* Initilize the device hid class. The class is connected with interface 2 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                                1,2, (VOID *)&hid_parameter);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+}
+
+static UINT  event_queue(ULONG report_id, UCHAR data)
+{
+UX_SLAVE_CLASS_HID_EVENT        hid_event;
+
+    hid_event.ux_device_class_hid_event_report_id = report_id;
+    hid_event.ux_device_class_hid_event_report_type = UX_DEVICE_CLASS_HID_REPORT_TYPE_INPUT;
+    hid_event.ux_device_class_hid_event_length = 4;
+    ux_utility_memory_set(hid_event.ux_device_class_hid_event_buffer, data, 4);
+    return(_ux_device_class_hid_event_set(device_hid, &hid_event));
+}
+
+static UINT  event_expect(ULONG report_id, UCHAR data)
+{
+UX_SLAVE_CLASS_HID_EVENT        hid_event;
+UINT                            status;
+
+    status = _ux_device_class_hid_event_get(device_hid, &hid_event);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* Queued events start with the report ID.  */
+    if (hid_event.ux_device_class_hid_event_length != 5 ||
+        hid_event.ux_device_class_hid_event_buffer[0] != (UCHAR)report_id ||
+        hid_event.ux_device_class_hid_event_buffer[1] != data ||
+        hid_event.ux_device_class_hid_event_buffer[4] != data)
+        return(UX_ERROR);
+    return(UX_SUCCESS);
+}
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+#if defined(UX_DEVICE_CLASS_HID_EVENT_COALESCE) && defined(UX_DEVICE_CLASS_HID_EVENT_STATISTICS)
+UINT                                        status;
+UX_SLAVE_DEVICE                             *device;
+UX_SLAVE_INTERFACE                          *interface;
+UX_SLAVE_CLASS                              *slave_class;
+UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS  *statistics;
+UX_SLAVE_CLASS_HID_EVENT                    hid_event;
+ULONG                                       i;
+
+    /* Find the HID class */
+    status = demo_class_hid_get();
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Derive device hid class. */
+    device =  &_ux_system_slave -> ux_system_slave_device;
+    interface = device -> ux_slave_device_first_interface;
+    slave_class = interface -> ux_slave_interface_class;
+    device_hid = interface -> ux_slave_interface_class_instance;
+    statistics = &device_hid -> ux_device_class_hid_event_statistics;
+
+    /* Suspend the device interrupt thread so events stay in the queue.  */
+    status = ux_utility_thread_suspend(&slave_class -> ux_slave_class_thread);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    while(_ux_device_class_hid_event_get(device_hid, &hid_event) == UX_SUCCESS);
+    ux_utility_memory_set(statistics, 0, sizeof(UX_DEVICE_CLASS_HID_EVENT_QUEUE_STATISTICS));
+
+    /**************************************************/
+    /** Test case: newest event of a report wins.    **/
+    /**************************************************/
+
+    status  = event_queue(1, 0x11);
+    status |= event_queue(2, 0x21);
+    status |= event_queue(1, 0x12);
+    status |= event_queue(1, 0x13);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Report 2 first, its place is kept, then the last report 1.  */
+    status  = event_expect(2, 0x21);
+    status |= event_expect(1, 0x13);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    if (_ux_device_class_hid_event_get(device_hid, &hid_event) == UX_SUCCESS)
+    {
+
+        printf("Error on line %d, replaced event sent\n", __LINE__);
+        test_control_return(1);
+    }
+    if (statistics -> ux_device_class_hid_event_statistics_queued != 4 ||
+        statistics -> ux_device_class_hid_event_statistics_coalesced != 2 ||
+        statistics -> ux_device_class_hid_event_statistics_dropped != 0 ||
+        statistics -> ux_device_class_hid_event_statistics_depth_high_water != 4)
+    {
+
+        printf("Error on line %d, statistics %ld %ld %ld %ld\n", __LINE__,
+                statistics -> ux_device_class_hid_event_statistics_queued,
+                statistics -> ux_device_class_hid_event_statistics_coalesced,
+                statistics -> ux_device_class_hid_event_statistics_dropped,
+                statistics -> ux_device_class_hid_event_statistics_depth_high_water);
+        test_control_return(1);
+    }
+
+    /**************************************************/
+    /** Test case: all events sent without coalesce. **/
+    /**************************************************/
+
+    device_hid -> ux_device_class_hid_event_coalesce = UX_FALSE;
+    status  = event_queue(1, 0x14);
+    status |= event_queue(1, 0x15);
+    status |= event_expect(1, 0x14);
+    status |= event_expect(1, 0x15);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    device_hid -> ux_device_class_hid_event_coalesce = UX_TRUE;
+
+    /**************************************************/
+    /** Test case: full queue drops events.          **/
+    /**************************************************/
+
+    for (i = 0; i < UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1; i ++)
+    {
+        status = event_queue(3 + i, (UCHAR)i);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+    }
+    if (event_queue(3 + i, (UCHAR)i) != UX_ERROR ||
+        statistics -> ux_device_class_hid_event_statistics_dropped != 1 ||
+        statistics -> ux_device_class_hid_event_statistics_depth_high_water != UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1)
+    {
+
+        printf("Error on line %d, full queue not reported\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* In a full queue, the newest pending event of the report is replaced.  */
+    if (event_queue(5, 0x52) != UX_SUCCESS ||
+        statistics -> ux_device_class_hid_event_statistics_coalesced != 3 ||
+        statistics -> ux_device_class_hid_event_statistics_dropped != 1)
+    {
+
+        printf("Error on line %d, pending event not replaced\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The event at the tail may be being sent, it is not replaced.  */
+    if (event_queue(3, 0x31) != UX_ERROR ||
+        statistics -> ux_device_class_hid_event_statistics_coalesced != 3 ||
+        statistics -> ux_device_class_hid_event_statistics_dropped != 2)
+    {
+
+        printf("Error on line %d, event at the tail replaced\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* A pending report is still replaced in a full queue.  */
+    status  = event_expect(3, 0);
+    status |= event_queue(4, 0x41);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    for (i = 2; i < UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1; i ++)
+    {
+        status = event_expect(3 + i, (i == 2) ? 0x52 : (UCHAR)i);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+    }
+    if (event_expect(4, 0x41) != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, replacing event lost\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /**************************************************/
+    /** Test case: full queue skips older events.    **/
+    /**************************************************/
+
+    /* Fill the queue with reports 7 and 8 without coalesce.  */
+    device_hid -> ux_device_class_hid_event_coalesce = UX_FALSE;
+    for (i = 0; i < UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1; i ++)
+    {
+        status = event_queue((i & 1) ? 8 : 7, (UCHAR)i);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+    }
+    device_hid -> ux_device_class_hid_event_coalesce = UX_TRUE;
+
+    /* The newest report 7 is replaced, the older ones (tail included) are skipped.  */
+    if (event_queue(7, 0x7F) != UX_SUCCESS ||
+        statistics -> ux_device_class_hid_event_statistics_coalesced != 3 + (UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1) / 2 + 1)
+    {
+
+        printf("Error on line %d, coalesced %ld\n", __LINE__, statistics -> ux_device_class_hid_event_statistics_coalesced);
+        test_control_return(1);
+    }
+    for (i = 0; i < UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1; i ++)
+    {
+        if (i & 1)
+            status = event_expect(8, (UCHAR)i);
+        else if (i + 2 >= UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE - 1)
+            status = event_expect(7, 0x7F);
+        else
+            continue;
+        if (status != UX_SUCCESS)
+        {
+
+            printf("Error on line %d, error code: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+    }
+    if (_ux_device_class_hid_event_get(device_hid, &hid_event) == UX_SUCCESS)
+    {
+
+        printf("Error on line %d, skipped event sent\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* An event being written is not sent until it is published.  */
+    event_queue(9, 0x91);
+    device_hid -> ux_device_class_hid_event_array_tail -> ux_device_class_hid_event_report_id = UX_DEVICE_CLASS_HID_EVENT_WRITING;
+    if (_ux_device_class_hid_event_get(device_hid, &hid_event) == UX_SUCCESS)
+    {
+
+        printf("Error on line %d, event being written sent\n", __LINE__);
+        test_control_return(1);
+    }
+    device_hid -> ux_device_class_hid_event_array_tail -> ux_device_class_hid_event_report_id = 9;
+    if (event_expect(9, 0x91) != UX_SUCCESS)
+    {
+
+        printf("Error on line %d, written event lost\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /**************************************************/
+    /** Test case: event age when sent.              **/
+    /**************************************************/
+
+    event_queue(1, 0x16);
+    tx_thread_sleep(5);
+    if (event_expect(1, 0x16) != UX_SUCCESS ||
+        statistics -> ux_device_class_hid_event_statistics_age_last < 5 ||
+        statistics -> ux_device_class_hid_event_statistics_age_max < 5)
+    {
+
+        printf("Error on line %d, age %ld\n", __LINE__, statistics -> ux_device_class_hid_event_statistics_age_last);
+        test_control_return(1);
+    }
+
+    /* The interrupt thread drains the queue again.  */
+    ux_utility_thread_resume(&slave_class -> ux_slave_class_thread);
+    event_queue(1, 0x17);
+    event_queue(1, 0x18);
+    for (i = 0; i < 10 && device_hid -> ux_device_class_hid_event_array_tail != device_hid -> ux_device_class_hid_event_array_head; i ++)
+        tx_thread_sleep(1);
+    if (device_hid -> ux_device_class_hid_event_array_tail != device_hid -> ux_device_class_hid_event_array_head)
+    {
+
+        printf("Error on line %d, events not sent\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Now disconnect the device.  */
+    _ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    status =  ux_device_stack_class_unregister(_ux_system_slave_class_hid_name, ux_device_class_hid_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+#endif
+}
+
+static UINT    demo_thread_hid_callback(UX_SLAVE_CLASS_HID *class, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,541 @@
+/* This test is designed to test transfer requests queued on a device
+   endpoint: they complete in order through their completion functions, they
+   can be queued again from the completion function, they are aborted in order
+   and they are freed with the endpoint.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_MEMORY_SIZE     (64*1024)
+
+#define TEST_REQUESTS_COUNT     4
+#define TEST_WAIT_TICKS         200
+
+
+/* Define USBX test global variables.  */
+
+static unsigned char                   host_out_buffer[UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+static unsigned char                   slave_buffer[TEST_REQUESTS_COUNT][UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static UINT                             expected_error;
+
+static UX_SLAVE_TRANSFER               *out_requests;
+static UX_SLAVE_TRANSFER               *completed[TEST_REQUESTS_COUNT * 2];
+static ULONG                            completed_length[TEST_REQUESTS_COUNT * 2];
+static UCHAR                            completed_data[TEST_REQUESTS_COUNT * 2];
+static ULONG                            completed_count;
+static UINT                             requeue;
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+#endif
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+#endif
+    };
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides English, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    if (expected_error == 0 || error_code != expected_error)
+    {
+        /* Failed test.  */
+        printf("Error on line %d, system_level: %d, system_context: %d, error code: %x\n", __LINE__, system_level, system_context, error_code);
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_device_stack_transfer_request_queue_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running Device Stack Transfer Request Queue Test.................... ");
+#if defined(UX_HOST_STANDALONE) || defined(UX_DEVICE_STANDALONE)
+
+    /* Transfer requests are queued by the simulator in threaded mode.  */
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#else
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+    status |= ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                               1, 0, &parameter);
+
+    /* Initialize the simulated device controller.  */
+    status |= _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main demo thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+#if !defined(UX_HOST_STANDALONE) && !defined(UX_DEVICE_STANDALONE)
+static VOID  transfer_completed(UX_SLAVE_TRANSFER *transfer_request)
+{
+
+    /* Log the completion order and the data received.  */
+    if (completed_count < TEST_REQUESTS_COUNT * 2)
+    {
+        completed[completed_count] = transfer_request;
+        completed_length[completed_count] = transfer_request -> ux_slave_transfer_request_actual_length;
+        completed_data[completed_count] = transfer_request -> ux_slave_transfer_request_data_pointer[0];
+    }
+    completed_count ++;
+
+    /* Queue the request again if it's completed.  */
+    if (requeue && transfer_request -> ux_slave_transfer_request_status == UX_TRANSFER_STATUS_COMPLETED)
+        ux_device_stack_transfer_request_queue(transfer_request, UX_HOST_CLASS_DPUMP_PACKET_SIZE, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+}
+
+static void  completed_wait(ULONG count, ULONG line)
+{
+
+ULONG           ticks = 0;
+
+
+    while (completed_count < count)
+    {
+        if (ticks ++ > TEST_WAIT_TICKS)
+        {
+
+            printf("ERROR #%ld: %ld of %ld transfers completed\n", line, completed_count, count);
+            test_control_return(1);
+        }
+        tx_thread_sleep(1);
+    }
+}
+
+static void  requests_setup(void)
+{
+
+UINT            i;
+
+
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        out_requests[i].ux_slave_transfer_request_data_pointer = slave_buffer[i];
+        out_requests[i].ux_slave_transfer_request_completion_function = transfer_completed;
+    }
+}
+
+static void  requests_queue(ULONG line)
+{
+
+UINT            status;
+UINT            i;
+
+
+    completed_count = 0;
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        status = ux_device_stack_transfer_request_queue(&out_requests[i], UX_HOST_CLASS_DPUMP_PACKET_SIZE, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("ERROR #%ld: 0x%x\n", line, status);
+            test_control_return(1);
+        }
+    }
+}
+
+static void  packets_write_check(ULONG count, UCHAR tag, ULONG line)
+{
+
+UINT            status;
+ULONG           actual_length;
+UINT            i;
+
+
+    /* The host writes packets, one per queued transfer request.  */
+    for (i = 0; i < count; i ++)
+    {
+        _ux_utility_memory_set(host_out_buffer, (UCHAR)(tag + i), UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        status = ux_host_class_dpump_write(dpump, host_out_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("ERROR #%ld: 0x%x\n", line, status);
+            test_control_return(1);
+        }
+    }
+
+    /* All of them complete in order, with the packets in order.  */
+    completed_wait(count, line);
+    for (i = 0; i < count; i ++)
+    {
+        if (completed[i] != &out_requests[i % TEST_REQUESTS_COUNT] ||
+            completed_length[i] != UX_HOST_CLASS_DPUMP_PACKET_SIZE ||
+            completed_data[i] != (UCHAR)(tag + i))
+        {
+
+            printf("ERROR #%ld: completion %d, length %ld, data 0x%x\n", line, i,
+                    completed_length[i], completed_data[i]);
+            test_control_return(1);
+        }
+    }
+}
+
+static void  requests_aborted_check(ULONG line)
+{
+
+UINT            i;
+
+
+    /* All the transfer requests are aborted in order.  */
+    completed_wait(TEST_REQUESTS_COUNT, line);
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        if (completed[i] != &out_requests[i] ||
+            out_requests[i].ux_slave_transfer_request_status != UX_TRANSFER_STATUS_ABORT)
+        {
+
+            printf("ERROR #%ld: request %d not aborted in order\n", line, i);
+            test_control_return(1);
+        }
+    }
+}
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                status;
+UX_HOST_CLASS       *class;
+UX_SLAVE_ENDPOINT   *out_endpoint;
+UX_SLAVE_TRANSFER   *transfer_requests;
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+        tx_thread_relinquish();
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE ||
+           dpump_slave == UX_NULL)
+        tx_thread_relinquish();
+    out_endpoint = dpump_slave -> ux_slave_class_dpump_bulkout_endpoint;
+
+    /* Allocate transfer requests on the device bulk OUT endpoint.  */
+    status = ux_device_stack_endpoint_transfer_requests_allocate(out_endpoint, TEST_REQUESTS_COUNT, &out_requests);
+    if (status != UX_SUCCESS ||
+        out_endpoint -> ux_slave_endpoint_transfer_requests != out_requests ||
+        out_endpoint -> ux_slave_endpoint_transfer_requests_count != TEST_REQUESTS_COUNT ||
+        out_requests[0].ux_slave_transfer_request_endpoint != out_endpoint)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    requests_setup();
+
+    /* Only one set of transfer requests per endpoint.  */
+    expected_error = UX_ALREADY_ACTIVATED;
+    status =  ux_device_stack_endpoint_transfer_requests_allocate(out_endpoint, 1, &transfer_requests);
+    expected_error = 0;
+    if (status != UX_ALREADY_ACTIVATED)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Transfer requests are not queued on the control endpoint.  */
+    expected_error = UX_FUNCTION_NOT_SUPPORTED;
+    transfer_requests = &_ux_system_slave -> ux_system_slave_device.ux_slave_device_control_endpoint.ux_slave_endpoint_transfer_request;
+    status =  ux_device_stack_transfer_request_queue(transfer_requests, 0, 0);
+    expected_error = 0;
+    if (status != UX_FUNCTION_NOT_SUPPORTED)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Queued transfer requests complete in order.  */
+    requests_queue(__LINE__);
+    packets_write_check(TEST_REQUESTS_COUNT, 'A', __LINE__);
+
+    /* A pending transfer request is not queued twice.  */
+    requests_queue(__LINE__);
+    status =  ux_device_stack_transfer_request_queue(&out_requests[0], UX_HOST_CLASS_DPUMP_PACKET_SIZE, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+    if (status != UX_BUSY)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    packets_write_check(TEST_REQUESTS_COUNT, 'a', __LINE__);
+
+    /* Transfer requests are queued again from the completion function.  */
+    requeue = UX_TRUE;
+    requests_queue(__LINE__);
+    packets_write_check(TEST_REQUESTS_COUNT * 2, '0', __LINE__);
+    requeue = UX_FALSE;
+
+    /* The endpoint abort cancels all the queued transfer requests.  */
+    completed_count = 0;
+    ux_device_stack_transfer_all_request_abort(out_endpoint, UX_TRANSFER_BUS_RESET);
+    requests_aborted_check(__LINE__);
+    requests_queue(__LINE__);
+    packets_write_check(TEST_REQUESTS_COUNT, 'A', __LINE__);
+
+    /* Free transfer requests, they can be allocated again.  */
+    requests_queue(__LINE__);
+    status = ux_device_stack_endpoint_transfer_requests_free(out_endpoint);
+    if (status != UX_SUCCESS ||
+        out_endpoint -> ux_slave_endpoint_transfer_requests != UX_NULL ||
+        out_endpoint -> ux_slave_endpoint_transfer_requests_count != 0)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    completed_wait(TEST_REQUESTS_COUNT, __LINE__);
+    status = ux_device_stack_endpoint_transfer_requests_allocate(out_endpoint, TEST_REQUESTS_COUNT, &out_requests);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    requests_setup();
+    requests_queue(__LINE__);
+    packets_write_check(TEST_REQUESTS_COUNT, 'a', __LINE__);
+
+    /* Transfer requests left are aborted and freed with the endpoint on disconnection.  */
+    requests_queue(__LINE__);
+    ux_test_dcd_sim_slave_disconnect();
+    ux_test_hcd_sim_host_disconnect();
+    completed_wait(TEST_REQUESTS_COUNT, __LINE__);
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+    /* Transfer requests are queued by the host thread, nothing else to do.  */
+    while(1)
+        tx_thread_sleep(10);
+}
+#endif
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
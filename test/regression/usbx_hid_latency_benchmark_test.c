@@ -0,0 +1,442 @@
+/* This benchmarks the latency of HID input reports from the device event set
+   to the host client callback, over the simulated controllers, for several
+   bInterval values, report sizes and client callback loads: each report is
+   stamped at every stage by the HID latency probe and by the client, the
+   stages are checked to be complete and in order, the latencies are only
+   reported.  */
+
+#include <sys/time.h>
+#include "usbx_test_common_hid.h"
+
+#define LATENCY_REPORTS                             32
+#define LATENCY_BURST                               4
+#define LATENCY_STAGE_CLIENT                        UX_HID_LATENCY_STAGES
+#define LATENCY_STAMPS                              (UX_HID_LATENCY_STAGES + 1)
+
+/* Offsets of the patched descriptor values.  */
+#define LATENCY_REPORT_COUNT_OFFSET                 15
+#define LATENCY_FS_INTERVAL_OFFSET                  (DEVICE_FRAMEWORK_LENGTH_FULL_SPEED - 1)
+#define LATENCY_HS_INTERVAL_OFFSET                  (DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED - 1)
+
+static UINT                                error_count;
+
+static volatile ULONG                      latency_length;
+static volatile ULONG                      latency_load_us;
+static volatile ULONG                      latency_reports;
+static ULONG                               latency_stamps[LATENCY_REPORTS][LATENCY_STAMPS];
+static ULONG                               latency_totals[LATENCY_REPORTS];
+
+static const UCHAR                         latency_intervals[] = {1, 8};
+static const UCHAR                         latency_lengths[] = {8, 32};
+static const ULONG                         latency_loads_us[] = {0, 500};
+
+static UCHAR hid_report_descriptor[] = {
+
+    0x06, 0x00, 0xff,              // USAGE_PAGE (Vendor Defined Page 1)
+    0x09, 0x01,                    // USAGE (Vendor Usage 1)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x26, 0xff, 0x00,              //   LOGICAL_MAXIMUM (255)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x95, 0x08,                    //   REPORT_COUNT (8), patched per configuration
+    0x09, 0x01,                    //   USAGE (Vendor Usage 1)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+};
+#define HID_REPORT_LENGTH sizeof(hid_report_descriptor)/sizeof(hid_report_descriptor[0])
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[DEVICE_FRAMEWORK_LENGTH_FULL_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x20, 0x00, 0x01
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x20, 0x00, 0x01
+
+    };
+
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No HID client is registered for the device.  */
+    if (error_code == UX_HOST_CLASS_HID_UNKNOWN)
+        return;
+
+    error_count ++;
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hid_latency_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR *                          stack_pointer;
+CHAR *                          memory_pointer;
+
+    /* Inform user.  */
+    printf("Running HID Latency Benchmark....................................... ");
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX. Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    status =  ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_report_descriptor;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+
+    /* Initilize the device hid class. The class is connected with interface 2 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                                1,2, (VOID *)&hid_parameter);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static ULONG  latency_time_us(void)
+{
+
+struct timeval  now;
+
+    gettimeofday(&now, UX_NULL);
+    return((ULONG)now.tv_sec * 1000000ul + (ULONG)now.tv_usec);
+}
+
+static VOID  latency_probe(UINT stage, UCHAR *buffer, ULONG length)
+{
+ULONG       time_us = latency_time_us();
+
+    /* Only the reports of the running configuration are stamped, the first byte is
+       their sequence number.  */
+    if (latency_length == 0 || length != latency_length || buffer[0] >= LATENCY_REPORTS)
+        return;
+    if (stage < UX_HID_LATENCY_STAGES && latency_stamps[buffer[0]][stage] == 0)
+        latency_stamps[buffer[0]][stage] = time_us;
+}
+
+static VOID  latency_report_callback(UX_HOST_CLASS_HID_REPORT_CALLBACK *callback)
+{
+UCHAR       *buffer = (UCHAR *)callback -> ux_host_class_hid_report_callback_buffer;
+ULONG       start_us;
+
+    /* Stamp the report as the client gets it.  */
+    start_us = latency_time_us();
+    if (callback -> ux_host_class_hid_report_callback_actual_length == latency_length &&
+        buffer[0] < LATENCY_REPORTS)
+        latency_stamps[buffer[0]][LATENCY_STAGE_CLIENT] = start_us;
+
+    /* Then process it for the configured time.  */
+    while (latency_time_us() - start_us < latency_load_us);
+
+    latency_reports ++;
+}
+
+static VOID  latency_configure(UCHAR interval, UCHAR length)
+{
+UX_HOST_CLASS_HID_REPORT_GET_ID     report_get_id;
+UX_HOST_CLASS_HID_REPORT_CALLBACK   callback;
+
+    /* Enumerate again with the endpoint interval and the report size of the configuration.  */
+    ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+    device_framework_full_speed[LATENCY_FS_INTERVAL_OFFSET] = interval;
+    device_framework_high_speed[LATENCY_HS_INTERVAL_OFFSET] = interval;
+    hid_report_descriptor[LATENCY_REPORT_COUNT_OFFSET] = length;
+    ux_test_connect_slave_and_host_wait_for_enum_completion();
+    UX_TEST_CHECK_SUCCESS(demo_class_hid_get());
+    UX_TEST_ASSERT(hid -> ux_host_class_hid_interrupt_endpoint -> ux_endpoint_descriptor.bInterval == interval);
+
+    /* Register a raw callback on the input report and start polling.  */
+    report_get_id.ux_host_class_hid_report_get_report = UX_NULL;
+    report_get_id.ux_host_class_hid_report_get_type = UX_HOST_CLASS_HID_REPORT_TYPE_INPUT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_id_get(hid, &report_get_id));
+    callback.ux_host_class_hid_report_callback_id =         report_get_id.ux_host_class_hid_report_get_id;
+    callback.ux_host_class_hid_report_callback_function =   latency_report_callback;
+    callback.ux_host_class_hid_report_callback_buffer =     UX_NULL;
+    callback.ux_host_class_hid_report_callback_flags =      UX_HOST_CLASS_HID_REPORT_RAW;
+    callback.ux_host_class_hid_report_callback_length =     length;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_callback_register(hid, &callback));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_periodic_report_start(hid));
+
+    /* Device HID instance.  */
+    device_hid = _ux_system_slave -> ux_system_slave_device.ux_slave_device_first_interface -> ux_slave_interface_class_instance;
+}
+
+static VOID  latency_run(UCHAR interval, UCHAR length, ULONG load_us)
+{
+UX_SLAVE_CLASS_HID_EVENT    event;
+ULONG                       segments[UX_HID_LATENCY_STAGES];
+ULONG                       sorted;
+ULONG                       total;
+ULONG                       i, j;
+
+
+    ux_utility_memory_set(latency_stamps, 0, sizeof(latency_stamps)); /* Use case of memset is verified. */
+    latency_reports = 0;
+    latency_load_us = load_us;
+    latency_length = length;
+
+    /* Send the reports in bursts, each burst is received before the next one.  */
+    ux_utility_memory_set(&event, 0, sizeof(event)); /* Use case of memset is verified. */
+    event.ux_device_class_hid_event_length = length;
+    for (i = 0; i < LATENCY_REPORTS; i ++)
+    {
+        event.ux_device_class_hid_event_buffer[0] = (UCHAR)i;
+        event.ux_device_class_hid_event_buffer[length - 1] = (UCHAR)~i;
+        UX_TEST_CHECK_SUCCESS(ux_device_class_hid_event_set(device_hid, &event));
+        if ((i % LATENCY_BURST) == LATENCY_BURST - 1)
+            UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&latency_reports, i + 1));
+    }
+    latency_length = 0;
+
+    /* Every report went through all stages, in order.  */
+    ux_utility_memory_set(segments, 0, sizeof(segments)); /* Use case of memset is verified. */
+    for (i = 0; i < LATENCY_REPORTS; i ++)
+    {
+        for (j = 0; j < UX_HID_LATENCY_STAGES; j ++)
+        {
+            if (latency_stamps[i][j] == 0 || latency_stamps[i][j + 1] < latency_stamps[i][j])
+            {
+                printf("Error on line %d, report %ld stage %ld\n", __LINE__, i, j);
+                test_control_return(1);
+            }
+            segments[j] += latency_stamps[i][j + 1] - latency_stamps[i][j];
+        }
+
+        /* Keep the totals sorted.  */
+        total = latency_stamps[i][LATENCY_STAGE_CLIENT] - latency_stamps[i][UX_HID_LATENCY_STAGE_EVENT_SET];
+        for (sorted = i; sorted > 0 && latency_totals[sorted - 1] > total; sorted --)
+            latency_totals[sorted] = latency_totals[sorted - 1];
+        latency_totals[sorted] = total;
+    }
+
+    printf("  bInterval %d, %2d bytes, load %3ld us: set>submit %6.1f, submit>host %7.1f, host>dispatch %6.1f, dispatch>client %6.1f us,"
+           " total min %ld, median %ld, p99 %ld, max %ld us\n",
+           interval, length, load_us,
+           (double)segments[UX_HID_LATENCY_STAGE_EVENT_SET] / LATENCY_REPORTS,
+           (double)segments[UX_HID_LATENCY_STAGE_DEVICE_SUBMIT] / LATENCY_REPORTS,
+           (double)segments[UX_HID_LATENCY_STAGE_HOST_RECEIVED] / LATENCY_REPORTS,
+           (double)segments[UX_HID_LATENCY_STAGE_HOST_DISPATCH] / LATENCY_REPORTS,
+           latency_totals[0], latency_totals[LATENCY_REPORTS / 2],
+           latency_totals[(LATENCY_REPORTS * 99 + 99) / 100 - 1], latency_totals[LATENCY_REPORTS - 1]);
+}
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+ULONG       interval_index;
+ULONG       length_index;
+ULONG       load_index;
+
+
+    /* Stamp the reports at every stage.  */
+    ux_test_hid_latency_probe_set(latency_probe);
+
+    printf("\n");
+    for (interval_index = 0; interval_index < sizeof(latency_intervals); interval_index ++)
+    {
+        for (length_index = 0; length_index < sizeof(latency_lengths); length_index ++)
+        {
+            latency_configure(latency_intervals[interval_index], latency_lengths[length_index]);
+            for (load_index = 0; load_index < sizeof(latency_loads_us) / sizeof(latency_loads_us[0]); load_index ++)
+                latency_run(latency_intervals[interval_index], latency_lengths[length_index], latency_loads_us[load_index]);
+        }
+    }
+
+    ux_test_hid_latency_probe_set(UX_NULL);
+
+    /* No unexpected errors.  */
+    UX_TEST_ASSERT(error_count == 0);
+
+    /* Now disconnect the device.  */
+    _ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    ux_device_stack_class_unregister(_ux_system_slave_class_hid_name, ux_device_class_hid_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+static UINT    demo_thread_hid_callback(UX_SLAVE_CLASS_HID *class, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,454 @@
+/* This tests the host HID report descriptor parse cache: the reports parsed
+   on first enumeration are kept in the HID class, a device re-enumerating
+   with the same descriptor gets a clone of them in a single allocation
+   without the descriptor being parsed again, and the clone is released in
+   one call when the device is removed.  */
+
+#include "usbx_test_common_hid.h"
+
+static UINT                                error_count;
+
+static UCHAR hid_report_descriptor[] = {
+
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x02,                    // USAGE (Mouse)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x01,                    //   REPORT_ID (1)
+    0x09, 0x01,                    //   USAGE (Pointer)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x05, 0x09,                    //     USAGE_PAGE (Button)
+    0x19, 0x01,                    //     USAGE_MINIMUM (Button 1)
+    0x29, 0x03,                    //     USAGE_MAXIMUM (Button 3)
+    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
+    0x75, 0x01,                    //     REPORT_SIZE (1)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x09, 0x30,                    //     USAGE (X)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x15, 0x81,                    //     LOGICAL_MINIMUM (-127)
+    0x25, 0x7f,                    //     LOGICAL_MAXIMUM (127)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0xc0,                          //   END_COLLECTION
+    0x85, 0x02,                    //   REPORT_ID (2)
+    0x06, 0x00, 0xff,              //   USAGE_PAGE (Vendor Defined Page 1)
+    0x09, 0x01,                    //   USAGE (Vendor Usage 1)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x26, 0xff, 0x00,              //   LOGICAL_MAXIMUM (255)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x95, 0x02,                    //   REPORT_COUNT (2)
+    0x91, 0x02,                    //   OUTPUT (Data,Var,Abs)
+    0x85, 0x03,                    //   REPORT_ID (3)
+    0x09, 0x02,                    //   USAGE (Vendor Usage 2)
+    0x95, 0x04,                    //   REPORT_COUNT (4)
+    0xb1, 0x02,                    //   FEATURE (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+};
+#define HID_REPORT_LENGTH sizeof(hid_report_descriptor)/sizeof(hid_report_descriptor[0])
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[DEVICE_FRAMEWORK_LENGTH_FULL_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No HID client is registered for the device.  */
+    if (error_code == UX_HOST_CLASS_HID_UNKNOWN)
+        return;
+
+    error_count ++;
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hid_parse_cache_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR *                          stack_pointer;
+CHAR *                          memory_pointer;
+
+    /* Inform user.  */
+    printf("Running HID Parse Cache Test....................................... ");
+#if !defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX. Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    status =  ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_report_descriptor;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+
+    /* Initilize the device hid class. The class is connected with interface 2 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                                1,2, (VOID *)&hid_parameter);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+static ULONG  report_fingerprint(UX_HOST_CLASS_HID_REPORT *report, ULONG *count)
+{
+UX_HOST_CLASS_HID_FIELD     *field;
+ULONG                       fingerprint = 2166136261u;
+ULONG                       i;
+
+#define FINGERPRINT(v) fingerprint = (fingerprint ^ (ULONG)(v)) * 16777619u
+
+    /* Fold everything the parser produced, but pointers, into a value.  */
+    for (; report != UX_NULL; report = report -> ux_host_class_hid_report_next_report)
+    {
+        (*count) ++;
+        FINGERPRINT(report -> ux_host_class_hid_report_id);
+        FINGERPRINT(report -> ux_host_class_hid_report_type);
+        FINGERPRINT(report -> ux_host_class_hid_report_number_item);
+        FINGERPRINT(report -> ux_host_class_hid_report_byte_length);
+        FINGERPRINT(report -> ux_host_class_hid_report_bit_length);
+        for (field = report -> ux_host_class_hid_report_field; field != UX_NULL;
+             field = field -> ux_host_class_hid_field_next_field)
+        {
+
+            /* Fields must point back to their own report.  */
+            UX_TEST_ASSERT(field -> ux_host_class_hid_field_report == report);
+            FINGERPRINT(field -> ux_host_class_hid_field_usage_page);
+            FINGERPRINT(field -> ux_host_class_hid_field_usage_min);
+            FINGERPRINT(field -> ux_host_class_hid_field_usage_max);
+            FINGERPRINT(field -> ux_host_class_hid_field_logical_min);
+            FINGERPRINT(field -> ux_host_class_hid_field_logical_max);
+            FINGERPRINT(field -> ux_host_class_hid_field_report_offset);
+            FINGERPRINT(field -> ux_host_class_hid_field_report_size);
+            FINGERPRINT(field -> ux_host_class_hid_field_report_count);
+            FINGERPRINT(field -> ux_host_class_hid_field_value);
+            FINGERPRINT(field -> ux_host_class_hid_field_number_values);
+            FINGERPRINT(field -> ux_host_class_hid_field_number_usage);
+            for (i = 0; i < field -> ux_host_class_hid_field_number_usage; i ++)
+                FINGERPRINT(field -> ux_host_class_hid_field_usages[i]);
+        }
+    }
+    return(fingerprint);
+}
+
+static ULONG  parser_fingerprint(UX_HOST_CLASS_HID_PARSER *parser, ULONG *count)
+{
+ULONG       fingerprint;
+
+    *count = 0;
+    fingerprint =  report_fingerprint(parser -> ux_host_class_hid_parser_input_report, count);
+    fingerprint += report_fingerprint(parser -> ux_host_class_hid_parser_output_report, count) * 3;
+    fingerprint += report_fingerprint(parser -> ux_host_class_hid_parser_feature_report, count) * 7;
+    return(fingerprint);
+}
+
+static UINT  report_in_block(UX_HOST_CLASS_HID_REPORT *report, UCHAR *block, ULONG length)
+{
+
+    for (; report != UX_NULL; report = report -> ux_host_class_hid_report_next_report)
+    {
+        if ((UCHAR *)report < block || (UCHAR *)report >= block + length)
+            return(UX_FALSE);
+        if (report -> ux_host_class_hid_report_field != UX_NULL &&
+            ((UCHAR *)report -> ux_host_class_hid_report_field < block ||
+             (UCHAR *)report -> ux_host_class_hid_report_field >= block + length))
+            return(UX_FALSE);
+    }
+    return(UX_TRUE);
+}
+#endif
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+#if defined(UX_HOST_CLASS_HID_PARSE_CACHE)
+
+UX_HOST_CLASS_HID_PARSE_CACHE_EXT   *cache;
+UX_HOST_CLASS_HID_PARSE_CACHE_ENTRY *entry;
+UX_HOST_CLASS_HID_PARSER            *parser;
+UX_HOST_CLASS_HID_REPORT_GET_ID     report_get_id;
+ULONG                               fingerprint;
+ULONG                               report_count;
+ULONG                               count;
+ULONG                               memory_free;
+ULONG                               i;
+
+
+    /* Find the HID class */
+    UX_TEST_CHECK_SUCCESS(demo_class_hid_get());
+    parser = &hid -> ux_host_class_hid_parser;
+
+    /* First enumeration: the descriptor is parsed and the result cached.  */
+    cache = (UX_HOST_CLASS_HID_PARSE_CACHE_EXT *)hid -> ux_host_class_hid_class -> ux_host_class_ext;
+    UX_TEST_ASSERT(cache != UX_NULL);
+    UX_TEST_ASSERT(hid -> ux_host_class_hid_parse_cache_block == UX_NULL);
+    UX_TEST_ASSERT(cache -> ux_host_class_hid_parse_cache_hits == 0);
+    UX_TEST_ASSERT(cache -> ux_host_class_hid_parse_cache_misses == 0);
+    entry = &cache -> ux_host_class_hid_parse_cache_entries[0];
+    UX_TEST_ASSERT(entry -> ux_host_class_hid_parse_cache_entry_block != UX_NULL);
+    UX_TEST_ASSERT(entry -> ux_host_class_hid_parse_cache_entry_descriptor_length == HID_REPORT_LENGTH);
+    UX_TEST_ASSERT(ux_utility_memory_compare(entry -> ux_host_class_hid_parse_cache_entry_block +
+                                             entry -> ux_host_class_hid_parse_cache_entry_reports_length,
+                                             hid_report_descriptor, HID_REPORT_LENGTH) == UX_SUCCESS);
+    fingerprint = parser_fingerprint(parser, &report_count);
+    UX_TEST_ASSERT(report_count == 3);
+
+    /* The cached reports are the same as the parsed ones.  */
+    {
+    UX_HOST_CLASS_HID_PARSER    cached;
+
+        cached.ux_host_class_hid_parser_input_report = entry -> ux_host_class_hid_parse_cache_entry_reports[0];
+        cached.ux_host_class_hid_parser_output_report = entry -> ux_host_class_hid_parse_cache_entry_reports[1];
+        cached.ux_host_class_hid_parser_feature_report = entry -> ux_host_class_hid_parse_cache_entry_reports[2];
+        UX_TEST_ASSERT(parser_fingerprint(&cached, &count) == fingerprint && count == report_count);
+        UX_TEST_ASSERT(report_in_block(cached.ux_host_class_hid_parser_input_report,
+                                       entry -> ux_host_class_hid_parse_cache_entry_block,
+                                       entry -> ux_host_class_hid_parse_cache_entry_reports_length));
+    }
+
+    /* Remove the device: the cache stays, keep the memory level.  */
+    ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+    memory_free = _ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available;
+
+    for (i = 1; i <= 2; i ++)
+    {
+
+        /* Re-enumerate: the reports are cloned from the cache.  */
+        ux_test_connect_slave_and_host_wait_for_enum_completion();
+        UX_TEST_CHECK_SUCCESS(demo_class_hid_get());
+        parser = &hid -> ux_host_class_hid_parser;
+        UX_TEST_ASSERT(cache -> ux_host_class_hid_parse_cache_hits == i);
+        UX_TEST_ASSERT(cache -> ux_host_class_hid_parse_cache_misses == 0);
+        UX_TEST_ASSERT(hid -> ux_host_class_hid_parse_cache_block != UX_NULL);
+        UX_TEST_ASSERT(hid -> ux_host_class_hid_parse_cache_block != entry -> ux_host_class_hid_parse_cache_entry_block);
+        UX_TEST_ASSERT(parser_fingerprint(parser, &count) == fingerprint && count == report_count);
+        UX_TEST_ASSERT(report_in_block(parser -> ux_host_class_hid_parser_input_report,
+                                       hid -> ux_host_class_hid_parse_cache_block,
+                                       entry -> ux_host_class_hid_parse_cache_entry_reports_length));
+        UX_TEST_ASSERT(report_in_block(parser -> ux_host_class_hid_parser_feature_report,
+                                       hid -> ux_host_class_hid_parse_cache_block,
+                                       entry -> ux_host_class_hid_parse_cache_entry_reports_length));
+
+        /* The cloned reports are usable.  */
+        report_get_id.ux_host_class_hid_report_get_report = UX_NULL;
+        report_get_id.ux_host_class_hid_report_get_type = UX_HOST_CLASS_HID_REPORT_TYPE_FEATURE;
+        UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_id_get(hid, &report_get_id));
+        UX_TEST_ASSERT(report_get_id.ux_host_class_hid_report_get_id == 3);
+
+        /* Removing the device frees the clone, nothing else.  */
+        ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+        UX_TEST_ASSERT(_ux_system -> ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] -> ux_byte_pool_available == memory_free);
+    }
+
+    /* No unexpected errors.  */
+    UX_TEST_ASSERT(error_count == 0);
+
+    /* Now disconnect the device.  */
+    _ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    ux_device_stack_class_unregister(_ux_system_slave_class_hid_name, ux_device_class_hid_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+#endif
+}
+
+static UINT    demo_thread_hid_callback(UX_SLAVE_CLASS_HID *class, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,567 @@
+/* This tests the host HID report decode plans: plans are compiled for each
+   report, layouts bind report values to client structure members (variable
+   values by usage, array values by the first usage of their range), values
+   are sign extended, and interrupt reports registered with
+   UX_HOST_CLASS_HID_REPORT_STRUCTURE are decoded straight into the client
+   structures. Layouts are bound in the spare copy of the plan and swapped,
+   structures shorter than the bound layout are not decoded.  */
+
+#include <stddef.h>
+#include "usbx_test_common_hid.h"
+
+static UINT                                error_count;
+static UINT                                error_last;
+
+/* Client structures.  */
+typedef struct DECODE_PLAN_MOUSE_STRUCT
+{
+    UCHAR           buttons[3];
+    SCHAR           wheel;
+    SHORT           x;
+    SHORT           y;
+    SCHAR           pan;
+} DECODE_PLAN_MOUSE;
+
+typedef struct DECODE_PLAN_KEYBOARD_STRUCT
+{
+    ULONG           modifiers[8];
+    UCHAR           keys[6];
+} DECODE_PLAN_KEYBOARD;
+
+static DECODE_PLAN_MOUSE                   mouse;
+static DECODE_PLAN_KEYBOARD                keyboard;
+static volatile ULONG                      mouse_reports;
+static volatile ULONG                      mouse_overflows;
+static volatile ULONG                      keyboard_reports;
+
+static UX_HOST_CLASS_HID_LAYOUT            mouse_layout[] = {
+    { 0x00090001, offsetof(DECODE_PLAN_MOUSE, buttons),    1, 3 },
+    { 0x00010030, offsetof(DECODE_PLAN_MOUSE, x),          2, 1 },
+    { 0x00010031, offsetof(DECODE_PLAN_MOUSE, y),          2, 1 },
+    { 0x00010038, offsetof(DECODE_PLAN_MOUSE, wheel),      1, 1 },
+    { 0x000C0238, offsetof(DECODE_PLAN_MOUSE, pan),        1, 1 },
+};
+
+static UX_HOST_CLASS_HID_LAYOUT            keyboard_layout[] = {
+    { 0x000700E0, offsetof(DECODE_PLAN_KEYBOARD, modifiers[0]), 4, 1 },
+    { 0x000700E1, offsetof(DECODE_PLAN_KEYBOARD, modifiers[1]), 4, 1 },
+    { 0x000700E7, offsetof(DECODE_PLAN_KEYBOARD, modifiers[7]), 4, 1 },
+    { 0x00070000, offsetof(DECODE_PLAN_KEYBOARD, keys),         1, 6 },
+};
+
+static UCHAR hid_report_descriptor[] = {
+
+    /* Mouse: 3 buttons, 12 bits X/Y, wheel and pan.  */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x02,                    // USAGE (Mouse)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x01,                    //   REPORT_ID (1)
+    0x09, 0x01,                    //   USAGE (Pointer)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x05, 0x09,                    //     USAGE_PAGE (Button)
+    0x19, 0x01,                    //     USAGE_MINIMUM (Button 1)
+    0x29, 0x03,                    //     USAGE_MAXIMUM (Button 3)
+    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //     REPORT_SIZE (1)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x16, 0x01, 0xf8,              //     LOGICAL_MINIMUM (-2047)
+    0x26, 0xff, 0x07,              //     LOGICAL_MAXIMUM (2047)
+    0x75, 0x0c,                    //     REPORT_SIZE (12)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x09, 0x30,                    //     USAGE (X)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0x15, 0x81,                    //     LOGICAL_MINIMUM (-127)
+    0x25, 0x7f,                    //     LOGICAL_MAXIMUM (127)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x09, 0x38,                    //     USAGE (Wheel)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0x05, 0x0c,                    //     USAGE_PAGE (Consumer Devices)
+    0x0a, 0x38, 0x02,              //     USAGE (AC Pan)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0xc0,                          //   END_COLLECTION
+    0xc0,                          // END_COLLECTION
+
+    /* Keyboard: modifiers and 6 keys array.  */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x06,                    // USAGE (Keyboard)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x02,                    //   REPORT_ID (2)
+    0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
+    0x19, 0xe0,                    //   USAGE_MINIMUM (Keyboard LeftControl)
+    0x29, 0xe7,                    //   USAGE_MAXIMUM (Keyboard Right GUI)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x95, 0x08,                    //   REPORT_COUNT (8)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0x95, 0x06,                    //   REPORT_COUNT (6)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x25, 0x65,                    //   LOGICAL_MAXIMUM (101)
+    0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
+    0x29, 0x65,                    //   USAGE_MAXIMUM (Keyboard Application)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0,                          // END_COLLECTION
+};
+#define HID_REPORT_LENGTH sizeof(hid_report_descriptor)/sizeof(hid_report_descriptor[0])
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[DEVICE_FRAMEWORK_LENGTH_FULL_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No HID client is registered for the device.  */
+    if (error_code == UX_HOST_CLASS_HID_UNKNOWN)
+        return;
+
+    /* Layout errors are expected, they are counted.  */
+    error_count ++;
+    error_last = error_code;
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hid_report_decode_plan_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR *                          stack_pointer;
+CHAR *                          memory_pointer;
+
+    /* Inform user.  */
+    printf("Running HID Report Decode Plan Test................................. ");
+#if !defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX. Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    status =  ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_report_descriptor;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+    hid_parameter.ux_device_class_hid_parameter_report_id      = UX_TRUE;
+
+    /* Initilize the device hid class. The class is connected with interface 2 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                                1,2, (VOID *)&hid_parameter);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+static VOID  decode_plan_mouse_callback(UX_HOST_CLASS_HID_REPORT_CALLBACK *callback)
+{
+
+    /* The structure is returned.  */
+    if (callback -> ux_host_class_hid_report_callback_status == UX_SUCCESS &&
+        callback -> ux_host_class_hid_report_callback_buffer == (VOID *)&mouse &&
+        callback -> ux_host_class_hid_report_callback_actual_length == sizeof(mouse))
+        mouse_reports ++;
+
+    /* The structure registered is too short for the layout.  */
+    if (callback -> ux_host_class_hid_report_callback_status == UX_BUFFER_OVERFLOW)
+        mouse_overflows ++;
+}
+
+static VOID  decode_plan_keyboard_callback(UX_HOST_CLASS_HID_REPORT_CALLBACK *callback)
+{
+
+    if (callback -> ux_host_class_hid_report_callback_status == UX_SUCCESS &&
+        callback -> ux_host_class_hid_report_callback_buffer == (VOID *)&keyboard)
+        keyboard_reports ++;
+}
+#endif
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+#if defined(UX_HOST_CLASS_HID_DECODE_PLAN)
+
+UX_HOST_CLASS_HID_REPORT_GET_ID     report_get_id;
+UX_HOST_CLASS_HID_REPORT            *mouse_report;
+UX_HOST_CLASS_HID_REPORT            *keyboard_report;
+UX_HOST_CLASS_HID_REPORT            foreign_report;
+UX_HOST_CLASS_HID_LAYOUT            layout;
+UX_HOST_CLASS_HID_REPORT_CALLBACK   callback;
+UX_SLAVE_CLASS_HID_EVENT            event;
+UCHAR                               report[8];
+ULONG                               i;
+
+
+    /* Find the HID class */
+    UX_TEST_CHECK_SUCCESS(demo_class_hid_get());
+
+    /* Plans are compiled for both input reports, padding is not in the plan.  */
+    report_get_id.ux_host_class_hid_report_get_report = UX_NULL;
+    report_get_id.ux_host_class_hid_report_get_type = UX_HOST_CLASS_HID_REPORT_TYPE_INPUT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_id_get(hid, &report_get_id));
+    mouse_report = report_get_id.ux_host_class_hid_report_get_report;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_id_get(hid, &report_get_id));
+    keyboard_report = report_get_id.ux_host_class_hid_report_get_report;
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_id == 1);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_count == 7);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_length == 7);
+    UX_TEST_ASSERT(keyboard_report -> ux_host_class_hid_report_id == 2);
+    UX_TEST_ASSERT(keyboard_report -> ux_host_class_hid_report_plan_count == 14);
+    UX_TEST_ASSERT(keyboard_report -> ux_host_class_hid_report_plan_length == 8);
+
+    /* Layouts must fit the report and the structure.  */
+    layout.ux_host_class_hid_layout_usage =  0x00010032;
+    layout.ux_host_class_hid_layout_offset = 0;
+    layout.ux_host_class_hid_layout_size =   2;
+    layout.ux_host_class_hid_layout_count =  1;
+    UX_TEST_CHECK_CODE(UX_HOST_CLASS_HID_REPORT_ERROR, ux_host_class_hid_report_layout_set(hid, mouse_report, &layout, 1, sizeof(mouse)));
+    UX_TEST_ASSERT(error_last == UX_HOST_CLASS_HID_REPORT_ERROR);
+    layout.ux_host_class_hid_layout_usage =  0x00090001;
+    layout.ux_host_class_hid_layout_count =  4;
+    UX_TEST_CHECK_CODE(UX_HOST_CLASS_HID_REPORT_ERROR, ux_host_class_hid_report_layout_set(hid, mouse_report, &layout, 1, sizeof(mouse)));
+    layout.ux_host_class_hid_layout_count =  1;
+    layout.ux_host_class_hid_layout_size =   3;
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_hid_report_layout_set(hid, mouse_report, &layout, 1, sizeof(mouse)));
+    layout.ux_host_class_hid_layout_size =   2;
+    layout.ux_host_class_hid_layout_offset = 1;
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_hid_report_layout_set(hid, mouse_report, &layout, 1, sizeof(mouse)));
+    layout.ux_host_class_hid_layout_offset = sizeof(mouse);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_hid_report_layout_set(hid, mouse_report, &layout, 1, sizeof(mouse)));
+    UX_TEST_ASSERT(error_count == 5);
+
+    /* A failed layout leaves the report unbound.  */
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound == mouse_report -> ux_host_class_hid_report_plan);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_structure_length == 0);
+    for (i = 0; i < mouse_report -> ux_host_class_hid_report_plan_count; i ++)
+        UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound[i].ux_host_class_hid_plan_entry_destination_size == 0);
+
+    /* Bind the reports, the spare copies of the plans are swapped in.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_layout_set(hid, mouse_report, mouse_layout, ARRAY_COUNT(mouse_layout), sizeof(mouse)));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_layout_set(hid, keyboard_report, keyboard_layout, ARRAY_COUNT(keyboard_layout), sizeof(keyboard)));
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound ==
+                   mouse_report -> ux_host_class_hid_report_plan + mouse_report -> ux_host_class_hid_report_plan_count);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_structure_length == sizeof(mouse));
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_users == 0);
+
+    /* A failed layout keeps the bound one.  */
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_hid_report_layout_set(hid, mouse_report, &layout, 1, sizeof(mouse)));
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound ==
+                   mouse_report -> ux_host_class_hid_report_plan + mouse_report -> ux_host_class_hid_report_plan_count);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_structure_length == sizeof(mouse));
+
+    /* A report that is not parsed for this instance is rejected, its plan is not touched.  */
+    foreign_report = *mouse_report;
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, ux_host_class_hid_report_layout_set(hid, &foreign_report, mouse_layout, ARRAY_COUNT(mouse_layout), sizeof(mouse)));
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan[0].ux_host_class_hid_plan_entry_destination_size == 0);
+
+    /* A decode that does not end times the layout out, the bound one is kept.  */
+    mouse_report -> ux_host_class_hid_report_plan_users = 1;
+    UX_TEST_CHECK_CODE(UX_TIMEOUT, ux_host_class_hid_report_layout_set(hid, mouse_report, mouse_layout, ARRAY_COUNT(mouse_layout), sizeof(mouse)));
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_waiter == UX_NULL);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound ==
+                   mouse_report -> ux_host_class_hid_report_plan + mouse_report -> ux_host_class_hid_report_plan_count);
+    mouse_report -> ux_host_class_hid_report_plan_users = 0;
+
+    /* Binding again swaps the copies back.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_layout_set(hid, mouse_report, mouse_layout, ARRAY_COUNT(mouse_layout), sizeof(mouse)));
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound == mouse_report -> ux_host_class_hid_report_plan);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_bound[6].ux_host_class_hid_plan_entry_destination_size != 0);
+
+    /* Decode a mouse report: buttons 1 and 3, X -5, Y 300, wheel -1, pan 2.  */
+    report[0] = 1;
+    report[1] = 0xfd;
+    report[2] = 0xfb;
+    report[3] = 0xcf;
+    report[4] = 0x12;
+    report[5] = 0xff;
+    report[6] = 0x02;
+    ux_utility_memory_set(&mouse, 0x5a, sizeof(mouse));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_plan_decode(mouse_report, report, 7, &mouse, sizeof(mouse)));
+    UX_TEST_ASSERT(mouse.buttons[0] == 1 && mouse.buttons[1] == 0 && mouse.buttons[2] == 1);
+    UX_TEST_ASSERT(mouse.x == -5 && mouse.y == 300);
+    UX_TEST_ASSERT(mouse.wheel == -1 && mouse.pan == 2);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_users == 0);
+
+    /* A structure shorter than the layout is not decoded.  */
+    ux_utility_memory_set(&mouse, 0x5a, sizeof(mouse));
+    UX_TEST_CHECK_CODE(UX_BUFFER_OVERFLOW, ux_host_class_hid_report_plan_decode(mouse_report, report, 7, &mouse, sizeof(mouse) - 1));
+    UX_TEST_ASSERT(mouse.buttons[0] == 0x5a && mouse.pan == 0x5a);
+    UX_TEST_ASSERT(mouse_report -> ux_host_class_hid_report_plan_users == 0);
+
+    /* Values that are not received are left unchanged.  */
+    ux_utility_memory_set(&mouse, 0x5a, sizeof(mouse));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_plan_decode(mouse_report, report, 5, &mouse, sizeof(mouse)));
+    UX_TEST_ASSERT(mouse.x == -5 && mouse.y == 300);
+    UX_TEST_ASSERT(mouse.wheel == 0x5a && mouse.pan == 0x5a);
+
+    /* Interrupt reports are decoded to the registered structures.  */
+    callback.ux_host_class_hid_report_callback_id =         1;
+    callback.ux_host_class_hid_report_callback_function =   decode_plan_mouse_callback;
+    callback.ux_host_class_hid_report_callback_buffer =     &mouse;
+    callback.ux_host_class_hid_report_callback_flags =      UX_HOST_CLASS_HID_REPORT_STRUCTURE;
+    callback.ux_host_class_hid_report_callback_length =     sizeof(mouse);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_callback_register(hid, &callback));
+    callback.ux_host_class_hid_report_callback_id =         2;
+    callback.ux_host_class_hid_report_callback_function =   decode_plan_keyboard_callback;
+    callback.ux_host_class_hid_report_callback_buffer =     &keyboard;
+    callback.ux_host_class_hid_report_callback_length =     sizeof(keyboard);
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_callback_register(hid, &callback));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_periodic_report_start(hid));
+
+    /* Device HID instance.  */
+    device_hid = _ux_system_slave -> ux_system_slave_device.ux_slave_device_first_interface -> ux_slave_interface_class_instance;
+
+    ux_utility_memory_set(&mouse, 0, sizeof(mouse));
+    ux_utility_memory_set(&event, 0, sizeof(event));
+    event.ux_device_class_hid_event_report_id = 1;
+    event.ux_device_class_hid_event_length = 6;
+    ux_utility_memory_copy(event.ux_device_class_hid_event_buffer, report + 1, 6);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_hid_event_set(device_hid, &event));
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&mouse_reports, 1));
+    UX_TEST_ASSERT(mouse.buttons[0] == 1 && mouse.buttons[1] == 0 && mouse.buttons[2] == 1);
+    UX_TEST_ASSERT(mouse.x == -5 && mouse.y == 300);
+    UX_TEST_ASSERT(mouse.wheel == -1 && mouse.pan == 2);
+
+    /* Keyboard: left shift and right GUI, keys A and B, array values are raw.  */
+    ux_utility_memory_set(&keyboard, 0, sizeof(keyboard));
+    event.ux_device_class_hid_event_report_id = 2;
+    event.ux_device_class_hid_event_length = 7;
+    event.ux_device_class_hid_event_buffer[0] = 0x82;
+    event.ux_device_class_hid_event_buffer[1] = 0x04;
+    event.ux_device_class_hid_event_buffer[2] = 0x05;
+    for (i = 3; i < 7; i ++)
+        event.ux_device_class_hid_event_buffer[i] = 0;
+    UX_TEST_CHECK_SUCCESS(ux_device_class_hid_event_set(device_hid, &event));
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&keyboard_reports, 1));
+    UX_TEST_ASSERT(keyboard.modifiers[0] == 0 && keyboard.modifiers[1] == 1 && keyboard.modifiers[7] == 1);
+    UX_TEST_ASSERT(keyboard.modifiers[2] == 0 && keyboard.modifiers[6] == 0);
+    UX_TEST_ASSERT(keyboard.keys[0] == 0x04 && keyboard.keys[1] == 0x05 && keyboard.keys[2] == 0);
+    UX_TEST_ASSERT(mouse_reports == 1);
+
+    /* A registered structure shorter than the layout gets the error, not the values.  */
+    callback.ux_host_class_hid_report_callback_id =         1;
+    callback.ux_host_class_hid_report_callback_function =   decode_plan_mouse_callback;
+    callback.ux_host_class_hid_report_callback_buffer =     &mouse;
+    callback.ux_host_class_hid_report_callback_length =     sizeof(mouse) - 1;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_callback_register(hid, &callback));
+    ux_utility_memory_set(&mouse, 0, sizeof(mouse));
+    event.ux_device_class_hid_event_report_id = 1;
+    event.ux_device_class_hid_event_length = 6;
+    ux_utility_memory_copy(event.ux_device_class_hid_event_buffer, report + 1, 6);
+    UX_TEST_CHECK_SUCCESS(ux_device_class_hid_event_set(device_hid, &event));
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&mouse_overflows, 1));
+    UX_TEST_ASSERT(mouse.x == 0 && mouse.y == 0 && mouse.pan == 0);
+    UX_TEST_ASSERT(mouse_reports == 1);
+
+    /* Only expected errors.  */
+    UX_TEST_ASSERT(error_count == 8);
+
+    /* Now disconnect the device.  */
+    _ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    ux_device_stack_class_unregister(_ux_system_slave_class_hid_name, ux_device_class_hid_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+#endif
+}
+
+static UINT    demo_thread_hid_callback(UX_SLAVE_CLASS_HID *class, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
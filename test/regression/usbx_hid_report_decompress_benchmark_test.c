@@ -0,0 +1,582 @@
+/* This benchmarks the host HID report decompression on the input reports of
+   a gaming mouse, a keyboard, a gamepad and a pen digitizer: the values are
+   checked against a bit by bit reference extraction on random reports, the
+   time per report of both is only reported.  */
+
+#include <sys/time.h>
+#include "usbx_test_common_hid.h"
+
+#ifndef HID_BENCHMARK_CHECKS
+#define HID_BENCHMARK_CHECKS                1000
+#endif
+#ifndef HID_BENCHMARK_ITERATIONS
+#define HID_BENCHMARK_ITERATIONS            20000
+#endif
+
+#define HID_BENCHMARK_REPORT_LENGTH         64
+#define HID_BENCHMARK_VALUES_LENGTH         256
+
+static UCHAR                               report_buffer[HID_BENCHMARK_REPORT_LENGTH];
+static ULONG                               values_reference[HID_BENCHMARK_VALUES_LENGTH];
+static ULONG                               values[HID_BENCHMARK_VALUES_LENGTH];
+static ULONG                               random_seed = 1;
+
+static UCHAR hid_report_descriptor[] = {
+
+    /* Gaming mouse: 16 buttons, 16 bits X/Y, wheel and pan.  */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x02,                    // USAGE (Mouse)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x01,                    //   REPORT_ID (1)
+    0x09, 0x01,                    //   USAGE (Pointer)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x05, 0x09,                    //     USAGE_PAGE (Button)
+    0x19, 0x01,                    //     USAGE_MINIMUM (Button 1)
+    0x29, 0x10,                    //     USAGE_MAXIMUM (Button 16)
+    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //     REPORT_SIZE (1)
+    0x95, 0x10,                    //     REPORT_COUNT (16)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x16, 0x01, 0x80,              //     LOGICAL_MINIMUM (-32767)
+    0x26, 0xff, 0x7f,              //     LOGICAL_MAXIMUM (32767)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x09, 0x30,                    //     USAGE (X)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0x15, 0x81,                    //     LOGICAL_MINIMUM (-127)
+    0x25, 0x7f,                    //     LOGICAL_MAXIMUM (127)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x09, 0x38,                    //     USAGE (Wheel)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0x05, 0x0c,                    //     USAGE_PAGE (Consumer Devices)
+    0x0a, 0x38, 0x02,              //     USAGE (AC Pan)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0xc0,                          //   END_COLLECTION
+    0xc0,                          // END_COLLECTION
+
+    /* Keyboard: modifiers, reserved byte and 6 keys array.  */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x06,                    // USAGE (Keyboard)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x02,                    //   REPORT_ID (2)
+    0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
+    0x19, 0xe0,                    //   USAGE_MINIMUM (Keyboard LeftControl)
+    0x29, 0xe7,                    //   USAGE_MAXIMUM (Keyboard Right GUI)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x95, 0x08,                    //   REPORT_COUNT (8)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x81, 0x03,                    //   INPUT (Cnst,Var,Abs)
+    0x95, 0x06,                    //   REPORT_COUNT (6)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x65,                    //   LOGICAL_MAXIMUM (101)
+    0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
+    0x29, 0x65,                    //   USAGE_MAXIMUM (Keyboard Application)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0,                          // END_COLLECTION
+
+    /* Gamepad: 4 axes of 12 bits, hat switch and 12 buttons.  */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x05,                    // USAGE (Game Pad)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x03,                    //   REPORT_ID (3)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x26, 0xff, 0x0f,              //   LOGICAL_MAXIMUM (4095)
+    0x75, 0x0c,                    //   REPORT_SIZE (12)
+    0x95, 0x04,                    //   REPORT_COUNT (4)
+    0x09, 0x30,                    //   USAGE (X)
+    0x09, 0x31,                    //   USAGE (Y)
+    0x09, 0x32,                    //   USAGE (Z)
+    0x09, 0x35,                    //   USAGE (Rz)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x07,                    //   LOGICAL_MAXIMUM (7)
+    0x75, 0x04,                    //   REPORT_SIZE (4)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x09, 0x39,                    //   USAGE (Hat switch)
+    0x81, 0x42,                    //   INPUT (Data,Var,Abs,Null)
+    0x05, 0x09,                    //   USAGE_PAGE (Button)
+    0x19, 0x01,                    //   USAGE_MINIMUM (Button 1)
+    0x29, 0x0c,                    //   USAGE_MAXIMUM (Button 12)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x95, 0x0c,                    //   REPORT_COUNT (12)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+
+    /* Pen digitizer: switches, 16 bits X/Y, 12 bits pressure and 7 bits tilts.  */
+    0x05, 0x0d,                    // USAGE_PAGE (Digitizers)
+    0x09, 0x02,                    // USAGE (Pen)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x04,                    //   REPORT_ID (4)
+    0x09, 0x20,                    //   USAGE (Stylus)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x09, 0x42,                    //     USAGE (Tip Switch)
+    0x09, 0x44,                    //     USAGE (Barrel Switch)
+    0x09, 0x45,                    //     USAGE (Eraser)
+    0x09, 0x32,                    //     USAGE (In Range)
+    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //     REPORT_SIZE (1)
+    0x95, 0x04,                    //     REPORT_COUNT (4)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x95, 0x04,                    //     REPORT_COUNT (4)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x26, 0xff, 0x7f,              //     LOGICAL_MAXIMUM (32767)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x09, 0x30,                    //     USAGE (X)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x0d,                    //     USAGE_PAGE (Digitizers)
+    0x26, 0xff, 0x0f,              //     LOGICAL_MAXIMUM (4095)
+    0x75, 0x0c,                    //     REPORT_SIZE (12)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x09, 0x30,                    //     USAGE (Tip Pressure)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x15, 0xc4,                    //     LOGICAL_MINIMUM (-60)
+    0x25, 0x3c,                    //     LOGICAL_MAXIMUM (60)
+    0x75, 0x07,                    //     REPORT_SIZE (7)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x09, 0x3d,                    //     USAGE (X Tilt)
+    0x09, 0x3e,                    //     USAGE (Y Tilt)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x75, 0x06,                    //     REPORT_SIZE (6)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0xc0,                          //   END_COLLECTION
+    0xc0,                          // END_COLLECTION
+};
+#define HID_REPORT_LENGTH sizeof(hid_report_descriptor)/sizeof(hid_report_descriptor[0])
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[DEVICE_FRAMEWORK_LENGTH_FULL_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No HID client is registered for the device.  */
+    if (error_code == UX_HOST_CLASS_HID_UNKNOWN)
+        return;
+
+    /* Failed test.  */
+    printf("Error on line %d, system_level: %d, system_context: %d, error code: %d\n", __LINE__, system_level, system_context, error_code);
+    test_control_return(1);
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hid_report_decompress_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR *                          stack_pointer;
+CHAR *                          memory_pointer;
+
+    /* Inform user.  */
+    printf("Running HID Report Decompress Benchmark............................. ");
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX. Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    status =  ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_report_descriptor;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+
+    /* Initilize the device hid class. The class is connected with interface 2 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                                1,2, (VOID *)&hid_parameter);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+static ULONG  benchmark_time_us(void)
+{
+
+struct timeval  now;
+
+    gettimeofday(&now, UX_NULL);
+    return((ULONG)now.tv_sec * 1000000ul + (ULONG)now.tv_usec);
+}
+
+static UCHAR  benchmark_random(void)
+{
+
+    /* Reports are filled with a fixed sequence so runs are comparable.  */
+    random_seed = random_seed * 1103515245ul + 12345ul;
+    return((UCHAR)(random_seed >> 16));
+}
+
+/* Reference extraction, values are built bit by bit as the field decompression used to.  */
+static VOID  reference_field_decompress(UX_HOST_CLASS_HID_FIELD *hid_field, UCHAR *report, UX_HOST_CLASS_HID_CLIENT_REPORT *client_report)
+{
+
+ULONG       field_report_count;
+ULONG       field_report_size;
+ULONG       data_offset_byte;
+ULONG       data_offset_bit;
+ULONG       data_offset_bit_in_report;
+ULONG       field_value;
+ULONG       field_value_bit_shifting;
+ULONG       field_usage;
+
+    data_offset_byte =  (hid_field -> ux_host_class_hid_field_report_offset >> 3);
+    data_offset_bit =  hid_field -> ux_host_class_hid_field_report_offset & 7;
+    for (field_report_count = 0; field_report_count < hid_field -> ux_host_class_hid_field_report_count; field_report_count++)
+    {
+        field_report_size =  hid_field -> ux_host_class_hid_field_report_size;
+        data_offset_bit_in_report = data_offset_bit;
+        field_value =  0;
+        field_value_bit_shifting =  0;
+        while (field_report_size-- != 0)
+        {
+            field_value |=  (((ULONG) *(report + data_offset_byte + (data_offset_bit_in_report >> 3)) >> (data_offset_bit_in_report & 7)) & 1) << field_value_bit_shifting;
+            data_offset_bit_in_report++;
+            field_value_bit_shifting++;
+        }
+
+        if (hid_field -> ux_host_class_hid_field_value & UX_HOST_CLASS_HID_ITEM_VARIABLE)
+        {
+            if (hid_field -> ux_host_class_hid_field_usages)
+                field_usage =  *(hid_field -> ux_host_class_hid_field_usages + field_report_count);
+            else
+                field_usage = 0;
+        }
+        else
+        {
+            field_usage =  hid_field -> ux_host_class_hid_field_usage_min + (ULONG)((SLONG)field_value - hid_field -> ux_host_class_hid_field_logical_min);
+            field_usage |=  (hid_field -> ux_host_class_hid_field_usage_page << 16);
+        }
+
+        *(client_report -> ux_host_class_hid_client_report_buffer + client_report -> ux_host_class_hid_client_report_actual_length) =  field_usage;
+        client_report -> ux_host_class_hid_client_report_actual_length++;
+        *(client_report -> ux_host_class_hid_client_report_buffer + client_report -> ux_host_class_hid_client_report_actual_length) =  field_value;
+        client_report -> ux_host_class_hid_client_report_actual_length++;
+        data_offset_bit +=  hid_field -> ux_host_class_hid_field_report_size;
+    }
+}
+
+static VOID  reference_report_decompress(UX_HOST_CLASS_HID_CLIENT_REPORT *client_report, UCHAR *report)
+{
+
+UX_HOST_CLASS_HID_FIELD      *hid_field;
+
+    if (client_report -> ux_host_class_hid_client_report -> ux_host_class_hid_report_id != 0)
+        report++;
+    hid_field =  client_report -> ux_host_class_hid_client_report -> ux_host_class_hid_report_field;
+    while (hid_field != UX_NULL)
+    {
+        reference_field_decompress(hid_field, report, client_report);
+        hid_field =  hid_field -> ux_host_class_hid_field_next_field;
+    }
+}
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                                status;
+UX_HOST_CLASS_HID_REPORT_GET_ID     report_get_id;
+UX_HOST_CLASS_HID_CLIENT_REPORT     client_report;
+UX_HOST_CLASS_HID_CLIENT_REPORT     reference_report;
+UX_HOST_CLASS_HID_REPORT            *hid_report;
+ULONG                               report_length;
+ULONG                               reports;
+ULONG                               i;
+ULONG                               j;
+ULONG                               start_us;
+ULONG                               reference_us;
+ULONG                               decompress_us;
+
+    /* Find the HID class */
+    status = demo_class_hid_get();
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Go through all input reports.  */
+    printf("\n");
+    reports = 0;
+    report_get_id.ux_host_class_hid_report_get_report = UX_NULL;
+    report_get_id.ux_host_class_hid_report_get_type = UX_HOST_CLASS_HID_REPORT_TYPE_INPUT;
+    while (ux_host_class_hid_report_id_get(hid, &report_get_id) == UX_SUCCESS)
+    {
+
+        hid_report = report_get_id.ux_host_class_hid_report_get_report;
+        report_length = hid_report -> ux_host_class_hid_report_byte_length + 1;
+        reports ++;
+
+        client_report.ux_host_class_hid_client_report = hid_report;
+        client_report.ux_host_class_hid_client_report_buffer = values;
+        client_report.ux_host_class_hid_client_report_length = HID_BENCHMARK_VALUES_LENGTH;
+        reference_report = client_report;
+        reference_report.ux_host_class_hid_client_report_buffer = values_reference;
+
+        /* Values are the same as the reference ones.  */
+        for (i = 0; i < HID_BENCHMARK_CHECKS; i ++)
+        {
+            report_buffer[0] = (UCHAR)hid_report -> ux_host_class_hid_report_id;
+            for (j = 1; j < report_length; j ++)
+                report_buffer[j] = benchmark_random();
+
+            client_report.ux_host_class_hid_client_report_actual_length = 0;
+            reference_report.ux_host_class_hid_client_report_actual_length = 0;
+            _ux_host_class_hid_report_decompress(hid, &client_report, report_buffer, report_length);
+            reference_report_decompress(&reference_report, report_buffer);
+            if (client_report.ux_host_class_hid_client_report_actual_length != reference_report.ux_host_class_hid_client_report_actual_length ||
+                client_report.ux_host_class_hid_client_report_actual_length == 0 ||
+                ux_utility_memory_compare(values, values_reference,
+                                          client_report.ux_host_class_hid_client_report_actual_length * sizeof(ULONG)) != UX_SUCCESS)
+            {
+
+                printf("Error on line %d, report %d check %ld\n", __LINE__, hid_report -> ux_host_class_hid_report_id, i);
+                test_control_return(1);
+            }
+        }
+
+        /* Time both extractions on the same report.  */
+        start_us = benchmark_time_us();
+        for (i = 0; i < HID_BENCHMARK_ITERATIONS; i ++)
+        {
+            reference_report.ux_host_class_hid_client_report_actual_length = 0;
+            reference_report_decompress(&reference_report, report_buffer);
+        }
+        reference_us = benchmark_time_us() - start_us;
+
+        start_us = benchmark_time_us();
+        for (i = 0; i < HID_BENCHMARK_ITERATIONS; i ++)
+        {
+            client_report.ux_host_class_hid_client_report_actual_length = 0;
+            _ux_host_class_hid_report_decompress(hid, &client_report, report_buffer, report_length);
+        }
+        decompress_us = benchmark_time_us() - start_us;
+
+        printf("  report %d: %2ld bytes %3ld values, bit by bit %7.1f ns, decompress %7.1f ns\n",
+               hid_report -> ux_host_class_hid_report_id, report_length,
+               client_report.ux_host_class_hid_client_report_actual_length / 2,
+               (double)reference_us * 1000 / HID_BENCHMARK_ITERATIONS,
+               (double)decompress_us * 1000 / HID_BENCHMARK_ITERATIONS);
+    }
+
+    /* All the reports are found.  */
+    if (reports != 4)
+    {
+
+        printf("Error on line %d, %ld reports\n", __LINE__, reports);
+        test_control_return(1);
+    }
+
+    /* Now disconnect the device.  */
+    _ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    status =  ux_device_stack_class_unregister(_ux_system_slave_class_hid_name, ux_device_class_hid_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+static UINT    demo_thread_hid_callback(UX_SLAVE_CLASS_HID *class, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
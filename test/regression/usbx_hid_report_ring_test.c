@@ -0,0 +1,397 @@
+/* This tests the host HID input report ring: reports are dispatched in order
+   by the worker thread of the HID instance with their reception time, the
+   interrupt transfer keeps polling while a client callback is blocked, and
+   reports received while the ring is full are dropped and counted.  */
+
+#include "usbx_test_common_hid.h"
+
+#define RING_TEST_REPORTS_MAX                       32
+
+static UINT                                error_count;
+
+static TX_SEMAPHORE                        ring_gate;
+static volatile ULONG                      ring_gated;
+static volatile ULONG                      ring_reports;
+static UCHAR                               ring_sequence[RING_TEST_REPORTS_MAX];
+static ULONG                               ring_timestamp[RING_TEST_REPORTS_MAX];
+static ULONG                               ring_wrong_thread;
+
+static UCHAR hid_report_descriptor[] = {
+
+    0x06, 0x00, 0xff,              // USAGE_PAGE (Vendor Defined Page 1)
+    0x09, 0x01,                    // USAGE (Vendor Usage 1)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x26, 0xff, 0x00,              //   LOGICAL_MAXIMUM (255)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x95, 0x04,                    //   REPORT_COUNT (4)
+    0x09, 0x01,                    //   USAGE (Vendor Usage 1)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+};
+#define HID_REPORT_LENGTH sizeof(hid_report_descriptor)/sizeof(hid_report_descriptor[0])
+
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 52
+static UCHAR device_framework_full_speed[DEVICE_FRAMEWORK_LENGTH_FULL_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0x81, 0x0A, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 62
+static UCHAR device_framework_high_speed[DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x22, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x02, 0x00, 0x01, 0x03, 0x00, 0x00,
+        0x00,
+
+    /* HID descriptor */
+        0x09, 0x21, 0x10, 0x01, 0x21, 0x01, 0x22, LSB(HID_REPORT_LENGTH),
+        MSB(HID_REPORT_LENGTH),
+
+    /* Endpoint descriptor (Interrupt) */
+        0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0x08
+
+    };
+
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 40
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x55, 0x53, 0x42, 0x20, 0x4b, 0x65, 0x79, 0x62,
+        0x6f, 0x61, 0x72, 0x64,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+
+    /* No HID client is registered for the device.  */
+    if (error_code == UX_HOST_CLASS_HID_UNKNOWN)
+        return;
+
+    error_count ++;
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_hid_report_ring_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR *                          stack_pointer;
+CHAR *                          memory_pointer;
+
+    /* Inform user.  */
+    printf("Running HID Report Ring Test........................................ ");
+#if !defined(UX_HOST_CLASS_HID_REPORT_RING)
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX. Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(UX_NULL);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    status =  ux_host_stack_class_register(_ux_system_host_class_hid_name, ux_host_class_hid_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,UX_NULL);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Initialize the hid class parameters.  */
+    hid_parameter.ux_device_class_hid_parameter_report_address = hid_report_descriptor;
+    hid_parameter.ux_device_class_hid_parameter_report_length  = HID_REPORT_LENGTH;
+    hid_parameter.ux_device_class_hid_parameter_callback       = demo_thread_hid_callback;
+
+    /* Initilize the device hid class. The class is connected with interface 2 */
+    status =  ux_device_stack_class_register(_ux_system_slave_class_hid_name, ux_device_class_hid_entry,
+                                                1,2, (VOID *)&hid_parameter);
+    if(status!=UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_dcd_sim_slave_initialize();
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+
+    /* Check for error.  */
+    if (status != UX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Check for error.  */
+    if (status != TX_SUCCESS)
+    {
+
+        printf("Error on line %d\n", __LINE__);
+        test_control_return(1);
+    }
+}
+
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+static VOID  ring_report_callback(UX_HOST_CLASS_HID_REPORT_CALLBACK *callback)
+{
+ULONG       index = ring_reports;
+
+    /* Reports are dispatched by the worker thread of the instance.  */
+    if (tx_thread_identify() != &hid -> ux_host_class_hid_ring_thread)
+        ring_wrong_thread ++;
+
+    /* Keep the sequence number and the reception time.  */
+    if (index < RING_TEST_REPORTS_MAX)
+    {
+        ring_sequence[index] = *(UCHAR *)callback -> ux_host_class_hid_report_callback_buffer;
+        ring_timestamp[index] = callback -> ux_host_class_hid_report_callback_timestamp;
+    }
+
+    /* Block while the test holds the gate.  */
+    if (ring_gated)
+        tx_semaphore_get(&ring_gate, 500);
+
+    ring_reports = index + 1;
+}
+
+static VOID  ring_event_send(UCHAR sequence)
+{
+UX_SLAVE_CLASS_HID_EVENT    event;
+
+    ux_utility_memory_set(&event, 0, sizeof(event));
+    event.ux_device_class_hid_event_length = 4;
+    event.ux_device_class_hid_event_buffer[0] = sequence;
+    event.ux_device_class_hid_event_buffer[3] = (UCHAR)~sequence;
+    UX_TEST_CHECK_SUCCESS(ux_device_class_hid_event_set(device_hid, &event));
+}
+#endif
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+#if defined(UX_HOST_CLASS_HID_REPORT_RING)
+
+UX_HOST_CLASS_HID_REPORT_GET_ID     report_get_id;
+UX_HOST_CLASS_HID_REPORT_CALLBACK   callback;
+UX_HOST_CLASS_HID_RING_STATISTICS   *statistics;
+ULONG                               start;
+ULONG                               i;
+
+
+    /* Find the HID class */
+    UX_TEST_CHECK_SUCCESS(demo_class_hid_get());
+    statistics = &hid -> ux_host_class_hid_ring_statistics;
+
+    /* The ring is set up and its worker is waiting.  */
+    UX_TEST_ASSERT(hid -> ux_host_class_hid_ring_buffer != UX_NULL);
+    UX_TEST_ASSERT(hid -> ux_host_class_hid_interrupt_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_data_pointer ==
+                   hid -> ux_host_class_hid_ring_slots[0].ux_host_class_hid_ring_slot_buffer);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_received == 0);
+
+    UX_TEST_CHECK_SUCCESS(tx_semaphore_create(&ring_gate, "ring gate", 0));
+
+    /* Register a raw callback on the input report and start polling.  */
+    report_get_id.ux_host_class_hid_report_get_report = UX_NULL;
+    report_get_id.ux_host_class_hid_report_get_type = UX_HOST_CLASS_HID_REPORT_TYPE_INPUT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_id_get(hid, &report_get_id));
+    callback.ux_host_class_hid_report_callback_id =         report_get_id.ux_host_class_hid_report_get_id;
+    callback.ux_host_class_hid_report_callback_function =   ring_report_callback;
+    callback.ux_host_class_hid_report_callback_buffer =     UX_NULL;
+    callback.ux_host_class_hid_report_callback_flags =      UX_HOST_CLASS_HID_REPORT_RAW;
+    callback.ux_host_class_hid_report_callback_length =     4;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_report_callback_register(hid, &callback));
+    UX_TEST_CHECK_SUCCESS(ux_host_class_hid_periodic_report_start(hid));
+
+    /* Device HID instance.  */
+    device_hid = _ux_system_slave -> ux_system_slave_device.ux_slave_device_first_interface -> ux_slave_interface_class_instance;
+
+    /* Reports are dispatched in order, with their reception time.  */
+    start = tx_time_get();
+    for (i = 0; i < 3; i ++)
+        ring_event_send((UCHAR)i);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&ring_reports, 3));
+    for (i = 0; i < 3; i ++)
+    {
+        UX_TEST_ASSERT(ring_sequence[i] == i);
+        UX_TEST_ASSERT(ring_timestamp[i] >= start && ring_timestamp[i] <= tx_time_get());
+    }
+    UX_TEST_ASSERT(ring_wrong_thread == 0);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_received == 3);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_dropped == 0);
+    UX_TEST_ASSERT(hid -> ux_host_class_hid_ring_head == 3 && hid -> ux_host_class_hid_ring_tail == 3);
+
+    /* Block the callback: polling goes on, the ring fills up, then reports are dropped.  */
+    ring_gated = 1;
+    for (i = 0; i < UX_HOST_CLASS_HID_REPORT_RING_DEPTH + 3; i ++)
+        ring_event_send((UCHAR)(0x10 + i));
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&statistics -> ux_host_class_hid_ring_statistics_received,
+                                                       3 + UX_HOST_CLASS_HID_REPORT_RING_DEPTH + 3));
+    UX_TEST_ASSERT(ring_reports == 3);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_dropped == 4);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_pending_high_water == UX_HOST_CLASS_HID_REPORT_RING_DEPTH - 1);
+
+    /* Let the reports wait, then release the callback.  */
+    tx_thread_sleep(5);
+    ring_gated = 0;
+    tx_semaphore_put(&ring_gate);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&ring_reports, 3 + UX_HOST_CLASS_HID_REPORT_RING_DEPTH - 1));
+    for (i = 0; i < UX_HOST_CLASS_HID_REPORT_RING_DEPTH - 1; i ++)
+        UX_TEST_ASSERT(ring_sequence[3 + i] == 0x10 + i);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_latency_max >= 5);
+
+    /* The ring works again once drained.  */
+    ring_event_send(0x40);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong((ULONG *)&ring_reports, 3 + UX_HOST_CLASS_HID_REPORT_RING_DEPTH));
+    UX_TEST_ASSERT(ring_sequence[3 + UX_HOST_CLASS_HID_REPORT_RING_DEPTH - 1] == 0x40);
+    UX_TEST_ASSERT(statistics -> ux_host_class_hid_ring_statistics_dropped == 4);
+    UX_TEST_ASSERT(ring_wrong_thread == 0);
+
+    /* No unexpected errors.  */
+    UX_TEST_ASSERT(error_count == 0);
+
+    /* Now disconnect the device.  */
+    _ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    ux_device_stack_class_unregister(_ux_system_slave_class_hid_name, ux_device_class_hid_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+#endif
+}
+
+static UINT    demo_thread_hid_callback(UX_SLAVE_CLASS_HID *class, UX_SLAVE_CLASS_HID_EVENT *event)
+{
+    return(UX_SUCCESS);
+}
@@ -0,0 +1,567 @@
+/* This test is designed to test ASIX host reception of aggregated bulk IN frames.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "nx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_network_driver.h"
+
+#include "ux_device_class_dummy.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_asix.h"
+
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+#include "ux_test_utility_sim.h"
+
+/* Define constants.  */
+#define                             UX_DEMO_STACK_SIZE      (4*1024)
+#define                             UX_DEMO_MEMORY_SIZE     (128*1024 + UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE * UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_COUNT)
+
+#define                             DEMO_IP_THREAD_STACK_SIZE   (8*1024)
+#define                             HOST_IP_ADDRESS         IP_ADDRESS(192,168,1,176)
+#define                             DEVICE_IP_ADDRESS       IP_ADDRESS(192,168,1,175)
+#define                             HOST_SOCKET_PORT_UDP    45054
+#define                             DEVICE_SOCKET_PORT_UDP  45055
+#define                             PACKET_PAYLOAD          1600
+#define                             PACKET_POOL_SIZE        ((PACKET_PAYLOAD + sizeof(NX_PACKET)) * 64)
+#define                             ARP_MEMORY_SIZE         1024
+
+/* Each bulk IN transfer fills a whole receive buffer, so frames may span transfers.  */
+#define                             TEST_CHUNK_SIZE         UX_HOST_CLASS_ASIX_RECEIVE_BUFFER_SIZE
+#define                             TEST_STREAM_SIZE        (TEST_CHUNK_SIZE * 2 + 4096)
+#define                             TEST_FRAMES_MAX         64
+#define                             TEST_HEADERS_SIZE       (14 + 20 + 8)
+#define                             TEST_FILL_PAYLOAD       1000
+#define                             TEST_FILL_MAX           1200
+#define                             TEST_FILL_MIN           60
+
+/* Define local/extern function prototypes.  */
+static TX_THREAD                           tx_test_thread_host_simulation;
+static TX_THREAD                           tx_test_thread_slave_simulation;
+static VOID                                tx_test_thread_host_simulation_entry(ULONG);
+static VOID                                tx_test_thread_slave_simulation_entry(ULONG);
+
+/* Define global data structures.  */
+static UCHAR                        usbx_memory[UX_DEMO_MEMORY_SIZE + (UX_DEMO_STACK_SIZE * 2)];
+
+static UX_DEVICE                    *device = UX_NULL;
+
+static UX_HOST_CLASS_ASIX           *host_asix = UX_NULL;
+
+static ULONG                        error_callback_counter = 0;
+
+static UX_DEVICE_CLASS_DUMMY                *device_dummy = UX_NULL;
+static UX_DEVICE_CLASS_DUMMY_PARAMETER      device_dummy_parameter;
+
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
+static UCHAR                        device_interrupt_buffer[64];
+static UCHAR                        device_bulk_in_buffer[TEST_CHUNK_SIZE];
+#endif
+
+static NX_IP                        nx_ip_host;
+static NX_PACKET_POOL               ip_pool_host;
+static NX_UDP_SOCKET                udp_socket_host;
+static UCHAR                        packet_pool_memory_host[PACKET_POOL_SIZE];
+static UCHAR                        ip_thread_stack_host[DEMO_IP_THREAD_STACK_SIZE];
+static UCHAR                        arp_memory_host[ARP_MEMORY_SIZE];
+
+static UCHAR                        test_stream[TEST_STREAM_SIZE];
+static ULONG                        test_stream_length;
+static ULONG                        test_frame_payload[TEST_FRAMES_MAX];
+static ULONG                        test_frames;
+static ULONG                        test_split_header_frame;
+static UCHAR                        test_buffer[PACKET_PAYLOAD];
+
+
+/* Define device framework.  */
+
+#define _W0(w)      ( (w)       & 0xFF)
+#define _W1(w)      (((w) >> 8) & 0xFF)
+
+#define _CONFIGURATION_DESCRIPTOR(total_len, n_ifc, cfg_val)                    \
+    0x09, 0x02, _W0(total_len), _W1(total_len), (n_ifc), (cfg_val),             \
+    0x00, 0xc0, 0x32,
+
+#define _INTERFACE_DESCRIPTOR(ifc_n, alt, n_ep, cls, sub, protocol)             \
+    0x09, 0x04, (ifc_n), (alt), (n_ep), (cls), (sub), (protocol), 0x00,
+
+#define _ENDPOINT_DESCRIPTOR(addr, attr, pktsize, interval)                     \
+    0x07, 0x05, (addr), (attr), _W0(pktsize), _W1(pktsize), (interval),
+
+#define _CFG_TOTAL_LEN (9+9+7+7+7+7)
+
+#define             STRING_FRAMEWORK_LENGTH                 47
+#define             LANGUAGE_ID_FRAMEWORK_LENGTH            2
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes, ASIX VID/PID.  */
+    0x12, 0x01, 0x10, 0x02,
+    0x00, 0x00, 0x00,
+    0x40,
+    0x95, 0x0B,
+    0x2B, 0x77,
+    0x00, 0x02,
+    0x01, 0x02, 0x03,
+    0x01,
+
+    _CONFIGURATION_DESCRIPTOR(_CFG_TOTAL_LEN, 1, 1)
+    _INTERFACE_DESCRIPTOR(0, 0, 4, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x81, 0x03, 16, 0x0B)
+    _ENDPOINT_DESCRIPTOR(0x82, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x03, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x05, 0x02, 64, 0x00)
+};
+
+#define             DEVICE_FRAMEWORK_LENGTH_FULL_SPEED      sizeof(device_framework_full_speed)
+#define             DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED      sizeof(device_framework_full_speed)
+#define             device_framework_high_speed             device_framework_full_speed
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "AzureRTOS" */
+    0x09, 0x04, 0x01, 9,
+        'A','z','u','r','e','R','T','O','S',
+
+    /* Product string descriptor : Index 2 - "Test device" */
+    0x09, 0x04, 0x02, 14,
+        'T','e','s','t',' ',' ',' ',' ','d','e','v','i','c','e',
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+    0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+};
+
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+};
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static UINT test_slave_change_function(ULONG change)
+{
+    return 0;
+}
+
+static UINT test_host_change_function(ULONG event, UX_HOST_CLASS *cls, VOID *inst)
+{
+
+UX_HOST_CLASS_ASIX *asix_inst = (UX_HOST_CLASS_ASIX *) inst;
+
+    switch(event)
+    {
+
+    case UX_DEVICE_INSERTION:
+        host_asix = asix_inst;
+        break;
+
+    case UX_DEVICE_REMOVAL:
+        if (host_asix == asix_inst)
+            host_asix = UX_NULL;
+        break;
+
+    case UX_DEVICE_CONNECTION:
+        device = (UX_DEVICE *)inst;
+        break;
+
+    case UX_DEVICE_DISCONNECTION:
+        if ((VOID *)device == inst)
+            device = UX_NULL;
+        break;
+
+    default:
+        break;
+    }
+    return 0;
+}
+
+static VOID    test_dummy_instance_activate(VOID *dummy_instance)
+{
+    if (device_dummy == UX_NULL)
+    {
+        device_dummy = (UX_DEVICE_CLASS_DUMMY *)dummy_instance;
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
+
+        /* Endpoint buffers are owned by the class.  */
+        _ux_device_class_dummy_get_transfer_request(device_dummy, 0x81) -> ux_slave_transfer_request_data_pointer = device_interrupt_buffer;
+        _ux_device_class_dummy_get_transfer_request(device_dummy, 0x82) -> ux_slave_transfer_request_data_pointer = device_bulk_in_buffer;
+#endif
+    }
+}
+static VOID    test_dummy_instance_deactivate(VOID *dummy_instance)
+{
+    if ((VOID*)device_dummy == dummy_instance)
+        device_dummy = UX_NULL;
+}
+static VOID    test_dummy_control_request(UX_DEVICE_CLASS_DUMMY *dummy_instance, UX_SLAVE_TRANSFER *transfer_request)
+{
+ULONG cmd_type = transfer_request -> ux_slave_transfer_request_setup[0] |
+            (transfer_request -> ux_slave_transfer_request_setup[1] << 8);
+ULONG cmd_length = transfer_request -> ux_slave_transfer_request_setup[6] |
+            (transfer_request -> ux_slave_transfer_request_setup[7] << 8);
+UCHAR *cmd_buf = transfer_request -> ux_slave_transfer_request_data_pointer;
+
+    if (device_dummy != dummy_instance)
+        return;
+
+    /* OUT requests are accepted.  */
+    if ((cmd_type & UX_REQUEST_IN) == 0)
+        return;
+
+    _ux_utility_memory_set(cmd_buf, 0, cmd_length);
+    switch(cmd_type)
+    {
+    case 0x19c0: /* READ_PHY_ID  */
+    case 0x07c0: /* READ_PHY_REG  */
+        cmd_buf[0] = 0x01;
+        break;
+
+    case 0x13c0: /* READ_NODE_ID  */
+        cmd_buf[0] = 0x01;
+        cmd_buf[1] = 0x02;
+        cmd_buf[2] = 0x03;
+        cmd_buf[3] = 0x04;
+        cmd_buf[4] = 0x05;
+        cmd_buf[5] = 0x06;
+        break;
+
+    default:
+        break;
+    }
+    ux_device_stack_transfer_request(transfer_request, cmd_length, cmd_length);
+}
+
+static VOID test_ux_error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    error_callback_counter ++;
+}
+
+static UCHAR _test_payload_byte(ULONG frame, ULONG offset)
+{
+    return((UCHAR)(frame * 7 + offset));
+}
+
+/* Append one ASIX framed UDP datagram to the bulk IN stream.  */
+static VOID _test_frame_append(ULONG payload_length)
+{
+
+UCHAR       *asix_header = test_stream + test_stream_length;
+UCHAR       *frame = asix_header + 4;
+UCHAR       *ip = frame + 14;
+UCHAR       *udp = ip + 20;
+ULONG       frame_length = TEST_HEADERS_SIZE + payload_length;
+ULONG       checksum;
+ULONG       i;
+
+    UX_TEST_ASSERT(test_frames < TEST_FRAMES_MAX);
+    UX_TEST_ASSERT(test_stream_length + 4 + frame_length + 1 <= TEST_STREAM_SIZE);
+
+    /* ASIX header: length and its complement.  */
+    _ux_utility_short_put(asix_header, (USHORT)frame_length);
+    _ux_utility_short_put(asix_header + 2, (USHORT)~frame_length);
+
+    /* Ethernet header.  */
+    _ux_utility_memory_set(frame, 0xFF, 6);
+    frame[6] = 0x02; frame[7] = 0x00; frame[8] = 0x00;
+    frame[9] = 0x00; frame[10] = 0x00; frame[11] = 0x01;
+    _ux_utility_short_put_big_endian(frame + 12, 0x0800);
+
+    /* IPv4 header.  */
+    _ux_utility_memory_set(ip, 0, 20);
+    ip[0] = 0x45;
+    _ux_utility_short_put_big_endian(ip + 2, (USHORT)(frame_length - 14));
+    ip[8] = 0x40;
+    ip[9] = 0x11;
+    _ux_utility_long_put_big_endian(ip + 12, DEVICE_IP_ADDRESS);
+    _ux_utility_long_put_big_endian(ip + 16, HOST_IP_ADDRESS);
+    checksum = 0;
+    for (i = 0; i < 20; i += 2)
+        checksum += _ux_utility_short_get_big_endian(ip + i);
+    while (checksum >> 16)
+        checksum = (checksum & 0xFFFF) + (checksum >> 16);
+    _ux_utility_short_put_big_endian(ip + 10, (USHORT)~checksum);
+
+    /* UDP header, no checksum.  */
+    _ux_utility_short_put_big_endian(udp, DEVICE_SOCKET_PORT_UDP);
+    _ux_utility_short_put_big_endian(udp + 2, HOST_SOCKET_PORT_UDP);
+    _ux_utility_short_put_big_endian(udp + 4, (USHORT)(8 + payload_length));
+    _ux_utility_short_put_big_endian(udp + 6, 0);
+
+    /* Payload.  */
+    for (i = 0; i < payload_length; i ++)
+        udp[8 + i] = _test_payload_byte(test_frames, i);
+
+    /* Odd frame is padded to 16-bit.  */
+    test_stream_length += 4 + frame_length;
+    if (frame_length & 1u)
+        test_stream[test_stream_length ++] = 0;
+
+    test_frame_payload[test_frames ++] = payload_length;
+}
+
+static VOID _test_stream_build(VOID)
+{
+
+ULONG       remain;
+
+    test_stream_length = 0;
+    test_frames = 0;
+
+    /* Several frames aggregated in first transfer, odd ones padded.  */
+    _test_frame_append(33);
+    _test_frame_append(101);
+    _test_frame_append(7);
+    _test_frame_append(64);
+
+    /* Large frames, may span transfers, until the transfer end is close.  */
+    remain = TEST_CHUNK_SIZE - (test_stream_length % TEST_CHUNK_SIZE);
+    while (remain > TEST_FILL_MAX || remain < TEST_FILL_MIN)
+    {
+        _test_frame_append(TEST_FILL_PAYLOAD);
+        remain = TEST_CHUNK_SIZE - (test_stream_length % TEST_CHUNK_SIZE);
+    }
+
+    /* Frame that leaves 2 bytes before the transfer end.  */
+    _test_frame_append(remain - 4 - 2 - TEST_HEADERS_SIZE);
+    UX_TEST_ASSERT(TEST_CHUNK_SIZE - (test_stream_length % TEST_CHUNK_SIZE) == 2);
+
+    /* Frame whose ASIX header is split across two transfers.  */
+    test_split_header_frame = test_frames;
+    _test_frame_append(200);
+
+    /* Tail frames, the last transfer is a short one.  */
+    _test_frame_append(150);
+    while ((test_stream_length % TEST_CHUNK_SIZE) == 0 ||
+           ((test_stream_length % TEST_CHUNK_SIZE) % 64) == 0)
+        _test_frame_append(20);
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_host_class_asix_receive_aggregate_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT                    status;
+CHAR *                  stack_pointer;
+CHAR *                  memory_pointer;
+
+
+    printf("Running Host ASIX Aggregated Receive Test........................... ");
+
+#if (UX_DEVICE_ENDPOINT_BUFFER_OWNER == 0) && (TEST_CHUNK_SIZE > UX_SLAVE_REQUEST_DATA_MAX_LENGTH)
+    printf("SKIP SUCCESS!\n");
+    test_control_return(0);
+    return;
+#endif
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_system_initialize failed 0x%x\n", status);
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(test_ux_error_callback);
+
+    /* Perform the initialization of the network driver. */
+    status = ux_network_driver_init();
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_network_driver_init failed 0x%x\n", status);
+
+    /* Initialize the NetX system. */
+    nx_system_initialize();
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(test_host_change_function);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_initialize failed 0x%x\n", status);
+
+    /* Register ASIX class.  */
+    status =  ux_host_stack_class_register(_ux_system_host_class_asix_name, _ux_host_class_asix_entry);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_class_register failed 0x%x\n", status);
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,
+                                       test_slave_change_function);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_device_stack_initialize failed 0x%x\n", status);
+
+    /* Set the parameters for callback when insertion/extraction of a dummy device.  */
+    _ux_utility_memory_set(&device_dummy_parameter, 0, sizeof(device_dummy_parameter));
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_instance_activate   = test_dummy_instance_activate;
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_instance_deactivate = test_dummy_instance_deactivate;
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_control_request =     test_dummy_control_request;
+    status  = ux_device_stack_class_register(_ux_device_class_dummy_name,
+                                             _ux_device_class_dummy_entry,
+                                             1, 0, &device_dummy_parameter);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_device_stack_class_register failed 0x%x\n", status);
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_test_dcd_sim_slave_initialize();
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "_ux_test_dcd_sim_slave_initialize failed 0x%x\n", status);
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_test_hcd_sim_host_initialize,0,0);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_hcd_register failed 0x%x\n", status);
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_test_thread_host_simulation, "tx test host simulation", tx_test_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_ASSERT_MESSAGE(status == TX_SUCCESS, "tx_thread_create failed 0x%x\n", status);
+
+    /* Create the main slave simulation  thread.  */
+    stack_pointer += UX_DEMO_STACK_SIZE;
+    status =  tx_thread_create(&tx_test_thread_slave_simulation, "tx test slave simulation", tx_test_thread_slave_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_ASSERT_MESSAGE(status == TX_SUCCESS, "tx_thread_create failed 0x%x\n", status);
+
+}
+
+static UINT _test_check_host_connection_success(VOID)
+{
+    if (device_dummy && host_asix)
+        return(UX_SUCCESS);
+    return(UX_ERROR);
+}
+
+static UINT _test_check_host_disconnection_success(VOID)
+{
+    if (device_dummy == UX_NULL && host_asix == UX_NULL)
+        return(UX_SUCCESS);
+    return(UX_ERROR);
+}
+
+static UINT _test_check_host_link_up(VOID)
+{
+    if (host_asix -> ux_host_class_asix_link_state == UX_HOST_CLASS_ASIX_LINK_STATE_UP)
+        return(UX_SUCCESS);
+    return(UX_ERROR);
+}
+
+void  tx_test_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                                                status;
+ULONG                                               offset;
+ULONG                                               length;
+ULONG                                               actual_length;
+ULONG                                               frame;
+ULONG                                               i;
+UCHAR                                               notification[16];
+UX_SLAVE_TRANSFER                                   *transfer;
+NX_PACKET                                           *packet;
+
+
+    /* Create the host IP instance.  */
+    status = nx_packet_pool_create(&ip_pool_host, "NetX Host IP Pool", PACKET_PAYLOAD, packet_pool_memory_host, PACKET_POOL_SIZE);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+    status = nx_ip_create(&nx_ip_host, "NetX Host Thread", HOST_IP_ADDRESS, 0xFF000000UL,
+                          &ip_pool_host, _ux_network_driver_entry, ip_thread_stack_host, DEMO_IP_THREAD_STACK_SIZE, 1);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+    status = nx_arp_enable(&nx_ip_host, (void *)arp_memory_host, ARP_MEMORY_SIZE);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+    status = nx_udp_enable(&nx_ip_host);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+    status = nx_udp_socket_create(&nx_ip_host, &udp_socket_host, "USB HOST UDP SOCKET", NX_IP_NORMAL, NX_DONT_FRAGMENT, 20, TEST_FRAMES_MAX);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+    status = nx_udp_socket_bind(&udp_socket_host, HOST_SOCKET_PORT_UDP, NX_NO_WAIT);
+    UX_TEST_ASSERT(status == NX_SUCCESS);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test connect\n");
+    ux_test_dcd_sim_slave_connect(UX_FULL_SPEED_DEVICE);
+    ux_test_hcd_sim_host_connect(UX_FULL_SPEED_DEVICE);
+    status = ux_test_sleep_break_on_success(100, _test_check_host_connection_success);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test link up\n");
+    _ux_utility_memory_set(notification, 0, sizeof(notification));
+    notification[UX_HOST_CLASS_ASIX_INTERRUPT_SIGNATURE_OFFSET] = UX_HOST_CLASS_ASIX_INTERRUPT_SIGNATURE_VALUE;
+    notification[UX_HOST_CLASS_ASIX_INTERRUPT_STATE_OFFSET] = UX_HOST_CLASS_ASIX_INTERRUPT_STATE_PPLS;
+    status = _ux_device_class_dummy_transfer(device_dummy, 0x81, notification, sizeof(notification), &actual_length);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    status = ux_test_sleep_break_on_success(100, _test_check_host_link_up);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test aggregated bulk IN\n");
+    _test_stream_build();
+    transfer = _ux_device_class_dummy_get_transfer_request(device_dummy, 0x82);
+    for (offset = 0; offset < test_stream_length; offset += length)
+    {
+
+        /* Full transfers, then a short one ends the stream.  */
+        length = test_stream_length - offset;
+        if (length > TEST_CHUNK_SIZE)
+            length = TEST_CHUNK_SIZE;
+        _ux_utility_memory_copy(transfer -> ux_slave_transfer_request_data_pointer, test_stream + offset, length);
+        status = ux_device_stack_transfer_request(transfer, length, length);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+    }
+
+    /* All frames are received in order, including the one with split header.  */
+    for (frame = 0; frame < test_frames; frame ++)
+    {
+        status = nx_udp_socket_receive(&udp_socket_host, &packet, 100);
+        UX_TEST_ASSERT_MESSAGE(status == NX_SUCCESS, "frame %ld (split header at %ld) not received\n", frame, test_split_header_frame);
+        status = nx_packet_data_retrieve(packet, test_buffer, &actual_length);
+        UX_TEST_ASSERT(status == NX_SUCCESS);
+        UX_TEST_ASSERT_MESSAGE(actual_length == test_frame_payload[frame], "frame %ld length %ld\n", frame, actual_length);
+        for (i = 0; i < actual_length; i ++)
+        {
+            UX_TEST_ASSERT_MESSAGE(test_buffer[i] == _test_payload_byte(frame, i), "frame %ld data error at %ld\n", frame, i);
+        }
+        nx_packet_release(packet);
+    }
+    status = nx_udp_socket_receive(&udp_socket_host, &packet, 10);
+    UX_TEST_ASSERT(status == NX_NO_PACKET);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test disconnect\n");
+    ux_test_dcd_sim_slave_disconnect();
+    ux_test_hcd_sim_host_disconnect();
+    status = ux_test_sleep_break_on_success(100, _test_check_host_disconnection_success);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* Finally disconnect the device. */
+    ux_device_stack_disconnect();
+
+    /* And deinitialize the class.  */
+    status  = ux_device_stack_class_unregister(_ux_device_class_dummy_name, _ux_device_class_dummy_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+
+}
+
+void  tx_test_thread_slave_simulation_entry(ULONG arg)
+{
+
+    while(1)
+    {
+
+        /* Sleep so ThreadX on Win32 will delete this thread. */
+        tx_thread_sleep(10);
+    }
+}
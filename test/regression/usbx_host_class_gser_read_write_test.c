@@ -0,0 +1,114 @@
+/* This test is designed to test the generic serial host class data transfers:
+   read and write on each interface, then the streaming reception of an
+   interface, with its overflow, and the port statistics.  */
+
+#include "ux_api.h"
+#include "ux_host_class_gser.h"
+
+#define                             TEST_STREAM_INTERFACE   1
+
+#define UX_TEST_SERIAL_HOST_CLASS           UX_HOST_CLASS_GSER
+#define UX_TEST_SERIAL_INTERFACE_COUNT      UX_HOST_CLASS_GSER_INTERFACE_NUMBER
+#define UX_TEST_SERIAL_WRITE(i,b,l,a)       ux_host_class_gser_write(host_serial, (i), (b), (l), (a))
+#define UX_TEST_SERIAL_READ(i,b,l,a)        ux_host_class_gser_read(host_serial, (i), (b), (l), (a))
+#define UX_TEST_SERIAL_SPAN_GET(i,b,l)      ux_host_class_gser_reception_span_get(host_serial, (i), (b), (l))
+#define UX_TEST_SERIAL_SPAN_RELEASE(i,l)    ux_host_class_gser_reception_span_release(host_serial, (i), (l))
+#define UX_TEST_SERIAL_STREAM               reception.ux_host_class_gser_reception_stream
+
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+#define TEST_STATISTICS_CHECK(i, field, value)  \
+    UX_TEST_ASSERT(host_serial -> ux_host_class_gser_interface_array[i].ux_host_class_gser_statistics.ux_host_class_serial_statistics_##field == (value))
+#else
+#define TEST_STATISTICS_CHECK(i, field, value)
+#endif
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static UX_HOST_CLASS_GSER_RECEPTION reception;
+#endif
+
+#include "usbx_ux_test_serial.h"
+
+
+#define _CFG_TOTAL_LEN (9+(9+7+7)*3)
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    /* REF: 0x05c6 0x9002  */
+    0x12, 0x01, 0x10, 0x02,
+    0x00, 0x00, 0x00,
+    0x40,
+    0xc6, 0x05,
+    0x02, 0x90,
+    0x00, 0x02,
+    0x01, 0x02, 0x03,
+    0x01,
+
+    /* REF: CFG (IFC BI BO) * 3 */
+    _CONFIGURATION_DESCRIPTOR(_CFG_TOTAL_LEN, 3, 1)
+    _INTERFACE_DESCRIPTOR(0, 0, 2, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x81, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x02, 0x02, 64, 0x00)
+    _INTERFACE_DESCRIPTOR(1, 0, 2, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x83, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x04, 0x02, 64, 0x00)
+    _INTERFACE_DESCRIPTOR(2, 0, 2, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x85, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x06, 0x02, 64, 0x00)
+};
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_host_class_gser_read_write_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    printf("Running Host GSER Read Write Test................................... ");
+    stepinfo("\n");
+
+    ux_test_serial_initialize(device_framework_full_speed, sizeof(device_framework_full_speed),
+                              _ux_system_host_class_gser_name, _ux_host_class_gser_entry,
+                              UX_NULL);
+}
+
+static VOID test_host_serial(VOID)
+{
+
+ULONG                                               interface_number;
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UCHAR                                               *span_buffer;
+ULONG                                               span_length;
+#endif
+
+
+    for (interface_number = 0; interface_number < UX_HOST_CLASS_GSER_INTERFACE_NUMBER; interface_number ++)
+        _test_write_read(interface_number, (UCHAR)('a' + interface_number));
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream start\n");
+    reception.ux_host_class_gser_reception_interface_index = TEST_STREAM_INTERFACE;
+    reception.ux_host_class_gser_reception_block_size = TEST_BLOCK_SIZE;
+    reception.ux_host_class_gser_reception_data_buffer = reception_buffer;
+    reception.ux_host_class_gser_reception_data_buffer_size = TEST_BUFFER_SIZE;
+    reception.ux_host_class_gser_reception_callback = _test_reception_callback;
+    reception.ux_host_class_gser_reception_transfer_count = TEST_TRANSFER_COUNT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_gser_reception_start(host_serial, &reception));
+    UX_TEST_ASSERT(host_serial -> ux_host_class_gser_interface_array[TEST_STREAM_INTERFACE].ux_host_class_gser_bulk_in_endpoint -> ux_endpoint_transfer_requests_count == TEST_TRANSFER_COUNT);
+
+    /* Other interfaces are not streaming.  */
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_gser_reception_span_get(host_serial, 0, &span_buffer, &span_length));
+
+    _test_stream_receive(TEST_STREAM_INTERFACE);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream stop\n");
+    UX_TEST_CHECK_SUCCESS(ux_host_class_gser_reception_stop(host_serial, &reception));
+    UX_TEST_ASSERT(reception.ux_host_class_gser_reception_state == UX_HOST_CLASS_GSER_RECEPTION_STATE_STOPPED);
+    UX_TEST_ASSERT(host_serial -> ux_host_class_gser_interface_array[TEST_STREAM_INTERFACE].ux_host_class_gser_bulk_in_endpoint -> ux_endpoint_transfer_requests == UX_NULL);
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_gser_reception_span_get(host_serial, TEST_STREAM_INTERFACE, &span_buffer, &span_length));
+#endif
+}
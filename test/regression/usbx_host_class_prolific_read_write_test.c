@@ -0,0 +1,129 @@
+/* This test is designed to test the prolific host class data transfers: read
+   and write, then the streaming reception, with its overflow, and the port
+   statistics.  */
+
+#include "ux_api.h"
+#include "ux_host_class_prolific.h"
+
+#define UX_TEST_SERIAL_HOST_CLASS           UX_HOST_CLASS_PROLIFIC
+#define UX_TEST_SERIAL_ENDPOINT_IN(i)       0x82
+#define UX_TEST_SERIAL_ENDPOINT_OUT(i)      0x03
+#define UX_TEST_SERIAL_WRITE(i,b,l,a)       ux_host_class_prolific_write(host_serial, (b), (l), (a))
+#define UX_TEST_SERIAL_READ(i,b,l,a)        ux_host_class_prolific_read(host_serial, (b), (l), (a))
+#define UX_TEST_SERIAL_SPAN_GET(i,b,l)      ux_host_class_prolific_reception_span_get(host_serial, (b), (l))
+#define UX_TEST_SERIAL_SPAN_RELEASE(i,l)    ux_host_class_prolific_reception_span_release(host_serial, (l))
+#define UX_TEST_SERIAL_STREAM               reception.ux_host_class_prolific_reception_stream
+
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+#define TEST_STATISTICS_CHECK(i, field, value)  \
+    UX_TEST_ASSERT(host_serial -> ux_host_class_prolific_statistics.ux_host_class_serial_statistics_##field == (value))
+#else
+#define TEST_STATISTICS_CHECK(i, field, value)
+#endif
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static UX_HOST_CLASS_PROLIFIC_RECEPTION reception;
+#endif
+
+#include "usbx_ux_test_serial.h"
+
+
+#define _CFG_TOTAL_LEN (9+9+7+7+7)
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    /* REF: 0x067b, 0x2303  */
+    0x12, 0x01, 0x10, 0x02,
+    0x00, 0x00, 0x00,
+    0x40,
+    0x7B, 0x06,
+    0x03, 0x23,
+    0x00, 0x02,
+    0x01, 0x02, 0x03,
+    0x01,
+
+    /* REF: CFG IFC II BI BO */
+    _CONFIGURATION_DESCRIPTOR(_CFG_TOTAL_LEN, 1, 1)
+    _INTERFACE_DESCRIPTOR(0, 0, 3, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x81, 0x03, 16, 0x0B)
+    _ENDPOINT_DESCRIPTOR(0x82, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x03, 0x02, 64, 0x00)
+};
+
+static VOID    test_dummy_control_request(UX_DEVICE_CLASS_DUMMY *dummy_instance, UX_SLAVE_TRANSFER *transfer_request)
+{
+ULONG cmd_type = transfer_request -> ux_slave_transfer_request_setup[0] |
+            (transfer_request -> ux_slave_transfer_request_setup[1] << 8);
+UCHAR *cmd_buf = transfer_request -> ux_slave_transfer_request_data_pointer;
+
+    if (device_dummy[0] != dummy_instance)
+        return;
+
+    switch(cmd_type)
+    {
+    case 0x01c0: /* Vendor read.  */
+        cmd_buf[0] = 0x00;
+        ux_device_stack_transfer_request(transfer_request, 1, 1);
+        return;
+
+    case 0x0140: /* Vendor write.  */
+    case 0x2021: /* SET_LINE_CODING.  */
+    case 0x2221: /* SET_CONTROL_LINE_STATE.  */
+        return;
+
+    default:
+        ux_device_stack_endpoint_stall(transfer_request -> ux_slave_transfer_request_endpoint);
+        break;
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_host_class_prolific_read_write_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    printf("Running Host PROLIFIC Read Write Test............................... ");
+    stepinfo("\n");
+
+    ux_test_serial_initialize(device_framework_full_speed, sizeof(device_framework_full_speed),
+                              _ux_system_host_class_prolific_name, ux_host_class_prolific_entry,
+                              test_dummy_control_request);
+}
+
+static VOID test_host_serial(VOID)
+{
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UCHAR                                               *span_buffer;
+ULONG                                               span_length;
+#endif
+
+
+    _test_write_read(0, 'a');
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream start\n");
+    reception.ux_host_class_prolific_reception_block_size = TEST_BLOCK_SIZE;
+    reception.ux_host_class_prolific_reception_data_buffer = reception_buffer;
+    reception.ux_host_class_prolific_reception_data_buffer_size = TEST_BUFFER_SIZE;
+    reception.ux_host_class_prolific_reception_callback = _test_reception_callback;
+    reception.ux_host_class_prolific_reception_transfer_count = TEST_TRANSFER_COUNT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_prolific_reception_start(host_serial, &reception));
+    UX_TEST_ASSERT(host_serial -> ux_host_class_prolific_bulk_in_endpoint -> ux_endpoint_transfer_requests_count == TEST_TRANSFER_COUNT);
+
+    _test_stream_receive(0);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream stop\n");
+    UX_TEST_CHECK_SUCCESS(ux_host_class_prolific_reception_stop(host_serial, &reception));
+    UX_TEST_ASSERT(reception.ux_host_class_prolific_reception_state == UX_HOST_CLASS_PROLIFIC_RECEPTION_STATE_STOPPED);
+    UX_TEST_ASSERT(host_serial -> ux_host_class_prolific_bulk_in_endpoint -> ux_endpoint_transfer_requests == UX_NULL);
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_prolific_reception_span_get(host_serial, &span_buffer, &span_length));
+#endif
+}
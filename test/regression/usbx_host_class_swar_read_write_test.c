@@ -0,0 +1,103 @@
+/* This test is designed to test the sierra wireless host class data
+   transfers: read and write, then the streaming reception, with its overflow,
+   and the port statistics.  */
+
+#include "ux_api.h"
+#include "ux_host_class_swar.h"
+
+#define UX_TEST_SERIAL_HOST_CLASS           UX_HOST_CLASS_SWAR
+#define UX_TEST_SERIAL_INTERFACE_FIRST      UX_HOST_CLASS_SWAR_DATA_INTERFACE
+#define UX_TEST_SERIAL_WRITE(i,b,l,a)       ux_host_class_swar_write(host_serial, (b), (l), (a))
+#define UX_TEST_SERIAL_READ(i,b,l,a)        ux_host_class_swar_read(host_serial, (b), (l), (a))
+#define UX_TEST_SERIAL_SPAN_GET(i,b,l)      ux_host_class_swar_reception_span_get(host_serial, (b), (l))
+#define UX_TEST_SERIAL_SPAN_RELEASE(i,l)    ux_host_class_swar_reception_span_release(host_serial, (l))
+#define UX_TEST_SERIAL_STREAM               reception.ux_host_class_swar_reception_stream
+
+#if defined(UX_HOST_CLASS_SERIAL_STATISTICS_SUPPORT)
+#define TEST_STATISTICS_CHECK(i, field, value)  \
+    UX_TEST_ASSERT(host_serial -> ux_host_class_swar_statistics.ux_host_class_serial_statistics_##field == (value))
+#else
+#define TEST_STATISTICS_CHECK(i, field, value)
+#endif
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static UX_HOST_CLASS_SWAR_RECEPTION reception;
+#endif
+
+#include "usbx_ux_test_serial.h"
+
+
+#define _CFG_TOTAL_LEN (9+9*3+(9+7+7))
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    /* REF: VID 1199, PID 68A3  */
+    0x12, 0x01, 0x10, 0x02,
+    0x00, 0x00, 0x00,
+    0x40,
+    0x99, 0x11,
+    0xA3, 0x68,
+    0x00, 0x02,
+    0x01, 0x02, 0x03,
+    0x01,
+
+    /* REF: CFG IFC IFC IFC (IFC BI BO), data is on the fourth interface */
+    _CONFIGURATION_DESCRIPTOR(_CFG_TOTAL_LEN, 4, 1)
+    _INTERFACE_DESCRIPTOR(0, 0, 0, 0xFF, 0xFF, 0x00)
+    _INTERFACE_DESCRIPTOR(1, 0, 0, 0xFF, 0xFF, 0x00)
+    _INTERFACE_DESCRIPTOR(2, 0, 0, 0xFF, 0xFF, 0x00)
+    _INTERFACE_DESCRIPTOR(UX_HOST_CLASS_SWAR_DATA_INTERFACE, 0, 2, 0xFF, 0xFF, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x81, 0x02, 64, 0x00)
+    _ENDPOINT_DESCRIPTOR(0x02, 0x02, 64, 0x00)
+};
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_host_class_swar_read_write_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    printf("Running Host SWAR Read Write Test................................... ");
+    stepinfo("\n");
+
+    ux_test_serial_initialize(device_framework_full_speed, sizeof(device_framework_full_speed),
+                              _ux_system_host_class_swar_name, ux_host_class_swar_entry,
+                              UX_NULL);
+}
+
+static VOID test_host_serial(VOID)
+{
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+UCHAR                                               *span_buffer;
+ULONG                                               span_length;
+#endif
+
+
+    _test_write_read(0, 'a');
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream start\n");
+    reception.ux_host_class_swar_reception_block_size = TEST_BLOCK_SIZE;
+    reception.ux_host_class_swar_reception_data_buffer = reception_buffer;
+    reception.ux_host_class_swar_reception_data_buffer_size = TEST_BUFFER_SIZE;
+    reception.ux_host_class_swar_reception_callback = _test_reception_callback;
+    reception.ux_host_class_swar_reception_transfer_count = TEST_TRANSFER_COUNT;
+    UX_TEST_CHECK_SUCCESS(ux_host_class_swar_reception_start(host_serial, &reception));
+    UX_TEST_ASSERT(host_serial -> ux_host_class_swar_bulk_in_endpoint -> ux_endpoint_transfer_requests_count == TEST_TRANSFER_COUNT);
+
+    _test_stream_receive(0);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream stop\n");
+    UX_TEST_CHECK_SUCCESS(ux_host_class_swar_reception_stop(host_serial, &reception));
+    UX_TEST_ASSERT(reception.ux_host_class_swar_reception_state == UX_HOST_CLASS_SWAR_RECEPTION_STATE_STOPPED);
+    UX_TEST_ASSERT(host_serial -> ux_host_class_swar_bulk_in_endpoint -> ux_endpoint_transfer_requests == UX_NULL);
+    UX_TEST_CHECK_CODE(UX_ERROR, ux_host_class_swar_reception_span_get(host_serial, &span_buffer, &span_length));
+#endif
+}
@@ -0,0 +1,585 @@
+/* This test is designed to test multiple transfer requests queued on a host
+   endpoint: they complete in order, they are aborted together in array order
+   with the endpoint transfer abort and the endpoint reset, each one completes
+   with the stall while the endpoint is halted, and they are freed.  */
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_host_stack.h"
+#include "ux_host_class_dpump.h"
+#include "ux_device_class_dpump.h"
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+
+
+/* Define USBX demo constants.  */
+
+#define UX_DEMO_STACK_SIZE      4096
+#define UX_DEMO_MEMORY_SIZE     (64*1024)
+
+#define TEST_REQUESTS_COUNT     4
+#define TEST_WAIT_TICKS         200
+
+
+/* Define USBX test global variables.  */
+
+static unsigned char                   host_out_buffer[TEST_REQUESTS_COUNT][UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+static unsigned char                   host_in_buffer[TEST_REQUESTS_COUNT][UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+static unsigned char                   slave_buffer[UX_HOST_CLASS_DPUMP_PACKET_SIZE];
+
+static UX_HOST_CLASS_DPUMP             *dpump;
+static UX_SLAVE_CLASS_DPUMP            *dpump_slave;
+
+static UINT                             expected_error;
+
+static UX_TRANSFER                     *in_requests;
+static UX_TRANSFER                     *out_requests;
+static UX_TRANSFER                     *completed[TEST_REQUESTS_COUNT * 2];
+static ULONG                            completed_count;
+
+#define DEVICE_FRAMEWORK_LENGTH_FULL_SPEED 50
+static UCHAR device_framework_full_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x10, 0x01, 0x00, 0x00, 0x00, 0x08,
+        0xec, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x40, 0x00, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00
+#endif
+    };
+
+
+#define DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED 60
+static UCHAR device_framework_high_speed[] = {
+
+    /* Device descriptor */
+        0x12, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x0a, 0x07, 0x25, 0x40, 0x01, 0x00, 0x01, 0x02,
+        0x03, 0x01,
+
+    /* Device qualifier descriptor */
+        0x0a, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40,
+        0x01, 0x00,
+
+    /* Configuration descriptor */
+        0x09, 0x02, 0x20, 0x00, 0x01, 0x01, 0x00, 0xc0,
+        0x32,
+
+    /* Interface descriptor */
+        0x09, 0x04, 0x00, 0x00, 0x02, 0x99, 0x99, 0x99,
+        0x00,
+
+    /* Endpoint descriptor (Bulk Out) */
+        0x07, 0x05, 0x01, 0x02, 0x00, 0x02, 0x00,
+
+#ifdef UX_DEVICE_BIDIRECTIONAL_ENDPOINT_SUPPORT
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x81, 0x02, 0x40, 0x00, 0x00
+#else
+    /* Endpoint descriptor (Bulk In) */
+        0x07, 0x05, 0x82, 0x02, 0x00, 0x02, 0x00
+#endif
+    };
+
+    /* String Device Framework :
+     Byte 0 and 1 : Word containing the language ID : 0x0904 for US
+     Byte 2       : Byte containing the index of the descriptor
+     Byte 3       : Byte containing the length of the descriptor string
+    */
+
+#define STRING_FRAMEWORK_LENGTH 38
+static UCHAR string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 */
+        0x09, 0x04, 0x01, 0x0c,
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c,
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 */
+        0x09, 0x04, 0x02, 0x0c,
+        0x44, 0x61, 0x74, 0x61, 0x50, 0x75, 0x6d, 0x70,
+        0x44, 0x65, 0x6d, 0x6f,
+
+    /* Serial Number string descriptor : Index 3 */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides English, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+#define LANGUAGE_ID_FRAMEWORK_LENGTH 2
+static UCHAR language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+
+/* Define prototypes for external Host Controller's (HCDs), classes and clients.  */
+
+static VOID                tx_demo_instance_activate(VOID  *dpump_instance);
+static VOID                tx_demo_instance_deactivate(VOID *dpump_instance);
+
+static TX_THREAD           tx_demo_thread_host_simulation;
+static TX_THREAD           tx_demo_thread_slave_simulation;
+static void                tx_demo_thread_host_simulation_entry(ULONG);
+static void                tx_demo_thread_slave_simulation_entry(ULONG);
+
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+
+static VOID error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    if (expected_error == 0 || error_code != expected_error)
+    {
+        /* Failed test.  */
+        printf("Error on line %d, system_level: %d, system_context: %d, error code: %x\n", __LINE__, system_level, system_context, error_code);
+    }
+}
+
+/* Define what the initial system looks like.  */
+
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void    usbx_host_stack_endpoint_transfer_requests_test_application_define(void *first_unused_memory)
+#endif
+{
+
+UINT status;
+CHAR                            *stack_pointer;
+CHAR                            *memory_pointer;
+UX_SLAVE_CLASS_DPUMP_PARAMETER  parameter;
+
+
+    /* Inform user.  */
+    printf("Running Host Stack Endpoint Transfer Requests Test.................. ");
+#if defined(UX_HOST_STANDALONE) || defined(UX_DEVICE_STANDALONE)
+
+    /* Transfer requests are queued by threads.  */
+    printf("Skipped\n");
+    test_control_return(0);
+    return;
+#else
+
+    /* Initialize the free memory pointer.  */
+    stack_pointer = (CHAR *) first_unused_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory.  */
+    status =  ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL, 0);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(error_callback);
+
+    /* The code below is required for installing the host portion of USBX.  */
+    status =  ux_host_stack_initialize(UX_NULL);
+    status |= ux_host_stack_class_register(_ux_system_host_class_dpump_name, ux_host_class_dpump_entry);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* The code below is required for installing the device portion of USBX */
+    status =  ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                       device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL);
+
+    /* Set the parameters for callback when insertion/extraction of a Data Pump device.  */
+    parameter.ux_slave_class_dpump_instance_activate   =  tx_demo_instance_activate;
+    parameter.ux_slave_class_dpump_instance_deactivate =  tx_demo_instance_deactivate;
+
+    /* Initialize the device dpump class. The class is connected with interface 0 */
+    status |= ux_device_stack_class_register(_ux_system_slave_class_dpump_name, _ux_device_class_dpump_entry,
+                                               1, 0, &parameter);
+
+    /* Initialize the simulated device controller.  */
+    status |= _ux_dcd_sim_slave_initialize();
+
+    /* Register all the USB host controllers available in this system */
+    status |= ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, ux_hcd_sim_host_initialize,0,0);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_demo_thread_host_simulation, "tx demo host simulation", tx_demo_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+
+    /* Create the main demo thread.  */
+    status |= tx_thread_create(&tx_demo_thread_slave_simulation, "tx demo slave simulation", tx_demo_thread_slave_simulation_entry, 0,
+            stack_pointer + UX_DEMO_STACK_SIZE, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    if (status != TX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+#endif
+}
+
+#if !defined(UX_HOST_STANDALONE) && !defined(UX_DEVICE_STANDALONE)
+static VOID  transfer_completed(UX_TRANSFER *transfer_request)
+{
+
+    /* Log the completion order.  */
+    if (completed_count < TEST_REQUESTS_COUNT * 2)
+        completed[completed_count] = transfer_request;
+    completed_count ++;
+}
+
+static void  completed_wait(ULONG count, ULONG line)
+{
+
+ULONG           ticks = 0;
+
+
+    while (completed_count < count)
+    {
+        if (ticks ++ > TEST_WAIT_TICKS)
+        {
+
+            printf("ERROR #%ld: %ld of %ld transfers completed\n", line, completed_count, count);
+            test_control_return(1);
+        }
+        tx_thread_sleep(1);
+    }
+}
+
+static void  requests_setup(UX_TRANSFER *requests, UCHAR (*buffers)[UX_HOST_CLASS_DPUMP_PACKET_SIZE])
+{
+
+UINT            i;
+
+
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        requests[i].ux_transfer_request_data_pointer = buffers[i];
+        requests[i].ux_transfer_request_requested_length = UX_HOST_CLASS_DPUMP_PACKET_SIZE;
+        requests[i].ux_transfer_request_completion_function = transfer_completed;
+    }
+}
+
+static void  in_requests_start(void)
+{
+
+UINT            status;
+UINT            i;
+
+
+    completed_count = 0;
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        _ux_utility_memory_set(host_in_buffer[i], 0, UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        status = ux_host_stack_transfer_request(&in_requests[i]);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("ERROR #%d: 0x%x\n", __LINE__, status);
+            test_control_return(1);
+        }
+    }
+}
+
+static void  requests_aborted_check(ULONG line)
+{
+
+UINT            i;
+
+
+    /* All the IN transfer requests are aborted in array order.  */
+    completed_wait(TEST_REQUESTS_COUNT, line);
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        if (completed[i] != &in_requests[i] ||
+            in_requests[i].ux_transfer_request_completion_code != UX_TRANSFER_STATUS_ABORT)
+        {
+
+            printf("ERROR #%ld: request %d not aborted in order\n", line, i);
+            test_control_return(1);
+        }
+    }
+}
+
+static void  requests_echo_check(UCHAR tag, ULONG line)
+{
+
+UINT            status;
+UINT            i;
+
+
+    /* Queue all the IN transfer requests, then all the OUT ones.  */
+    in_requests_start();
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        _ux_utility_memory_set(host_out_buffer[i], (UCHAR)(tag + i), UX_HOST_CLASS_DPUMP_PACKET_SIZE);
+        status = ux_host_stack_transfer_request(&out_requests[i]);
+        if (status != UX_SUCCESS)
+        {
+
+            printf("ERROR #%ld: 0x%x\n", line, status);
+            test_control_return(1);
+        }
+    }
+
+    /* All of them complete, the IN ones receive the echo in order.  */
+    completed_wait(TEST_REQUESTS_COUNT * 2, line);
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        if (in_requests[i].ux_transfer_request_completion_code != UX_SUCCESS ||
+            in_requests[i].ux_transfer_request_actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE ||
+            host_in_buffer[i][0] != (UCHAR)(tag + i) ||
+            host_in_buffer[i][UX_HOST_CLASS_DPUMP_PACKET_SIZE - 1] != (UCHAR)(tag + i))
+        {
+
+            printf("ERROR #%ld: IN request %d, status 0x%x, data 0x%x\n", line, i,
+                    in_requests[i].ux_transfer_request_completion_code, host_in_buffer[i][0]);
+            test_control_return(1);
+        }
+        if (out_requests[i].ux_transfer_request_completion_code != UX_SUCCESS ||
+            out_requests[i].ux_transfer_request_actual_length != UX_HOST_CLASS_DPUMP_PACKET_SIZE)
+        {
+
+            printf("ERROR #%ld: OUT request %d, status 0x%x\n", line, i,
+                    out_requests[i].ux_transfer_request_completion_code);
+            test_control_return(1);
+        }
+    }
+}
+
+static void  tx_demo_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT            status;
+UX_HOST_CLASS   *class;
+UX_ENDPOINT     *in_endpoint;
+UX_ENDPOINT     *out_endpoint;
+UX_TRANSFER     *transfer_requests;
+UINT            i;
+
+
+    /* Find the main data pump container.  */
+    status =  ux_host_stack_class_get(_ux_system_host_class_dpump_name, &class);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d\n", __LINE__);
+        test_control_return(1);
+    }
+
+    /* We get the first instance of the data pump device.  */
+    do
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (VOID **) &dpump);
+        tx_thread_relinquish();
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the data pump status to be live.  */
+    while (dpump -> ux_host_class_dpump_state != UX_HOST_CLASS_INSTANCE_LIVE)
+        tx_thread_relinquish();
+    in_endpoint = dpump -> ux_host_class_dpump_bulk_in_endpoint;
+    out_endpoint = dpump -> ux_host_class_dpump_bulk_out_endpoint;
+
+    /* Allocate transfer requests on both bulk endpoints.  */
+    status =  ux_host_stack_endpoint_transfer_requests_allocate(in_endpoint, TEST_REQUESTS_COUNT, &in_requests);
+    status |= ux_host_stack_endpoint_transfer_requests_allocate(out_endpoint, TEST_REQUESTS_COUNT, &out_requests);
+    if (status != UX_SUCCESS ||
+        in_endpoint -> ux_endpoint_transfer_requests != in_requests ||
+        in_endpoint -> ux_endpoint_transfer_requests_count != TEST_REQUESTS_COUNT ||
+        in_requests[0].ux_transfer_request_endpoint != in_endpoint ||
+        in_requests[0].ux_transfer_request_type != in_endpoint -> ux_endpoint_transfer_request.ux_transfer_request_type)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    requests_setup(in_requests, host_in_buffer);
+    requests_setup(out_requests, host_out_buffer);
+
+    /* Only one set of transfer requests per endpoint.  */
+    expected_error = UX_ALREADY_ACTIVATED;
+    status =  ux_host_stack_endpoint_transfer_requests_allocate(in_endpoint, 1, &transfer_requests);
+    expected_error = 0;
+    if (status != UX_ALREADY_ACTIVATED)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+
+    /* Queued transfer requests complete in order.  */
+    requests_echo_check('A', __LINE__);
+    requests_echo_check('a', __LINE__);
+
+    /* The endpoint transfer abort cancels all the queued transfer requests.  */
+    in_requests_start();
+    tx_thread_sleep(2);
+    if (completed_count != 0)
+    {
+
+        printf("ERROR #%d: %ld transfers completed\n", __LINE__, completed_count);
+        test_control_return(1);
+    }
+    ux_host_stack_endpoint_transfer_abort(in_endpoint);
+    requests_aborted_check(__LINE__);
+    requests_echo_check('0', __LINE__);
+
+    /* The endpoint reset cancels all the queued transfer requests.  */
+    in_requests_start();
+    tx_thread_sleep(2);
+    status = ux_host_stack_endpoint_reset(in_endpoint);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    requests_aborted_check(__LINE__);
+    requests_echo_check('a', __LINE__);
+
+    /* A stall does not flush the queued transfer requests, each one completes
+       with the stall until the endpoint reset clears the halt.  */
+    ux_device_stack_endpoint_stall(dpump_slave -> ux_slave_class_dpump_bulkin_endpoint);
+    expected_error = UX_TRANSFER_STALLED;
+    in_requests_start();
+    completed_wait(TEST_REQUESTS_COUNT, __LINE__);
+    expected_error = 0;
+    for (i = 0; i < TEST_REQUESTS_COUNT; i ++)
+    {
+        if (completed[i] != &in_requests[i] ||
+            in_requests[i].ux_transfer_request_completion_code != UX_TRANSFER_STALLED)
+        {
+
+            printf("ERROR #%d: request %d, status 0x%x\n", __LINE__, i,
+                    in_requests[i].ux_transfer_request_completion_code);
+            test_control_return(1);
+        }
+    }
+    status = ux_host_stack_endpoint_reset(in_endpoint);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    requests_echo_check('S', __LINE__);
+
+    /* Free transfer requests, they can be allocated again.  */
+    in_requests_start();
+    status = ux_host_stack_endpoint_transfer_requests_free(in_endpoint);
+    if (status != UX_SUCCESS ||
+        completed_count != TEST_REQUESTS_COUNT ||
+        in_endpoint -> ux_endpoint_transfer_requests != UX_NULL ||
+        in_endpoint -> ux_endpoint_transfer_requests_count != 0)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    status = ux_host_stack_endpoint_transfer_requests_allocate(in_endpoint, TEST_REQUESTS_COUNT, &in_requests);
+    if (status != UX_SUCCESS)
+    {
+
+        printf("ERROR #%d: 0x%x\n", __LINE__, status);
+        test_control_return(1);
+    }
+    requests_setup(in_requests, host_in_buffer);
+    requests_echo_check('A', __LINE__);
+
+    /* Transfer requests left are freed with the endpoint on disconnection.  */
+    in_requests_start();
+    ux_test_dcd_sim_slave_disconnect();
+    ux_test_hcd_sim_host_disconnect();
+    completed_wait(TEST_REQUESTS_COUNT, __LINE__);
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+
+static void  tx_demo_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT    status;
+ULONG   actual_length;
+
+
+    while(1)
+    {
+
+        /* Echo the packets while the dpump class on the device is alive.  */
+        while (dpump_slave != UX_NULL)
+        {
+
+            /* Read from the device data pump.  */
+            status =  _ux_device_class_dpump_read(dpump_slave, slave_buffer, UX_HOST_CLASS_DPUMP_PACKET_SIZE, &actual_length);
+            if (status != UX_SUCCESS)
+                break;
+
+            /* Now write to the device data pump.  */
+            status =  _ux_device_class_dpump_write(dpump_slave, slave_buffer, actual_length, &actual_length);
+            if (status != UX_SUCCESS)
+                break;
+        }
+
+        /* Relinquish to other thread.  */
+        tx_thread_sleep(1);
+    }
+}
+#endif
+
+static VOID  tx_demo_instance_activate(VOID *dpump_instance)
+{
+
+    /* Save the DPUMP instance.  */
+    dpump_slave = (UX_SLAVE_CLASS_DPUMP *) dpump_instance;
+}
+
+static VOID  tx_demo_instance_deactivate(VOID *dpump_instance)
+{
+
+    /* Reset the DPUMP instance.  */
+    dpump_slave = UX_NULL;
+}
@@ -0,0 +1,57 @@
+/* This benchmarks USB networking between the device RNDIS class and the
+   host CDC-ECM class: UDP blast and ping latency are measured both ways,
+   with full and with reduced receive packet pools. The simulated
+   controllers add and remove the RNDIS headers the host class does not
+   handle.  */
+
+#define PACKET_PAYLOAD                      1600
+#define HOST_IP_POOL_SIZE                   (PACKET_PAYLOAD*UX_HOST_CLASS_CDC_ECM_NX_PKPOOL_ENTRIES)
+#define DEVICE_IP_POOL_SIZE                 (PACKET_PAYLOAD*UX_HOST_CLASS_CDC_ECM_NX_PKPOOL_ENTRIES)
+
+#include "usbx_ux_test_rndis.h"
+#include "usbx_ux_test_network_benchmark.h"
+
+/* Define what the initial system looks like.  */
+#ifdef CTEST
+void test_application_define(void *first_unused_memory)
+#else
+void usbx_rndis_network_benchmark_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Inform user.  */
+    printf("Running RNDIS Network Benchmark..................................... ");
+    stepinfo("\n");
+
+    ux_test_rndis_initialize(first_unused_memory);
+}
+
+static void post_init_host()
+{
+
+NETWORK_BENCHMARK_PEER  host;
+NETWORK_BENCHMARK_PEER  device;
+
+    /* TCP is covered by the CDC-ECM benchmark.  */
+    host.name = "host";
+    host.ip = &nx_ip_host;
+    host.ip_address = HOST_IP_ADDRESS;
+    host.packet_pool = &packet_pool_host;
+    host.udp_socket = &udp_socket_host;
+    host.udp_port = HOST_SOCKET_PORT_UDP;
+    host.tcp_socket = UX_NULL;
+
+    device.name = "rndis";
+    device.ip = &nx_ip_device;
+    device.ip_address = DEVICE_IP_ADDRESS;
+    device.packet_pool = &packet_pool_device;
+    device.udp_socket = &udp_socket_device;
+    device.udp_port = DEVICE_SOCKET_PORT_UDP;
+    device.tcp_socket = UX_NULL;
+
+    network_benchmark_run(&host, &device);
+}
+
+static void post_init_device()
+{
+}
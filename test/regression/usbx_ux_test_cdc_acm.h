@@ -0,0 +1,423 @@
+#ifndef USBX_UX_TEST_CDC_ACM_H
+#define USBX_UX_TEST_CDC_ACM_H
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+#include "ux_device_class_cdc_acm.h"
+#include "ux_device_stack.h"
+#include "ux_host_class_cdc_acm.h"
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+#include "ux_test_utility_sim.h"
+#include "ux_test.h"
+
+/* Define local constants.  */
+
+#define UX_DEMO_STACK_SIZE                  (4*1024)
+#define UX_USBX_MEMORY_SIZE                 (128*1024)
+
+/* Host */
+
+static TX_THREAD                            thread_host;
+static UCHAR                                thread_stack_host[UX_DEMO_STACK_SIZE];
+static UX_HOST_CLASS_CDC_ACM                *cdc_acm_host_control;
+static UX_HOST_CLASS_CDC_ACM                *cdc_acm_host_data;
+
+/* Device */
+
+static TX_THREAD                            thread_device;
+static UCHAR                                thread_stack_device[UX_DEMO_STACK_SIZE];
+static UX_SLAVE_CLASS_CDC_ACM               *cdc_acm_slave;
+static UX_SLAVE_CLASS_CDC_ACM_PARAMETER     cdc_acm_parameter;
+
+static UCHAR                                global_host_ready_for_application;
+
+/* Define local prototypes and definitions.  */
+static void thread_entry_host(ULONG arg);
+static void thread_entry_device(ULONG arg);
+static void post_init_host();
+static void post_init_device();
+
+/* Prototype for test control return.  */
+void  test_control_return(UINT status);
+
+/* Define device framework.  */
+
+#define             DEVICE_FRAMEWORK_LENGTH_FULL_SPEED      93 
+#define             DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED      103
+#define             STRING_FRAMEWORK_LENGTH                 47
+#define             LANGUAGE_ID_FRAMEWORK_LENGTH            2
+
+static unsigned char device_framework_full_speed[] = {
+
+    /* Device descriptor     18 bytes
+       0x02 bDeviceClass:    CDC class code
+       0x00 bDeviceSubclass: CDC class sub code
+       0x00 bDeviceProtocol: CDC Device protocol
+    
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    0x12, 0x01, 0x10, 0x01,     
+    0xEF, 0x02, 0x01,           
+    0x08,                       
+    0x84, 0x84, 0x00, 0x00,     
+    0x00, 0x01,                 
+    0x01, 0x02, 03,             
+    0x01,                       
+
+    /* Configuration 1 descriptor 9 bytes */
+    0x09, 0x02, 0x4b, 0x00,     
+    0x02, 0x01, 0x00,           
+    0x40, 0x00,                 
+
+    /* Interface association descriptor. 8 bytes.  */
+    0x08, 0x0b, 0x00, 0x02, 0x02, 0x02, 0x00, 0x00,
+
+    /* Communication Class Interface Descriptor Requirement. 9 bytes.   */
+    0x09, 0x04, 0x00,           
+    0x00,                       
+    0x01,                       
+    0x02, 0x02, 0x01,           
+    0x00,                       
+
+    /* Header Functional Descriptor 5 bytes */
+    0x05, 0x24, 0x00,           
+    0x10, 0x01,                 
+
+    /* ACM Functional Descriptor 4 bytes */
+    0x04, 0x24, 0x02,           
+    0x0f,                       
+
+    /* Union Functional Descriptor 5 bytes */
+    0x05, 0x24, 0x06,           
+    0x00,                          /* Master interface */
+    0x01,                          /* Slave interface  */
+
+    /* Call Management Functional Descriptor 5 bytes */
+    0x05, 0x24, 0x01,           
+    0x03,                       
+    0x01,                          /* Data interface   */
+
+    /* Endpoint 1 descriptor 7 bytes */
+    0x07, 0x05, 0x83,           
+    0x03,                       
+    0x08, 0x00,                 
+    0xFF,                       
+
+    /* Data Class Interface Descriptor Requirement 9 bytes */
+    0x09, 0x04, 0x01,           
+    0x00,                       
+    0x02,                       
+    0x0A, 0x00, 0x00,           
+    0x00,                       
+
+    /* First alternate setting Endpoint 1 descriptor 7 bytes*/
+    0x07, 0x05, 0x02,           
+    0x02,                       
+    0x40, 0x00,                 
+    0x00,                       
+
+    /* Endpoint 2 descriptor 7 bytes */
+    0x07, 0x05, 0x81,           
+    0x02,                       
+    0x40, 0x00,                 
+    0x00,                       
+
+};
+
+static unsigned char device_framework_high_speed[] = {
+
+    /* Device descriptor    
+       0x02 bDeviceClass:    CDC class code
+       0x00 bDeviceSubclass: CDC class sub code
+       0x00 bDeviceProtocol: CDC Device protocol
+    
+       idVendor & idProduct - http://www.linux-usb.org/usb.ids
+    */
+    0x12, 0x01, 0x00, 0x02,     
+    0xEF, 0x02, 0x01,           
+    0x40,                       
+    0x84, 0x84, 0x00, 0x00,     
+    0x00, 0x01,                 
+    0x01, 0x02, 03,             
+    0x01,                       
+
+    /* Device qualifier descriptor */
+    0x0a, 0x06, 0x00, 0x02,     
+    0x02, 0x00, 0x00,           
+    0x40,                       
+    0x01,                       
+    0x00,                       
+
+    /* Configuration 1 descriptor */
+    0x09, 0x02, 0x4b, 0x00,     
+    0x02, 0x01, 0x00,           
+    0x40, 0x00,                 
+
+    /* Interface association descriptor. */
+    0x08, 0x0b, 0x00, 0x02, 0x02, 0x02, 0x00, 0x00,
+
+    /* Communication Class Interface Descriptor Requirement */
+    0x09, 0x04, 0x01,           
+    0x00,                       
+    0x01,                       
+    0x02, 0x02, 0x01,           
+    0x00,                       
+
+    /* Header Functional Descriptor */
+    0x05, 0x24, 0x00,           
+    0x10, 0x01,                 
+
+    /* ACM Functional Descriptor */
+    0x04, 0x24, 0x02,           
+    0x0f,                       
+
+    /* Union Functional Descriptor */
+    0x05, 0x24, 0x06,           
+    0x00,                       
+    0x01,                       
+
+    /* Call Management Functional Descriptor */
+    0x05, 0x24, 0x01,           
+    0x00,                       
+    0x01,                       
+
+    /* Endpoint 1 descriptor */
+    0x07, 0x05, 0x83,           
+    0x03,                       
+    0x08, 0x00,                 
+    0xFF,                       
+
+    /* Data Class Interface Descriptor Requirement */
+    0x09, 0x04, 0x01,           
+    0x00,                       
+    0x02,                       
+    0x0A, 0x00, 0x00,           
+    0x00,                       
+
+    /* First alternate setting Endpoint 1 descriptor */
+    0x07, 0x05, 0x02,           
+    0x02,                       
+    0x40, 0x00,                 
+    0x00,                       
+
+    /* Endpoint 2 descriptor */
+    0x07, 0x05, 0x81,           
+    0x02,                       
+    0x40, 0x00,                 
+    0x00,                        
+
+};
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "Express Logic" */
+        0x09, 0x04, 0x01, 0x0c, 
+        0x45, 0x78, 0x70, 0x72,0x65, 0x73, 0x20, 0x4c, 
+        0x6f, 0x67, 0x69, 0x63,
+
+    /* Product string descriptor : Index 2 - "EL Composite device" */
+        0x09, 0x04, 0x02, 0x13,
+        0x45, 0x4c, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+        0x73, 0x69, 0x74, 0x65, 0x20, 0x64, 0x65, 0x76, 
+        0x69, 0x63, 0x65,                              
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+        0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+    };
+
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+    };
+
+static UINT  class_cdc_acm_get_host(void)
+{
+
+UINT                                status;
+UX_HOST_CLASS                       *class;
+UX_HOST_CLASS_CDC_ACM               *cdc_acm_host;
+
+
+    /* Find the main cdc_acm container */
+    status =  ux_host_stack_class_get(_ux_system_host_class_cdc_acm_name, &class);
+    if (status != UX_SUCCESS)
+        return(status);
+
+    /* We get the first instance of the cdc_acm device */
+    do  
+    {
+
+        status =  ux_host_stack_class_instance_get(class, 0, (void **) &cdc_acm_host);
+        tx_thread_sleep(10);
+    } while (status != UX_SUCCESS);
+
+    /* We still need to wait for the cdc_acm status to be live */
+    while (cdc_acm_host -> ux_host_class_cdc_acm_state != UX_HOST_CLASS_INSTANCE_LIVE)
+        tx_thread_sleep(10);
+
+    /* Isolate both the control and data interfaces.  */
+    if (cdc_acm_host -> ux_host_class_cdc_acm_interface -> ux_interface_descriptor.bInterfaceClass == UX_HOST_CLASS_CDC_DATA_CLASS)
+    {            
+        /* This is the data interface.  */
+        cdc_acm_host_data = cdc_acm_host;
+        
+        /* In that case, the second one should be the control interface.  */
+        status =  ux_host_stack_class_instance_get(class, 1, (void **) &cdc_acm_host);
+
+        /* Check error.  */
+        if (status != UX_SUCCESS)
+            return(status);
+        
+        /* Check for the control interfaces.  */
+        if (cdc_acm_host -> ux_host_class_cdc_acm_interface -> ux_interface_descriptor.bInterfaceClass == UX_HOST_CLASS_CDC_CONTROL_CLASS)
+        {
+
+            /* This is the control interface.  */
+            cdc_acm_host_control = cdc_acm_host;
+
+            return(UX_SUCCESS);
+        
+        }
+    }
+    else
+    {
+        /* Check for the control interfaces.  */
+        if (cdc_acm_host -> ux_host_class_cdc_acm_interface -> ux_interface_descriptor.bInterfaceClass == UX_HOST_CLASS_CDC_CONTROL_CLASS)
+        {
+
+            /* This is the control interface.  */
+            cdc_acm_host_control = cdc_acm_host;
+
+            /* In that case, the second one should be the data interface.  */
+            status =  ux_host_stack_class_instance_get(class, 1, (void **) &cdc_acm_host);
+
+            /* Check error.  */
+            if (status != UX_SUCCESS)
+                return(status);
+        
+            /* Check for the data interface.  */
+            if (cdc_acm_host -> ux_host_class_cdc_acm_interface -> ux_interface_descriptor.bInterfaceClass == UX_HOST_CLASS_CDC_DATA_CLASS)
+            {
+
+                /* This is the data interface.  */
+                cdc_acm_host_data = cdc_acm_host;
+            
+                return(UX_SUCCESS);
+        
+            }
+        }
+    }
+        
+    /* Return ERROR.  */
+    return(UX_ERROR);
+}
+
+static VOID cdc_acm_instance_activate(VOID *cdc_instance)
+{
+
+    /* Save the CDC instance.  */
+    cdc_acm_slave = (UX_SLAVE_CLASS_CDC_ACM *) cdc_instance;
+}
+
+static VOID cdc_acm_instance_deactivate(VOID *cdc_instance)
+{
+
+    /* Reset the CDC instance.  */
+    cdc_acm_slave = UX_NULL;
+}
+
+static void ux_test_cdc_acm_initialize(void *first_unused_memory)
+{
+
+CHAR *memory_pointer = first_unused_memory;
+
+    /* Initialize USBX Memory. */
+    UX_TEST_CHECK_SUCCESS(ux_system_initialize(memory_pointer, UX_USBX_MEMORY_SIZE, UX_NULL, 0));
+
+    /* Register the error callback. */
+    ux_utility_error_callback_register(ux_test_error_callback);
+
+    /* The code below is required for installing the host portion of USBX. */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_initialize(UX_NULL));
+
+    /* Register CDC-ACM class.  */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_class_register(_ux_system_host_class_cdc_acm_name, ux_host_class_cdc_acm_entry));
+
+    /* The code below is required for installing the device portion of USBX. */
+    UX_TEST_CHECK_SUCCESS(ux_device_stack_initialize(device_framework_high_speed, DEVICE_FRAMEWORK_LENGTH_HIGH_SPEED,
+                                                     device_framework_full_speed, DEVICE_FRAMEWORK_LENGTH_FULL_SPEED,
+                                                     string_framework, STRING_FRAMEWORK_LENGTH,
+                                                     language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH, UX_NULL));
+
+    /* Set the parameters for callback when insertion/extraction of a CDC device.  */
+    cdc_acm_parameter.ux_slave_class_cdc_acm_instance_activate   =  cdc_acm_instance_activate;
+    cdc_acm_parameter.ux_slave_class_cdc_acm_instance_deactivate =  cdc_acm_instance_deactivate;
+
+    /* Initialize the device cdc class. This class owns both interfaces starting with 0. */
+    UX_TEST_CHECK_SUCCESS(ux_device_stack_class_register(_ux_system_slave_class_cdc_acm_name, ux_device_class_cdc_acm_entry,
+                                                         1, 0, &cdc_acm_parameter));
+
+    /* Initialize the simulated device controller.  */
+    UX_TEST_CHECK_SUCCESS(_ux_dcd_sim_slave_initialize());
+
+    /* Register all the USB host controllers available in this system. */
+    UX_TEST_CHECK_SUCCESS(ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_test_hcd_sim_host_initialize, 0, 0));
+
+    /* Create the host thread. */
+    UX_TEST_CHECK_SUCCESS(tx_thread_create(&thread_host, "host thread", thread_entry_host, 0,
+                                           thread_stack_host, UX_DEMO_STACK_SIZE,
+                                           20, 20, 1, TX_AUTO_START));
+
+    /* Create the device thread. */
+    UX_TEST_CHECK_SUCCESS(tx_thread_create(&thread_device, "device thread", thread_entry_device, 0,
+                                           thread_stack_device, UX_DEMO_STACK_SIZE,
+                                           20, 20, 1, TX_AUTO_START));
+}
+
+static void thread_entry_host(ULONG arg)
+{
+
+    /* Find the cdc_acm class and wait for the link to be up.  */
+    UX_TEST_CHECK_SUCCESS(class_cdc_acm_get_host());
+
+    /* Wait for the device instance.  */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_non_null((VOID **)&cdc_acm_slave));
+    global_host_ready_for_application = 1;
+
+    /* Call test code. */
+    post_init_host();
+
+    /* Disconnect. */
+    ux_test_disconnect_slave_and_host_wait_for_enum_completion();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+static void thread_entry_device(ULONG arg)
+{
+
+    /* Wait for the host to be ready. */
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_uchar(&global_host_ready_for_application, 1));
+
+    /* Call test code. */
+    post_init_device();
+
+    /* Nothing else to do. */
+    while (1)
+        tx_thread_sleep(100);
+}
+
+#endif
@@ -34,7 +34,9 @@ typedef struct DEVICE_INIT_DATA
 #define DEVICE_SOCKET_PORT_TCP              45057
 
 #ifndef TEST_NX_PACKET_CHAIN
+#ifndef TCP_WINDOW
 #define TCP_WINDOW                          1600
+#endif
 #define PACKET_PAYLOAD                      1600
 #define WRITE_APPEND_SIZE                   (0)
 #define PACKET_POOL_SIZE                    (PACKET_PAYLOAD*10000)
@@ -48,6 +50,9 @@ typedef struct DEVICE_INIT_DATA
 #define HOST_IP_POOL_SIZE                   (PACKET_PAYLOAD*UX_HOST_CLASS_CDC_ECM_NX_PKPOOL_ENTRIES)
 #define DEVICE_IP_POOL_SIZE                 (PACKET_PAYLOAD*UX_DEVICE_CLASS_CDC_ECM_NX_PKPOOL_ENTRIES)
 #endif
+#ifndef DEVICE_TCP_WINDOW
+#define DEVICE_TCP_WINDOW                   100
+#endif
 #define ARP_MEMORY_SIZE                     1024
 
 /* Define local constants.  */
@@ -709,7 +714,7 @@ DEVICE_INIT_DATA *device_init_data;
     /* Setup TCP. */
 
     UX_TEST_CHECK_SUCCESS(nx_tcp_enable(&nx_ip_device));
-    UX_TEST_CHECK_SUCCESS(nx_tcp_socket_create(&nx_ip_device, &tcp_socket_device, "USB DEVICE TCP SOCKET", NX_IP_NORMAL, NX_DONT_FRAGMENT, NX_IP_TIME_TO_LIVE, 100, NX_NULL, NX_NULL));
+    UX_TEST_CHECK_SUCCESS(nx_tcp_socket_create(&nx_ip_device, &tcp_socket_device, "USB DEVICE TCP SOCKET", NX_IP_NORMAL, NX_DONT_FRAGMENT, NX_IP_TIME_TO_LIVE, DEVICE_TCP_WINDOW, NX_NULL, NX_NULL));
     UX_TEST_CHECK_SUCCESS(nx_tcp_client_socket_bind(&tcp_socket_device, DEVICE_SOCKET_PORT_TCP, NX_WAIT_FOREVER));
 
     /* The code below is required for installing the device portion of USBX.
@@ -0,0 +1,343 @@
+/* Network benchmark scenarios run between two NetX IP instances connected
+   by USB over the simulated host and device controllers. Results are only
+   reported, the scenarios check nothing but that traffic went through.  */
+
+#ifndef USBX_UX_TEST_NETWORK_BENCHMARK_H
+#define USBX_UX_TEST_NETWORK_BENCHMARK_H
+
+#include <sys/time.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NETWORK_BENCHMARK_TSC_READ()            __rdtsc()
+#else
+#define NETWORK_BENCHMARK_TSC_READ()            0
+#endif
+
+#include "ux_api.h"
+#include "ux_test.h"
+#include "nx_api.h"
+
+/* Define benchmark constants.  */
+
+#ifndef NETWORK_BENCHMARK_UDP_PACKETS
+#define NETWORK_BENCHMARK_UDP_PACKETS           200
+#endif
+#ifndef NETWORK_BENCHMARK_TCP_SEGMENTS
+#define NETWORK_BENCHMARK_TCP_SEGMENTS          200
+#endif
+#ifndef NETWORK_BENCHMARK_PING_COUNT
+#define NETWORK_BENCHMARK_PING_COUNT            50
+#endif
+#ifndef NETWORK_BENCHMARK_IDLE_TIMEOUT_MS
+#define NETWORK_BENCHMARK_IDLE_TIMEOUT_MS       1000
+#endif
+
+/* Pool sizes are the receive packets left available in the IP pools.  */
+#ifndef NETWORK_BENCHMARK_POOL_RESERVE_LEFT
+#define NETWORK_BENCHMARK_POOL_RESERVE_LEFT     6
+#endif
+
+#define NETWORK_BENCHMARK_MAX_PAYLOAD           1472
+#define NETWORK_BENCHMARK_MAX_SAMPLES           NETWORK_BENCHMARK_PING_COUNT
+
+typedef struct NETWORK_BENCHMARK_PEER
+{
+    CHAR            *name;
+    NX_IP           *ip;
+    ULONG           ip_address;
+    NX_PACKET_POOL  *packet_pool;
+    NX_UDP_SOCKET   *udp_socket;
+    UINT            udp_port;
+    NX_TCP_SOCKET   *tcp_socket;
+} NETWORK_BENCHMARK_PEER;
+
+typedef struct NETWORK_BENCHMARK_COUNTERS
+{
+    ULONG           frames;
+    ULONG           bytes;
+    ULONG           last_us;
+} NETWORK_BENCHMARK_COUNTERS;
+
+static NETWORK_BENCHMARK_COUNTERS   network_benchmark_received;
+static UCHAR                        network_benchmark_payload[NETWORK_BENCHMARK_MAX_PAYLOAD];
+static ULONG                        network_benchmark_samples[NETWORK_BENCHMARK_MAX_SAMPLES];
+static NX_PACKET                    *network_benchmark_reserved;
+
+static ULONG network_benchmark_time_us(void)
+{
+
+struct timeval  now;
+
+    gettimeofday(&now, NX_NULL);
+    return((ULONG)now.tv_sec * 1000000ul + (ULONG)now.tv_usec);
+}
+
+static ULONG network_benchmark_cpu_us(void)
+{
+
+    return((ULONG)((unsigned long long)clock() * 1000000ull / CLOCKS_PER_SEC));
+}
+
+static void network_benchmark_udp_notify(NX_UDP_SOCKET *socket_ptr)
+{
+
+NX_PACKET   *packet;
+
+    /* Drain the socket from IP thread, count and drop.  */
+    while (nx_udp_socket_receive(socket_ptr, &packet, NX_NO_WAIT) == NX_SUCCESS)
+    {
+        network_benchmark_received.frames ++;
+        network_benchmark_received.bytes += packet -> nx_packet_length;
+        network_benchmark_received.last_us = network_benchmark_time_us();
+        nx_packet_release(packet);
+    }
+}
+
+static void network_benchmark_tcp_notify(NX_TCP_SOCKET *socket_ptr)
+{
+
+NX_PACKET   *packet;
+
+    /* Drain the socket from IP thread, count and drop.  */
+    while (nx_tcp_socket_receive(socket_ptr, &packet, NX_NO_WAIT) == NX_SUCCESS)
+    {
+        network_benchmark_received.frames ++;
+        network_benchmark_received.bytes += packet -> nx_packet_length;
+        network_benchmark_received.last_us = network_benchmark_time_us();
+        nx_packet_release(packet);
+    }
+}
+
+/* Wait until expected bytes are received, or reception is idle.  */
+static void network_benchmark_wait(ULONG expected_bytes, ULONG idle_timeout_ms)
+{
+
+ULONG       last_bytes = 0;
+ULONG       idle_ms = 0;
+
+    while (network_benchmark_received.bytes < expected_bytes &&
+           idle_ms < idle_timeout_ms)
+    {
+        tx_thread_sleep(1);
+        if (network_benchmark_received.bytes != last_bytes)
+        {
+            last_bytes = network_benchmark_received.bytes;
+            idle_ms = 0;
+        }
+        else
+            idle_ms += 10;
+    }
+}
+
+/* Hold receive packets so that only pool_left are available.  */
+static void network_benchmark_pool_reserve(NX_PACKET_POOL *pool, ULONG pool_left)
+{
+
+NX_PACKET   *packet;
+
+    while (pool -> nx_packet_pool_available > pool_left)
+    {
+        if (nx_packet_allocate(pool, &packet, NX_RECEIVE_PACKET, NX_NO_WAIT) != NX_SUCCESS)
+            break;
+        packet -> nx_packet_queue_next = network_benchmark_reserved;
+        network_benchmark_reserved = packet;
+    }
+}
+
+static void network_benchmark_pool_release(void)
+{
+
+NX_PACKET   *packet;
+
+    while (network_benchmark_reserved)
+    {
+        packet = network_benchmark_reserved;
+        network_benchmark_reserved = packet -> nx_packet_queue_next;
+        packet -> nx_packet_queue_next = NX_NULL;
+        nx_packet_release(packet);
+    }
+}
+
+static void network_benchmark_report(CHAR *scenario, NETWORK_BENCHMARK_PEER *from, NETWORK_BENCHMARK_PEER *to,
+                                     ULONG size, ULONG pool, ULONG sent, ULONG elapsed_us, ULONG cpu_us,
+                                     double cycles_per_us)
+{
+
+ULONG       frames = network_benchmark_received.frames;
+ULONG       bytes = network_benchmark_received.bytes;
+double      mbps = 0, pps = 0, cpu_ns = 0, cycles = 0;
+
+    if (elapsed_us)
+    {
+        mbps = (double)bytes * 8 / elapsed_us;
+        pps = (double)frames * 1000000 / elapsed_us;
+    }
+    if (frames)
+    {
+        cpu_ns = (double)cpu_us * 1000 / frames;
+
+        /* Convert CPU time to cycles with the time stamp counter rate.  */
+        cycles = cycles_per_us * cpu_us / frames;
+    }
+    printf("  %-4s %-6s->%-6s size %4lu pool %2lu: %4lu/%-4lu %8.3f Mbit/s %8.1f pkt/s %9.0f cpu ns/pkt %10.0f cycles/pkt\n",
+           scenario, from -> name, to -> name, size, pool, frames, sent, mbps, pps, cpu_ns, cycles);
+}
+
+static void network_benchmark_udp_blast(NETWORK_BENCHMARK_PEER *from, NETWORK_BENCHMARK_PEER *to, ULONG size, ULONG pool)
+{
+
+NX_PACKET           *packet;
+ULONG               i;
+ULONG               sent = 0;
+ULONG               start_us, end_us, cpu_us;
+unsigned long long  tsc;
+
+    _ux_utility_memory_set(&network_benchmark_received, 0, sizeof(network_benchmark_received));
+    UX_TEST_CHECK_SUCCESS(nx_udp_socket_receive_notify(to -> udp_socket, network_benchmark_udp_notify));
+
+    start_us = network_benchmark_time_us();
+    cpu_us = network_benchmark_cpu_us();
+    tsc = NETWORK_BENCHMARK_TSC_READ();
+
+    for (i = 0; i < NETWORK_BENCHMARK_UDP_PACKETS; i ++)
+    {
+        UX_TEST_CHECK_SUCCESS(nx_packet_allocate(from -> packet_pool, &packet, NX_UDP_PACKET, NX_WAIT_FOREVER));
+        UX_TEST_CHECK_SUCCESS(nx_packet_data_append(packet, network_benchmark_payload, size, from -> packet_pool, NX_WAIT_FOREVER));
+        if (nx_udp_socket_send(from -> udp_socket, packet, to -> ip_address, to -> udp_port) == NX_SUCCESS)
+            sent ++;
+        else
+            nx_packet_release(packet);
+    }
+    network_benchmark_wait(sent * size, NETWORK_BENCHMARK_IDLE_TIMEOUT_MS);
+
+    tsc = NETWORK_BENCHMARK_TSC_READ() - tsc;
+    cpu_us = network_benchmark_cpu_us() - cpu_us;
+    end_us = network_benchmark_time_us();
+    UX_TEST_CHECK_SUCCESS(nx_udp_socket_receive_notify(to -> udp_socket, NX_NULL));
+
+    UX_TEST_ASSERT(network_benchmark_received.frames > 0);
+    network_benchmark_report("udp", from, to, size, pool, sent,
+                             network_benchmark_received.last_us - start_us, cpu_us,
+                             (end_us != start_us) ? (double)tsc / (end_us - start_us) : 0);
+}
+
+static void network_benchmark_tcp_bulk(NETWORK_BENCHMARK_PEER *from, NETWORK_BENCHMARK_PEER *to, ULONG size, ULONG pool)
+{
+
+NX_PACKET           *packet;
+ULONG               i;
+ULONG               start_us, end_us, cpu_us;
+unsigned long long  tsc;
+
+    _ux_utility_memory_set(&network_benchmark_received, 0, sizeof(network_benchmark_received));
+    UX_TEST_CHECK_SUCCESS(nx_tcp_socket_receive_notify(to -> tcp_socket, network_benchmark_tcp_notify));
+
+    start_us = network_benchmark_time_us();
+    cpu_us = network_benchmark_cpu_us();
+    tsc = NETWORK_BENCHMARK_TSC_READ();
+
+    for (i = 0; i < NETWORK_BENCHMARK_TCP_SEGMENTS; i ++)
+    {
+        UX_TEST_CHECK_SUCCESS(nx_packet_allocate(from -> packet_pool, &packet, NX_TCP_PACKET, NX_WAIT_FOREVER));
+        UX_TEST_CHECK_SUCCESS(nx_packet_data_append(packet, network_benchmark_payload, size, from -> packet_pool, NX_WAIT_FOREVER));
+        UX_TEST_CHECK_SUCCESS(nx_tcp_socket_send(from -> tcp_socket, packet, NX_WAIT_FOREVER));
+    }
+    /* Lost segments are recovered on retransmission timeout.  */
+    network_benchmark_wait(NETWORK_BENCHMARK_TCP_SEGMENTS * size, NETWORK_BENCHMARK_IDLE_TIMEOUT_MS * 10);
+
+    tsc = NETWORK_BENCHMARK_TSC_READ() - tsc;
+    cpu_us = network_benchmark_cpu_us() - cpu_us;
+    end_us = network_benchmark_time_us();
+    UX_TEST_CHECK_SUCCESS(nx_tcp_socket_receive_notify(to -> tcp_socket, NX_NULL));
+
+    /* TCP is reliable, all data must be there.  */
+    UX_TEST_ASSERT(network_benchmark_received.bytes == NETWORK_BENCHMARK_TCP_SEGMENTS * size);
+    network_benchmark_report("tcp", from, to, size, pool, NETWORK_BENCHMARK_TCP_SEGMENTS,
+                             network_benchmark_received.last_us - start_us, cpu_us,
+                             (end_us != start_us) ? (double)tsc / (end_us - start_us) : 0);
+}
+
+static void network_benchmark_ping(NETWORK_BENCHMARK_PEER *from, NETWORK_BENCHMARK_PEER *to, ULONG size, ULONG pool)
+{
+
+NX_PACKET   *response;
+ULONG       i, j, sample;
+ULONG       count = 0;
+ULONG       start_us;
+
+    for (i = 0; i < NETWORK_BENCHMARK_PING_COUNT; i ++)
+    {
+        start_us = network_benchmark_time_us();
+        if (nx_icmp_ping(from -> ip, to -> ip_address, (CHAR *)network_benchmark_payload, size,
+                         &response, MS_TO_TICK(NETWORK_BENCHMARK_IDLE_TIMEOUT_MS)) != NX_SUCCESS)
+            continue;
+        sample = network_benchmark_time_us() - start_us;
+        nx_packet_release(response);
+
+        /* Insert the sample in order.  */
+        for (j = count; j > 0 && network_benchmark_samples[j - 1] > sample; j --)
+            network_benchmark_samples[j] = network_benchmark_samples[j - 1];
+        network_benchmark_samples[j] = sample;
+        count ++;
+    }
+
+    UX_TEST_ASSERT(count > 0);
+    printf("  ping %-6s->%-6s size %4lu pool %2lu: %4lu/%-4u p50 %6lu us p90 %6lu us p99 %6lu us max %6lu us\n",
+           from -> name, to -> name, size, pool, count, NETWORK_BENCHMARK_PING_COUNT,
+           network_benchmark_samples[count * 50 / 100], network_benchmark_samples[count * 90 / 100],
+           network_benchmark_samples[count * 99 / 100], network_benchmark_samples[count - 1]);
+}
+
+/* Run all scenarios, with full pools and with pools reduced.  */
+static void network_benchmark_run(NETWORK_BENCHMARK_PEER *host, NETWORK_BENCHMARK_PEER *device)
+{
+
+static const ULONG  udp_sizes[] = { 64, 512, 1024, NETWORK_BENCHMARK_MAX_PAYLOAD };
+static const ULONG  tcp_sizes[] = { 536, 1460 };
+static const ULONG  ping_sizes[] = { 32, 1024 };
+ULONG               pool_left[2];
+ULONG               pass, i;
+
+    for (i = 0; i < NETWORK_BENCHMARK_MAX_PAYLOAD; i ++)
+        network_benchmark_payload[i] = (UCHAR)i;
+
+    UX_TEST_CHECK_SUCCESS(nx_icmp_enable(host -> ip));
+    UX_TEST_CHECK_SUCCESS(nx_icmp_enable(device -> ip));
+
+    printf("\n");
+    pool_left[0] = UX_MIN(host -> ip -> nx_ip_default_packet_pool -> nx_packet_pool_available,
+                          device -> ip -> nx_ip_default_packet_pool -> nx_packet_pool_available);
+    pool_left[1] = UX_MIN(pool_left[0], NETWORK_BENCHMARK_POOL_RESERVE_LEFT);
+    for (pass = 0; pass < 2; pass ++)
+    {
+
+        network_benchmark_pool_reserve(host -> ip -> nx_ip_default_packet_pool, pool_left[pass]);
+        network_benchmark_pool_reserve(device -> ip -> nx_ip_default_packet_pool, pool_left[pass]);
+
+        for (i = 0; i < sizeof(udp_sizes) / sizeof(udp_sizes[0]); i ++)
+        {
+            network_benchmark_udp_blast(host, device, udp_sizes[i], pool_left[pass]);
+            network_benchmark_udp_blast(device, host, udp_sizes[i], pool_left[pass]);
+        }
+
+        if (host -> tcp_socket && device -> tcp_socket)
+        {
+            for (i = 0; i < sizeof(tcp_sizes) / sizeof(tcp_sizes[0]); i ++)
+            {
+                network_benchmark_tcp_bulk(host, device, tcp_sizes[i], pool_left[pass]);
+                network_benchmark_tcp_bulk(device, host, tcp_sizes[i], pool_left[pass]);
+            }
+        }
+
+        for (i = 0; i < sizeof(ping_sizes) / sizeof(ping_sizes[0]); i ++)
+        {
+            network_benchmark_ping(host, device, ping_sizes[i], pool_left[pass]);
+            network_benchmark_ping(device, host, ping_sizes[i], pool_left[pass]);
+        }
+
+        network_benchmark_pool_release();
+    }
+}
+
+#endif
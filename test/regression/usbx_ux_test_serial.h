@@ -0,0 +1,540 @@
+/* Shared fixture of the serial host classes (generic serial, prolific, sierra
+   wireless) read/write tests: a dummy device class serves the serial
+   interfaces, the host thread checks the transfers and the reception stream.
+
+   The test includes its host class header, then defines before including this
+   file:
+     UX_TEST_SERIAL_HOST_CLASS          host class instance type
+     UX_TEST_SERIAL_WRITE(i,b,l,a)      class write on interface i
+     UX_TEST_SERIAL_READ(i,b,l,a)       class read on interface i
+     UX_TEST_SERIAL_SPAN_GET(i,b,l)     class reception span get on interface i
+     UX_TEST_SERIAL_SPAN_RELEASE(i,l)   class reception span release on interface i
+     UX_TEST_SERIAL_STREAM              reception stream of the test
+     TEST_STATISTICS_CHECK(i,f,v)       port statistics check on interface i
+   and optionally:
+     UX_TEST_SERIAL_INTERFACE_FIRST     first interface served, default 0
+     UX_TEST_SERIAL_INTERFACE_COUNT     interfaces served, default 1
+     UX_TEST_SERIAL_ENDPOINT_IN(i)      bulk IN address of interface i
+     UX_TEST_SERIAL_ENDPOINT_OUT(i)     bulk OUT address of interface i
+
+   The test defines its device framework and the host test body
+   test_host_serial(), the fixture connects before and disconnects after it.  */
+
+#ifndef USBX_UX_TEST_SERIAL_H
+#define USBX_UX_TEST_SERIAL_H
+
+#include <stdio.h>
+#include "tx_api.h"
+#include "ux_api.h"
+#include "ux_system.h"
+#include "ux_utility.h"
+
+#include "ux_device_class_dummy.h"
+#include "ux_device_stack.h"
+
+#include "ux_test_dcd_sim_slave.h"
+#include "ux_test_hcd_sim_host.h"
+#include "ux_test_utility_sim.h"
+
+#ifndef UX_TEST_SERIAL_INTERFACE_FIRST
+#define UX_TEST_SERIAL_INTERFACE_FIRST      0
+#endif
+#ifndef UX_TEST_SERIAL_INTERFACE_COUNT
+#define UX_TEST_SERIAL_INTERFACE_COUNT      1
+#endif
+#ifndef UX_TEST_SERIAL_ENDPOINT_IN
+#define UX_TEST_SERIAL_ENDPOINT_IN(i)       ((UCHAR)(0x81 + (i) * 2))
+#endif
+#ifndef UX_TEST_SERIAL_ENDPOINT_OUT
+#define UX_TEST_SERIAL_ENDPOINT_OUT(i)      ((UCHAR)(0x02 + (i) * 2))
+#endif
+
+/* Define constants.  */
+#define                             UX_DEMO_STACK_SIZE      1024
+#define                             UX_DEMO_MEMORY_SIZE     (64*1024)
+
+/* Lengths are not multiple of the packet size, a short packet ends each transfer.  */
+#define                             TEST_LENGTH             200
+#define                             TEST_BLOCK_SIZE         64
+#define                             TEST_BLOCK_COUNT        8
+#define                             TEST_TRANSFER_COUNT     3
+#define                             TEST_BUFFER_SIZE        (TEST_BLOCK_SIZE * TEST_BLOCK_COUNT)
+#define                             TEST_OVERFLOW_LENGTH    (TEST_BUFFER_SIZE + 30)
+#define                             TEST_SPAN_LENGTH        (TEST_BLOCK_SIZE * 2 + 10)
+
+/* Define local/extern function prototypes.  */
+static TX_THREAD                           tx_test_thread_host_simulation;
+static TX_THREAD                           tx_test_thread_slave_simulation;
+static VOID                                tx_test_thread_host_simulation_entry(ULONG);
+static VOID                                tx_test_thread_slave_simulation_entry(ULONG);
+static VOID                                test_host_serial(VOID);
+
+/* Define global data structures.  */
+static UCHAR                        usbx_memory[UX_DEMO_MEMORY_SIZE + (UX_DEMO_STACK_SIZE * 2)];
+
+static UX_DEVICE                    *device = UX_NULL;
+
+static UX_TEST_SERIAL_HOST_CLASS    *host_serial = UX_NULL;
+
+static ULONG                        error_callback_counter = 0;
+
+static UX_DEVICE_CLASS_DUMMY                *device_dummy[UX_TEST_SERIAL_INTERFACE_COUNT];
+static UX_DEVICE_CLASS_DUMMY_PARAMETER      device_dummy_parameter;
+
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
+static UCHAR                        device_endpoint_buffer[UX_TEST_SERIAL_INTERFACE_COUNT][2][TEST_OVERFLOW_LENGTH];
+#endif
+
+/* Transfers done by the device thread, the host thread waits for them.  */
+static UCHAR                        device_request_endpoint;
+static ULONG                        device_request_length;
+static ULONG                        device_request_interface;
+static ULONG                        device_request_done;
+static UCHAR                        device_buffer[TEST_OVERFLOW_LENGTH];
+
+static UCHAR                        host_buffer[TEST_OVERFLOW_LENGTH];
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static UCHAR                        reception_buffer[TEST_BUFFER_SIZE];
+static ULONG                        callback_length;
+static ULONG                        callback_overflow;
+#endif
+
+
+/* Define device framework.  */
+
+#define _W0(w)      ( (w)       & 0xFF)
+#define _W1(w)      (((w) >> 8) & 0xFF)
+
+#define _CONFIGURATION_DESCRIPTOR(total_len, n_ifc, cfg_val)                    \
+    0x09, 0x02, _W0(total_len), _W1(total_len), (n_ifc), (cfg_val),             \
+    0x00, 0xc0, 0x32,
+
+#define _INTERFACE_DESCRIPTOR(ifc_n, alt, n_ep, cls, sub, protocol)             \
+    0x09, 0x04, (ifc_n), (alt), (n_ep), (cls), (sub), (protocol), 0x00,
+
+#define _ENDPOINT_DESCRIPTOR(addr, attr, pktsize, interval)                     \
+    0x07, 0x05, (addr), (attr), _W0(pktsize), _W1(pktsize), (interval),
+
+#define             STRING_FRAMEWORK_LENGTH                 47
+#define             LANGUAGE_ID_FRAMEWORK_LENGTH            2
+
+static unsigned char string_framework[] = {
+
+    /* Manufacturer string descriptor : Index 1 - "AzureRTOS" */
+    0x09, 0x04, 0x01, 9,
+        'A','z','u','r','e','R','T','O','S',
+
+    /* Product string descriptor : Index 2 - "Test device" */
+    0x09, 0x04, 0x02, 14,
+        'T','e','s','t',' ',' ',' ',' ','d','e','v','i','c','e',
+
+    /* Serial Number string descriptor : Index 3 - "0001" */
+    0x09, 0x04, 0x03, 0x04,
+        0x30, 0x30, 0x30, 0x31
+};
+
+    /* Multiple languages are supported on the device, to add
+       a language besides english, the unicode language code must
+       be appended to the language_id_framework array and the length
+       adjusted accordingly. */
+static unsigned char language_id_framework[] = {
+
+    /* English. */
+        0x09, 0x04
+};
+
+/* Prototype for test control return.  */
+
+void  test_control_return(UINT status);
+
+static UINT test_slave_change_function(ULONG change)
+{
+    return 0;
+}
+
+static UINT test_host_change_function(ULONG event, UX_HOST_CLASS *cls, VOID *inst)
+{
+
+UX_TEST_SERIAL_HOST_CLASS *serial_inst = (UX_TEST_SERIAL_HOST_CLASS *) inst;
+
+    switch(event)
+    {
+
+    case UX_DEVICE_INSERTION:
+        host_serial = serial_inst;
+        break;
+
+    case UX_DEVICE_REMOVAL:
+        if (host_serial == serial_inst)
+            host_serial = UX_NULL;
+        break;
+
+    case UX_DEVICE_CONNECTION:
+        device = (UX_DEVICE *)inst;
+        break;
+
+    case UX_DEVICE_DISCONNECTION:
+        if ((VOID *)device == inst)
+            device = UX_NULL;
+        break;
+
+    default:
+        break;
+    }
+    return 0;
+}
+
+static VOID    test_dummy_instance_activate(VOID *dummy_instance)
+{
+
+UX_DEVICE_CLASS_DUMMY   *dummy = (UX_DEVICE_CLASS_DUMMY *)dummy_instance;
+ULONG                   index = dummy -> ux_device_class_dummy_interface -> ux_slave_interface_descriptor.bInterfaceNumber - UX_TEST_SERIAL_INTERFACE_FIRST;
+
+    device_dummy[index] = dummy;
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
+
+    /* Endpoint buffers are owned by the class.  */
+    _ux_device_class_dummy_get_transfer_request(dummy, UX_TEST_SERIAL_ENDPOINT_IN(index)) -> ux_slave_transfer_request_data_pointer = device_endpoint_buffer[index][0];
+    _ux_device_class_dummy_get_transfer_request(dummy, UX_TEST_SERIAL_ENDPOINT_OUT(index)) -> ux_slave_transfer_request_data_pointer = device_endpoint_buffer[index][1];
+#endif
+}
+static VOID    test_dummy_instance_deactivate(VOID *dummy_instance)
+{
+
+ULONG   index;
+
+    for (index = 0; index < UX_TEST_SERIAL_INTERFACE_COUNT; index ++)
+    {
+        if ((VOID*)device_dummy[index] == dummy_instance)
+            device_dummy[index] = UX_NULL;
+    }
+}
+
+static VOID test_ux_error_callback(UINT system_level, UINT system_context, UINT error_code)
+{
+    error_callback_counter ++;
+}
+
+/* Initialize the host with the serial class and the device with a dummy
+   class on each served interface, then start the test threads.  */
+static VOID ux_test_serial_initialize(UCHAR *framework, ULONG framework_length,
+                                      UCHAR *class_name, UINT (*class_entry)(UX_HOST_CLASS_COMMAND *),
+                                      VOID (*control_request)(UX_DEVICE_CLASS_DUMMY *, UX_SLAVE_TRANSFER *))
+{
+
+UINT                    status;
+CHAR *                  stack_pointer;
+CHAR *                  memory_pointer;
+ULONG                   index;
+
+
+    /* Initialize the free memory pointer */
+    stack_pointer = (CHAR *) usbx_memory;
+    memory_pointer = stack_pointer + (UX_DEMO_STACK_SIZE * 2);
+
+    /* Initialize USBX Memory */
+    status = ux_system_initialize(memory_pointer, UX_DEMO_MEMORY_SIZE, UX_NULL,0);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_system_initialize failed 0x%x\n", status);
+
+    /* Register the error callback. */
+    _ux_utility_error_callback_register(test_ux_error_callback);
+
+    /* The code below is required for installing the host portion of USBX */
+    status =  ux_host_stack_initialize(test_host_change_function);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_initialize failed 0x%x\n", status);
+
+    /* Register the serial class.  */
+    status =  ux_host_stack_class_register(class_name, class_entry);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_class_register failed 0x%x\n", status);
+
+    /* The code below is required for installing the device portion of USBX. No call back for
+       device status change in this example. */
+    status =  ux_device_stack_initialize(framework, framework_length,
+                                       framework, framework_length,
+                                       string_framework, STRING_FRAMEWORK_LENGTH,
+                                       language_id_framework, LANGUAGE_ID_FRAMEWORK_LENGTH,
+                                       test_slave_change_function);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_device_stack_initialize failed 0x%x\n", status);
+
+    /* Set the parameters for callback when insertion/extraction of a dummy device.  */
+    _ux_utility_memory_set(&device_dummy_parameter, 0, sizeof(device_dummy_parameter));
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_instance_activate   = test_dummy_instance_activate;
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_instance_deactivate = test_dummy_instance_deactivate;
+    device_dummy_parameter.ux_device_class_dummy_parameter_callbacks.ux_device_class_dummy_control_request =     control_request;
+
+    /* A dummy class owns each served interface.  */
+    for (index = 0; index < UX_TEST_SERIAL_INTERFACE_COUNT; index ++)
+    {
+        status  = ux_device_stack_class_register(_ux_device_class_dummy_name,
+                                                 _ux_device_class_dummy_entry,
+                                                 1, UX_TEST_SERIAL_INTERFACE_FIRST + index, &device_dummy_parameter);
+        UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_device_stack_class_register failed 0x%x\n", status);
+    }
+
+    /* Initialize the simulated device controller.  */
+    status =  _ux_test_dcd_sim_slave_initialize();
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "_ux_test_dcd_sim_slave_initialize failed 0x%x\n", status);
+
+    /* Register all the USB host controllers available in this system */
+    status =  ux_host_stack_hcd_register(_ux_system_host_hcd_simulator_name, _ux_test_hcd_sim_host_initialize,0,0);
+    UX_TEST_ASSERT_MESSAGE(status == UX_SUCCESS, "ux_host_stack_hcd_register failed 0x%x\n", status);
+
+    /* Create the main host simulation thread.  */
+    status =  tx_thread_create(&tx_test_thread_host_simulation, "tx test host simulation", tx_test_thread_host_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_ASSERT_MESSAGE(status == TX_SUCCESS, "tx_thread_create failed 0x%x\n", status);
+
+    /* Create the main slave simulation  thread.  */
+    stack_pointer += UX_DEMO_STACK_SIZE;
+    status =  tx_thread_create(&tx_test_thread_slave_simulation, "tx test slave simulation", tx_test_thread_slave_simulation_entry, 0,
+            stack_pointer, UX_DEMO_STACK_SIZE,
+            20, 20, 1, TX_AUTO_START);
+    UX_TEST_ASSERT_MESSAGE(status == TX_SUCCESS, "tx_thread_create failed 0x%x\n", status);
+
+}
+
+static UINT _test_check_host_connection_success(VOID)
+{
+
+ULONG   index;
+
+    for (index = 0; index < UX_TEST_SERIAL_INTERFACE_COUNT; index ++)
+    {
+        if (device_dummy[index] == UX_NULL)
+            return(UX_ERROR);
+    }
+    if (host_serial == UX_NULL)
+        return(UX_ERROR);
+    return(UX_SUCCESS);
+}
+
+static UINT _test_check_host_disconnection_success(VOID)
+{
+
+ULONG   index;
+
+    for (index = 0; index < UX_TEST_SERIAL_INTERFACE_COUNT; index ++)
+    {
+        if (device_dummy[index] != UX_NULL)
+            return(UX_ERROR);
+    }
+    if (host_serial != UX_NULL)
+        return(UX_ERROR);
+    return(UX_SUCCESS);
+}
+
+static VOID _test_data_fill(UCHAR *buffer, ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+
+    for (i = 0; i < length; i ++)
+        buffer[i] = (UCHAR)(tag + i);
+}
+
+static VOID _test_data_check(UCHAR *buffer, ULONG length, UCHAR tag)
+{
+
+ULONG       i;
+
+    for (i = 0; i < length; i ++)
+    {
+        UX_TEST_ASSERT(buffer[i] == (UCHAR)(tag + i));
+    }
+}
+
+/* The device thread transfers on the endpoint, the caller waits for it.  */
+static VOID _test_device_request(ULONG index, UCHAR endpoint_address, ULONG length)
+{
+
+    device_request_done = 0;
+    device_request_interface = index;
+    device_request_endpoint = endpoint_address;
+    device_request_length = length;
+}
+
+/* Write then read TEST_LENGTH bytes on the interface, check data and statistics.  */
+static VOID _test_write_read(ULONG index, UCHAR tag)
+{
+
+UINT        status;
+ULONG       actual_length;
+
+
+    stepinfo(">>>>>>>>>>>>>>>> Test write on interface %ld\n", index);
+    _test_device_request(index, UX_TEST_SERIAL_ENDPOINT_OUT(index), TEST_LENGTH);
+    _test_data_fill(host_buffer, TEST_LENGTH, tag);
+    status = UX_TEST_SERIAL_WRITE(index, host_buffer, TEST_LENGTH, &actual_length);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(actual_length == TEST_LENGTH);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&device_request_done, TEST_LENGTH));
+    _test_data_check(device_buffer, TEST_LENGTH, tag);
+    TEST_STATISTICS_CHECK(index, tx_bytes, TEST_LENGTH);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test read on interface %ld\n", index);
+    _test_data_fill(device_buffer, TEST_LENGTH, (UCHAR)(tag - 'a' + 'A'));
+    _test_device_request(index, UX_TEST_SERIAL_ENDPOINT_IN(index), TEST_LENGTH);
+    _ux_utility_memory_set(host_buffer, 0, TEST_LENGTH);
+    status = UX_TEST_SERIAL_READ(index, host_buffer, TEST_LENGTH, &actual_length);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(actual_length == TEST_LENGTH);
+    _test_data_check(host_buffer, TEST_LENGTH, (UCHAR)(tag - 'a' + 'A'));
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&device_request_done, TEST_LENGTH));
+    TEST_STATISTICS_CHECK(index, rx_bytes, TEST_LENGTH);
+}
+
+#if defined(UX_HOST_CLASS_SERIAL_RECEPTION_STREAM)
+static VOID _test_reception_callback(UX_TEST_SERIAL_HOST_CLASS *serial, UINT status, UCHAR *buffer, ULONG length)
+{
+
+    /* Overflow is reported without data.  */
+    if (status == UX_BUFFER_OVERFLOW)
+    {
+        UX_TEST_ASSERT(buffer == UX_NULL);
+        callback_overflow ++;
+        return;
+    }
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+    UX_TEST_ASSERT(buffer >= reception_buffer && buffer + length <= reception_buffer + TEST_BUFFER_SIZE);
+    callback_length += length;
+}
+
+static VOID _test_stream_read(ULONG index, ULONG length, UCHAR tag)
+{
+
+UCHAR       *span_buffer;
+ULONG       span_length;
+ULONG       total_length = 0;
+ULONG       wait_ms = 0;
+ULONG       i;
+
+
+    /* Read spans and release them until all the expected data is received.  */
+    while (total_length < length)
+    {
+        UX_TEST_ASSERT(wait_ms < 2000);
+        UX_TEST_CHECK_SUCCESS(UX_TEST_SERIAL_SPAN_GET(index, &span_buffer, &span_length));
+        if (span_length == 0)
+        {
+            tx_thread_sleep(1);
+            wait_ms += 10;
+            continue;
+        }
+        UX_TEST_ASSERT(total_length + span_length <= length);
+        for (i = 0; i < span_length; i ++)
+        {
+            UX_TEST_ASSERT(span_buffer[i] == (UCHAR)(tag + total_length + i));
+        }
+        UX_TEST_CHECK_SUCCESS(UX_TEST_SERIAL_SPAN_RELEASE(index, span_length));
+        total_length += span_length;
+    }
+}
+
+/* Receive a span in the started stream, then overflow it and drain it.  */
+static VOID _test_stream_receive(ULONG index)
+{
+
+UCHAR       *span_buffer;
+ULONG       span_length;
+
+
+    UX_TEST_ASSERT(UX_TEST_SERIAL_STREAM.ux_host_class_serial_stream_transfers_pending == TEST_TRANSFER_COUNT);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream span\n");
+    _test_data_fill(device_buffer, TEST_SPAN_LENGTH, '0');
+    _test_device_request(index, UX_TEST_SERIAL_ENDPOINT_IN(index), TEST_SPAN_LENGTH);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&callback_length, TEST_SPAN_LENGTH));
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&device_request_done, TEST_SPAN_LENGTH));
+    UX_TEST_CHECK_SUCCESS(UX_TEST_SERIAL_SPAN_GET(index, &span_buffer, &span_length));
+    UX_TEST_ASSERT(span_buffer == reception_buffer);
+    UX_TEST_ASSERT(span_length == TEST_SPAN_LENGTH);
+    _test_data_check(span_buffer, span_length, '0');
+    UX_TEST_CHECK_SUCCESS(UX_TEST_SERIAL_SPAN_RELEASE(index, span_length));
+    UX_TEST_ASSERT(UX_TEST_SERIAL_STREAM.ux_host_class_serial_stream_blocks_filled == 0);
+    TEST_STATISTICS_CHECK(index, rx_bytes, TEST_LENGTH + TEST_SPAN_LENGTH);
+    TEST_STATISTICS_CHECK(index, rx_blocks_high_water, 3);
+
+    stepinfo(">>>>>>>>>>>>>>>> Test reception stream overflow\n");
+    _test_data_fill(device_buffer, TEST_OVERFLOW_LENGTH, 'a');
+    _test_device_request(index, UX_TEST_SERIAL_ENDPOINT_IN(index), TEST_OVERFLOW_LENGTH);
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&callback_overflow, 1));
+    UX_TEST_ASSERT(UX_TEST_SERIAL_STREAM.ux_host_class_serial_stream_transfers_pending == 0);
+    TEST_STATISTICS_CHECK(index, rx_overflows, 1);
+    TEST_STATISTICS_CHECK(index, rx_blocks_high_water, TEST_BLOCK_COUNT);
+    UX_TEST_ASSERT(device_request_done == 0);
+    _test_stream_read(index, TEST_OVERFLOW_LENGTH, 'a');
+    UX_TEST_CHECK_SUCCESS(ux_test_wait_for_value_ulong(&device_request_done, TEST_OVERFLOW_LENGTH));
+}
+#endif
+
+static VOID  tx_test_thread_host_simulation_entry(ULONG arg)
+{
+
+UINT                                                status;
+ULONG                                               index;
+
+
+    stepinfo(">>>>>>>>>>>>>>>> Test connect\n");
+    ux_test_dcd_sim_slave_connect(UX_FULL_SPEED_DEVICE);
+    ux_test_hcd_sim_host_connect(UX_FULL_SPEED_DEVICE);
+    status = ux_test_sleep_break_on_success(100, _test_check_host_connection_success);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* Class specific checks.  */
+    test_host_serial();
+
+    stepinfo(">>>>>>>>>>>>>>>> Test disconnect\n");
+    ux_test_dcd_sim_slave_disconnect();
+    ux_test_hcd_sim_host_disconnect();
+    status = ux_test_sleep_break_on_success(100, _test_check_host_disconnection_success);
+    UX_TEST_ASSERT(status == UX_SUCCESS);
+
+    /* Finally disconnect the device. */
+    ux_device_stack_disconnect();
+
+    /* And deinitialize the classes.  */
+    for (index = 0; index < UX_TEST_SERIAL_INTERFACE_COUNT; index ++)
+        status  = ux_device_stack_class_unregister(_ux_device_class_dummy_name, _ux_device_class_dummy_entry);
+
+    /* Deinitialize the device side of usbx.  */
+    _ux_device_stack_uninitialize();
+
+    /* And finally the usbx system resources.  */
+    _ux_system_uninitialize();
+
+    /* Successful test.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+
+}
+
+static VOID  tx_test_thread_slave_simulation_entry(ULONG arg)
+{
+
+UINT        status;
+ULONG       actual_length;
+ULONG       length;
+
+
+    while(1)
+    {
+
+        /* Serve the transfer requested by the host thread.  */
+        length = device_request_length;
+        if (length == 0)
+        {
+            tx_thread_sleep(1);
+            continue;
+        }
+        device_request_length = 0;
+        status = _ux_device_class_dummy_transfer(device_dummy[device_request_interface], device_request_endpoint,
+                                                 device_buffer, length, &actual_length);
+        UX_TEST_ASSERT(status == UX_SUCCESS);
+        UX_TEST_ASSERT(actual_length == length);
+        device_request_done = actual_length;
+    }
+}
+
+#endif
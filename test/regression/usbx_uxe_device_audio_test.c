@@ -500,6 +500,8 @@ ULONG                                   dummy_dw;
 UX_SLAVE_TRANSFER                       dummy_transfer; 
 UX_DEVICE_CLASS_AUDIO10_CONTROL_GROUP   dummy_group10;
 UX_DEVICE_CLASS_AUDIO20_CONTROL_GROUP   dummy_group20;
+UX_DEVICE_CLASS_AUDIO_MIXER             dummy_mixer;
+LONG                                    dummy_samples[4];
 
     /* ux_device_class_audio_stream_get()  */
     status = ux_device_class_audio_stream_get(UX_NULL, 0, &dummy_stream);
@@ -604,6 +606,22 @@ UX_DEVICE_CLASS_AUDIO20_CONTROL_GROUP   dummy_group20;
     status = ux_device_class_audio20_control_process(dummy_audio, &dummy_transfer, UX_NULL);
     UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
 
+    /* ux_device_class_audio_mixer_mix()  */
+    status = ux_device_class_audio_mixer_mix(UX_NULL, dummy_samples);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_device_class_audio_mixer_mix(&dummy_mixer, UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_device_class_audio_mixer_mix(&dummy_mixer, dummy_samples);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
+    /* ux_device_class_audio_mixer_route()  */
+    status = ux_device_class_audio_mixer_route(UX_NULL, dummy_samples);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_device_class_audio_mixer_route(&dummy_mixer, UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_device_class_audio_mixer_route(&dummy_mixer, dummy_samples);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
     /* Sleep for a tick to make sure everything is complete.  */
     tx_thread_sleep(1);
 
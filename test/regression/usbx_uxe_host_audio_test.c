@@ -119,7 +119,9 @@ UX_HOST_CLASS_AUDIO_CONTROL                     dummy_audio_control;
 UX_HOST_CLASS_AUDIO_TRANSFER_REQUEST            dummy_audio_request;
 UX_HOST_CLASS_AUDIO_SAMPLING_CHARACTERISTICS    dummy_audio_sampling_prop;
 UX_HOST_CLASS_AUDIO_SAMPLING                    dummy_audio_sampling;
+UX_HOST_CLASS_AUDIO_STATISTICS                  dummy_audio_statistics;
 UCHAR                                           dummy_buffer[64];
+ULONG                                           actual_length;
 
 
     /* ux_host_class_audio_control_get()  */
@@ -224,6 +226,40 @@ UCHAR                                           dummy_buffer[64];
     status = ux_host_class_audio_interrupt_start(UX_NULL, _dummy_int_callback_func, UX_NULL);
     UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
 
+    /* ux_host_class_audio_ring_start()  */
+    status = ux_host_class_audio_ring_start(UX_NULL, 4, 4);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
+    /* ux_host_class_audio_ring_stop()  */
+    status = ux_host_class_audio_ring_stop(UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
+    /* ux_host_class_audio_ring_read()  */
+    status = ux_host_class_audio_ring_read(UX_NULL, dummy_buffer, sizeof(dummy_buffer), &actual_length, UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_host_class_audio_ring_read(dummy_audio, UX_NULL, sizeof(dummy_buffer), &actual_length, UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_host_class_audio_ring_read(dummy_audio, dummy_buffer, sizeof(dummy_buffer), UX_NULL, UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
+    /* ux_host_class_audio_ring_write()  */
+    status = ux_host_class_audio_ring_write(UX_NULL, dummy_buffer, sizeof(dummy_buffer), &actual_length);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_host_class_audio_ring_write(dummy_audio, UX_NULL, sizeof(dummy_buffer), &actual_length);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_host_class_audio_ring_write(dummy_audio, dummy_buffer, sizeof(dummy_buffer), UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
+    /* ux_host_class_audio_statistics_get()  */
+    status = ux_host_class_audio_statistics_get(UX_NULL, &dummy_audio_statistics);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+    status = ux_host_class_audio_statistics_get(dummy_audio, UX_NULL);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
+    /* ux_host_class_audio_statistics_reset()  */
+    status = ux_host_class_audio_statistics_reset(UX_NULL, &dummy_audio_statistics);
+    UX_TEST_CHECK_CODE(UX_INVALID_PARAMETER, status);
+
     /* Sleep for a tick to make sure everything is complete.  */
     tx_thread_sleep(1);
 
@@ -28,6 +28,9 @@ static UCHAR            ux_test_assert_hit_exit_off = 0;
 static ULONG            ux_test_assert_hit_count = 0;
 static UINT             ux_test_assert_hit_exit_code = 1;
 
+static VOID             (*ux_test_hid_latency_probe_callback)(UINT stage, UCHAR *buffer, ULONG length) = UX_NULL;
+static ULONG            (*ux_test_audio_statistics_time_callback)(VOID) = UX_NULL;
+
 VOID _ux_test_main_action_list_thread_update(TX_THREAD *old, TX_THREAD *new)
 {
     UX_TEST_ACTION *list = ux_test_main_action_list;
@@ -598,6 +601,12 @@ VOID ux_test_cleanup_everything(VOID)
     ux_test_assert_hit_exit_off = 0;
     ux_test_assert_hit_exit_code = 1;
 
+    /* HID latency probe.  */
+    ux_test_hid_latency_probe_callback = UX_NULL;
+
+    /* Audio statistics time base.  */
+    ux_test_audio_statistics_time_callback = UX_NULL;
+
 #if defined(UX_HOST_CLASS_STORAGE_NO_FILEX)
     _ux_host_class_storage_driver_read_write_notify(UX_NULL);
 #endif
@@ -1813,6 +1822,27 @@ void ux_test_assert_hit(char* file, INT line)
         test_control_return(ux_test_assert_hit_exit_code);
 }
 
+void ux_test_hid_latency_probe_set(VOID (*probe)(UINT stage, UCHAR *buffer, ULONG length))
+{
+    ux_test_hid_latency_probe_callback = probe;
+}
+void ux_test_hid_latency_probe(unsigned int stage, unsigned char *buffer, unsigned long length)
+{
+    if (ux_test_hid_latency_probe_callback)
+        ux_test_hid_latency_probe_callback(stage, buffer, (ULONG)length);
+}
+
+void ux_test_audio_statistics_time_set(ULONG (*time_get)(VOID))
+{
+    ux_test_audio_statistics_time_callback = time_get;
+}
+unsigned long ux_test_audio_statistics_time_get(void)
+{
+    if (ux_test_audio_statistics_time_callback)
+        return(ux_test_audio_statistics_time_callback());
+    return(_ux_utility_time_get());
+}
+
 UINT ux_test_host_endpoint_write(UX_ENDPOINT *endpoint, UCHAR *buffer, ULONG length, ULONG *actual_length)
 {
 UINT            status;
@@ -516,6 +516,9 @@ void  ux_test_assert_hit_exit(UCHAR on_off);
 ULONG ux_test_assert_hit_count_get(void);
 void  ux_test_assert_hit_count_reset(void);
 
+void  ux_test_hid_latency_probe_set(VOID (*probe)(UINT stage, UCHAR *buffer, ULONG length));
+void  ux_test_audio_statistics_time_set(ULONG (*time_get)(VOID));
+
 static inline int ux_test_memory_is_freed(void *memory)
 {
 UCHAR               *work_ptr;